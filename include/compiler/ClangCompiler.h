@@ -22,6 +22,8 @@ public:
     bool isAvailable() const override;
     QString version() const override;
     CompileResult compile(const CompileRequest& request) override;
+    CompileJob* compileAsync(const CompileRequest& request, QObject* parent = nullptr) override;
+    QList<DiagnosticMessage> parseDiagnosticOutput(const QString& output) const override;
     QProcess* runExecutable(const QString& exePath, const QStringList& args) override;
     
 private:
@@ -35,7 +37,12 @@ private:
      * @param output Compiler output (stdout/stderr)
      * @return List of diagnostic messages
      */
-    QList<DiagnosticMessage> parseDiagnostics(const QString& output);
+    static QList<DiagnosticMessage> parseDiagnostics(const QString& output);
+    
+    /**
+     * @brief Build the command-line arguments for a compilation request
+     */
+    QStringList buildArguments(const CompileRequest& request) const;
     
     /**
      * @brief Convert optimization level to Clang flag
@@ -0,0 +1,185 @@
+#ifndef COMPILEJOB_H
+#define COMPILEJOB_H
+
+#include <QObject>
+#include <QProcess>
+#include <QElapsedTimer>
+#include <functional>
+#include "CompileRequest.h"
+#include "CompileResult.h"
+#include "DiagnosticStreamParser.h"
+
+class QTimer;
+class GroupedProcess;
+
+/**
+ * @brief Handle for one asynchronous compiler invocation.
+ *
+ * Created by ICompiler::compileAsync().  The job does nothing until start()
+ * is called; it is then queued in CompileJobQueue, which launches it as soon
+ * as a concurrency slot is free.  The compiler runs via a non-blocking
+ * QProcess, so the GUI thread never waits on it.
+ *
+ * Lifecycle:
+ *   Queued → Running → Finished
+ *   Queued / Running → Cancelled   (via cancel())
+ *
+ * finished() is emitted exactly once per started job, including when the
+ * job is cancelled (CompileResult::cancelled is then true).
+ *
+ * Diagnostics are parsed incrementally as stderr arrives (see
+ * DiagnosticStreamParser) and reported through diagnosticsReceived().  When
+ * the compiler emits a structured log (JSON/SARIF), outputReceived() carries
+ * the diagnostics rendered as text instead of the raw JSON.
+ *
+ * With CompileRequest::useCache set, start() first consults ArtifactCache;
+ * on a hit the cached output is copied into place and finished() reports
+ * CompileResult::fromCache without spawning the compiler.
+ *
+ * Ownership: the QObject parent passed to compileAsync() owns the job.
+ * Callers typically deleteLater() the job from their finished() slot.
+ * Destroying a job that is still running never blocks: the compiler is
+ * killed, CompileJobQueue keeps its slot until the process is reaped, and
+ * finished() is not emitted.
+ */
+class CompileJob : public QObject {
+    Q_OBJECT
+
+public:
+    enum class State {
+        Created,   // Constructed, start() not called yet
+        Queued,    // Waiting for a free slot in CompileJobQueue
+        Running,   // Compiler process is running
+        Finished,  // Compiler exited (successfully or not)
+        Cancelled  // Stopped via cancel() before completion
+    };
+
+    CompileJob(const QString& program,
+               const QStringList& arguments,
+               const CompileRequest& request,
+               DiagnosticStreamParser::Format diagnosticFormat,
+               QObject* parent = nullptr);
+    ~CompileJob() override;
+
+    /**
+     * @brief Queue the job for execution in CompileJobQueue
+     */
+    void start();
+
+    /**
+     * @brief Cancel the job; kills the compiler if it is already running
+     *
+     * The compiler's whole process group is killed, so cc1plus/as go with
+     * the driver.  finished() follows once the process is reaped, which is
+     * also when the job's queue slot is freed.
+     */
+    void cancel();
+
+    /**
+     * @brief Call @p next once the job finishes successfully
+     *
+     * Never fires for a failed, timed-out or cancelled job, nor after
+     * @p context disconnects from the job or is destroyed.  Runs after the
+     * finished() receivers connected before it.  Build && Run chains the run
+     * this way.
+     */
+    void whenSucceeded(QObject* context, std::function<void()> next);
+
+    State state() const { return m_state; }
+
+    /**
+     * @brief Check whether the job is queued or running
+     * @return true until finished() has been emitted
+     */
+    bool isActive() const;
+
+    const CompileRequest& request() const { return m_request; }
+    QString program() const { return m_program; }
+
+    /**
+     * @brief Identify the compiler for ArtifactCache keys
+     *
+     * Only consulted when CompileRequest::useCache is set.
+     */
+    void setCacheIdentity(const QString& toolId, const QString& toolVersion);
+
+    QStringList arguments() const { return m_arguments; }
+
+    /**
+     * @brief Result of the job (valid after finished() has been emitted)
+     */
+    CompileResult result() const { return m_result; }
+
+signals:
+    /** Emitted when the compiler process has been launched */
+    void started();
+
+    /** Emitted with human-readable status changes (queued, compiling, ...) */
+    void progressMessage(const QString& message);
+
+    /**
+     * @brief Emitted as compiler output arrives
+     * @param text Output chunk
+     * @param fromStderr true if the chunk came from stderr
+     */
+    void outputReceived(const QString& text, bool fromStderr);
+
+    /**
+     * @brief Emitted as complete diagnostics are parsed from the output
+     * @param diagnostics Newly completed top-level diagnostics
+     */
+    void diagnosticsReceived(const QList<DiagnosticMessage>& diagnostics);
+
+    /** Emitted once when the job completes, fails or is cancelled */
+    void finished(const CompileResult& result);
+
+private slots:
+    void onReadyReadStandardOutput();
+    void onReadyReadStandardError();
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+    void onProcessError(QProcess::ProcessError error);
+    void onTimeout();
+
+private:
+    friend class CompileJobQueue;
+
+    /**
+     * @brief Start the compiler process (called by CompileJobQueue)
+     */
+    void launch();
+
+    /**
+     * @brief Record the final result, release the process and emit finished()
+     */
+    void complete(State finalState);
+
+    QString displayFile() const;
+
+    /**
+     * @brief Record newly parsed diagnostics and forward the matching output
+     * @param rawText Raw stderr chunk (used as output in Text format)
+     */
+    void publishDiagnostics(const QList<DiagnosticMessage>& diagnostics, const QString& rawText);
+    bool startFromCache();
+
+    QString m_program;
+    QStringList m_arguments;
+    CompileRequest m_request;
+    DiagnosticStreamParser m_diagnosticParser;
+
+    State m_state = State::Created;
+    GroupedProcess* m_process = nullptr;
+    QTimer* m_timeoutTimer = nullptr;
+    QElapsedTimer m_elapsed;
+    bool m_timedOut = false;
+
+    QString m_cacheToolId;
+    QString m_cacheToolVersion;
+    QString m_cacheKey;
+
+    QString m_stdout;
+    QString m_stderr;
+    CompileResult m_result;
+};
+
+#endif // COMPILEJOB_H
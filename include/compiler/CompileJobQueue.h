@@ -0,0 +1,83 @@
+#ifndef COMPILEJOBQUEUE_H
+#define COMPILEJOBQUEUE_H
+
+#include <QObject>
+#include <QList>
+#include <QPointer>
+
+class CompileJob;
+
+/**
+ * @brief Process-wide scheduler that bounds the number of concurrently
+ * running compiler processes.
+ *
+ * Every CompileJob is funnelled through this queue by CompileJob::start().
+ * At most maxConcurrentJobs() compilers run at once (defaults to the number
+ * of logical CPUs); the rest wait in FIFO order.
+ *
+ * A job destroyed while its compiler still runs hands the killed process
+ * over (holdSlotUntilDestroyed()); the slot stays taken until the process
+ * is reaped, so killed compilers never push the count over the limit.
+ */
+class CompileJobQueue : public QObject {
+    Q_OBJECT
+
+public:
+    static CompileJobQueue& instance();
+
+    /**
+     * @brief Maximum number of compiler processes allowed to run concurrently
+     */
+    int maxConcurrentJobs() const;
+
+    /**
+     * @brief Set the concurrency limit (clamped to at least 1)
+     * @param count New limit
+     */
+    void setMaxConcurrentJobs(int count);
+
+    /**
+     * @brief Number of compiler processes currently running
+     *
+     * Includes killed processes of destroyed jobs that are not reaped yet.
+     */
+    int runningCount() const;
+
+    /**
+     * @brief Number of jobs waiting for a free slot
+     */
+    int pendingCount() const;
+
+signals:
+    /**
+     * @brief Emitted whenever the running or pending job count changes
+     */
+    void activityChanged(int running, int pending);
+
+private:
+    friend class CompileJob;
+
+    CompileJobQueue();
+    ~CompileJobQueue() override = default;
+    CompileJobQueue(const CompileJobQueue&) = delete;
+    CompileJobQueue& operator=(const CompileJobQueue&) = delete;
+
+    void enqueue(CompileJob* job);
+    void remove(CompileJob* job);
+    void jobFinished(CompileJob* job);
+    void schedule();
+
+    /**
+     * @brief Keep a slot taken until @p process is destroyed
+     *
+     * Called by ~CompileJob for a process that is killed but not yet reaped.
+     */
+    void holdSlotUntilDestroyed(QObject* process);
+
+    QList<QPointer<CompileJob>> m_pending;
+    QList<QPointer<CompileJob>> m_running;
+    QList<QObject*> m_reaping;
+    int m_maxConcurrentJobs = 1;
+};
+
+#endif // COMPILEJOBQUEUE_H
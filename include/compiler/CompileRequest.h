@@ -15,11 +15,14 @@ enum class OptimizationLevel {
 
 struct CompileRequest {
     QString sourceFile;
+    QStringList inputFiles;     // Extra inputs passed after sourceFile (e.g. objects to link)
     QString outputFile;
     QString standard;           // "c++17", "c++20", etc.
     QStringList additionalFlags;
     bool optimizationEnabled = false;
     OptimizationLevel optLevel = OptimizationLevel::O0;
+    int timeoutMs = 60000;      // Kill the compiler after this long
+    bool useCache = false;      // Serve/store the output via ArtifactCache (async jobs only)
 };
 
 #endif // COMPILEREQUEST_H
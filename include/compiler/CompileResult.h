@@ -13,6 +13,7 @@ struct DiagnosticMessage {
     int column = 0;
     QString message;
     QString code;  // Error code if available
+    QList<DiagnosticMessage> children;  // Notes and "required from" context of this diagnostic
 };
 
 struct CompileResult {
@@ -23,6 +24,8 @@ struct CompileResult {
     QList<DiagnosticMessage> diagnostics;
     int exitCode = 0;
     qint64 compilationTimeMs = 0;
+    bool fromCache = false;  // Output was copied from ArtifactCache, compiler not run
+    bool cancelled = false;  // Job was stopped before the compiler finished
 };
 
 #endif // COMPILERESULT_H
@@ -2,6 +2,7 @@
 #define COMPILERREGISTRY_H
 
 #include "ICompiler.h"
+#include "ToolchainDiscovery.h"
 #include <QObject>
 #include <QMap>
 #include <QSharedPointer>
@@ -48,8 +49,22 @@ public:
     
     /**
      * @brief Auto-scan system for installed compilers
+     *
+     * Finds g++/clang++ (including versioned g++-13, clang++-18, ...) and
+     * probes them concurrently through ToolchainDiscovery.  Blocks until
+     * every uncached candidate has been probed.
      */
     void autoScanCompilers();
+
+    /**
+     * @brief Auto-scan on a worker thread
+     *
+     * Compilers already in the persistent probe cache are registered
+     * immediately; the rest are probed in the background and
+     * compilersChanged() is emitted once they are registered.
+     * @param extraTools Other binaries to probe alongside (path, arguments)
+     */
+    void autoScanCompilersAsync(const QList<QPair<QString, QStringList>>& extraTools = {});
     
     /**
      * @brief Load configuration from JSON file
@@ -101,13 +116,12 @@ private:
     QMap<QString, QSharedPointer<ICompiler>> m_compilers;
     QString m_defaultCompilerId;
     QString m_defaultStandard = "c++17";
+    bool m_discoveryConnected = false;
     
     /**
-     * @brief Try to find a compiler executable in system PATH
-     * @param name Executable name (e.g., "g++", "clang++")
-     * @return Full path if found, empty string otherwise
+     * @brief Register every available, not yet registered candidate
      */
-    QString findInPath(const QString& name) const;
+    void registerCandidates(const QList<CompilerCandidate>& candidates);
 };
 
 #endif // COMPILERREGISTRY_H
@@ -0,0 +1,106 @@
+#ifndef DIAGNOSTICSTREAMPARSER_H
+#define DIAGNOSTICSTREAMPARSER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include "CompileResult.h"
+
+class QJsonObject;
+
+/**
+ * @brief Incremental parser for compiler diagnostics
+ *
+ * Compiler stderr is fed in chunks as it arrives; every feed() returns the
+ * top-level diagnostics completed so far, so a flood of template errors
+ * is turned into rows long before the compiler exits.
+ *
+ * Formats:
+ *   - Text     classic "file:line:col: error: message" lines
+ *   - GccJson  -fdiagnostics-format=json; each element of the top-level
+ *              array is parsed as soon as its closing brace arrives
+ *   - Sarif    -fdiagnostics-format=sarif (Clang); the log is one JSON
+ *              document and is converted once it is complete
+ *
+ * In the structured formats any plain text in the stream (linker errors,
+ * driver messages) is passed through via takePassthroughText() and
+ * parsed as Text.  If a JSON document turns out to be malformed, its raw
+ * bytes are handled the same way, so no output is ever lost.
+ *
+ * Grouping: notes, "required from here" and "In instantiation of" context
+ * lines are attached to their error as DiagnosticMessage::children rather
+ * than reported as separate top-level diagnostics.
+ */
+class DiagnosticStreamParser {
+public:
+    enum class Format {
+        Text,
+        GccJson,
+        Sarif
+    };
+
+    explicit DiagnosticStreamParser(Format format = Format::Text);
+
+    Format format() const { return m_format; }
+
+    /**
+     * @brief Feed the next chunk of compiler output
+     * @return Top-level diagnostics completed by this chunk
+     */
+    QList<DiagnosticMessage> feed(const QByteArray& chunk);
+
+    /**
+     * @brief Signal end of stream and flush everything still buffered
+     * @return Remaining top-level diagnostics
+     */
+    QList<DiagnosticMessage> finish();
+
+    /**
+     * @brief Take plain text found in a structured stream since the last call
+     *
+     * Always empty in Text format, where the raw output is already text.
+     */
+    QString takePassthroughText();
+
+    /**
+     * @brief Parse a complete text log in one go
+     */
+    static QList<DiagnosticMessage> parseText(const QString& output);
+
+    /**
+     * @brief Render a diagnostic (and its children) in GCC's text layout
+     */
+    static QString formatDiagnostic(const DiagnosticMessage& diagnostic);
+
+private:
+    enum class State {
+        Lines,      // Between documents, consuming text line by line
+        JsonArray,  // Inside a GCC JSON array, splitting out elements
+        JsonObject  // Inside a SARIF document
+    };
+
+    void consumeLine(const QString& line, QList<DiagnosticMessage>& out);
+    void consumeStructured(QList<DiagnosticMessage>& out);
+    void flushCurrent(QList<DiagnosticMessage>& out);
+    void handleTextFallback(const QByteArray& raw, QList<DiagnosticMessage>& out);
+
+    static DiagnosticMessage fromGccJson(const QJsonObject& obj);
+    static QList<DiagnosticMessage> fromSarif(const QJsonObject& root);
+    static DiagnosticMessage::Severity severityFromString(const QString& kind);
+
+    Format m_format;
+    State m_state = State::Lines;
+    QByteArray m_buffer;       // Unconsumed input
+    QByteArray m_document;     // Current JSON element/document
+    int m_depth = 0;
+    bool m_inString = false;
+    bool m_escape = false;
+    QString m_passthrough;
+
+    // Text-format grouping
+    bool m_hasCurrent = false;
+    DiagnosticMessage m_current;
+    QList<DiagnosticMessage> m_pendingContext;
+};
+
+#endif // DIAGNOSTICSTREAMPARSER_H
@@ -7,6 +7,9 @@
 #include "CompileRequest.h"
 #include "CompileResult.h"
 
+class CompileJob;
+class QObject;
+
 /**
  * @brief Abstract interface for C++ compilers
  */
@@ -63,6 +66,25 @@ public:
      */
     virtual CompileResult compile(const CompileRequest& request) = 0;
     
+    /**
+     * @brief Create an asynchronous, cancellable compilation job
+     *
+     * The returned job is idle until CompileJob::start() is called; it then
+     * runs through CompileJobQueue without blocking the caller.
+     *
+     * @param request Compilation request with all parameters
+     * @param parent QObject parent that takes ownership of the job
+     * @return New job handle
+     */
+    virtual CompileJob* compileAsync(const CompileRequest& request, QObject* parent = nullptr) = 0;
+    
+    /**
+     * @brief Parse compiler diagnostic output into structured messages
+     * @param output Compiler output (stdout/stderr)
+     * @return List of diagnostic messages
+     */
+    virtual QList<DiagnosticMessage> parseDiagnosticOutput(const QString& output) const = 0;
+    
     /**
      * @brief Run a compiled executable
      * @param exePath Path to the executable
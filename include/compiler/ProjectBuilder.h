@@ -0,0 +1,139 @@
+#ifndef PROJECTBUILDER_H
+#define PROJECTBUILDER_H
+
+#include <QObject>
+#include <QList>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QElapsedTimer>
+#include "CompileRequest.h"
+#include "CompileResult.h"
+
+class Project;
+class ICompiler;
+class CompileJob;
+
+/**
+ * @brief Incremental, parallel build of a multi-file Project.
+ *
+ * Every entry of Project::sourceFiles() is compiled to its own object file
+ * under <outputDirectory>/obj, followed by a single link step producing
+ * <outputDirectory>/<project name>.  Compiles are issued as CompileJobs, so
+ * they run concurrently up to CompileJobQueue's limit.
+ *
+ * A translation unit is skipped when its object file is newer than every
+ * file listed in the compiler-emitted dependency file (-MMD) and the
+ * command line that produced it is unchanged (recorded in a ".cmd" stamp
+ * next to the object).  The link is skipped when no object changed and the
+ * executable is newer than all objects.
+ */
+class ProjectBuilder : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ProjectBuilder(QObject* parent = nullptr);
+    ~ProjectBuilder() override;
+
+    /**
+     * @brief Start building a project
+     * @param project Project whose sources are compiled
+     * @param compiler Compiler used for every compile and the link
+     * @param standard C++ standard (e.g. "c++17")
+     * @param extraFlags Flags added in front of the project's own flags
+     * @return false if a build is already running or the project has no sources
+     */
+    bool build(const Project* project, const QSharedPointer<ICompiler>& compiler,
+               const QString& standard, const QStringList& extraFlags = QStringList());
+
+    /**
+     * @brief Cancel all outstanding compile/link jobs
+     */
+    void cancel();
+
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief Directory of the project being (or last) built
+     */
+    QString projectDirectory() const { return m_projectDirectory; }
+
+    /**
+     * @brief Path of the executable produced for a project
+     */
+    static QString executablePathFor(const Project* project);
+
+    /**
+     * @brief Directory holding object, dependency and stamp files
+     */
+    static QString objectDirectoryFor(const Project* project);
+
+    /**
+     * @brief Parse a Makefile-style dependency file written by -MMD/-MF
+     * @param contents File contents ("target: dep1 dep2 \\\n dep3 ...")
+     * @return Prerequisites in order of appearance (the target is dropped)
+     */
+    static QStringList parseDependencyFile(const QString& contents);
+
+signals:
+    void progressMessage(const QString& message);
+    void outputReceived(const QString& text, bool fromStderr);
+
+    /**
+     * @brief Emitted as any compile job parses new diagnostics
+     */
+    void diagnosticsReceived(const QList<DiagnosticMessage>& diagnostics);
+
+    /**
+     * @brief Emitted as translation units complete
+     * @param completed Units compiled or skipped so far (the link counts as one)
+     * @param total Number of units plus one for the link
+     */
+    void progressChanged(int completed, int total);
+
+    /**
+     * @brief Emitted once with the aggregated result of all compiles and the link
+     */
+    void finished(const CompileResult& result);
+
+private:
+    struct Unit {
+        QString sourceFile;
+        QString objectFile;
+        QString dependencyFile;
+    };
+
+    bool isUpToDate(const Unit& unit, const QByteArray& commandHash) const;
+    bool isLinkUpToDate(const QByteArray& commandHash) const;
+    void startJob(CompileJob* job, const QString& stampFile, const QByteArray& commandHash);
+    void onJobFinished(CompileJob* job, const QString& stampFile,
+                       const QByteArray& commandHash, const CompileResult& result);
+    void startLink();
+    void advance();
+    void finish(bool success, bool cancelled);
+    void reportProgress();
+
+    static QByteArray commandHash(const QString& program, const QStringList& arguments);
+    static QByteArray readStamp(const QString& stampFile);
+    static void writeStamp(const QString& stampFile, const QByteArray& hash);
+
+    QSharedPointer<ICompiler> m_compiler;
+    QString m_projectDirectory;
+    QString m_objectDirectory;
+    QString m_executable;
+    QString m_standard;
+    QStringList m_linkFlags;
+    QList<Unit> m_units;
+    QList<QPointer<CompileJob>> m_jobs;
+
+    bool m_running = false;
+    bool m_queueing = false;
+    bool m_linking = false;
+    bool m_failed = false;
+    bool m_cancelled = false;
+    int m_completed = 0;
+    int m_recompiled = 0;
+    QElapsedTimer m_elapsed;
+    CompileResult m_result;
+};
+
+#endif // PROJECTBUILDER_H
@@ -0,0 +1,42 @@
+#ifndef STDINSOURCE_H
+#define STDINSOURCE_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * @file StdinSource.h
+ * @brief Compiler arguments for an editor buffer piped on stdin.
+ *
+ * The buffer has no file name, so #include "local.h" would no longer
+ * resolve next to it.  -iquote puts the file's directory back for quoted
+ * includes only; unlike -I it leaves how <...> includes resolve alone,
+ * as MatrixRunner does for its temp sources.
+ *
+ * Shared by SyntaxChecker, AssemblyRunner and OptRemarksRunner.
+ *
+ * Usage:
+ *
+ *   #include "compiler/StdinSource.h"
+ *
+ *   args << flags << StdinSource::arguments(sourceDirectory);
+ *   process->start(compiler, args);
+ *   process->write(buffer);
+ *   process->closeWriteChannel();
+ */
+
+namespace StdinSource {
+
+/// [-iquote <sourceDirectory>] -x c++ -   (no -iquote when the directory is empty)
+inline QStringList arguments(const QString& sourceDirectory) {
+    QStringList args;
+    if (!sourceDirectory.isEmpty()) {
+        args << QStringLiteral("-iquote") << sourceDirectory;
+    }
+    args << QStringLiteral("-x") << QStringLiteral("c++") << QStringLiteral("-");
+    return args;
+}
+
+} // namespace StdinSource
+
+#endif // STDINSOURCE_H
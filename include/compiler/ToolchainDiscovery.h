@@ -0,0 +1,151 @@
+#ifndef TOOLCHAINDISCOVERY_H
+#define TOOLCHAINDISCOVERY_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Result of probing a tool binary (e.g. "g++ --version")
+ */
+struct ToolProbe {
+    QString path;            // Absolute path of the binary
+    bool available = false;  // Process started and exited with code 0
+    QString output;          // Standard output of the probe
+    qint64 mtime = 0;        // Binary modification time (ms since epoch)
+};
+
+/**
+ * @brief Compiler candidate found on PATH or in a well-known location
+ */
+struct CompilerCandidate {
+    QString id;      // e.g. "gcc-system", "clang-18"
+    QString family;  // "gcc" or "clang"
+    QString path;    // Absolute path of the binary
+};
+
+/**
+ * @brief Cached, parallel discovery of compilers and tools
+ *
+ * Every "is this tool there and which version is it" question goes through
+ * this service instead of spawning a process per call.  Probe results are
+ * kept in memory and persisted to QStandardPaths::CacheLocation, keyed by
+ * binary path, probe arguments and the binary's mtime — an upgraded
+ * compiler is re-probed, an unchanged one never is.
+ *
+ * Startup discovery runs on a worker thread and probes all candidates
+ * concurrently; discoveryFinished() is delivered to the GUI thread when it
+ * completes.  cachedProbe() is an O(1) lookup that never blocks.
+ */
+class ToolchainDiscovery : public QObject {
+    Q_OBJECT
+
+public:
+    static ToolchainDiscovery& instance();
+
+    /**
+     * @brief Probe a binary, using the cache when possible
+     *
+     * Blocks on a cache miss.  Bare names are resolved through PATH.
+     * @param program Executable path or name
+     * @param args Probe arguments
+     */
+    ToolProbe probe(const QString& program,
+                    const QStringList& args = QStringList{QStringLiteral("--version")});
+
+    /**
+     * @brief Return a cached probe without ever spawning a process
+     * @return The cached result; available is false if never probed
+     */
+    ToolProbe cachedProbe(const QString& program,
+                          const QStringList& args = QStringList{QStringLiteral("--version")}) const;
+
+    /**
+     * @brief Check whether a probe result is cached
+     */
+    bool isCached(const QString& program,
+                  const QStringList& args = QStringList{QStringLiteral("--version")}) const;
+
+    /**
+     * @brief Probe several binaries concurrently; blocks until all are done
+     *
+     * Binaries that already have a cached result are skipped.
+     */
+    void probeAll(const QStringList& programs,
+                  const QStringList& args = QStringList{QStringLiteral("--version")});
+
+    /**
+     * @brief Find g++/clang++ binaries, including versioned ones (g++-13)
+     *
+     * Only inspects the filesystem; no process is spawned.  Candidates are
+     * de-duplicated by canonical path, so a g++ symlink to g++-13 is
+     * reported once.
+     */
+    QList<CompilerCandidate> findCompilerCandidates() const;
+
+    /**
+     * @brief Start background discovery of compilers and extra tools
+     *
+     * Emits discoveryFinished() when done.  Calls while a discovery is
+     * already running are ignored.
+     * @param extraTools Additional binaries (with their probe arguments)
+     */
+    void startDiscovery(const QList<QPair<QString, QStringList>>& extraTools = {});
+
+    bool isDiscovering() const;
+
+    /**
+     * @brief Compiler candidates found by the last completed discovery
+     */
+    QList<CompilerCandidate> discoveredCompilers() const;
+
+    /**
+     * @brief Forget every cached probe (memory and disk)
+     */
+    void clear();
+
+    /**
+     * @brief Resolve a bare executable name through PATH
+     * @return Absolute path, or @p program unchanged if it is already a path
+     */
+    static QString resolveExecutable(const QString& program);
+
+    /**
+     * @brief Parse a versioned compiler file name
+     * @param fileName e.g. "g++-13", "clang++-18.exe"
+     * @param family Receives "gcc" or "clang"
+     * @param suffix Receives the version suffix ("13"), empty for plain names
+     * @return true if the name is a C++ compiler driver
+     */
+    static bool parseCompilerFileName(const QString& fileName, QString* family,
+                                      QString* suffix);
+
+signals:
+    void discoveryFinished();
+
+private:
+    ToolchainDiscovery();
+    ~ToolchainDiscovery() override = default;
+    ToolchainDiscovery(const ToolchainDiscovery&) = delete;
+    ToolchainDiscovery& operator=(const ToolchainDiscovery&) = delete;
+
+    static QString probeKey(const QString& path, const QStringList& args);
+    static ToolProbe runProbe(const QString& path, const QStringList& args);
+    void insertProbe(const QString& key, const ToolProbe& result);
+    QString cacheFilePath() const;
+    void loadCache();
+    void saveCache();
+
+    mutable QMutex m_mutex;
+    QMutex m_saveMutex;
+    QHash<QString, ToolProbe> m_probes;
+    QList<CompilerCandidate> m_discovered;
+    bool m_discovering = false;
+    bool m_dirty = false;
+};
+
+#endif // TOOLCHAINDISCOVERY_H
@@ -0,0 +1,168 @@
+#ifndef ARTIFACTCACHE_H
+#define ARTIFACTCACHE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+class QCryptographicHash;
+
+/**
+ * @brief Persistent, content-addressed cache for build and tool artifacts.
+ *
+ * Artifacts (executables, objects, generated assembly, C++ Insights output)
+ * are stored under a key derived from everything that determines them:
+ * the source contents — including any local headers pulled in via
+ * <tt>#include "..."</tt> — the tool id and version, and the full flag list.
+ * An unchanged request therefore maps to the same key and can be served
+ * from disk without respawning the compiler or tool.
+ *
+ * Entries live in QStandardPaths::CacheLocation/artifacts.  The total size
+ * is bounded by maxSizeBytes(); when a store exceeds it, the least recently
+ * used entries are evicted.  Hits only mark the on-disk index dirty; it is
+ * written with the next store, at most every INDEX_SAVE_INTERVAL_MS on
+ * hits, and when the application quits.  An optional log (e.g. compiler warnings) can be
+ * kept next to an artifact so that a cache hit can replay it.
+ *
+ * Usage:
+ * @code
+ *   ArtifactCache* cache = ArtifactCache::instance();
+ *   const QString key = cache->keyForSource(ArtifactCache::Kind::Assembly,
+ *                                           src, compilerId, version, flags);
+ *   QByteArray asmText;
+ *   if (!cache->lookupData(key, &asmText)) {
+ *       ... run the compiler, then cache->storeData(key, asmText);
+ *   }
+ * @endcode
+ */
+class ArtifactCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Kind {
+        Executable,
+        Object,
+        Assembly,
+        Insights
+    };
+
+    struct Stats {
+        qint64 hits = 0;        // Lookups served from the cache (this session)
+        qint64 misses = 0;      // Lookups that found nothing (this session)
+        qint64 evictions = 0;   // Entries dropped by the LRU limit (this session)
+        int entryCount = 0;
+        qint64 totalBytes = 0;
+    };
+
+    static ArtifactCache* instance();
+
+    /**
+     * @brief Compute a cache key from raw inputs
+     * @param kind Artifact kind (part of the key)
+     * @param sourceDigest Digest or contents of the source input
+     * @param toolId Compiler/tool identifier
+     * @param toolVersion Compiler/tool version string
+     * @param flags Full flag list, excluding output paths
+     * @return Hex SHA-256 key
+     */
+    static QString computeKey(Kind kind, const QByteArray& sourceDigest,
+                              const QString& toolId, const QString& toolVersion,
+                              const QStringList& flags);
+
+    /**
+     * @brief Compute a cache key for a source file on disk
+     *
+     * Local headers included with quotes are hashed recursively as well.
+     * @return Key, or an empty string if the source cannot be read
+     */
+    static QString keyForSource(Kind kind, const QString& sourceFile,
+                                const QString& toolId, const QString& toolVersion,
+                                const QStringList& flags);
+
+    /**
+     * @brief Look up a file artifact
+     * @param key Key from computeKey()/keyForSource()
+     * @param log Receives the stored log, if any
+     * @return Path of the cached file, or an empty string on a miss
+     */
+    QString lookup(const QString& key, QByteArray* log = nullptr);
+
+    /**
+     * @brief Copy a file artifact into the cache
+     *
+     * The copy replaces an existing artifact atomically (temporary file
+     * renamed over it); the entry is only recorded once the rename succeeded.
+     * @return true if the artifact was stored
+     */
+    bool store(const QString& key, const QString& artifactPath,
+               const QByteArray& log = QByteArray());
+
+    /**
+     * @brief Look up an in-memory artifact (assembly text, insights output)
+     */
+    bool lookupData(const QString& key, QByteArray* data, QByteArray* log = nullptr);
+
+    /**
+     * @brief Store an in-memory artifact
+     */
+    bool storeData(const QString& key, const QByteArray& data,
+                   const QByteArray& log = QByteArray());
+
+    /**
+     * @brief Remove every entry and reset the statistics
+     */
+    void clear();
+
+    Stats stats() const;
+    QString cacheDirectory() const { return m_directory; }
+
+    qint64 maxSizeBytes() const;
+    void setMaxSizeBytes(qint64 bytes);
+
+    static constexpr qint64 DEFAULT_MAX_SIZE_BYTES = 512LL * 1024 * 1024;
+    /// Least time between index writes caused by lookups alone
+    static constexpr int INDEX_SAVE_INTERVAL_MS = 30000;
+
+signals:
+    void statsChanged();
+
+private:
+    explicit ArtifactCache(QObject* parent = nullptr);
+    ~ArtifactCache() override;
+
+    struct Entry {
+        qint64 size = 0;
+        qint64 lastUsed = 0;    // ms since epoch
+    };
+
+    QString artifactPath(const QString& key) const;
+    QString logPath(const QString& key) const;
+    bool findEntry(const QString& key, QByteArray* log);
+    bool commitEntry(const QString& key, const QByteArray& log);
+    void removeEntryFiles(const QString& key);
+    void evictIfNeeded();
+    void loadIndex();
+    void saveIndex();
+    void saveIndexIfDirty();
+
+    static bool hashSourceRecursive(const QString& filePath, const QStringList& includeDirs,
+                                    QCryptographicHash& hash, QStringList& visited, int depth);
+
+    static ArtifactCache* s_instance;
+
+    mutable QMutex m_mutex;
+    QString m_directory;
+    QHash<QString, Entry> m_entries;
+    qint64 m_totalBytes = 0;
+    qint64 m_maxSizeBytes = DEFAULT_MAX_SIZE_BYTES;
+    bool m_indexDirty = false;
+    QElapsedTimer m_sinceIndexSave;
+    Stats m_stats;
+};
+
+#endif // ARTIFACTCACHE_H
@@ -0,0 +1,54 @@
+#ifndef GROUPEDPROCESS_H
+#define GROUPEDPROCESS_H
+
+#include <QProcess>
+
+/**
+ * @brief QProcess that leads its own process group, killed as a whole.
+ *
+ * A compiler driver (g++, clang++) forks cc1plus/as to do the work, and a
+ * plain QProcess::kill() only reaches the driver: the real compiler keeps
+ * running.  GroupedProcess puts the child in a new process group between
+ * fork and exec, the way ProcessMeter does, so killAndRelease() signals
+ * everything the driver spawned.
+ *
+ * killAndRelease() never blocks.  The process is detached from its parent
+ * and owner and deletes itself once finished() reports it reaped, instead
+ * of waitForFinished() on the GUI thread.
+ *
+ * Usage:
+ * @code
+ *   m_process = new GroupedProcess(this);
+ *   connect(m_process, ...);
+ *   m_process->start(program, args);
+ *   ...
+ *   m_process->killAndRelease();   // Stale: no more signals, no wait
+ *   m_process = nullptr;
+ * @endcode
+ *
+ * On Windows there are no process groups; only the process itself is killed.
+ */
+class GroupedProcess : public QProcess {
+    Q_OBJECT
+
+public:
+    explicit GroupedProcess(QObject* parent = nullptr);
+
+    /** SIGKILL the whole group; finished() follows once the leader is reaped. */
+    void killGroup();
+
+    /**
+     * @brief Disconnect every receiver, kill the group and delete once reaped
+     *
+     * The caller must drop its pointer; a process that is not running is
+     * deleted with deleteLater() right away.
+     */
+    void killAndRelease();
+
+#if defined(Q_OS_UNIX) && QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+protected:
+    void setupChildProcess() override;
+#endif
+};
+
+#endif // GROUPEDPROCESS_H
@@ -0,0 +1,48 @@
+#ifndef THREADPOOLTASK_H
+#define THREADPOOLTASK_H
+
+#include <QRunnable>
+#include <QThreadPool>
+#include <QtGlobal>
+#include <functional>
+#include <utility>
+
+/**
+ * @file ThreadPoolTask.h
+ * @brief Run a lambda on a QThreadPool.
+ *
+ * QThreadPool::start(std::function<void()>) only exists from Qt 5.15 on;
+ * older Qt5 gets an equivalent auto-deleting QRunnable.
+ *
+ * Usage:
+ *
+ *   #include "core/ThreadPoolTask.h"
+ *
+ *   ThreadPoolTask::start(&m_pool, [this]() { ... });
+ */
+
+namespace ThreadPoolTask {
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+class FunctionRunnable : public QRunnable {
+public:
+    explicit FunctionRunnable(std::function<void()> fn) : m_fn(std::move(fn)) {}
+    void run() override { m_fn(); }
+
+private:
+    std::function<void()> m_fn;
+};
+#endif
+
+/// Queue @p fn on @p pool; the pool owns and deletes the task.
+inline void start(QThreadPool* pool, std::function<void()> fn) {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    pool->start(std::move(fn));
+#else
+    pool->start(new FunctionRunnable(std::move(fn)));
+#endif
+}
+
+} // namespace ThreadPoolTask
+
+#endif // THREADPOOLTASK_H
@@ -4,7 +4,14 @@
 #include <Qsci/qsciscintilla.h>
 #include <Qsci/qscilexercpp.h>
 #include <Qsci/qsciapis.h>
+#include <QHash>
 #include <QMap>
+#include "compiler/CompileResult.h"
+#include "tools/OptRemark.h"
+#include "tools/SourceHeat.h"
+
+class HeatMargin;
+class SyntaxChecker;
 
 /**
  * @brief Code editor widget with C++ syntax highlighting and QScintilla features
@@ -94,13 +101,62 @@ public:
      * @brief Apply font, line-number visibility and word-wrap settings.
      */
     void applyEditorSettings(const QFont& font, bool showLineNumbers, bool wordWrap);
+
+    /**
+     * @brief Background -fsyntax-only checker for this editor's buffer
+     */
+    SyntaxChecker* syntaxChecker() const { return m_syntaxChecker; }
+
+    /**
+     * @brief Replace error/warning markers with the given diagnostics
+     * @param diagnostics Diagnostics for this buffer (1-based lines)
+     */
+    void showDiagnostics(const QList<DiagnosticMessage>& diagnostics);
+
+    /**
+     * @brief Replace optimization-remark markers with the given remarks
+     *
+     * Lines with a missed optimization get a "missed" marker, lines where
+     * only optimizations were applied a "passed" one; hovering a marked
+     * line shows every remark for it.  Analysis notes only appear in the
+     * tooltip.
+     * @param remarks Remarks for this buffer (1-based lines)
+     */
+    void showOptRemarks(const QList<OptRemark>& remarks);
+
+    /**
+     * @brief Remove optimization-remark markers and tooltips
+     */
+    void clearOptRemarks();
+
+    /**
+     * @brief Shade the heat margin by what each line's generated code costs
+     *
+     * Hovering the margin shows the line's instruction count and, once
+     * measured, its code bytes.
+     * @param heat   Per-line costs for this buffer (1-based lines)
+     * @param metric Which cost decides the shade
+     */
+    void showHeatmap(const SourceHeat& heat, SourceHeat::Metric metric);
+
+    /**
+     * @brief Remove the heat shading and hide its margin
+     */
+    void clearHeatmap();
     
 signals:
     void modificationChanged(bool modified);
+
+    /**
+     * @brief Emitted when a background syntax check has updated the markers
+     */
+    void syntaxDiagnosticsChanged(const QList<DiagnosticMessage>& diagnostics);
     
 private slots:
     void onTextChanged();
     void onThemeChanged(const QString& themeName);
+    void onSyntaxCheckFinished(const QList<DiagnosticMessage>& diagnostics, qint64 elapsedMs);
+    void onDwellStart(int position, int x, int y);
     
 private:
     void setupEditor();
@@ -116,6 +172,11 @@ private:
     int m_errorMarkerHandle = -1;
     int m_warningMarkerHandle = -1;
     QMap<int, QString> m_errorMarkers;  // line -> error message
+    int m_remarkPassedMarkerHandle = -1;
+    int m_remarkMissedMarkerHandle = -1;
+    QHash<int, QString> m_remarkTooltips;  // marker handle -> remarks (markers follow edits)
+    HeatMargin* m_heatMargin = nullptr;
+    SyntaxChecker* m_syntaxChecker = nullptr;
     bool m_isModified = false;
 };
 
@@ -79,6 +79,15 @@ public:
      * @param newPath New file path
      */
     void updateFilePath(const QString& oldPath, const QString& newPath);
+
+    /**
+     * @brief Configure background syntax checking for all editors
+     * @param compilerId Compiler used for -fsyntax-only checks
+     * @param standard C++ standard (e.g. "c++17")
+     * @param enabled false turns live checking off
+     */
+    void setSyntaxCheckOptions(const QString& compilerId, const QString& standard,
+                               bool enabled = true);
     
 signals:
     void editorChanged(CodeEditor* editor);
@@ -99,6 +108,14 @@ private slots:
     
 private:
     int m_newFileCounter = 1;
+    QString m_syntaxCompilerId;
+    QString m_syntaxStandard = "c++17";
+    bool m_syntaxCheckEnabled = true;
+
+    /**
+     * @brief Apply the syntax check options to one editor
+     */
+    void configureSyntaxChecker(CodeEditor* editor) const;
     
     /**
      * @brief Update tab title for editor
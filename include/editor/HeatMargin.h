@@ -0,0 +1,59 @@
+#ifndef HEATMARGIN_H
+#define HEATMARGIN_H
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include "tools/SourceHeat.h"
+
+class QsciScintilla;
+
+/**
+ * @brief Narrow margin that colours source lines by how much code they cost
+ *
+ * Owns one QScintilla margin and LEVELS full-rectangle markers shaded from
+ * the margin background to the theme's error colour; each line with code
+ * gets the marker for its share of the hottest line.  Used by CodeEditor
+ * and by AssemblyWidget's source mirror, as a child of the editor.  The
+ * margin is hidden while nothing is shown.
+ */
+class HeatMargin : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int LEVELS = 8;
+
+    /**
+     * @param editor  Editor to draw in; also the parent
+     * @param margin  Margin index to take over (markers of other margins are
+     *                masked out of it, and its markers out of them)
+     */
+    HeatMargin(QsciScintilla* editor, int margin);
+
+    /**
+     * @brief Replace the shading with @p heat measured by @p metric
+     */
+    void show(const SourceHeat& heat, SourceHeat::Metric metric);
+
+    void clear();
+
+    bool isEmpty() const { return m_handles.isEmpty(); }
+
+    /** Re-read marker colours from the current theme. */
+    void applyTheme();
+
+    /**
+     * @brief Tooltip for a dwell at viewport point (@p x, @p y)
+     * @return The line's costs when the point is over this margin, else empty
+     */
+    QString toolTipAt(int x, int y) const;
+
+private:
+    QsciScintilla* m_editor;
+    int m_margin;
+    int m_firstMarker = -1;
+    SourceHeat m_heat;
+    QHash<int, int> m_handles;   // marker handle -> 1-based source line (markers follow edits)
+};
+
+#endif // HEATMARGIN_H
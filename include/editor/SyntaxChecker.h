@@ -0,0 +1,108 @@
+#ifndef SYNTAXCHECKER_H
+#define SYNTAXCHECKER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QProcess>
+#include "compiler/CompileResult.h"
+
+class GroupedProcess;
+class QTimer;
+
+/**
+ * @brief Debounced background "-fsyntax-only" checker for one editor
+ *
+ * scheduleCheck() (re)starts a debounce timer; when it fires the current
+ * buffer is piped to the selected compiler on stdin:
+ *
+ *   <compiler> -fsyntax-only -std=<std> -iquote <file dir> -x c++ -
+ *
+ * Nothing is written to disk.  A new edit marks the in-flight check stale
+ * without killing it; if it is still running when the debounce fires, its
+ * whole process group (driver and cc1plus) is killed.  So at most one
+ * checker runs per editor, stale results are never reported and typing
+ * never waits on a compiler.  Only diagnostics that point into the buffer itself
+ * (file "<stdin>") are emitted; errors inside included headers are not.
+ */
+class SyntaxChecker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SyntaxChecker(QObject* parent = nullptr);
+    ~SyntaxChecker() override;
+
+    void setCompilerId(const QString& compilerId);
+    QString compilerId() const { return m_compilerId; }
+
+    void setStandard(const QString& standard);
+    QString standard() const { return m_standard; }
+
+    /**
+     * @brief Directory of the checked file; used for -iquote and as working dir
+     */
+    void setSourceDirectory(const QString& directory);
+
+    /**
+     * @brief Enable or disable checking; disabling cancels any pending check
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    void setDebounceMs(int ms);
+    int debounceMs() const;
+
+    /**
+     * @brief Schedule a check of @p source after the debounce interval
+     *
+     * A check still running for an older buffer is left to finish, its
+     * result dropped; the new check kills it if it is still running.
+     */
+    void scheduleCheck(const QString& source);
+
+    /**
+     * @brief Drop the pending check and kill the running one, if any
+     *
+     * Does not wait: the killed compiler is reaped in the background.
+     */
+    void cancel();
+
+    bool isRunning() const;
+
+    /**
+     * @brief Build the checker command line (without the program)
+     */
+    static QStringList buildArguments(const QString& standard, const QString& sourceDirectory);
+
+    static constexpr int DEFAULT_DEBOUNCE_MS = 400;
+    static constexpr int TIMEOUT_MS = 5000;
+
+signals:
+    /**
+     * @brief Emitted when a check completes for the latest buffer
+     * @param diagnostics Diagnostics located in the buffer (may be empty)
+     * @param elapsedMs Wall time of the compiler run
+     */
+    void diagnosticsReady(const QList<DiagnosticMessage>& diagnostics, qint64 elapsedMs);
+
+private slots:
+    void runCheck();
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+    void onProcessError(QProcess::ProcessError error);
+
+private:
+    void killProcess();
+
+    QString m_compilerId;
+    QString m_standard = "c++17";
+    QString m_sourceDirectory;
+    QString m_pendingSource;
+    bool m_enabled = true;
+
+    QTimer* m_debounceTimer = nullptr;
+    QTimer* m_timeoutTimer = nullptr;
+    GroupedProcess* m_process = nullptr;
+    bool m_staleProcess = false;   // m_process checks an older buffer
+    QElapsedTimer m_elapsed;
+};
+
+#endif // SYNTAXCHECKER_H
@@ -31,6 +31,10 @@ class WelcomeScreen;
 class FileManager;
 class SettingsDialog;
 class QuizAdminPanel;
+class CompileJob;
+class ProjectBuilder;
+class OptRemarksRunner;
+struct CompileResult;
 
 class MainWindow : public QMainWindow
 {
@@ -86,6 +90,7 @@ private slots:
     void onBuildCompileAndRun();
     void onBuildStop();
     void onBuildClean();
+    void onBuildRemarks();
 
     // View menu
     void onViewToggleFileTree();
@@ -147,10 +152,14 @@ private:
     QString getCurrentSourceFile();
     QString getExecutablePath(const QString& sourceFile);
     void showBuildError(const QString& message);
+    bool startBuild();
+    bool startProjectBuild(Project* project);
+    void onBuildFinished(const CompileResult& result);
     void saveCurrentSession();
     void restoreProjectSession(Project* project);
     void showProjectLoadError(Project::LoadResult result);
     void showAboutDialog();
+    void showArtifactCacheDialog();
     void wireFindReplaceDialog(FindReplaceDialog* dialog, CodeEditor* editor);
 
     // Constants
@@ -223,6 +232,12 @@ private:
     FileManager*  m_fileManager      = nullptr;
     Project*      m_project          = nullptr;
     QString       m_currentExecutable;
+    QPointer<CompileJob> m_buildJob;
+    ProjectBuilder* m_projectBuilder = nullptr;
+    OptRemarksRunner* m_remarksRunner = nullptr;
+    QPointer<CodeEditor> m_remarksEditor;   // Editor the last remarks were collected for
+    QPointer<CodeEditor> m_heatEditor;      // Editor currently shaded by the heat map
+    bool          m_runAfterBuild    = false;
     bool          m_dragging         = false;
     QPoint        m_dragPosition;
     bool          m_fileTreeOnLeft   = true;
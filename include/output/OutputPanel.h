@@ -5,9 +5,10 @@
 
 class TerminalWidget;
 class ProblemsWidget;
+class RemarksWidget;
 
 /**
- * @brief Container for output tabs (Terminal, Problems)
+ * @brief Container for output tabs (Terminal, Problems, Remarks)
  */
 class OutputPanel : public QTabWidget {
     Q_OBJECT
@@ -27,6 +28,12 @@ public:
      * @return Pointer to problems widget
      */
     ProblemsWidget* problems() const { return m_problems; }
+
+    /**
+     * @brief Get optimization remarks widget
+     * @return Pointer to remarks widget
+     */
+    RemarksWidget* remarks() const { return m_remarks; }
     
     /**
      * @brief Show terminal tab
@@ -38,12 +45,18 @@ public:
      */
     void showProblemsTab();
 
+    /**
+     * @brief Show remarks tab
+     */
+    void showRemarksTab();
+
 private slots:
     void applyTheme();
     
 private:
     TerminalWidget* m_terminal = nullptr;
     ProblemsWidget* m_problems = nullptr;
+    RemarksWidget* m_remarks = nullptr;
 };
 
 #endif // OUTPUTPANEL_H
@@ -0,0 +1,79 @@
+#ifndef PROBLEMSMODEL_H
+#define PROBLEMSMODEL_H
+
+#include <QAbstractItemModel>
+#include <QVector>
+#include "compiler/CompileResult.h"
+
+class QColor;
+
+/**
+ * @brief Two-level item model of compiler diagnostics
+ *
+ * Top-level rows are errors/warnings; their notes and "required from"
+ * context (DiagnosticMessage::children) are child rows.  Rows are only
+ * ever appended, in batches, so a view stays responsive while thousands
+ * of diagnostics stream in.
+ */
+class ProblemsModel : public QAbstractItemModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        IconColumn,
+        SeverityColumn,
+        MessageColumn,
+        FileColumn,
+        PositionColumn,
+        ColumnCount
+    };
+
+    enum Role {
+        SeverityRole = Qt::UserRole + 1,  // DiagnosticMessage::Severity as int
+        FilePathRole,                     // Full file path
+        LineRole,
+        ColumnRole
+    };
+
+    explicit ProblemsModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Append top-level diagnostics in one row insertion
+     */
+    void appendDiagnostics(const QList<DiagnosticMessage>& diagnostics);
+
+    /**
+     * @brief Remove every row
+     */
+    void clear();
+
+    /**
+     * @brief Diagnostic behind an index (top-level or child)
+     * @return nullptr for an invalid index
+     */
+    const DiagnosticMessage* diagnosticAt(const QModelIndex& index) const;
+
+    int errorCount() const { return m_errorCount; }
+    int warningCount() const { return m_warningCount; }
+
+    // ── QAbstractItemModel ───────────────────────────────────────────────────
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    static QString severityIcon(DiagnosticMessage::Severity severity);
+    static QString severityText(DiagnosticMessage::Severity severity);
+    static QColor severityColor(DiagnosticMessage::Severity severity);
+
+private:
+    // Top-level rows carry internalId 0; child rows carry (parent row + 1)
+    QVector<DiagnosticMessage> m_items;
+    int m_errorCount = 0;
+    int m_warningCount = 0;
+};
+
+#endif // PROBLEMSMODEL_H
@@ -2,13 +2,22 @@
 #define PROBLEMSWIDGET_H
 
 #include <QWidget>
-#include <QTableWidget>
+#include <QTreeView>
 #include <QComboBox>
 #include <QPushButton>
 #include "compiler/CompileResult.h"
 
+class ProblemsModel;
+class QSortFilterProxyModel;
+class QTimer;
+
 /**
- * @brief Widget for displaying compiler diagnostics in a table
+ * @brief Widget for displaying compiler diagnostics in a tree
+ *
+ * Errors and warnings are top-level rows; their notes and template
+ * instantiation context can be expanded underneath.  Diagnostics streamed
+ * in with appendDiagnostics() are buffered and inserted in batches so a
+ * flood of errors does not stall the UI.
  */
 class ProblemsWidget : public QWidget {
     Q_OBJECT
@@ -22,6 +31,12 @@ public:
      * @param diagnostics List of diagnostic messages
      */
     void setDiagnostics(const QList<DiagnosticMessage>& diagnostics);
+
+    /**
+     * @brief Queue diagnostics for display; rows are added in batches
+     * @param diagnostics Newly parsed diagnostic messages
+     */
+    void appendDiagnostics(const QList<DiagnosticMessage>& diagnostics);
     
     /**
      * @brief Clear all diagnostics
@@ -39,19 +54,25 @@ public:
      * @return Number of warnings
      */
     int warningCount() const;
+
+    static constexpr int BATCH_INTERVAL_MS = 50;
     
 signals:
     void diagnosticClicked(const QString& file, int line, int column);
     
 private slots:
     void onFilterChanged(int index);
-    void onCellClicked(int row, int column);
+    void onItemClicked(const QModelIndex& index);
+    void flushPending();
     
 private:
-    QTableWidget* m_tableWidget;
+    QTreeView* m_treeView;
     QComboBox* m_filterCombo;
     QPushButton* m_clearButton;
-    QList<DiagnosticMessage> m_diagnostics;
+    ProblemsModel* m_model;
+    QSortFilterProxyModel* m_proxy;
+    QTimer* m_batchTimer;
+    QList<DiagnosticMessage> m_pending;
     
     enum FilterMode {
         All,
@@ -62,10 +83,6 @@ private:
     FilterMode m_filterMode = All;
     
     void setupUi();
-    void updateTable();
-    QString severityIcon(DiagnosticMessage::Severity severity) const;
-    QString severityText(DiagnosticMessage::Severity severity) const;
-    QColor severityColor(DiagnosticMessage::Severity severity) const;
 };
 
 #endif // PROBLEMSWIDGET_H
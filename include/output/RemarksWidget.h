@@ -0,0 +1,99 @@
+#ifndef REMARKSWIDGET_H
+#define REMARKSWIDGET_H
+
+#include <QWidget>
+#include "tools/OptRemark.h"
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QModelIndex;
+class QPushButton;
+class QSortFilterProxyModel;
+class QStandardItemModel;
+class QTreeView;
+
+/**
+ * @brief Output tab listing the optimizer's remarks for the active file
+ *
+ * Layout:
+ *   [Opt▾ | Show: All/Optimized/Missed/Analysis▾ | filter text | status | ▶ Collect | Clear]
+ *   [Kind | Pass | Message | Function | Line:Col]
+ *
+ * The widget only displays remarks; MainWindow owns the OptRemarksRunner,
+ * starts it on runRequested() and feeds the result to setRemarks().
+ * The text filter matches message, pass and function.
+ */
+class RemarksWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit RemarksWidget(QWidget* parent = nullptr);
+    ~RemarksWidget() override = default;
+
+    enum Column {
+        KindColumn,
+        PassColumn,
+        MessageColumn,
+        FunctionColumn,
+        PositionColumn,
+        ColumnCount
+    };
+
+    enum Role {
+        KindRole = Qt::UserRole + 1,   // OptRemark::Kind as int
+        FileRole,
+        LineRole,
+        ColumnRole
+    };
+
+    /**
+     * @brief Replace the list with @p remarks
+     */
+    void setRemarks(const QList<OptRemark>& remarks);
+
+    /**
+     * @brief Remove every remark
+     */
+    void clear();
+
+    /**
+     * @brief Switch the toolbar between idle and collecting
+     */
+    void setRunning(bool running);
+
+    void setStatusText(const QString& text);
+
+    /** -O flag to collect remarks with ("-O2"). */
+    QString optimizationFlag() const;
+
+    int remarkCount() const;
+
+signals:
+    void runRequested();
+    void remarkClicked(const QString& file, int line, int column);
+
+    /** The user pressed Clear; editor markers should go too. */
+    void cleared();
+
+private slots:
+    void onKindFilterChanged(int index);
+    void onTextFilterChanged(const QString& text);
+    void onItemClicked(const QModelIndex& index);
+
+private:
+    void setupUi();
+    void updateSummary();
+
+    QComboBox*   m_optCombo    = nullptr;
+    QComboBox*   m_kindCombo   = nullptr;
+    QLineEdit*   m_filterEdit  = nullptr;
+    QLabel*      m_statusLabel = nullptr;
+    QPushButton* m_runButton   = nullptr;
+    QPushButton* m_clearButton = nullptr;
+    QTreeView*   m_treeView    = nullptr;
+    QStandardItemModel*    m_model = nullptr;
+    QSortFilterProxyModel* m_proxy = nullptr;
+};
+
+#endif // REMARKSWIDGET_H
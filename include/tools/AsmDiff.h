@@ -0,0 +1,84 @@
+#ifndef ASMDIFF_H
+#define ASMDIFF_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include "tools/AsmDocument.h"
+
+/**
+ * @brief Per-function comparison between two listings.
+ */
+struct AsmFunctionDelta {
+    QString symbol;                 ///< Mangled name; functions are matched on it
+    QString name;                   ///< Display name
+    int     leftInstructions  = -1; ///< -1 = function absent on that side
+    int     rightInstructions = -1;
+    qint64  leftBytes  = -1;        ///< Machine-code size, -1 = unknown
+    qint64  rightBytes = -1;
+    int     removed = 0;            ///< Instructions only in the left listing
+    int     added   = 0;            ///< Instructions only in the right listing
+
+    int instructionDelta() const {
+        return qMax(rightInstructions, 0) - qMax(leftInstructions, 0);
+    }
+    bool changed() const {
+        return removed > 0 || added > 0 || leftInstructions != rightInstructions;
+    }
+};
+
+/**
+ * @brief Result of AsmDiff::compare(): what changed, per function and per line.
+ */
+struct AsmDiffResult {
+    QVector<AsmFunctionDelta> functions;   ///< Left order, then right-only functions
+    QVector<int> removedLines;             ///< 0-based lines of the left AsmDocument
+    QVector<int> addedLines;               ///< 0-based lines of the right AsmDocument
+};
+
+/**
+ * @brief Function-aligned instruction diff of two filtered listings.
+ *
+ * Functions are paired by mangled symbol, so reordering between compilers
+ * or flags does not show up as a change; a function present on one side
+ * only counts as entirely added or removed.  Inside a pair, instruction
+ * lines are diffed with Myers' O(ND) algorithm after normalisation, which
+ * collapses whitespace and renames local labels (.L3, .LBB0_2, Ltmp1) so
+ * that renumbering alone is not a difference.
+ *
+ * Pure and thread-safe: meant to run off the GUI thread.
+ */
+class AsmDiff {
+public:
+    static AsmDiffResult compare(const AsmDocument& left, const AsmDocument& right);
+
+    /**
+     * @brief Attach machine-code sizes (by mangled symbol) to @p result
+     */
+    static void applySizes(AsmDiffResult& result,
+                           const QHash<QString, qint64>& leftSizes,
+                           const QHash<QString, qint64>& rightSizes);
+
+    /** Canonical form of an instruction line used for matching. */
+    static QString normalize(const QString& line);
+
+    /**
+     * @brief Assemble @p assembly and read back per-symbol code sizes
+     *
+     * Runs `<compiler> -c -x assembler -` and then `nm -S` on the object.
+     * Blocking; call from a worker thread.  Returns an empty hash when the
+     * listing does not assemble or no nm is installed.
+     */
+    static QHash<QString, qint64> measureFunctionSizes(const QString& compilerPath,
+                                                       const QByteArray& assembly);
+
+    /**
+     * @brief Parse `nm -S` output into symbol → size
+     */
+    static QHash<QString, qint64> parseNmSizes(const QByteArray& nmOutput);
+
+    /// Edit distance beyond which a function pair is reported as fully replaced
+    static constexpr int MAX_EDIT_DISTANCE = 2000;
+};
+
+#endif // ASMDIFF_H
@@ -0,0 +1,117 @@
+#ifndef ASMDOCUMENT_H
+#define ASMDOCUMENT_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief What to hide or rewrite when turning raw -S output into an AsmDocument.
+ *
+ * Defaults match Compiler Explorer's: everything filtered, symbols demangled.
+ */
+struct AsmFilterOptions {
+    bool directives       = true;   ///< Drop .cfi/.loc/.section/... (data after used labels is kept)
+    bool comments         = true;   ///< Drop whole-line comments and trailing label comments
+    bool unusedLabels     = true;   ///< Drop labels nothing jumps to or loads from
+    bool libraryFunctions = true;   ///< Drop functions whose code comes only from other files
+    bool demangle         = true;   ///< _Z3fooi → foo(int)
+
+    bool operator==(const AsmFilterOptions& o) const {
+        return directives == o.directives && comments == o.comments
+            && unusedLabels == o.unusedLabels && libraryFunctions == o.libraryFunctions
+            && demangle == o.demangle;
+    }
+    bool operator!=(const AsmFilterOptions& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief One line of the filtered assembly listing.
+ */
+struct AsmLine {
+    enum class Kind : quint8 {
+        Instruction,
+        Label,
+        Directive,   ///< Only present when directives are not filtered (or data after a label)
+        Comment
+    };
+
+    QString text;             ///< As displayed (demangled if requested)
+    Kind    kind = Kind::Instruction;
+    int     file       = -1;  ///< Index into AsmDocument::files, -1 = no .loc seen
+    int     sourceLine = 0;   ///< 1-based line in that file, 0 = none
+    int     function   = -1;  ///< Index into AsmDocument::functions, -1 = outside any function
+};
+
+/**
+ * @brief A function body in the listing: lines [firstLine, lastLine].
+ */
+struct AsmFunction {
+    QString symbol;           ///< Mangled name as the assembler sees it
+    QString name;             ///< Display name (demangled if requested)
+    int     firstLine = 0;    ///< 0-based index into AsmDocument::lines (the label)
+    int     lastLine  = 0;
+    int     instructions = 0;
+    bool    library   = false;   ///< All its .loc lines point outside the main file
+};
+
+/**
+ * @brief A numbered .file entry.
+ */
+struct AsmSourceFile {
+    int     number = 0;       ///< The assembler's file number
+    QString path;
+    bool    isMain = false;   ///< The translation unit itself rather than a header
+};
+
+/**
+ * @brief Compact, filtered model of one -S listing.
+ *
+ * Produced by AsmParser::parse().  The asm ↔ source index is kept as flat
+ * vectors: each AsmLine carries its own source line, and the reverse
+ * direction is a CSR-style table — the asm lines generated from main-file
+ * line L are srcToAsm[srcOffsets[L] .. srcOffsets[L + 1]).
+ */
+struct AsmDocument {
+    QVector<AsmLine>       lines;
+    QVector<AsmFunction>   functions;
+    QVector<AsmSourceFile> files;
+
+    QVector<int> srcOffsets;   ///< Size = highest main-file line + 2 (empty if no mapping)
+    QVector<int> srcToAsm;     ///< 0-based asm line indices grouped by source line
+
+    int rawLineCount = 0;      ///< Lines in the unfiltered input
+
+    /** The listing as one string, '\n'-separated. */
+    QString text() const {
+        QStringList parts;
+        parts.reserve(lines.size());
+        for (const AsmLine& line : lines) parts << line.text;
+        return parts.join(QLatin1Char('\n'));
+    }
+
+    /** Main-file source line for 0-based asm line @p asmLine, or 0. */
+    int mainSourceLine(int asmLine) const {
+        if (asmLine < 0 || asmLine >= lines.size()) return 0;
+        const AsmLine& l = lines[asmLine];
+        return (l.file >= 0 && files[l.file].isMain) ? l.sourceLine : 0;
+    }
+
+    /** Number of asm lines generated from 1-based main-file line @p srcLine. */
+    int asmCount(int srcLine) const {
+        if (srcLine <= 0 || srcLine + 1 >= srcOffsets.size()) return 0;
+        return srcOffsets[srcLine + 1] - srcOffsets[srcLine];
+    }
+
+    /** 0-based index of the i-th asm line generated from @p srcLine. */
+    int asmLineAt(int srcLine, int i) const {
+        return srcToAsm[srcOffsets[srcLine] + i];
+    }
+
+    /** First asm line (0-based) generated from @p srcLine, or -1. */
+    int firstAsmLine(int srcLine) const {
+        return asmCount(srcLine) > 0 ? asmLineAt(srcLine, 0) : -1;
+    }
+};
+
+#endif // ASMDOCUMENT_H
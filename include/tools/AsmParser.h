@@ -0,0 +1,53 @@
+#ifndef ASMPARSER_H
+#define ASMPARSER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include "tools/AsmDocument.h"
+
+/**
+ * @brief Turns raw GCC/Clang -S output into a filtered AsmDocument.
+ *
+ * The raw text is scanned exactly once, by hand rather than with regular
+ * expressions: every line is classified (label, directive, instruction,
+ * comment) into a small record that remembers its byte range, current
+ * section, .loc position and enclosing function, while .file/.type/.globl
+ * declarations and label references are collected on the way.  Filtering
+ * then walks those records — never the text — and only lines that survive
+ * are turned into QStrings.
+ *
+ * Understands ELF (.type @function / %function), Mach-O and COFF output,
+ * GCC and Clang DWARF 4/5 .file forms ("name", N "name", N "dir" "name")
+ * and debug/unwind sections, which are dropped wholesale with directives.
+ *
+ * A function is a "library" function when it has .loc lines and none of
+ * them point into the main file — std:: instantiations and other inline
+ * header code emitted into this translation unit.
+ */
+class AsmParser {
+public:
+    /**
+     * @param assembly        Raw compiler -S output
+     * @param options         What to filter
+     * @param mainSourcePath  The compiled file; used to pick the main .file
+     *                        entry when the listing names none itself
+     */
+    static AsmDocument parse(const QByteArray& assembly,
+                             const AsmFilterOptions& options = AsmFilterOptions(),
+                             const QString& mainSourcePath = QString());
+
+    /**
+     * @brief Demangle Itanium C++ symbols (with or without the Mach-O "_")
+     *
+     * In-process via abi::__cxa_demangle where the C++ runtime has it,
+     * otherwise in one batched c++filt call.  Symbols that are not
+     * mangled, or fail to demangle, come back unchanged.
+     */
+    static QStringList demangle(const QStringList& symbols);
+
+    /** True for Itanium-mangled names: _Z…, or __Z… on Mach-O. */
+    static bool isMangled(const QByteArray& symbol);
+};
+
+#endif // ASMPARSER_H
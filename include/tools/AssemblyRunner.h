@@ -5,10 +5,11 @@
 #include <QMap>
 #include <QProcess>
 
+class GroupedProcess;
+
 /**
  * @brief Generates assembly output for a C++ source file by invoking the
- * compiler with the \c -S flag (and \c -g for \c .loc directives) and parses
- * the resulting \c .s file to build a source-line ↔ assembly-line map.
+ * compiler with the \c -S flag (and \c -g for \c .loc directives).
  *
  * Invocation (GCC / Clang):
  *   <compiler> -S -g [-masm=intel] [-O<n>] -std=<std> <sourceFile> -o <tmp.s>
@@ -19,6 +20,20 @@
  *
  * Async: emits started(), finished(), progressMessage() from IToolRunner
  * plus lineMapReady() after successful assembly generation.
+ * finished() carries the raw \c .s text; AsmParser turns it into a
+ * filtered AsmDocument with the source-line ↔ assembly-line index.
+ *
+ * runSource() compiles an in-memory buffer instead: the text is piped on
+ * stdin and the listing read from stdout, so nothing touches the disk:
+ *   <compiler> -S -g [-masm=intel] [flags] [-iquote <dir>] -x c++ - -o -
+ *
+ * Starting a new run or calling cancel() kills the in-flight compiler and
+ * everything it spawned (GroupedProcess) without blocking; its output is
+ * discarded, never reported.
+ *
+ * Generated assembly is kept in ArtifactCache, keyed by source contents,
+ * compiler id/version and flags, so re-running an unchanged configuration
+ * (e.g. toggling back to a previous -O level) skips the compiler.
  */
 class AssemblyRunner : public IToolRunner {
     Q_OBJECT
@@ -33,6 +48,24 @@ public:
     void run(const QString& sourceFile, const QStringList& flags) override;
     void cancel() override;
 
+    /**
+     * @brief Generate assembly for an in-memory buffer (no temp files)
+     * @param sourceCode       Translation unit text, piped on stdin
+     * @param flags            -std=, -O<n> and any other compiler flags
+     * @param sourceDirectory  Directory of the buffer's file, for quoted
+     *                         includes and as working directory; may be empty
+     */
+    void runSource(const QString& sourceCode, const QStringList& flags,
+                   const QString& sourceDirectory = QString());
+
+    bool isRunning() const;
+
+    /**
+     * @brief Build the runSource() command line (without the program)
+     */
+    static QStringList buildSourceArguments(bool intelSyntax, const QStringList& flags,
+                                            const QString& sourceDirectory);
+
     // Configuration
     void setCompilerId(const QString& id);
     QString compilerId() const;
@@ -40,6 +73,13 @@ public:
     void setIntelSyntax(bool intel);
     bool intelSyntax() const;
 
+    /**
+     * @brief Source-line map of raw \c .s text, from an unfiltered AsmParser pass
+     * @param asmText Full content of the generated \c .s file.
+     * @return Map from asm output line (1-based) → main-file source line (1-based).
+     */
+    static QMap<int, int> parseLocDirectives(const QString& asmText);
+
 signals:
     /**
      * @brief Emitted after a successful run with the source-line ↔ asm-line map.
@@ -47,7 +87,9 @@ signals:
      * Key   = 1-based line number in the assembly output text.
      * Value = 1-based source line number the instruction was generated from.
      *
-     * Lines for which no \c .loc directive was seen have no entry in the map.
+     * Lines without a \c .loc position in the main file have no entry in
+     * the map.  Only computed when something is connected; AssemblyWidget
+     * uses the AsmDocument index instead.
      */
     void lineMapReady(const QMap<int, int>& asmLineToSrcLine);
 
@@ -57,17 +99,18 @@ private slots:
     void onProcessStarted();
 
 private:
-    /**
-     * @brief Parse \c .loc directives from assembly text to produce the map.
-     * @param asmText Full content of the generated \c .s file.
-     * @return Map from asm output line (1-based) → source line (1-based).
-     */
-    static QMap<int, int> parseLocDirectives(const QString& asmText);
+    bool lookupCached(const QString& displayName);
+    void startProcess(const QString& program, const QStringList& args,
+                      const QString& workingDirectory);
+    void killProcess();
+    void emitFinished(bool success, const QString& asmText, const QString& errText);
 
-    QString  m_compilerId;
-    bool     m_intelSyntax  = false;
-    QProcess* m_process     = nullptr;
-    QString  m_tmpAsmFile;
+    QString         m_compilerId;
+    bool            m_intelSyntax = false;
+    GroupedProcess* m_process     = nullptr;
+    QString         m_tmpAsmFile;
+    QString         m_cacheKey;
+    quint64         m_runSerial   = 0;   // Invalidates pending cache-hit deliveries
 };
 
 #endif // ASSEMBLYRUNNER_H
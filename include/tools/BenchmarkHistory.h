@@ -0,0 +1,127 @@
+#ifndef BENCHMARKHISTORY_H
+#define BENCHMARKHISTORY_H
+
+#include <QDateTime>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include "tools/BenchmarkResult.h"
+#include "tools/BenchmarkStats.h"
+
+/**
+ * @brief One run as stored in the benchmark history.
+ */
+struct BenchmarkHistoryRun {
+    qint64    id = -1;              ///< < 0: not found
+    QDateTime recordedAt;           ///< UTC
+    QString   sourceName;           ///< File or editor tab name; runs are grouped by it
+    QString   sourceHash;           ///< SHA-1 of the source text, hex
+    QString   source;               ///< The source text itself
+    bool      baseline = false;     ///< Pinned: new runs of sourceName are compared to it
+    BenchmarkResult result;         ///< Compiler, standard, -O level, options, context and every entry
+
+    bool isValid() const { return id >= 0; }
+
+    /** "#12 · a1b2c3d" — the run and the edit it measured. */
+    QString shortLabel() const {
+        return QStringLiteral("#%1 · %2").arg(id).arg(sourceHash.left(7));
+    }
+};
+
+/**
+ * @brief Persistent SQLite history of benchmark runs.
+ *
+ * Every finished run is stored with its source text and hash, compiler,
+ * flags, run options, machine context and all entries, so a session's
+ * edits can be followed benchmark by benchmark.  One run per source name
+ * can be pinned as the baseline; BenchmarkStats::compare() against it
+ * turns into regressionFlags().
+ *
+ * The database lives at defaultPath() unless another path is given, with
+ * its own connection per instance.  Entries are kept as the JSON objects
+ * of BenchmarkRunner::entryToJson(), next to their run name and real
+ * time for queries.
+ *
+ * Usage:
+ * @code
+ *   BenchmarkHistory history;
+ *   const qint64 id = history.addRun(result, "sort.cpp", sourceText);
+ *   const BenchmarkHistoryRun base = history.baseline("sort.cpp");
+ *   if (base.isValid() && base.id != id)
+ *       flags = BenchmarkHistory::regressionFlags(BenchmarkStats::compare(base.result, result));
+ * @endcode
+ */
+class BenchmarkHistory : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int SCHEMA_VERSION = 1;
+    /// Without repetitions there is no test; flag slowdowns from this size on
+    static constexpr double UNTESTED_CHANGE = 0.05;
+
+    explicit BenchmarkHistory(const QString& databasePath = defaultPath(),
+                              QObject* parent = nullptr);
+    ~BenchmarkHistory() override;
+
+    /** QStandardPaths::AppDataLocation/benchmark_history.db */
+    static QString defaultPath();
+
+    bool    isOpen() const;
+    QString lastError() const { return m_lastError; }
+    QString databasePath() const { return m_path; }
+
+    /**
+     * @brief Store a finished run
+     * @return Its id, or -1 on failure (see lastError())
+     */
+    qint64 addRun(const BenchmarkResult& result, const QString& sourceName,
+                  const QString& sourceText);
+
+    /** Runs of @p sourceName (all runs if empty), oldest first, with their entries. */
+    QList<BenchmarkHistoryRun> runs(const QString& sourceName = QString()) const;
+
+    /** One run with its entries; invalid if there is no such id. */
+    BenchmarkHistoryRun run(qint64 id) const;
+
+    /** Source names that have runs, most recently run first. */
+    QStringList sourceNames() const;
+
+    /** Pin run @p id as the baseline of its source name, unpinning any other. */
+    bool pinBaseline(qint64 id);
+    bool unpinBaseline(const QString& sourceName);
+
+    /** Pinned run of @p sourceName; invalid if none is pinned. */
+    BenchmarkHistoryRun baseline(const QString& sourceName) const;
+
+    bool removeRun(qint64 id);
+
+    /** Hex SHA-1 of @p sourceText. */
+    static QString sourceHash(const QString& sourceText);
+
+    /**
+     * @brief Regressions among @p comparisons (baseline → contender), one line each
+     *
+     * "BM_Sort/64 regressed by 12.5% (significant, p = 0.002)" for a slower
+     * verdict; with too few repetitions to test, slowdowns of at least
+     * UNTESTED_CHANGE are listed as untested.
+     */
+    static QStringList regressionFlags(const QList<BenchmarkComparison>& comparisons);
+
+signals:
+    /** A run was added, removed, pinned or unpinned. */
+    void changed();
+
+private:
+    bool open();
+    bool createSchema();
+    bool loadEntries(BenchmarkHistoryRun& run) const;
+    QList<BenchmarkHistoryRun> selectRuns(const QString& where, const QVariantMap& bindings) const;
+
+    QString m_path;
+    QString m_connectionName;
+    mutable QString m_lastError;
+};
+
+#endif // BENCHMARKHISTORY_H
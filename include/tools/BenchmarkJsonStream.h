@@ -0,0 +1,40 @@
+#ifndef BENCHMARKJSONSTREAM_H
+#define BENCHMARKJSONSTREAM_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+
+/**
+ * @brief Picks finished rows out of --benchmark_format=json output as it arrives.
+ *
+ * Google Benchmark flushes its reporter after every benchmark, so each
+ * object of the "benchmarks" array appears on stdout as soon as that
+ * benchmark is done.  feed() scans only the new bytes (tracking string
+ * literals and brace depth) and returns the objects completed by them;
+ * data() keeps the whole output for the final parse.
+ */
+class BenchmarkJsonStream {
+public:
+    /**
+     * @brief Append @p chunk
+     * @return Rows of the "benchmarks" array completed by this chunk, in order
+     */
+    QList<QJsonObject> feed(const QByteArray& chunk);
+
+    void reset();
+
+    /** Everything fed since the last reset(). */
+    const QByteArray& data() const { return m_data; }
+
+private:
+    QByteArray m_data;
+    int  m_pos         = -1;     // Next byte to scan; -1 until the array opened
+    int  m_depth       = 0;      // Brace depth inside the array
+    int  m_objectStart = 0;
+    bool m_inString    = false;
+    bool m_escape      = false;
+    bool m_done        = false;  // Array closed
+};
+
+#endif // BENCHMARKJSONSTREAM_H
@@ -5,6 +5,7 @@
 #include <QString>
 #include <QList>
 #include <QMap>
+#include <QStringList>
 #include <QVariant>
 
 /**
@@ -17,6 +18,164 @@ struct BenchmarkEntry {
     qint64  iterations = 0;
     QString timeUnit;
     QMap<QString, QVariant> counters;
+
+    // Repetitions (--benchmark_repetitions): every repetition is one
+    // "iteration" row, followed by "aggregate" rows for the same run_name.
+    QString runName;              ///< name without the aggregate suffix; = name if absent
+    QString runType;              ///< "iteration" or "aggregate"
+    QString aggregateName;        ///< "mean", "median", "stddev", "cv" (aggregates only)
+    int     repetitions     = 1;
+    int     repetitionIndex = 0;
+    int     threads         = 1;      ///< ->Threads / ->ThreadRange; also "/threads:N" in the name
+
+    // Identity within the suite, from run_name and the JSON indices (-1 in old output)
+    int           familyIndex   = -1;
+    int           instanceIndex = -1;   ///< per_family_instance_index
+    QString       family;               ///< run_name up to the first '/'
+    QList<qint64> args;                 ///< ->Arg / ->Range values, in name order
+    QStringList   argNames;             ///< ->ArgNames; empty where unnamed
+
+    // Hardware counters per iteration (--benchmark_perf_counters); < 0 = not measured
+    double cycles       = -1;
+    double instructions = -1;
+    double cacheMisses  = -1;
+    double branches     = -1;
+    double branchMisses = -1;
+
+    // Heap use from the library's memory-manager run (allocation tracking); < 0 = not measured
+    double allocsPerIteration  = -1;
+    qint64 totalAllocatedBytes = -1;    ///< Over the whole memory-manager run
+    qint64 maxBytesUsed        = -1;    ///< Peak of live bytes
+    qint64 netHeapGrowth       = -1;
+
+    // ->Complexity() fit: the "BigO" and "RMS" aggregate rows of a family
+    QString bigO;                       ///< "(1)", "N", "N^2", "N^3", "lgN", "NlgN", "f(N)"
+    double  realCoefficient = -1;       ///< BigO row: real time = coefficient · f(N), in timeUnit
+    double  rms             = -1;       ///< RMS row: normalised root-mean-square error of the fit
+
+    /// The library runs the memory manager for min(this, iterations) iterations
+    static constexpr qint64 MEMORY_RUN_ITERATIONS = 16;
+
+    bool isAggregate() const { return runType == QLatin1String("aggregate"); }
+    bool isComplexityFit() const {
+        return aggregateName == QLatin1String("BigO") || aggregateName == QLatin1String("RMS");
+    }
+
+    /** run_name without its "/threads:N" part: the same work at every thread count. */
+    QString scalingName() const {
+        QString n = runName.isEmpty() ? name : runName;
+        const int at = n.indexOf(QLatin1String("/threads:"));
+        if (at < 0) return n;
+        const int next = n.indexOf(QLatin1Char('/'), at + 1);
+        return n.remove(at, next < 0 ? n.size() - at : next - at);
+    }
+
+    bool hasPerfCounters() const { return cycles >= 0 || instructions >= 0; }
+    bool hasAllocations() const { return allocsPerIteration >= 0; }
+
+    /** Bytes requested per iteration; < 0 when not measured. */
+    double bytesPerIteration() const {
+        if (totalAllocatedBytes < 0) return -1;
+        return double(totalAllocatedBytes) / qBound<qint64>(1, iterations, MEMORY_RUN_ITERATIONS);
+    }
+};
+
+/**
+ * @brief Benchmark-binary options for noise handling.
+ *
+ * In adaptive mode, repetitions is the first batch for every benchmark;
+ * BenchmarkRunner then re-runs the unstable ones one at a time until each
+ * meets a target or the budget runs out.
+ */
+struct BenchmarkRunOptions {
+    int    repetitions        = 1;      ///< --benchmark_repetitions
+    double minTimeSec         = 0;      ///< --benchmark_min_time, 0 = library default
+    bool   randomInterleaving = false;  ///< --benchmark_enable_random_interleaving
+
+    bool   adaptive       = false;
+    double targetCv       = 0.02;       ///< Stable once stddev / mean is at most this...
+    double targetCiWidth  = 0.02;       ///< ...or the median's 95% CI is this narrow, relative
+    double timeBudgetSec  = 60;         ///< Wall clock for the whole run phase
+    int    maxRepetitions = 100;        ///< Per benchmark
+
+    // Isolated run (Linux): applied to the benchmark process before it starts measuring
+    QList<int> pinnedCpus;              ///< sched_setaffinity; empty = not pinned
+    bool       raisePriority = false;   ///< Lower the nice value (needs CAP_SYS_NICE)
+
+    bool perfCounters = false;          ///< --benchmark_perf_counters (libpfm)
+    bool trackAllocations = false;      ///< Link the allocation-counting memory manager
+    int  threadSweepMax   = 0;          ///< > 0: add ->ThreadRange(1, this) to every registration
+
+    bool operator==(const BenchmarkRunOptions& o) const {
+        return repetitions == o.repetitions && minTimeSec == o.minTimeSec
+            && randomInterleaving == o.randomInterleaving && adaptive == o.adaptive
+            && targetCv == o.targetCv && targetCiWidth == o.targetCiWidth
+            && timeBudgetSec == o.timeBudgetSec && maxRepetitions == o.maxRepetitions
+            && pinnedCpus == o.pinnedCpus && raisePriority == o.raisePriority
+            && perfCounters == o.perfCounters && trackAllocations == o.trackAllocations
+            && threadSweepMax == o.threadSweepMax;
+    }
+    bool operator!=(const BenchmarkRunOptions& o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Where one benchmark stands during adaptive sampling.
+ */
+struct BenchmarkConvergence {
+    enum class State {
+        Sampling,
+        Converged,
+        OutOfBudget,        ///< Time budget spent before the target was met
+        OutOfRepetitions    ///< maxRepetitions reached before the target was met
+    };
+
+    QString runName;
+    int     repetitions = 0;
+    double  cv          = 0;
+    double  ciWidth     = 0;    ///< (ciHigh − ciLow) / median
+    State   state       = State::Sampling;
+};
+
+/**
+ * @brief Machine and conditions of one run: the "context" object of the
+ * JSON output, plus what BenchmarkRunner itself applied and observed.
+ */
+struct BenchmarkContext {
+    struct Cache {
+        QString type;               ///< "Data", "Instruction", "Unified"
+        int     level      = 0;
+        qint64  size       = 0;     ///< Bytes
+        int     numSharing = 0;
+
+        bool operator==(const Cache& o) const {
+            return type == o.type && level == o.level && size == o.size
+                && numSharing == o.numSharing;
+        }
+    };
+
+    QString       hostName;
+    QString       executable;
+    int           numCpus   = 0;
+    double        mhzPerCpu = 0;
+    bool          cpuScalingEnabled = false;
+    bool          cpuScalingKnown   = false;   ///< Older libraries omit it
+    QList<double> loadAvg;                     ///< 1, 5 and 15 minutes, at start
+    QList<Cache>  caches;
+    QString       libraryBuildType;            ///< "release" or "debug"
+    QString       libraryVersion;
+
+    // Not from the library
+    QString governor;       ///< cpufreq scaling governor of the first CPU used (Linux)
+    QString pinnedCpus;     ///< Affinity the process actually ran with, "2,3"; empty = any
+    int     niceness = 0;   ///< Nice value the process actually ran with
+
+    bool isEmpty() const { return hostName.isEmpty() && numCpus == 0; }
+
+    /** Same hardware: host, CPU count and nominal speed, cache layout. */
+    bool sameMachine(const BenchmarkContext& o) const {
+        return hostName == o.hostName && numCpus == o.numCpus
+            && qFuzzyCompare(mhzPerCpu + 1.0, o.mhzPerCpu + 1.0) && caches == o.caches;
+    }
 };
 
 /**
@@ -29,8 +188,11 @@ struct BenchmarkResult {
     QString date;
     QString executablePath;
 
-    QList<BenchmarkEntry> benchmarks;
+    QList<BenchmarkEntry> benchmarks;   ///< Every row, repetitions and aggregates included
     QString rawJson;
+    BenchmarkRunOptions options;        ///< How the binary was run
+    BenchmarkContext    context;        ///< Where and under what conditions
+    QString perfCountersNote;           ///< Why requested hardware counters are missing
 
     // Metadata used by the Compare view
     QString compilerId;
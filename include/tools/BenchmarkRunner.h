@@ -2,11 +2,17 @@
 #define BENCHMARKRUNNER_H
 
 #include "tools/IToolRunner.h"
+#include "tools/BenchmarkJsonStream.h"
 #include "tools/BenchmarkResult.h"
+#include <QElapsedTimer>
+#include <QJsonObject>
 #include <QProcess>
 #include <QScopedPointer>
+#include <QSet>
 #include <QTemporaryDir>
 
+#include <limits>
+
 /**
  * @brief Compiles and runs a Google Benchmark C++ source file.
  *
@@ -19,14 +25,58 @@
  *       -L<benchmarkLibDir()> -lbenchmark -lbenchmark_main -lpthread
  *
  *   Phase 2 — Run:
- *     <tmp_binary> --benchmark_format=json
- *     stdout → parseJsonOutput() → BenchmarkResult
+ *     <tmp_binary> --benchmark_list_tests=true
+ *       → number of benchmarks, for runProgress()
+ *     <tmp_binary> --benchmark_format=json [runArguments(runOptions())]
+ *       stdout, as it arrives → BenchmarkJsonStream → entryReady() per row
+ *       stdout, at exit       → parseJsonOutput() → BenchmarkResult
+ *
+ *   Adaptive mode (BenchmarkRunOptions::adaptive):
+ *     The first run gives every benchmark at least ADAPTIVE_MIN_REPETITIONS
+ *     repetitions; then, round-robin, each benchmark that is not yet stable
+ *     (BenchmarkStats::isConverged) is re-run alone with
+ *     --benchmark_filter=<filterForRun(name)> for ADAPTIVE_BATCH more,
+ *     until all are stable, hit maxRepetitions, or timeBudgetSec is spent
+ *     (checked between batches).
+ *     convergenceUpdated() reports every benchmark after each batch.
+ *
+ *   Isolated run (BenchmarkRunOptions::pinnedCpus / raisePriority, Linux):
+ *     The run process gets sched_setaffinity and a lower nice value before
+ *     it execs (Qt 6 child-process modifier; on Qt 5 right after start).
+ *     The affinity and nice value it actually got are read back into
+ *     BenchmarkContext, next to the library's "context" and the scaling
+ *     governor; noiseWarnings() turns that into user-facing warnings.
+ *
+ *   Hardware counters (BenchmarkRunOptions::perfCounters):
+ *     --benchmark_perf_counters with cycles, instructions, cache misses,
+ *     branches and branch misses; the library reports them per iteration
+ *     and entryFromJson() moves them into BenchmarkEntry's counter fields.
+ *     Libraries built without libpfm, or a kernel that refuses access
+ *     (perf_event_paranoid), leave them out: the run goes on and
+ *     BenchmarkResult::perfCountersNote says why.  Older libraries that
+ *     abort instead are re-run once without counters.
+ *
+ *   Thread sweep (BenchmarkRunOptions::threadSweepMax):
+ *     A copy of the source with ->ThreadRange(1, N) added to every
+ *     registration that has no thread setting is compiled instead
+ *     (injectThreadRange()); the user's file is not touched.
+ *
+ *   Allocation tracking (BenchmarkRunOptions::trackAllocations):
+ *     resources/templates/benchmark_memory_manager.cpp is compiled into
+ *     the binary.  It counts the global operator new / delete and
+ *     registers with benchmark::RegisterMemoryManager, so the library
+ *     adds allocs_per_iter, total_allocated_bytes, max_bytes_used and
+ *     net_heap_growth to every benchmark.
  *
  * Compiler is set externally via setCompilerId() — NOT chosen inside
  * this class.  This follows the same pattern as AssemblyRunner.
  *
  * Benchmark library paths come from ToolsConfig::instance().
  *
+ * The compiled binary is kept in ArtifactCache, keyed by source contents,
+ * compiler id/version, flags and the benchmark library; re-running an
+ * unchanged benchmark skips Phase 1.
+ *
  * JSON format reference:
  *   https://github.com/google/benchmark#output-formats
  *
@@ -39,6 +89,13 @@ class BenchmarkRunner : public IToolRunner {
     Q_OBJECT
 
 public:
+    static constexpr int ADAPTIVE_MIN_REPETITIONS = 5;
+    static constexpr int ADAPTIVE_BATCH           = 5;
+    static constexpr int ISOLATED_NICE            = -10;
+    /// 1-minute load average above which a run is flagged as disturbed
+    static constexpr double LOAD_WARNING          = 1.0;
+    static constexpr int PARANOID_UNKNOWN         = std::numeric_limits<int>::min();
+
     explicit BenchmarkRunner(QObject* parent = nullptr);
     ~BenchmarkRunner() override;
 
@@ -62,6 +119,84 @@ public:
                            const QString& standard,
                            const QString& optimizationLevel);
 
+    /** Repetitions, min time and interleaving for the next run. */
+    void                setRunOptions(const BenchmarkRunOptions& options);
+    BenchmarkRunOptions runOptions() const;
+
+    /**
+     * @brief Benchmark-binary flags for @p options (format flag excluded)
+     */
+    static QStringList runArguments(const BenchmarkRunOptions& options);
+
+    /**
+     * @brief --benchmark_filter pattern that matches exactly @p runName
+     *
+     * The library matches POSIX extended regexes, so only their
+     * metacharacters are escaped.
+     */
+    static QString filterForRun(const QString& runName);
+
+    /**
+     * @brief Append the repetitions in @p batch to @p entries
+     *
+     * Aggregate rows are dropped (they would describe the batch only),
+     * repetition indices continue where each benchmark left off, and
+     * every row's repetitions is the benchmark's new total.
+     */
+    static void appendRepetitions(QList<BenchmarkEntry>& entries,
+                                  const QList<BenchmarkEntry>& batch);
+
+    // ── Run conditions ───────────────────────────────────────────
+    /** Whether pinning and priority can be applied on this platform. */
+    static bool isolationSupported();
+
+    /**
+     * @brief Parse a CPU list such as "2,3" or "0-3,6"
+     * @param ok  Set to false on syntax errors or out-of-range CPUs
+     * @return Sorted, without duplicates
+     */
+    static QList<int> parseCpuList(const QString& text, bool* ok = nullptr);
+    static QString    formatCpuList(const QList<int>& cpus);
+
+    /** The library's "context" object, in either direction. */
+    static BenchmarkContext contextFromJson(const QJsonObject& obj);
+    static QJsonObject      contextToJson(const BenchmarkContext& context);
+
+    /** Run options, in either direction; missing keys keep their defaults. */
+    static BenchmarkRunOptions optionsFromJson(const QJsonObject& obj);
+    static QJsonObject         optionsToJson(const BenchmarkRunOptions& options);
+
+    /**
+     * @brief Conditions of @p result that make its timings unreliable
+     *
+     * Frequency scaling or a non-performance governor, system load,
+     * a debug build of the benchmark library, unoptimized benchmark code.
+     */
+    static QStringList noiseWarnings(const BenchmarkResult& result);
+
+    /** One-line description of the machine, for Compare. */
+    static QString describeMachine(const BenchmarkContext& context);
+
+    /**
+     * @brief @p source with ->ThreadRange(1, @p maxThreads) after every
+     * BENCHMARK / BENCHMARK_CAPTURE / BENCHMARK_TEMPLATE / BENCHMARK_REGISTER_F
+     *
+     * Registrations that already call ->Threads, ->ThreadRange or
+     * ->ThreadPerCpu are left alone, as are line comments.  Insertions
+     * stay on their line, so diagnostics keep their line numbers.
+     */
+    static QString injectThreadRange(const QString& source, int maxThreads);
+
+    /** kernel.perf_event_paranoid; PARANOID_UNKNOWN when it cannot be read. */
+    static int perfEventParanoid();
+
+    /**
+     * @brief Why hardware counters that were asked for are missing
+     * @param stderrText The benchmark binary's stderr, where the library explains
+     * @param paranoid   perfEventParanoid()
+     */
+    static QString perfCountersNote(const QString& stderrText, int paranoid);
+
     // ── Results ──────────────────────────────────────────────────
     BenchmarkResult lastResult() const;
 
@@ -72,6 +207,17 @@ public:
     // ── Import ───────────────────────────────────────────────────
     BenchmarkResult loadFromJson(const QString& filePath) const;
 
+    /**
+     * @brief Parse Google Benchmark --benchmark_format=json output
+     *
+     * Only fills the entries and date; the caller sets success and metadata.
+     */
+    static BenchmarkResult parseJsonOutput(const QString& json);
+
+    /** One "benchmarks" row, Google Benchmark keys, in either direction. */
+    static BenchmarkEntry entryFromJson(const QJsonObject& obj);
+    static QJsonObject    entryToJson(const BenchmarkEntry& entry);
+
 signals:
     /**
      * Emitted with the full parsed result after successful execution.
@@ -85,21 +231,45 @@ signals:
      */
     void compilationFinished(bool success, const QString& errorOutput);
 
+    /**
+     * Adaptive mode: one benchmark's state after a batch finished.
+     */
+    void convergenceUpdated(const BenchmarkConvergence& convergence);
+
+    /**
+     * Emitted for every row (repetition or aggregate) as soon as the
+     * binary reports it, before benchmarkResultReady().
+     */
+    void entryReady(const BenchmarkEntry& entry);
+
+    /**
+     * @brief Benchmarks finished so far in the first pass over the suite
+     * @param total From --benchmark_list_tests; 0 when unknown
+     */
+    void runProgress(int done, int total);
+
 private slots:
     void onCompileFinished(int exitCode, QProcess::ExitStatus status);
     void onCompileError   (QProcess::ProcessError error);
+    void onListFinished   (int exitCode, QProcess::ExitStatus status);
+    void onRunOutput      ();
     void onRunFinished    (int exitCode, QProcess::ExitStatus status);
     void onRunError       (QProcess::ProcessError error);
 
 private:
     void            startRun(const QString& binaryPath);
-    BenchmarkResult parseJsonOutput(const QString& json) const;
+    void            launchRun(const QStringList& args);
+    void            continueAdaptive(const BenchmarkResult& batch, const QString& errText);
+    void            deliverResult(const QString& rawJson, const QString& errText);
+    void            recordIsolation(qint64 pid);
     static QString  extractStandardFromFlags(const QStringList& flags);
     static QString  extractOptFromFlags(const QStringList& flags);
 
     QString  m_compilerId;
+    BenchmarkRunOptions m_runOptions;
     QProcess* m_compileProcess = nullptr;
     QProcess* m_runProcess     = nullptr;
+    QProcess* m_listProcess    = nullptr;
     BenchmarkResult m_lastResult;
 
     // Temp dir owns the output binary for the duration of compile+run.
@@ -107,6 +277,27 @@ private:
     QString     m_tempBinaryPath;
     QString     m_sourceFilePath;
     QStringList m_compileFlags;
+    QString     m_cacheKey;
+    quint64     m_runSerial = 0;   // Invalidates pending cache-hit deliveries
+
+    // Adaptive sampling state, reset by startRun()
+    QString               m_binaryPath;
+    QElapsedTimer         m_runClock;
+    QList<BenchmarkEntry> m_adaptiveEntries;
+    int                   m_adaptiveCursor = 0;   // Round-robin position in run order
+
+    // Streaming state
+    BenchmarkJsonStream m_stream;
+    QStringList         m_firstPassArgs;
+    QSet<QString>       m_finishedRuns;   // Run names seen in the first pass
+    int                 m_expectedRuns = 0;
+    bool                m_firstPass    = false;
+
+    // What the run process actually got (recordIsolation)
+    QString m_appliedCpus;
+    int     m_appliedNiceness = 0;
+
+    QString m_perfCountersNote;   // Set when the counters had to be switched off
 };
 
 #endif // BENCHMARKRUNNER_H
@@ -0,0 +1,310 @@
+#ifndef BENCHMARKSTATS_H
+#define BENCHMARKSTATS_H
+
+#include <QList>
+#include <QPair>
+#include <QPointF>
+#include <QString>
+#include "tools/BenchmarkResult.h"
+
+/**
+ * @brief All repetitions of one benchmark (one run_name), summarised.
+ *
+ * Times are in the benchmark's own time unit.
+ */
+struct BenchmarkSummary {
+    QString runName;
+    QString timeUnit;
+    qint64  iterations = 0;     ///< Of the first repetition
+
+    QList<double> realTimes;    ///< One per repetition, in run order (empty for aggregates-only output)
+    QList<double> cpuTimes;
+
+    int    repetitions = 0;
+    double mean   = 0;          ///< Real time
+    double median = 0;
+    double stddev = 0;          ///< Sample standard deviation (n − 1)
+    double cv     = 0;          ///< stddev / mean
+    double cpuMedian = 0;
+
+    double ciLow  = 0;          ///< Bootstrap confidence interval of the median;
+    double ciHigh = 0;          ///< both equal median when it cannot be computed
+
+    // Hardware counters per iteration, median over repetitions; < 0 = not measured
+    double cycles       = -1;
+    double instructions = -1;
+    double cacheMisses  = -1;
+    double branches     = -1;
+    double branchMisses = -1;
+
+    // Heap use per iteration, median over repetitions; < 0 = not measured
+    double allocsPerIteration = -1;
+    double bytesPerIteration  = -1;
+    double peakBytes          = -1;
+
+    bool hasPerfCounters() const { return cycles >= 0 || instructions >= 0; }
+    bool hasAllocations() const { return allocsPerIteration >= 0; }
+
+    /** Instructions per cycle; < 0 without both counters. */
+    double ipc() const {
+        return cycles > 0.0 && instructions >= 0.0 ? instructions / cycles : -1.0;
+    }
+
+    /** Share of branches mispredicted; < 0 without both counters. */
+    double branchMissRate() const {
+        return branches > 0.0 && branchMisses >= 0.0 ? branchMisses / branches : -1.0;
+    }
+
+    bool hasInterval() const { return realTimes.size() >= 2; }
+
+    /** CI width relative to the median; 0 without an interval. */
+    double relativeCiWidth() const {
+        return hasInterval() && median > 0.0 ? (ciHigh - ciLow) / median : 0.0;
+    }
+};
+
+/**
+ * @brief What a chart plots per benchmark.
+ */
+enum class BenchmarkMetric {
+    RealTime,           ///< Median real time
+    Ipc,                ///< Instructions per cycle
+    CacheMisses,        ///< Cache misses per iteration
+    BranchMissRate,     ///< Mispredicted branches, percent
+    Allocations,        ///< Heap allocations per iteration
+    BytesAllocated      ///< Heap bytes requested per iteration
+};
+
+/**
+ * @brief One thread count of a thread-scaling series.
+ */
+struct ScalingPoint {
+    int    threads    = 1;
+    double timeNs     = 0;   ///< Median real time per iteration, all threads together
+    double throughput = 0;   ///< Iterations per second, all threads together
+    double speedup    = 0;   ///< Throughput relative to the fewest-threads point
+    double efficiency = 0;   ///< speedup / (threads / fewest threads)
+};
+
+/**
+ * @brief One benchmark run at several thread counts.
+ */
+struct ScalingSeries {
+    QString             name;       ///< BenchmarkEntry::scalingName()
+    QList<ScalingPoint> points;     ///< Ascending thread count
+    double serialFraction = -1;     ///< Amdahl fit; < 0 without a 1-thread point
+
+    bool hasFit() const { return serialFraction >= 0.0; }
+
+    /** Speedup Amdahl's law predicts at @p threads for the fitted serial fraction. */
+    double amdahlSpeedup(double threads) const {
+        return 1.0 / (serialFraction + (1.0 - serialFraction) / threads);
+    }
+};
+
+/**
+ * @brief The ->Complexity() fit Google Benchmark reports for a family.
+ */
+struct ComplexityFit {
+    QString runName;                ///< run_name of the BigO row: the family without its arguments
+    QString bigO;                   ///< As the library prints it: "N", "NlgN", "N^2", ...
+    double  coefficientNs = -1;     ///< Real time = coefficientNs · f(N)
+    double  rms           = -1;     ///< Relative RMS error of the fit; < 0 if absent
+
+    /** False for lambda complexities ("f(N)"), whose function the output does not carry. */
+    bool canEvaluate() const { return coefficientNs >= 0.0 && complexity(1.0) >= 0.0; }
+
+    /** f(n) for bigO; < 0 when unknown.  lg is log2, as in the library. */
+    double complexity(double n) const;
+
+    /** Real time in nanoseconds the fit predicts at N = @p n. */
+    double predictNs(double n) const { return coefficientNs * complexity(n); }
+};
+
+/**
+ * @brief One run of a parameter sweep: its varying arguments and summary.
+ */
+struct SweepPoint {
+    QList<qint64>    coords;    ///< The sweep's varying arguments, in name order
+    BenchmarkSummary summary;
+};
+
+/**
+ * @brief The runs of a family that differ only in their numeric arguments.
+ *
+ * ->Range(8, 8 << 10) gives one dimension, ->Ranges / ->ArgsProduct with
+ * two varying arguments two.  Arguments with the same value in every run
+ * stay part of the name.
+ */
+struct ParameterSweep {
+    QString           name;         ///< run_name with varying arguments as "*": "BM_2D/rows:*/cols:*"
+    QString           family;
+    QStringList       dimensions;   ///< ArgNames of the varying arguments, else "range(i)"
+    QList<SweepPoint> points;       ///< Ascending by coords
+    ComplexityFit     fit;          ///< One-dimensional sweeps of a ->Complexity() family
+
+    bool hasFit() const { return !fit.bigO.isEmpty(); }
+};
+
+/**
+ * @brief Mann-Whitney U test of two independent samples.
+ */
+struct MannWhitneyResult {
+    bool   valid  = false;      ///< Both samples have at least two values
+    bool   exact  = false;      ///< p from the exact U distribution, else normal approximation
+    double u      = 0;          ///< U statistic of the first sample
+    double pValue = 1;          ///< Two-sided
+};
+
+/**
+ * @brief One benchmark of a contender result against the same benchmark of a baseline.
+ */
+struct BenchmarkComparison {
+    enum class Verdict {
+        Faster,
+        Slower,
+        NoSignificantDifference,
+        InsufficientData        ///< Fewer than two repetitions on a side
+    };
+
+    QString runName;
+    double  baselineNs  = 0;    ///< Median real time
+    double  contenderNs = 0;
+    double  change      = 0;    ///< (contender − baseline) / baseline, as compare.py prints it
+    double  pValue      = 1;
+    int     baselineRepetitions  = 0;
+    int     contenderRepetitions = 0;
+    Verdict verdict = Verdict::InsufficientData;
+
+    static QString verdictText(Verdict verdict);
+};
+
+/**
+ * @brief Statistics over Google Benchmark repetitions.
+ *
+ * summarize() groups the per-repetition rows of a run by run_name and
+ * computes mean, median, standard deviation, coefficient of variation and
+ * a percentile-bootstrap confidence interval of the median; output that
+ * only has the library's aggregate rows (--benchmark_report_aggregates_only)
+ * falls back to those.
+ *
+ * compare() follows google/benchmark's tools/compare.py: a two-sided
+ * Mann-Whitney U test on the real times of each benchmark present in both
+ * results, significant below ALPHA.  Small samples without ties use the
+ * exact U distribution.
+ *
+ * Pure and deterministic (the bootstrap uses a fixed seed).
+ */
+class BenchmarkStats {
+public:
+    static constexpr double ALPHA = 0.05;
+    static constexpr double CONFIDENCE = 0.95;
+    static constexpr int    BOOTSTRAP_RESAMPLES = 2000;
+    static constexpr quint32 BOOTSTRAP_SEED = 0x5eed;
+    /// compare.py's advice: fewer repetitions than this make the U test unreliable
+    static constexpr int    RECOMMENDED_REPETITIONS = 9;
+
+    static double mean(const QList<double>& values);
+    static double median(QList<double> values);
+    static double stddev(const QList<double>& values);
+
+    /**
+     * @brief Percentile-bootstrap confidence interval of the median
+     * @return (low, high); (median, median) with fewer than two values
+     */
+    static QPair<double, double> bootstrapMedianCi(const QList<double>& values,
+                                                   double confidence = CONFIDENCE,
+                                                   int resamples = BOOTSTRAP_RESAMPLES,
+                                                   quint32 seed = BOOTSTRAP_SEED);
+
+    /**
+     * @brief Percentile-bootstrap confidence interval of median(reference) / median(contender)
+     *
+     * Each round resamples both samples independently; > 1 means the
+     * contender is faster.
+     * @return (low, high); (ratio, ratio) when either side has fewer than two values
+     */
+    static QPair<double, double> bootstrapMedianRatioCi(const QList<double>& reference,
+                                                        const QList<double>& contender,
+                                                        double confidence = CONFIDENCE,
+                                                        int resamples = BOOTSTRAP_RESAMPLES,
+                                                        quint32 seed = BOOTSTRAP_SEED);
+
+    static MannWhitneyResult mannWhitneyU(const QList<double>& a, const QList<double>& b);
+
+    /**
+     * @brief One summary per run_name, in order of first appearance
+     */
+    static QList<BenchmarkSummary> summarize(const QList<BenchmarkEntry>& entries);
+
+    /**
+     * @brief Whether @p summary meets the adaptive-sampling targets of @p options
+     *
+     * Needs at least two repetitions; either target being met is enough.
+     */
+    static bool isConverged(const BenchmarkSummary& summary, const BenchmarkRunOptions& options);
+
+    /**
+     * @brief Compare every benchmark of @p contender that @p baseline also has
+     */
+    static QList<BenchmarkComparison> compare(const BenchmarkResult& baseline,
+                                              const BenchmarkResult& contender,
+                                              double alpha = ALPHA);
+
+    /**
+     * @brief @p metric of @p summary; < 0 when its counters were not measured
+     */
+    static double metricValue(const BenchmarkSummary& summary, BenchmarkMetric metric);
+
+    /** Axis title of @p metric; @p timeUnit is used for RealTime. */
+    static QString metricTitle(BenchmarkMetric metric, const QString& timeUnit = QStringLiteral("ns"));
+
+    /**
+     * @brief Thread-scaling series: run names that differ only in "/threads:N"
+     *
+     * Throughput is 1 / real time: for threaded benchmarks the library
+     * divides wall time by the iterations of all threads together.
+     * Only series with at least two thread counts are returned.
+     */
+    static QList<ScalingSeries> scaling(const QList<BenchmarkEntry>& entries);
+
+    /**
+     * @brief Least-squares serial fraction s of Amdahl's law,
+     * 1 / speedup = s + (1 − s) / threads
+     *
+     * Fitted in 1 / speedup, where the law is linear in 1 / threads.
+     * @return In [0, 1]; -1 unless the points start at one thread and go beyond it
+     */
+    static double fitAmdahl(const QList<ScalingPoint>& points);
+
+    /**
+     * @brief BigO and RMS rows paired up, one fit per family, in output order
+     */
+    static QList<ComplexityFit> complexityFits(const QList<BenchmarkEntry>& entries);
+
+    /**
+     * @brief Parameter sweeps of @p entries: groups of at least two runs
+     *
+     * Runs are grouped by their name with every numeric argument masked;
+     * the arguments that differ within a group are its dimensions.
+     * Entries need BenchmarkEntry::args, as entryFromJson() fills them.
+     */
+    static QList<ParameterSweep> sweeps(const QList<BenchmarkEntry>& entries);
+
+    /**
+     * @brief Largest-Triangle-Three-Buckets downsampling
+     *
+     * Keeps the first and last point and, from each of @p maxPoints − 2
+     * equal buckets in between, the point spanning the largest triangle
+     * with its neighbours' picks, so peaks and steps survive.
+     * @param points Sorted by x
+     * @return Indices of the kept points, ascending; all of them when
+     *         there are at most @p maxPoints or @p maxPoints < 3
+     */
+    static QList<int> downsample(const QList<QPointF>& points, int maxPoints);
+
+    /** @p value in @p unit ("ns", "us", "ms", "s") as nanoseconds. */
+    static double toNanoseconds(double value, const QString& unit);
+};
+
+#endif // BENCHMARKSTATS_H
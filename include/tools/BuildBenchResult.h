@@ -0,0 +1,53 @@
+#ifndef BUILDBENCHRESULT_H
+#define BUILDBENCHRESULT_H
+
+#include <QList>
+#include <QString>
+
+/**
+ * @brief Summary statistics of one measured quantity across repetitions.
+ */
+struct BuildBenchStats {
+    int    count  = 0;
+    double mean   = 0;
+    double stddev = 0;   ///< Sample standard deviation (n − 1)
+    double min    = 0;
+    double max    = 0;
+};
+
+/**
+ * @brief One compile of one snippet, as measured by ProcessMeter.
+ */
+struct BuildBenchSample {
+    double wallMs    = 0;
+    double cpuMs     = -1;   ///< user + system; -1 if the platform has no rusage
+    qint64 peakRssKb = -1;
+};
+
+/**
+ * @brief All repetitions of one snippet under one compiler configuration.
+ */
+struct BuildBenchCase {
+    QString snippet;            ///< Snippet tab name
+    QString compilerId;
+    QString standard;           ///< e.g. "c++20"
+    QString optimization;       ///< e.g. "O2"
+
+    bool    success = false;
+    QString errorMessage;       ///< First compiler error when success is false
+
+    QList<BuildBenchSample> samples;
+    BuildBenchStats wallMs;
+    BuildBenchStats cpuMs;
+    BuildBenchStats peakRssMb;
+
+    /// Wall-time speedup of this snippet relative to the first snippet under
+    /// the same configuration (> 1 = compiles faster than the baseline).
+    double speedup = 1.0;
+
+    QString configurationLabel() const {
+        return QStringLiteral("%1 %2 -%3").arg(compilerId, standard, optimization);
+    }
+};
+
+#endif // BUILDBENCHRESULT_H
@@ -0,0 +1,115 @@
+#ifndef BUILDBENCHRUNNER_H
+#define BUILDBENCHRUNNER_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QThreadPool>
+#include "tools/BuildBenchResult.h"
+
+class QTemporaryDir;
+struct ProcessUsage;
+
+/**
+ * @brief One code variant compared by Build Bench.
+ */
+struct BuildBenchSnippet {
+    QString name;
+    QString code;
+};
+
+/**
+ * @brief What to measure: every snippet × compiler × standard × -O level.
+ */
+struct BuildBenchConfig {
+    QList<BuildBenchSnippet> snippets;
+    QStringList compilerIds;
+    QStringList standards;            ///< e.g. {"c++17", "c++20"}
+    QStringList optimizationLevels;   ///< e.g. {"O0", "O2"}
+    QStringList extraFlags;
+    int  repetitions = 5;
+    bool parallel    = false;         ///< One worker per core instead of one in total
+};
+
+/**
+ * @brief Measures how expensive snippets are to compile.
+ *
+ * Each case (snippet × configuration) is compiled with -c once as an
+ * unmeasured warm-up (page cache, compiler binary) and then
+ * BuildBenchConfig::repetitions times.  Every compile is run through
+ * ProcessMeter, so wall time, CPU time and peak RSS of the compiler come
+ * from wait4() rusage rather than from timing a QProcess.
+ *
+ * Repetitions are interleaved across cases (round-robin) so slow drift of
+ * the machine — thermal throttling, a background job — spreads over all
+ * cases instead of biasing whichever ran last.
+ *
+ * Parallel mode runs one worker per core, each pinned to its own CPU where
+ * the platform allows; sequential mode uses a single unpinned worker and
+ * gives the least noisy numbers.
+ */
+class BuildBenchRunner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit BuildBenchRunner(QObject* parent = nullptr);
+    ~BuildBenchRunner() override;
+
+    /**
+     * @brief Start measuring
+     * @return false if a run is in progress or the configuration is empty
+     */
+    bool start(const BuildBenchConfig& config);
+
+    /**
+     * @brief Stop the run without blocking
+     *
+     * Running compiles are killed; finished() with cancelled = true follows
+     * once every worker has returned.  isRunning() stays true until then.
+     */
+    void cancel();
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief Mean, sample standard deviation, min and max of @p values
+     */
+    static BuildBenchStats summarize(const QList<double>& values);
+
+    /**
+     * @brief Fill BuildBenchCase::speedup relative to the first snippet
+     * measured under the same compiler/standard/-O configuration
+     */
+    static void computeSpeedups(QList<BuildBenchCase>& cases);
+
+signals:
+    void progressMessage(const QString& message);
+    void progressChanged(int completed, int total);
+    void caseFinished(const BuildBenchCase& result);
+    void finished(const QList<BuildBenchCase>& cases, bool cancelled);
+
+private:
+    struct WorkItem {
+        int caseIndex  = 0;
+        int repetition = -1;   ///< -1 = warm-up, not recorded
+    };
+    struct SharedState;
+
+    void onSampleDone(int caseIndex, int repetition, const ProcessUsage& usage);
+    void onWorkerDone();
+    void finishCase(int caseIndex);
+    void finishRun(bool cancelled);
+
+    QThreadPool m_pool;
+    QSharedPointer<SharedState> m_state;
+    QScopedPointer<QTemporaryDir> m_workDir;
+
+    QList<BuildBenchCase> m_cases;
+    QList<int> m_pendingPerCase;   ///< Outstanding work items per case
+    int  m_completed = 0;
+    int  m_total     = 0;
+    int  m_activeWorkers = 0;      ///< Pool tasks that have not returned yet
+    bool m_running   = false;
+};
+
+#endif // BUILDBENCHRUNNER_H
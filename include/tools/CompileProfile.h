@@ -0,0 +1,59 @@
+#ifndef COMPILEPROFILE_H
+#define COMPILEPROFILE_H
+
+#include <QList>
+#include <QString>
+
+/**
+ * @brief One span of compiler work, laid out for the flame chart.
+ *
+ * Clang: a complete ("ph":"X") event from the -ftime-trace JSON.
+ * GCC:   one header from the -H include tree; start/duration are measured
+ *        in included headers rather than time (see CompileProfile::unit).
+ */
+struct CompileProfileEvent {
+    QString name;           ///< Event kind, e.g. "Source", "InstantiateClass"
+    QString detail;         ///< Header path, template or function name
+    qint64  start    = 0;   ///< Offset from the start of the compile
+    qint64  duration = 0;
+    int     depth    = 0;   ///< Nesting level (0 = outermost)
+};
+
+/**
+ * @brief One row of a ranked cost table (headers, templates, functions, phases).
+ */
+struct CompileProfileEntry {
+    QString name;
+    qint64  totalUs = 0;    ///< Summed inclusive time; 0 when the compiler reports none
+    int     count   = 0;    ///< Occurrences (GCC headers: transitive includes pulled in)
+};
+
+/**
+ * @brief Parsed compile-time profile of one translation unit.
+ */
+struct CompileProfile {
+    enum class Unit {
+        Microseconds,       ///< Events are timed (Clang -ftime-trace)
+        Headers             ///< Events are sized by include count (GCC -H)
+    };
+
+    bool    success = false;
+    QString errorMessage;
+
+    QString compilerId;
+    QString label;                          ///< Shown in the compare selector
+    QString sourceFile;
+    qint64  wallTimeUs = 0;                 ///< Whole compiler invocation, measured by the runner
+
+    Unit    unit = Unit::Microseconds;
+    QList<CompileProfileEvent> events;      ///< Flame chart spans, sorted by start
+
+    QList<CompileProfileEntry> headers;     ///< Most expensive first
+    QList<CompileProfileEntry> templates;
+    QList<CompileProfileEntry> functions;
+    QList<CompileProfileEntry> phases;      ///< Frontend/backend split or GCC -ftime-report rows
+
+    QString rawOutput;                      ///< Trace JSON or compiler stderr, for the Raw tab
+};
+
+#endif // COMPILEPROFILE_H
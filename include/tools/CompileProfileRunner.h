@@ -0,0 +1,85 @@
+#ifndef COMPILEPROFILERUNNER_H
+#define COMPILEPROFILERUNNER_H
+
+#include "tools/IToolRunner.h"
+#include "tools/CompileProfile.h"
+#include <QElapsedTimer>
+#include <QProcess>
+
+/**
+ * @brief Compiles a translation unit with the compiler's own time
+ * instrumentation and parses the result into a CompileProfile.
+ *
+ * Invocation:
+ *   Clang: <compiler> -c -ftime-trace -ftime-trace-granularity=<us> [flags] <src> -o <tmp.o>
+ *          → the trace is written next to the object as <tmp>.json
+ *   GCC:   <compiler> -c -ftime-report -H [flags] <src> -o <tmp.o>
+ *          → the phase report and the include tree both arrive on stderr
+ *
+ * GCC has no per-header or per-template timing, so its header table and
+ * flame chart are sized by the number of headers each include pulls in.
+ *
+ * Profiles are never cached: re-running the same configuration is how a
+ * user checks whether a measurement is stable.
+ *
+ * Async: emits started(), finished(), progressMessage() from IToolRunner
+ * plus profileReady() after a successful compile.
+ */
+class CompileProfileRunner : public IToolRunner {
+    Q_OBJECT
+
+public:
+    explicit CompileProfileRunner(QObject* parent = nullptr);
+    ~CompileProfileRunner() override;
+
+    // IToolRunner interface
+    bool isAvailable() const override;
+    QString toolName() const override { return QStringLiteral("Compile Profile"); }
+    void run(const QString& sourceFile, const QStringList& flags) override;
+    void cancel() override;
+
+    // Configuration
+    void setCompilerId(const QString& id);
+    QString compilerId() const;
+
+    /** Minimum duration of a Clang trace event; shorter events are dropped by the compiler. */
+    void setGranularityUs(int us) { m_granularityUs = us; }
+
+    // ── Parsers (public for tests) ───────────────────────────────
+
+    /**
+     * @brief Parse a Clang -ftime-trace document.
+     *
+     * "Source" events rank headers, "InstantiateClass"/"InstantiateFunction"
+     * rank templates, and "ParseFunctionDefinition"/"OptFunction"/
+     * "CodeGen Function" rank functions.  Times are inclusive.
+     */
+    static CompileProfile parseTimeTrace(const QByteArray& json);
+
+    /**
+     * @brief Parse GCC stderr containing -H include dots and a -ftime-report table.
+     */
+    static CompileProfile parseGccReport(const QString& stderrText);
+
+signals:
+    void profileReady(const CompileProfile& profile);
+
+private slots:
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+    void onProcessError(QProcess::ProcessError error);
+    void onProcessStarted();
+
+private:
+    void removeTempFiles();
+
+    QString   m_compilerId;
+    int       m_granularityUs = 500;
+    bool      m_clang         = false;
+    QProcess* m_process       = nullptr;
+    QString   m_sourceFile;
+    QString   m_tmpObjectFile;
+    QString   m_tmpTraceFile;
+    QElapsedTimer m_timer;
+};
+
+#endif // COMPILEPROFILERUNNER_H
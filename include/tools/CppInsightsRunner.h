@@ -16,6 +16,9 @@
  * It can be overridden at runtime via setExecutablePath().
  *
  * Async: emits started(), finished(), progressMessage() from IToolRunner.
+ *
+ * Output is kept in ArtifactCache, keyed by source contents, the insights
+ * binary (path + modification time) and flags.
  */
 class CppInsightsRunner : public IToolRunner {
     Q_OBJECT
@@ -42,6 +45,8 @@ private slots:
 private:
     QString m_execPath;   // Resolved from ToolsConfig if empty
     QProcess* m_process = nullptr;
+    QString m_cacheKey;
+    quint64 m_runSerial = 0;   // Invalidates pending cache-hit deliveries
 };
 
 #endif // CPPINSIGHTSRUNNER_H
@@ -0,0 +1,60 @@
+#ifndef MATRIXRESULT_H
+#define MATRIXRESULT_H
+
+#include <QString>
+#include "tools/BenchmarkResult.h"
+
+/**
+ * @brief Size of the assembly one configuration produced.
+ */
+struct MatrixAsmStats {
+    qint64 bytes        = 0;   ///< Size of the .s file
+    int    instructions = 0;   ///< Lines that are neither labels, directives nor comments
+    int    functions    = 0;   ///< Symbols declared @function (or .globl where there is no .type)
+};
+
+/**
+ * @brief One cell of the configuration matrix: compiler × -std × -O × -march.
+ */
+struct MatrixCell {
+    QString compilerId;
+    QString standard;        ///< e.g. "c++20"
+    QString optimization;    ///< e.g. "O2"
+    QString march;           ///< e.g. "x86-64-v3"; empty = compiler default
+
+    bool    success = false;
+    QString errorMessage;    ///< First compiler error when success is false
+
+    double  compileMs = 0;   ///< Wall time of the -S compile
+    MatrixAsmStats asmStats;
+
+    bool    benchmarkRequested = false;   ///< Source is a Google Benchmark and benchmarks were enabled
+    bool    benchmarkRan       = false;
+    QString benchmarkError;
+    BenchmarkResult benchmark;
+
+    QString marchLabel() const {
+        return march.isEmpty() ? QStringLiteral("default") : march;
+    }
+
+    /// Everything except the compiler — the chart's category axis
+    QString flagsLabel() const {
+        return QStringLiteral("%1 -%2 %3").arg(standard, optimization, marchLabel());
+    }
+
+    /**
+     * @brief Real time of benchmark @p name in nanoseconds, or -1 if absent
+     */
+    double benchmarkNs(const QString& name) const {
+        for (const BenchmarkEntry& e : benchmark.benchmarks) {
+            if (e.name != name) continue;
+            if (e.timeUnit == QLatin1String("us")) return e.realTimeNs * 1e3;
+            if (e.timeUnit == QLatin1String("ms")) return e.realTimeNs * 1e6;
+            if (e.timeUnit == QLatin1String("s"))  return e.realTimeNs * 1e9;
+            return e.realTimeNs;
+        }
+        return -1;
+    }
+};
+
+#endif // MATRIXRESULT_H
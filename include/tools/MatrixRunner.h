@@ -0,0 +1,113 @@
+#ifndef MATRIXRUNNER_H
+#define MATRIXRUNNER_H
+
+#include <QObject>
+#include <QScopedPointer>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QThreadPool>
+#include "tools/MatrixResult.h"
+
+class QTemporaryDir;
+struct ProcessUsage;
+
+/**
+ * @brief What to build: one source × compilers × standards × -O × -march.
+ */
+struct MatrixConfig {
+    QString     sourceCode;
+    QString     includeDir;           ///< Added with -iquote so "local.h" still resolves
+    QStringList compilerIds;
+    QStringList standards;            ///< e.g. {"c++17", "c++20"}
+    QStringList optimizationLevels;   ///< e.g. {"O2", "O3"}
+    QStringList marchTargets;         ///< e.g. {"", "x86-64-v3", "native"}; "" = no -march
+    QStringList extraFlags;
+    bool runBenchmarks = true;        ///< Only honoured when the source uses Google Benchmark
+};
+
+/**
+ * @brief Builds one translation unit under every configuration of a matrix.
+ *
+ * Phase 1 — compile, in parallel on a pool of QThread::idealThreadCount()
+ * workers.  Each cell is compiled with -S through ProcessMeter, which gives
+ * the compile time; the .s file gives the assembly size and instruction
+ * count.  When the source includes <benchmark/benchmark.h> and Google
+ * Benchmark is configured (ToolsConfig), the worker also links a benchmark
+ * binary for the cell.
+ *
+ * Phase 2 — benchmark, strictly one binary at a time and only after every
+ * compile has finished, so neither other benchmarks nor the compiler pool
+ * compete for the cores being measured.  Results are read from
+ * --benchmark_out and parsed with BenchmarkRunner::parseJsonOutput().
+ *
+ * Cells that fail to compile (an -march the compiler does not know, say)
+ * are reported with their first error line and do not stop the rest.
+ */
+class MatrixRunner : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MatrixRunner(QObject* parent = nullptr);
+    ~MatrixRunner() override;
+
+    /**
+     * @brief Start building the matrix
+     * @return false if a run is in progress or the configuration is empty
+     */
+    bool start(const MatrixConfig& config);
+
+    /**
+     * @brief Stop the run without blocking
+     *
+     * Running compiles and benchmarks are killed; finished() with
+     * cancelled = true follows once every worker has returned.
+     * isRunning() stays true until then.
+     */
+    void cancel();
+    bool isRunning() const { return m_running; }
+
+    /** Cells of the current (or last) run, in matrix order. */
+    const QList<MatrixCell>& cells() const { return m_cells; }
+
+    /**
+     * @brief Count instructions, functions and bytes in compiler -S output
+     *
+     * Works for GCC and Clang output on x86 and ARM: directives (".foo"),
+     * labels ("foo:") and whole-line comments ("#", "//", ";", "@") are not
+     * instructions.
+     */
+    static MatrixAsmStats analyzeAssembly(const QByteArray& assembly);
+
+    /** True if @p code looks like a Google Benchmark translation unit. */
+    static bool usesGoogleBenchmark(const QString& code);
+
+signals:
+    void progressMessage(const QString& message);
+    void progressChanged(int completed, int total);
+    void cellUpdated(int index, const MatrixCell& cell);
+    void finished(const QList<MatrixCell>& cells, bool cancelled);
+
+private:
+    struct SharedState;
+
+    void onCompileDone(int index, const ProcessUsage& usage, const MatrixAsmStats& stats,
+                       const QString& binaryPath, const QString& linkError);
+    void onBenchmarkDone(int index, const ProcessUsage& usage, const QByteArray& json);
+    void startBenchmarks();
+    void postWorkerDone(const QSharedPointer<SharedState>& state);   ///< From a worker thread
+    void finishRun(bool cancelled);
+
+    QThreadPool m_pool;
+    QSharedPointer<SharedState> m_state;
+    QScopedPointer<QTemporaryDir> m_workDir;
+
+    QList<MatrixCell> m_cells;
+    QStringList m_binaries;         ///< Per cell; empty = nothing to benchmark
+    int  m_compilesPending = 0;
+    int  m_completed = 0;
+    int  m_total     = 0;
+    int  m_activeWorkers = 0;      ///< Pool tasks that have not returned yet
+    bool m_running   = false;
+};
+
+#endif // MATRIXRUNNER_H
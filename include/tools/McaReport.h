@@ -0,0 +1,51 @@
+#ifndef MCAREPORT_H
+#define MCAREPORT_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief One row of llvm-mca's "Instruction Info" table.
+ */
+struct McaInstruction {
+    QString text;                 ///< Instruction as llvm-mca printed it
+    int     uops        = 0;
+    int     latency     = 0;      ///< Cycles until the result is available
+    double  rthroughput = 0.0;    ///< Reciprocal throughput, cycles per instruction
+    bool    mayLoad     = false;
+    bool    mayStore    = false;
+    bool    sideEffects = false;
+    QVector<double> pressure;     ///< Cycles per iteration on each McaReport::resources entry
+};
+
+/**
+ * @brief Parsed llvm-mca report for one code region.
+ */
+struct McaReport {
+    bool    valid = false;        ///< The summary block was found
+
+    int     iterations    = 0;
+    int     instructionCount = 0; ///< Instructions × iterations, as reported
+    qint64  totalCycles   = 0;
+    qint64  totalUops     = 0;
+    int     dispatchWidth = 0;
+    double  uopsPerCycle  = 0.0;
+    double  ipc           = 0.0;
+    double  blockRThroughput = 0.0;   ///< Cycles per iteration when throughput-bound
+
+    QStringList     resources;          ///< Scheduler resources, e.g. "SKLPort0"
+    QVector<double> resourcePressure;   ///< Cycles per iteration on each resource
+    QVector<McaInstruction> instructions;
+
+    /** Index into resources of the busiest one, -1 if none. */
+    int busiestResource() const {
+        int best = -1;
+        for (int i = 0; i < resourcePressure.size(); ++i) {
+            if (best < 0 || resourcePressure[i] > resourcePressure[best]) best = i;
+        }
+        return best;
+    }
+};
+
+#endif // MCAREPORT_H
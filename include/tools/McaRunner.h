@@ -0,0 +1,63 @@
+#ifndef MCARUNNER_H
+#define MCARUNNER_H
+
+#include "tools/IToolRunner.h"
+#include "tools/McaReport.h"
+#include <QProcess>
+
+/**
+ * @brief Static throughput analysis of an instruction block with llvm-mca.
+ *
+ * Invocation:
+ *   llvm-mca -mcpu=<cpu> [flags] -            (block piped on stdin)
+ *   llvm-mca -mcpu=<cpu> [flags] <file.s>     (run())
+ *
+ * llvm-mca simulates the block in a loop on the chosen CPU's scheduling
+ * model and reports IPC, block reciprocal throughput, per-resource
+ * pressure and per-instruction latency/throughput — what a loop costs
+ * without running it.  parseReport() turns the text report into a
+ * McaReport; finished() carries the raw text.
+ *
+ * The block must be plain instructions the assembler accepts: mangled
+ * symbol names, and a leading ".intel_syntax noprefix" for Intel syntax.
+ */
+class McaRunner : public IToolRunner {
+    Q_OBJECT
+
+public:
+    explicit McaRunner(QObject* parent = nullptr);
+    ~McaRunner() override;
+
+    // IToolRunner interface
+    bool isAvailable() const override;
+    QString toolName() const override { return QStringLiteral("llvm-mca"); }
+    void run(const QString& sourceFile, const QStringList& flags) override;
+    void cancel() override;
+
+    /**
+     * @brief Analyze an instruction block
+     * @param assembly     One instruction per line
+     * @param cpu          -mcpu value ("native", "skylake", "znver3", ...)
+     * @param intelSyntax  The block is in Intel syntax
+     */
+    void analyze(const QString& assembly, const QString& cpu, bool intelSyntax = false);
+
+    bool isRunning() const;
+
+    /** Path of llvm-mca (or a versioned llvm-mca-N) on PATH, or empty. */
+    static QString findExecutable();
+
+    static McaReport parseReport(const QString& output);
+
+private slots:
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+    void onProcessError(QProcess::ProcessError error);
+
+private:
+    void start(const QStringList& args, const QByteArray& input);
+    void killProcess();
+
+    QProcess* m_process = nullptr;
+};
+
+#endif // MCARUNNER_H
@@ -0,0 +1,43 @@
+#ifndef OPTREMARK_H
+#define OPTREMARK_H
+
+#include <QList>
+#include <QString>
+
+/**
+ * @brief One optimization remark: a decision the optimizer made (or did
+ * not make) at a source location.
+ *
+ * GCC (-fopt-info-all) and Clang (-fsave-optimization-record) report the
+ * same three kinds under different names:
+ *   Passed   — GCC "optimized", Clang "!Passed"   ("loop vectorized")
+ *   Missed   — GCC "missed",    Clang "!Missed"   ("not vectorized: ...")
+ *   Analysis — GCC "note",      Clang "!Analysis*" (supporting detail)
+ */
+struct OptRemark {
+    enum class Kind {
+        Passed,
+        Missed,
+        Analysis
+    };
+
+    Kind    kind   = Kind::Analysis;
+    QString pass;             ///< "inline", "loop-vectorize", ... (GCC: inferred from the text)
+    QString name;             ///< Clang remark name, e.g. "Vectorized"; empty for GCC
+    QString function;         ///< Enclosing function (demangled); empty when unknown
+    QString file;             ///< As reported; "<stdin>" for a piped buffer
+    int     line   = 0;       ///< 1-based, 0 = no location
+    int     column = 0;
+    QString message;
+
+    static QString kindText(Kind kind) {
+        switch (kind) {
+        case Kind::Passed:   return QStringLiteral("Optimized");
+        case Kind::Missed:   return QStringLiteral("Missed");
+        case Kind::Analysis: return QStringLiteral("Analysis");
+        }
+        return QString();
+    }
+};
+
+#endif // OPTREMARK_H
@@ -0,0 +1,91 @@
+#ifndef OPTREMARKSRUNNER_H
+#define OPTREMARKSRUNNER_H
+
+#include "tools/IToolRunner.h"
+#include "tools/OptRemark.h"
+#include <QProcess>
+
+class GroupedProcess;
+
+/**
+ * @brief Compiles a translation unit with optimization remarks enabled and
+ * parses them into OptRemark lists.
+ *
+ * Invocation:
+ *   Clang: <compiler> -c -fsave-optimization-record
+ *                     -foptimization-record-file=<tmp.yaml> [flags] <src> -o <tmp.o>
+ *          → one YAML document per remark in <tmp.yaml>
+ *   GCC:   <compiler> -c -fopt-info-all [flags] <src> -o <tmp.o>
+ *          → "file:line:col: optimized|missed|note: text" lines on stderr
+ *
+ * runSource() compiles an in-memory buffer piped on stdin instead
+ * (-x c++ -), so remarks for it are reported against file "<stdin>".
+ * Remarks only appear with optimization enabled; the -O level is part of
+ * the flags.
+ *
+ * Async: emits started(), finished(), progressMessage() from IToolRunner
+ * plus remarksReady() after a successful compile.  Starting a new run or
+ * calling cancel() kills the in-flight compiler and its cc1plus
+ * (GroupedProcess) without blocking.
+ */
+class OptRemarksRunner : public IToolRunner {
+    Q_OBJECT
+
+public:
+    explicit OptRemarksRunner(QObject* parent = nullptr);
+    ~OptRemarksRunner() override;
+
+    // IToolRunner interface
+    bool isAvailable() const override;
+    QString toolName() const override { return QStringLiteral("Optimization Remarks"); }
+    void run(const QString& sourceFile, const QStringList& flags) override;
+    void cancel() override;
+
+    /**
+     * @brief Collect remarks for an in-memory buffer (piped on stdin)
+     * @param sourceDirectory  Directory of the buffer's file, for quoted
+     *                         includes and as working directory; may be empty
+     */
+    void runSource(const QString& sourceCode, const QStringList& flags,
+                   const QString& sourceDirectory = QString());
+
+    bool isRunning() const;
+
+    // Configuration
+    void setCompilerId(const QString& id);
+    QString compilerId() const;
+
+    // ── Parsers (public for tests) ───────────────────────────────
+
+    /** Parse GCC -fopt-info-all output; lines without a location are skipped. */
+    static QList<OptRemark> parseGccOptInfo(const QString& stderrText);
+
+    /**
+     * @brief Parse a Clang/LLVM optimization record (-fsave-optimization-record).
+     *
+     * The message is the concatenation of the Args values; mangled function
+     * and callee names are demangled.
+     */
+    static QList<OptRemark> parseOptRecord(const QByteArray& yaml);
+
+signals:
+    void remarksReady(const QList<OptRemark>& remarks);
+
+private slots:
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+    void onProcessError(QProcess::ProcessError error);
+
+private:
+    void start(const QString& displayName, const QStringList& flags,
+               const QString& sourceFile, const QByteArray& input,
+               const QString& workingDirectory);
+    void killProcess();
+
+    QString         m_compilerId;
+    bool            m_clang   = false;
+    GroupedProcess* m_process = nullptr;
+    QString         m_tmpObjectFile;
+    QString         m_tmpRecordFile;
+};
+
+#endif // OPTREMARKSRUNNER_H
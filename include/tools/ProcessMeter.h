@@ -0,0 +1,71 @@
+#ifndef PROCESSMETER_H
+#define PROCESSMETER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <atomic>
+
+/**
+ * @brief Resource usage of one finished child process.
+ */
+struct ProcessUsage {
+    bool    started   = false;
+    bool    timedOut  = false;
+    bool    cancelled = false;
+    bool    crashed   = false;
+    int     exitCode  = -1;
+
+    double  wallMs    = 0;
+    double  userMs    = -1;     ///< -1 when the platform reports no rusage
+    double  systemMs  = -1;
+    qint64  peakRssKb = -1;     ///< ru_maxrss normalised to KiB
+
+    QByteArray standardError;
+    QString    errorString;     ///< Why the process could not be started
+
+    double cpuMs() const { return userMs < 0 ? -1 : userMs + systemMs; }
+    bool succeeded() const {
+        return started && !timedOut && !cancelled && !crashed && exitCode == 0;
+    }
+};
+
+/**
+ * @brief Runs a program synchronously and reports what it cost.
+ *
+ * Unlike QProcess this reaps the child with wait4(), so user/system CPU
+ * time and peak resident set size come straight from the kernel's rusage
+ * for exactly that process.  Meant to be called from worker threads,
+ * several at once: the pipes are close-on-exec, so no child inherits
+ * another run's stderr, and wall time stops when the child is reaped.
+ *
+ * The child leads its own process group; a timeout or cancellation kills
+ * the whole group, including processes a compiler driver spawned.
+ *
+ * On Linux the child can be pinned to one CPU before exec so parallel
+ * measurements don't migrate onto each other's cores.
+ *
+ * Platforms without fork/wait4 (Windows) fall back to QProcess and
+ * report wall time only.
+ */
+class ProcessMeter {
+public:
+    /**
+     * @param program    Executable (looked up in PATH if not absolute)
+     * @param arguments  Command-line arguments
+     * @param cpu        CPU to pin the child to, or -1 for no pinning
+     * @param timeoutMs  Kill the child after this long
+     * @param cancel     Optional flag polled while waiting; kills the child when set
+     */
+    static ProcessUsage run(const QString& program, const QStringList& arguments,
+                            int cpu = -1, int timeoutMs = 120000,
+                            const std::atomic_bool* cancel = nullptr);
+
+    /** True when run() reports CPU time and peak RSS. */
+    static bool hasResourceUsage();
+
+    /** True when run() honours the cpu argument. */
+    static bool hasAffinity();
+};
+
+#endif // PROCESSMETER_H
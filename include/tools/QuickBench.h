@@ -0,0 +1,113 @@
+#ifndef QUICKBENCH_H
+#define QUICKBENCH_H
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include "tools/BenchmarkResult.h"
+#include "tools/BenchmarkStats.h"
+
+/**
+ * @brief One code pane of Quick Bench: statements measured per iteration.
+ */
+struct QuickBenchSnippet {
+    QString name;   ///< Shown in the results; the benchmark is BM_<name>
+    QString code;   ///< Lambda body; a returned value is kept with DoNotOptimize
+};
+
+/**
+ * @brief How fast one snippet ran relative to the reference snippet.
+ */
+struct QuickBenchRatio {
+    QString name;
+    QString reference;          ///< The first snippet
+    double  speedup = 0;        ///< Reference median / this median: > 1 = faster
+    double  ciLow   = 0;        ///< Bootstrap confidence interval of speedup;
+    double  ciHigh  = 0;        ///< both equal speedup without repetitions
+    double  pValue  = 1;        ///< Mann-Whitney U on the real times
+    bool    tested  = false;    ///< Both sides had at least two repetitions
+
+    bool isReference() const { return name == reference; }
+    bool isSignificant() const { return tested && pValue < BenchmarkStats::ALPHA; }
+
+    /** Half the interval, relative to speedup: the "±4%". */
+    double uncertainty() const {
+        return speedup > 0.0 ? (ciHigh - ciLow) / (2.0 * speedup) : 0.0;
+    }
+
+    /** "B is 3.2× faster than A ±4%", with the test's verdict when it failed. */
+    QString text() const;
+};
+
+/**
+ * @brief Google Benchmark harness for plain code snippets.
+ *
+ * generate() fills resources/templates/quick_bench_harness.cpp: one
+ * benchmark per snippet, the shared setup run untimed before each timing
+ * loop, the snippet called through a lambda whose result goes to
+ * benchmark::DoNotOptimize and followed by benchmark::ClobberMemory().
+ * A snippet that returns nothing keeps only its writes to memory: warnings()
+ * flags it, but the harness cannot stop the rest of its work from being
+ * optimised away.
+ * #include lines of the setup move to file scope.  All snippets land in
+ * one source, so they are compiled once, with the same flags, and
+ * runOptions() interleaves their repetitions.
+ *
+ * ratios() turns the result into speedups against the first snippet.
+ *
+ * Usage:
+ * @code
+ *   QString error;
+ *   const QString source = QuickBench::generate(setup, snippets, &error);
+ *   runner->setRunOptions(QuickBench::runOptions(options));
+ *   ...
+ *   for (const QuickBenchRatio& r : QuickBench::ratios(result, snippets))
+ *       qDebug() << r.text();
+ * @endcode
+ */
+class QuickBench {
+public:
+    static constexpr int MIN_SNIPPETS = 2;
+    static constexpr int MAX_SNIPPETS = 6;
+    /// Interleaved repetitions per snippet at the least, for the U test
+    static constexpr int MIN_REPETITIONS = BenchmarkStats::RECOMMENDED_REPETITIONS;
+
+    /** "BM_" + @p snippetName with every character outside [A-Za-z0-9_] as '_'. */
+    static QString benchmarkName(const QString& snippetName);
+
+    /**
+     * @brief Why @p snippets cannot be generated; empty when they can
+     *
+     * Needs MIN_SNIPPETS to MAX_SNIPPETS snippets, each with code and a
+     * name whose benchmarkName() no other snippet shares.
+     */
+    static QString validate(const QList<QuickBenchSnippet>& snippets);
+
+    /**
+     * @brief Benchmark source for @p snippets after @p setup
+     *
+     * Compiler messages name the pane ("setup" or the snippet's name) and
+     * its line; for harness code they name "quick_bench.cpp".
+     *
+     * @return Empty on failure, with the reason in @p error
+     */
+    static QString generate(const QString& setup, const QList<QuickBenchSnippet>& snippets,
+                            QString* error = nullptr);
+
+    /** Snippets whose work may still be optimised away, one line each. */
+    static QStringList warnings(const QList<QuickBenchSnippet>& snippets);
+
+    /** @p options with interleaving on and at least MIN_REPETITIONS (unless adaptive). */
+    static BenchmarkRunOptions runOptions(BenchmarkRunOptions options);
+
+    /**
+     * @brief Every snippet of @p snippets found in @p result against the first one
+     *
+     * The first snippet comes first, at speedup 1.  Missing snippets
+     * (failed to run) are left out, as are all of them without the reference.
+     */
+    static QList<QuickBenchRatio> ratios(const BenchmarkResult& result,
+                                         const QList<QuickBenchSnippet>& snippets);
+};
+
+#endif // QUICKBENCH_H
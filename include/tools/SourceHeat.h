@@ -0,0 +1,71 @@
+#ifndef SOURCEHEAT_H
+#define SOURCEHEAT_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "tools/AsmDocument.h"
+
+/**
+ * @brief What the generated code costs, per line of the main source file.
+ *
+ * Built from an AsmDocument's source → asm index: instruction counts are
+ * available as soon as the listing is parsed, code bytes once the listing
+ * has been assembled (measureLineBytes(), off the GUI thread).  Each metric
+ * is stored per 1-based line; index 0 is unused.
+ */
+struct SourceHeat {
+    enum class Metric {
+        Instructions,
+        Bytes
+    };
+
+    QVector<int>     instructions;   ///< Always sized lineCount() + 1
+    QVector<qint64>  bytes;          ///< Empty until measured
+
+    int lineCount() const { return qMax(0, int(instructions.size()) - 1); }
+    bool isEmpty() const { return lineCount() == 0; }
+
+    /** True when @p metric has data for at least one line. */
+    bool has(Metric metric) const;
+
+    double value(int line, Metric metric) const;
+    double maxValue(Metric metric) const;
+
+    /** "12 instructions · 41 bytes" for 1-based @p line. */
+    QString describe(int line) const;
+
+    static QString metricName(Metric metric);
+
+    /**
+     * @brief Count the instructions generated from each main-file line
+     */
+    static SourceHeat fromDocument(const AsmDocument& document);
+
+    /**
+     * @brief Sum per-asm-line sizes (from measureLineBytes()) into bytes
+     * @param document  The listing @p lineBytes was measured on, or one with
+     *                  the same lines (demangling only rewrites text)
+     */
+    void applyLineBytes(const AsmDocument& document, const QVector<int>& lineBytes);
+
+    /**
+     * @brief Assemble @p listing and read back the code size of each line
+     *
+     * Runs GNU as with a listing (`as -aln`) on the text; the listing is
+     * keyed by input line, so result[i] is the byte count of listing line
+     * i (0-based).  Lines that fail to assemble count as 0.  Blocking; call
+     * from a worker thread.  Returns an empty vector when no GNU as is
+     * installed or nothing could be measured.
+     */
+    static QVector<int> measureLineBytes(const QString& listing, bool intelSyntax);
+
+    /**
+     * @brief Parse an `as -aln` listing into bytes per input line
+     * @param firstLine  Listing line number of input line 0 (1 + any prologue)
+     */
+    static QVector<int> parseListing(const QByteArray& listing, int lineCount,
+                                     int firstLine = 1);
+};
+
+#endif // SOURCEHEAT_H
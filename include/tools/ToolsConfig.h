@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 
 /**
  * @brief Singleton configuration manager for external analysis tools.
@@ -55,6 +56,12 @@ public:
      */
     bool isCppInsightsAvailable() const;
 
+    /**
+     * @brief Arguments used to probe the insights binary ("--help").
+     * Shared with ToolchainDiscovery so startup discovery warms the same cache entry.
+     */
+    static QStringList insightsProbeArguments();
+
     // ----------------------------------------------------------------
     // Google Benchmark
     // ----------------------------------------------------------------
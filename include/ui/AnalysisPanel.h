@@ -3,23 +3,33 @@
 
 #include <QTabWidget>
 #include "core/AppSettings.h"
+#include "tools/SourceHeat.h"
 
 class InsightsWidget;
 class AssemblyWidget;
 class BenchmarkWidget;
+class BuildBenchWidget;
+class CompileProfileWidget;
+class MatrixWidget;
+class AsmCompareWidget;
 
 /**
  * @brief Unified QTabWidget hosting InsightsWidget, AssemblyWidget,
- *        and BenchmarkWidget.
+ *        BenchmarkWidget, BuildBenchWidget, CompileProfileWidget,
+ *        MatrixWidget and AsmCompareWidget.
  *
  * MainWindow owns one AnalysisPanel inside AnalysisDock (right side,
  * hidden by default).  All synchronisation with EditorTabWidget passes
  * through this class.
  *
  * API contract:
- *   setSourceCode(code, path) — propagates to InsightsWidget + AssemblyWidget
- *   setCompilerId(id)         — propagates to AssemblyWidget + BenchmarkWidget
- *   setStandard(std)          — propagates to AssemblyWidget + BenchmarkWidget
+ *   setSourceCode(code, path) — propagates to InsightsWidget, AssemblyWidget,
+ *                               CompileProfileWidget, MatrixWidget and
+ *                               AsmCompareWidget
+ *   setCompilerId(id)         — propagates to AssemblyWidget, BenchmarkWidget,
+ *                               BuildBenchWidget, CompileProfileWidget,
+ *                               MatrixWidget and AsmCompareWidget
+ *   setStandard(std)          — propagates to all tools
  *
  * Signals forwarded to MainWindow:
  *   sourceLineActivated(int line) — from AssemblyWidget; navigates editor
@@ -35,23 +45,30 @@ public:
     InsightsWidget*  insightsWidget()  const { return m_insights;   }
     AssemblyWidget*  assemblyWidget()  const { return m_assembly;   }
     BenchmarkWidget* benchmarkWidget() const { return m_benchmark;  }
+    BuildBenchWidget* buildBenchWidget() const { return m_buildBench; }
+    CompileProfileWidget* compileProfileWidget() const { return m_compileProfile; }
+    MatrixWidget* matrixWidget() const { return m_matrix; }
+    AsmCompareWidget* asmCompareWidget() const { return m_asmCompare; }
 
     // ── Synchronisation API (called by MainWindow) ───────────────
 
     /**
-     * @brief Forward active editor source to InsightsWidget and AssemblyWidget.
-     * Does NOT auto-run either tool.
+     * @brief Forward active editor source to InsightsWidget, AssemblyWidget,
+     * CompileProfileWidget, MatrixWidget and AsmCompareWidget.
+     * Only AssemblyWidget in live mode runs on its own.
      */
     void setSourceCode(const QString& code, const QString& filePath);
 
     /**
-     * @brief Forward compiler ID to AssemblyWidget and BenchmarkWidget.
+     * @brief Forward compiler ID to AssemblyWidget, BenchmarkWidget,
+     * BuildBenchWidget, CompileProfileWidget, MatrixWidget and
+     * AsmCompareWidget.
      * Called when MainWindow toolbar compiler combo changes.
      */
     void setCompilerId(const QString& id);
 
     /**
-     * @brief Forward C++ standard to AssemblyWidget and BenchmarkWidget.
+     * @brief Forward C++ standard to every analysis tool.
      * Called when MainWindow toolbar standard combo changes.
      */
     void setStandard(const QString& standard);
@@ -66,6 +83,10 @@ public:
     static constexpr int TabInsights  = 0;
     static constexpr int TabAssembly  = 1;
     static constexpr int TabBenchmark = 2;
+    static constexpr int TabBuildBench = 3;
+    static constexpr int TabCompileProfile = 4;
+    static constexpr int TabMatrix = 5;
+    static constexpr int TabAsmCompare = 6;
 
 signals:
     /**
@@ -74,10 +95,20 @@ signals:
      */
     void sourceLineActivated(int line);
 
+    /**
+     * Forwarded from AssemblyWidget::sourceHeatChanged.
+     * MainWindow shades the active editor with it.
+     */
+    void sourceHeatChanged(const SourceHeat& heat, SourceHeat::Metric metric);
+
 private:
     InsightsWidget*  m_insights  = nullptr;
     AssemblyWidget*  m_assembly  = nullptr;
     BenchmarkWidget* m_benchmark = nullptr;
+    BuildBenchWidget* m_buildBench = nullptr;
+    CompileProfileWidget* m_compileProfile = nullptr;
+    MatrixWidget* m_matrix = nullptr;
+    AsmCompareWidget* m_asmCompare = nullptr;
 };
 
 #endif // ANALYSISPANEL_H
@@ -0,0 +1,134 @@
+#ifndef ASMCOMPAREWIDGET_H
+#define ASMCOMPAREWIDGET_H
+
+#include <QFont>
+#include <QHash>
+#include <QThreadPool>
+#include <QWidget>
+#include "tools/AsmDiff.h"
+#include "tools/AsmDocument.h"
+
+class AssemblyRunner;
+class QsciLexerCPP;
+class QsciScintilla;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QSplitter;
+class QTableWidget;
+class QToolButton;
+
+/**
+ * @brief Side-by-side assembly for several compiler/flag configurations.
+ *
+ * Layout:
+ *   ┌─ Toolbar: [+ Pane] Diff: [A▾] vs [B▾] [▶ Generate All] [■ Stop] [status] ─┐
+ *   ├─ QSplitter, one pane per configuration:                                  ─┤
+ *   │    [A  compiler▾ | O2▾ | -march▾ | extra flags | ✕]                       │
+ *   │    [read-only assembly]                                                   │
+ *   └─ Summary strip: per function, instructions and code bytes on both sides  ─┘
+ *      and their deltas; click a row to scroll both panes to that function.
+ *
+ * Every pane owns an AssemblyRunner, so Generate All compiles all
+ * configurations concurrently.  Once both panes of the selected pair have a
+ * listing, AsmDiff runs on a worker thread: instructions only in the left
+ * pane are marked as removed, those only in the right pane as added.  Code
+ * sizes come from assembling each listing (AsmDiff::measureFunctionSizes),
+ * also on the worker, once per listing.
+ *
+ * Builds the active editor buffer (setSourceCode), piped to the compiler.
+ */
+class AsmCompareWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit AsmCompareWidget(QWidget* parent = nullptr);
+    ~AsmCompareWidget() override;
+
+    void setSourceCode(const QString& code, const QString& filePath);
+    void setCompilerId(const QString& id);
+    void setStandard(const QString& standard);
+
+    int paneCount() const { return m_panes.size(); }
+
+    static constexpr int MAX_PANES = 6;
+
+public slots:
+    void generateAll();
+    void stopAll();
+    void addPane();
+    void onThemeChanged(const QString& themeName);
+    void applyEditorSettings(const QFont& font, bool showLineNumbers, bool wordWrap);
+
+private slots:
+    void scheduleDiff();
+    void rebuildCompilerCombos();
+    void onSummaryCellClicked(int row, int column);
+
+private:
+    struct Pane {
+        QWidget*        container     = nullptr;
+        QLabel*         titleLabel    = nullptr;
+        QComboBox*      compilerCombo = nullptr;
+        QComboBox*      optCombo      = nullptr;
+        QComboBox*      marchCombo    = nullptr;
+        QLineEdit*      flagsEdit     = nullptr;
+        QToolButton*    removeButton  = nullptr;
+        QsciScintilla*  editor        = nullptr;
+        QsciLexerCPP*   lexer         = nullptr;
+        AssemblyRunner* runner        = nullptr;
+
+        int addedMarker   = -1;
+        int removedMarker = -1;
+
+        bool userPickedCompiler = false;
+        bool running = false;
+
+        QByteArray  rawAsm;               // Unfiltered output of the last good run
+        AsmDocument document;
+        QString     compilerPath;         // Compiler that produced rawAsm (for sizes)
+        quint64     generation = 0;       // Bumped per new listing
+        quint64     sizesGeneration = 0;  // Listing the sizes were measured for
+        QHash<QString, qint64> sizes;
+    };
+
+    void setupUi();
+    void setupToolbar(QWidget* toolbar);
+    Pane* createPane(const QString& optLevel);
+    void removePane(Pane* pane);
+    void relabelPanes();
+    void runPane(Pane* pane);
+    void onPaneFinished(Pane* pane, bool success, const QString& output, const QString& error);
+    void applyDiff(Pane* left, Pane* right, const AsmDiffResult& result);
+    void clearDiff();
+    void updateStatus();
+    void applyThemeToPane(Pane* pane);
+    Pane* diffPane(const QComboBox* combo) const;
+
+    // ── Toolbar ───────────────────────────────────────────────────────────────
+    QPushButton* m_addButton   = nullptr;
+    QComboBox*   m_leftCombo   = nullptr;
+    QComboBox*   m_rightCombo  = nullptr;
+    QPushButton* m_runButton   = nullptr;
+    QPushButton* m_stopButton  = nullptr;
+    QLabel*      m_statusLabel = nullptr;
+
+    // ── Panes and summary ─────────────────────────────────────────────────────
+    QSplitter*    m_paneSplitter = nullptr;
+    QTableWidget* m_summaryTable = nullptr;
+    QList<Pane*>  m_panes;
+
+    // ── State ─────────────────────────────────────────────────────────────────
+    QThreadPool m_diffPool;
+    quint64     m_diffSerial = 0;      // Drops results of superseded diffs
+    QString m_currentSourceCode;
+    QString m_currentFilePath;
+    QString m_compilerId;
+    QString m_standard = QStringLiteral("c++17");
+    QFont   m_editorFont = QFont(QStringLiteral("Monospace"), 10);
+    bool    m_showLineNumbers = true;
+    bool    m_wordWrap = false;
+};
+
+#endif // ASMCOMPAREWIDGET_H
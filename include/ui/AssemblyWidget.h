@@ -1,26 +1,58 @@
 #ifndef ASSEMBLYWIDGET_H
 #define ASSEMBLYWIDGET_H
 
-#include <QMap>
+#include <QElapsedTimer>
+#include <QThreadPool>
 #include <QWidget>
+#include "tools/AsmDocument.h"
 #include "tools/AssemblyRunner.h"
+#include "tools/McaReport.h"
+#include "tools/SourceHeat.h"
 
 class QsciScintilla;
 class QsciLexerCPP;
+class QCheckBox;
 class QComboBox;
 class QPushButton;
 class QLabel;
+class QMenu;
 class QSplitter;
+class QTimer;
+class HeatMargin;
+class McaRunner;
 
 /**
  * @brief Widget for the Assembly output tab.
  *
  * Layout:
- *   [Toolbar: optimization combo | syntax combo | Run button | status label]
+ *   [Toolbar: optimization combo | syntax combo | Filters▾ | CPU▾ | Analyze | Heat▾ | Live | Run button | status label]
  *   [QSplitter horizontal]
  *     Left:  source code mirror (read-only QsciScintilla, synced from editor)
  *     Right: assembly output   (read-only QsciScintilla, plain highlighting)
  *
+ * The raw -S output is kept and run through AsmParser; the Filters menu
+ * (directives, comments, unused labels, library functions, demangling)
+ * re-filters it without recompiling.
+ *
+ * Live mode regenerates the listing as the buffer changes: edits are
+ * debounced, a newer buffer kills the compiler still working on an older
+ * one, and the last good listing stays on screen (also across compile
+ * errors) until the new one lands.  The buffer is piped to the compiler,
+ * never written to a temp file, and the asm pane is updated by replacing
+ * only the lines that changed, so scroll position and caret survive.
+ *
+ * Analyze runs llvm-mca (McaRunner) on the selected lines, or on the
+ * function under the cursor, for the CPU in the CPU combo.  Per-instruction
+ * latency and reciprocal throughput appear in a margin next to each line,
+ * and IPC, block RThroughput and the busiest resources in a box under the
+ * block.  The overlay is dropped whenever the listing changes.
+ *
+ * Heat shades a margin of the source mirror by what each source line
+ * costs: instructions (from the listing's source index, right away) or
+ * code bytes (from assembling the listing in the background).  The same
+ * SourceHeat goes out through sourceHeatChanged() so the real editor can
+ * show it too.
+ *
  * Bidirectional line highlighting:
  *   • When the cursor moves in the assembly pane, the corresponding source
  *     line is highlighted in the source mirror and sourceLineActivated() is
@@ -40,11 +72,11 @@ class AssemblyWidget : public QWidget {
 
 public:
     explicit AssemblyWidget(QWidget* parent = nullptr);
-    ~AssemblyWidget() override = default;
+    ~AssemblyWidget() override;
 
     /**
      * @brief Supply source code from the currently active editor.
-     * Saves to a temp file on Run.  Does NOT auto-run.
+     * Regenerates after a short debounce in live mode; otherwise waits for Run.
      */
     void setSourceCode(const QString& code, const QString& filePath);
 
@@ -61,6 +93,12 @@ public:
     /** Called by MainWindow whenever the user changes the C++ standard. */
     void setStandard(const QString& standard);
 
+    /** Enable or disable live mode (regenerate on every change). */
+    void setLiveMode(bool live);
+    bool isLiveMode() const;
+
+    static constexpr int LIVE_DEBOUNCE_MS = 300;
+
 public slots:
     void runAssembly();
     void onThemeChanged(const QString& themeName);
@@ -79,23 +117,45 @@ signals:
      */
     void sourceLineActivated(int sourceLine);
 
+    /**
+     * @brief Per-line costs of the current listing changed
+     * @param heat   Empty when heat is off or there is no listing
+     * @param metric Cost the heat map is shaded by
+     */
+    void sourceHeatChanged(const SourceHeat& heat, SourceHeat::Metric metric);
+
 private slots:
     void onRunnerStarted();
     void onRunnerFinished(bool success, const QString& output, const QString& error);
     void onProgressMessage(const QString& msg);
-    void onLineMapReady(const QMap<int, int>& asmLineToSrcLine);
+    void applyFilters();
+    void scheduleLiveRun();
     void onAsmCursorPositionChanged(int line, int col);
     void stopProcess();
+    void analyzeSelection();
+    void onMcaFinished(bool success, const QString& output, const QString& error);
+    void updateHeat();
 
 private:
     void setupUi();
     void setupLexer(QsciScintilla* editor, QsciLexerCPP* lexer);
     void applyThemeToEditor(QsciScintilla* editor, const QString& themeName);
     void clearHighlights();
+    static void replaceChangedLines(QsciScintilla* editor, const QString& text);
+    AsmFilterOptions filterOptions() const;
+    AsmDocument assemblableDocument() const;
+    void measureHeatBytes();
+    void showMcaReport(const McaReport& report);
+    void clearMcaOverlay();
 
     // Toolbar widgets
     QComboBox*   m_optimizationCombo;
     QComboBox*   m_syntaxCombo;
+    QMenu*       m_filterMenu = nullptr;
+    QComboBox*   m_cpuCombo   = nullptr;
+    QPushButton* m_analyzeButton = nullptr;
+    QComboBox*   m_heatCombo  = nullptr;
+    QCheckBox*   m_liveCheck  = nullptr;
     QPushButton* m_runButton;
     QPushButton* m_stopButton = nullptr;
     QLabel*      m_statusLabel;
@@ -109,18 +169,26 @@ private:
     // Highlighting marker handles
     int m_srcHighlightMarker  = -1;
     int m_asmHighlightMarker  = -1;
+    HeatMargin* m_sourceHeat  = nullptr;   // Heat shading of the source mirror
 
     // Backend
     AssemblyRunner* m_runner;
+    QTimer*         m_liveTimer = nullptr;
+    McaRunner*      m_mcaRunner = nullptr;
 
     // State
     QString         m_currentSourceCode;
     QString         m_currentFilePath;
     QString         m_compilerId;                         // set via setCompilerId()
     QString         m_standard = QStringLiteral("c++17"); // set via setStandard()
-    QString         m_tempAsmSourceFile;
-    QMap<int, int>  m_asmLineToSrcLine;  // asm line (1-based) → src line (1-based)
-    QMap<int, int>  m_srcLineToFirstAsm; // src line → first asm line for it
+    QByteArray      m_rawAsm;            // Unfiltered -S output of the last run
+    AsmDocument     m_document;          // Filtered listing + asm ↔ source index
+    QElapsedTimer   m_runTimer;          // Run-to-listing time shown in the status
+    QVector<int>    m_mcaLines;          // Asm lines sent to llvm-mca, in order
+    QString         m_mcaCpu;            // CPU of the analysis in flight
+    SourceHeat      m_heat;              // Per-line cost of the current listing
+    QThreadPool     m_heatPool;          // Assembles listings for code bytes
+    quint64         m_heatSerial = 0;    // Drops byte counts of replaced listings
 };
 
 #endif // ASSEMBLYWIDGET_H
@@ -1,18 +1,34 @@
 #ifndef BENCHMARKCHARTWIDGET_H
 #define BENCHMARKCHARTWIDGET_H
 
+#include <QColor>
 #include <QWidget>
 #include "tools/BenchmarkResult.h"
+#include "tools/BenchmarkStats.h"
 
 /**
  * @brief Visualizes BenchmarkResult data as interactive charts.
  *
  * When CPPATLAS_CHARTS_AVAILABLE is defined (Qt Charts found at CMake time):
- *   Bar chart    — real_time per benchmark entry (default view after Run).
- *   Line chart   — parametric benchmarks whose names contain "/" (BM_Sort/8,
- *                  BM_Sort/16, …).  Groups by base name; x-axis = parameter.
+ *   Bar chart    — median real_time per benchmark over its repetitions
+ *                  (default view after Run).
+ *   Line chart   — parameter sweeps (BenchmarkStats::sweeps) on log-log axes,
+ *                  one line per sweep along its first varying argument, with
+ *                  the ->Complexity() fit dashed over it when the library
+ *                  reported one.  Lines of more than a few hundred points
+ *                  are downsampled (BenchmarkStats::downsample, in log space).
  *   Comparison   — multiple BenchmarkResult objects side-by-side as grouped
  *                  bar chart (up to MAX_COMPARE runs from BenchmarkWidget).
+ *   Scaling      — speedup against thread count for every benchmark run at
+ *                  several (->ThreadRange), with ideal linear speedup, the
+ *                  Amdahl fit and parallel efficiency on a second axis.
+ *   Trend        — one line per benchmark across stored runs of the same
+ *                  source (BenchmarkHistory), the pinned baseline marked.
+ *
+ * Bar, line and comparison plot the selected BenchmarkMetric: real time, or one derived
+ * from hardware counters (IPC, cache misses, branch mispredicts).
+ * Benchmarks without those counters plot as 0; the log-scale line chart
+ * leaves them out.
  *
  * When Qt Charts is NOT available:
  *   Shows a QLabel with platform-specific install instructions.
@@ -26,9 +42,19 @@ class BenchmarkChartWidget : public QWidget {
 
 public:
     enum class ChartType {
-        Bar,          ///< One bar per BenchmarkEntry (real_time)
-        Line,         ///< Parametric benchmarks, x = numeric suffix after "/"
-        SpeedupRatio  ///< Normalised to first run (comparison mode)
+        Bar,          ///< One bar per benchmark (median real_time)
+        Line,         ///< Parameter sweeps, log-log, x = first varying argument
+        SpeedupRatio, ///< Normalised to first run (comparison mode)
+        Scaling       ///< Speedup and efficiency against threads (BenchmarkStats::scaling)
+    };
+
+    /**
+     * @brief One bar set of a grouped bar chart (see showGroupedBars()).
+     */
+    struct BarGroup {
+        QString       label;
+        QColor        color;    ///< Invalid = chart palette
+        QList<double> values;   ///< One value per category
     };
 
     explicit BenchmarkChartWidget(QWidget* parent = nullptr);
@@ -40,9 +66,38 @@ public:
     /** Display two or more runs side-by-side.  Enables grouped bar chart. */
     void compareResults(const QList<BenchmarkResult>& results);
 
+    /**
+     * @brief Grouped bar chart of arbitrary values.
+     *
+     * The comparison chart is built on this; Build Bench uses it directly
+     * for compile time, peak memory and speedup.
+     */
+    void showGroupedBars(const QStringList& categories, const QList<BarGroup>& groups,
+                         const QString& title, const QString& axisTitle);
+
+    /**
+     * @brief Trend of every benchmark across @p runs, oldest first.
+     *
+     * x is the run's position, 1-based; y the selected metric of each
+     * benchmark's repetitions (median real time in ns).  The run at
+     * @p baselineIndex (< 0: none) gets a vertical line.  At most a dozen
+     * benchmarks are drawn, in order of appearance.
+     */
+    void showTrend(const QList<BenchmarkResult>& runs, int baselineIndex = -1);
+
     void      setChartType(ChartType type);
     ChartType chartType() const { return m_chartType; }
 
+    /** Takes effect with the next setResult() / compareResults(). */
+    void            setMetric(BenchmarkMetric metric) { m_metric = metric; }
+    BenchmarkMetric metric() const { return m_metric; }
+
+    /**
+     * Series animations on (default) or off for the charts built from now
+     * on; BenchmarkWidget turns them off while rows stream in.
+     */
+    void setAnimated(bool animated) { m_animated = animated; }
+
 public slots:
     /** Called by ThemeManager::themeChanged — updates chart colours. */
     void onThemeChanged(const QString& themeName);
@@ -53,14 +108,19 @@ private:
 #ifdef CPPATLAS_CHARTS_AVAILABLE
     void buildBarChart       (const BenchmarkResult& result);
     void buildLineChart      (const BenchmarkResult& result);
+    void buildScalingChart   (const BenchmarkResult& result);
     void buildComparisonChart(const QList<BenchmarkResult>& results);
+    void buildTrendChart     (const QList<BenchmarkResult>& runs, int baselineIndex);
+    void installChart        (class QChart* chart);   // Frees the chart it replaces
     void applyChartTheme     (const QString& themeName);
 
     // m_chartView is only declared when Charts is available.
     class QChartView* m_chartView = nullptr;
 #endif
 
-    ChartType m_chartType = ChartType::Bar;
+    ChartType       m_chartType = ChartType::Bar;
+    BenchmarkMetric m_metric    = BenchmarkMetric::RealTime;
+    bool            m_animated  = true;
 };
 
 #endif // BENCHMARKCHARTWIDGET_H
@@ -0,0 +1,62 @@
+#ifndef BENCHMARKHEATMAPWIDGET_H
+#define BENCHMARKHEATMAPWIDGET_H
+
+#include <QVector>
+#include <QWidget>
+#include "tools/BenchmarkResult.h"
+#include "tools/BenchmarkStats.h"
+
+class QComboBox;
+
+/**
+ * @brief Custom-painted heatmap of two-argument parameter sweeps.
+ *
+ * One cell per run of a ParameterSweep with exactly two varying arguments
+ * (->Ranges, ->ArgsProduct): columns are the first argument, rows the
+ * second, growing upwards.  The shade is the selected BenchmarkMetric on a
+ * log scale, from the theme's success colour at the lowest value through
+ * warning to error at the highest; runs without the metric stay empty.
+ * With several such sweeps a combo box above the grid picks one.
+ *
+ * Hovering a cell shows its run name and value.  Cells shrink with the
+ * widget and drop their labels when too small, so large grids still
+ * paint in one pass.  Does not need Qt Charts.
+ */
+class BenchmarkHeatmapWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit BenchmarkHeatmapWidget(QWidget* parent = nullptr);
+
+    void setResult(const BenchmarkResult& result);
+    void setMetric(BenchmarkMetric metric);
+    BenchmarkMetric metric() const { return m_metric; }
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+
+private:
+    static constexpr int HEADER_HEIGHT = 20;
+    static constexpr int LEGEND_WIDTH  = 14;
+
+    void   selectSweep(int index);
+    QRectF gridRect() const;
+    int    pointAt(const QPoint& pos) const;
+    double valueOf(const SweepPoint& p) const;   ///< < 0 when not measured
+    QString formatValue(double value) const;
+
+    QComboBox*            m_sweepCombo = nullptr;
+    QList<ParameterSweep> m_sweeps;              ///< Two-dimensional only
+    BenchmarkMetric       m_metric = BenchmarkMetric::RealTime;
+
+    // Layout of the selected sweep
+    int           m_current = -1;
+    QList<qint64> m_columns;                     ///< Distinct first-argument values, ascending
+    QList<qint64> m_rows;                        ///< Distinct second-argument values, ascending
+    QVector<int>  m_cells;                       ///< row * columns + column -> point index, -1 = none
+};
+
+#endif // BENCHMARKHEATMAPWIDGET_H
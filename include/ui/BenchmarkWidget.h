@@ -8,17 +8,28 @@
 #include <QTemporaryFile>
 #include "tools/BenchmarkRunner.h"
 #include "tools/BenchmarkResult.h"
+#include "tools/QuickBench.h"
 
 class QsciScintilla;
+class QCheckBox;
 class QComboBox;
+class QDoubleSpinBox;
 class QPushButton;
+class QSpinBox;
 class QLabel;
+class QLineEdit;
 class QTabWidget;
 class QTableWidget;
 class QScrollArea;
+class QStackedWidget;
 class QVBoxLayout;
 class QPlainTextEdit;
+class QProgressBar;
+class QTimer;
 class BenchmarkChartWidget;
+class BenchmarkHeatmapWidget;
+class BenchmarkHistory;
+class QuickBenchWidget;
 
 // ── Result record ─────────────────────────────────────────────────────────────
 
@@ -45,18 +56,43 @@ struct BenchmarkResultRecord {
  * @brief Full benchmark authoring and results widget.
  *
  * Layout:
- *   ┌─ Toolbar: [Opt] [▶ Run] [Export...] [Compare] [status] ──────────┐
+ *   ┌─ Toolbar: [Opt] [Reps] [Min time] [Interleave] [Adaptive] [▶ Run] [Export...] [Compare] [status] ┐
  *   │  (NO compiler / standard combo — received via setCompilerId /     │
  *   │   setStandard from MainWindow, exactly like AssemblyWidget)        │
  *   ├─ QsciScintilla code editor (pre-loaded with benchmark_template)  ─┤
+ *   │  or, with [Quick Bench] down, QuickBenchWidget: setup + snippets   │
  *   └─ QTabWidget results:                                              ─┘
  *       "Charts"   — BenchmarkChartWidget (bar / line / comparison)
- *       "Table"    — QTableWidget: Name | Real Time | CPU Time | Iters
+ *       "Table"    — QTableWidget, one row per benchmark over its repetitions:
+ *                    Name | Real Time (median) | CPU Time | Iters | Reps | CV | 95% CI
  *       "Raw JSON" — QPlainTextEdit, raw --benchmark_format=json output
+ *       "Convergence" — live per-benchmark repetitions / CV / CI width / state
+ *                    while an adaptive run samples (tab 5)
+ *       "History"  — every finished run of a source, stored in BenchmarkHistory
+ *                    (SQLite): runs table, per-benchmark trend and the pinned
+ *                    baseline (tab 8)
+ *       "Quick Bench" — speedup of every snippet against the first, with
+ *                    its confidence interval and verdict (tab 9)
+ *
+ *   Charts and Table fill in row by row while the binary runs
+ *   (BenchmarkRunner::entryReady); the toolbar progress bar counts finished
+ *   benchmarks against --benchmark_list_tests.
  *
  * Compare:
  *   Saves up to MAX_COMPARE (5) results.  "Compare" button enabled once
- *   ≥ 2 results are saved; passes them to BenchmarkChartWidget::compareResults().
+ *   ≥ 2 results are saved; passes them to BenchmarkChartWidget::compareResults()
+ *   and lists a Mann-Whitney U verdict (BenchmarkStats::compare) of every
+ *   other compared run against the first one under the chart.
+ *
+ * Quick Bench:
+ *   The snippets become one generated harness (QuickBench::generate),
+ *   compiled once and run with interleaved repetitions
+ *   (QuickBench::runOptions); the result also lands in Results as usual.
+ *
+ * History:
+ *   Each finished run is stored with its source text.  When a baseline is
+ *   pinned for that source the new run is compared to it and the status
+ *   line reports BenchmarkHistory::regressionFlags().
  *
  * Theme:
  *   Reacts to ThemeManager::themeChanged; propagates to code editor and chart.
@@ -92,6 +128,10 @@ private slots:
     void onBenchmarkResultReady(const BenchmarkResult& result);
     void onCompilationFinished(bool success, const QString& error);
     void onProgressMessage(const QString& msg);
+    void onConvergenceUpdated(const BenchmarkConvergence& convergence);
+    void onEntryReady(const BenchmarkEntry& entry);
+    void onRunProgress(int done, int total);
+    void onRunnerFinished(bool success, const QString& output, const QString& error);
     void onCompareClicked();
     void stopProcess();
 
@@ -111,6 +151,7 @@ private:
     void setupCodeEditor();
     void setupResultsTabs();
     void setupResultsManagerTab();
+    void setupHistoryTab();
 
     // ── Helpers ───────────────────────────────────────────────────────────────
     void addRecord(const BenchmarkResult& result,
@@ -126,11 +167,42 @@ private:
     /** Push all records with inComparison=true to the Comparison chart. */
     void refreshComparison();
 
+    /** Records ticked for comparison, decorated with label and colour. */
+    QList<BenchmarkResult> comparedResults() const;
+
+    /** Fill the verdict table: every compared record against the first. */
+    void updateVerdictTable(const QList<BenchmarkResult>& compared);
+
+    /** Machine and noise warnings of each compared run, above the verdicts. */
+    void updateComparisonContext(const QList<BenchmarkResult>& compared);
+
     /** Apply display metadata from m_records[row] to the BenchmarkResult
      *  passed to buildComparisonChart so bar colors and labels are correct. */
     BenchmarkResult decoratedResult(int recordIndex) const;
 
     void updateResultsView(const BenchmarkResult& result);
+
+    /** History tab: source names, runs of the selected one and their trend. */
+    void refreshHistory();
+
+    /** History runs table: the run id of the selected row, -1 if none. */
+    qint64 selectedHistoryRun() const;
+
+    /** Quick Bench tab: ratio chart and lines for a finished Quick Bench run. */
+    void showQuickBenchResult(const BenchmarkResult& result);
+
+    /** Every code editor: benchmark tabs, then the Quick Bench panes. */
+    QList<QsciScintilla*> benchEditors() const;
+
+    /** Table tab: one row per benchmark summarised over its repetitions. */
+    void populateTable(const BenchmarkResult& result);
+
+    /** Charts and Table from m_liveResult, animations off; throttled by m_liveRefreshTimer. */
+    void refreshLiveResult();
+
+    /** Drop a pending live refresh and turn chart animations back on. */
+    void stopLiveRefresh();
+
     void applyThemeToEditor(const QString& themeName);
 
     // ── Code editor helpers ───────────────────────────────────────────────────
@@ -142,23 +214,45 @@ private:
 
     // ── Toolbar widgets ───────────────────────────────────────────────────────
     QComboBox*   m_optimizationCombo = nullptr;
+    QSpinBox*       m_repetitionsSpin    = nullptr;
+    QDoubleSpinBox* m_minTimeSpin        = nullptr;
+    QCheckBox*      m_interleaveCheck    = nullptr;
+    QCheckBox*      m_adaptiveCheck      = nullptr;
+    QDoubleSpinBox* m_targetSpin         = nullptr;
+    QSpinBox*       m_budgetSpin         = nullptr;
+    QLineEdit*      m_pinCpusEdit        = nullptr;
+    QCheckBox*      m_priorityCheck      = nullptr;
+    QCheckBox*      m_perfCountersCheck  = nullptr;
+    QCheckBox*      m_allocationsCheck   = nullptr;
+    QSpinBox*       m_threadSweepSpin    = nullptr;
+    QComboBox*      m_metricCombo        = nullptr;   // What Charts, Comparison and Parameters plot
     QPushButton* m_openFileButton    = nullptr;
     QPushButton* m_saveFileButton    = nullptr;
     QPushButton* m_importButton      = nullptr;
+    QPushButton* m_quickBenchButton  = nullptr;   // Checkable: snippets instead of files
     QPushButton* m_runButton         = nullptr;
     QPushButton* m_stopButton        = nullptr;
     QPushButton* m_exportButton      = nullptr;
     QPushButton* m_compareButton     = nullptr;
+    QProgressBar* m_progressBar      = nullptr;   // Benchmarks done / listed, while running
     QLabel*      m_statusLabel       = nullptr;
 
     // ── Code editor tabs ──────────────────────────────────────────────────────
-    QTabWidget* m_editorTabs      = nullptr;
-    int         m_newBenchCounter = 1;
+    QStackedWidget*   m_editorStack     = nullptr;   // m_editorTabs or m_quickBench
+    QTabWidget*       m_editorTabs      = nullptr;
+    QuickBenchWidget* m_quickBench      = nullptr;
+    int               m_newBenchCounter = 1;
 
     // ── Results tabs ──────────────────────────────────────────────────────────
     QTabWidget*           m_resultsTabs            = nullptr;
     BenchmarkChartWidget* m_chartWidget            = nullptr;
     BenchmarkChartWidget* m_comparisonChartWidget  = nullptr;
+    BenchmarkChartWidget* m_scalingChartWidget     = nullptr;
+    BenchmarkChartWidget* m_sweepChartWidget       = nullptr;   // Parameters tab: log-log lines
+    BenchmarkHeatmapWidget* m_heatmapWidget        = nullptr;   // ...and two-argument heatmap
+    QTableWidget*         m_verdictTable           = nullptr;
+    QLabel*               m_comparisonContextLabel = nullptr;
+    QTableWidget*         m_convergenceTable       = nullptr;
     QTableWidget*         m_tableWidget            = nullptr;
     QPlainTextEdit*       m_rawJsonView            = nullptr;
 
@@ -168,13 +262,34 @@ private:
     QVBoxLayout*  m_recordsLayout     = nullptr;
     QPushButton*  m_clearAllBtn       = nullptr;
 
+    // History tab (index 8)
+    QComboBox*            m_historySourceCombo  = nullptr;
+    QTableWidget*         m_historyTable        = nullptr;
+    BenchmarkChartWidget* m_historyChartWidget  = nullptr;
+    QPushButton*          m_pinBaselineButton   = nullptr;
+    QPushButton*          m_unpinBaselineButton = nullptr;
+    QPushButton*          m_loadHistoryButton   = nullptr;
+    QPushButton*          m_deleteHistoryButton = nullptr;
+
+    // Quick Bench tab (index 9)
+    BenchmarkChartWidget* m_quickChartWidget = nullptr;
+    QLabel*               m_quickRatioLabel  = nullptr;
+
     // ── Backend ───────────────────────────────────────────────────────────────
-    BenchmarkRunner* m_runner = nullptr;
+    BenchmarkRunner*  m_runner  = nullptr;
+    BenchmarkHistory* m_history = nullptr;
 
     // ── State ─────────────────────────────────────────────────────────────────
     QString m_compilerId;
     QString m_standard = QStringLiteral("c++17");
     QScopedPointer<QTemporaryFile> m_tempBenchSource;
+    BenchmarkResult m_liveResult;   // Rows streamed so far by the current run
+    QTimer* m_liveRefreshTimer = nullptr;   // Single-shot; batches rows for refreshLiveResult()
+    // Streamed rows redraw Charts / Table at most this often
+    static constexpr int LIVE_REFRESH_MS = 250;
+    QString m_runSourceName;        // File path, or tab title when untitled — the history key
+    QString m_runSourceText;        // What the current run compiled
+    QList<QuickBenchSnippet> m_quickRunSnippets;   // Non-empty while a Quick Bench run is out
 
     QList<BenchmarkResultRecord> m_records;
 
@@ -0,0 +1,108 @@
+#ifndef BUILDBENCHWIDGET_H
+#define BUILDBENCHWIDGET_H
+
+#include <QWidget>
+#include "tools/BuildBenchRunner.h"
+
+class QsciScintilla;
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QMenu;
+class QProgressBar;
+class QPushButton;
+class QSpinBox;
+class QTabWidget;
+class QTableWidget;
+class QToolButton;
+class BenchmarkChartWidget;
+
+/**
+ * @brief Build Bench: compare how expensive code variants are to compile.
+ *
+ * Layout:
+ *   ┌─ Toolbar: [Compilers▾] [Standards▾] [Opt▾] [Reps] [Parallel]
+ *   │           [▶ Run] [■ Stop] [progress] [status] ──────────────────┐
+ *   ├─ QTabWidget of snippet editors ("+" adds a variant)             ─┤
+ *   └─ QTabWidget results:                                            ─┘
+ *       "Chart" — BenchmarkChartWidget grouped bars, one group per
+ *                 configuration, one bar per snippet; metric selectable
+ *       "Table" — Snippet | Configuration | Wall | CPU | Peak RSS | Speedup
+ *
+ * Every snippet is compiled under every checked compiler × standard × -O
+ * level by BuildBenchRunner.  Speedup is relative to the first snippet
+ * under the same configuration.
+ *
+ * The compiler and standard chosen in MainWindow's toolbar (setCompilerId /
+ * setStandard) are pre-selected until the user picks their own.
+ */
+class BuildBenchWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit BuildBenchWidget(QWidget* parent = nullptr);
+    ~BuildBenchWidget() override = default;
+
+    void setCompilerId(const QString& id);
+    void setStandard(const QString& standard);
+
+public slots:
+    void runBench();
+    void stopBench();
+    void onThemeChanged(const QString& themeName);
+    void applyEditorSettings(const QFont& font, bool showLineNumbers, bool wordWrap);
+
+private slots:
+    void onCaseFinished(const BuildBenchCase& result);
+    void onBenchFinished(const QList<BuildBenchCase>& cases, bool cancelled);
+    void onProgressChanged(int completed, int total);
+    void rebuildCompilerMenu();
+    void refreshChart();
+
+private:
+    enum class Metric {
+        WallTime,
+        CpuTime,
+        PeakRss,
+        Speedup
+    };
+
+    void setupUi();
+    void setupToolbar(QWidget* toolbar);
+    void addSnippetTab(const QString& name, const QString& code);
+    void refreshTable();
+    void applyThemeToEditor(QsciScintilla* editor);
+
+    static QToolButton* makeMenuButton(const QString& text, QWidget* parent, QMenu** menu);
+    static void addCheckableItems(QMenu* menu, const QStringList& items, const QStringList& checked);
+    static QStringList checkedItems(const QMenu* menu);
+
+    // ── Toolbar ───────────────────────────────────────────────────────────────
+    QMenu*        m_compilerMenu  = nullptr;
+    QMenu*        m_standardMenu  = nullptr;
+    QMenu*        m_optMenu       = nullptr;
+    QSpinBox*     m_repsSpin      = nullptr;
+    QCheckBox*    m_parallelCheck = nullptr;
+    QPushButton*  m_runButton     = nullptr;
+    QPushButton*  m_stopButton    = nullptr;
+    QProgressBar* m_progressBar   = nullptr;
+    QLabel*       m_statusLabel   = nullptr;
+
+    // ── Editors / results ─────────────────────────────────────────────────────
+    QTabWidget*           m_snippetTabs  = nullptr;
+    QTabWidget*           m_resultsTabs  = nullptr;
+    QComboBox*            m_metricCombo  = nullptr;
+    BenchmarkChartWidget* m_chartWidget  = nullptr;
+    QTableWidget*         m_tableWidget  = nullptr;
+
+    // ── State ─────────────────────────────────────────────────────────────────
+    BuildBenchRunner*     m_runner = nullptr;
+    QList<BuildBenchCase> m_cases;
+    QString m_compilerId;
+    QString m_standard = QStringLiteral("c++17");
+    bool    m_userPickedCompilers = false;
+    bool    m_userPickedStandards = false;
+    int     m_snippetCounter = 0;
+};
+
+#endif // BUILDBENCHWIDGET_H
@@ -0,0 +1,101 @@
+#ifndef COMPILEPROFILEWIDGET_H
+#define COMPILEPROFILEWIDGET_H
+
+#include <QWidget>
+#include "tools/CompileProfile.h"
+#include "tools/CompileProfileRunner.h"
+
+class QComboBox;
+class QLabel;
+class QPlainTextEdit;
+class QPushButton;
+class QScrollArea;
+class QTabWidget;
+class QTableWidget;
+class FlameChartWidget;
+
+/**
+ * @brief Compile-time profiler for the active editor buffer.
+ *
+ * Layout:
+ *   ┌─ Toolbar: [Opt] [Compare with] [▶ Profile] [■ Stop] [status] ─────┐
+ *   └─ QTabWidget:                                                       ┘
+ *       "Flame Chart" — current run above, baseline run below when comparing
+ *       "Headers"     — ranked include cost
+ *       "Templates"   — ranked template instantiations
+ *       "Functions"   — ranked parse/optimise/codegen time per function
+ *       "Phases"      — Clang "Total X" summaries or GCC -ftime-report rows
+ *       "Raw"         — trace JSON / compiler stderr
+ *
+ * Compare: every successful run is kept (up to MAX_HISTORY).  Choosing an
+ * earlier run in "Compare with" shows it below the current flame chart
+ * and adds Baseline / Δ columns to the ranked tables, matched by name.
+ *
+ * Compiler and standard are received via setCompilerId / setStandard,
+ * exactly like AssemblyWidget.
+ */
+class CompileProfileWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit CompileProfileWidget(QWidget* parent = nullptr);
+    ~CompileProfileWidget() override;
+
+    void setCompilerId(const QString& id);
+    void setStandard(const QString& standard);
+    void setSourceCode(const QString& code, const QString& filePath);
+
+public slots:
+    void runProfile();
+    void stopProcess();
+
+private slots:
+    void onRunnerStarted();
+    void onRunnerFinished(bool success, const QString& output, const QString& error);
+    void onProgressMessage(const QString& msg);
+    void onProfileReady(const CompileProfile& profile);
+    void onCompareChanged(int index);
+
+private:
+    static constexpr int MAX_HISTORY    = 10;
+    static constexpr int MAX_TABLE_ROWS = 200;
+
+    void setupUi();
+    void refreshViews();
+    void fillTable(QTableWidget* table,
+                   const QList<CompileProfileEntry>& entries,
+                   const QList<CompileProfileEntry>* baseline);
+    void rebuildCompareCombo();
+    const CompileProfile* baselineProfile() const;
+
+    // ── Toolbar ───────────────────────────────────────────────────────────────
+    QComboBox*   m_optimizationCombo = nullptr;
+    QComboBox*   m_compareCombo      = nullptr;
+    QPushButton* m_runButton         = nullptr;
+    QPushButton* m_stopButton        = nullptr;
+    QLabel*      m_statusLabel       = nullptr;
+
+    // ── Views ─────────────────────────────────────────────────────────────────
+    QTabWidget*       m_tabs           = nullptr;
+    FlameChartWidget* m_currentChart   = nullptr;
+    FlameChartWidget* m_baselineChart  = nullptr;
+    QScrollArea*      m_baselineScroll = nullptr;
+    QTableWidget*     m_headersTable   = nullptr;
+    QTableWidget*     m_templatesTable = nullptr;
+    QTableWidget*     m_functionsTable = nullptr;
+    QTableWidget*     m_phasesTable    = nullptr;
+    QPlainTextEdit*   m_rawView        = nullptr;
+
+    // ── Backend / state ───────────────────────────────────────────────────────
+    CompileProfileRunner* m_runner = nullptr;
+    QString m_compilerId;
+    QString m_standard = QStringLiteral("c++17");
+    QString m_currentSourceCode;
+    QString m_currentFilePath;
+    QString m_tempSourceFile;
+
+    QList<CompileProfile> m_history;   ///< Newest last
+    int m_runCounter = 0;
+};
+
+#endif // COMPILEPROFILEWIDGET_H
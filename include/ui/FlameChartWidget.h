@@ -0,0 +1,63 @@
+#ifndef FLAMECHARTWIDGET_H
+#define FLAMECHARTWIDGET_H
+
+#include <QWidget>
+#include "tools/CompileProfile.h"
+
+/**
+ * @brief Custom-painted flame chart of a CompileProfile.
+ *
+ * One row per nesting depth; each span's width is proportional to its
+ * duration (or, for GCC profiles, to the number of headers it includes).
+ * Spans are coloured by kind: headers, template instantiations, functions
+ * and everything else.
+ *
+ * Interaction:
+ *   hover          — tooltip with kind, detail and cost
+ *   wheel          — zoom around the cursor
+ *   double-click   — zoom to the clicked span; on empty space, reset
+ *
+ * Height follows the deepest row so the widget can sit in a QScrollArea.
+ */
+class FlameChartWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit FlameChartWidget(QWidget* parent = nullptr);
+
+    void setProfile(const CompileProfile& profile);
+    void setCaption(const QString& caption);
+    void clear();
+
+    /** Show the whole profile again. */
+    void resetZoom();
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+
+private:
+    static constexpr int ROW_HEIGHT    = 18;
+    static constexpr int HEADER_HEIGHT = 20;
+
+    int eventAt(const QPoint& pos) const;
+    QRectF eventRect(const CompileProfileEvent& e) const;
+    QString formatCost(qint64 value) const;
+    static QColor colorForEvent(const CompileProfileEvent& e);
+
+    QList<CompileProfileEvent> m_events;
+    CompileProfile::Unit m_unit = CompileProfile::Unit::Microseconds;
+    QString m_caption;
+    int     m_maxDepth  = 0;
+    qint64  m_total     = 0;
+
+    // Visible range, in profile units
+    double  m_viewStart = 0;
+    double  m_viewSpan  = 1;
+};
+
+#endif // FLAMECHARTWIDGET_H
@@ -0,0 +1,105 @@
+#ifndef MATRIXWIDGET_H
+#define MATRIXWIDGET_H
+
+#include <QWidget>
+#include "tools/MatrixRunner.h"
+
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QMenu;
+class QProgressBar;
+class QPushButton;
+class QTabWidget;
+class QTableWidget;
+class QToolButton;
+class BenchmarkChartWidget;
+
+/**
+ * @brief Configuration matrix: one source under many compiler settings.
+ *
+ * Layout:
+ *   ┌─ Toolbar: [Compilers▾] [Standards▾] [Opt▾] [-march▾] [Benchmarks]
+ *   │           [▶ Run Matrix] [■ Stop] [progress] [status] ───────────┐
+ *   ├─ Metric: [combo]   Benchmark: [combo]                            ─┤
+ *   └─ QTabWidget:                                                     ─┘
+ *       "Grid"  — sortable table, one row per cell:
+ *                 Compiler | Standard | Opt | -march | Compile (ms) |
+ *                 Asm (KB) | Instructions | Functions | Benchmark (ns)
+ *       "Chart" — BenchmarkChartWidget grouped bars of the chosen metric,
+ *                 one group per compiler, one category per flag set
+ *
+ * Builds the active editor buffer (setSourceCode), not the file on disk.
+ * Benchmark columns fill in only for Google Benchmark sources.
+ */
+class MatrixWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit MatrixWidget(QWidget* parent = nullptr);
+    ~MatrixWidget() override = default;
+
+    void setSourceCode(const QString& code, const QString& filePath);
+    void setCompilerId(const QString& id);
+    void setStandard(const QString& standard);
+
+public slots:
+    void runMatrix();
+    void stopMatrix();
+    void onThemeChanged(const QString& themeName);
+
+private slots:
+    void onCellUpdated(int index, const MatrixCell& cell);
+    void onMatrixFinished(const QList<MatrixCell>& cells, bool cancelled);
+    void onProgressChanged(int completed, int total);
+    void rebuildCompilerMenu();
+    void refreshChart();
+    void refreshTable();
+
+private:
+    enum class Metric {
+        CompileTime,
+        AsmSize,
+        Instructions,
+        BenchmarkTime
+    };
+
+    void setupUi();
+    void setupToolbar(QWidget* toolbar);
+    void refreshBenchmarkNames();
+    double metricValue(const MatrixCell& cell, Metric metric) const;
+
+    static QToolButton* makeMenuButton(const QString& text, QWidget* parent, QMenu** menu);
+    static void addCheckableItems(QMenu* menu, const QStringList& items, const QStringList& checked);
+    static QStringList checkedItems(const QMenu* menu);
+
+    // ── Toolbar ───────────────────────────────────────────────────────────────
+    QMenu*        m_compilerMenu   = nullptr;
+    QMenu*        m_standardMenu   = nullptr;
+    QMenu*        m_optMenu        = nullptr;
+    QMenu*        m_marchMenu      = nullptr;
+    QCheckBox*    m_benchmarkCheck = nullptr;
+    QPushButton*  m_runButton      = nullptr;
+    QPushButton*  m_stopButton     = nullptr;
+    QProgressBar* m_progressBar    = nullptr;
+    QLabel*       m_statusLabel    = nullptr;
+
+    // ── Results ───────────────────────────────────────────────────────────────
+    QComboBox*            m_metricCombo    = nullptr;
+    QComboBox*            m_benchmarkCombo = nullptr;
+    QTabWidget*           m_resultsTabs    = nullptr;
+    QTableWidget*         m_tableWidget    = nullptr;
+    BenchmarkChartWidget* m_chartWidget    = nullptr;
+
+    // ── State ─────────────────────────────────────────────────────────────────
+    MatrixRunner*     m_runner = nullptr;
+    QList<MatrixCell> m_cells;
+    QString m_currentSourceCode;
+    QString m_currentFilePath;
+    QString m_compilerId;
+    QString m_standard = QStringLiteral("c++17");
+    bool    m_userPickedCompilers = false;
+    bool    m_userPickedStandards = false;
+};
+
+#endif // MATRIXWIDGET_H
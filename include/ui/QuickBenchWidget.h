@@ -0,0 +1,69 @@
+#ifndef QUICKBENCHWIDGET_H
+#define QUICKBENCHWIDGET_H
+
+#include <QList>
+#include <QWidget>
+#include "tools/QuickBench.h"
+
+class QsciScintilla;
+class QLineEdit;
+class QPushButton;
+class QSplitter;
+class QToolButton;
+
+/**
+ * @brief Quick Bench editor: a shared setup block above side-by-side snippets.
+ *
+ * Layout:
+ *   ┌─ [+ Snippet]  hint ───────────────────────────────────────┐
+ *   ├─ Setup — untimed, before every snippet; #include lines go ─┤
+ *   │  to file scope                                              │
+ *   ├─ [A        ✕] │ [B        ✕] │ ...   one pane per snippet ──┤
+ *   └────────────────────────────────────────────────────────────┘
+ *
+ * Holds QuickBench::MIN_SNIPPETS to QuickBench::MAX_SNIPPETS panes, the
+ * first being the reference the ratios are taken against.  Added panes
+ * take the first free letter, A, B, ..., as their name.
+ *
+ * BenchmarkWidget turns setup() and snippets() into a harness with
+ * QuickBench::generate() and styles the editors() like its own.
+ */
+class QuickBenchWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit QuickBenchWidget(QWidget* parent = nullptr);
+
+    QString                  setup() const;
+    QList<QuickBenchSnippet> snippets() const;
+
+    /** Setup editor first, then one per snippet pane. */
+    QList<QsciScintilla*> editors() const;
+
+    /** Append a pane; ignored at QuickBench::MAX_SNIPPETS. */
+    void addSnippet(const QString& name, const QString& code);
+
+signals:
+    /** A snippet pane was added; its editor needs theming. */
+    void editorAdded(QsciScintilla* editor);
+
+private:
+    struct Pane {
+        QWidget*       frame        = nullptr;
+        QLineEdit*     nameEdit     = nullptr;
+        QToolButton*   removeButton = nullptr;
+        QsciScintilla* editor       = nullptr;
+    };
+
+    QsciScintilla* createEditor(QWidget* parent) const;
+    void           removeSnippet(QWidget* frame);
+    void           updateButtons();
+    QString        nextName() const;
+
+    QsciScintilla* m_setupEditor     = nullptr;
+    QSplitter*     m_snippetSplitter = nullptr;
+    QPushButton*   m_addButton       = nullptr;
+    QList<Pane>    m_panes;
+};
+
+#endif // QUICKBENCHWIDGET_H
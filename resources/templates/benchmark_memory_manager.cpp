@@ -0,0 +1,124 @@
+// ============================================================
+// Allocation counting for Google Benchmark — CppAtlas
+//
+// Compiled next to a benchmark when "Allocs" is on.  Registers with
+// benchmark::RegisterMemoryManager; the library then runs every
+// benchmark once more, for a few iterations, with the manager started
+// and reports in its JSON output:
+//   allocs_per_iter        operator new calls per iteration
+//   total_allocated_bytes  bytes requested in that run
+//   max_bytes_used         peak of live bytes above the start
+//   net_heap_growth        live bytes left at the end
+//
+// The replaceable global operator new / delete are counted, which
+// covers every standard container and smart pointer.  Plain malloc
+// and over-aligned new are not.  Outside the memory run the only
+// cost is one relaxed atomic load per allocation.
+// ============================================================
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+namespace {
+
+std::atomic<bool>         g_active{false};
+std::atomic<std::int64_t> g_allocs{0};
+std::atomic<std::int64_t> g_requested{0};
+std::atomic<std::int64_t> g_live{0};
+std::atomic<std::int64_t> g_peak{0};
+
+std::size_t usableSize(void* p) {
+#if defined(__APPLE__)
+    return malloc_size(p);
+#elif defined(_WIN32)
+    return _msize(p);
+#else
+    return malloc_usable_size(p);
+#endif
+}
+
+void countAlloc(std::size_t requested, void* p) {
+    if (!g_active.load(std::memory_order_relaxed)) return;
+    const auto usable = static_cast<std::int64_t>(usableSize(p));
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_requested.fetch_add(static_cast<std::int64_t>(requested), std::memory_order_relaxed);
+    const std::int64_t live = g_live.fetch_add(usable, std::memory_order_relaxed) + usable;
+    std::int64_t peak = g_peak.load(std::memory_order_relaxed);
+    while (live > peak
+           && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+// Frees of blocks from before Start() count too: live bytes are net
+void countFree(void* p) {
+    if (!g_active.load(std::memory_order_relaxed)) return;
+    g_live.fetch_sub(static_cast<std::int64_t>(usableSize(p)), std::memory_order_relaxed);
+}
+
+void* countedNew(std::size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (p) countAlloc(size, p);
+    return p;
+}
+
+void countedDelete(void* p) {
+    if (!p) return;
+    countFree(p);
+    std::free(p);
+}
+
+class CountingMemoryManager : public benchmark::MemoryManager {
+public:
+    void Start() {
+        g_allocs    = 0;
+        g_requested = 0;
+        g_live      = 0;
+        g_peak      = 0;
+        g_active    = true;
+    }
+
+    // Library 1.8+ makes the reference overload the pure one, 1.7 the pointer one
+    void Stop(Result& result) {
+        g_active = false;
+        result.num_allocs            = g_allocs;
+        result.total_allocated_bytes = g_requested;
+        result.max_bytes_used        = g_peak;
+        result.net_heap_growth       = g_live;
+    }
+    void Stop(Result* result) { Stop(*result); }
+};
+
+CountingMemoryManager g_manager;
+const bool g_registered = (benchmark::RegisterMemoryManager(&g_manager), true);
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    if (void* p = countedNew(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = countedNew(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedNew(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedNew(size); }
+
+void operator delete(void* p) noexcept { countedDelete(p); }
+void operator delete[](void* p) noexcept { countedDelete(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { countedDelete(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { countedDelete(p); }
+#if defined(__cpp_sized_deallocation)
+void operator delete(void* p, std::size_t) noexcept { countedDelete(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedDelete(p); }
+#endif
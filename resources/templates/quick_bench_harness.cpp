@@ -0,0 +1,70 @@
+// ============================================================
+// Quick Bench harness — CppAtlas
+//
+// Filled in by QuickBench::generate() from the snippet panes of the
+// Benchmark view; edit the panes, not the generated file.
+//
+// Every snippet becomes the body of a lambda called once per
+// iteration, after the shared setup has run (untimed) in the same
+// function, so the setup's variables are visible to it:
+//   - a value the snippet returns goes through benchmark::DoNotOptimize,
+//     so the work that produced it cannot be removed as dead code;
+//   - benchmark::ClobberMemory() follows every call, so writes to
+//     memory the snippet makes are kept as well.
+// A snippet that returns nothing and writes nothing measures nothing;
+// QuickBench::warnings() points those out, but nothing here stops the
+// compiler from removing such work.
+//
+// Placeholders, in double braces: INCLUDES (the setup's #include
+// lines), then per snippet, between the SNIPPET section markers, NAME,
+// LABEL, SETUP and CODE.  #line keeps compiler errors on the panes'
+// own line numbers; HARNESS_LINE, alone on its line after each pane,
+// becomes the #line that puts the code below back on this file's
+// numbering, as "quick_bench.cpp".
+// ============================================================
+
+#include <benchmark/benchmark.h>
+
+#include <type_traits>
+
+{{INCLUDES}}
+
+namespace cppatlas_quick_bench {
+
+template <class F>
+inline void keep(F& snippet, std::true_type /* returns void */) {
+    snippet();
+    benchmark::ClobberMemory();
+}
+
+template <class F>
+inline void keep(F& snippet, std::false_type) {
+    auto&& result = snippet();
+    benchmark::DoNotOptimize(result);
+    benchmark::ClobberMemory();
+}
+
+template <class F>
+inline void keep(F& snippet) {
+    keep(snippet, std::is_void<decltype(snippet())>{});
+}
+
+} // namespace cppatlas_quick_bench
+
+// {{#SNIPPET}}
+static void {{NAME}}(benchmark::State& state) {
+#line 1 "setup"
+{{SETUP}}
+{{HARNESS_LINE}}
+    auto snippet = [&]() {
+#line 1 "{{LABEL}}"
+{{CODE}}
+{{HARNESS_LINE}}
+    };
+    for (auto _ : state)
+        cppatlas_quick_bench::keep(snippet);
+}
+BENCHMARK({{NAME}});
+
+// {{/SNIPPET}}
+BENCHMARK_MAIN();
@@ -1,4 +1,7 @@
 #include "compiler/ClangCompiler.h"
+#include "compiler/CompileJob.h"
+#include "compiler/DiagnosticStreamParser.h"
+#include "compiler/ToolchainDiscovery.h"
 #include <QProcess>
 #include <QFileInfo>
 #include <QRegularExpression>
@@ -30,18 +33,13 @@ QString ClangCompiler::defaultStandard() const {
 }
 
 bool ClangCompiler::isAvailable() const {
-    QProcess process;
-    process.start(m_execPath, QStringList() << "--version");
-    process.waitForFinished(3000);
-    return process.exitCode() == 0;
+    // Probed once per binary (and persisted); later calls are a cache lookup
+    return ToolchainDiscovery::instance().probe(m_execPath).available;
 }
 
 QString ClangCompiler::version() const {
     if (!m_versionQueried) {
-        QProcess process;
-        process.start(m_execPath, QStringList() << "--version");
-        process.waitForFinished(3000);
-        QString output = process.readAllStandardOutput();
+        const QString output = ToolchainDiscovery::instance().probe(m_execPath).output;
         
         // Parse version from first line: clang version 17.0.0
         QRegularExpression versionRe(R"(version\s+(\d+\.\d+\.\d+))");
@@ -73,20 +71,9 @@ CompileResult ClangCompiler::compile(const CompileRequest& request) {
     QElapsedTimer timer;
     timer.start();
     
-    QStringList args;
-    args << request.sourceFile;
-    args << "-o" << request.outputFile;
-    args << "-std=" + request.standard;
-    
-    if (request.optimizationEnabled) {
-        args << optimizationFlag(request.optLevel);
-    }
-    
-    args << request.additionalFlags;
-    
     QProcess process;
-    process.start(m_execPath, args);
-    process.waitForFinished(60000);  // 60 second timeout
+    process.start(m_execPath, buildArguments(request));
+    process.waitForFinished(request.timeoutMs);
     
     result.compilationTimeMs = timer.elapsed();
     result.exitCode = process.exitCode();
@@ -101,34 +88,46 @@ CompileResult ClangCompiler::compile(const CompileRequest& request) {
     return result;
 }
 
-QList<DiagnosticMessage> ClangCompiler::parseDiagnostics(const QString& output) {
-    QList<DiagnosticMessage> diagnostics;
-    
-    // Clang format: file:line:col: severity: message
-    QRegularExpression re(R"(([^:]+):(\d+):(\d+):\s+(error|warning|note):\s+(.+))");
-    QRegularExpressionMatchIterator it = re.globalMatch(output);
+QStringList ClangCompiler::buildArguments(const CompileRequest& request) const {
+    QStringList args;
+    if (!request.sourceFile.isEmpty()) {
+        args << request.sourceFile;
+    }
+    args << request.inputFiles;
+    args << "-o" << request.outputFile;
+    args << "-std=" + request.standard;
     
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        DiagnosticMessage diag;
-        diag.file = match.captured(1);
-        diag.line = match.captured(2).toInt();
-        diag.column = match.captured(3).toInt();
-        
-        QString severity = match.captured(4);
-        if (severity == "error") {
-            diag.severity = DiagnosticMessage::Error;
-        } else if (severity == "warning") {
-            diag.severity = DiagnosticMessage::Warning;
-        } else {
-            diag.severity = DiagnosticMessage::Note;
-        }
-        
-        diag.message = match.captured(5);
-        diagnostics.append(diag);
+    if (request.optimizationEnabled) {
+        args << optimizationFlag(request.optLevel);
     }
     
-    return diagnostics;
+    args << request.additionalFlags;
+    return args;
+}
+
+CompileJob* ClangCompiler::compileAsync(const CompileRequest& request, QObject* parent) {
+    // Prefer Clang's SARIF log (Clang 16+) over scraping the text output
+    QStringList args = buildArguments(request);
+    DiagnosticStreamParser::Format format = DiagnosticStreamParser::Format::Text;
+    if (version().section('.', 0, 0).toInt() >= 16) {
+        args << "-fdiagnostics-format=sarif" << "-Wno-sarif-format-unstable";
+        format = DiagnosticStreamParser::Format::Sarif;
+    }
+
+    CompileJob* job = new CompileJob(m_execPath, args, request, format, parent);
+    if (request.useCache) {
+        job->setCacheIdentity(m_id, version());
+    }
+    return job;
+}
+
+QList<DiagnosticMessage> ClangCompiler::parseDiagnosticOutput(const QString& output) const {
+    return parseDiagnostics(output);
+}
+
+QList<DiagnosticMessage> ClangCompiler::parseDiagnostics(const QString& output) {
+    // file:line:col: severity: message, with notes grouped under their error
+    return DiagnosticStreamParser::parseText(output);
 }
 
 QProcess* ClangCompiler::runExecutable(const QString& exePath, const QStringList& args) {
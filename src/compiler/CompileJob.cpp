@@ -0,0 +1,274 @@
+#include "compiler/CompileJob.h"
+#include "compiler/CompileJobQueue.h"
+#include "core/ArtifactCache.h"
+#include "core/GroupedProcess.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTimer>
+
+CompileJob::CompileJob(const QString& program,
+                       const QStringList& arguments,
+                       const CompileRequest& request,
+                       DiagnosticStreamParser::Format diagnosticFormat,
+                       QObject* parent)
+    : QObject(parent)
+    , m_program(program)
+    , m_arguments(arguments)
+    , m_request(request)
+    , m_diagnosticParser(diagnosticFormat)
+{
+}
+
+CompileJob::~CompileJob() {
+    // A job holds a queue slot while queued or while its process exists
+    // (a cancelled job keeps its slot until the killed process is reaped).
+    const bool holdsSlot = (m_state == State::Queued || m_process != nullptr);
+    if (m_process) {
+        // Never wait here: the process reaps itself through finished() and
+        // keeps the slot until then, so the concurrency bound still holds.
+        GroupedProcess* process = m_process;
+        m_process = nullptr;
+        process->killAndRelease();
+        CompileJobQueue::instance().holdSlotUntilDestroyed(process);
+    }
+    if (holdsSlot) {
+        CompileJobQueue::instance().remove(this);
+    }
+}
+
+bool CompileJob::isActive() const {
+    return m_state == State::Queued || m_state == State::Running;
+}
+
+QString CompileJob::displayFile() const {
+    // Link jobs have no single source file; name them after their output
+    return m_request.sourceFile.isEmpty() ? m_request.outputFile : m_request.sourceFile;
+}
+
+void CompileJob::setCacheIdentity(const QString& toolId, const QString& toolVersion) {
+    m_cacheToolId = toolId;
+    m_cacheToolVersion = toolVersion;
+}
+
+void CompileJob::start() {
+    if (m_state != State::Created) {
+        return;
+    }
+    if (m_request.useCache && startFromCache()) {
+        return;
+    }
+    m_state = State::Queued;
+    emit progressMessage(QString("Queued %1").arg(QFileInfo(displayFile()).fileName()));
+    CompileJobQueue::instance().enqueue(this);
+}
+
+void CompileJob::cancel() {
+    if (m_state == State::Queued) {
+        CompileJobQueue::instance().remove(this);
+        complete(State::Cancelled);
+    } else if (m_state == State::Running && m_process) {
+        // onProcessFinished() reports the cancellation once the process is gone
+        m_state = State::Cancelled;
+        m_process->killGroup();
+    } else if (m_state == State::Running) {
+        complete(State::Cancelled);  // Cache hit still waiting to be reported
+    }
+}
+
+void CompileJob::whenSucceeded(QObject* context, std::function<void()> next) {
+    connect(this, &CompileJob::finished, context, [next](const CompileResult& result) {
+        if (result.success && !result.cancelled) next();
+    });
+}
+
+bool CompileJob::startFromCache() {
+    if (m_cacheToolId.isEmpty() || m_request.sourceFile.isEmpty()) {
+        return false;
+    }
+
+    // The output path changes between runs; everything else determines the artifact
+    QStringList flags = m_arguments;
+    flags.removeAll(m_request.outputFile);
+    const ArtifactCache::Kind kind = flags.contains("-c") ? ArtifactCache::Kind::Object
+                                                          : ArtifactCache::Kind::Executable;
+    m_cacheKey = ArtifactCache::keyForSource(kind, m_request.sourceFile,
+                                             m_cacheToolId, m_cacheToolVersion, flags);
+
+    QByteArray log;
+    const QString cached = ArtifactCache::instance()->lookup(m_cacheKey, &log);
+    if (cached.isEmpty()) {
+        return false;
+    }
+    QFile::remove(m_request.outputFile);
+    if (!QFile::copy(cached, m_request.outputFile)) {
+        return false;
+    }
+
+    m_state = State::Running;
+    m_elapsed.start();
+    m_result.success = true;
+    m_result.fromCache = true;
+    // The cached log holds the rendered text, whatever format produced it
+    m_diagnosticParser = DiagnosticStreamParser(DiagnosticStreamParser::Format::Text);
+    emit progressMessage(QString("Using cached build of %1").arg(QFileInfo(m_request.sourceFile).fileName()));
+
+    // Report asynchronously so callers can connect after start() as usual
+    QTimer::singleShot(0, this, [this, log]() {
+        if (m_state != State::Running || m_process) return;
+        if (!log.isEmpty()) {
+            publishDiagnostics(m_diagnosticParser.feed(log), QString::fromLocal8Bit(log));
+        }
+        complete(State::Finished);
+    });
+    return true;
+}
+
+void CompileJob::launch() {
+    if (m_state != State::Queued) {
+        return;
+    }
+    m_state = State::Running;
+    m_elapsed.start();
+
+    m_process = new GroupedProcess(this);
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+
+    connect(m_process, &QProcess::readyReadStandardOutput,
+            this, &CompileJob::onReadyReadStandardOutput);
+    connect(m_process, &QProcess::readyReadStandardError,
+            this, &CompileJob::onReadyReadStandardError);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &CompileJob::onProcessFinished);
+    connect(m_process, &QProcess::errorOccurred,
+            this, &CompileJob::onProcessError);
+
+    if (m_request.timeoutMs > 0) {
+        m_timeoutTimer = new QTimer(this);
+        m_timeoutTimer->setSingleShot(true);
+        connect(m_timeoutTimer, &QTimer::timeout, this, &CompileJob::onTimeout);
+        m_timeoutTimer->start(m_request.timeoutMs);
+    }
+
+    emit progressMessage(m_request.sourceFile.isEmpty()
+                         ? QString("Linking %1...").arg(QFileInfo(m_request.outputFile).fileName())
+                         : QString("Compiling %1...").arg(QFileInfo(m_request.sourceFile).fileName()));
+    emit started();
+    m_process->start(m_program, m_arguments);
+}
+
+void CompileJob::onReadyReadStandardOutput() {
+    if (!m_process) return;
+    const QString text = QString::fromLocal8Bit(m_process->readAllStandardOutput());
+    if (text.isEmpty()) return;
+    m_stdout += text;
+    emit outputReceived(text, false);
+}
+
+void CompileJob::onReadyReadStandardError() {
+    if (!m_process) return;
+    const QByteArray chunk = m_process->readAllStandardError();
+    if (chunk.isEmpty()) return;
+    publishDiagnostics(m_diagnosticParser.feed(chunk), QString::fromLocal8Bit(chunk));
+}
+
+void CompileJob::publishDiagnostics(const QList<DiagnosticMessage>& diagnostics,
+                                    const QString& rawText) {
+    QString text;
+    if (m_diagnosticParser.format() == DiagnosticStreamParser::Format::Text) {
+        text = rawText;
+    } else {
+        text = m_diagnosticParser.takePassthroughText();
+        for (const DiagnosticMessage& diag : diagnostics) {
+            text += DiagnosticStreamParser::formatDiagnostic(diag);
+        }
+    }
+    if (!text.isEmpty()) {
+        m_stderr += text;
+        emit outputReceived(text, true);
+    }
+    if (!diagnostics.isEmpty()) {
+        m_result.diagnostics += diagnostics;
+        emit diagnosticsReceived(diagnostics);
+    }
+}
+
+void CompileJob::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
+    // Drain anything still buffered before the process object goes away
+    onReadyReadStandardOutput();
+    onReadyReadStandardError();
+
+    m_result.exitCode = exitCode;
+    if (m_state == State::Cancelled) {
+        complete(State::Cancelled);
+        return;
+    }
+
+    m_result.success = (status == QProcess::NormalExit && exitCode == 0 && !m_timedOut);
+    if (m_timedOut) {
+        const QString message = QString("\nCompilation timed out after %1 s.\n")
+                                    .arg(m_request.timeoutMs / 1000);
+        m_stderr += message;
+        emit outputReceived(message, true);
+    }
+    complete(State::Finished);
+}
+
+void CompileJob::onProcessError(QProcess::ProcessError error) {
+    // Crashes and kills are reported through finished(); only a failed
+    // start never reaches onProcessFinished().
+    if (error != QProcess::FailedToStart || !m_process) {
+        return;
+    }
+    const QString message = QString("Failed to start compiler '%1' — check path/permissions.\n")
+                                .arg(m_program);
+    m_stderr += message;
+    emit outputReceived(message, true);
+    m_result.exitCode = -1;
+    m_result.success = false;
+    complete(m_state == State::Cancelled ? State::Cancelled : State::Finished);
+}
+
+void CompileJob::onTimeout() {
+    if (m_state == State::Running && m_process) {
+        m_timedOut = true;
+        m_process->killGroup();
+    }
+}
+
+void CompileJob::complete(State finalState) {
+    const bool occupiedSlot = (m_process != nullptr);
+
+    if (m_timeoutTimer) {
+        m_timeoutTimer->stop();
+    }
+    if (m_process) {
+        m_process->disconnect(this);
+        m_process->deleteLater();
+        m_process = nullptr;
+    }
+
+    // Flush the last diagnostic group (and any truncated structured log)
+    publishDiagnostics(m_diagnosticParser.finish(), QString());
+
+    m_state = finalState;
+    m_result.compilationTimeMs = m_elapsed.isValid() ? m_elapsed.elapsed() : 0;
+    m_result.outputFile = m_request.outputFile;
+    m_result.rawOutput = m_stdout;
+    m_result.rawError = m_stderr;
+    m_result.cancelled = (finalState == State::Cancelled);
+    if (m_result.cancelled) {
+        m_result.success = false;
+    }
+    if (m_result.success && !m_result.fromCache && !m_cacheKey.isEmpty()) {
+        ArtifactCache::instance()->store(m_cacheKey, m_request.outputFile, m_stderr.toLocal8Bit());
+    }
+
+    if (occupiedSlot) {
+        CompileJobQueue::instance().jobFinished(this);
+    }
+
+    emit progressMessage(m_result.cancelled ? QString("Cancelled")
+                         : m_result.success ? QString("Finished")
+                                            : QString("Failed"));
+    emit finished(m_result);
+}
@@ -0,0 +1,81 @@
+#include "compiler/CompileJobQueue.h"
+#include "compiler/CompileJob.h"
+#include <QThread>
+
+CompileJobQueue& CompileJobQueue::instance() {
+    static CompileJobQueue instance;
+    return instance;
+}
+
+CompileJobQueue::CompileJobQueue()
+    : QObject(nullptr)
+    , m_maxConcurrentJobs(qMax(1, QThread::idealThreadCount()))
+{
+}
+
+int CompileJobQueue::maxConcurrentJobs() const {
+    return m_maxConcurrentJobs;
+}
+
+void CompileJobQueue::setMaxConcurrentJobs(int count) {
+    m_maxConcurrentJobs = qMax(1, count);
+    schedule();
+}
+
+int CompileJobQueue::runningCount() const {
+    int count = m_reaping.size();
+    for (const QPointer<CompileJob>& job : m_running) {
+        if (job) ++count;
+    }
+    return count;
+}
+
+int CompileJobQueue::pendingCount() const {
+    int count = 0;
+    for (const QPointer<CompileJob>& job : m_pending) {
+        if (job) ++count;
+    }
+    return count;
+}
+
+void CompileJobQueue::enqueue(CompileJob* job) {
+    m_pending.append(QPointer<CompileJob>(job));
+    schedule();
+}
+
+void CompileJobQueue::remove(CompileJob* job) {
+    m_pending.removeAll(QPointer<CompileJob>(job));
+    m_running.removeAll(QPointer<CompileJob>(job));
+    schedule();
+}
+
+void CompileJobQueue::jobFinished(CompileJob* job) {
+    m_running.removeAll(QPointer<CompileJob>(job));
+    schedule();
+}
+
+void CompileJobQueue::holdSlotUntilDestroyed(QObject* process) {
+    m_reaping.append(process);
+    connect(process, &QObject::destroyed, this, [this, process]() {
+        m_reaping.removeAll(process);
+        schedule();
+    });
+}
+
+void CompileJobQueue::schedule() {
+    // Drop entries whose job was destroyed without going through remove()
+    for (int i = m_running.size() - 1; i >= 0; --i) {
+        if (!m_running[i]) m_running.removeAt(i);
+    }
+
+    // launch() may complete a job synchronously (e.g. failed to start), which
+    // re-enters schedule(); the loop condition is re-evaluated every pass.
+    while (m_running.size() + m_reaping.size() < m_maxConcurrentJobs && !m_pending.isEmpty()) {
+        QPointer<CompileJob> job = m_pending.takeFirst();
+        if (!job) continue;
+        m_running.append(job);
+        job->launch();
+    }
+
+    emit activityChanged(runningCount(), pendingCount());
+}
@@ -1,13 +1,11 @@
 #include "compiler/CompilerRegistry.h"
 #include "compiler/GccCompiler.h"
 #include "compiler/ClangCompiler.h"
+#include "compiler/ToolchainDiscovery.h"
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
-#include <QProcess>
-#include <QStandardPaths>
-#include <QDir>
 
 CompilerRegistry& CompilerRegistry::instance() {
     static CompilerRegistry instance;
@@ -36,6 +34,7 @@ QList<QSharedPointer<ICompiler>> CompilerRegistry::getCompilers() const {
 }
 
 QList<QSharedPointer<ICompiler>> CompilerRegistry::getAvailableCompilers() const {
+    // isAvailable() is answered from the ToolchainDiscovery cache
     QList<QSharedPointer<ICompiler>> available;
     for (const auto& compiler : m_compilers) {
         if (compiler->isAvailable()) {
@@ -45,120 +44,59 @@ QList<QSharedPointer<ICompiler>> CompilerRegistry::getAvailableCompilers() const
     return available;
 }
 
-QString CompilerRegistry::findInPath(const QString& name) const {
-    QProcess process;
-    
-#ifdef Q_OS_WIN
-    process.start("where", QStringList() << name);
-#else
-    process.start("which", QStringList() << name);
-#endif
-    
-    process.waitForFinished(3000);
-    if (process.exitCode() == 0) {
-        QString output = process.readAllStandardOutput().trimmed();
-        return output.split('\n').first();  // Return first match
+void CompilerRegistry::autoScanCompilers() {
+    ToolchainDiscovery& discovery = ToolchainDiscovery::instance();
+    const QList<CompilerCandidate> candidates = discovery.findCompilerCandidates();
+
+    QStringList paths;
+    for (const CompilerCandidate& candidate : candidates) {
+        paths.append(candidate.path);
     }
-    return QString();
+    discovery.probeAll(paths);   // Concurrent; cached binaries are not respawned
+    registerCandidates(candidates);
 }
 
-void CompilerRegistry::autoScanCompilers() {
-    // Try to find GCC/G++
-    QString gccPath = findInPath("g++");
-    if (!gccPath.isEmpty()) {
-        auto gcc = QSharedPointer<GccCompiler>::create(gccPath, "gcc-system");
-        if (gcc->isAvailable()) {
-            registerCompiler(gcc);
-            if (m_defaultCompilerId.isEmpty()) {
-                m_defaultCompilerId = gcc->id();
-            }
-        }
+void CompilerRegistry::autoScanCompilersAsync(const QList<QPair<QString, QStringList>>& extraTools) {
+    ToolchainDiscovery& discovery = ToolchainDiscovery::instance();
+
+    // Binaries probed in an earlier session are available right away
+    registerCandidates(discovery.findCompilerCandidates());
+
+    if (!m_discoveryConnected) {
+        connect(&discovery, &ToolchainDiscovery::discoveryFinished, this, [this]() {
+            registerCandidates(ToolchainDiscovery::instance().discoveredCompilers());
+        });
+        m_discoveryConnected = true;
     }
-    
-    // Try to find Clang++
-    QString clangPath = findInPath("clang++");
-    if (!clangPath.isEmpty()) {
-        auto clang = QSharedPointer<ClangCompiler>::create(clangPath, "clang-system");
-        if (clang->isAvailable()) {
-            registerCompiler(clang);
-            if (m_defaultCompilerId.isEmpty()) {
-                m_defaultCompilerId = clang->id();
-            }
+    discovery.startDiscovery(extraTools);
+}
+
+void CompilerRegistry::registerCandidates(const QList<CompilerCandidate>& candidates) {
+    const ToolchainDiscovery& discovery = ToolchainDiscovery::instance();
+    bool changed = false;
+
+    for (const CompilerCandidate& candidate : candidates) {
+        if (m_compilers.contains(candidate.id)
+            || !discovery.cachedProbe(candidate.path).available) {
+            continue;
         }
-    }
-    
-    // Platform-specific paths
-#ifdef Q_OS_LINUX
-    // Check common Linux paths
-    QStringList linuxPaths = {
-        "/usr/bin/g++", "/usr/bin/clang++",
-        "/usr/local/bin/g++", "/usr/local/bin/clang++"
-    };
-    for (const QString& path : linuxPaths) {
-        if (QFile::exists(path) && !m_compilers.contains(path)) {
-            if (path.contains("g++")) {
-                auto gcc = QSharedPointer<GccCompiler>::create(path, "gcc-" + path);
-                if (gcc->isAvailable()) {
-                    registerCompiler(gcc);
-                }
-            } else if (path.contains("clang++")) {
-                auto clang = QSharedPointer<ClangCompiler>::create(path, "clang-" + path);
-                if (clang->isAvailable()) {
-                    registerCompiler(clang);
-                }
-            }
+
+        QSharedPointer<ICompiler> compiler;
+        if (candidate.family == "gcc") {
+            compiler = QSharedPointer<GccCompiler>::create(candidate.path, candidate.id);
+        } else {
+            compiler = QSharedPointer<ClangCompiler>::create(candidate.path, candidate.id);
         }
-    }
-#endif
-    
-#ifdef Q_OS_WIN
-    // Check common Windows MinGW/LLVM paths
-    QStringList winPaths = {
-        "C:/MinGW/bin/g++.exe",
-        "C:/Program Files/LLVM/bin/clang++.exe",
-        "C:/msys64/mingw64/bin/g++.exe"
-    };
-    for (const QString& path : winPaths) {
-        if (QFile::exists(path)) {
-            if (path.contains("g++")) {
-                auto gcc = QSharedPointer<GccCompiler>::create(path, "gcc-" + path);
-                if (gcc->isAvailable()) {
-                    registerCompiler(gcc);
-                }
-            } else if (path.contains("clang++")) {
-                auto clang = QSharedPointer<ClangCompiler>::create(path, "clang-" + path);
-                if (clang->isAvailable()) {
-                    registerCompiler(clang);
-                }
-            }
+        m_compilers[compiler->id()] = compiler;
+        if (m_defaultCompilerId.isEmpty()) {
+            m_defaultCompilerId = compiler->id();
         }
+        changed = true;
     }
-#endif
-    
-#ifdef Q_OS_MAC
-    // Check Xcode and Homebrew paths
-    QStringList macPaths = {
-        "/usr/bin/clang++",
-        "/usr/local/bin/g++",
-        "/opt/homebrew/bin/g++",
-        "/opt/homebrew/bin/clang++"
-    };
-    for (const QString& path : macPaths) {
-        if (QFile::exists(path) && !m_compilers.contains(path)) {
-            if (path.contains("g++")) {
-                auto gcc = QSharedPointer<GccCompiler>::create(path, "gcc-" + path);
-                if (gcc->isAvailable()) {
-                    registerCompiler(gcc);
-                }
-            } else if (path.contains("clang++")) {
-                auto clang = QSharedPointer<ClangCompiler>::create(path, "clang-" + path);
-                if (clang->isAvailable()) {
-                    registerCompiler(clang);
-                }
-            }
-        }
+
+    if (changed) {
+        emit compilersChanged();
     }
-#endif
 }
 
 bool CompilerRegistry::loadConfiguration(const QString& filePath) {
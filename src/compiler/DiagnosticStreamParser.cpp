@@ -0,0 +1,347 @@
+#include "compiler/DiagnosticStreamParser.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QUrl>
+
+DiagnosticStreamParser::DiagnosticStreamParser(Format format)
+    : m_format(format)
+{
+}
+
+// ── Streaming ────────────────────────────────────────────────────────────────
+
+QList<DiagnosticMessage> DiagnosticStreamParser::feed(const QByteArray& chunk) {
+    QList<DiagnosticMessage> out;
+    m_buffer += chunk;
+
+    while (!m_buffer.isEmpty()) {
+        if (m_state != State::Lines) {
+            consumeStructured(out);
+            continue;
+        }
+
+        // A structured document starts with '[' (GCC) or '{' (SARIF) on its own line
+        int first = 0;
+        while (first < m_buffer.size() && (m_buffer.at(first) == ' ' || m_buffer.at(first) == '\t')) {
+            ++first;
+        }
+        if (first == m_buffer.size()) {
+            break;   // Only indentation so far; wait for more
+        }
+        const char lead = m_buffer.at(first);
+        if ((m_format == Format::GccJson && lead == '[') || (m_format == Format::Sarif && lead == '{')) {
+            m_buffer.remove(0, first);
+            m_state = (lead == '[') ? State::JsonArray : State::JsonObject;
+            m_document.clear();
+            m_depth = 0;
+            m_inString = false;
+            m_escape = false;
+            continue;
+        }
+
+        const int newline = m_buffer.indexOf('\n');
+        if (newline < 0) {
+            break;   // Incomplete line
+        }
+        QByteArray line = m_buffer.left(newline);
+        m_buffer.remove(0, newline + 1);
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+        const QString text = QString::fromUtf8(line);
+        if (m_format != Format::Text) {
+            m_passthrough += text + '\n';
+        }
+        consumeLine(text, out);
+    }
+    return out;
+}
+
+QList<DiagnosticMessage> DiagnosticStreamParser::finish() {
+    QList<DiagnosticMessage> out;
+    if (m_state != State::Lines) {
+        // Truncated document: show what we have as text instead of dropping it
+        handleTextFallback(m_document + m_buffer, out);
+        m_state = State::Lines;
+    } else if (!m_buffer.isEmpty()) {
+        const QString text = QString::fromUtf8(m_buffer);
+        if (m_format != Format::Text) {
+            m_passthrough += text + '\n';
+        }
+        consumeLine(text, out);
+    }
+    m_buffer.clear();
+    m_document.clear();
+
+    flushCurrent(out);
+    m_pendingContext.clear();   // Context lines never followed by a diagnostic
+    return out;
+}
+
+QString DiagnosticStreamParser::takePassthroughText() {
+    QString text;
+    text.swap(m_passthrough);
+    return text;
+}
+
+void DiagnosticStreamParser::consumeStructured(QList<DiagnosticMessage>& out) {
+    // Depth at which a complete unit (array element / whole document) ends
+    const int base = (m_state == State::JsonArray) ? 1 : 0;
+
+    int i = 0;
+    while (i < m_buffer.size() && m_state != State::Lines) {
+        const char c = m_buffer.at(i++);
+        const int depthBefore = m_depth;
+
+        if (m_inString) {
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+            }
+        } else if (c == '"') {
+            m_inString = true;
+        } else if (c == '{' || c == '[') {
+            ++m_depth;
+        } else if (c == '}' || c == ']') {
+            --m_depth;
+        }
+
+        if (depthBefore > base || m_depth > base) {
+            m_document.append(c);
+        }
+
+        if (depthBefore > base && m_depth == base) {
+            QJsonParseError error;
+            const QJsonDocument doc = QJsonDocument::fromJson(m_document, &error);
+            if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+                handleTextFallback(m_document, out);
+            } else if (m_state == State::JsonArray) {
+                flushCurrent(out);
+                out.append(fromGccJson(doc.object()));
+            } else {
+                flushCurrent(out);
+                out += fromSarif(doc.object());
+            }
+            m_document.clear();
+        }
+
+        if (m_depth <= 0) {
+            m_depth = 0;
+            m_state = State::Lines;
+        }
+    }
+    m_buffer.remove(0, i);
+}
+
+void DiagnosticStreamParser::handleTextFallback(const QByteArray& raw, QList<DiagnosticMessage>& out) {
+    const QString text = QString::fromUtf8(raw);
+    if (text.trimmed().isEmpty()) {
+        return;
+    }
+    m_passthrough += text;
+    if (!text.endsWith('\n')) {
+        m_passthrough += '\n';
+    }
+    for (const QString& line : text.split('\n')) {
+        consumeLine(line, out);
+    }
+}
+
+// ── Text format ──────────────────────────────────────────────────────────────
+
+void DiagnosticStreamParser::consumeLine(const QString& rawLine, QList<DiagnosticMessage>& out) {
+    // Lazy file match so "C:\src\a.cpp:3:5:" keeps its drive letter
+    static const QRegularExpression diagRe(
+        R"(^(.*?):(\d+):(\d+):\s+(fatal error|error|warning|note):\s+(.*)$)");
+    static const QRegularExpression requiredRe(
+        R"(^(.*?):(\d+):(\d+):\s+((?:recursively )?required (?:from|by) .*)$)");
+    static const QRegularExpression scopeRe(
+        R"(^(.*?):\s+(In (?:instantiation of|substitution of|function|member function|)"
+        R"(static member function|constructor|destructor|copy constructor|lambda function).*)$)");
+    static const QRegularExpression includedRe(
+        R"(^(?:In file included|\s+) from (.*?):(\d+)(?::(\d+))?[:,]$)");
+
+    QString line = rawLine;
+    if (line.endsWith('\r')) {
+        line.chop(1);
+    }
+    if (line.trimmed().isEmpty()) {
+        return;
+    }
+
+    QRegularExpressionMatch match = diagRe.match(line);
+    if (match.hasMatch()) {
+        DiagnosticMessage diag;
+        diag.file = match.captured(1);
+        diag.line = match.captured(2).toInt();
+        diag.column = match.captured(3).toInt();
+        diag.severity = severityFromString(match.captured(4));
+        diag.message = match.captured(5);
+
+        if (diag.severity == DiagnosticMessage::Note) {
+            if (m_hasCurrent) {
+                m_current.children.append(diag);
+            } else {
+                out.append(diag);
+            }
+            return;
+        }
+
+        flushCurrent(out);
+        m_current = diag;
+        m_current.children = m_pendingContext;
+        m_pendingContext.clear();
+        m_hasCurrent = true;
+        return;
+    }
+
+    // Context lines precede the diagnostic they explain, so they open a new group
+    DiagnosticMessage context;
+    context.severity = DiagnosticMessage::Note;
+    if ((match = requiredRe.match(line)).hasMatch()) {
+        context.file = match.captured(1);
+        context.line = match.captured(2).toInt();
+        context.column = match.captured(3).toInt();
+        context.message = match.captured(4).trimmed();
+    } else if ((match = scopeRe.match(line)).hasMatch()) {
+        context.file = match.captured(1);
+        context.message = match.captured(2).trimmed();
+        if (context.message.endsWith(':')) {
+            context.message.chop(1);
+        }
+    } else if ((match = includedRe.match(line)).hasMatch()) {
+        context.file = match.captured(1);
+        context.line = match.captured(2).toInt();
+        context.column = match.captured(3).toInt();
+        context.message = QStringLiteral("In file included from here");
+    } else {
+        return;   // Source excerpts, carets, driver chatter
+    }
+
+    flushCurrent(out);
+    m_pendingContext.append(context);
+}
+
+void DiagnosticStreamParser::flushCurrent(QList<DiagnosticMessage>& out) {
+    if (m_hasCurrent) {
+        out.append(m_current);
+        m_current = DiagnosticMessage();
+        m_hasCurrent = false;
+    }
+}
+
+QList<DiagnosticMessage> DiagnosticStreamParser::parseText(const QString& output) {
+    DiagnosticStreamParser parser(Format::Text);
+    QList<DiagnosticMessage> diagnostics = parser.feed(output.toUtf8());
+    diagnostics += parser.finish();
+    return diagnostics;
+}
+
+QString DiagnosticStreamParser::formatDiagnostic(const DiagnosticMessage& diagnostic) {
+    auto formatOne = [](const DiagnosticMessage& d) {
+        QString severity;
+        switch (d.severity) {
+        case DiagnosticMessage::Error:   severity = QStringLiteral("error"); break;
+        case DiagnosticMessage::Warning: severity = QStringLiteral("warning"); break;
+        case DiagnosticMessage::Note:    severity = QStringLiteral("note"); break;
+        }
+        QString location = d.file;
+        if (d.line > 0) {
+            location += QString(":%1:%2").arg(d.line).arg(d.column);
+        }
+        QString text = QString("%1: %2: %3").arg(location, severity, d.message);
+        if (!d.code.isEmpty()) {
+            text += QString(" [%1]").arg(d.code);
+        }
+        return text + '\n';
+    };
+
+    QString text = formatOne(diagnostic);
+    for (const DiagnosticMessage& child : diagnostic.children) {
+        text += formatOne(child);
+    }
+    return text;
+}
+
+// ── Structured formats ───────────────────────────────────────────────────────
+
+DiagnosticMessage::Severity DiagnosticStreamParser::severityFromString(const QString& kind) {
+    if (kind == QLatin1String("error") || kind.startsWith(QLatin1String("fatal"))) {
+        return DiagnosticMessage::Error;
+    }
+    if (kind == QLatin1String("warning")) {
+        return DiagnosticMessage::Warning;
+    }
+    return DiagnosticMessage::Note;
+}
+
+DiagnosticMessage DiagnosticStreamParser::fromGccJson(const QJsonObject& obj) {
+    DiagnosticMessage diag;
+    diag.severity = severityFromString(obj["kind"].toString());
+    diag.message = obj["message"].toString();
+    diag.code = obj["option"].toString();
+
+    const QJsonArray locations = obj["locations"].toArray();
+    if (!locations.isEmpty()) {
+        const QJsonObject caret = locations.first().toObject()["caret"].toObject();
+        diag.file = caret["file"].toString();
+        diag.line = caret["line"].toInt();
+        diag.column = caret["column"].toInt();
+    }
+
+    // Nested notes are flattened into one level under the top-level error
+    for (const QJsonValue& value : obj["children"].toArray()) {
+        DiagnosticMessage child = fromGccJson(value.toObject());
+        const QList<DiagnosticMessage> grandchildren = child.children;
+        child.children.clear();
+        diag.children.append(child);
+        diag.children += grandchildren;
+    }
+    return diag;
+}
+
+QList<DiagnosticMessage> DiagnosticStreamParser::fromSarif(const QJsonObject& root) {
+    auto readLocation = [](const QJsonObject& location, DiagnosticMessage& diag) {
+        const QJsonObject physical = location["physicalLocation"].toObject();
+        const QString uri = physical["artifactLocation"].toObject()["uri"].toString();
+        diag.file = uri.startsWith(QLatin1String("file:")) ? QUrl(uri).toLocalFile() : uri;
+        const QJsonObject region = physical["region"].toObject();
+        diag.line = region["startLine"].toInt();
+        diag.column = region["startColumn"].toInt();
+    };
+
+    QList<DiagnosticMessage> diagnostics;
+    for (const QJsonValue& run : root["runs"].toArray()) {
+        for (const QJsonValue& value : run.toObject()["results"].toArray()) {
+            const QJsonObject result = value.toObject();
+            DiagnosticMessage diag;
+            diag.severity = severityFromString(result["level"].toString(QStringLiteral("warning")));
+            diag.message = result["message"].toObject()["text"].toString();
+            diag.code = result["ruleId"].toString();
+
+            const QJsonArray locations = result["locations"].toArray();
+            if (!locations.isEmpty()) {
+                readLocation(locations.first().toObject(), diag);
+            }
+            for (const QJsonValue& related : result["relatedLocations"].toArray()) {
+                DiagnosticMessage note;
+                note.severity = DiagnosticMessage::Note;
+                note.message = related.toObject()["message"].toObject()["text"].toString();
+                readLocation(related.toObject(), note);
+                diag.children.append(note);
+            }
+
+            if (diag.severity == DiagnosticMessage::Note && !diagnostics.isEmpty()) {
+                diagnostics.last().children.append(diag);
+            } else {
+                diagnostics.append(diag);
+            }
+        }
+    }
+    return diagnostics;
+}
@@ -1,4 +1,7 @@
 #include "compiler/GccCompiler.h"
+#include "compiler/CompileJob.h"
+#include "compiler/DiagnosticStreamParser.h"
+#include "compiler/ToolchainDiscovery.h"
 #include <QProcess>
 #include <QFileInfo>
 #include <QRegularExpression>
@@ -30,18 +33,13 @@ QString GccCompiler::defaultStandard() const {
 }
 
 bool GccCompiler::isAvailable() const {
-    QProcess process;
-    process.start(m_execPath, QStringList() << "--version");
-    process.waitForFinished(3000);
-    return process.exitCode() == 0;
+    // Probed once per binary (and persisted); later calls are a cache lookup
+    return ToolchainDiscovery::instance().probe(m_execPath).available;
 }
 
 QString GccCompiler::version() const {
     if (!m_versionQueried) {
-        QProcess process;
-        process.start(m_execPath, QStringList() << "--version");
-        process.waitForFinished(3000);
-        QString output = process.readAllStandardOutput();
+        const QString output = ToolchainDiscovery::instance().probe(m_execPath).output;
         
         // Parse version from first line: g++ (GCC) 13.2.0
         QRegularExpression versionRe(R"((\d+\.\d+\.\d+))");
@@ -73,20 +71,9 @@ CompileResult GccCompiler::compile(const CompileRequest& request) {
     QElapsedTimer timer;
     timer.start();
     
-    QStringList args;
-    args << request.sourceFile;
-    args << "-o" << request.outputFile;
-    args << "-std=" + request.standard;
-    
-    if (request.optimizationEnabled) {
-        args << optimizationFlag(request.optLevel);
-    }
-    
-    args << request.additionalFlags;
-    
     QProcess process;
-    process.start(m_execPath, args);
-    process.waitForFinished(60000);  // 60 second timeout
+    process.start(m_execPath, buildArguments(request));
+    process.waitForFinished(request.timeoutMs);
     
     result.compilationTimeMs = timer.elapsed();
     result.exitCode = process.exitCode();
@@ -101,34 +88,50 @@ CompileResult GccCompiler::compile(const CompileRequest& request) {
     return result;
 }
 
-QList<DiagnosticMessage> GccCompiler::parseDiagnostics(const QString& output) {
-    QList<DiagnosticMessage> diagnostics;
-    
-    // GCC format: file:line:col: severity: message
-    QRegularExpression re(R"(([^:]+):(\d+):(\d+):\s+(error|warning|note):\s+(.+))");
-    QRegularExpressionMatchIterator it = re.globalMatch(output);
+QStringList GccCompiler::buildArguments(const CompileRequest& request) const {
+    QStringList args;
+    if (!request.sourceFile.isEmpty()) {
+        args << request.sourceFile;
+    }
+    args << request.inputFiles;
+    args << "-o" << request.outputFile;
+    args << "-std=" + request.standard;
     
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        DiagnosticMessage diag;
-        diag.file = match.captured(1);
-        diag.line = match.captured(2).toInt();
-        diag.column = match.captured(3).toInt();
-        
-        QString severity = match.captured(4);
-        if (severity == "error") {
-            diag.severity = DiagnosticMessage::Error;
-        } else if (severity == "warning") {
-            diag.severity = DiagnosticMessage::Warning;
-        } else {
-            diag.severity = DiagnosticMessage::Note;
-        }
-        
-        diag.message = match.captured(5);
-        diagnostics.append(diag);
+    if (request.optimizationEnabled) {
+        args << optimizationFlag(request.optLevel);
     }
     
-    return diagnostics;
+    args << request.additionalFlags;
+    return args;
+}
+
+CompileJob* GccCompiler::compileAsync(const CompileRequest& request, QObject* parent) {
+    // Prefer GCC's machine-readable log: JSON on GCC 10-14 (dropped in 15), SARIF after
+    QStringList args = buildArguments(request);
+    DiagnosticStreamParser::Format format = DiagnosticStreamParser::Format::Text;
+    const int major = version().section('.', 0, 0).toInt();
+    if (major >= 15) {
+        args << "-fdiagnostics-format=sarif-stderr";
+        format = DiagnosticStreamParser::Format::Sarif;
+    } else if (major >= 10) {
+        args << "-fdiagnostics-format=json";
+        format = DiagnosticStreamParser::Format::GccJson;
+    }
+
+    CompileJob* job = new CompileJob(m_execPath, args, request, format, parent);
+    if (request.useCache) {
+        job->setCacheIdentity(m_id, version());
+    }
+    return job;
+}
+
+QList<DiagnosticMessage> GccCompiler::parseDiagnosticOutput(const QString& output) const {
+    return parseDiagnostics(output);
+}
+
+QList<DiagnosticMessage> GccCompiler::parseDiagnostics(const QString& output) {
+    // file:line:col: severity: message, with notes grouped under their error
+    return DiagnosticStreamParser::parseText(output);
 }
 
 QProcess* GccCompiler::runExecutable(const QString& exePath, const QStringList& args) {
@@ -0,0 +1,347 @@
+#include "compiler/ProjectBuilder.h"
+#include "compiler/ICompiler.h"
+#include "compiler/CompileJob.h"
+#include "core/Project.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+ProjectBuilder::ProjectBuilder(QObject* parent)
+    : QObject(parent)
+{
+}
+
+ProjectBuilder::~ProjectBuilder() {
+    // Jobs are children and die with us; make sure none calls back mid-destruction
+    for (const QPointer<CompileJob>& job : m_jobs) {
+        if (job) job->disconnect(this);
+    }
+}
+
+QString ProjectBuilder::executablePathFor(const Project* project) {
+    QString baseName = project->name();
+    baseName.replace(QRegularExpression(R"([^A-Za-z0-9_.-]+)"), "_");
+    if (baseName.isEmpty()) {
+        baseName = "a.out";
+    }
+    const QString outputDir = QDir(project->projectDirectory()).absoluteFilePath(project->outputDirectory());
+#ifdef Q_OS_WIN
+    return outputDir + "/" + baseName + ".exe";
+#else
+    return outputDir + "/" + baseName;
+#endif
+}
+
+QString ProjectBuilder::objectDirectoryFor(const Project* project) {
+    return QDir(project->projectDirectory()).absoluteFilePath(project->outputDirectory()) + "/obj";
+}
+
+bool ProjectBuilder::build(const Project* project, const QSharedPointer<ICompiler>& compiler,
+                           const QString& standard, const QStringList& extraFlags) {
+    if (m_running || !project || !compiler || project->sourceFiles().isEmpty()) {
+        return false;
+    }
+
+    m_compiler = compiler;
+    m_projectDirectory = project->projectDirectory();
+    m_objectDirectory = objectDirectoryFor(project);
+    m_executable = executablePathFor(project);
+    m_standard = standard;
+    m_linkFlags = extraFlags + project->compilerFlags();
+    m_units.clear();
+    m_jobs.clear();
+    m_linking = false;
+    m_failed = false;
+    m_cancelled = false;
+    m_completed = 0;
+    m_recompiled = 0;
+    m_result = CompileResult();
+
+    const QDir projectDir(m_projectDirectory);
+    QStringList compileFlags = extraFlags + project->compilerFlags();
+    for (const QString& include : project->includeDirectories()) {
+        compileFlags << "-I" + projectDir.absoluteFilePath(include);
+    }
+
+    for (const QString& source : project->sourceFiles()) {
+        Unit unit;
+        unit.sourceFile = projectDir.absoluteFilePath(source);
+        QString relative = projectDir.relativeFilePath(unit.sourceFile);
+        if (relative.startsWith("..")) {
+            relative = QFileInfo(unit.sourceFile).fileName();  // Source outside the project tree
+        }
+        unit.objectFile = m_objectDirectory + "/" + relative + ".o";
+        unit.dependencyFile = m_objectDirectory + "/" + relative + ".d";
+        QDir().mkpath(QFileInfo(unit.objectFile).absolutePath());
+        m_units.append(unit);
+    }
+    QDir().mkpath(QFileInfo(m_executable).absolutePath());
+
+    m_running = true;
+    m_elapsed.start();
+    emit progressMessage(QString("Building %1 (%2 files)...")
+                             .arg(project->name()).arg(m_units.size()));
+    reportProgress();
+
+    // Queue every out-of-date unit at once; CompileJobQueue bounds how many
+    // compilers actually run in parallel.
+    m_queueing = true;
+    for (const Unit& unit : m_units) {
+        CompileRequest request;
+        request.sourceFile = unit.sourceFile;
+        request.outputFile = unit.objectFile;
+        request.standard = m_standard;
+        request.additionalFlags = compileFlags;
+        request.additionalFlags << "-c" << "-MMD" << "-MF" << unit.dependencyFile;
+
+        CompileJob* job = m_compiler->compileAsync(request, this);
+        const QByteArray hash = commandHash(job->program(), job->arguments());
+        if (isUpToDate(unit, hash)) {
+            delete job;
+            ++m_completed;
+            continue;
+        }
+        ++m_recompiled;
+        startJob(job, unit.objectFile + ".cmd", hash);
+    }
+    m_queueing = false;
+
+    reportProgress();
+    advance();
+    return true;
+}
+
+void ProjectBuilder::cancel() {
+    if (!m_running) {
+        return;
+    }
+    m_cancelled = true;
+    const QList<QPointer<CompileJob>> jobs = m_jobs;
+    for (const QPointer<CompileJob>& job : jobs) {
+        if (job) job->cancel();
+    }
+    advance();
+}
+
+bool ProjectBuilder::isUpToDate(const Unit& unit, const QByteArray& commandHash) const {
+    const QFileInfo objectInfo(unit.objectFile);
+    if (!objectInfo.exists() || readStamp(unit.objectFile + ".cmd") != commandHash) {
+        return false;
+    }
+
+    QFile depFile(unit.dependencyFile);
+    if (!depFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+    const QStringList dependencies = parseDependencyFile(QString::fromLocal8Bit(depFile.readAll()));
+    if (dependencies.isEmpty()) {
+        return false;
+    }
+
+    const QDateTime objectTime = objectInfo.lastModified();
+    const QDir projectDir(m_projectDirectory);
+    for (const QString& dependency : dependencies) {
+        const QFileInfo depInfo(projectDir.absoluteFilePath(dependency));
+        if (!depInfo.exists() || depInfo.lastModified() > objectTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProjectBuilder::isLinkUpToDate(const QByteArray& commandHash) const {
+    const QFileInfo exeInfo(m_executable);
+    if (!exeInfo.exists() || readStamp(m_objectDirectory + "/link.cmd") != commandHash) {
+        return false;
+    }
+    const QDateTime exeTime = exeInfo.lastModified();
+    for (const Unit& unit : m_units) {
+        if (QFileInfo(unit.objectFile).lastModified() > exeTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ProjectBuilder::startJob(CompileJob* job, const QString& stampFile, const QByteArray& commandHash) {
+    connect(job, &CompileJob::outputReceived, this, &ProjectBuilder::outputReceived);
+    connect(job, &CompileJob::diagnosticsReceived, this, &ProjectBuilder::diagnosticsReceived);
+    connect(job, &CompileJob::progressMessage, this, [this](const QString& message) {
+        // Per-job "Finished"/"Failed" notes would just flicker in the status bar
+        if (message.endsWith("...")) emit progressMessage(message);
+    });
+    connect(job, &CompileJob::finished, this,
+            [this, job, stampFile, commandHash](const CompileResult& result) {
+        onJobFinished(job, stampFile, commandHash, result);
+    });
+    m_jobs.append(QPointer<CompileJob>(job));
+    job->start();
+}
+
+void ProjectBuilder::onJobFinished(CompileJob* job, const QString& stampFile,
+                                   const QByteArray& commandHash, const CompileResult& result) {
+    m_jobs.removeAll(QPointer<CompileJob>(job));
+    job->deleteLater();
+
+    m_result.rawOutput += result.rawOutput;
+    m_result.rawError += result.rawError;
+    m_result.diagnostics += result.diagnostics;
+    if (result.exitCode != 0) {
+        m_result.exitCode = result.exitCode;
+    }
+
+    if (result.success) {
+        writeStamp(stampFile, commandHash);
+    } else {
+        // A failed or interrupted compile may leave a stale object behind
+        QFile::remove(stampFile);
+        if (!result.cancelled) m_failed = true;
+    }
+
+    ++m_completed;
+    reportProgress();
+    advance();
+}
+
+void ProjectBuilder::advance() {
+    if (!m_running || m_queueing || !m_jobs.isEmpty()) {
+        return;
+    }
+    if (m_cancelled) {
+        finish(false, true);
+    } else if (m_failed) {
+        finish(false, false);
+    } else if (!m_linking) {
+        startLink();
+    } else {
+        finish(true, false);
+    }
+}
+
+void ProjectBuilder::startLink() {
+    m_linking = true;
+
+    CompileRequest request;
+    for (const Unit& unit : m_units) {
+        request.inputFiles << unit.objectFile;
+    }
+    request.outputFile = m_executable;
+    request.standard = m_standard;
+    request.additionalFlags = m_linkFlags;
+
+    CompileJob* job = m_compiler->compileAsync(request, this);
+    const QByteArray hash = commandHash(job->program(), job->arguments());
+    if (m_recompiled == 0 && isLinkUpToDate(hash)) {
+        delete job;
+        ++m_completed;
+        reportProgress();
+        emit outputReceived(QString("%1 is up to date.\n").arg(QFileInfo(m_executable).fileName()), false);
+        finish(true, false);
+        return;
+    }
+
+    m_queueing = true;
+    startJob(job, m_objectDirectory + "/link.cmd", hash);
+    m_queueing = false;
+    advance();
+}
+
+void ProjectBuilder::finish(bool success, bool cancelled) {
+    m_running = false;
+    m_result.success = success;
+    m_result.cancelled = cancelled;
+    m_result.outputFile = m_executable;
+    m_result.compilationTimeMs = m_elapsed.elapsed();
+
+    if (success) {
+        emit progressMessage(QString("Build finished: %1 of %2 files recompiled")
+                                 .arg(m_recompiled).arg(m_units.size()));
+    }
+    emit finished(m_result);
+}
+
+void ProjectBuilder::reportProgress() {
+    emit progressChanged(m_completed, m_units.size() + 1);
+}
+
+QStringList ProjectBuilder::parseDependencyFile(const QString& contents) {
+    QStringList dependencies;
+    QString token;
+    bool inPrerequisites = false;
+
+    auto flush = [&]() {
+        if (token.isEmpty()) return;
+        if (!inPrerequisites) {
+            // Targets end at the first token carrying the rule's colon
+            if (token.endsWith(':')) inPrerequisites = true;
+        } else {
+            dependencies.append(token);
+        }
+        token.clear();
+    };
+
+    const int length = contents.size();
+    for (int i = 0; i < length; ++i) {
+        const QChar c = contents.at(i);
+        if (c == '\\' && i + 1 < length) {
+            const QChar next = contents.at(i + 1);
+            if (next == '\n') {                          // Line continuation
+                flush();
+                ++i;
+                continue;
+            }
+            if (next == '\r' && i + 2 < length && contents.at(i + 2) == '\n') {
+                flush();
+                i += 2;
+                continue;
+            }
+            if (next == ' ' || next == '#') {            // Escaped character in a path
+                token += next;
+                ++i;
+                continue;
+            }
+            token += c;                                  // Windows path separator
+        } else if (c == '$' && i + 1 < length && contents.at(i + 1) == '$') {
+            token += '$';
+            ++i;
+        } else if (c == '\n') {
+            flush();
+            inPrerequisites = false;                     // Next line starts a new rule
+        } else if (c.isSpace()) {
+            flush();
+        } else {
+            token += c;
+        }
+    }
+    flush();
+    return dependencies;
+}
+
+QByteArray ProjectBuilder::commandHash(const QString& program, const QStringList& arguments) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(program.toUtf8());
+    for (const QString& argument : arguments) {
+        hash.addData(QByteArray(1, '\0'));
+        hash.addData(argument.toUtf8());
+    }
+    return hash.result().toHex();
+}
+
+QByteArray ProjectBuilder::readStamp(const QString& stampFile) {
+    QFile file(stampFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll().trimmed();
+}
+
+void ProjectBuilder::writeStamp(const QString& stampFile, const QByteArray& hash) {
+    QFile file(stampFile);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        file.write(hash);
+        file.write("\n");
+    }
+}
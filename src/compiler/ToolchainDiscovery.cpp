@@ -0,0 +1,350 @@
+#include "compiler/ToolchainDiscovery.h"
+#include "core/ThreadPoolTask.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSet>
+#include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+
+namespace {
+
+constexpr int PROBE_TIMEOUT_MS = 3000;
+
+qint64 fileMtime(const QString& path) {
+    const QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+} // namespace
+
+ToolchainDiscovery& ToolchainDiscovery::instance() {
+    static ToolchainDiscovery instance;
+    return instance;
+}
+
+ToolchainDiscovery::ToolchainDiscovery() {
+    loadCache();
+}
+
+// ── Probing ──────────────────────────────────────────────────────────────────
+
+ToolProbe ToolchainDiscovery::probe(const QString& program, const QStringList& args) {
+    const QString path = resolveExecutable(program);
+    const QString key = probeKey(path, args);
+    {
+        QMutexLocker locker(&m_mutex);
+        auto it = m_probes.constFind(key);
+        if (it != m_probes.constEnd()) {
+            return it.value();
+        }
+    }
+
+    const ToolProbe result = runProbe(path, args);
+    insertProbe(key, result);
+    saveCache();
+    return result;
+}
+
+ToolProbe ToolchainDiscovery::cachedProbe(const QString& program, const QStringList& args) const {
+    const QString key = probeKey(resolveExecutable(program), args);
+    QMutexLocker locker(&m_mutex);
+    return m_probes.value(key);
+}
+
+bool ToolchainDiscovery::isCached(const QString& program, const QStringList& args) const {
+    const QString key = probeKey(resolveExecutable(program), args);
+    QMutexLocker locker(&m_mutex);
+    return m_probes.contains(key);
+}
+
+void ToolchainDiscovery::probeAll(const QStringList& programs, const QStringList& args) {
+    QStringList pending;
+    for (const QString& program : programs) {
+        const QString path = resolveExecutable(program);
+        if (path.isEmpty()) {
+            continue;
+        }
+        if (!pending.contains(path) && !isCached(path, args)) {
+            pending.append(path);
+        }
+    }
+    if (pending.isEmpty()) {
+        return;
+    }
+
+    // A private pool so a blocking probe never starves the global one
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, qMin(pending.size(), QThread::idealThreadCount())));
+    for (const QString& path : pending) {
+        ThreadPoolTask::start(&pool, [this, path, args]() {
+            insertProbe(probeKey(path, args), runProbe(path, args));
+        });
+    }
+    pool.waitForDone();
+    saveCache();
+}
+
+ToolProbe ToolchainDiscovery::runProbe(const QString& path, const QStringList& args) {
+    ToolProbe result;
+    result.path = path;
+    result.mtime = fileMtime(path);
+    if (path.isEmpty()) {
+        return result;
+    }
+
+    QProcess process;
+    process.start(path, args);
+    if (!process.waitForStarted(PROBE_TIMEOUT_MS)) {
+        return result;
+    }
+    if (!process.waitForFinished(PROBE_TIMEOUT_MS)) {
+        process.kill();
+        process.waitForFinished(1000);
+        return result;
+    }
+    result.available = process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0;
+    result.output = QString::fromLocal8Bit(process.readAllStandardOutput());
+    return result;
+}
+
+void ToolchainDiscovery::insertProbe(const QString& key, const ToolProbe& result) {
+    QMutexLocker locker(&m_mutex);
+    m_probes.insert(key, result);
+    m_dirty = true;
+}
+
+// ── Candidates ───────────────────────────────────────────────────────────────
+
+bool ToolchainDiscovery::parseCompilerFileName(const QString& fileName, QString* family,
+                                               QString* suffix) {
+    static const QRegularExpression re(
+        QStringLiteral(R"(^(g\+\+|clang\+\+)(?:-(\d+(?:\.\d+)*))?(?:\.exe)?$)"));
+    const QRegularExpressionMatch match = re.match(fileName);
+    if (!match.hasMatch()) {
+        return false;
+    }
+    if (family) {
+        *family = match.captured(1) == QLatin1String("g++") ? QStringLiteral("gcc")
+                                                            : QStringLiteral("clang");
+    }
+    if (suffix) {
+        *suffix = match.captured(2);
+    }
+    return true;
+}
+
+QList<CompilerCandidate> ToolchainDiscovery::findCompilerCandidates() const {
+    QList<CompilerCandidate> candidates;
+    QSet<QString> seen;   // canonical paths
+
+    auto addCandidate = [&](const QString& path, const QString& family, const QString& id) {
+        const QFileInfo info(path);
+        if (!info.exists() || !info.isExecutable()) {
+            return;
+        }
+        const QString canonical = info.canonicalFilePath();
+        if (seen.contains(canonical)) {
+            return;
+        }
+        seen.insert(canonical);
+        candidates.append({id, family, info.absoluteFilePath()});
+    };
+
+    // Default drivers first, so they keep their well-known ids
+    addCandidate(resolveExecutable(QStringLiteral("g++")), QStringLiteral("gcc"),
+                 QStringLiteral("gcc-system"));
+    addCandidate(resolveExecutable(QStringLiteral("clang++")), QStringLiteral("clang"),
+                 QStringLiteral("clang-system"));
+
+    // Versioned drivers on PATH (g++-13, clang++-18, ...)
+    const QStringList pathDirs = qEnvironmentVariable("PATH").split(QDir::listSeparator(),
+                                                                    Qt::SkipEmptyParts);
+    for (const QString& dirPath : pathDirs) {
+        const QDir dir(dirPath);
+        const QStringList entries = dir.entryList(
+            {QStringLiteral("g++-*"), QStringLiteral("clang++-*")}, QDir::Files, QDir::Name);
+        for (const QString& entry : entries) {
+            QString family;
+            QString suffix;
+            if (parseCompilerFileName(entry, &family, &suffix) && !suffix.isEmpty()) {
+                addCandidate(dir.absoluteFilePath(entry), family, family + "-" + suffix);
+            }
+        }
+    }
+
+    // Platform-specific paths
+#ifdef Q_OS_LINUX
+    const QStringList platformPaths = {
+        "/usr/bin/g++", "/usr/bin/clang++",
+        "/usr/local/bin/g++", "/usr/local/bin/clang++"
+    };
+#elif defined(Q_OS_WIN)
+    const QStringList platformPaths = {
+        "C:/MinGW/bin/g++.exe",
+        "C:/Program Files/LLVM/bin/clang++.exe",
+        "C:/msys64/mingw64/bin/g++.exe"
+    };
+#elif defined(Q_OS_MAC)
+    const QStringList platformPaths = {
+        "/usr/bin/clang++",
+        "/usr/local/bin/g++",
+        "/opt/homebrew/bin/g++",
+        "/opt/homebrew/bin/clang++"
+    };
+#else
+    const QStringList platformPaths;
+#endif
+    for (const QString& path : platformPaths) {
+        QString family;
+        if (parseCompilerFileName(QFileInfo(path).fileName(), &family, nullptr)) {
+            addCandidate(path, family, family + "-" + path);
+        }
+    }
+
+    return candidates;
+}
+
+// ── Background discovery ─────────────────────────────────────────────────────
+
+void ToolchainDiscovery::startDiscovery(const QList<QPair<QString, QStringList>>& extraTools) {
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_discovering) {
+            return;
+        }
+        m_discovering = true;
+    }
+
+    ThreadPoolTask::start(QThreadPool::globalInstance(), [this, extraTools]() {
+        const QList<CompilerCandidate> candidates = findCompilerCandidates();
+        QStringList paths;
+        for (const CompilerCandidate& candidate : candidates) {
+            paths.append(candidate.path);
+        }
+        probeAll(paths);
+        for (const auto& tool : extraTools) {
+            probeAll({tool.first}, tool.second);
+        }
+
+        {
+            QMutexLocker locker(&m_mutex);
+            m_discovered = candidates;
+            m_discovering = false;
+        }
+        // Receivers live on the GUI thread, so this is delivered queued
+        emit discoveryFinished();
+    });
+}
+
+bool ToolchainDiscovery::isDiscovering() const {
+    QMutexLocker locker(&m_mutex);
+    return m_discovering;
+}
+
+QList<CompilerCandidate> ToolchainDiscovery::discoveredCompilers() const {
+    QMutexLocker locker(&m_mutex);
+    return m_discovered;
+}
+
+void ToolchainDiscovery::clear() {
+    QMutexLocker locker(&m_mutex);
+    m_probes.clear();
+    m_dirty = false;
+    QFile::remove(cacheFilePath());
+}
+
+// ── Helpers ──────────────────────────────────────────────────────────────────
+
+QString ToolchainDiscovery::resolveExecutable(const QString& program) {
+    if (program.isEmpty() || program.contains('/') || program.contains('\\')) {
+        return program;
+    }
+    return QStandardPaths::findExecutable(program);
+}
+
+QString ToolchainDiscovery::probeKey(const QString& path, const QStringList& args) {
+    return path + QChar('\n') + args.join(QChar(' '));
+}
+
+// ── Persistence ──────────────────────────────────────────────────────────────
+
+QString ToolchainDiscovery::cacheFilePath() const {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+           + QStringLiteral("/toolchains.json");
+}
+
+void ToolchainDiscovery::loadCache() {
+    QFile file(cacheFilePath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonArray entries = QJsonDocument::fromJson(file.readAll()).object()["probes"].toArray();
+    for (const QJsonValue& value : entries) {
+        const QJsonObject obj = value.toObject();
+        ToolProbe result;
+        result.path = obj["path"].toString();
+        result.mtime = static_cast<qint64>(obj["mtime"].toDouble());
+        // A rebuilt or upgraded binary invalidates its entry
+        if (result.path.isEmpty() || fileMtime(result.path) != result.mtime) {
+            m_dirty = true;
+            continue;
+        }
+        result.available = obj["available"].toBool();
+        result.output = obj["output"].toString();
+
+        QStringList args;
+        for (const QJsonValue& arg : obj["args"].toArray()) {
+            args.append(arg.toString());
+        }
+        m_probes.insert(probeKey(result.path, args), result);
+    }
+}
+
+void ToolchainDiscovery::saveCache() {
+    // Serialises writers (GUI-thread probes vs. background discovery)
+    QMutexLocker saveLocker(&m_saveMutex);
+    QJsonArray entries;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_dirty) {
+            return;
+        }
+        for (auto it = m_probes.constBegin(); it != m_probes.constEnd(); ++it) {
+            const ToolProbe& result = it.value();
+            if (result.path.isEmpty()) {
+                continue;
+            }
+            QJsonObject obj;
+            obj["path"] = result.path;
+            obj["args"] = QJsonArray::fromStringList(
+                it.key().section(QChar('\n'), 1).split(QChar(' '), Qt::SkipEmptyParts));
+            obj["mtime"] = static_cast<double>(result.mtime);
+            obj["available"] = result.available;
+            obj["output"] = result.output;
+            entries.append(obj);
+        }
+        m_dirty = false;
+    }
+
+    const QString path = cacheFilePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QJsonObject root;
+    root["probes"] = entries;
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.commit();
+}
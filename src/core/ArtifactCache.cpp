@@ -0,0 +1,405 @@
+#include "core/ArtifactCache.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <algorithm>
+
+ArtifactCache* ArtifactCache::s_instance = nullptr;
+
+namespace {
+constexpr int MAX_INCLUDE_DEPTH = 16;
+constexpr qint64 COPY_CHUNK_BYTES = 1 << 16;
+
+QString kindName(ArtifactCache::Kind kind) {
+    switch (kind) {
+        case ArtifactCache::Kind::Executable: return "exe";
+        case ArtifactCache::Kind::Object:     return "obj";
+        case ArtifactCache::Kind::Assembly:   return "asm";
+        case ArtifactCache::Kind::Insights:   return "insights";
+    }
+    return "unknown";
+}
+}
+
+ArtifactCache::ArtifactCache(QObject* parent)
+    : QObject(parent)
+{
+    m_directory = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                  + "/artifacts";
+    QDir().mkpath(m_directory);
+
+    QSettings settings("CppAtlas", "CppAtlas");
+    m_maxSizeBytes = settings.value("artifactCache/maxSizeBytes", DEFAULT_MAX_SIZE_BYTES).toLongLong();
+
+    loadIndex();
+    m_sinceIndexSave.start();
+
+    // The instance is never deleted; write pending LRU updates on the way out
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, this, &ArtifactCache::saveIndexIfDirty);
+    }
+}
+
+ArtifactCache::~ArtifactCache() {
+    saveIndexIfDirty();
+}
+
+ArtifactCache* ArtifactCache::instance() {
+    if (!s_instance) {
+        s_instance = new ArtifactCache();
+    }
+    return s_instance;
+}
+
+// ── Keys ─────────────────────────────────────────────────────────────────────
+
+QString ArtifactCache::computeKey(Kind kind, const QByteArray& sourceDigest,
+                                  const QString& toolId, const QString& toolVersion,
+                                  const QStringList& flags) {
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(kindName(kind).toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(sourceDigest);
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(toolId.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(toolVersion.toUtf8());
+    for (const QString& flag : flags) {
+        hash.addData(QByteArray(1, '\0'));
+        hash.addData(flag.toUtf8());
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString ArtifactCache::keyForSource(Kind kind, const QString& sourceFile,
+                                    const QString& toolId, const QString& toolVersion,
+                                    const QStringList& flags) {
+    QStringList includeDirs;
+    for (int i = 0; i < flags.size(); ++i) {
+        if (flags[i] == "-I" && i + 1 < flags.size()) {
+            includeDirs << flags[i + 1];
+        } else if (flags[i].startsWith("-I")) {
+            includeDirs << flags[i].mid(2);
+        }
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QStringList visited;
+    if (!hashSourceRecursive(sourceFile, includeDirs, hash, visited, 0)) {
+        return QString();
+    }
+    return computeKey(kind, hash.result(), toolId, toolVersion, flags);
+}
+
+bool ArtifactCache::hashSourceRecursive(const QString& filePath, const QStringList& includeDirs,
+                                        QCryptographicHash& hash, QStringList& visited, int depth) {
+    const QString canonical = QFileInfo(filePath).canonicalFilePath();
+    if (canonical.isEmpty() || visited.contains(canonical)) {
+        return !canonical.isEmpty();
+    }
+    visited << canonical;
+
+    QFile file(canonical);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray contents = file.readAll();
+    hash.addData(contents);
+    hash.addData(QByteArray(1, '\0'));
+
+    if (depth >= MAX_INCLUDE_DEPTH) {
+        return true;
+    }
+
+    // Quoted includes may be edited alongside the source; system headers are
+    // covered by the compiler version.
+    static const QRegularExpression includeRe(R"(^\s*#\s*include\s*"([^"]+)")",
+                                              QRegularExpression::MultilineOption);
+    const QString dir = QFileInfo(canonical).absolutePath();
+    QRegularExpressionMatchIterator it = includeRe.globalMatch(QString::fromUtf8(contents));
+    while (it.hasNext()) {
+        const QString name = it.next().captured(1);
+        QString resolved = QDir(dir).absoluteFilePath(name);
+        if (!QFileInfo::exists(resolved)) {
+            resolved.clear();
+            for (const QString& includeDir : includeDirs) {
+                const QString candidate = QDir(includeDir).absoluteFilePath(name);
+                if (QFileInfo::exists(candidate)) {
+                    resolved = candidate;
+                    break;
+                }
+            }
+        }
+        if (resolved.isEmpty()) {
+            // Mark the unresolved name so creating the header later changes the key
+            hash.addData(name.toUtf8());
+            continue;
+        }
+        hashSourceRecursive(resolved, includeDirs, hash, visited, depth + 1);
+    }
+    return true;
+}
+
+// ── Lookup / store ───────────────────────────────────────────────────────────
+
+QString ArtifactCache::artifactPath(const QString& key) const {
+    return m_directory + "/" + key.left(2) + "/" + key;
+}
+
+QString ArtifactCache::logPath(const QString& key) const {
+    return artifactPath(key) + ".log";
+}
+
+bool ArtifactCache::findEntry(const QString& key, QByteArray* log) {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || !QFileInfo::exists(artifactPath(key))) {
+        if (it != m_entries.end()) {
+            // Files removed behind our back
+            m_totalBytes -= it->size;
+            m_entries.erase(it);
+            m_indexDirty = true;
+        }
+        ++m_stats.misses;
+        return false;
+    }
+
+    it->lastUsed = QDateTime::currentMSecsSinceEpoch();
+    ++m_stats.hits;
+    // Keep the LRU order across sessions without rewriting the index per hit
+    m_indexDirty = true;
+    if (m_sinceIndexSave.hasExpired(INDEX_SAVE_INTERVAL_MS)) {
+        saveIndex();
+    }
+
+    if (log) {
+        QFile logFile(logPath(key));
+        *log = logFile.open(QIODevice::ReadOnly) ? logFile.readAll() : QByteArray();
+    }
+    return true;
+}
+
+QString ArtifactCache::lookup(const QString& key, QByteArray* log) {
+    if (key.isEmpty()) return QString();
+    bool found;
+    {
+        QMutexLocker locker(&m_mutex);
+        found = findEntry(key, log);
+    }
+    emit statsChanged();
+    return found ? artifactPath(key) : QString();
+}
+
+bool ArtifactCache::lookupData(const QString& key, QByteArray* data, QByteArray* log) {
+    if (key.isEmpty()) return false;
+    bool found;
+    {
+        QMutexLocker locker(&m_mutex);
+        found = findEntry(key, log);
+        if (found && data) {
+            QFile file(artifactPath(key));
+            found = file.open(QIODevice::ReadOnly);
+            if (found) *data = file.readAll();
+        }
+    }
+    emit statsChanged();
+    return found;
+}
+
+bool ArtifactCache::store(const QString& key, const QString& sourcePath, const QByteArray& log) {
+    if (key.isEmpty() || !QFileInfo::exists(sourcePath)) return false;
+    bool stored;
+    {
+        QMutexLocker locker(&m_mutex);
+        const QString target = artifactPath(key);
+        QDir().mkpath(QFileInfo(target).absolutePath());
+        // Copied to a temporary file beside the target and renamed over it by
+        // commit(), so a concurrent lookup never sees a missing or partial artifact
+        QFile source(sourcePath);
+        QSaveFile file(target);
+        if (source.open(QIODevice::ReadOnly) && file.open(QIODevice::WriteOnly)) {
+            // Keep the source's permissions, so cached executables stay runnable
+            file.setPermissions(source.permissions());
+            while (!source.atEnd()) {
+                const QByteArray chunk = source.read(COPY_CHUNK_BYTES);
+                if (chunk.isEmpty() || file.write(chunk) != chunk.size()) {
+                    file.cancelWriting();
+                    break;
+                }
+            }
+            stored = file.commit() && commitEntry(key, log);
+        }
+    }
+    emit statsChanged();
+    return stored;
+}
+
+bool ArtifactCache::storeData(const QString& key, const QByteArray& data, const QByteArray& log) {
+    if (key.isEmpty()) return false;
+    bool stored = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        const QString target = artifactPath(key);
+        QDir().mkpath(QFileInfo(target).absolutePath());
+        QSaveFile file(target);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(data);
+            stored = file.commit() && commitEntry(key, log);
+        }
+    }
+    emit statsChanged();
+    return stored;
+}
+
+bool ArtifactCache::commitEntry(const QString& key, const QByteArray& log) {
+    const QString logFile = logPath(key);
+    QFile::remove(logFile);
+    if (!log.isEmpty()) {
+        QFile file(logFile);
+        if (file.open(QIODevice::WriteOnly)) {
+            file.write(log);
+        }
+    }
+
+    Entry entry;
+    entry.size = QFileInfo(artifactPath(key)).size() + log.size();
+    entry.lastUsed = QDateTime::currentMSecsSinceEpoch();
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        m_totalBytes -= it->size;
+    }
+    m_entries.insert(key, entry);
+    m_totalBytes += entry.size;
+
+    evictIfNeeded();
+    saveIndex();
+    return m_entries.contains(key);
+}
+
+void ArtifactCache::removeEntryFiles(const QString& key) {
+    QFile::remove(artifactPath(key));
+    QFile::remove(logPath(key));
+}
+
+void ArtifactCache::evictIfNeeded() {
+    if (m_totalBytes <= m_maxSizeBytes) {
+        return;
+    }
+
+    QList<QPair<qint64, QString>> byAge;
+    byAge.reserve(m_entries.size());
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        byAge.append(qMakePair(it->lastUsed, it.key()));
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    for (const auto& item : byAge) {
+        if (m_totalBytes <= m_maxSizeBytes) break;
+        m_totalBytes -= m_entries.value(item.second).size;
+        m_entries.remove(item.second);
+        removeEntryFiles(item.second);
+        ++m_stats.evictions;
+    }
+    m_indexDirty = true;
+}
+
+void ArtifactCache::clear() {
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+            removeEntryFiles(it.key());
+        }
+        m_entries.clear();
+        m_totalBytes = 0;
+        m_stats = Stats();
+        saveIndex();
+    }
+    emit statsChanged();
+}
+
+ArtifactCache::Stats ArtifactCache::stats() const {
+    QMutexLocker locker(&m_mutex);
+    Stats s = m_stats;
+    s.entryCount = m_entries.size();
+    s.totalBytes = m_totalBytes;
+    return s;
+}
+
+qint64 ArtifactCache::maxSizeBytes() const {
+    QMutexLocker locker(&m_mutex);
+    return m_maxSizeBytes;
+}
+
+void ArtifactCache::setMaxSizeBytes(qint64 bytes) {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_maxSizeBytes = qMax<qint64>(0, bytes);
+        QSettings settings("CppAtlas", "CppAtlas");
+        settings.setValue("artifactCache/maxSizeBytes", m_maxSizeBytes);
+        evictIfNeeded();
+        if (m_indexDirty) saveIndex();
+    }
+    emit statsChanged();
+}
+
+// ── Index persistence ────────────────────────────────────────────────────────
+
+void ArtifactCache::loadIndex() {
+    QFile file(m_directory + "/index.json");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    const QJsonObject entries = root["entries"].toObject();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        const QJsonObject obj = it.value().toObject();
+        if (!QFileInfo::exists(artifactPath(it.key()))) {
+            m_indexDirty = true;
+            continue;
+        }
+        Entry entry;
+        entry.size = static_cast<qint64>(obj["size"].toDouble());
+        entry.lastUsed = static_cast<qint64>(obj["lastUsed"].toDouble());
+        m_entries.insert(it.key(), entry);
+        m_totalBytes += entry.size;
+    }
+}
+
+void ArtifactCache::saveIndex() {
+    QJsonObject entries;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        QJsonObject obj;
+        obj["size"] = static_cast<double>(it->size);
+        obj["lastUsed"] = static_cast<double>(it->lastUsed);
+        entries[it.key()] = obj;
+    }
+    QJsonObject root;
+    root["version"] = 1;
+    root["entries"] = entries;
+
+    QSaveFile file(m_directory + "/index.json");
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+        if (file.commit()) {
+            m_indexDirty = false;
+        }
+    }
+    m_sinceIndexSave.restart();
+}
+
+void ArtifactCache::saveIndexIfDirty() {
+    QMutexLocker locker(&m_mutex);
+    if (m_indexDirty) {
+        saveIndex();
+    }
+}
@@ -0,0 +1,48 @@
+#include "core/GroupedProcess.h"
+
+#if defined(Q_OS_UNIX)
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+GroupedProcess::GroupedProcess(QObject* parent)
+    : QProcess(parent)
+{
+#if defined(Q_OS_UNIX) && QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    // Between fork and exec: async-signal-safe calls only
+    setChildProcessModifier([]() { ::setpgid(0, 0); });
+#endif
+}
+
+#if defined(Q_OS_UNIX) && QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+void GroupedProcess::setupChildProcess() {
+    ::setpgid(0, 0);
+}
+#endif
+
+void GroupedProcess::killGroup() {
+    if (state() == QProcess::NotRunning) return;
+#if defined(Q_OS_UNIX)
+    const qint64 pid = processId();
+    if (pid > 0) ::kill(-static_cast<pid_t>(pid), SIGKILL);
+#endif
+    kill();
+}
+
+void GroupedProcess::killAndRelease() {
+    // Stale from here on: nobody hears from it again
+    disconnect(this, nullptr, nullptr, nullptr);
+    if (state() == QProcess::NotRunning) {
+        deleteLater();
+        return;
+    }
+
+    // Outlives its owner if need be; a running QProcess blocks in its destructor
+    setParent(nullptr);
+    connect(this, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &QObject::deleteLater);
+    connect(this, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) deleteLater();
+    });
+    killGroup();
+}
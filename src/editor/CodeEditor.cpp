@@ -1,9 +1,19 @@
 #include "editor/CodeEditor.h"
+#include "editor/HeatMargin.h"
+#include "editor/SyntaxChecker.h"
 #include "ui/ThemeManager.h"
 #include <QFile>
+#include <QFileInfo>
 #include <QTextStream>
 #include <QFont>
 #include <QFontDatabase>
+#include <QMap>
+#include <QToolTip>
+
+namespace {
+// Margins 0-2 are line numbers, markers and folding
+constexpr int HEAT_MARGIN = 3;
+} // namespace
 
 CodeEditor::CodeEditor(QWidget *parent)
     : QsciScintilla(parent)
@@ -15,7 +25,13 @@ CodeEditor::CodeEditor(QWidget *parent)
     setupAutoCompletion();
     setupBraceMatching();
     
+    m_syntaxChecker = new SyntaxChecker(this);
+    connect(m_syntaxChecker, &SyntaxChecker::diagnosticsReady,
+            this, &CodeEditor::onSyntaxCheckFinished);
+
     connect(this, &QsciScintilla::textChanged, this, &CodeEditor::onTextChanged);
+    connect(this, &QsciScintilla::SCN_DWELLSTART, this, &CodeEditor::onDwellStart);
+    connect(this, &QsciScintilla::SCN_DWELLEND, this, []() { QToolTip::hideText(); });
     connect(ThemeManager::instance(), &ThemeManager::themeChanged,
             this, &CodeEditor::onThemeChanged);
     applyTheme(ThemeManager::instance()->currentThemeName());
@@ -80,6 +96,14 @@ void CodeEditor::setupMargins() {
     // Define marker symbols
     m_errorMarkerHandle = markerDefine(QsciScintilla::Circle);
     m_warningMarkerHandle = markerDefine(QsciScintilla::Circle);
+    m_remarkPassedMarkerHandle = markerDefine(QsciScintilla::RightTriangle);
+    m_remarkMissedMarkerHandle = markerDefine(QsciScintilla::RightTriangle);
+
+    // Per-line code cost, next to the text; hidden until there is any
+    m_heatMargin = new HeatMargin(this, HEAT_MARGIN);
+
+    // Hover delay before remark tooltips appear
+    SendScintilla(SCI_SETMOUSEDWELLTIME, 500);
 }
 
 void CodeEditor::setupFolding() {
@@ -156,10 +180,11 @@ bool CodeEditor::loadFile(const QString& filePath) {
     }
     
     QTextStream in(&file);
+    m_filePath = filePath;
+    m_syntaxChecker->setSourceDirectory(QFileInfo(filePath).absolutePath());
     setText(in.readAll());
     file.close();
     
-    m_filePath = filePath;
     m_isModified = false;
     setModified(false);
     emit modificationChanged(false);
@@ -178,6 +203,7 @@ bool CodeEditor::saveFile(const QString& filePath) {
     file.close();
     
     m_filePath = filePath;
+    m_syntaxChecker->setSourceDirectory(QFileInfo(filePath).absolutePath());
     m_isModified = false;
     setModified(false);
     emit modificationChanged(false);
@@ -203,6 +229,8 @@ QString CodeEditor::filePath() const {
 
 void CodeEditor::setFilePath(const QString& path) {
     m_filePath = path;
+    m_syntaxChecker->setSourceDirectory(path.isEmpty() ? QString()
+                                                       : QFileInfo(path).absolutePath());
 }
 
 void CodeEditor::gotoLine(int line) {
@@ -230,6 +258,8 @@ void CodeEditor::clearErrorMarkers() {
 void CodeEditor::clearAllMarkers() {
     markerDeleteAll(-1);  // -1 means all markers
     m_errorMarkers.clear();
+    m_remarkTooltips.clear();
+    m_heatMargin->clear();
 }
 
 void CodeEditor::applyTheme(const QString& themeName) {
@@ -293,6 +323,11 @@ void CodeEditor::applyTheme(const QString& themeName) {
     setMarkerForegroundColor(Qt::white,     m_errorMarkerHandle);
     setMarkerBackgroundColor(theme.warning, m_warningMarkerHandle);
     setMarkerForegroundColor(Qt::white,     m_warningMarkerHandle);
+    setMarkerBackgroundColor(theme.success, m_remarkPassedMarkerHandle);
+    setMarkerForegroundColor(theme.success, m_remarkPassedMarkerHandle);
+    setMarkerBackgroundColor(theme.warning, m_remarkMissedMarkerHandle);
+    setMarkerForegroundColor(theme.warning, m_remarkMissedMarkerHandle);
+    m_heatMargin->applyTheme();
 
     recolor();
 }
@@ -326,4 +361,91 @@ void CodeEditor::onTextChanged() {
         m_isModified = true;
         emit modificationChanged(true);
     }
+    m_syntaxChecker->scheduleCheck(text());
+}
+
+void CodeEditor::onSyntaxCheckFinished(const QList<DiagnosticMessage>& diagnostics,
+                                       qint64 elapsedMs) {
+    Q_UNUSED(elapsedMs);
+    showDiagnostics(diagnostics);
+    emit syntaxDiagnosticsChanged(diagnostics);
+}
+
+void CodeEditor::showDiagnostics(const QList<DiagnosticMessage>& diagnostics) {
+    markerDeleteAll(m_errorMarkerHandle);
+    markerDeleteAll(m_warningMarkerHandle);
+    m_errorMarkers.clear();
+
+    for (const DiagnosticMessage& diag : diagnostics) {
+        if (diag.line <= 0) continue;
+        if (diag.severity == DiagnosticMessage::Error) {
+            setErrorMarker(diag.line, diag.message);
+        } else if (diag.severity == DiagnosticMessage::Warning) {
+            setWarningMarker(diag.line, diag.message);
+        }
+    }
+}
+
+void CodeEditor::showOptRemarks(const QList<OptRemark>& remarks) {
+    clearOptRemarks();
+
+    struct LineRemarks {
+        QStringList text;
+        bool passed = false;
+        bool missed = false;
+    };
+    QMap<int, LineRemarks> byLine;
+    for (const OptRemark& remark : remarks) {
+        if (remark.line <= 0 || remark.line > lines()) continue;
+        LineRemarks& entry = byLine[remark.line];
+        entry.passed |= remark.kind == OptRemark::Kind::Passed;
+        entry.missed |= remark.kind == OptRemark::Kind::Missed;
+        QString text = OptRemark::kindText(remark.kind);
+        if (!remark.pass.isEmpty()) text += QStringLiteral(" [%1]").arg(remark.pass);
+        entry.text << text + QStringLiteral(": ") + remark.message;
+    }
+
+    for (auto it = byLine.cbegin(); it != byLine.cend(); ++it) {
+        if (!it->passed && !it->missed) continue;   // Analysis notes alone stay in the list
+        // QScintilla uses 0-based line numbers
+        const int handle = markerAdd(it.key() - 1, it->missed ? m_remarkMissedMarkerHandle
+                                                              : m_remarkPassedMarkerHandle);
+        m_remarkTooltips.insert(handle, it->text.join(QLatin1Char('\n')));
+    }
+}
+
+void CodeEditor::clearOptRemarks() {
+    markerDeleteAll(m_remarkPassedMarkerHandle);
+    markerDeleteAll(m_remarkMissedMarkerHandle);
+    m_remarkTooltips.clear();
+}
+
+void CodeEditor::showHeatmap(const SourceHeat& heat, SourceHeat::Metric metric) {
+    m_heatMargin->show(heat, metric);
+}
+
+void CodeEditor::clearHeatmap() {
+    m_heatMargin->clear();
+}
+
+void CodeEditor::onDwellStart(int position, int x, int y) {
+    Q_UNUSED(position);
+    const QString heat = m_heatMargin->toolTipAt(x, y);
+    if (!heat.isEmpty()) {
+        QToolTip::showText(viewport()->mapToGlobal(QPoint(x, y)), heat, viewport());
+        return;
+    }
+    if (m_remarkTooltips.isEmpty()) return;
+
+    // position is -1 over the margin; the nearest position still gives the line
+    const long nearest = SendScintilla(SCI_POSITIONFROMPOINT,
+                                       static_cast<unsigned long>(x), static_cast<long>(y));
+    const int line = static_cast<int>(SendScintilla(SCI_LINEFROMPOSITION,
+                                                    static_cast<unsigned long>(nearest)));
+    for (auto it = m_remarkTooltips.cbegin(); it != m_remarkTooltips.cend(); ++it) {
+        if (markerLine(it.key()) == line) {
+            QToolTip::showText(viewport()->mapToGlobal(QPoint(x, y)), it.value(), viewport());
+            return;
+        }
+    }
 }
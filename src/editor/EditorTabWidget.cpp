@@ -1,5 +1,6 @@
 #include "editor/EditorTabWidget.h"
 #include "editor/CodeEditor.h"
+#include "editor/SyntaxChecker.h"
 #include "ui/ThemeManager.h"
 #include <QFileDialog>
 #include <QMessageBox>
@@ -22,6 +23,7 @@ EditorTabWidget::EditorTabWidget(QWidget *parent)
 
 CodeEditor* EditorTabWidget::newFile() {
     CodeEditor* editor = new CodeEditor(this);
+    configureSyntaxChecker(editor);
     QString title = QString("Untitled-%1.cpp").arg(m_newFileCounter++);
     
     connect(editor, &CodeEditor::modificationChanged, 
@@ -45,6 +47,7 @@ CodeEditor* EditorTabWidget::openFile(const QString& filePath) {
     
     // Open new file
     CodeEditor* editor = new CodeEditor(this);
+    configureSyntaxChecker(editor);
     if (!editor->loadFile(filePath)) {
         delete editor;
         return nullptr;
@@ -244,3 +247,31 @@ void EditorTabWidget::applyThemeToAllEditors(const QString& themeName) {
         }
     }
 }
+
+void EditorTabWidget::setSyntaxCheckOptions(const QString& compilerId, const QString& standard,
+                                            bool enabled) {
+    const bool changed = compilerId != m_syntaxCompilerId || standard != m_syntaxStandard
+                         || enabled != m_syntaxCheckEnabled;
+    m_syntaxCompilerId = compilerId;
+    m_syntaxStandard = standard;
+    m_syntaxCheckEnabled = enabled;
+    if (!changed) return;
+
+    for (int i = 0; i < count(); ++i) {
+        CodeEditor* editor = editorAt(i);
+        if (!editor) continue;
+        configureSyntaxChecker(editor);
+        if (enabled) {
+            editor->syntaxChecker()->scheduleCheck(editor->text());
+        } else {
+            editor->showDiagnostics({});
+        }
+    }
+}
+
+void EditorTabWidget::configureSyntaxChecker(CodeEditor* editor) const {
+    SyntaxChecker* checker = editor->syntaxChecker();
+    checker->setCompilerId(m_syntaxCompilerId);
+    checker->setStandard(m_syntaxStandard);
+    checker->setEnabled(m_syntaxCheckEnabled);
+}
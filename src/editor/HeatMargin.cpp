@@ -0,0 +1,96 @@
+#include "editor/HeatMargin.h"
+#include "ui/ThemeManager.h"
+
+#include <Qsci/qsciscintilla.h>
+
+#include <cmath>
+
+namespace {
+
+constexpr int MARGIN_WIDTH = 6;
+constexpr int MAX_MARGINS  = 5;   // Scintilla's default margin count
+
+QColor blend(const QColor& from, const QColor& to, double t) {
+    return QColor::fromRgbF(from.redF()   + (to.redF()   - from.redF())   * t,
+                            from.greenF() + (to.greenF() - from.greenF()) * t,
+                            from.blueF()  + (to.blueF()  - from.blueF())  * t);
+}
+
+} // namespace
+
+HeatMargin::HeatMargin(QsciScintilla* editor, int margin)
+    : QObject(editor)
+    , m_editor(editor)
+    , m_margin(margin)
+{
+    int mask = 0;
+    for (int level = 0; level < LEVELS; ++level) {
+        const int marker = m_editor->markerDefine(QsciScintilla::FullRectangle);
+        if (level == 0) m_firstMarker = marker;
+        mask |= 1 << marker;
+    }
+    for (int other = 0; other < MAX_MARGINS; ++other) {
+        if (other != m_margin) {
+            m_editor->setMarginMarkerMask(other, m_editor->marginMarkerMask(other) & ~mask);
+        }
+    }
+    m_editor->setMarginType(m_margin, QsciScintilla::SymbolMargin);
+    m_editor->setMarginMarkerMask(m_margin, mask);
+    m_editor->setMarginWidth(m_margin, 0);
+    applyTheme();
+}
+
+void HeatMargin::show(const SourceHeat& heat, SourceHeat::Metric metric) {
+    clear();
+    const double max = heat.maxValue(metric);
+    if (max <= 0.0) return;
+
+    m_heat = heat;
+    const int lastLine = qMin(heat.lineCount(), m_editor->lines());
+    for (int line = 1; line <= lastLine; ++line) {
+        const double value = heat.value(line, metric);
+        if (value <= 0.0) continue;
+        // Even the coolest line with code gets the first shade
+        const int level = qBound(0, int(std::ceil(value / max * LEVELS)) - 1, LEVELS - 1);
+        // QScintilla uses 0-based line numbers
+        m_handles.insert(m_editor->markerAdd(line - 1, m_firstMarker + level), line);
+    }
+    m_editor->setMarginWidth(m_margin, m_handles.isEmpty() ? 0 : MARGIN_WIDTH);
+}
+
+void HeatMargin::clear() {
+    for (int level = 0; level < LEVELS; ++level) {
+        m_editor->markerDeleteAll(m_firstMarker + level);
+    }
+    m_handles.clear();
+    m_heat = SourceHeat();
+    m_editor->setMarginWidth(m_margin, 0);
+}
+
+void HeatMargin::applyTheme() {
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    for (int level = 0; level < LEVELS; ++level) {
+        const QColor colour = blend(theme.sidebarBackground, theme.error,
+                                    double(level + 1) / LEVELS);
+        m_editor->setMarkerBackgroundColor(colour, m_firstMarker + level);
+        m_editor->setMarkerForegroundColor(colour, m_firstMarker + level);
+    }
+}
+
+QString HeatMargin::toolTipAt(int x, int y) const {
+    if (m_handles.isEmpty()) return QString();
+
+    int left = 0;
+    for (int margin = 0; margin < m_margin; ++margin) left += m_editor->marginWidth(margin);
+    if (x < left || x >= left + m_editor->marginWidth(m_margin)) return QString();
+
+    const long position = m_editor->SendScintilla(QsciScintilla::SCI_POSITIONFROMPOINT,
+                                                  static_cast<unsigned long>(x),
+                                                  static_cast<long>(y));
+    const int line = static_cast<int>(m_editor->SendScintilla(
+        QsciScintilla::SCI_LINEFROMPOSITION, static_cast<unsigned long>(position)));
+    for (auto it = m_handles.cbegin(); it != m_handles.cend(); ++it) {
+        if (m_editor->markerLine(it.key()) == line) return m_heat.describe(it.value());
+    }
+    return QString();
+}
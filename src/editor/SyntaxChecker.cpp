@@ -0,0 +1,162 @@
+#include "editor/SyntaxChecker.h"
+#include "compiler/CompilerRegistry.h"
+#include "compiler/StdinSource.h"
+#include "core/GroupedProcess.h"
+#include <QDir>
+#include <QTimer>
+
+namespace {
+const QString STDIN_FILE = QStringLiteral("<stdin>");
+}
+
+SyntaxChecker::SyntaxChecker(QObject* parent)
+    : QObject(parent)
+{
+    m_debounceTimer = new QTimer(this);
+    m_debounceTimer->setSingleShot(true);
+    m_debounceTimer->setInterval(DEFAULT_DEBOUNCE_MS);
+    connect(m_debounceTimer, &QTimer::timeout, this, &SyntaxChecker::runCheck);
+
+    m_timeoutTimer = new QTimer(this);
+    m_timeoutTimer->setSingleShot(true);
+    m_timeoutTimer->setInterval(TIMEOUT_MS);
+    connect(m_timeoutTimer, &QTimer::timeout, this, &SyntaxChecker::killProcess);
+}
+
+SyntaxChecker::~SyntaxChecker() {
+    killProcess();
+}
+
+void SyntaxChecker::setCompilerId(const QString& compilerId) {
+    m_compilerId = compilerId;
+}
+
+void SyntaxChecker::setStandard(const QString& standard) {
+    m_standard = standard;
+}
+
+void SyntaxChecker::setSourceDirectory(const QString& directory) {
+    m_sourceDirectory = directory;
+}
+
+void SyntaxChecker::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) {
+        cancel();
+    }
+}
+
+void SyntaxChecker::setDebounceMs(int ms) {
+    m_debounceTimer->setInterval(ms);
+}
+
+int SyntaxChecker::debounceMs() const {
+    return m_debounceTimer->interval();
+}
+
+void SyntaxChecker::scheduleCheck(const QString& source) {
+    if (!m_enabled) {
+        return;
+    }
+    // A running check is for an older buffer: drop its result, but let it
+    // run on; runCheck() only kills it if it is still going by then
+    m_staleProcess = m_process != nullptr;
+    m_pendingSource = source;
+    m_debounceTimer->start();
+}
+
+void SyntaxChecker::cancel() {
+    m_debounceTimer->stop();
+    m_pendingSource.clear();
+    killProcess();
+}
+
+bool SyntaxChecker::isRunning() const {
+    return m_process != nullptr;
+}
+
+QStringList SyntaxChecker::buildArguments(const QString& standard, const QString& sourceDirectory) {
+    QStringList args;
+    args << "-fsyntax-only"
+         << "-fdiagnostics-color=never";
+    if (!standard.isEmpty()) {
+        args << "-std=" + standard;
+    }
+    args << StdinSource::arguments(sourceDirectory);
+    return args;
+}
+
+void SyntaxChecker::runCheck() {
+    auto compiler = CompilerRegistry::instance().getCompiler(m_compilerId);
+    if (!compiler || !compiler->isAvailable()) {
+        return;
+    }
+
+    killProcess();
+
+    m_process = new GroupedProcess(this);
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    m_process->setWorkingDirectory(m_sourceDirectory.isEmpty() ? QDir::tempPath()
+                                                               : m_sourceDirectory);
+
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &SyntaxChecker::onProcessFinished);
+    connect(m_process, &QProcess::errorOccurred,
+            this, &SyntaxChecker::onProcessError);
+
+    m_elapsed.start();
+    m_timeoutTimer->start();
+    m_process->start(compiler->executablePath(), buildArguments(m_standard, m_sourceDirectory));
+    m_process->write(m_pendingSource.toUtf8());
+    m_process->closeWriteChannel();
+    m_pendingSource.clear();
+}
+
+void SyntaxChecker::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
+    Q_UNUSED(exitCode);
+    if (!m_process) return;
+
+    m_timeoutTimer->stop();
+    const qint64 elapsedMs = m_elapsed.elapsed();
+    const QString output = QString::fromUtf8(m_process->readAllStandardError());
+    m_process->deleteLater();
+    m_process = nullptr;
+
+    if (m_staleProcess) {
+        m_staleProcess = false;
+        return;
+    }
+    if (status != QProcess::NormalExit) {
+        return;
+    }
+
+    auto compiler = CompilerRegistry::instance().getCompiler(m_compilerId);
+    if (!compiler) {
+        return;
+    }
+
+    QList<DiagnosticMessage> diagnostics;
+    for (const DiagnosticMessage& diag : compiler->parseDiagnosticOutput(output)) {
+        if (diag.file == STDIN_FILE) {
+            diagnostics.append(diag);
+        }
+    }
+    emit diagnosticsReady(diagnostics, elapsedMs);
+}
+
+void SyntaxChecker::onProcessError(QProcess::ProcessError error) {
+    // A failed start never emits finished(); crashes are handled there
+    if (error != QProcess::FailedToStart) return;
+    killProcess();
+}
+
+void SyntaxChecker::killProcess() {
+    m_timeoutTimer->stop();
+    m_staleProcess = false;
+    if (!m_process) {
+        return;
+    }
+    // Kills cc1plus with the driver; reaped in the background, never reports
+    m_process->killAndRelease();
+    m_process = nullptr;
+}
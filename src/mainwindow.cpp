@@ -5,6 +5,7 @@
 #include "output/OutputPanel.h"
 #include "output/TerminalWidget.h"
 #include "output/ProblemsWidget.h"
+#include "output/RemarksWidget.h"
 #include "ui/FileTreeWidget.h"
 #include "ui/ThemeManager.h"
 #include "ui/GotoLineDialog.h"
@@ -22,12 +23,17 @@
 #  include "ui/QuizAdminPanel.h"
 #endif
 #include "core/AppSettings.h"
+#include "core/ArtifactCache.h"
 #include "core/FileManager.h"
 #include "core/Project.h"
 #include "core/ProjectManager.h"
 #include "core/RecentProjectsManager.h"
 #include "compiler/CompilerRegistry.h"
 #include "compiler/ICompiler.h"
+#include "compiler/CompileJob.h"
+#include "compiler/ProjectBuilder.h"
+#include "tools/OptRemarksRunner.h"
+#include "tools/ToolsConfig.h"
 
 #include <QToolBar>
 #include <QMenuBar>
@@ -63,6 +69,24 @@
 #include <windowsx.h>
 #endif
 
+// Compilers report paths relative to their working directory; the Problems
+// panel and editor navigation need absolute ones.
+static QList<DiagnosticMessage> resolveDiagnosticPaths(const QString& sourceDir,
+                                                       QList<DiagnosticMessage> diagnostics)
+{
+    for (DiagnosticMessage& diag : diagnostics) {
+        if (!diag.file.isEmpty() && !QFileInfo(diag.file).isAbsolute()) {
+            const QString abs = QDir(sourceDir).absoluteFilePath(diag.file);
+            if (QFileInfo::exists(abs))
+                diag.file = abs;
+            else
+                diag.file = sourceDir + QDir::separator() + diag.file;
+        }
+        diag.children = resolveDiagnosticPaths(sourceDir, diag.children);
+    }
+    return diagnostics;
+}
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
@@ -79,6 +103,8 @@ MainWindow::MainWindow(QWidget *parent)
 
     m_fileManager = new FileManager(this);
     m_project     = new Project(this);
+    m_projectBuilder = new ProjectBuilder(this);
+    m_remarksRunner  = new OptRemarksRunner(this);
 
     setupUi();
     setupMenus();
@@ -88,7 +114,12 @@ MainWindow::MainWindow(QWidget *parent)
     setupConnections();
     setupWelcomeScreen();
 
-    CompilerRegistry::instance().autoScanCompilers();
+    // Toolchains are probed on a worker thread; the compiler combo is
+    // refilled whenever the scan registers something new.
+    connect(&CompilerRegistry::instance(), &CompilerRegistry::compilersChanged,
+            this, &MainWindow::loadCompilers);
+    CompilerRegistry::instance().autoScanCompilersAsync(
+        {{ToolsConfig::instance().cppInsightsPath(), ToolsConfig::insightsProbeArguments()}});
     loadCompilers();
 
     {
@@ -374,6 +405,12 @@ void MainWindow::setupMenus()
     QAction* cleanAction = m_buildMenu->addAction("&Clean");
     connect(cleanAction, &QAction::triggered, this, &MainWindow::onBuildClean);
 
+    m_buildMenu->addSeparator();
+
+    QAction* remarksAction = m_buildMenu->addAction("Optimization &Remarks");
+    remarksAction->setShortcut(QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_R));
+    connect(remarksAction, &QAction::triggered, this, &MainWindow::onBuildRemarks);
+
     // View menu
     m_viewMenu = menuBar()->addMenu("&View");
 
@@ -485,6 +522,11 @@ void MainWindow::setupMenus()
         updateTitlePosition();
     });
 
+    m_toolsMenu->addSeparator();
+
+    QAction* artifactCacheAction = m_toolsMenu->addAction(QStringLiteral("Artifact &Cache..."));
+    connect(artifactCacheAction, &QAction::triggered, this, &MainWindow::showArtifactCacheDialog);
+
     // Settings menu
     m_settingsMenu = menuBar()->addMenu(QStringLiteral("&Settings"));
     QAction* openSettingsAction = m_settingsMenu->addAction(QStringLiteral("&Preferences..."));
@@ -600,6 +642,47 @@ void MainWindow::setupConnections()
     connect(m_outputPanel->problems(), &ProblemsWidget::diagnosticClicked,
             this, &MainWindow::onDiagnosticClicked);
 
+    // Optimization remarks: list in the output panel, markers in the editor
+    RemarksWidget* remarks = m_outputPanel->remarks();
+    connect(remarks, &RemarksWidget::runRequested, this, &MainWindow::onBuildRemarks);
+    connect(remarks, &RemarksWidget::cleared, this, [this]() {
+        if (m_remarksEditor) m_remarksEditor->clearOptRemarks();
+    });
+    connect(remarks, &RemarksWidget::remarkClicked,
+            this, [this](const QString& file, int line, int column) {
+                if (file != QLatin1String("<stdin>")) {
+                    onDiagnosticClicked(file, line, column);   // A header
+                    return;
+                }
+                if (!m_remarksEditor) return;
+                const int index = m_editorTabs->indexOf(m_remarksEditor);
+                if (index >= 0) m_editorTabs->setCurrentIndex(index);
+                m_remarksEditor->gotoLine(line);
+                m_remarksEditor->setCursorPosition(line - 1, qMax(0, column - 1));
+                m_remarksEditor->setFocus();
+            });
+    connect(m_remarksRunner, &OptRemarksRunner::remarksReady,
+            this, [this](const QList<OptRemark>& list) {
+                m_outputPanel->remarks()->setRemarks(list);
+                if (!m_remarksEditor) return;
+                QList<OptRemark> own;   // The piped buffer is "<stdin>"
+                for (const OptRemark& remark : list) {
+                    if (remark.file == QLatin1String("<stdin>")) own << remark;
+                }
+                m_remarksEditor->showOptRemarks(own);
+            });
+    connect(m_remarksRunner, &OptRemarksRunner::finished,
+            this, [this](bool success, const QString&, const QString& error) {
+                RemarksWidget* widget = m_outputPanel->remarks();
+                widget->setRunning(false);
+                if (!success) {
+                    widget->setStatusText(QStringLiteral("Compile failed: ")
+                                          + error.trimmed().section('\n', 0, 0));
+                } else if (widget->remarkCount() == 0) {
+                    widget->setStatusText(QStringLiteral("No remarks — is optimization enabled?"));
+                }
+            });
+
     connect(ProjectManager::instance(), &ProjectManager::projectClosed,
             this, [this]() {
                 if (m_closeProjectAction) m_closeProjectAction->setEnabled(false);
@@ -610,14 +693,46 @@ void MainWindow::setupConnections()
                 CodeEditor* ed = m_editorTabs->currentEditor();
                 if (ed) ed->gotoLine(line);
             });
+    // The Assembly tab always works on the active editor's buffer
+    connect(m_analysisPanel, &AnalysisPanel::sourceHeatChanged,
+            this, [this](const SourceHeat& heat, SourceHeat::Metric metric) {
+                CodeEditor* ed = m_editorTabs->currentEditor();
+                if (m_heatEditor && m_heatEditor != ed) m_heatEditor->clearHeatmap();
+                m_heatEditor = ed;
+                if (!ed) return;
+                if (heat.isEmpty()) ed->clearHeatmap();
+                else ed->showHeatmap(heat, metric);
+            });
 
     connect(m_compilerCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, [this](int) {
                 m_analysisPanel->setCompilerId(m_compilerCombo->currentData().toString());
+                m_editorTabs->setSyntaxCheckOptions(m_compilerCombo->currentData().toString(),
+                                                    m_standardCombo->currentText());
             });
     connect(m_standardCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, [this](int) {
                 m_analysisPanel->setStandard(m_standardCombo->currentText());
+                m_editorTabs->setSyntaxCheckOptions(m_compilerCombo->currentData().toString(),
+                                                    m_standardCombo->currentText());
+            });
+
+    connect(m_projectBuilder, &ProjectBuilder::progressMessage,
+            m_statusLabel, &QLabel::setText);
+    connect(m_projectBuilder, &ProjectBuilder::outputReceived,
+            this, [this](const QString& text, bool fromStderr) {
+                const QColor color = fromStderr ? QColor("#F48771")
+                                                : ThemeManager::instance()->currentTheme().textPrimary;
+                m_outputPanel->terminal()->appendText(text, color);
+            });
+    connect(m_projectBuilder, &ProjectBuilder::diagnosticsReceived,
+            this, [this](const QList<DiagnosticMessage>& diagnostics) {
+                m_outputPanel->problems()->appendDiagnostics(
+                    resolveDiagnosticPaths(m_projectBuilder->projectDirectory(), diagnostics));
+            });
+    connect(m_projectBuilder, &ProjectBuilder::finished,
+            this, [this](const CompileResult& result) {
+                onBuildFinished(result);
             });
 }
 
@@ -947,6 +1062,7 @@ void MainWindow::updateMenuState(bool isWelcomeOrQuiz)
 // ─────────────────────────────────────────────────────────────────────────────
 void MainWindow::loadCompilers()
 {
+    const QString previousId = m_compilerCombo->currentData().toString();
     m_compilerCombo->clear();
     auto compilers = CompilerRegistry::instance().getAvailableCompilers();
     if (compilers.isEmpty()) {
@@ -955,10 +1071,12 @@ void MainWindow::loadCompilers()
         m_compilerLabel->setText("No compiler");
         return;
     }
+    m_compilerCombo->setEnabled(true);
     for (const auto& compiler : compilers)
         m_compilerCombo->addItem(compiler->name(), compiler->id());
 
-    QString defaultId = CompilerRegistry::instance().defaultCompilerId();
+    QString defaultId = previousId.isEmpty()
+        ? CompilerRegistry::instance().defaultCompilerId() : previousId;
     int index = m_compilerCombo->findData(defaultId);
     if (index >= 0) m_compilerCombo->setCurrentIndex(index);
 
@@ -1236,14 +1354,31 @@ void MainWindow::onEditGotoLine()
 // ─────────────────────────────────────────────────────────────────────────────
 void MainWindow::onBuildCompile()
 {
+    m_runAfterBuild = false;
+    startBuild();
+}
+
+bool MainWindow::startBuild()
+{
+    Project* project = ProjectManager::instance()->currentProject();
+    if (project && !project->sourceFiles().isEmpty())
+        return startProjectBuild(project);
+
     QString sourceFile = getCurrentSourceFile();
     if (sourceFile.isEmpty()) {
         showBuildError("No file to compile. Please save your file first.");
-        return;
+        return false;
     }
     QString compilerId = m_compilerCombo->currentData().toString();
     auto compiler = CompilerRegistry::instance().getCompiler(compilerId);
-    if (!compiler) { showBuildError("No compiler selected."); return; }
+    if (!compiler) { showBuildError("No compiler selected."); return false; }
+
+    // A new build supersedes one that is still in flight
+    if (m_buildJob) {
+        m_buildJob->disconnect(this);
+        m_buildJob->cancel();
+        m_buildJob->deleteLater();
+    }
 
     CompileRequest request;
     request.sourceFile         = sourceFile;
@@ -1252,39 +1387,93 @@ void MainWindow::onBuildCompile()
     request.additionalFlags    = QStringList() << "-Wall" << "-Wextra";
     request.optimizationEnabled = false;
     request.optLevel           = OptimizationLevel::O0;
+    request.useCache           = true;
 
     m_outputPanel->terminal()->clear();
     m_outputPanel->showTerminalTab();
     m_outputPanel->problems()->clear();
     m_statusLabel->setText("Building...");
 
-    CompileResult result = compiler->compile(request);
-    Theme theme = ThemeManager::instance()->currentTheme();
+    CompileJob* job = compiler->compileAsync(request, this);
+    m_buildJob = job;
 
-    if (!result.rawOutput.isEmpty())
-        m_outputPanel->terminal()->appendText(result.rawOutput, theme.textPrimary);
-    if (!result.rawError.isEmpty())
-        m_outputPanel->terminal()->appendText(result.rawError, QColor("#F48771"));
+    connect(job, &CompileJob::progressMessage, this, [this](const QString& message) {
+        m_statusLabel->setText(message);
+    });
+    connect(job, &CompileJob::outputReceived, this, [this](const QString& text, bool fromStderr) {
+        const QColor color = fromStderr ? QColor("#F48771")
+                                        : ThemeManager::instance()->currentTheme().textPrimary;
+        m_outputPanel->terminal()->appendText(text, color);
+    });
+    connect(job, &CompileJob::diagnosticsReceived, this,
+            [this, sourceDir = QFileInfo(sourceFile).absolutePath()](const QList<DiagnosticMessage>& diagnostics) {
+        m_outputPanel->problems()->appendDiagnostics(resolveDiagnosticPaths(sourceDir, diagnostics));
+    });
+    connect(job, &CompileJob::finished, this, [this, job](const CompileResult& result) {
+        if (m_buildJob == job) m_buildJob = nullptr;
+        job->deleteLater();
+        onBuildFinished(result);
+    });
+    // Tied to this job: a superseded, failed or cancelled build never runs
+    if (m_runAfterBuild) {
+        m_runAfterBuild = false;
+        job->whenSucceeded(this, [this]() { onBuildRun(); });
+    }
 
-    {
-        const QString sourceDir = QFileInfo(sourceFile).absolutePath();
-        QList<DiagnosticMessage> resolved = result.diagnostics;
-        for (DiagnosticMessage& diag : resolved) {
-            if (!diag.file.isEmpty() && !QFileInfo(diag.file).isAbsolute()) {
-                const QString abs = QDir(sourceDir).absoluteFilePath(diag.file);
-                if (QFileInfo::exists(abs))
-                    diag.file = abs;
-                else
-                    diag.file = sourceDir + QDir::separator() + diag.file;
-            }
-        }
-        m_outputPanel->problems()->setDiagnostics(resolved);
+    job->start();
+    return true;
+}
+
+bool MainWindow::startProjectBuild(Project* project)
+{
+    QString compilerId = m_compilerCombo->currentData().toString();
+    auto compiler = CompilerRegistry::instance().getCompiler(compilerId);
+    if (!compiler) { showBuildError("No compiler selected."); return false; }
+
+    // Every TU may depend on any open buffer, so flush them all to disk
+    for (int i = 0; i < m_editorTabs->count(); ++i) {
+        CodeEditor* editor = m_editorTabs->editorAt(i);
+        if (editor && editor->isModified() && !editor->filePath().isEmpty())
+            editor->saveFile(editor->filePath());
+    }
+
+    if (m_projectBuilder->isRunning()) {
+        m_statusLabel->setText("A project build is already running");
+        return false;
+    }
+
+    m_outputPanel->terminal()->clear();
+    m_outputPanel->showTerminalTab();
+    m_outputPanel->problems()->clear();
+    m_statusLabel->setText("Building...");
+
+    if (!m_projectBuilder->build(project, compiler, m_standardCombo->currentText(),
+                                 QStringList() << "-Wall" << "-Wextra")) {
+        showBuildError("Project build could not be started.");
+        return false;
+    }
+    return true;
+}
+
+void MainWindow::onBuildFinished(const CompileResult& result)
+{
+    const bool runAfterBuild = m_runAfterBuild;
+    m_runAfterBuild = false;
+
+    if (result.cancelled) {
+        m_statusLabel->setText("Build cancelled");
+        m_outputPanel->terminal()->appendText("\nBuild cancelled.\n", QColor("#CCA700"));
+        return;
     }
 
     if (result.success) {
         m_currentExecutable = result.outputFile;
-        m_statusLabel->setText(QString("Build succeeded (%1 ms)").arg(result.compilationTimeMs));
+        m_statusLabel->setText(result.fromCache
+                               ? QString("Build succeeded (cached)")
+                               : QString("Build succeeded (%1 ms)").arg(result.compilationTimeMs));
         m_outputPanel->terminal()->appendText("\nBuild succeeded!\n", QColor("#4EC994"));
+        if (runAfterBuild)
+            onBuildRun();
     } else {
         m_statusLabel->setText("Build failed");
         m_outputPanel->terminal()->appendText("\nBuild failed!\n", QColor("#F44747"));
@@ -1305,13 +1494,24 @@ void MainWindow::onBuildRun()
 
 void MainWindow::onBuildCompileAndRun()
 {
-    onBuildCompile();
-    if (!m_currentExecutable.isEmpty() && QFile::exists(m_currentExecutable))
-        onBuildRun();
+    // Single-file builds chain the run onto their CompileJob; project builds
+    // run it from onBuildFinished() once the build succeeds
+    m_runAfterBuild = true;
+    if (!startBuild())
+        m_runAfterBuild = false;
 }
 
 void MainWindow::onBuildStop()
 {
+    if (m_buildJob && m_buildJob->isActive()) {
+        m_buildJob->cancel();
+        return;
+    }
+    if (m_projectBuilder->isRunning()) {
+        m_runAfterBuild = false;
+        m_projectBuilder->cancel();
+        return;
+    }
     if (m_outputPanel->terminal()->isRunning()) {
         m_outputPanel->terminal()->stopProcess();
         m_statusLabel->setText("Program stopped");
@@ -1320,6 +1520,14 @@ void MainWindow::onBuildStop()
 
 void MainWindow::onBuildClean()
 {
+    Project* project = ProjectManager::instance()->currentProject();
+    if (project && !project->sourceFiles().isEmpty() && !m_projectBuilder->isRunning()) {
+        QDir(ProjectBuilder::objectDirectoryFor(project)).removeRecursively();
+        QFile::remove(ProjectBuilder::executablePathFor(project));
+        m_currentExecutable.clear();
+        m_statusLabel->setText("Clean complete");
+        return;
+    }
     if (!m_currentExecutable.isEmpty() && QFile::exists(m_currentExecutable)) {
         QFile::remove(m_currentExecutable);
         m_currentExecutable.clear();
@@ -1327,6 +1535,32 @@ void MainWindow::onBuildClean()
     }
 }
 
+void MainWindow::onBuildRemarks()
+{
+    CodeEditor* editor = m_editorTabs->currentEditor();
+    if (!editor) {
+        m_statusLabel->setText("No file to analyze");
+        return;
+    }
+
+    // Markers belong to one buffer at a time
+    if (m_remarksEditor) m_remarksEditor->clearOptRemarks();
+    m_remarksEditor = editor;
+
+    RemarksWidget* remarks = m_outputPanel->remarks();
+    QStringList flags;
+    flags << QStringLiteral("-std=") + m_standardCombo->currentText()
+          << remarks->optimizationFlag();
+    const QString sourceDir = editor->filePath().isEmpty()
+        ? QString() : QFileInfo(editor->filePath()).absolutePath();
+
+    remarks->setRunning(true);
+    m_outputPanel->show();
+    m_outputPanel->showRemarksTab();
+    m_remarksRunner->setCompilerId(m_compilerCombo->currentData().toString());
+    m_remarksRunner->runSource(editor->text(), flags, sourceDir);
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Toolbar slots
 // ─────────────────────────────────────────────────────────────────────────────
@@ -1608,6 +1842,39 @@ void MainWindow::restoreProjectSession(Project* project)
 // ─────────────────────────────────────────────────────────────────────────────
 // About dialog
 // ─────────────────────────────────────────────────────────────────────────────
+void MainWindow::showArtifactCacheDialog()
+{
+    ArtifactCache* cache = ArtifactCache::instance();
+    const ArtifactCache::Stats stats = cache->stats();
+    const qint64 lookups = stats.hits + stats.misses;
+    const QString hitRate = lookups > 0
+        ? QString::number(100.0 * stats.hits / lookups, 'f', 1) + "%"
+        : QStringLiteral("n/a");
+
+    QMessageBox box(this);
+    box.setWindowTitle(QStringLiteral("Artifact Cache"));
+    box.setIcon(QMessageBox::Information);
+    box.setText(QString("Cached builds, assembly, C++ Insights output and benchmark binaries.\n\n"
+                        "Entries: %1\n"
+                        "Size: %2 MB of %3 MB\n"
+                        "Hits / misses this session: %4 / %5 (%6)\n"
+                        "Evictions this session: %7")
+                    .arg(stats.entryCount)
+                    .arg(stats.totalBytes / (1024.0 * 1024.0), 0, 'f', 1)
+                    .arg(cache->maxSizeBytes() / (1024 * 1024))
+                    .arg(stats.hits).arg(stats.misses).arg(hitRate)
+                    .arg(stats.evictions));
+    box.setDetailedText(cache->cacheDirectory());
+    QPushButton* clearButton = box.addButton(QStringLiteral("Clear Cache"), QMessageBox::DestructiveRole);
+    box.addButton(QMessageBox::Close);
+    box.exec();
+
+    if (box.clickedButton() == clearButton) {
+        cache->clear();
+        m_statusLabel->setText("Artifact cache cleared");
+    }
+}
+
 void MainWindow::showAboutDialog()
 {
     Qt::WindowFlags flags = Qt::Dialog | Qt::WindowStaysOnTopHint | Qt::WindowTitleHint
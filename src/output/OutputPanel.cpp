@@ -1,6 +1,7 @@
 #include "output/OutputPanel.h"
 #include "output/TerminalWidget.h"
 #include "output/ProblemsWidget.h"
+#include "output/RemarksWidget.h"
 #include "ui/ThemeManager.h"
 #include <QTabBar>
 
@@ -9,9 +10,11 @@ OutputPanel::OutputPanel(QWidget *parent)
 {
     m_terminal = new TerminalWidget(this);
     m_problems = new ProblemsWidget(this);
+    m_remarks  = new RemarksWidget(this);
 
     addTab(m_terminal, "Terminal");
     addTab(m_problems, "Problems");
+    addTab(m_remarks,  "Remarks");
 
     setTabPosition(QTabWidget::South);
 
@@ -22,6 +25,7 @@ OutputPanel::OutputPanel(QWidget *parent)
 
 void OutputPanel::showTerminalTab() { setCurrentWidget(m_terminal); }
 void OutputPanel::showProblemsTab() { setCurrentWidget(m_problems); }
+void OutputPanel::showRemarksTab()  { setCurrentWidget(m_remarks); }
 
 void OutputPanel::applyTheme()
 {
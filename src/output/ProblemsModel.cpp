@@ -0,0 +1,147 @@
+#include "output/ProblemsModel.h"
+#include <QColor>
+#include <QFileInfo>
+
+ProblemsModel::ProblemsModel(QObject* parent)
+    : QAbstractItemModel(parent)
+{
+}
+
+void ProblemsModel::appendDiagnostics(const QList<DiagnosticMessage>& diagnostics) {
+    if (diagnostics.isEmpty()) return;
+
+    const int first = m_items.size();
+    beginInsertRows(QModelIndex(), first, first + diagnostics.size() - 1);
+    for (const DiagnosticMessage& d : diagnostics) {
+        m_items.append(d);
+        if (d.severity == DiagnosticMessage::Error) ++m_errorCount;
+        else if (d.severity == DiagnosticMessage::Warning) ++m_warningCount;
+    }
+    endInsertRows();
+}
+
+void ProblemsModel::clear() {
+    beginResetModel();
+    m_items.clear();
+    m_errorCount = 0;
+    m_warningCount = 0;
+    endResetModel();
+}
+
+const DiagnosticMessage* ProblemsModel::diagnosticAt(const QModelIndex& index) const {
+    if (!index.isValid()) return nullptr;
+    const quintptr id = index.internalId();
+    if (id == 0) {
+        return index.row() < m_items.size() ? &m_items[index.row()] : nullptr;
+    }
+    const int parentRow = static_cast<int>(id - 1);
+    if (parentRow >= m_items.size()) return nullptr;
+    const QList<DiagnosticMessage>& children = m_items[parentRow].children;
+    return index.row() < children.size() ? &children[index.row()] : nullptr;
+}
+
+QModelIndex ProblemsModel::index(int row, int column, const QModelIndex& parent) const {
+    if (row < 0 || column < 0 || column >= ColumnCount) return QModelIndex();
+
+    if (!parent.isValid()) {
+        return row < m_items.size() ? createIndex(row, column, quintptr(0)) : QModelIndex();
+    }
+    if (parent.internalId() != 0 || parent.row() >= m_items.size()) {
+        return QModelIndex();   // Children have no children of their own
+    }
+    if (row >= m_items[parent.row()].children.size()) return QModelIndex();
+    return createIndex(row, column, quintptr(parent.row() + 1));
+}
+
+QModelIndex ProblemsModel::parent(const QModelIndex& child) const {
+    if (!child.isValid() || child.internalId() == 0) return QModelIndex();
+    return createIndex(static_cast<int>(child.internalId() - 1), 0, quintptr(0));
+}
+
+int ProblemsModel::rowCount(const QModelIndex& parent) const {
+    if (!parent.isValid()) return m_items.size();
+    if (parent.internalId() != 0 || parent.column() != 0 || parent.row() >= m_items.size())
+        return 0;
+    return m_items[parent.row()].children.size();
+}
+
+int ProblemsModel::columnCount(const QModelIndex& parent) const {
+    Q_UNUSED(parent);
+    return ColumnCount;
+}
+
+QVariant ProblemsModel::data(const QModelIndex& index, int role) const {
+    const DiagnosticMessage* d = diagnosticAt(index);
+    if (!d) return QVariant();
+
+    switch (role) {
+    case Qt::DisplayRole:
+        switch (index.column()) {
+        case IconColumn:     return severityIcon(d->severity);
+        case SeverityColumn: return severityText(d->severity);
+        case MessageColumn:  return d->message;
+        case FileColumn:     return QFileInfo(d->file).fileName();
+        case PositionColumn:
+            return d->line > 0 ? QString("%1:%2").arg(d->line).arg(d->column) : QString();
+        }
+        break;
+    case Qt::ForegroundRole:
+        if (index.column() == IconColumn || index.column() == SeverityColumn)
+            return severityColor(d->severity);
+        break;
+    case Qt::TextAlignmentRole:
+        if (index.column() == IconColumn) return int(Qt::AlignCenter);
+        break;
+    case Qt::ToolTipRole:
+        if (index.column() == FileColumn) return d->file;
+        if (index.column() == MessageColumn) return d->message;
+        break;
+    case SeverityRole: return int(d->severity);
+    case FilePathRole: return d->file;
+    case LineRole:     return d->line;
+    case ColumnRole:   return d->column;
+    }
+    return QVariant();
+}
+
+QVariant ProblemsModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+    case IconColumn:     return QString();
+    case SeverityColumn: return QStringLiteral("Severity");
+    case MessageColumn:  return QStringLiteral("Message");
+    case FileColumn:     return QStringLiteral("File");
+    case PositionColumn: return QStringLiteral("Line:Col");
+    }
+    return QVariant();
+}
+
+QString ProblemsModel::severityIcon(DiagnosticMessage::Severity s)
+{
+    switch (s) {
+    case DiagnosticMessage::Error:   return "\xe2\x9c\x96";
+    case DiagnosticMessage::Warning: return "\xe2\x9a\xa0";
+    case DiagnosticMessage::Note:    return "\xe2\x84\xb9";
+    }
+    return "";
+}
+
+QString ProblemsModel::severityText(DiagnosticMessage::Severity s)
+{
+    switch (s) {
+    case DiagnosticMessage::Error:   return "Error";
+    case DiagnosticMessage::Warning: return "Warning";
+    case DiagnosticMessage::Note:    return "Note";
+    }
+    return "";
+}
+
+QColor ProblemsModel::severityColor(DiagnosticMessage::Severity s)
+{
+    switch (s) {
+    case DiagnosticMessage::Error:   return QColor("#F44747");
+    case DiagnosticMessage::Warning: return QColor("#CCA700");
+    case DiagnosticMessage::Note:    return QColor("#75BEFF");
+    }
+    return QColor("#D4D4D4");
+}
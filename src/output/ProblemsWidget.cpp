@@ -1,9 +1,36 @@
 #include "output/ProblemsWidget.h"
+#include "output/ProblemsModel.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QHeaderView>
-#include <QFileInfo>
+#include <QSortFilterProxyModel>
+#include <QTimer>
+
+namespace {
+
+// Filters top-level rows by severity; children always follow their parent
+class SeverityFilterProxy : public QSortFilterProxyModel {
+public:
+    using QSortFilterProxyModel::QSortFilterProxyModel;
+
+    void setAllowedSeverity(int severity) {
+        m_allowedSeverity = severity;
+        invalidateFilter();
+    }
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override {
+        if (m_allowedSeverity < 0 || sourceParent.isValid()) return true;
+        const QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
+        return index.data(ProblemsModel::SeverityRole).toInt() == m_allowedSeverity;
+    }
+
+private:
+    int m_allowedSeverity = -1;   // -1: show everything
+};
+
+} // namespace
 
 ProblemsWidget::ProblemsWidget(QWidget *parent) : QWidget(parent) { setupUi(); }
 
@@ -29,143 +56,98 @@ void ProblemsWidget::setupUi()
     toolbarLayout->addStretch();
     toolbarLayout->addWidget(m_clearButton);
 
-    m_tableWidget = new QTableWidget(this);
-    m_tableWidget->setColumnCount(5);
-    m_tableWidget->setHorizontalHeaderLabels({"", "Severity", "Message", "File", "Line:Col"});
-    m_tableWidget->horizontalHeader()->setStretchLastSection(false);
-    m_tableWidget->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Fixed);
-    m_tableWidget->horizontalHeader()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
-    m_tableWidget->horizontalHeader()->setSectionResizeMode(2, QHeaderView::Stretch);
-    m_tableWidget->horizontalHeader()->setSectionResizeMode(3, QHeaderView::ResizeToContents);
-    m_tableWidget->horizontalHeader()->setSectionResizeMode(4, QHeaderView::ResizeToContents);
-    m_tableWidget->setColumnWidth(0, 30);
-    m_tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
-    m_tableWidget->setSelectionMode(QAbstractItemView::SingleSelection);
-    m_tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    m_tableWidget->setAlternatingRowColors(true);
+    m_model = new ProblemsModel(this);
+    m_proxy = new SeverityFilterProxy(this);
+    m_proxy->setSourceModel(m_model);
+
+    m_treeView = new QTreeView(this);
+    m_treeView->setModel(m_proxy);
+    m_treeView->setUniformRowHeights(true);   // Keeps huge row counts cheap to lay out
+    m_treeView->setRootIsDecorated(true);
+    m_treeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_treeView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_treeView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_treeView->setAlternatingRowColors(true);
+    m_treeView->header()->setStretchLastSection(false);
+    m_treeView->header()->setSectionResizeMode(ProblemsModel::IconColumn, QHeaderView::Fixed);
+    m_treeView->header()->setSectionResizeMode(ProblemsModel::SeverityColumn, QHeaderView::Interactive);
+    m_treeView->header()->setSectionResizeMode(ProblemsModel::MessageColumn, QHeaderView::Stretch);
+    m_treeView->header()->setSectionResizeMode(ProblemsModel::FileColumn, QHeaderView::Interactive);
+    m_treeView->header()->setSectionResizeMode(ProblemsModel::PositionColumn, QHeaderView::Interactive);
+    m_treeView->setColumnWidth(ProblemsModel::IconColumn, 50);
+
+    m_batchTimer = new QTimer(this);
+    m_batchTimer->setSingleShot(true);
+    m_batchTimer->setInterval(BATCH_INTERVAL_MS);
 
     mainLayout->addWidget(toolbar);
-    mainLayout->addWidget(m_tableWidget);
+    mainLayout->addWidget(m_treeView);
 
     connect(m_filterCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &ProblemsWidget::onFilterChanged);
     connect(m_clearButton, &QPushButton::clicked, this, &ProblemsWidget::clear);
-    connect(m_tableWidget, &QTableWidget::cellClicked, this, &ProblemsWidget::onCellClicked);
+    connect(m_treeView, &QTreeView::clicked, this, &ProblemsWidget::onItemClicked);
+    connect(m_batchTimer, &QTimer::timeout, this, &ProblemsWidget::flushPending);
 }
 
 void ProblemsWidget::setDiagnostics(const QList<DiagnosticMessage>& diagnostics)
 {
-    m_diagnostics = diagnostics;
-    updateTable();
-}
-
-void ProblemsWidget::clear() { m_diagnostics.clear(); updateTable(); }
-
-int ProblemsWidget::errorCount() const
-{
-    int count = 0;
-    for (const auto& d : m_diagnostics)
-        if (d.severity == DiagnosticMessage::Error) ++count;
-    return count;
+    clear();
+    m_model->appendDiagnostics(diagnostics);
 }
 
-int ProblemsWidget::warningCount() const
+void ProblemsWidget::appendDiagnostics(const QList<DiagnosticMessage>& diagnostics)
 {
-    int count = 0;
-    for (const auto& d : m_diagnostics)
-        if (d.severity == DiagnosticMessage::Warning) ++count;
-    return count;
+    if (diagnostics.isEmpty()) return;
+    m_pending += diagnostics;
+    if (!m_batchTimer->isActive()) m_batchTimer->start();
 }
 
-void ProblemsWidget::onFilterChanged(int index)
+void ProblemsWidget::flushPending()
 {
-    m_filterMode = static_cast<FilterMode>(m_filterCombo->itemData(index).toInt());
-    updateTable();
+    if (m_pending.isEmpty()) return;
+    const QList<DiagnosticMessage> batch = m_pending;
+    m_pending.clear();
+    m_model->appendDiagnostics(batch);
 }
 
-void ProblemsWidget::onCellClicked(int row, int column)
+void ProblemsWidget::clear()
 {
-    Q_UNUSED(column);
-    if (row < 0 || row >= m_tableWidget->rowCount()) return;
-
-    QTableWidgetItem* fileItem = m_tableWidget->item(row, 3);
-    QTableWidgetItem* posItem  = m_tableWidget->item(row, 4);
-    if (!fileItem || !posItem) return;
-
-    const QString file = fileItem->toolTip().isEmpty()
-                             ? fileItem->text()
-                             : fileItem->toolTip();
-
-    const QStringList parts = posItem->text().split(':');
-    if (parts.size() == 2) {
-        const int line = parts[0].toInt();
-        const int col  = parts[1].toInt();
-        emit diagnosticClicked(file, line, col);
-    }
+    m_batchTimer->stop();
+    m_pending.clear();
+    m_model->clear();
 }
 
-void ProblemsWidget::updateTable()
+int ProblemsWidget::errorCount() const
 {
-    m_tableWidget->setRowCount(0);
-
-    QList<DiagnosticMessage> filtered;
-    for (const auto& d : m_diagnostics) {
-        if (m_filterMode == All ||
-            (m_filterMode == ErrorsOnly   && d.severity == DiagnosticMessage::Error) ||
-            (m_filterMode == WarningsOnly && d.severity == DiagnosticMessage::Warning))
-            filtered.append(d);
-    }
-
-    m_tableWidget->setRowCount(filtered.size());
-    for (int i = 0; i < filtered.size(); ++i) {
-        const DiagnosticMessage& d = filtered[i];
-
-        QTableWidgetItem* iconItem = new QTableWidgetItem(severityIcon(d.severity));
-        iconItem->setForeground(severityColor(d.severity));
-        iconItem->setTextAlignment(Qt::AlignCenter);
-        m_tableWidget->setItem(i, 0, iconItem);
-
-        QTableWidgetItem* sevItem = new QTableWidgetItem(severityText(d.severity));
-        sevItem->setForeground(severityColor(d.severity));
-        m_tableWidget->setItem(i, 1, sevItem);
-
-        m_tableWidget->setItem(i, 2, new QTableWidgetItem(d.message));
-
-        QTableWidgetItem* fileItem = new QTableWidgetItem(QFileInfo(d.file).fileName());
-        fileItem->setToolTip(d.file);
-        m_tableWidget->setItem(i, 3, fileItem);
-
-        m_tableWidget->setItem(i, 4,
-                               new QTableWidgetItem(QString("%1:%2").arg(d.line).arg(d.column)));
-    }
+    int count = m_model->errorCount();
+    for (const auto& d : m_pending)
+        if (d.severity == DiagnosticMessage::Error) ++count;
+    return count;
 }
 
-QString ProblemsWidget::severityIcon(DiagnosticMessage::Severity s) const
+int ProblemsWidget::warningCount() const
 {
-    switch (s) {
-    case DiagnosticMessage::Error:   return "\xe2\x9c\x96";
-    case DiagnosticMessage::Warning: return "\xe2\x9a\xa0";
-    case DiagnosticMessage::Note:    return "\xe2\x84\xb9";
-    }
-    return "";
+    int count = m_model->warningCount();
+    for (const auto& d : m_pending)
+        if (d.severity == DiagnosticMessage::Warning) ++count;
+    return count;
 }
 
-QString ProblemsWidget::severityText(DiagnosticMessage::Severity s) const
+void ProblemsWidget::onFilterChanged(int index)
 {
-    switch (s) {
-    case DiagnosticMessage::Error:   return "Error";
-    case DiagnosticMessage::Warning: return "Warning";
-    case DiagnosticMessage::Note:    return "Note";
-    }
-    return "";
+    m_filterMode = static_cast<FilterMode>(m_filterCombo->itemData(index).toInt());
+    int severity = -1;
+    if (m_filterMode == ErrorsOnly)   severity = DiagnosticMessage::Error;
+    if (m_filterMode == WarningsOnly) severity = DiagnosticMessage::Warning;
+    static_cast<SeverityFilterProxy*>(m_proxy)->setAllowedSeverity(severity);
 }
 
-QColor ProblemsWidget::severityColor(DiagnosticMessage::Severity s) const
+void ProblemsWidget::onItemClicked(const QModelIndex& index)
 {
-    switch (s) {
-    case DiagnosticMessage::Error:   return QColor("#F44747");
-    case DiagnosticMessage::Warning: return QColor("#CCA700");
-    case DiagnosticMessage::Note:    return QColor("#75BEFF");
-    }
-    return QColor("#D4D4D4");
+    const QModelIndex source = m_proxy->mapToSource(index);
+    const QString file = source.data(ProblemsModel::FilePathRole).toString();
+    const int line = source.data(ProblemsModel::LineRole).toInt();
+    if (file.isEmpty() || line <= 0) return;
+    emit diagnosticClicked(file, line, source.data(ProblemsModel::ColumnRole).toInt());
 }
@@ -0,0 +1,235 @@
+#include "output/RemarksWidget.h"
+#include "ui/ThemeManager.h"
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSortFilterProxyModel>
+#include <QStandardItemModel>
+#include <QTreeView>
+#include <QVBoxLayout>
+
+namespace {
+
+// Filters rows by remark kind and by text in message, pass or function
+class RemarksFilterProxy : public QSortFilterProxyModel {
+public:
+    using QSortFilterProxyModel::QSortFilterProxyModel;
+
+    void setAllowedKind(int kind) {
+        m_allowedKind = kind;
+        invalidateFilter();
+    }
+
+    void setText(const QString& text) {
+        m_text = text.trimmed();
+        invalidateFilter();
+    }
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override {
+        const QAbstractItemModel* model = sourceModel();
+        if (m_allowedKind >= 0
+            && model->index(sourceRow, RemarksWidget::KindColumn, sourceParent)
+                   .data(RemarksWidget::KindRole).toInt() != m_allowedKind) {
+            return false;
+        }
+        if (m_text.isEmpty()) return true;
+        for (int column : { int(RemarksWidget::MessageColumn), int(RemarksWidget::PassColumn),
+                            int(RemarksWidget::FunctionColumn) }) {
+            if (model->index(sourceRow, column, sourceParent).data().toString()
+                    .contains(m_text, Qt::CaseInsensitive)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Positions sort by line, then column
+    bool lessThan(const QModelIndex& left, const QModelIndex& right) const override {
+        if (left.column() != RemarksWidget::PositionColumn) {
+            return QSortFilterProxyModel::lessThan(left, right);
+        }
+        const int leftLine  = left.data(RemarksWidget::LineRole).toInt();
+        const int rightLine = right.data(RemarksWidget::LineRole).toInt();
+        if (leftLine != rightLine) return leftLine < rightLine;
+        return left.data(RemarksWidget::ColumnRole).toInt()
+             < right.data(RemarksWidget::ColumnRole).toInt();
+    }
+
+private:
+    int     m_allowedKind = -1;   // -1: show everything
+    QString m_text;
+};
+
+} // namespace
+
+RemarksWidget::RemarksWidget(QWidget* parent) : QWidget(parent) { setupUi(); }
+
+void RemarksWidget::setupUi()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+
+    QWidget* toolbar = new QWidget(this);
+    QHBoxLayout* toolbarLayout = new QHBoxLayout(toolbar);
+    toolbarLayout->setContentsMargins(5, 5, 5, 5);
+
+    // Remarks only exist with optimization on, so there is no O0
+    m_optCombo = new QComboBox(toolbar);
+    m_optCombo->addItems({ "O1", "O2", "O3", "Os" });
+    m_optCombo->setCurrentText(QStringLiteral("O2"));
+
+    m_kindCombo = new QComboBox(toolbar);
+    m_kindCombo->addItem("All",       -1);
+    m_kindCombo->addItem("Optimized", int(OptRemark::Kind::Passed));
+    m_kindCombo->addItem("Missed",    int(OptRemark::Kind::Missed));
+    m_kindCombo->addItem("Analysis",  int(OptRemark::Kind::Analysis));
+
+    m_filterEdit = new QLineEdit(toolbar);
+    m_filterEdit->setPlaceholderText(QStringLiteral("Filter remarks…"));
+    m_filterEdit->setClearButtonEnabled(true);
+
+    m_statusLabel = new QLabel(toolbar);
+    m_runButton   = new QPushButton(QStringLiteral("▶  Collect Remarks"), toolbar);
+    m_runButton->setToolTip(
+        QStringLiteral("Compile the active file with optimization remarks enabled"));
+    m_clearButton = new QPushButton("Clear", toolbar);
+
+    toolbarLayout->addWidget(new QLabel("Opt:", toolbar));
+    toolbarLayout->addWidget(m_optCombo);
+    toolbarLayout->addWidget(new QLabel("Show:", toolbar));
+    toolbarLayout->addWidget(m_kindCombo);
+    toolbarLayout->addWidget(m_filterEdit, 1);
+    toolbarLayout->addWidget(m_statusLabel);
+    toolbarLayout->addWidget(m_runButton);
+    toolbarLayout->addWidget(m_clearButton);
+
+    m_model = new QStandardItemModel(0, ColumnCount, this);
+    m_model->setHorizontalHeaderLabels({ "Kind", "Pass", "Message", "Function", "Line" });
+    m_proxy = new RemarksFilterProxy(this);
+    m_proxy->setSourceModel(m_model);
+
+    m_treeView = new QTreeView(this);
+    m_treeView->setModel(m_proxy);
+    m_treeView->setUniformRowHeights(true);
+    m_treeView->setRootIsDecorated(false);
+    m_treeView->setSortingEnabled(true);
+    m_treeView->sortByColumn(PositionColumn, Qt::AscendingOrder);
+    m_treeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_treeView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_treeView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_treeView->setAlternatingRowColors(true);
+    m_treeView->header()->setStretchLastSection(false);
+    m_treeView->header()->setSectionResizeMode(MessageColumn, QHeaderView::Stretch);
+    m_treeView->setColumnWidth(KindColumn, 90);
+    m_treeView->setColumnWidth(PassColumn, 110);
+    m_treeView->setColumnWidth(FunctionColumn, 180);
+
+    mainLayout->addWidget(toolbar);
+    mainLayout->addWidget(m_treeView);
+
+    connect(m_kindCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &RemarksWidget::onKindFilterChanged);
+    connect(m_filterEdit, &QLineEdit::textChanged, this, &RemarksWidget::onTextFilterChanged);
+    connect(m_runButton, &QPushButton::clicked, this, &RemarksWidget::runRequested);
+    connect(m_clearButton, &QPushButton::clicked, this, [this]() {
+        clear();
+        emit cleared();
+    });
+    connect(m_treeView, &QTreeView::clicked, this, &RemarksWidget::onItemClicked);
+
+    updateSummary();
+}
+
+void RemarksWidget::setRemarks(const QList<OptRemark>& remarks)
+{
+    const Theme& theme = ThemeManager::instance()->currentTheme();
+
+    m_treeView->setSortingEnabled(false);   // One sort after the bulk insert
+    m_model->removeRows(0, m_model->rowCount());
+    for (const OptRemark& remark : remarks) {
+        auto* kind = new QStandardItem(OptRemark::kindText(remark.kind));
+        kind->setData(int(remark.kind), KindRole);
+        kind->setForeground(remark.kind == OptRemark::Kind::Passed ? theme.success
+                            : remark.kind == OptRemark::Kind::Missed ? theme.warning
+                                                                     : theme.textSecondary);
+
+        auto* position = new QStandardItem(remark.line > 0
+            ? QStringLiteral("%1:%2").arg(remark.line).arg(remark.column) : QString());
+        position->setData(remark.file, FileRole);
+        position->setData(remark.line, LineRole);
+        position->setData(remark.column, ColumnRole);
+
+        auto* message = new QStandardItem(remark.message);
+        message->setToolTip(remark.message);
+
+        m_model->appendRow({ kind, new QStandardItem(remark.pass), message,
+                             new QStandardItem(remark.function), position });
+    }
+    m_treeView->setSortingEnabled(true);
+    updateSummary();
+}
+
+void RemarksWidget::clear()
+{
+    m_model->removeRows(0, m_model->rowCount());
+    updateSummary();
+}
+
+void RemarksWidget::setRunning(bool running)
+{
+    m_runButton->setEnabled(!running);
+    if (running) m_statusLabel->setText(QStringLiteral("Compiling…"));
+}
+
+void RemarksWidget::setStatusText(const QString& text)
+{
+    m_statusLabel->setText(text);
+}
+
+QString RemarksWidget::optimizationFlag() const
+{
+    return QStringLiteral("-") + m_optCombo->currentText();
+}
+
+int RemarksWidget::remarkCount() const
+{
+    return m_model->rowCount();
+}
+
+void RemarksWidget::updateSummary()
+{
+    int passed = 0, missed = 0, analysis = 0;
+    for (int row = 0; row < m_model->rowCount(); ++row) {
+        switch (OptRemark::Kind(m_model->item(row, KindColumn)->data(KindRole).toInt())) {
+        case OptRemark::Kind::Passed:   ++passed;   break;
+        case OptRemark::Kind::Missed:   ++missed;   break;
+        case OptRemark::Kind::Analysis: ++analysis; break;
+        }
+    }
+    m_statusLabel->setText(QStringLiteral("%1 optimized, %2 missed, %3 analysis")
+                               .arg(passed).arg(missed).arg(analysis));
+}
+
+void RemarksWidget::onKindFilterChanged(int index)
+{
+    static_cast<RemarksFilterProxy*>(m_proxy)->setAllowedKind(m_kindCombo->itemData(index).toInt());
+}
+
+void RemarksWidget::onTextFilterChanged(const QString& text)
+{
+    static_cast<RemarksFilterProxy*>(m_proxy)->setText(text);
+}
+
+void RemarksWidget::onItemClicked(const QModelIndex& index)
+{
+    const QModelIndex source = m_proxy->mapToSource(index);
+    const QModelIndex position = source.sibling(source.row(), PositionColumn);
+    const int line = position.data(LineRole).toInt();
+    if (line <= 0) return;
+    emit remarkClicked(position.data(FileRole).toString(), line,
+                       position.data(ColumnRole).toInt());
+}
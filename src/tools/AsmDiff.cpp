@@ -0,0 +1,213 @@
+#include "tools/AsmDiff.h"
+
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QUuid>
+
+#include <algorithm>
+
+namespace {
+
+constexpr int PROCESS_TIMEOUT_MS = 30000;
+
+/**
+ * Myers' greedy O(ND) diff.  On return keepA[i] / keepB[j] are true for
+ * elements on the longest common subsequence.  Gives up (everything
+ * changed) once the edit distance exceeds @p maxEdits.
+ */
+void myersDiff(const QVector<int>& a, const QVector<int>& b, int maxEdits,
+               QVector<bool>& keepA, QVector<bool>& keepB)
+{
+    const int n = a.size();
+    const int m = b.size();
+    keepA.fill(false, n);
+    keepB.fill(false, m);
+
+    const int max    = n + m;
+    const int offset = max + 1;
+    QVector<int> v(2 * max + 3, 0);
+    // trace[d] = v[-d-1 .. d+1] before step d; O(D²) memory instead of O(D·(N+M))
+    QVector<QVector<int>> trace;
+
+    bool done = false;
+    for (int d = 0; d <= max && d <= maxEdits && !done; ++d) {
+        trace.append(v.mid(offset - d - 1, 2 * d + 3));
+        for (int k = -d; k <= d; k += 2) {
+            int x = (k == -d || (k != d && v[offset + k - 1] < v[offset + k + 1]))
+                ? v[offset + k + 1]          // Step down: insertion from b
+                : v[offset + k - 1] + 1;     // Step right: deletion from a
+            int y = x - k;
+            while (x < n && y < m && a[x] == b[y]) { ++x; ++y; }
+            v[offset + k] = x;
+            if (x >= n && y >= m) { done = true; break; }
+        }
+    }
+    if (!done) return;
+
+    // Walk the trace backwards, marking the diagonal (matching) runs
+    int x = n;
+    int y = m;
+    for (int d = trace.size() - 1; d >= 0; --d) {
+        const QVector<int>& prev = trace[d];
+        const int base = d + 1;   // prev[base + k] == v[offset + k]
+        const int k = x - y;
+        const int prevK = (k == -d || (k != d && prev[base + k - 1] < prev[base + k + 1]))
+            ? k + 1 : k - 1;
+        const int prevX = prev[base + prevK];
+        const int prevY = prevX - prevK;
+        while (x > prevX && y > prevY) {
+            keepA[--x] = true;
+            keepB[--y] = true;
+        }
+        if (d > 0) { x = prevX; y = prevY; }
+    }
+}
+
+QHash<QString, int> functionIndexBySymbol(const AsmDocument& doc) {
+    QHash<QString, int> index;
+    for (int i = 0; i < doc.functions.size(); ++i) {
+        index.insert(doc.functions[i].symbol, i);
+    }
+    return index;
+}
+
+QVector<int> instructionLines(const AsmDocument& doc, int function) {
+    QVector<int> lines;
+    if (function < 0) return lines;
+    const AsmFunction& f = doc.functions[function];
+    for (int i = f.firstLine; i <= f.lastLine && i < doc.lines.size(); ++i) {
+        if (doc.lines[i].kind == AsmLine::Kind::Instruction) lines.append(i);
+    }
+    return lines;
+}
+
+} // namespace
+
+QString AsmDiff::normalize(const QString& line) {
+    static const QRegularExpression localLabel(
+        QStringLiteral(R"((?<![\w.$])(?:\.L\w*|L(?:BB|tmp)\w*|\$LN\d+))"));
+    QString text = line.simplified();
+    text.replace(localLabel, QStringLiteral(".L"));
+    return text;
+}
+
+AsmDiffResult AsmDiff::compare(const AsmDocument& left, const AsmDocument& right) {
+    AsmDiffResult result;
+
+    const QHash<QString, int> rightIndex = functionIndexBySymbol(right);
+    QHash<QString, int> tokens;   // Normalised instruction → id, shared by both sides
+    auto tokenize = [&tokens](const AsmDocument& doc, const QVector<int>& lines) {
+        QVector<int> ids;
+        ids.reserve(lines.size());
+        for (int line : lines) {
+            const QString key = normalize(doc.lines[line].text);
+            auto it = tokens.constFind(key);
+            if (it == tokens.constEnd()) it = tokens.insert(key, tokens.size());
+            ids.append(it.value());
+        }
+        return ids;
+    };
+
+    auto addPair = [&](int leftFn, int rightFn) {
+        const AsmFunction& f = leftFn >= 0 ? left.functions[leftFn] : right.functions[rightFn];
+        AsmFunctionDelta delta;
+        delta.symbol = f.symbol;
+        delta.name   = f.name;
+
+        const QVector<int> leftLines  = instructionLines(left, leftFn);
+        const QVector<int> rightLines = instructionLines(right, rightFn);
+        if (leftFn >= 0)  delta.leftInstructions  = leftLines.size();
+        if (rightFn >= 0) delta.rightInstructions = rightLines.size();
+
+        QVector<bool> keepLeft;
+        QVector<bool> keepRight;
+        myersDiff(tokenize(left, leftLines), tokenize(right, rightLines),
+                  MAX_EDIT_DISTANCE, keepLeft, keepRight);
+
+        for (int i = 0; i < leftLines.size(); ++i) {
+            if (!keepLeft[i]) { result.removedLines.append(leftLines[i]); ++delta.removed; }
+        }
+        for (int j = 0; j < rightLines.size(); ++j) {
+            if (!keepRight[j]) { result.addedLines.append(rightLines[j]); ++delta.added; }
+        }
+        result.functions.append(delta);
+    };
+
+    QHash<QString, bool> matched;
+    for (int i = 0; i < left.functions.size(); ++i) {
+        const int r = rightIndex.value(left.functions[i].symbol, -1);
+        if (r >= 0) matched.insert(left.functions[i].symbol, true);
+        addPair(i, r);
+    }
+    for (int j = 0; j < right.functions.size(); ++j) {
+        if (!matched.contains(right.functions[j].symbol)) addPair(-1, j);
+    }
+
+    std::sort(result.removedLines.begin(), result.removedLines.end());
+    std::sort(result.addedLines.begin(), result.addedLines.end());
+    return result;
+}
+
+void AsmDiff::applySizes(AsmDiffResult& result,
+                         const QHash<QString, qint64>& leftSizes,
+                         const QHash<QString, qint64>& rightSizes) {
+    for (AsmFunctionDelta& delta : result.functions) {
+        if (delta.leftInstructions >= 0) {
+            delta.leftBytes = leftSizes.value(delta.symbol, -1);
+        }
+        if (delta.rightInstructions >= 0) {
+            delta.rightBytes = rightSizes.value(delta.symbol, -1);
+        }
+    }
+}
+
+QHash<QString, qint64> AsmDiff::parseNmSizes(const QByteArray& nmOutput) {
+    // "0000000000000000 000000000000002a T _Z6squarei"; undefined and
+    // size-less symbols have fewer fields and are skipped
+    QHash<QString, qint64> sizes;
+    for (const QByteArray& rawLine : nmOutput.split('\n')) {
+        const QList<QByteArray> fields = rawLine.simplified().split(' ');
+        if (fields.size() < 4) continue;
+        bool ok = false;
+        const qint64 size = fields[1].toLongLong(&ok, 16);
+        if (!ok) continue;
+        const QChar type = QLatin1Char(fields[2].isEmpty() ? ' ' : fields[2].at(0));
+        if (type.toLower() != QLatin1Char('t') && type != QLatin1Char('W')) continue;
+        sizes.insert(QString::fromUtf8(fields[3]), size);
+    }
+    return sizes;
+}
+
+QHash<QString, qint64> AsmDiff::measureFunctionSizes(const QString& compilerPath,
+                                                     const QByteArray& assembly) {
+    QString nm = QStandardPaths::findExecutable(QStringLiteral("nm"));
+    if (nm.isEmpty()) nm = QStandardPaths::findExecutable(QStringLiteral("llvm-nm"));
+    if (nm.isEmpty() || compilerPath.isEmpty() || assembly.isEmpty()) return {};
+
+    const QString uuid = QUuid::createUuid().toString().remove('{').remove('}').remove('-');
+    const QString objPath = QDir::tempPath() + QStringLiteral("/cppatlas_asmdiff_")
+        + uuid + QStringLiteral(".o");
+
+    QProcess as;
+    as.start(compilerPath, { QStringLiteral("-c"), QStringLiteral("-x"),
+                             QStringLiteral("assembler"), QStringLiteral("-"),
+                             QStringLiteral("-o"), objPath });
+    as.write(assembly);
+    as.closeWriteChannel();
+    if (!as.waitForFinished(PROCESS_TIMEOUT_MS) || as.exitStatus() != QProcess::NormalExit
+        || as.exitCode() != 0) {
+        as.kill();
+        QFile::remove(objPath);
+        return {};
+    }
+
+    QProcess sizes;
+    sizes.start(nm, { QStringLiteral("-S"), QStringLiteral("--defined-only"), objPath });
+    const bool ok = sizes.waitForFinished(PROCESS_TIMEOUT_MS)
+        && sizes.exitStatus() == QProcess::NormalExit && sizes.exitCode() == 0;
+    QFile::remove(objPath);
+    return ok ? parseNmSizes(sizes.readAllStandardOutput()) : QHash<QString, qint64>();
+}
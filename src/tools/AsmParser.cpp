@@ -0,0 +1,611 @@
+#include "tools/AsmParser.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QProcess>
+#include <QSet>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#if defined(__has_include)
+#  if __has_include(<cxxabi.h>)
+#    include <cxxabi.h>
+#    include <cstdlib>
+#    define CPPATLAS_HAS_CXXABI 1
+#  endif
+#endif
+
+namespace {
+
+enum class RecordKind : quint8 {
+    Instruction,
+    Label,
+    Directive,
+    DataDirective,   // .quad/.string/... — kept after a used label even with directives filtered
+    Comment
+};
+
+// One non-blank input line.  Offsets index the raw text; nothing is copied
+// except label and .size symbol names.
+struct Record {
+    int begin = 0;              // Trimmed line [begin, end)
+    int end   = 0;
+    int labelEnd = 0;           // Labels: one past the ':'
+    RecordKind kind = RecordKind::Instruction;
+    bool hidden = false;        // Inside a debug/unwind/note section (isHiddenSection)
+    bool endsFunction = false;  // .cfi_endproc
+    bool startsFunction = false;
+    int fileNumber = -1;        // .loc state for instructions
+    int sourceLine = 0;
+    int function = -1;          // Assigned after the scan
+    QByteArray symbol;          // Label name, or the symbol of a .size directive
+};
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v'; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+inline bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+inline bool isIdChar(char c) { return isAlpha(c) || isDigit(c) || c == '_' || c == '.' || c == '$'; }
+
+inline bool equals(const char* data, int b, int e, const char* literal) {
+    const int len = int(std::strlen(literal));
+    return e - b == len && std::memcmp(data + b, literal, size_t(len)) == 0;
+}
+
+inline bool startsWith(const char* data, int b, int e, const char* literal) {
+    const int len = int(std::strlen(literal));
+    return e - b >= len && std::memcmp(data + b, literal, size_t(len)) == 0;
+}
+
+inline int skipSpaces(const char* data, int i, int e) {
+    while (i < e && isSpace(data[i])) ++i;
+    return i;
+}
+
+int parseInt(const char* data, int& i, int e) {
+    int value = 0;
+    bool any = false;
+    while (i < e && isDigit(data[i])) {
+        value = value * 10 + (data[i] - '0');
+        ++i;
+        any = true;
+    }
+    return any ? value : -1;
+}
+
+// Reads a "quoted" string at i (handles \" and \\ escapes)
+bool parseQuoted(const char* data, int& i, int e, QByteArray* out) {
+    i = skipSpaces(data, i, e);
+    if (i >= e || data[i] != '"') return false;
+    ++i;
+    out->clear();
+    while (i < e && data[i] != '"') {
+        if (data[i] == '\\' && i + 1 < e) ++i;
+        out->append(data[i]);
+        ++i;
+    }
+    if (i < e) ++i;   // Closing quote
+    return true;
+}
+
+// Symbol operand of .type/.globl/.size: up to ',' or whitespace
+QByteArray parseSymbol(const char* data, int i, int e) {
+    i = skipSpaces(data, i, e);
+    if (i < e && data[i] == '"') {
+        QByteArray quoted;
+        parseQuoted(data, i, e, &quoted);
+        return quoted;
+    }
+    const int start = i;
+    while (i < e && data[i] != ',' && !isSpace(data[i])) ++i;
+    return QByteArray(data + start, i - start);
+}
+
+bool isCommentStart(const char* data, int i, int e) {
+    const char c = data[i];
+    return c == '#' || c == ';' || c == '@' || (c == '/' && i + 1 < e && data[i + 1] == '/');
+}
+
+// Debug info, unwind and exception tables, notes: never interesting to read,
+// and their label references must not keep code labels alive
+bool isHiddenSection(const char* data, int i, int e) {
+    static const char* const prefixes[] = {
+        ".debug", ".zdebug", "__DWARF", ".gcc_except_table", ".eh_frame", ".note", ".comment",
+        ".llvm_addrsig", "__LD", "__TEXT,__eh_frame", "__TEXT,__gcc_except_tab",
+    };
+    i = skipSpaces(data, i, e);
+    for (const char* prefix : prefixes) {
+        if (startsWith(data, i, e, prefix)) return true;
+    }
+    return false;
+}
+
+bool isDataDirective(const char* data, int b, int e) {
+    static const char* const names[] = {
+        ".ascii", ".asciz", ".string", ".byte", ".short", ".hword", ".word", ".long", ".int",
+        ".quad", ".octa", ".xword", ".dword", ".2byte", ".4byte", ".8byte", ".value",
+        ".zero", ".skip", ".space", ".float", ".single", ".double", ".uleb128", ".sleb128",
+    };
+    for (const char* name : names) {
+        if (equals(data, b, e, name)) return true;
+    }
+    return false;
+}
+
+// Labels the compiler made up (.L*, L*, l*, numeric) as opposed to real symbols
+bool isLocalLabel(const QByteArray& name) {
+    if (name.isEmpty()) return true;
+    const char c = name.at(0);
+    return c == '.' || c == 'L' || c == 'l' || isDigit(c);
+}
+
+// Adds every identifier in operands [i, e) to @p used; "1f"/"1b" count as "1"
+void collectReferences(const char* data, int i, int e, QSet<QByteArray>* used) {
+    while (i < e) {
+        const char c = data[i];
+        if (c == '%') {                       // AT&T register
+            ++i;
+            while (i < e && isIdChar(data[i])) ++i;
+        } else if (isDigit(c)) {
+            const int start = i;
+            while (i < e && isDigit(data[i])) ++i;
+            if (i < e && (data[i] == 'f' || data[i] == 'b') && (i + 1 >= e || !isIdChar(data[i + 1]))) {
+                used->insert(QByteArray(data + start, i - start));
+            }
+            while (i < e && isIdChar(data[i])) ++i;
+        } else if (isAlpha(c) || c == '_' || c == '.') {
+            const int start = i;
+            while (i < e && isIdChar(data[i])) ++i;
+            used->insert(QByteArray(data + start, i - start));
+        } else if (c == '"') {
+            QByteArray quoted;
+            parseQuoted(data, i, e, &quoted);
+            used->insert(quoted);
+        } else if (c == '#' && i + 1 < e && isSpace(data[i + 1])) {
+            break;                           // Trailing x86 comment
+        } else {
+            ++i;
+        }
+    }
+}
+
+inline bool isDemangleChar(char c) { return isAlpha(c) || isDigit(c) || c == '_' || c == '.'; }
+
+// Calls @p fn(start, end) for every Itanium-mangled token in [b, e)
+template <typename Fn>
+void forEachMangled(const char* data, int b, int e, Fn fn) {
+    int i = b;
+    while (i < e) {
+        if (data[i] == '_' && (i == b || !isDemangleChar(data[i - 1]))
+            && ((i + 1 < e && data[i + 1] == 'Z')
+                || (i + 2 < e && data[i + 1] == '_' && data[i + 2] == 'Z'))) {
+            const int start = i;
+            while (i < e && isDemangleChar(data[i])) ++i;
+            fn(start, i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+#ifdef CPPATLAS_HAS_CXXABI
+QString demangleOne(const QByteArray& symbol) {
+    // Mach-O adds a leading underscore to every symbol
+    const QByteArray itanium = symbol.startsWith("__Z") ? symbol.mid(1) : symbol;
+    int status = 0;
+    char* out = abi::__cxa_demangle(itanium.constData(), nullptr, nullptr, &status);
+    if (status == 0 && out) {
+        const QString result = QString::fromUtf8(out);
+        std::free(out);
+        return result;
+    }
+    std::free(out);
+    return QString::fromUtf8(symbol);
+}
+#endif
+
+} // namespace
+
+// static
+bool AsmParser::isMangled(const QByteArray& symbol) {
+    return symbol.startsWith("_Z") || symbol.startsWith("__Z");
+}
+
+// static
+QStringList AsmParser::demangle(const QStringList& symbols) {
+    QStringList result;
+    result.reserve(symbols.size());
+#ifdef CPPATLAS_HAS_CXXABI
+    for (const QString& symbol : symbols) {
+        result << demangleOne(symbol.toUtf8());
+    }
+#else
+    // No C++ ABI runtime (MSVC build): one c++filt process for the batch
+    QStringList input;
+    for (const QString& symbol : symbols) {
+        input << (symbol.startsWith(QLatin1String("__Z")) ? symbol.mid(1) : symbol);
+    }
+    QProcess filt;
+    filt.start(QStringLiteral("c++filt"), QStringList());
+    if (filt.waitForStarted(2000)) {
+        filt.write((input.join(QLatin1Char('\n')) + QLatin1Char('\n')).toUtf8());
+        filt.closeWriteChannel();
+        if (filt.waitForFinished(5000)) {
+            const QStringList lines = QString::fromUtf8(filt.readAllStandardOutput())
+                                          .split(QLatin1Char('\n'));
+            if (lines.size() >= symbols.size()) {
+                for (int i = 0; i < symbols.size(); ++i) {
+                    result << (lines[i] == input[i] ? symbols[i] : lines[i]);
+                }
+                return result;
+            }
+        }
+    }
+    result = symbols;
+#endif
+    return result;
+}
+
+// static
+AsmDocument AsmParser::parse(const QByteArray& assembly, const AsmFilterOptions& options,
+                             const QString& mainSourcePath) {
+    AsmDocument doc;
+    const char* data = assembly.constData();
+    const int size = int(assembly.size());
+
+    QVector<Record> records;
+    records.reserve(size / 24);
+
+    QSet<QByteArray> functionSymbols;   // .type X, @function
+    QSet<QByteArray> globals;           // .globl X
+    QSet<QByteArray> used;              // Referenced from code or data
+    QHash<int, int>  fileIndex;         // .file number → doc.files index
+    QString mainName = QFileInfo(mainSourcePath).fileName();
+    bool mainNameFromListing = false;
+
+    bool hidden = false;
+    bool previousHidden = false;
+    QVector<bool> sectionStack;
+    int locFile = -1;
+    int locLine = 0;
+
+    // ── Scan: one pass over the raw text ────────────────────────────────────
+    int pos = 0;
+    while (pos < size) {
+        const char* nl = static_cast<const char*>(std::memchr(data + pos, '\n', size_t(size - pos)));
+        const int eol = nl ? int(nl - data) : size;
+        int b = pos;
+        int e = eol;
+        pos = eol + 1;
+        ++doc.rawLineCount;
+
+        b = skipSpaces(data, b, e);
+        while (e > b && isSpace(data[e - 1])) --e;
+        if (b == e) continue;
+
+        Record r;
+        r.begin = b;
+        r.end   = e;
+        r.hidden = hidden;
+
+        if (isCommentStart(data, b, e)) {
+            r.kind = RecordKind::Comment;
+            records.append(r);
+            continue;
+        }
+
+        // Label?  name: / "quoted name":
+        int i = b;
+        if (data[i] == '"') {
+            QByteArray quoted;
+            parseQuoted(data, i, e, &quoted);
+            if (i < e && data[i] == ':') {
+                r.kind = RecordKind::Label;
+                r.symbol = quoted;
+                r.labelEnd = i + 1;
+            }
+        } else {
+            while (i < e && isIdChar(data[i])) ++i;
+            if (i > b && i < e && data[i] == ':') {
+                r.kind = RecordKind::Label;
+                r.symbol = QByteArray(data + b, i - b);
+                r.labelEnd = i + 1;
+            }
+        }
+        if (r.kind == RecordKind::Label) {
+            if (!isLocalLabel(r.symbol)) {
+                locFile = -1;   // New symbol: don't inherit the previous function's .loc
+                locLine = 0;
+            }
+            records.append(r);
+            continue;
+        }
+
+        if (data[b] == '.') {
+            int nameEnd = b;
+            while (nameEnd < e && !isSpace(data[nameEnd])) ++nameEnd;
+            const int args = skipSpaces(data, nameEnd, e);
+            r.kind = RecordKind::Directive;
+
+            if (equals(data, b, nameEnd, ".loc")) {
+                int j = args;
+                const int file = parseInt(data, j, e);
+                j = skipSpaces(data, j, e);
+                const int line = parseInt(data, j, e);
+                if (file >= 0 && line >= 0) {
+                    locFile = file;
+                    locLine = line;
+                }
+            } else if (equals(data, b, nameEnd, ".file")) {
+                int j = args;
+                const int number = parseInt(data, j, e);
+                QByteArray first;
+                QByteArray second;
+                if (parseQuoted(data, j, e, &first)) {
+                    const bool hasSecond = parseQuoted(data, j, e, &second);
+                    if (number < 0) {
+                        mainName = QFileInfo(QString::fromUtf8(first)).fileName();
+                        mainNameFromListing = true;
+                    } else if (!fileIndex.contains(number)) {
+                        AsmSourceFile f;
+                        f.number = number;
+                        f.path = QString::fromUtf8(first);
+                        if (hasSecond) {
+                            const QString name = QString::fromUtf8(second);
+                            f.path = (name.startsWith(QLatin1Char('/')) || f.path.isEmpty())
+                                ? name : f.path + QLatin1Char('/') + name;
+                        }
+                        fileIndex.insert(number, doc.files.size());
+                        doc.files.append(f);
+                    }
+                }
+            } else if (equals(data, b, nameEnd, ".type")) {
+                const QByteArray symbol = parseSymbol(data, args, e);
+                const QByteArray rest(data + args, e - args);
+                if (rest.contains("function") || rest.contains("STT_FUNC")) {
+                    functionSymbols.insert(symbol);
+                }
+            } else if (equals(data, b, nameEnd, ".globl") || equals(data, b, nameEnd, ".global")) {
+                globals.insert(parseSymbol(data, args, e));
+            } else if (equals(data, b, nameEnd, ".size")) {
+                r.symbol = parseSymbol(data, args, e);
+            } else if (equals(data, b, nameEnd, ".cfi_endproc")) {
+                r.endsFunction = true;
+            } else if (equals(data, b, nameEnd, ".section")) {
+                previousHidden = hidden;
+                hidden = isHiddenSection(data, args, e);
+            } else if (equals(data, b, nameEnd, ".pushsection")) {
+                sectionStack.append(hidden);
+                previousHidden = hidden;
+                hidden = isHiddenSection(data, args, e);
+            } else if (equals(data, b, nameEnd, ".popsection")) {
+                if (!sectionStack.isEmpty()) {
+                    hidden = sectionStack.last();
+                    sectionStack.removeLast();
+                }
+            } else if (equals(data, b, nameEnd, ".previous")) {
+                std::swap(hidden, previousHidden);
+            } else if (equals(data, b, nameEnd, ".text") || equals(data, b, nameEnd, ".data")
+                       || equals(data, b, nameEnd, ".bss")) {
+                previousHidden = hidden;
+                hidden = false;
+            } else if (isDataDirective(data, b, nameEnd)) {
+                r.kind = RecordKind::DataDirective;
+                if (!hidden) collectReferences(data, args, e, &used);
+            }
+            records.append(r);
+            continue;
+        }
+
+        // Instruction: mnemonic, then operands
+        r.kind = RecordKind::Instruction;
+        r.fileNumber = locFile;
+        r.sourceLine = locLine;
+        int operands = b;
+        while (operands < e && !isSpace(data[operands])) ++operands;
+        collectReferences(data, operands, e, &used);
+        records.append(r);
+    }
+
+    // ── Files: which .file entries are the translation unit itself ─────────
+    bool anyMain = false;
+    for (AsmSourceFile& f : doc.files) {
+        f.isMain = !mainName.isEmpty() && QFileInfo(f.path).fileName() == mainName;
+        anyMain = anyMain || f.isMain;
+    }
+    if (!anyMain && !doc.files.isEmpty() && !mainNameFromListing) {
+        // No name to go by: DWARF 5 puts the CU in file 0, DWARF 4 in file 1
+        const int main = fileIndex.contains(0) ? 0 : 1;
+        if (fileIndex.contains(main)) doc.files[fileIndex.value(main)].isMain = true;
+    }
+
+    // ── Functions: boundaries and library detection ─────────────────────────
+    struct FunctionInfo {
+        QByteArray symbol;
+        bool hasMainLoc  = false;
+        bool hasOtherLoc = false;
+        bool library     = false;
+        int  outputIndex = -1;
+    };
+    QVector<FunctionInfo> functions;
+    const bool typed = !functionSymbols.isEmpty();
+    int current = -1;
+    for (Record& r : records) {
+        if (r.hidden) continue;
+        if (r.kind == RecordKind::Label
+            && (typed ? functionSymbols.contains(r.symbol)
+                      : (globals.contains(r.symbol) || !isLocalLabel(r.symbol)))) {
+            FunctionInfo info;
+            info.symbol = r.symbol;
+            current = functions.size();
+            functions.append(info);
+            r.startsFunction = true;
+        }
+        r.function = current;
+        if (current < 0) continue;
+
+        if (r.kind == RecordKind::Instruction && r.fileNumber >= 0 && r.sourceLine > 0) {
+            const int idx = fileIndex.value(r.fileNumber, -1);
+            const bool main = idx >= 0 && doc.files[idx].isMain;
+            functions[current].hasMainLoc  = functions[current].hasMainLoc || main;
+            functions[current].hasOtherLoc = functions[current].hasOtherLoc || !main;
+        }
+        if (r.endsFunction
+            || (!r.symbol.isEmpty() && r.kind == RecordKind::Directive
+                && r.symbol == functions[current].symbol)) {
+            current = -1;
+        }
+    }
+    for (FunctionInfo& f : functions) {
+        f.library = !f.hasMainLoc && f.hasOtherLoc;
+    }
+
+    // ── Filter: decide which records survive ────────────────────────────────
+    QVector<int> kept;
+    kept.reserve(records.size() / 2);
+    bool dataLabelKept = false;
+    for (int idx = 0; idx < records.size(); ++idx) {
+        const Record& r = records[idx];
+        if (options.directives && r.hidden) continue;
+        if (options.libraryFunctions && r.function >= 0 && functions[r.function].library) continue;
+
+        switch (r.kind) {
+        case RecordKind::Comment:
+            if (options.comments) continue;
+            break;
+        case RecordKind::Label: {
+            const bool keep = !options.unusedLabels || r.startsFunction
+                || used.contains(r.symbol) || globals.contains(r.symbol);
+            dataLabelKept = keep && !r.startsFunction;
+            if (!keep) continue;
+            break;
+        }
+        case RecordKind::Directive:
+            if (options.directives) continue;
+            break;
+        case RecordKind::DataDirective:
+            if (options.directives && !dataLabelKept) continue;
+            break;
+        case RecordKind::Instruction:
+            dataLabelKept = false;
+            break;
+        }
+        kept.append(idx);
+    }
+
+    // ── Demangle every symbol that survived, in one batch ───────────────────
+    QHash<QByteArray, QString> demangled;
+    if (options.demangle) {
+        QStringList pending;
+        auto want = [&](const QByteArray& symbol) {
+            if (!demangled.contains(symbol)) {
+                demangled.insert(symbol, QString());
+                pending << QString::fromUtf8(symbol);
+            }
+        };
+        for (int idx : kept) {
+            const Record& r = records[idx];
+            if (r.kind == RecordKind::Comment) continue;
+            forEachMangled(data, r.begin, r.end, [&](int s, int t) {
+                want(QByteArray(data + s, t - s));
+            });
+        }
+        for (const FunctionInfo& f : functions) {
+            if (isMangled(f.symbol)) want(f.symbol);
+        }
+        const QStringList names = demangle(pending);
+        for (int i = 0; i < pending.size(); ++i) {
+            demangled.insert(pending[i].toUtf8(), names.value(i, pending[i]));
+        }
+    }
+
+    auto lineText = [&](int b, int e) {
+        if (demangled.isEmpty()) return QString::fromUtf8(data + b, e - b);
+        QString text;
+        int last = b;
+        forEachMangled(data, b, e, [&](int s, int t) {
+            text += QString::fromUtf8(data + last, s - last);
+            const QByteArray symbol(data + s, t - s);
+            text += demangled.value(symbol, QString::fromUtf8(symbol));
+            last = t;
+        });
+        text += QString::fromUtf8(data + last, e - last);
+        return text;
+    };
+
+    // ── Emit the compact model ──────────────────────────────────────────────
+    doc.lines.reserve(kept.size());
+    int maxSourceLine = 0;
+    for (int idx : kept) {
+        const Record& r = records[idx];
+        AsmLine line;
+        const int b = r.begin;
+        int e = r.end;
+
+        switch (r.kind) {
+        case RecordKind::Instruction:   line.kind = AsmLine::Kind::Instruction; break;
+        case RecordKind::Label:         line.kind = AsmLine::Kind::Label;       break;
+        case RecordKind::Comment:       line.kind = AsmLine::Kind::Comment;     break;
+        case RecordKind::Directive:
+        case RecordKind::DataDirective: line.kind = AsmLine::Kind::Directive;   break;
+        }
+
+        if (r.kind == RecordKind::Label && options.comments) {
+            // "main:   # @main" → "main:"
+            const int rest = skipSpaces(data, r.labelEnd, e);
+            if (rest < e && isCommentStart(data, rest, e)) e = r.labelEnd;
+        }
+        // Instructions and directives indented, labels flush — as Compiler Explorer shows them
+        line.text = (r.kind == RecordKind::Label || r.kind == RecordKind::Comment)
+            ? lineText(b, e)
+            : QStringLiteral("        ") + lineText(b, e);
+
+        if (r.kind == RecordKind::Instruction && r.sourceLine > 0) {
+            line.file = fileIndex.value(r.fileNumber, -1);
+            line.sourceLine = line.file >= 0 ? r.sourceLine : 0;
+            if (line.file >= 0 && doc.files[line.file].isMain) {
+                maxSourceLine = std::max(maxSourceLine, r.sourceLine);
+            }
+        }
+
+        if (r.function >= 0) {
+            FunctionInfo& info = functions[r.function];
+            if (info.outputIndex < 0) {
+                AsmFunction f;
+                f.symbol = QString::fromUtf8(info.symbol);
+                f.name = demangled.value(info.symbol, f.symbol);
+                if (f.name.isEmpty()) f.name = f.symbol;
+                f.firstLine = doc.lines.size();
+                f.library = info.library;
+                info.outputIndex = doc.functions.size();
+                doc.functions.append(f);
+            }
+            AsmFunction& f = doc.functions[info.outputIndex];
+            f.lastLine = doc.lines.size();
+            if (line.kind == AsmLine::Kind::Instruction) ++f.instructions;
+            line.function = info.outputIndex;
+        }
+        doc.lines.append(line);
+    }
+
+    // ── Source → asm index (CSR: counts, prefix sums, fill) ─────────────────
+    if (maxSourceLine > 0) {
+        doc.srcOffsets.fill(0, maxSourceLine + 2);
+        for (const AsmLine& line : doc.lines) {
+            if (line.sourceLine > 0 && doc.files[line.file].isMain) ++doc.srcOffsets[line.sourceLine + 1];
+        }
+        for (int l = 1; l < doc.srcOffsets.size(); ++l) {
+            doc.srcOffsets[l] += doc.srcOffsets[l - 1];
+        }
+        doc.srcToAsm.resize(doc.srcOffsets.last());
+        QVector<int> fill = doc.srcOffsets;
+        for (int i = 0; i < doc.lines.size(); ++i) {
+            const AsmLine& line = doc.lines[i];
+            if (line.sourceLine > 0 && doc.files[line.file].isMain) {
+                doc.srcToAsm[fill[line.sourceLine]++] = i;
+            }
+        }
+    }
+    return doc;
+}
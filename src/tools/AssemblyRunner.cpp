@@ -1,11 +1,18 @@
 #include "tools/AssemblyRunner.h"
+#include "tools/AsmParser.h"
 #include "compiler/CompilerRegistry.h"
+#include "compiler/StdinSource.h"
+#include "core/ArtifactCache.h"
+#include "core/GroupedProcess.h"
 
+#include <QCryptographicHash>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QMetaMethod>
 #include <QRegularExpression>
 #include <QTextStream>
+#include <QTimer>
 #include <QUuid>
 
 AssemblyRunner::AssemblyRunner(QObject* parent)
@@ -51,6 +58,20 @@ void AssemblyRunner::run(const QString& sourceFile, const QStringList& flags) {
 
     cancel(); // Kill any running process
 
+    // Cache key covers every input except the temp output path
+    QStringList keyArgs;
+    keyArgs << QStringLiteral("-S") << QStringLiteral("-g");
+    if (m_intelSyntax) {
+        keyArgs << QStringLiteral("-masm=intel");
+    }
+    keyArgs << flags;
+    m_cacheKey = ArtifactCache::keyForSource(ArtifactCache::Kind::Assembly, sourceFile,
+                                             compiler->id(), compiler->version(), keyArgs);
+
+    if (lookupCached(QFileInfo(sourceFile).fileName())) {
+        return;
+    }
+
     // Temp file for the generated assembly
     QString uuid = QUuid::createUuid().toString().remove('{').remove('}').remove('-');
     m_tmpAsmFile = QDir::tempPath()
@@ -72,8 +93,94 @@ void AssemblyRunner::run(const QString& sourceFile, const QStringList& flags) {
     args << sourceFile;
     args << QStringLiteral("-o") << m_tmpAsmFile;
 
-    m_process = new QProcess(this);
+    emit progressMessage(
+        QStringLiteral("Generating assembly for %1...").arg(
+            QFileInfo(sourceFile).fileName()));
+
+    startProcess(compiler->executablePath(), args, QString());
+}
+
+void AssemblyRunner::runSource(const QString& sourceCode, const QStringList& flags,
+                               const QString& sourceDirectory) {
+    auto compiler = CompilerRegistry::instance().getCompiler(m_compilerId);
+    if (!compiler || !compiler->isAvailable()) {
+        emit finished(false, QString(),
+            QStringLiteral("Compiler '%1' is not available. "
+                           "Please select a valid compiler.").arg(m_compilerId));
+        return;
+    }
+
+    cancel(); // Kill any running process
+
+    const QStringList args = buildSourceArguments(m_intelSyntax, flags, sourceDirectory);
+
+    // Quoted includes may change without the buffer changing; only
+    // self-contained buffers are cached.
+    static const QRegularExpression quotedInclude(QStringLiteral(R"(^\s*#\s*include\s*")"),
+                                                  QRegularExpression::MultilineOption);
+    m_cacheKey.clear();
+    if (!sourceCode.contains(quotedInclude)) {
+        const QByteArray digest =
+            QCryptographicHash::hash(sourceCode.toUtf8(), QCryptographicHash::Sha256);
+        m_cacheKey = ArtifactCache::computeKey(ArtifactCache::Kind::Assembly, digest,
+                                               compiler->id(), compiler->version(), args);
+    }
+
+    if (lookupCached(QStringLiteral("buffer"))) {
+        return;
+    }
+
+    emit progressMessage(QStringLiteral("Generating assembly..."));
+
+    startProcess(compiler->executablePath(), args, sourceDirectory);
+    m_process->write(sourceCode.toUtf8());
+    m_process->closeWriteChannel();
+}
+
+QStringList AssemblyRunner::buildSourceArguments(bool intelSyntax, const QStringList& flags,
+                                                 const QString& sourceDirectory) {
+    QStringList args;
+    args << QStringLiteral("-S") << QStringLiteral("-g");
+    if (intelSyntax) {
+        args << QStringLiteral("-masm=intel");
+    }
+    args << flags;
+    args << StdinSource::arguments(sourceDirectory);
+    args << QStringLiteral("-o") << QStringLiteral("-");
+    return args;
+}
+
+bool AssemblyRunner::isRunning() const {
+    return m_process != nullptr;
+}
+
+bool AssemblyRunner::lookupCached(const QString& displayName) {
+    QByteArray cachedAsm;
+    QByteArray cachedLog;
+    if (m_cacheKey.isEmpty()
+        || !ArtifactCache::instance()->lookupData(m_cacheKey, &cachedAsm, &cachedLog)) {
+        return false;
+    }
+
+    const quint64 serial = m_runSerial;
+    const QString asmText = QString::fromUtf8(cachedAsm);
+    const QString errText = QString::fromUtf8(cachedLog);
+    emit progressMessage(QStringLiteral("Using cached assembly for %1").arg(displayName));
+    QTimer::singleShot(0, this, [this, serial, asmText, errText]() {
+        if (serial != m_runSerial) return;   // cancelled or superseded
+        emit started();
+        emitFinished(true, asmText, errText);
+    });
+    return true;
+}
+
+void AssemblyRunner::startProcess(const QString& program, const QStringList& args,
+                                  const QString& workingDirectory) {
+    m_process = new GroupedProcess(this);
     m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    if (!workingDirectory.isEmpty()) {
+        m_process->setWorkingDirectory(workingDirectory);
+    }
 
     connect(m_process, &QProcess::started,
             this, &AssemblyRunner::onProcessStarted);
@@ -82,28 +189,28 @@ void AssemblyRunner::run(const QString& sourceFile, const QStringList& flags) {
     connect(m_process, &QProcess::errorOccurred,
             this, &AssemblyRunner::onProcessError);
 
-    emit progressMessage(
-        QStringLiteral("Generating assembly for %1...").arg(
-            QFileInfo(sourceFile).fileName()));
-
-    m_process->start(compiler->executablePath(), args);
+    m_process->start(program, args);
 }
 
 void AssemblyRunner::cancel() {
-    if (m_process && m_process->state() != QProcess::NotRunning) {
-        m_process->kill();
-        m_process->waitForFinished(1000);
-    }
-    if (m_process) {
-        m_process->deleteLater();
-        m_process = nullptr;
-    }
+    ++m_runSerial;
+    killProcess();
     if (!m_tmpAsmFile.isEmpty()) {
         QFile::remove(m_tmpAsmFile);
         m_tmpAsmFile.clear();
     }
 }
 
+void AssemblyRunner::killProcess() {
+    if (!m_process) {
+        return;
+    }
+    // Live mode cancels on every keystroke: kill cc1plus with the driver,
+    // reap in the background, and never hear from the superseded compile
+    m_process->killAndRelease();
+    m_process = nullptr;
+}
+
 void AssemblyRunner::onProcessStarted() {
     emit started();
 }
@@ -113,73 +220,82 @@ void AssemblyRunner::onProcessFinished(int exitCode, QProcess::ExitStatus status
 
     QString errText = QString::fromUtf8(m_process->readAllStandardError());
     bool success = (status == QProcess::NormalExit && exitCode == 0);
+    if (status == QProcess::CrashExit && errText.isEmpty()) {
+        errText = QStringLiteral("Compiler process crashed.");
+    }
 
     QString asmText;
     if (success) {
-        QFile asmFile(m_tmpAsmFile);
-        if (asmFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QTextStream ts(&asmFile);
-            asmText = ts.readAll();
-            asmFile.close();
+        if (m_tmpAsmFile.isEmpty()) {
+            asmText = QString::fromUtf8(m_process->readAllStandardOutput());   // runSource()
+        } else {
+            QFile asmFile(m_tmpAsmFile);
+            if (asmFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                QTextStream ts(&asmFile);
+                asmText = ts.readAll();
+                asmFile.close();
+            }
         }
-        QFile::remove(m_tmpAsmFile);
-        m_tmpAsmFile.clear();
 
-        // Build and emit the source ↔ asm line map
-        emit lineMapReady(parseLocDirectives(asmText));
-    } else {
+        if (!m_cacheKey.isEmpty()) {
+            ArtifactCache::instance()->storeData(m_cacheKey, asmText.toUtf8(), errText.toUtf8());
+        }
+    }
+    if (!m_tmpAsmFile.isEmpty()) {
         QFile::remove(m_tmpAsmFile);
         m_tmpAsmFile.clear();
     }
 
-    emit finished(success, asmText, errText);
-
     m_process->deleteLater();
     m_process = nullptr;
-}
 
-void AssemblyRunner::onProcessError(QProcess::ProcessError error) {
-    static const QMap<QProcess::ProcessError, QString> errors = {
-        { QProcess::FailedToStart, QStringLiteral("Failed to start compiler — check path/permissions.") },
-        { QProcess::Crashed,       QStringLiteral("Compiler process crashed.") },
-        { QProcess::Timedout,      QStringLiteral("Compiler process timed out.") },
-        { QProcess::WriteError,    QStringLiteral("Write error to compiler process.") },
-        { QProcess::ReadError,     QStringLiteral("Read error from compiler process.") },
-    };
-
-    emit finished(false, QString(), errors.value(error, QStringLiteral("Unknown error.")));
+    emitFinished(success, asmText, errText);
+}
 
-    if (!m_tmpAsmFile.isEmpty()) {
-        QFile::remove(m_tmpAsmFile);
-        m_tmpAsmFile.clear();
-    }
-    if (m_process) {
-        m_process->deleteLater();
-        m_process = nullptr;
+void AssemblyRunner::emitFinished(bool success, const QString& asmText, const QString& errText) {
+    // The map costs a parse; skip it when nobody listens
+    static const QMetaMethod lineMapSignal = QMetaMethod::fromSignal(&AssemblyRunner::lineMapReady);
+    if (success && isSignalConnected(lineMapSignal)) {
+        emit lineMapReady(parseLocDirectives(asmText));
     }
+    emit finished(success, asmText, errText);
 }
 
 // static
 QMap<int, int> AssemblyRunner::parseLocDirectives(const QString& asmText) {
-    // .loc directive format (GAS):  .loc <file_num> <line_num> [<col>] [<options>]
-    // We only care about the line number (captured group 1).
-    static const QRegularExpression locRe(
-        QStringLiteral(R"(^\s*\.loc\s+\d+\s+(\d+))"));
-
+    AsmFilterOptions unfiltered;
+    unfiltered.directives       = false;
+    unfiltered.comments         = false;
+    unfiltered.unusedLabels     = false;
+    unfiltered.libraryFunctions = false;
+    unfiltered.demangle         = false;
+    const AsmDocument doc = AsmParser::parse(asmText.toUtf8(), unfiltered);
+
+    // Unfiltered, the document keeps every non-blank input line, in order
     QMap<int, int> asmToSrc;
-    int currentSrcLine = -1;
-    int asmLine = 1;
-
+    int docLine = 0;
+    int asmLine = 0;
     for (const QString& line : asmText.split(QLatin1Char('\n'))) {
-        const QRegularExpressionMatch m = locRe.match(line);
-        if (m.hasMatch()) {
-            currentSrcLine = m.captured(1).toInt();
-        }
-        if (currentSrcLine > 0) {
-            asmToSrc[asmLine] = currentSrcLine;
-        }
         ++asmLine;
+        if (line.trimmed().isEmpty()) continue;
+        const int srcLine = doc.mainSourceLine(docLine++);
+        if (srcLine > 0) {
+            asmToSrc.insert(asmLine, srcLine);
+        }
     }
-
     return asmToSrc;
 }
+
+void AssemblyRunner::onProcessError(QProcess::ProcessError error) {
+    // Crashes and kills also end in finished(); only a failed start does not
+    if (error != QProcess::FailedToStart) return;
+
+    if (!m_tmpAsmFile.isEmpty()) {
+        QFile::remove(m_tmpAsmFile);
+        m_tmpAsmFile.clear();
+    }
+    killProcess();
+
+    emit finished(false, QString(),
+                  QStringLiteral("Failed to start compiler — check path/permissions."));
+}
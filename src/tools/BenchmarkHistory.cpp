@@ -0,0 +1,352 @@
+#include "tools/BenchmarkHistory.h"
+#include "tools/BenchmarkRunner.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QStandardPaths>
+#include <QVariant>
+
+namespace {
+
+const char* const RUN_COLUMNS =
+    "id, recorded_at, source_name, source_hash, source, compiler_id, standard, "
+    "optimization, label, date, options, context, perf_counters_note, baseline";
+
+QByteArray toJson(const QJsonObject& obj) {
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+QJsonObject fromJson(const QVariant& value) {
+    return QJsonDocument::fromJson(value.toByteArray()).object();
+}
+
+} // namespace
+
+BenchmarkHistory::BenchmarkHistory(const QString& databasePath, QObject* parent)
+    : QObject(parent)
+    , m_path(databasePath)
+    , m_connectionName(QStringLiteral("CppAtlasBenchmarkHistory_%1")
+                           .arg(reinterpret_cast<quintptr>(this), 0, 16))
+{
+    if (open()) createSchema();
+}
+
+BenchmarkHistory::~BenchmarkHistory() {
+    {
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+        if (db.isOpen()) db.close();
+    }
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+// static
+QString BenchmarkHistory::defaultPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QStringLiteral("/benchmark_history.db");
+}
+
+bool BenchmarkHistory::isOpen() const {
+    return QSqlDatabase::database(m_connectionName, false).isOpen();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Schema
+// ─────────────────────────────────────────────────────────────────────────────
+
+bool BenchmarkHistory::open() {
+    const QString dir = QFileInfo(m_path).absolutePath();
+    if (!QDir().mkpath(dir)) {
+        m_lastError = QStringLiteral("Cannot create directory: ") + dir;
+        return false;
+    }
+
+    QSqlDatabase db = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), m_connectionName);
+    db.setDatabaseName(m_path);
+    if (!db.open()) {
+        m_lastError = db.lastError().text();
+        return false;
+    }
+    // Cascade entry deletes with their run
+    QSqlQuery pragma(db);
+    pragma.exec(QStringLiteral("PRAGMA foreign_keys=ON;"));
+    pragma.exec(QStringLiteral("PRAGMA journal_mode=WAL;"));
+    return true;
+}
+
+bool BenchmarkHistory::createSchema() {
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    QSqlQuery q(db);
+    const QStringList statements = {
+        QStringLiteral(
+            "CREATE TABLE IF NOT EXISTS runs ("
+            "  id           INTEGER PRIMARY KEY AUTOINCREMENT,"
+            "  recorded_at  TEXT NOT NULL,"             // ISO 8601, UTC
+            "  source_name  TEXT NOT NULL,"
+            "  source_hash  TEXT NOT NULL,"
+            "  source       TEXT NOT NULL,"
+            "  compiler_id  TEXT,"
+            "  standard     TEXT,"
+            "  optimization TEXT,"
+            "  label        TEXT,"
+            "  date         TEXT,"                      // The library's context date
+            "  options      TEXT NOT NULL,"             // BenchmarkRunner::optionsToJson
+            "  context      TEXT NOT NULL,"             // BenchmarkRunner::contextToJson
+            "  perf_counters_note TEXT,"
+            "  baseline     INTEGER NOT NULL DEFAULT 0"
+            ")"),
+        QStringLiteral(
+            "CREATE TABLE IF NOT EXISTS entries ("
+            "  run_id       INTEGER NOT NULL REFERENCES runs(id) ON DELETE CASCADE,"
+            "  position     INTEGER NOT NULL,"
+            "  run_name     TEXT NOT NULL,"
+            "  real_time_ns REAL,"
+            "  data         TEXT NOT NULL,"             // BenchmarkRunner::entryToJson
+            "  PRIMARY KEY (run_id, position)"
+            ")"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS idx_runs_source ON runs(source_name, id)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS idx_entries_name ON entries(run_name)"),
+        QStringLiteral("PRAGMA user_version = %1").arg(SCHEMA_VERSION)
+    };
+    for (const QString& sql : statements) {
+        if (!q.exec(sql)) {
+            m_lastError = q.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Runs
+// ─────────────────────────────────────────────────────────────────────────────
+
+qint64 BenchmarkHistory::addRun(const BenchmarkResult& result, const QString& sourceName,
+                                const QString& sourceText) {
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+    if (!db.isOpen()) {
+        m_lastError = QStringLiteral("Benchmark history is not open.");
+        return -1;
+    }
+
+    db.transaction();
+    QSqlQuery q(db);
+    q.prepare(QStringLiteral(
+        "INSERT INTO runs (recorded_at, source_name, source_hash, source, compiler_id, standard,"
+        "                  optimization, label, date, options, context, perf_counters_note) "
+        "VALUES (:recorded_at, :source_name, :source_hash, :source, :compiler_id, :standard,"
+        "        :optimization, :label, :date, :options, :context, :perf_counters_note)"));
+    q.bindValue(QStringLiteral(":recorded_at"),
+                QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs));
+    q.bindValue(QStringLiteral(":source_name"), sourceName);
+    q.bindValue(QStringLiteral(":source_hash"), sourceHash(sourceText));
+    q.bindValue(QStringLiteral(":source"),      sourceText);
+    q.bindValue(QStringLiteral(":compiler_id"), result.compilerId);
+    q.bindValue(QStringLiteral(":standard"),    result.standard);
+    q.bindValue(QStringLiteral(":optimization"), result.optimizationLevel);
+    q.bindValue(QStringLiteral(":label"),       result.label);
+    q.bindValue(QStringLiteral(":date"),        result.date);
+    q.bindValue(QStringLiteral(":options"), toJson(BenchmarkRunner::optionsToJson(result.options)));
+    q.bindValue(QStringLiteral(":context"), toJson(BenchmarkRunner::contextToJson(result.context)));
+    q.bindValue(QStringLiteral(":perf_counters_note"), result.perfCountersNote);
+    if (!q.exec()) {
+        m_lastError = q.lastError().text();
+        db.rollback();
+        return -1;
+    }
+    const qint64 id = q.lastInsertId().toLongLong();
+
+    QSqlQuery entry(db);
+    entry.prepare(QStringLiteral(
+        "INSERT INTO entries (run_id, position, run_name, real_time_ns, data) "
+        "VALUES (:run_id, :position, :run_name, :real_time_ns, :data)"));
+    for (int i = 0; i < result.benchmarks.size(); ++i) {
+        const BenchmarkEntry& e = result.benchmarks[i];
+        entry.bindValue(QStringLiteral(":run_id"),   id);
+        entry.bindValue(QStringLiteral(":position"), i);
+        entry.bindValue(QStringLiteral(":run_name"), e.runName.isEmpty() ? e.name : e.runName);
+        entry.bindValue(QStringLiteral(":real_time_ns"),
+                        BenchmarkStats::toNanoseconds(e.realTimeNs, e.timeUnit));
+        entry.bindValue(QStringLiteral(":data"), toJson(BenchmarkRunner::entryToJson(e)));
+        if (!entry.exec()) {
+            m_lastError = entry.lastError().text();
+            db.rollback();
+            return -1;
+        }
+    }
+    if (!db.commit()) {
+        m_lastError = db.lastError().text();
+        return -1;
+    }
+    emit changed();
+    return id;
+}
+
+QList<BenchmarkHistoryRun> BenchmarkHistory::selectRuns(const QString& where,
+                                                        const QVariantMap& bindings) const {
+    QList<BenchmarkHistoryRun> runs;
+    QSqlQuery q(QSqlDatabase::database(m_connectionName, false));
+    q.prepare(QStringLiteral("SELECT %1 FROM runs %2 ORDER BY id")
+                  .arg(QLatin1String(RUN_COLUMNS), where));
+    for (auto it = bindings.cbegin(); it != bindings.cend(); ++it)
+        q.bindValue(it.key(), it.value());
+    if (!q.exec()) {
+        m_lastError = q.lastError().text();
+        return runs;
+    }
+    while (q.next()) {
+        BenchmarkHistoryRun run;
+        run.id         = q.value(QStringLiteral("id")).toLongLong();
+        run.recordedAt = QDateTime::fromString(q.value(QStringLiteral("recorded_at")).toString(),
+                                               Qt::ISODateWithMs);
+        run.sourceName = q.value(QStringLiteral("source_name")).toString();
+        run.sourceHash = q.value(QStringLiteral("source_hash")).toString();
+        run.source     = q.value(QStringLiteral("source")).toString();
+        run.baseline   = q.value(QStringLiteral("baseline")).toBool();
+
+        BenchmarkResult& r = run.result;
+        r.success           = true;
+        r.compilerId        = q.value(QStringLiteral("compiler_id")).toString();
+        r.standard          = q.value(QStringLiteral("standard")).toString();
+        r.optimizationLevel = q.value(QStringLiteral("optimization")).toString();
+        r.label             = q.value(QStringLiteral("label")).toString();
+        r.date              = q.value(QStringLiteral("date")).toString();
+        r.options = BenchmarkRunner::optionsFromJson(fromJson(q.value(QStringLiteral("options"))));
+        r.context = BenchmarkRunner::contextFromJson(fromJson(q.value(QStringLiteral("context"))));
+        r.perfCountersNote  = q.value(QStringLiteral("perf_counters_note")).toString();
+        runs << run;
+    }
+    for (BenchmarkHistoryRun& run : runs) loadEntries(run);
+    return runs;
+}
+
+bool BenchmarkHistory::loadEntries(BenchmarkHistoryRun& run) const {
+    QSqlQuery q(QSqlDatabase::database(m_connectionName, false));
+    q.prepare(QStringLiteral("SELECT data FROM entries WHERE run_id = :run_id ORDER BY position"));
+    q.bindValue(QStringLiteral(":run_id"), run.id);
+    if (!q.exec()) {
+        m_lastError = q.lastError().text();
+        return false;
+    }
+    while (q.next())
+        run.result.benchmarks << BenchmarkRunner::entryFromJson(fromJson(q.value(0)));
+    return true;
+}
+
+QList<BenchmarkHistoryRun> BenchmarkHistory::runs(const QString& sourceName) const {
+    if (sourceName.isEmpty()) return selectRuns(QString(), {});
+    return selectRuns(QStringLiteral("WHERE source_name = :source_name"),
+                      {{QStringLiteral(":source_name"), sourceName}});
+}
+
+BenchmarkHistoryRun BenchmarkHistory::run(qint64 id) const {
+    const QList<BenchmarkHistoryRun> found =
+        selectRuns(QStringLiteral("WHERE id = :id"), {{QStringLiteral(":id"), id}});
+    return found.isEmpty() ? BenchmarkHistoryRun{} : found.first();
+}
+
+QStringList BenchmarkHistory::sourceNames() const {
+    QStringList names;
+    QSqlQuery q(QSqlDatabase::database(m_connectionName, false));
+    if (!q.exec(QStringLiteral("SELECT source_name FROM runs GROUP BY source_name "
+                               "ORDER BY MAX(id) DESC"))) {
+        m_lastError = q.lastError().text();
+        return names;
+    }
+    while (q.next()) names << q.value(0).toString();
+    return names;
+}
+
+bool BenchmarkHistory::pinBaseline(qint64 id) {
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+    db.transaction();
+    QSqlQuery q(db);
+    q.prepare(QStringLiteral(
+        "UPDATE runs SET baseline = (id = :pinned) "
+        "WHERE source_name = (SELECT source_name FROM runs WHERE id = :id)"));
+    q.bindValue(QStringLiteral(":pinned"), id);
+    q.bindValue(QStringLiteral(":id"), id);
+    if (!q.exec() || q.numRowsAffected() <= 0) {
+        m_lastError = q.lastError().isValid() ? q.lastError().text()
+                                              : QStringLiteral("No run #%1.").arg(id);
+        db.rollback();
+        return false;
+    }
+    db.commit();
+    emit changed();
+    return true;
+}
+
+bool BenchmarkHistory::unpinBaseline(const QString& sourceName) {
+    QSqlQuery q(QSqlDatabase::database(m_connectionName, false));
+    q.prepare(QStringLiteral("UPDATE runs SET baseline = 0 WHERE source_name = :source_name"));
+    q.bindValue(QStringLiteral(":source_name"), sourceName);
+    if (!q.exec()) {
+        m_lastError = q.lastError().text();
+        return false;
+    }
+    emit changed();
+    return true;
+}
+
+BenchmarkHistoryRun BenchmarkHistory::baseline(const QString& sourceName) const {
+    const QList<BenchmarkHistoryRun> found = selectRuns(
+        QStringLiteral("WHERE source_name = :source_name AND baseline = 1"),
+        {{QStringLiteral(":source_name"), sourceName}});
+    return found.isEmpty() ? BenchmarkHistoryRun{} : found.first();
+}
+
+bool BenchmarkHistory::removeRun(qint64 id) {
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+    db.transaction();
+    QSqlQuery q(db);
+    q.prepare(QStringLiteral("DELETE FROM entries WHERE run_id = :id"));
+    q.bindValue(QStringLiteral(":id"), id);
+    bool ok = q.exec();
+    if (ok) {
+        q.prepare(QStringLiteral("DELETE FROM runs WHERE id = :id"));
+        q.bindValue(QStringLiteral(":id"), id);
+        ok = q.exec() && q.numRowsAffected() > 0;
+    }
+    if (!ok) {
+        m_lastError = q.lastError().isValid() ? q.lastError().text()
+                                              : QStringLiteral("No run #%1.").arg(id);
+        db.rollback();
+        return false;
+    }
+    db.commit();
+    emit changed();
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Helpers
+// ─────────────────────────────────────────────────────────────────────────────
+
+// static
+QString BenchmarkHistory::sourceHash(const QString& sourceText) {
+    return QString::fromLatin1(
+        QCryptographicHash::hash(sourceText.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+// static
+QStringList BenchmarkHistory::regressionFlags(const QList<BenchmarkComparison>& comparisons) {
+    QStringList flags;
+    for (const BenchmarkComparison& c : comparisons) {
+        const QString change = QString::number(c.change * 100.0, 'f', 1);
+        if (c.verdict == BenchmarkComparison::Verdict::Slower) {
+            flags << QStringLiteral("%1 regressed by %2% (significant, p = %3)")
+                         .arg(c.runName, change, QString::number(c.pValue, 'g', 2));
+        } else if (c.verdict == BenchmarkComparison::Verdict::InsufficientData
+                   && c.change >= UNTESTED_CHANGE) {
+            flags << QStringLiteral("%1 slower by %2% (untested: needs ≥ 2 repetitions on both sides)")
+                         .arg(c.runName, change);
+        }
+    }
+    return flags;
+}
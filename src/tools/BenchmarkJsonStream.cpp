@@ -0,0 +1,53 @@
+#include "tools/BenchmarkJsonStream.h"
+
+#include <QJsonDocument>
+
+QList<QJsonObject> BenchmarkJsonStream::feed(const QByteArray& chunk) {
+    m_data += chunk;
+    QList<QJsonObject> rows;
+    if (m_done) return rows;
+
+    if (m_pos < 0) {
+        // "context" comes first and never contains this key
+        const int key = m_data.indexOf("\"benchmarks\"");
+        if (key < 0) return rows;
+        const int bracket = m_data.indexOf('[', key);
+        if (bracket < 0) return rows;
+        m_pos = bracket + 1;
+    }
+
+    for (; m_pos < m_data.size() && !m_done; ++m_pos) {
+        const char c = m_data.at(m_pos);
+        if (m_inString) {
+            if (m_escape)         m_escape = false;
+            else if (c == '\\')   m_escape = true;
+            else if (c == '"')    m_inString = false;
+            continue;
+        }
+        switch (c) {
+        case '"':
+            m_inString = true;
+            break;
+        case '{':
+            if (m_depth++ == 0) m_objectStart = m_pos;
+            break;
+        case '}':
+            if (--m_depth == 0) {
+                const QJsonDocument doc = QJsonDocument::fromJson(
+                    m_data.mid(m_objectStart, m_pos - m_objectStart + 1));
+                if (doc.isObject()) rows << doc.object();
+            }
+            break;
+        case ']':
+            if (m_depth == 0) m_done = true;
+            break;
+        default:
+            break;
+        }
+    }
+    return rows;
+}
+
+void BenchmarkJsonStream::reset() {
+    *this = BenchmarkJsonStream();
+}
@@ -2,14 +2,84 @@
 #include "tools/ToolsConfig.h"
 #include "compiler/CompilerRegistry.h"
 #include "compiler/ICompiler.h"
+#include "core/ArtifactCache.h"
+#include "tools/BenchmarkStats.h"
 
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QRegularExpression>
 #include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <sched.h>
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+constexpr int MAX_CPU = 1023;
+
+// libpfm's generic perf_events names; the library reports each per iteration
+const char* const PERF_EVENTS = "CYCLES,INSTRUCTIONS,CACHE-MISSES,BRANCHES,BRANCH-MISSES";
+
+#ifdef Q_OS_LINUX
+// Failures are not reported here: recordIsolation() reads back what stuck
+void applyIsolation(pid_t pid, const cpu_set_t& cpus, bool pin, bool boost) {
+    if (pin)   sched_setaffinity(pid, sizeof(cpus), &cpus);
+    if (boost) setpriority(PRIO_PROCESS, id_t(pid), BenchmarkRunner::ISOLATED_NICE);
+}
+#endif
+
+QString readGovernor(int cpu) {
+    QFile f(QStringLiteral("/sys/devices/system/cpu/cpu%1/cpufreq/scaling_governor").arg(cpu));
+    if (!f.open(QIODevice::ReadOnly)) return QString();
+    return QString::fromLatin1(f.readAll()).trimmed();
+}
+
+// family/arg/arg...: ->Arg values, named or not, between the library's own options
+void splitRunName(BenchmarkEntry& entry) {
+    static const QStringList options = {
+        QStringLiteral("threads"), QStringLiteral("iterations"), QStringLiteral("repeats"),
+        QStringLiteral("min_time"), QStringLiteral("min_warmup_time")
+    };
+    static const QStringList flags = {
+        QStringLiteral("real_time"), QStringLiteral("manual_time"), QStringLiteral("process_time")
+    };
+    const QStringList parts = entry.runName.split(QLatin1Char('/'));
+    entry.family = parts.first();
+    for (int i = 1; i < parts.size(); ++i) {
+        const QString& part = parts[i];
+        const int colon = part.indexOf(QLatin1Char(':'));
+        const QString key = colon < 0 ? QString() : part.left(colon);
+        if (options.contains(key) || flags.contains(part)) continue;
+        bool ok = false;
+        const qint64 value = part.mid(colon + 1).toLongLong(&ok);
+        if (!ok) continue;   // BENCHMARK_CAPTURE labels
+        entry.args     << value;
+        entry.argNames << key;
+    }
+}
+
+QString formatBytes(qint64 bytes) {
+    if (bytes >= 1024 * 1024 && bytes % (1024 * 1024) == 0)
+        return QStringLiteral("%1 MiB").arg(bytes / (1024 * 1024));
+    if (bytes >= 1024)
+        return QStringLiteral("%1 KiB").arg(bytes / 1024);
+    return QStringLiteral("%1 B").arg(bytes);
+}
+
+} // namespace
 
 // ── Construction ─────────────────────────────────────────────────────────────
 
@@ -43,6 +113,321 @@ void BenchmarkRunner::setResultMetadata(const QString& compilerId,
     m_lastResult.optimizationLevel = optimizationLevel;
 }
 
+void BenchmarkRunner::setRunOptions(const BenchmarkRunOptions& options) { m_runOptions = options; }
+BenchmarkRunOptions BenchmarkRunner::runOptions() const { return m_runOptions; }
+
+// static
+QStringList BenchmarkRunner::runArguments(const BenchmarkRunOptions& options) {
+    QStringList args;
+    const int repetitions = options.adaptive
+        ? qMax(options.repetitions, ADAPTIVE_MIN_REPETITIONS)
+        : options.repetitions;
+    if (repetitions > 1)
+        args << QStringLiteral("--benchmark_repetitions=%1").arg(repetitions);
+    // A bare number means seconds to every library version (1.8+ also takes "0.5s")
+    if (options.minTimeSec > 0.0)
+        args << QStringLiteral("--benchmark_min_time=%1").arg(options.minTimeSec, 0, 'g', 6);
+    if (options.randomInterleaving)
+        args << QStringLiteral("--benchmark_enable_random_interleaving=true");
+    if (options.perfCounters)
+        args << QStringLiteral("--benchmark_perf_counters=") + QLatin1String(PERF_EVENTS);
+    return args;
+}
+
+// static
+QString BenchmarkRunner::filterForRun(const QString& runName) {
+    static const QString special = QStringLiteral(".[]{}()\\*+?^$|");
+    QString pattern = QStringLiteral("^");
+    for (const QChar c : runName) {
+        if (special.contains(c)) pattern += QLatin1Char('\\');
+        pattern += c;
+    }
+    return pattern + QLatin1Char('$');
+}
+
+// static
+void BenchmarkRunner::appendRepetitions(QList<BenchmarkEntry>& entries,
+                                        const QList<BenchmarkEntry>& batch) {
+    QHash<QString, int> counts;
+    for (const BenchmarkEntry& e : entries) {
+        if (!e.isAggregate()) ++counts[e.runName];
+    }
+    for (BenchmarkEntry e : batch) {
+        if (e.isAggregate()) continue;
+        e.repetitionIndex = counts[e.runName]++;
+        entries << e;
+    }
+    for (BenchmarkEntry& e : entries) e.repetitions = counts.value(e.runName, 1);
+}
+
+// static
+bool BenchmarkRunner::isolationSupported() {
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+// static
+QList<int> BenchmarkRunner::parseCpuList(const QString& text, bool* ok) {
+    QList<int> cpus;
+    bool good = true;
+    for (const QString& part : text.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        const QStringList bounds = part.trimmed().split(QLatin1Char('-'));
+        bool okFirst = false, okLast = false;
+        const int first = bounds.first().trimmed().toInt(&okFirst);
+        const int last  = bounds.size() == 2 ? bounds.last().trimmed().toInt(&okLast) : first;
+        if (bounds.size() == 1) okLast = okFirst;
+        if (bounds.size() > 2 || !okFirst || !okLast
+            || first < 0 || last > MAX_CPU || first > last) {
+            good = false;
+            break;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) cpus << cpu;
+    }
+    if (ok) *ok = good;
+    if (!good) return {};
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+// static
+QString BenchmarkRunner::formatCpuList(const QList<int>& cpus) {
+    QStringList parts;
+    for (int i = 0; i < cpus.size();) {
+        int j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+        parts << (j - i >= 2 ? QStringLiteral("%1-%2").arg(cpus[i]).arg(cpus[j])
+                             : QString::number(cpus[i]));
+        if (j - i == 1) parts << QString::number(cpus[j]);
+        i = j + 1;
+    }
+    return parts.join(QLatin1Char(','));
+}
+
+// static
+BenchmarkContext BenchmarkRunner::contextFromJson(const QJsonObject& obj) {
+    BenchmarkContext c;
+    c.hostName   = obj[QStringLiteral("host_name")].toString();
+    c.executable = obj[QStringLiteral("executable")].toString();
+    c.numCpus    = obj[QStringLiteral("num_cpus")].toInt();
+    c.mhzPerCpu  = obj[QStringLiteral("mhz_per_cpu")].toDouble();
+    c.cpuScalingKnown   = obj.contains(QStringLiteral("cpu_scaling_enabled"));
+    c.cpuScalingEnabled = obj[QStringLiteral("cpu_scaling_enabled")].toBool();
+    for (const QJsonValue& v : obj[QStringLiteral("load_avg")].toArray())
+        c.loadAvg << v.toDouble();
+    for (const QJsonValue& v : obj[QStringLiteral("caches")].toArray()) {
+        const QJsonObject o = v.toObject();
+        BenchmarkContext::Cache cache;
+        cache.type       = o[QStringLiteral("type")].toString();
+        cache.level      = o[QStringLiteral("level")].toInt();
+        cache.size       = static_cast<qint64>(o[QStringLiteral("size")].toDouble());
+        cache.numSharing = o[QStringLiteral("num_sharing")].toInt();
+        c.caches << cache;
+    }
+    c.libraryBuildType = obj[QStringLiteral("library_build_type")].toString();
+    c.libraryVersion   = obj[QStringLiteral("library_version")].toString();
+
+    c.governor   = obj[QStringLiteral("governor")].toString();
+    c.pinnedCpus = obj[QStringLiteral("pinned_cpus")].toString();
+    c.niceness   = obj[QStringLiteral("niceness")].toInt();
+    return c;
+}
+
+// static
+QJsonObject BenchmarkRunner::contextToJson(const BenchmarkContext& c) {
+    QJsonObject obj;
+    obj[QStringLiteral("host_name")]   = c.hostName;
+    obj[QStringLiteral("executable")]  = c.executable;
+    obj[QStringLiteral("num_cpus")]    = c.numCpus;
+    obj[QStringLiteral("mhz_per_cpu")] = c.mhzPerCpu;
+    if (c.cpuScalingKnown)
+        obj[QStringLiteral("cpu_scaling_enabled")] = c.cpuScalingEnabled;
+    QJsonArray load;
+    for (double l : c.loadAvg) load.append(l);
+    obj[QStringLiteral("load_avg")] = load;
+    QJsonArray caches;
+    for (const BenchmarkContext::Cache& cache : c.caches) {
+        QJsonObject o;
+        o[QStringLiteral("type")]        = cache.type;
+        o[QStringLiteral("level")]       = cache.level;
+        o[QStringLiteral("size")]        = double(cache.size);
+        o[QStringLiteral("num_sharing")] = cache.numSharing;
+        caches.append(o);
+    }
+    obj[QStringLiteral("caches")]             = caches;
+    obj[QStringLiteral("library_build_type")] = c.libraryBuildType;
+    obj[QStringLiteral("library_version")]    = c.libraryVersion;
+
+    obj[QStringLiteral("governor")]    = c.governor;
+    obj[QStringLiteral("pinned_cpus")] = c.pinnedCpus;
+    obj[QStringLiteral("niceness")]    = c.niceness;
+    return obj;
+}
+
+// static
+BenchmarkRunOptions BenchmarkRunner::optionsFromJson(const QJsonObject& obj) {
+    BenchmarkRunOptions o;
+    o.repetitions        = obj[QStringLiteral("repetitions")].toInt(o.repetitions);
+    o.minTimeSec         = obj[QStringLiteral("min_time")].toDouble(o.minTimeSec);
+    o.randomInterleaving = obj[QStringLiteral("random_interleaving")].toBool(o.randomInterleaving);
+    o.adaptive           = obj[QStringLiteral("adaptive")].toBool(o.adaptive);
+    o.targetCv           = obj[QStringLiteral("target_cv")].toDouble(o.targetCv);
+    o.targetCiWidth      = obj[QStringLiteral("target_ci_width")].toDouble(o.targetCiWidth);
+    o.timeBudgetSec      = obj[QStringLiteral("time_budget")].toDouble(o.timeBudgetSec);
+    o.maxRepetitions     = obj[QStringLiteral("max_repetitions")].toInt(o.maxRepetitions);
+    o.pinnedCpus         = parseCpuList(obj[QStringLiteral("pinned_cpus")].toString());
+    o.raisePriority      = obj[QStringLiteral("raise_priority")].toBool(o.raisePriority);
+    o.perfCounters       = obj[QStringLiteral("perf_counters")].toBool(o.perfCounters);
+    o.trackAllocations   = obj[QStringLiteral("track_allocations")].toBool(o.trackAllocations);
+    o.threadSweepMax     = obj[QStringLiteral("thread_sweep_max")].toInt(o.threadSweepMax);
+    return o;
+}
+
+// static
+QJsonObject BenchmarkRunner::optionsToJson(const BenchmarkRunOptions& o) {
+    QJsonObject obj;
+    obj[QStringLiteral("repetitions")]         = o.repetitions;
+    obj[QStringLiteral("min_time")]            = o.minTimeSec;
+    obj[QStringLiteral("random_interleaving")] = o.randomInterleaving;
+    obj[QStringLiteral("adaptive")]            = o.adaptive;
+    obj[QStringLiteral("target_cv")]           = o.targetCv;
+    obj[QStringLiteral("target_ci_width")]     = o.targetCiWidth;
+    obj[QStringLiteral("time_budget")]         = o.timeBudgetSec;
+    obj[QStringLiteral("max_repetitions")]     = o.maxRepetitions;
+    obj[QStringLiteral("pinned_cpus")]         = formatCpuList(o.pinnedCpus);
+    obj[QStringLiteral("raise_priority")]      = o.raisePriority;
+    obj[QStringLiteral("perf_counters")]       = o.perfCounters;
+    obj[QStringLiteral("track_allocations")]   = o.trackAllocations;
+    obj[QStringLiteral("thread_sweep_max")]    = o.threadSweepMax;
+    return obj;
+}
+
+// static
+QStringList BenchmarkRunner::noiseWarnings(const BenchmarkResult& result) {
+    const BenchmarkContext& c = result.context;
+    QStringList warnings;
+
+    const bool slowGovernor = !c.governor.isEmpty() && c.governor != QLatin1String("performance");
+    if (slowGovernor) {
+        warnings << QStringLiteral("CPU frequency scaling: governor is \"%1\", so the clock "
+                                   "speed changes during the run. Use \"performance\".")
+                        .arg(c.governor);
+    } else if (c.cpuScalingEnabled) {
+        warnings << QStringLiteral("CPU frequency scaling is enabled, so the clock speed "
+                                   "changes during the run.");
+    }
+    if (!c.loadAvg.isEmpty() && c.loadAvg.first() > LOAD_WARNING) {
+        warnings << QStringLiteral("System load was %1 at start: other processes competed "
+                                   "for the CPU.").arg(c.loadAvg.first(), 0, 'f', 2);
+    }
+    if (c.libraryBuildType.compare(QLatin1String("debug"), Qt::CaseInsensitive) == 0) {
+        warnings << QStringLiteral("The Google Benchmark library is a debug build; "
+                                   "its overhead is in every timing.");
+    }
+    if (result.optimizationLevel.compare(QLatin1String("O0"), Qt::CaseInsensitive) == 0) {
+        warnings << QStringLiteral("The benchmark was compiled with -O0; timings say "
+                                   "little about optimized code.");
+    }
+    if (!result.options.pinnedCpus.isEmpty() && !c.isEmpty() && c.pinnedCpus.isEmpty()) {
+        warnings << QStringLiteral("CPU pinning to %1 was not applied.")
+                        .arg(formatCpuList(result.options.pinnedCpus));
+    }
+    if (result.options.raisePriority && !c.isEmpty() && c.niceness >= 0) {
+        warnings << QStringLiteral("Priority was not raised: a negative nice value needs "
+                                   "CAP_SYS_NICE or an RLIMIT_NICE allowance.");
+    }
+    return warnings;
+}
+
+// static
+QString BenchmarkRunner::describeMachine(const BenchmarkContext& c) {
+    if (c.isEmpty()) return QStringLiteral("unknown machine");
+    QStringList parts;
+    parts << (c.hostName.isEmpty() ? QStringLiteral("unknown host") : c.hostName);
+    parts << QStringLiteral("%1 × %2 MHz").arg(c.numCpus).arg(c.mhzPerCpu, 0, 'f', 0);
+    for (const BenchmarkContext::Cache& cache : c.caches) {
+        const QString kind = cache.type == QLatin1String("Data")        ? QStringLiteral("d")
+                           : cache.type == QLatin1String("Instruction") ? QStringLiteral("i")
+                                                                        : QString();
+        parts << QStringLiteral("L%1%2 %3").arg(cache.level).arg(kind, formatBytes(cache.size));
+    }
+    if (!c.libraryBuildType.isEmpty()) parts << c.libraryBuildType;
+    if (!c.governor.isEmpty())         parts << c.governor;
+    if (!c.pinnedCpus.isEmpty())       parts << QStringLiteral("CPUs %1").arg(c.pinnedCpus);
+    if (c.niceness != 0)               parts << QStringLiteral("nice %1").arg(c.niceness);
+    return parts.join(QStringLiteral(" · "));
+}
+
+// static
+QString BenchmarkRunner::injectThreadRange(const QString& source, int maxThreads) {
+    static const QRegularExpression registration(QStringLiteral(
+        "\\bBENCHMARK(?:_CAPTURE|_TEMPLATE[12]?|_REGISTER_F)?\\s*\\("));
+    const QString range = QStringLiteral("->ThreadRange(1, %1)").arg(maxThreads);
+
+    QString out;
+    int copied = 0;
+    QRegularExpressionMatchIterator it = registration.globalMatch(source);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch m = it.next();
+        const int start = m.capturedStart();
+        if (start < copied) continue;
+        const int lineStart = source.lastIndexOf(QLatin1Char('\n'), start) + 1;
+        if (source.mid(lineStart, start - lineStart).contains(QLatin1String("//"))) continue;
+
+        int close = m.capturedEnd();
+        for (int depth = 1; close < source.size() && depth > 0; ++close) {
+            if (source[close] == QLatin1Char('('))      ++depth;
+            else if (source[close] == QLatin1Char(')')) --depth;
+        }
+        const int statementEnd = source.indexOf(QLatin1Char(';'), close);
+        if (statementEnd < 0) break;
+        if (source.mid(close, statementEnd - close).contains(QLatin1String("->Thread"))) continue;
+
+        out += source.mid(copied, close - copied) + range;
+        copied = close;
+    }
+    return out + source.mid(copied);
+}
+
+// static
+int BenchmarkRunner::perfEventParanoid() {
+    QFile f(QStringLiteral("/proc/sys/kernel/perf_event_paranoid"));
+    if (!f.open(QIODevice::ReadOnly)) return PARANOID_UNKNOWN;
+    bool ok = false;
+    const int value = QString::fromLatin1(f.readAll()).trimmed().toInt(&ok);
+    return ok ? value : PARANOID_UNKNOWN;
+}
+
+// static
+QString BenchmarkRunner::perfCountersNote(const QString& stderrText, int paranoid) {
+    if (stderrText.contains(QLatin1String("multi-threaded"))) {
+        return QStringLiteral("Hardware counters do not work with multi-threaded benchmarks "
+                              "(->Threads()); the run was repeated without them.");
+    }
+    if (stderrText.contains(QLatin1String("kMaxCounters"))) {
+        return QStringLiteral("This Google Benchmark library counts at most three events "
+                              "at once; version 1.8 or newer is needed.");
+    }
+    if (stderrText.contains(QLatin1String("counters not supported"), Qt::CaseInsensitive)) {
+        return QStringLiteral("The Google Benchmark library was built without libpfm; "
+                              "rebuild it with -DBENCHMARK_ENABLE_LIBPFM=ON.");
+    }
+    // 2 still lets a process count its own user-space events
+    if (paranoid != PARANOID_UNKNOWN && paranoid > 2) {
+        return QStringLiteral("Access denied: kernel.perf_event_paranoid is %1. "
+                              "Lower it with \"sysctl kernel.perf_event_paranoid=2\".")
+            .arg(paranoid);
+    }
+    if (paranoid == PARANOID_UNKNOWN) {
+        return QStringLiteral("Hardware counters need Linux perf_events.");
+    }
+    return QStringLiteral("The kernel exposes no usable hardware counters "
+                          "(common in virtual machines).");
+}
+
 QString BenchmarkRunner::extractStandardFromFlags(const QStringList& flags) {
     for (const QString& f : flags) {
         if (f.startsWith(QStringLiteral("-std=")))
@@ -104,24 +489,88 @@ void BenchmarkRunner::run(const QString& sourceFile, const QStringList& flags) {
 
     const ToolsConfig& cfg = ToolsConfig::instance();
 
-    QStringList args;
-    args << sourceFile
-         << QStringLiteral("-o") << m_tempBinaryPath;
-    args << flags;
-    args << (QStringLiteral("-I") + cfg.benchmarkIncludeDir());
+    QStringList linkArgs;
+    linkArgs << flags;
+    linkArgs << (QStringLiteral("-I") + cfg.benchmarkIncludeDir());
 
     // Link benchmark library — absolute path (libbenchmark.a) or flag
     const QString lib = cfg.benchmarkLibrary();
+    QString libStamp;
     if (!lib.isEmpty() && QFileInfo::exists(lib)) {
-        args << lib;                    // e.g. /build/_deps/googlebenchmark-build/src/libbenchmark.a
+        linkArgs << lib;                // e.g. /build/_deps/googlebenchmark-build/src/libbenchmark.a
+        libStamp = QFileInfo(lib).lastModified().toString(Qt::ISODate);
     } else {
-        args << QStringLiteral("-lbenchmark")
-             << QStringLiteral("-lbenchmark_main");
+        linkArgs << QStringLiteral("-lbenchmark")
+                 << QStringLiteral("-lbenchmark_main");
     }
 #ifndef Q_OS_WIN
-    args << QStringLiteral("-lpthread");
+    linkArgs << QStringLiteral("-lpthread");
 #endif
 
+    // Thread sweep: compile an edited copy, found its includes where the original is
+    QString compiledSource = sourceFile;
+    if (m_runOptions.threadSweepMax > 0) {
+        QFile original(sourceFile);
+        const QString sweptPath = m_tempDir->filePath(QStringLiteral("bench_threads.cpp"));
+        QFile swept(sweptPath);
+        if (!original.open(QIODevice::ReadOnly | QIODevice::Text)
+            || !swept.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            emit finished(false, {}, QStringLiteral("Failed to prepare the thread sweep."));
+            return;
+        }
+        const QString absolute = QFileInfo(sourceFile).absoluteFilePath();
+        QTextStream(&swept)
+            << QStringLiteral("#line 1 \"%1\"\n").arg(QDir::fromNativeSeparators(absolute))
+            << injectThreadRange(QString::fromUtf8(original.readAll()), m_runOptions.threadSweepMax);
+        swept.close();
+        compiledSource = sweptPath;
+        linkArgs << (QStringLiteral("-I") + QFileInfo(sourceFile).absolutePath());
+    }
+
+    // The allocation-counting memory manager is one more translation unit
+    QStringList sources{compiledSource};
+    QString shimStamp;
+    if (m_runOptions.trackAllocations) {
+        QFile shim(QStringLiteral(":/templates/benchmark_memory_manager.cpp"));
+        const QString shimPath = m_tempDir->filePath(QStringLiteral("cppatlas_memory_manager.cpp"));
+        QFile shimCopy(shimPath);
+        if (!shim.open(QIODevice::ReadOnly) || !shimCopy.open(QIODevice::WriteOnly)) {
+            emit finished(false, {}, QStringLiteral("Failed to set up allocation tracking."));
+            return;
+        }
+        const QByteArray shimSource = shim.readAll();
+        shimCopy.write(shimSource);
+        shimCopy.close();
+        sources << shimPath;
+        shimStamp = QStringLiteral("|allocs:") + QString::fromLatin1(
+            QCryptographicHash::hash(shimSource, QCryptographicHash::Sha1).toHex().left(12));
+    }
+
+    // A rebuilt libbenchmark.a must invalidate cached binaries, hence libStamp
+    m_cacheKey = ArtifactCache::keyForSource(
+        ArtifactCache::Kind::Executable, compiledSource, compiler->id(),
+        compiler->version() + QLatin1Char('|') + libStamp + shimStamp, linkArgs);
+
+    QByteArray cachedLog;
+    const QString cachedBinary = ArtifactCache::instance()->lookup(m_cacheKey, &cachedLog);
+    if (!cachedBinary.isEmpty()) {
+        const quint64 serial = m_runSerial;
+        const QString errText = QString::fromLocal8Bit(cachedLog);
+        emit progressMessage(QStringLiteral("Using cached benchmark binary..."));
+        emit started();
+        QTimer::singleShot(0, this, [this, serial, cachedBinary, errText]() {
+            if (serial != m_runSerial) return;   // cancelled or superseded
+            emit compilationFinished(true, errText);
+            startRun(cachedBinary);
+        });
+        return;
+    }
+
+    QStringList args;
+    args << sources
+         << QStringLiteral("-o") << m_tempBinaryPath;
+    args << linkArgs;
+
     m_compileProcess = new QProcess(this);
     m_compileProcess->setProcessChannelMode(QProcess::SeparateChannels);
 
@@ -138,7 +587,8 @@ void BenchmarkRunner::run(const QString& sourceFile, const QStringList& flags) {
 }
 
 void BenchmarkRunner::cancel() {
-    for (QProcess* p : {m_compileProcess, m_runProcess}) {
+    ++m_runSerial;
+    for (QProcess* p : {m_compileProcess, m_listProcess, m_runProcess}) {
         if (p && p->state() != QProcess::NotRunning) {
             p->kill();
             p->waitForFinished(1000);
@@ -146,6 +596,7 @@ void BenchmarkRunner::cancel() {
         }
     }
     m_compileProcess = nullptr;
+    m_listProcess    = nullptr;
     m_runProcess     = nullptr;
 }
 
@@ -159,6 +610,9 @@ void BenchmarkRunner::onCompileFinished(int exitCode, QProcess::ExitStatus statu
     m_compileProcess = nullptr;
 
     const bool ok = (status == QProcess::NormalExit && exitCode == 0);
+    if (ok) {
+        ArtifactCache::instance()->store(m_cacheKey, m_tempBinaryPath, errText.toLocal8Bit());
+    }
     emit compilationFinished(ok, errText);
 
     if (!ok) {
@@ -183,45 +637,266 @@ void BenchmarkRunner::onCompileError(QProcess::ProcessError) {
 // ── Phase 2: run ──────────────────────────────────────────────────────────────
 
 void BenchmarkRunner::startRun(const QString& binaryPath) {
+    m_binaryPath = binaryPath;
+    m_lastResult.options = m_runOptions;
+    m_adaptiveEntries.clear();
+    m_adaptiveCursor = 0;
+    m_runClock.start();
+    m_firstPassArgs = runArguments(m_runOptions);
+    m_finishedRuns.clear();
+    m_expectedRuns = 0;
+    m_firstPass    = true;
+    m_perfCountersNote.clear();
+
+    // Listing is instant and gives the progress total
+    m_listProcess = new QProcess(this);
+    m_listProcess->setProcessChannelMode(QProcess::SeparateChannels);
+    connect(m_listProcess,
+            QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &BenchmarkRunner::onListFinished);
+    connect(m_listProcess, &QProcess::errorOccurred,
+            this, [this](QProcess::ProcessError error) {
+                if (error == QProcess::FailedToStart) onListFinished(-1, QProcess::CrashExit);
+            });
+    m_listProcess->start(binaryPath, {QStringLiteral("--benchmark_list_tests=true")});
+}
+
+void BenchmarkRunner::onListFinished(int exitCode, QProcess::ExitStatus status) {
+    if (!m_listProcess) return;
+    if (status == QProcess::NormalExit && exitCode == 0) {
+        const QString listing = QString::fromUtf8(m_listProcess->readAllStandardOutput());
+        m_expectedRuns = int(listing.split(QLatin1Char('\n'), Qt::SkipEmptyParts).size());
+    }
+    m_listProcess->deleteLater();
+    m_listProcess = nullptr;
+    emit runProgress(0, m_expectedRuns);
+
+    const BenchmarkRunOptions& options = m_lastResult.options;
+    if (options.adaptive) {
+        emit progressMessage(QStringLiteral("Running benchmark (adaptive, first %1 repetitions)...")
+                                 .arg(qMax(options.repetitions, ADAPTIVE_MIN_REPETITIONS)));
+    } else {
+        emit progressMessage(options.repetitions > 1
+            ? QStringLiteral("Running benchmark (%1 repetitions)...").arg(options.repetitions)
+            : QStringLiteral("Running benchmark..."));
+    }
+    launchRun(m_firstPassArgs);
+}
+
+void BenchmarkRunner::launchRun(const QStringList& args) {
+    m_stream.reset();
+    m_appliedCpus.clear();
+    m_appliedNiceness = 0;
     m_runProcess = new QProcess(this);
     m_runProcess->setProcessChannelMode(QProcess::SeparateChannels);
 
+    connect(m_runProcess, &QProcess::readyReadStandardOutput,
+            this, &BenchmarkRunner::onRunOutput);
+
     connect(m_runProcess,
             QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
             this, &BenchmarkRunner::onRunFinished);
     connect(m_runProcess, &QProcess::errorOccurred,
             this, &BenchmarkRunner::onRunError);
 
-    emit progressMessage(QStringLiteral("Running benchmark..."));
-    m_runProcess->start(binaryPath,
-                        {QStringLiteral("--benchmark_format=json")});
+#ifdef Q_OS_LINUX
+    const BenchmarkRunOptions& options = m_lastResult.options;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (int cpu : options.pinnedCpus) CPU_SET(cpu, &cpus);
+    const bool pin   = !options.pinnedCpus.isEmpty();
+    const bool boost = options.raisePriority;
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    // Between fork and exec: the benchmark never runs unpinned
+    if (pin || boost) {
+        m_runProcess->setChildProcessModifier([cpus, pin, boost]() {
+            applyIsolation(0, cpus, pin, boost);
+        });
+    }
+    connect(m_runProcess, &QProcess::started, this, [this]() {
+        if (m_runProcess) recordIsolation(m_runProcess->processId());
+    });
+#endif
+#endif
+
+    QProcess* process = m_runProcess;
+    process->start(m_binaryPath,
+                   QStringList{QStringLiteral("--benchmark_format=json")} + args);
+
+#if defined(Q_OS_LINUX) && QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    // No pre-exec hook in Qt 5: isolate as soon as the process exists
+    if (process->waitForStarted(1000) && m_runProcess == process) {
+        if (pin || boost) applyIsolation(pid_t(process->processId()), cpus, pin, boost);
+        recordIsolation(process->processId());
+    }
+#endif
+}
+
+void BenchmarkRunner::recordIsolation(qint64 pid) {
+#ifdef Q_OS_LINUX
+    cpu_set_t own, child;
+    CPU_ZERO(&own);
+    CPU_ZERO(&child);
+    // An affinity the IDE itself already has (cgroup, taskset) is not pinning
+    if (sched_getaffinity(0, sizeof(own), &own) == 0
+        && sched_getaffinity(pid_t(pid), sizeof(child), &child) == 0
+        && !CPU_EQUAL(&own, &child)) {
+        QList<int> list;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &child)) list << cpu;
+        }
+        m_appliedCpus = formatCpuList(list);
+    }
+    errno = 0;
+    const int nice = getpriority(PRIO_PROCESS, id_t(pid));
+    if (errno == 0) m_appliedNiceness = nice;
+#else
+    Q_UNUSED(pid);
+#endif
+}
+
+void BenchmarkRunner::onRunOutput() {
+    if (!m_runProcess) return;
+    for (const QJsonObject& obj : m_stream.feed(m_runProcess->readAllStandardOutput())) {
+        const BenchmarkEntry entry = entryFromJson(obj);
+        emit entryReady(entry);
+        if (m_firstPass && !entry.isAggregate() && !m_finishedRuns.contains(entry.runName)) {
+            m_finishedRuns.insert(entry.runName);
+            emit runProgress(m_finishedRuns.size(), qMax(m_expectedRuns, m_finishedRuns.size()));
+        }
+    }
 }
 
 void BenchmarkRunner::onRunFinished(int exitCode, QProcess::ExitStatus status) {
     if (!m_runProcess) return;
-    const QString jsonOut =
-        QString::fromUtf8(m_runProcess->readAllStandardOutput());
+    onRunOutput();   // Whatever arrived after the last readyRead
+    m_firstPass = false;
+    const QString jsonOut = QString::fromUtf8(m_stream.data());
     const QString errText =
         QString::fromLocal8Bit(m_runProcess->readAllStandardError());
     m_runProcess->deleteLater();
     m_runProcess = nullptr;
 
     const bool ok = (status == QProcess::NormalExit && exitCode == 0);
-    if (ok) {
+    // Libraries before 1.8 abort when the counters cannot be set up or are
+    // more than three, and multi-threaded benchmarks refuse them: try once
+    // more without
+    if (!ok && m_lastResult.options.perfCounters
+        && (errText.contains(QLatin1String("Perf counters"))
+            || errText.contains(QLatin1String("perf_counters")))) {
+        m_perfCountersNote = perfCountersNote(errText, perfEventParanoid());
+        m_lastResult.options.perfCounters = false;
+        m_adaptiveEntries.clear();
+        m_firstPassArgs = runArguments(m_lastResult.options);
+        m_finishedRuns.clear();
+        m_firstPass = true;
+        emit runProgress(0, m_expectedRuns);
+        emit progressMessage(QStringLiteral("Hardware counters unavailable — running without them..."));
+        launchRun(m_firstPassArgs);
+        return;
+    }
+    if (ok && m_lastResult.options.adaptive) {
+        continueAdaptive(parseJsonOutput(jsonOut), errText);
+    } else if (ok) {
+        const BenchmarkRunOptions options = m_lastResult.options;
         m_lastResult = parseJsonOutput(jsonOut);
-        m_lastResult.rawJson           = jsonOut;
-        m_lastResult.compilerId        = m_compilerId;
-        m_lastResult.standard          = extractStandardFromFlags(m_compileFlags);
-        m_lastResult.optimizationLevel = extractOptFromFlags(m_compileFlags);
-        m_lastResult.success = true;
-        emit benchmarkResultReady(m_lastResult);
-        emit finished(true, jsonOut, errText);
+        m_lastResult.options = options;
+        deliverResult(jsonOut, errText);
     } else {
         m_lastResult.errorMessage = errText.isEmpty() ? jsonOut : errText;
         emit finished(false, {}, m_lastResult.errorMessage);
     }
 }
 
+void BenchmarkRunner::continueAdaptive(const BenchmarkResult& batch, const QString& errText) {
+    if (m_adaptiveEntries.isEmpty()) {
+        m_lastResult.date    = batch.date;
+        m_lastResult.context = batch.context;
+    }
+    appendRepetitions(m_adaptiveEntries, batch.benchmarks);
+
+    const BenchmarkRunOptions& options = m_lastResult.options;
+    const bool outOfTime = m_runClock.elapsed() >= qint64(options.timeBudgetSec * 1000.0);
+
+    const QList<BenchmarkSummary> summaries = BenchmarkStats::summarize(m_adaptiveEntries);
+    QList<int> unstable;
+    for (int i = 0; i < summaries.size(); ++i) {
+        const BenchmarkSummary& s = summaries[i];
+        BenchmarkConvergence c;
+        c.runName     = s.runName;
+        c.repetitions = s.repetitions;
+        c.cv          = s.cv;
+        c.ciWidth     = s.relativeCiWidth();
+        if (BenchmarkStats::isConverged(s, options)) {
+            c.state = BenchmarkConvergence::State::Converged;
+        } else if (s.repetitions >= options.maxRepetitions) {
+            c.state = BenchmarkConvergence::State::OutOfRepetitions;
+        } else if (outOfTime) {
+            c.state = BenchmarkConvergence::State::OutOfBudget;
+        } else {
+            unstable << i;
+        }
+        emit convergenceUpdated(c);
+    }
+
+    if (unstable.isEmpty()) {
+        QJsonArray arr;
+        for (const BenchmarkEntry& e : m_adaptiveEntries) arr.append(entryToJson(e));
+        QJsonObject context = contextToJson(m_lastResult.context);
+        context[QStringLiteral("date")] = m_lastResult.date;
+        QJsonObject root;
+        root[QStringLiteral("context")]    = context;
+        root[QStringLiteral("benchmarks")] = arr;
+
+        m_lastResult.benchmarks = m_adaptiveEntries;
+        deliverResult(QString::fromUtf8(QJsonDocument(root).toJson(QJsonDocument::Indented)),
+                      errText);
+        return;
+    }
+
+    // Round-robin, so one very noisy benchmark cannot starve the others
+    int next = unstable.first();
+    for (int i : unstable) {
+        if (i >= m_adaptiveCursor) { next = i; break; }
+    }
+    m_adaptiveCursor = next + 1;
+    const BenchmarkSummary& s = summaries[next];
+
+    BenchmarkRunOptions batchOptions;
+    batchOptions.repetitions  = qMin(ADAPTIVE_BATCH, options.maxRepetitions - s.repetitions);
+    batchOptions.minTimeSec   = options.minTimeSec;
+    batchOptions.perfCounters = options.perfCounters;
+
+    emit progressMessage(QStringLiteral("Sampling %1: %2 repetitions, CV %3% (%4 of %5 s)...")
+                             .arg(s.runName).arg(s.repetitions)
+                             .arg(s.cv * 100.0, 0, 'f', 1)
+                             .arg(m_runClock.elapsed() / 1000)
+                             .arg(options.timeBudgetSec, 0, 'f', 0));
+    QStringList args = runArguments(batchOptions);
+    args << QStringLiteral("--benchmark_filter=") + filterForRun(s.runName);
+    launchRun(args);
+}
+
+void BenchmarkRunner::deliverResult(const QString& rawJson, const QString& errText) {
+    m_lastResult.rawJson           = rawJson;
+    m_lastResult.compilerId        = m_compilerId;
+    m_lastResult.standard          = extractStandardFromFlags(m_compileFlags);
+    m_lastResult.optimizationLevel = extractOptFromFlags(m_compileFlags);
+    m_lastResult.context.pinnedCpus = m_appliedCpus;
+    m_lastResult.context.niceness   = m_appliedNiceness;
+    const QList<int>& pinned = m_lastResult.options.pinnedCpus;
+    m_lastResult.context.governor = readGovernor(pinned.isEmpty() ? 0 : pinned.first());
+    if (m_runOptions.perfCounters && m_perfCountersNote.isEmpty()
+        && std::none_of(m_lastResult.benchmarks.cbegin(), m_lastResult.benchmarks.cend(),
+                        [](const BenchmarkEntry& e) { return e.hasPerfCounters(); })) {
+        m_perfCountersNote = perfCountersNote(errText, perfEventParanoid());
+    }
+    m_lastResult.perfCountersNote = m_perfCountersNote;
+    m_lastResult.success = true;
+    emit benchmarkResultReady(m_lastResult);
+    emit finished(true, rawJson, errText);
+}
+
 void BenchmarkRunner::onRunError(QProcess::ProcessError) {
     emit finished(false, {},
                   QStringLiteral("Failed to start benchmark binary."));
@@ -233,7 +908,8 @@ void BenchmarkRunner::onRunError(QProcess::ProcessError) {
 
 // ── JSON parsing ──────────────────────────────────────────────────────────────
 
-BenchmarkResult BenchmarkRunner::parseJsonOutput(const QString& json) const {
+// static
+BenchmarkResult BenchmarkRunner::parseJsonOutput(const QString& json) {
     // Google Benchmark JSON:
     // { "context": { "date": "...", ... },
     //   "benchmarks": [ { "name":"BM_Foo", "real_time":42.0,
@@ -251,57 +927,136 @@ BenchmarkResult BenchmarkRunner::parseJsonOutput(const QString& json) const {
     }
 
     const QJsonObject root = doc.object();
-    result.date = root[QStringLiteral("context")]
-                      .toObject()[QStringLiteral("date")].toString();
+    const QJsonObject context = root[QStringLiteral("context")].toObject();
+    result.date    = context[QStringLiteral("date")].toString();
+    result.context = contextFromJson(context);
+
+    for (const QJsonValue& v :
+             root[QStringLiteral("benchmarks")].toArray()) {
+        result.benchmarks << entryFromJson(v.toObject());
+    }
+    return result;
+}
 
+// static
+BenchmarkEntry BenchmarkRunner::entryFromJson(const QJsonObject& obj) {
     static const QStringList knownKeys = {
         "name", "run_name", "run_type", "repetitions", "repetition_index",
         "threads", "iterations", "real_time", "cpu_time", "time_unit",
-        "error_occurred", "error_message"
+        "error_occurred", "error_message", "aggregate_name", "aggregate_unit",
+        "family_index", "per_family_instance_index",
+        "CYCLES", "INSTRUCTIONS", "CACHE-MISSES", "BRANCHES", "BRANCH-MISSES",
+        "allocs_per_iter", "total_allocated_bytes", "max_bytes_used", "net_heap_growth",
+        "big_o", "real_coefficient", "rms"
     };
 
-    for (const QJsonValue& v :
-             root[QStringLiteral("benchmarks")].toArray()) {
-        const QJsonObject obj = v.toObject();
-        BenchmarkEntry entry;
-        entry.name       = obj[QStringLiteral("name")].toString();
-        entry.realTimeNs = obj[QStringLiteral("real_time")].toDouble();
-        entry.cpuTimeNs  = obj[QStringLiteral("cpu_time")].toDouble();
-        entry.iterations =
-            static_cast<qint64>(obj[QStringLiteral("iterations")].toDouble());
-        entry.timeUnit   = obj[QStringLiteral("time_unit")].toString();
-
-        for (auto it = obj.begin(); it != obj.end(); ++it) {
-            if (!knownKeys.contains(it.key()))
-                entry.counters[it.key()] = it.value().toVariant();
-        }
-        result.benchmarks << entry;
+    BenchmarkEntry entry;
+    entry.name       = obj[QStringLiteral("name")].toString();
+    entry.realTimeNs = obj[QStringLiteral("real_time")].toDouble();
+    entry.cpuTimeNs  = obj[QStringLiteral("cpu_time")].toDouble();
+    entry.iterations =
+        static_cast<qint64>(obj[QStringLiteral("iterations")].toDouble());
+    entry.timeUnit   = obj[QStringLiteral("time_unit")].toString();
+
+    entry.runName         = obj[QStringLiteral("run_name")].toString(entry.name);
+    entry.runType         = obj[QStringLiteral("run_type")].toString(QStringLiteral("iteration"));
+    entry.aggregateName   = obj[QStringLiteral("aggregate_name")].toString();
+    entry.repetitions     = obj[QStringLiteral("repetitions")].toInt(1);
+    entry.repetitionIndex = obj[QStringLiteral("repetition_index")].toInt(0);
+    entry.familyIndex     = obj[QStringLiteral("family_index")].toInt(-1);
+    entry.instanceIndex   = obj[QStringLiteral("per_family_instance_index")].toInt(-1);
+    splitRunName(entry);
+
+    // Older output has no "threads" key, only the name part
+    static const QRegularExpression threadsPart(QStringLiteral("/threads:(\\d+)"));
+    const QRegularExpressionMatch threadsMatch = threadsPart.match(entry.runName);
+    entry.threads = obj[QStringLiteral("threads")].toInt(
+        threadsMatch.hasMatch() ? threadsMatch.captured(1).toInt() : 1);
+
+    entry.cycles       = obj[QStringLiteral("CYCLES")].toDouble(-1);
+    entry.instructions = obj[QStringLiteral("INSTRUCTIONS")].toDouble(-1);
+    entry.cacheMisses  = obj[QStringLiteral("CACHE-MISSES")].toDouble(-1);
+    entry.branches     = obj[QStringLiteral("BRANCHES")].toDouble(-1);
+    entry.branchMisses = obj[QStringLiteral("BRANCH-MISSES")].toDouble(-1);
+
+    entry.allocsPerIteration  = obj[QStringLiteral("allocs_per_iter")].toDouble(-1);
+    entry.totalAllocatedBytes =
+        static_cast<qint64>(obj[QStringLiteral("total_allocated_bytes")].toDouble(-1));
+    entry.maxBytesUsed  = static_cast<qint64>(obj[QStringLiteral("max_bytes_used")].toDouble(-1));
+    entry.netHeapGrowth = static_cast<qint64>(obj[QStringLiteral("net_heap_growth")].toDouble(-1));
+
+    entry.bigO            = obj[QStringLiteral("big_o")].toString();
+    entry.realCoefficient = obj[QStringLiteral("real_coefficient")].toDouble(-1);
+    entry.rms             = obj[QStringLiteral("rms")].toDouble(-1);
+
+    for (auto it = obj.begin(); it != obj.end(); ++it) {
+        if (!knownKeys.contains(it.key()))
+            entry.counters[it.key()] = it.value().toVariant();
     }
-    return result;
+    return entry;
+}
+
+// static
+QJsonObject BenchmarkRunner::entryToJson(const BenchmarkEntry& e) {
+    QJsonObject obj;
+    obj[QStringLiteral("name")]             = e.name;
+    obj[QStringLiteral("run_name")]         = e.runName.isEmpty() ? e.name : e.runName;
+    obj[QStringLiteral("run_type")]         = e.runType.isEmpty() ? QStringLiteral("iteration")
+                                                                  : e.runType;
+    obj[QStringLiteral("repetitions")]      = e.repetitions;
+    obj[QStringLiteral("repetition_index")] = e.repetitionIndex;
+    obj[QStringLiteral("threads")]          = e.threads;
+    if (e.familyIndex >= 0)
+        obj[QStringLiteral("family_index")]  = e.familyIndex;
+    if (e.instanceIndex >= 0)
+        obj[QStringLiteral("per_family_instance_index")] = e.instanceIndex;
+    if (e.isAggregate())
+        obj[QStringLiteral("aggregate_name")] = e.aggregateName;
+    obj[QStringLiteral("real_time")]        = e.realTimeNs;
+    obj[QStringLiteral("cpu_time")]         = e.cpuTimeNs;
+    obj[QStringLiteral("iterations")]       = e.iterations;
+    obj[QStringLiteral("time_unit")]        = e.timeUnit;
+    if (e.cycles       >= 0) obj[QStringLiteral("CYCLES")]        = e.cycles;
+    if (e.instructions >= 0) obj[QStringLiteral("INSTRUCTIONS")]  = e.instructions;
+    if (e.cacheMisses  >= 0) obj[QStringLiteral("CACHE-MISSES")]  = e.cacheMisses;
+    if (e.branches     >= 0) obj[QStringLiteral("BRANCHES")]      = e.branches;
+    if (e.branchMisses >= 0) obj[QStringLiteral("BRANCH-MISSES")] = e.branchMisses;
+    if (e.hasAllocations()) {
+        obj[QStringLiteral("allocs_per_iter")] = e.allocsPerIteration;
+        if (e.totalAllocatedBytes >= 0)
+            obj[QStringLiteral("total_allocated_bytes")] = double(e.totalAllocatedBytes);
+        if (e.maxBytesUsed >= 0)
+            obj[QStringLiteral("max_bytes_used")] = double(e.maxBytesUsed);
+        if (e.netHeapGrowth >= 0)
+            obj[QStringLiteral("net_heap_growth")] = double(e.netHeapGrowth);
+    }
+    if (!e.bigO.isEmpty())      obj[QStringLiteral("big_o")]            = e.bigO;
+    if (e.realCoefficient >= 0) obj[QStringLiteral("real_coefficient")] = e.realCoefficient;
+    if (e.rms >= 0)             obj[QStringLiteral("rms")]              = e.rms;
+    for (auto it = e.counters.cbegin(); it != e.counters.cend(); ++it)
+        obj[it.key()] = QJsonValue::fromVariant(it.value());
+    return obj;
 }
 
 // ── Export ────────────────────────────────────────────────────────────────────
 
 bool BenchmarkRunner::exportToJson(const QString& filePath) const {
     QJsonArray arr;
-    for (const BenchmarkEntry& e : m_lastResult.benchmarks) {
-        QJsonObject obj;
-        obj[QStringLiteral("name")]       = e.name;
-        obj[QStringLiteral("real_time")]  = e.realTimeNs;
-        obj[QStringLiteral("cpu_time")]   = e.cpuTimeNs;
-        obj[QStringLiteral("iterations")] = e.iterations;
-        obj[QStringLiteral("time_unit")]  = e.timeUnit;
-        arr.append(obj);
-    }
+    for (const BenchmarkEntry& e : m_lastResult.benchmarks)
+        arr.append(entryToJson(e));
     QJsonObject metadata;
     metadata[QStringLiteral("compilerId")]        = m_lastResult.compilerId;
     metadata[QStringLiteral("standard")]          = m_lastResult.standard;
     metadata[QStringLiteral("optimizationLevel")] = m_lastResult.optimizationLevel;
     metadata[QStringLiteral("source_file")]       = m_sourceFilePath;
+    metadata[QStringLiteral("repetitions")]       = m_lastResult.options.repetitions;
+    metadata[QStringLiteral("minTime")]           = m_lastResult.options.minTimeSec;
+    metadata[QStringLiteral("randomInterleaving")] = m_lastResult.options.randomInterleaving;
 
     QJsonObject root;
     root[QStringLiteral("date")]       = m_lastResult.date;
     root[QStringLiteral("metadata")]   = metadata;
+    root[QStringLiteral("context")]    = contextToJson(m_lastResult.context);
     root[QStringLiteral("benchmarks")] = arr;
 
     QFile f(filePath);
@@ -314,13 +1069,15 @@ bool BenchmarkRunner::exportToCsv(const QString& filePath) const {
     QFile f(filePath);
     if (!f.open(QIODevice::WriteOnly | QIODevice::Text)) return false;
     QTextStream out(&f);
-    out << "name,real_time_ns,cpu_time_ns,iterations,time_unit\n";
+    out << "name,run_type,repetition_index,real_time_ns,cpu_time_ns,iterations,time_unit\n";
     for (const BenchmarkEntry& e : m_lastResult.benchmarks) {
-        out << e.name       << ","
-            << e.realTimeNs << ","
-            << e.cpuTimeNs  << ","
-            << e.iterations << ","
-            << e.timeUnit   << "\n";
+        out << e.name            << ","
+            << (e.isAggregate() ? e.aggregateName : QStringLiteral("iteration")) << ","
+            << e.repetitionIndex << ","
+            << e.realTimeNs      << ","
+            << e.cpuTimeNs       << ","
+            << e.iterations      << ","
+            << e.timeUnit        << "\n";
     }
     return true;
 }
@@ -347,17 +1104,12 @@ BenchmarkResult BenchmarkRunner::loadFromJson(const QString& filePath) const {
     result.label = result.optimizationLevel.isEmpty()
                    ? QFileInfo(filePath).fileName()
                    : result.optimizationLevel;
+    result.options.repetitions        = meta[QStringLiteral("repetitions")].toInt(1);
+    result.options.minTimeSec         = meta[QStringLiteral("minTime")].toDouble();
+    result.options.randomInterleaving = meta[QStringLiteral("randomInterleaving")].toBool();
+    result.context = contextFromJson(root[QStringLiteral("context")].toObject());
 
-    for (const QJsonValue& v : root[QStringLiteral("benchmarks")].toArray()) {
-        const QJsonObject obj = v.toObject();
-        BenchmarkEntry entry;
-        entry.name       = obj[QStringLiteral("name")].toString();
-        entry.realTimeNs = obj[QStringLiteral("real_time")].toDouble();
-        entry.cpuTimeNs  = obj[QStringLiteral("cpu_time")].toDouble();
-        entry.iterations =
-            static_cast<qint64>(obj[QStringLiteral("iterations")].toDouble());
-        entry.timeUnit   = obj[QStringLiteral("time_unit")].toString();
-        result.benchmarks << entry;
-    }
+    for (const QJsonValue& v : root[QStringLiteral("benchmarks")].toArray())
+        result.benchmarks << entryFromJson(v.toObject());
     return result;
 }
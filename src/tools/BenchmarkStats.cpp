@@ -0,0 +1,629 @@
+#include "tools/BenchmarkStats.h"
+
+#include <QHash>
+#include <QRandomGenerator>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Exact U distribution table grows as n1 · n2 · (n1 · n2); past this the
+// normal approximation is already good
+constexpr int EXACT_MAX_SAMPLES = 20;
+
+/// Ranks of @p values (1-based, ties get their average rank)
+QList<double> averageRanks(const QList<double>& values, bool* hasTies) {
+    QList<int> order;
+    for (int i = 0; i < values.size(); ++i) order << i;
+    std::sort(order.begin(), order.end(),
+              [&](int a, int b) { return values[a] < values[b]; });
+
+    QList<double> ranks;
+    for (int i = 0; i < values.size(); ++i) ranks << 0.0;
+    *hasTies = false;
+    for (int i = 0; i < order.size();) {
+        int j = i + 1;
+        while (j < order.size() && values[order[j]] == values[order[i]]) ++j;
+        if (j - i > 1) *hasTies = true;
+        const double rank = (i + 1 + j) / 2.0;   // mean of ranks i+1 .. j
+        for (int k = i; k < j; ++k) ranks[order[k]] = rank;
+        i = j;
+    }
+    return ranks;
+}
+
+/// P(U ≤ u) for samples of @p n1 and @p n2 without ties
+double exactUCdf(int n1, int n2, int u) {
+    // counts[m][n][k]: orderings of m + n values whose U equals k,
+    // built with f(m, n, k) = f(m − 1, n, k − n) + f(m, n − 1, k)
+    std::vector<std::vector<std::vector<double>>> counts(
+        n1 + 1, std::vector<std::vector<double>>(n2 + 1));
+    for (int m = 0; m <= n1; ++m) {
+        for (int n = 0; n <= n2; ++n) {
+            std::vector<double>& f = counts[m][n];
+            f.assign(m * n + 1, 0.0);
+            if (m == 0 || n == 0) { f[0] = 1.0; continue; }
+            const std::vector<double>& withoutA = counts[m - 1][n];
+            const std::vector<double>& withoutB = counts[m][n - 1];
+            for (int k = 0; k <= m * n; ++k) {
+                if (k - n >= 0 && k - n < int(withoutA.size())) f[k] += withoutA[k - n];
+                if (k < int(withoutB.size()))                   f[k] += withoutB[k];
+            }
+        }
+    }
+    const std::vector<double>& f = counts[n1][n2];
+    double total = 0.0, below = 0.0;
+    for (int k = 0; k < int(f.size()); ++k) {
+        total += f[k];
+        if (k <= u) below += f[k];
+    }
+    return below / total;
+}
+
+QList<double> toNanoseconds(const QList<double>& values, const QString& unit) {
+    QList<double> out;
+    for (double v : values) out << BenchmarkStats::toNanoseconds(v, unit);
+    return out;
+}
+
+/// Median of @p values drawn with replacement, as many draws as values
+double resampledMedian(const QList<double>& values, QRandomGenerator& rng, QList<double>& sample) {
+    sample.clear();
+    for (int i = 0; i < values.size(); ++i) {
+        sample << values[int(rng.bounded(quint32(values.size())))];
+    }
+    return BenchmarkStats::median(sample);
+}
+
+/// Central @p confidence interval of the bootstrap @p estimates
+QPair<double, double> percentileInterval(QList<double> estimates, double confidence) {
+    std::sort(estimates.begin(), estimates.end());
+    const int last = estimates.size() - 1;
+    const double tail = (1.0 - confidence) / 2.0;
+    const int low  = qBound(0, int(std::floor(tail * last)), last);
+    const int high = qBound(0, int(std::ceil((1.0 - tail) * last)), last);
+    return { estimates[low], estimates[high] };
+}
+
+} // namespace
+
+QString BenchmarkComparison::verdictText(Verdict verdict) {
+    switch (verdict) {
+    case Verdict::Faster:                  return QStringLiteral("Faster");
+    case Verdict::Slower:                  return QStringLiteral("Slower");
+    case Verdict::NoSignificantDifference: return QStringLiteral("No significant difference");
+    case Verdict::InsufficientData:        return QStringLiteral("Needs ≥ 2 repetitions");
+    }
+    return QString();
+}
+
+double ComplexityFit::complexity(double n) const {
+    if (bigO == QLatin1String("(1)"))  return 1.0;
+    if (bigO == QLatin1String("N"))    return n;
+    if (bigO == QLatin1String("N^2"))  return n * n;
+    if (bigO == QLatin1String("N^3"))  return n * n * n;
+    if (bigO == QLatin1String("lgN"))  return std::log2(n);
+    if (bigO == QLatin1String("NlgN")) return n * std::log2(n);
+    return -1.0;
+}
+
+// ── Descriptive statistics ────────────────────────────────────────────────────
+
+double BenchmarkStats::mean(const QList<double>& values) {
+    if (values.isEmpty()) return 0.0;
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    return sum / values.size();
+}
+
+double BenchmarkStats::median(QList<double> values) {
+    if (values.isEmpty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const int mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+}
+
+double BenchmarkStats::stddev(const QList<double>& values) {
+    if (values.size() < 2) return 0.0;
+    const double m = mean(values);
+    double sum = 0.0;
+    for (double v : values) sum += (v - m) * (v - m);
+    return std::sqrt(sum / (values.size() - 1));
+}
+
+QPair<double, double> BenchmarkStats::bootstrapMedianCi(const QList<double>& values,
+                                                        double confidence,
+                                                        int resamples,
+                                                        quint32 seed) {
+    const double point = median(values);
+    if (values.size() < 2 || resamples < 2) return { point, point };
+
+    QRandomGenerator rng(seed);
+    QList<double> medians;
+    QList<double> sample;
+    for (int r = 0; r < resamples; ++r) {
+        medians << resampledMedian(values, rng, sample);
+    }
+    return percentileInterval(medians, confidence);
+}
+
+QPair<double, double> BenchmarkStats::bootstrapMedianRatioCi(const QList<double>& reference,
+                                                             const QList<double>& contender,
+                                                             double confidence,
+                                                             int resamples,
+                                                             quint32 seed) {
+    const double point = median(reference) / median(contender);
+    if (reference.size() < 2 || contender.size() < 2 || resamples < 2) return { point, point };
+
+    QRandomGenerator rng(seed);
+    QList<double> ratios;
+    QList<double> sample;
+    for (int r = 0; r < resamples; ++r) {
+        const double referenceMedian = resampledMedian(reference, rng, sample);
+        ratios << referenceMedian / resampledMedian(contender, rng, sample);
+    }
+    return percentileInterval(ratios, confidence);
+}
+
+// ── Mann-Whitney U ────────────────────────────────────────────────────────────
+
+MannWhitneyResult BenchmarkStats::mannWhitneyU(const QList<double>& a, const QList<double>& b) {
+    MannWhitneyResult result;
+    const int n1 = a.size();
+    const int n2 = b.size();
+    if (n1 < 2 || n2 < 2) return result;
+    result.valid = true;
+
+    bool ties = false;
+    const QList<double> ranks = averageRanks(a + b, &ties);
+    double rankSumA = 0.0;
+    for (int i = 0; i < n1; ++i) rankSumA += ranks[i];
+    result.u = rankSumA - n1 * (n1 + 1) / 2.0;
+
+    const double n1n2 = double(n1) * n2;
+    if (!ties && n1 <= EXACT_MAX_SAMPLES && n2 <= EXACT_MAX_SAMPLES) {
+        // Two-sided: double the smaller tail; the distribution is symmetric
+        const int smaller = int(std::lround(qMin(result.u, n1n2 - result.u)));
+        result.exact  = true;
+        result.pValue = qMin(1.0, 2.0 * exactUCdf(n1, n2, smaller));
+        return result;
+    }
+
+    // Normal approximation with tie and continuity correction (as scipy)
+    const int n = n1 + n2;
+    QList<double> sorted = ranks;
+    std::sort(sorted.begin(), sorted.end());
+    double tieTerm = 0.0;
+    for (int i = 0; i < sorted.size();) {
+        int j = i + 1;
+        while (j < sorted.size() && sorted[j] == sorted[i]) ++j;
+        const double t = j - i;
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+    const double sigma = std::sqrt(n1n2 / 12.0 * ((n + 1) - tieTerm / (double(n) * (n - 1))));
+    if (sigma <= 0.0) return result;   // Every value equal: p stays 1
+
+    const double z = (std::fabs(result.u - n1n2 / 2.0) - 0.5) / sigma;
+    result.pValue = z <= 0.0 ? 1.0 : qMin(1.0, std::erfc(z / std::sqrt(2.0)));
+    return result;
+}
+
+// ── Summaries ─────────────────────────────────────────────────────────────────
+
+QList<BenchmarkSummary> BenchmarkStats::summarize(const QList<BenchmarkEntry>& entries) {
+    QList<BenchmarkSummary> summaries;
+    QHash<QString, int> index;                    // run name -> summaries index
+    QHash<QString, QHash<QString, BenchmarkEntry>> aggregates;
+
+    auto summaryFor = [&](const BenchmarkEntry& e) -> BenchmarkSummary& {
+        const QString run = e.runName.isEmpty() ? e.name : e.runName;
+        auto it = index.constFind(run);
+        if (it != index.constEnd()) return summaries[it.value()];
+        BenchmarkSummary s;
+        s.runName  = run;
+        s.timeUnit = e.timeUnit.isEmpty() ? QStringLiteral("ns") : e.timeUnit;
+        index.insert(run, summaries.size());
+        summaries << s;
+        return summaries.last();
+    };
+
+    // Counters per run name, one value per repetition that has them
+    struct CounterSamples {
+        QList<double> cycles, instructions, cacheMisses, branches, branchMisses;
+        QList<double> allocs, bytes, peak;
+    };
+    QHash<QString, CounterSamples> counterSamples;
+
+    static const QStringList statAggregates = {
+        QStringLiteral("mean"), QStringLiteral("median"),
+        QStringLiteral("stddev"), QStringLiteral("cv")
+    };
+
+    for (const BenchmarkEntry& e : entries) {
+        if (e.isAggregate()) {
+            // BigO / RMS and user-defined statistics are not repetition summaries
+            if (!statAggregates.contains(e.aggregateName)) continue;
+            BenchmarkSummary& s = summaryFor(e);
+            aggregates[s.runName].insert(e.aggregateName, e);
+            s.repetitions = qMax(s.repetitions, e.repetitions);
+            continue;
+        }
+        BenchmarkSummary& s = summaryFor(e);
+        if (s.realTimes.isEmpty()) s.iterations = e.iterations;
+        s.realTimes << e.realTimeNs;
+        s.cpuTimes  << e.cpuTimeNs;
+        if (e.hasAllocations()) {
+            CounterSamples& c = counterSamples[s.runName];
+            c.allocs << e.allocsPerIteration;
+            if (e.totalAllocatedBytes >= 0) c.bytes << e.bytesPerIteration();
+            if (e.maxBytesUsed        >= 0) c.peak  << double(e.maxBytesUsed);
+        }
+        if (e.hasPerfCounters()) {
+            CounterSamples& c = counterSamples[s.runName];
+            if (e.cycles       >= 0.0) c.cycles       << e.cycles;
+            if (e.instructions >= 0.0) c.instructions << e.instructions;
+            if (e.cacheMisses  >= 0.0) c.cacheMisses  << e.cacheMisses;
+            if (e.branches     >= 0.0) c.branches     << e.branches;
+            if (e.branchMisses >= 0.0) c.branchMisses << e.branchMisses;
+        }
+    }
+
+    auto medianOrMissing = [](const QList<double>& values) {
+        return values.isEmpty() ? -1.0 : median(values);
+    };
+
+    for (BenchmarkSummary& s : summaries) {
+        if (!s.realTimes.isEmpty()) {
+            s.repetitions = s.realTimes.size();
+            s.mean        = mean(s.realTimes);
+            s.median      = median(s.realTimes);
+            s.stddev      = stddev(s.realTimes);
+            s.cv          = s.mean > 0.0 ? s.stddev / s.mean : 0.0;
+            s.cpuMedian   = median(s.cpuTimes);
+            const QPair<double, double> ci = bootstrapMedianCi(s.realTimes);
+            s.ciLow  = ci.first;
+            s.ciHigh = ci.second;
+
+            const CounterSamples c = counterSamples.value(s.runName);
+            s.cycles       = medianOrMissing(c.cycles);
+            s.instructions = medianOrMissing(c.instructions);
+            s.cacheMisses  = medianOrMissing(c.cacheMisses);
+            s.branches     = medianOrMissing(c.branches);
+            s.branchMisses = medianOrMissing(c.branchMisses);
+            s.allocsPerIteration = medianOrMissing(c.allocs);
+            s.bytesPerIteration  = medianOrMissing(c.bytes);
+            s.peakBytes          = medianOrMissing(c.peak);
+            continue;
+        }
+
+        // --benchmark_report_aggregates_only: the library's numbers are all there is
+        const QHash<QString, BenchmarkEntry> agg = aggregates.value(s.runName);
+        const BenchmarkEntry meanRow   = agg.value(QStringLiteral("mean"));
+        const BenchmarkEntry medianRow = agg.value(QStringLiteral("median"),
+                                                   meanRow);
+        s.mean      = meanRow.realTimeNs;
+        s.median    = medianRow.realTimeNs;
+        s.cpuMedian = medianRow.cpuTimeNs;
+        s.stddev    = agg.value(QStringLiteral("stddev")).realTimeNs;
+        s.cv        = agg.contains(QStringLiteral("cv"))
+                          ? agg.value(QStringLiteral("cv")).realTimeNs
+                          : (s.mean > 0.0 ? s.stddev / s.mean : 0.0);
+        s.ciLow  = s.median;
+        s.ciHigh = s.median;
+        s.cycles       = medianRow.cycles;
+        s.instructions = medianRow.instructions;
+        s.cacheMisses  = medianRow.cacheMisses;
+        s.branches     = medianRow.branches;
+        s.branchMisses = medianRow.branchMisses;
+        s.allocsPerIteration = medianRow.allocsPerIteration;
+        s.bytesPerIteration  = medianRow.bytesPerIteration();
+        s.peakBytes          = double(medianRow.maxBytesUsed);
+    }
+    return summaries;
+}
+
+double BenchmarkStats::metricValue(const BenchmarkSummary& summary, BenchmarkMetric metric) {
+    switch (metric) {
+    case BenchmarkMetric::RealTime:       return summary.median;
+    case BenchmarkMetric::Ipc:            return summary.ipc();
+    case BenchmarkMetric::CacheMisses:    return summary.cacheMisses;
+    case BenchmarkMetric::BranchMissRate: {
+        const double rate = summary.branchMissRate();
+        return rate < 0.0 ? rate : rate * 100.0;
+    }
+    case BenchmarkMetric::Allocations:    return summary.allocsPerIteration;
+    case BenchmarkMetric::BytesAllocated: return summary.bytesPerIteration;
+    }
+    return -1.0;
+}
+
+QString BenchmarkStats::metricTitle(BenchmarkMetric metric, const QString& timeUnit) {
+    switch (metric) {
+    case BenchmarkMetric::RealTime:       return QStringLiteral("Real Time (%1)").arg(timeUnit);
+    case BenchmarkMetric::Ipc:            return QStringLiteral("Instructions per Cycle");
+    case BenchmarkMetric::CacheMisses:    return QStringLiteral("Cache Misses per Iteration");
+    case BenchmarkMetric::BranchMissRate: return QStringLiteral("Branch Mispredict Rate (%)");
+    case BenchmarkMetric::Allocations:    return QStringLiteral("Allocations per Iteration");
+    case BenchmarkMetric::BytesAllocated: return QStringLiteral("Bytes Allocated per Iteration");
+    }
+    return QString();
+}
+
+QList<ScalingSeries> BenchmarkStats::scaling(const QList<BenchmarkEntry>& entries) {
+    QHash<QString, int> threadsOf;     // run name -> thread count
+    for (const BenchmarkEntry& e : entries) {
+        if (!e.isAggregate()) threadsOf.insert(e.runName.isEmpty() ? e.name : e.runName, e.threads);
+    }
+
+    QList<ScalingSeries> series;
+    QHash<QString, int> index;         // scaling name -> series index
+    for (const BenchmarkSummary& s : summarize(entries)) {
+        BenchmarkEntry probe;
+        probe.runName = s.runName;
+        const QString name = probe.scalingName();
+        if (!index.contains(name)) {
+            index.insert(name, series.size());
+            series << ScalingSeries{name, {}, -1};
+        }
+        ScalingPoint p;
+        p.threads    = threadsOf.value(s.runName, 1);
+        p.timeNs     = toNanoseconds(s.median, s.timeUnit);
+        p.throughput = p.timeNs > 0.0 ? 1e9 / p.timeNs : 0.0;
+        series[index.value(name)].points << p;
+    }
+
+    QList<ScalingSeries> scaled;
+    for (ScalingSeries& s : series) {
+        if (s.points.size() < 2) continue;
+        std::sort(s.points.begin(), s.points.end(),
+                  [](const ScalingPoint& a, const ScalingPoint& b) { return a.threads < b.threads; });
+        const ScalingPoint base = s.points.first();
+        for (ScalingPoint& p : s.points) {
+            p.speedup    = base.throughput > 0.0 ? p.throughput / base.throughput : 0.0;
+            p.efficiency = p.speedup * base.threads / p.threads;
+        }
+        s.serialFraction = fitAmdahl(s.points);
+        scaled << s;
+    }
+    return scaled;
+}
+
+double BenchmarkStats::fitAmdahl(const QList<ScalingPoint>& points) {
+    if (points.isEmpty() || points.first().threads != 1) return -1.0;
+    // 1/S − x = s·(1 − x) with x = 1/n: a line through the origin
+    double sxy = 0.0, sxx = 0.0;
+    for (const ScalingPoint& p : points) {
+        if (p.threads <= 1 || p.speedup <= 0.0) continue;
+        const double x = 1.0 - 1.0 / p.threads;
+        const double y = 1.0 / p.speedup - 1.0 / p.threads;
+        sxy += x * y;
+        sxx += x * x;
+    }
+    if (sxx <= 0.0) return -1.0;
+    return qBound(0.0, sxy / sxx, 1.0);
+}
+
+// ── Parameter sweeps ──────────────────────────────────────────────────────────
+
+QList<ComplexityFit> BenchmarkStats::complexityFits(const QList<BenchmarkEntry>& entries) {
+    QList<ComplexityFit> fits;
+    QHash<QString, int> index;         // run name -> fits index
+    for (const BenchmarkEntry& e : entries) {
+        if (!e.isAggregate() || !e.isComplexityFit()) continue;
+        const QString run = e.runName.isEmpty() ? e.name : e.runName;
+        if (!index.contains(run)) {
+            index.insert(run, fits.size());
+            ComplexityFit fit;
+            fit.runName = run;
+            fits << fit;
+        }
+        ComplexityFit& fit = fits[index.value(run)];
+        if (e.aggregateName == QLatin1String("BigO")) {
+            fit.bigO = e.bigO;
+            if (e.realCoefficient >= 0.0)
+                fit.coefficientNs = toNanoseconds(e.realCoefficient, e.timeUnit);
+        } else {
+            fit.rms = e.rms;
+        }
+    }
+    return fits;
+}
+
+QList<ParameterSweep> BenchmarkStats::sweeps(const QList<BenchmarkEntry>& entries) {
+    QHash<QString, const BenchmarkEntry*> entryOf;     // run name -> first repetition
+    for (const BenchmarkEntry& e : entries) {
+        const QString run = e.runName.isEmpty() ? e.name : e.runName;
+        if (!e.isAggregate() && !entryOf.contains(run)) entryOf.insert(run, &e);
+    }
+
+    struct Group {
+        QString                 family;
+        QStringList             parts;      // run_name split at '/', arguments masked
+        QList<int>              argParts;   // parts index of each argument
+        QStringList             argNames;
+        QList<QList<qint64>>    args;       // one per summary
+        QList<BenchmarkSummary> summaries;
+    };
+    QList<Group> groups;
+    QHash<QString, int> index;         // masked name -> groups index
+    for (const BenchmarkSummary& s : summarize(entries)) {
+        const BenchmarkEntry* e = entryOf.value(s.runName);
+        if (!e || e->args.isEmpty()) continue;
+        QStringList parts = s.runName.split(QLatin1Char('/'));
+        QList<int> argParts;
+        for (int i = 1; i < parts.size() && argParts.size() < e->args.size(); ++i) {
+            const int k = argParts.size();
+            const QString prefix = e->argNames.value(k).isEmpty()
+                                       ? QString() : e->argNames[k] + QLatin1Char(':');
+            if (parts[i] != prefix + QString::number(e->args[k])) continue;
+            parts[i] = prefix + QLatin1Char('*');
+            argParts << i;
+        }
+        if (argParts.size() != e->args.size()) continue;
+
+        const QString key = parts.join(QLatin1Char('/'));
+        if (!index.contains(key)) {
+            index.insert(key, groups.size());
+            groups << Group{e->family, parts, argParts, e->argNames, {}, {}};
+        }
+        Group& g = groups[index.value(key)];
+        g.args << e->args;
+        g.summaries << s;
+    }
+
+    const QList<ComplexityFit> fits = complexityFits(entries);
+    QList<ParameterSweep> sweeps;
+    for (const Group& g : groups) {
+        if (g.summaries.size() < 2) continue;
+        ParameterSweep sweep;
+        sweep.family = g.family;
+
+        // Arguments equal in every run go back into the name
+        QList<int>  varying;
+        QStringList nameParts = g.parts;
+        for (int k = 0; k < g.argParts.size(); ++k) {
+            const qint64 first = g.args.first()[k];
+            const bool varies = std::any_of(g.args.cbegin(), g.args.cend(),
+                                            [&](const QList<qint64>& a) { return a[k] != first; });
+            if (varies) {
+                varying << k;
+                sweep.dimensions << (g.argNames.value(k).isEmpty()
+                                         ? QStringLiteral("range(%1)").arg(k) : g.argNames[k]);
+            } else {
+                QString& part = nameParts[g.argParts[k]];
+                part = part.left(part.size() - 1) + QString::number(first);
+            }
+        }
+        sweep.name = nameParts.join(QLatin1Char('/'));
+
+        for (int i = 0; i < g.summaries.size(); ++i) {
+            SweepPoint p;
+            for (int k : varying) p.coords << g.args[i][k];
+            p.summary = g.summaries[i];
+            sweep.points << p;
+        }
+        std::sort(sweep.points.begin(), sweep.points.end(),
+                  [](const SweepPoint& a, const SweepPoint& b) {
+                      return std::lexicographical_compare(a.coords.cbegin(), a.coords.cend(),
+                                                          b.coords.cbegin(), b.coords.cend());
+                  });
+
+        // The BigO row's run_name drops every argument; its N is the one that varies
+        if (varying.size() == 1) {
+            QStringList bare = g.parts;
+            for (int k = g.argParts.size() - 1; k >= 0; --k) bare.removeAt(g.argParts[k]);
+            const QString fitName = bare.join(QLatin1Char('/'));
+            for (const ComplexityFit& fit : fits) {
+                if (fit.runName == fitName) {
+                    sweep.fit = fit;
+                    break;
+                }
+            }
+        }
+        sweeps << sweep;
+    }
+    return sweeps;
+}
+
+QList<int> BenchmarkStats::downsample(const QList<QPointF>& points, int maxPoints) {
+    const int n = points.size();
+    QList<int> kept;
+    if (maxPoints < 3 || n <= maxPoints) {
+        for (int i = 0; i < n; ++i) kept << i;
+        return kept;
+    }
+
+    // Bucket b covers [bucketStart(b), bucketStart(b + 1)); integer bounds end exactly at n − 1
+    const qint64 buckets = maxPoints - 2;
+    auto bucketStart = [&](qint64 b) { return int(1 + b * (n - 2) / buckets); };
+
+    kept << 0;
+    int previous = 0;
+    for (qint64 b = 0; b < buckets; ++b) {
+        // Third corner: mean of the next bucket, or the last point
+        QPointF next = points[n - 1];
+        if (b + 1 < buckets) {
+            const int from = bucketStart(b + 1);
+            const int to   = bucketStart(b + 2);
+            double x = 0.0, y = 0.0;
+            for (int i = from; i < to; ++i) {
+                x += points[i].x();
+                y += points[i].y();
+            }
+            next = QPointF(x / (to - from), y / (to - from));
+        }
+
+        const QPointF& a = points[previous];
+        double bestArea = -1.0;
+        int    pick     = bucketStart(b);
+        for (int i = bucketStart(b); i < bucketStart(b + 1); ++i) {
+            const double area = std::abs((a.x() - next.x()) * (points[i].y() - a.y())
+                                         - (a.x() - points[i].x()) * (next.y() - a.y()));
+            if (area > bestArea) {
+                bestArea = area;
+                pick     = i;
+            }
+        }
+        kept << pick;
+        previous = pick;
+    }
+    kept << n - 1;
+    return kept;
+}
+
+bool BenchmarkStats::isConverged(const BenchmarkSummary& summary,
+                                 const BenchmarkRunOptions& options) {
+    if (summary.realTimes.size() < 2) return false;
+    return summary.cv <= options.targetCv
+        || summary.relativeCiWidth() <= options.targetCiWidth;
+}
+
+// ── Comparison ────────────────────────────────────────────────────────────────
+
+QList<BenchmarkComparison> BenchmarkStats::compare(const BenchmarkResult& baseline,
+                                                   const BenchmarkResult& contender,
+                                                   double alpha) {
+    const QList<BenchmarkSummary> before = summarize(baseline.benchmarks);
+    QHash<QString, int> beforeIndex;
+    for (int i = 0; i < before.size(); ++i) beforeIndex.insert(before[i].runName, i);
+
+    QList<BenchmarkComparison> comparisons;
+    for (const BenchmarkSummary& after : summarize(contender.benchmarks)) {
+        const auto it = beforeIndex.constFind(after.runName);
+        if (it == beforeIndex.constEnd()) continue;
+        const BenchmarkSummary& base = before[it.value()];
+
+        BenchmarkComparison c;
+        c.runName     = after.runName;
+        c.baselineNs  = toNanoseconds(base.median, base.timeUnit);
+        c.contenderNs = toNanoseconds(after.median, after.timeUnit);
+        c.change      = c.baselineNs > 0.0 ? (c.contenderNs - c.baselineNs) / c.baselineNs : 0.0;
+        c.baselineRepetitions  = base.repetitions;
+        c.contenderRepetitions = after.repetitions;
+
+        const MannWhitneyResult test = mannWhitneyU(toNanoseconds(base.realTimes, base.timeUnit),
+                                                    toNanoseconds(after.realTimes, after.timeUnit));
+        if (!test.valid) {
+            c.verdict = BenchmarkComparison::Verdict::InsufficientData;
+        } else {
+            c.pValue = test.pValue;
+            if (test.pValue >= alpha)
+                c.verdict = BenchmarkComparison::Verdict::NoSignificantDifference;
+            else
+                c.verdict = c.contenderNs < c.baselineNs ? BenchmarkComparison::Verdict::Faster
+                                                         : BenchmarkComparison::Verdict::Slower;
+        }
+        comparisons << c;
+    }
+    return comparisons;
+}
+
+double BenchmarkStats::toNanoseconds(double value, const QString& unit) {
+    if (unit == QLatin1String("us")) return value * 1e3;
+    if (unit == QLatin1String("ms")) return value * 1e6;
+    if (unit == QLatin1String("s"))  return value * 1e9;
+    return value;
+}
@@ -0,0 +1,304 @@
+#include "tools/BuildBenchRunner.h"
+#include "tools/ProcessMeter.h"
+#include "compiler/CompilerRegistry.h"
+#include "core/ThreadPoolTask.h"
+
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QVector>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+QString firstErrorLine(const ProcessUsage& usage) {
+    if (!usage.started) {
+        return QStringLiteral("Failed to start compiler: ") + usage.errorString;
+    }
+    if (usage.timedOut) return QStringLiteral("Compiler timed out.");
+    if (usage.crashed)  return QStringLiteral("Compiler crashed.");
+
+    const QStringList lines = QString::fromUtf8(usage.standardError).split('\n');
+    for (const QString& line : lines) {
+        if (line.contains(QLatin1String("error"))) return line.trimmed();
+    }
+    return lines.isEmpty() || lines.first().trimmed().isEmpty()
+        ? QStringLiteral("Compiler exited with code %1.").arg(usage.exitCode)
+        : lines.first().trimmed();
+}
+
+} // namespace
+
+struct BuildBenchRunner::SharedState {
+    struct Command {
+        QString program;
+        QStringList arguments;
+    };
+
+    QVector<Command> commands;    // Per case; read-only once workers start
+    QString objectDir;
+
+    QMutex mutex;
+    QList<WorkItem> queue;        // Guarded by mutex
+    QSet<int> failedCases;        // Guarded by mutex
+    std::atomic_bool cancel { false };
+};
+
+BuildBenchRunner::BuildBenchRunner(QObject* parent)
+    : QObject(parent)
+{
+}
+
+BuildBenchRunner::~BuildBenchRunner() {
+    if (m_state) {
+        m_state->cancel = true;
+    }
+    m_pool.waitForDone();
+}
+
+bool BuildBenchRunner::start(const BuildBenchConfig& config) {
+    if (m_running || config.snippets.isEmpty() || config.compilerIds.isEmpty()
+        || config.standards.isEmpty() || config.optimizationLevels.isEmpty()
+        || config.repetitions < 1) {
+        return false;
+    }
+
+    m_workDir.reset(new QTemporaryDir(QDir::tempPath() + QStringLiteral("/cppatlas_buildbench_XXXXXX")));
+    if (!m_workDir->isValid()) {
+        emit progressMessage(QStringLiteral("Build Bench: cannot create a temporary directory."));
+        return false;
+    }
+
+    QStringList snippetFiles;
+    for (int i = 0; i < config.snippets.size(); ++i) {
+        const QString path = m_workDir->filePath(QStringLiteral("snippet_%1.cpp").arg(i));
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            emit progressMessage(QStringLiteral("Build Bench: cannot write %1.").arg(path));
+            return false;
+        }
+        file.write(config.snippets[i].code.toUtf8());
+        snippetFiles << path;
+    }
+
+    auto state = QSharedPointer<SharedState>::create();
+    state->objectDir = m_workDir->path();
+    m_cases.clear();
+
+    // Snippets of one configuration stay adjacent, which is how they are compared
+    for (const QString& compilerId : config.compilerIds) {
+        auto compiler = CompilerRegistry::instance().getCompiler(compilerId);
+        if (!compiler || !compiler->isAvailable()) {
+            emit progressMessage(QStringLiteral("Build Bench: skipping unavailable compiler '%1'.")
+                                     .arg(compilerId));
+            continue;
+        }
+        for (const QString& standard : config.standards) {
+            for (const QString& opt : config.optimizationLevels) {
+                for (int s = 0; s < config.snippets.size(); ++s) {
+                    BuildBenchCase bc;
+                    bc.snippet      = config.snippets[s].name;
+                    bc.compilerId   = compilerId;
+                    bc.standard     = standard;
+                    bc.optimization = opt;
+                    bc.success      = true;
+                    m_cases.append(bc);
+
+                    SharedState::Command command;
+                    command.program = compiler->executablePath();
+                    command.arguments << QStringLiteral("-std=") + standard
+                                      << QStringLiteral("-") + opt
+                                      << config.extraFlags
+                                      << QStringLiteral("-c") << snippetFiles[s];
+                    state->commands.append(command);
+                }
+            }
+        }
+    }
+    if (m_cases.isEmpty()) {
+        emit progressMessage(QStringLiteral("Build Bench: no available compiler selected."));
+        return false;
+    }
+
+    // Warm-ups first, then repetitions round-robin across cases
+    for (int c = 0; c < m_cases.size(); ++c) {
+        state->queue.append({ c, -1 });
+    }
+    for (int rep = 0; rep < config.repetitions; ++rep) {
+        for (int c = 0; c < m_cases.size(); ++c) {
+            state->queue.append({ c, rep });
+        }
+    }
+
+    m_total = state->queue.size();
+    m_completed = 0;
+    m_pendingPerCase = QList<int>();
+    for (int c = 0; c < m_cases.size(); ++c) {
+        m_pendingPerCase.append(config.repetitions + 1);
+    }
+
+    const int cores = std::max(1, QThread::idealThreadCount());
+    const int workers = config.parallel ? std::min(cores, m_total) : 1;
+    m_pool.setMaxThreadCount(workers);
+    m_state = state;
+    m_activeWorkers = workers;
+    m_running = true;
+
+    emit progressMessage(QStringLiteral("Build Bench: %1 cases × %2 repetitions on %3 worker(s)...")
+                             .arg(m_cases.size()).arg(config.repetitions).arg(workers));
+    emit progressChanged(0, m_total);
+
+    for (int w = 0; w < workers; ++w) {
+        const int cpu = (config.parallel && ProcessMeter::hasAffinity()) ? w : -1;
+        ThreadPoolTask::start(&m_pool, [this, state, w, cpu]() {
+            for (;;) {
+                WorkItem item;
+                bool skip = false;
+                {
+                    QMutexLocker locker(&state->mutex);
+                    if (state->cancel || state->queue.isEmpty()) break;
+                    item = state->queue.takeFirst();
+                    skip = state->failedCases.contains(item.caseIndex);
+                }
+
+                ProcessUsage usage;
+                if (!skip) {
+                    const SharedState::Command& command = state->commands[item.caseIndex];
+                    const QString object = QDir(state->objectDir)
+                        .filePath(QStringLiteral("w%1_c%2.o").arg(w).arg(item.caseIndex));
+                    QStringList arguments = command.arguments;
+                    arguments << QStringLiteral("-o") << object;
+                    usage = ProcessMeter::run(command.program, arguments,
+                                              cpu, 120000, &state->cancel);
+                    QFile::remove(object);
+                }
+
+                QMetaObject::invokeMethod(this, [this, state, item, usage]() {
+                    if (state != m_state || state->cancel) return;   // Cancelled or superseded
+                    onSampleDone(item.caseIndex, item.repetition, usage);
+                }, Qt::QueuedConnection);
+
+                // Mark after posting so a later "skipped" never overtakes the failure
+                if (!skip && !usage.succeeded()) {
+                    QMutexLocker locker(&state->mutex);
+                    state->failedCases.insert(item.caseIndex);
+                }
+            }
+            // Queued after this worker's last sample, so it arrives after it
+            QMetaObject::invokeMethod(this, [this, state]() {
+                if (state == m_state) onWorkerDone();
+            }, Qt::QueuedConnection);
+        });
+    }
+    return true;
+}
+
+void BuildBenchRunner::cancel() {
+    if (!m_running || m_state->cancel) return;
+    // Workers kill their compiles and drain; the last one to return ends the run
+    m_state->cancel = true;
+    emit progressMessage(QStringLiteral("Build Bench: cancelling..."));
+}
+
+void BuildBenchRunner::onWorkerDone() {
+    if (--m_activeWorkers == 0 && m_state->cancel) {
+        m_state.reset();
+        finishRun(true);
+    }
+}
+
+void BuildBenchRunner::onSampleDone(int caseIndex, int repetition, const ProcessUsage& usage) {
+    BuildBenchCase& bc = m_cases[caseIndex];
+    if (bc.success) {
+        if (!usage.succeeded()) {
+            bc.success = false;
+            bc.errorMessage = firstErrorLine(usage);
+        } else if (repetition >= 0) {
+            BuildBenchSample sample;
+            sample.wallMs    = usage.wallMs;
+            sample.cpuMs     = usage.cpuMs();
+            sample.peakRssKb = usage.peakRssKb;
+            bc.samples.append(sample);
+        }
+    }
+
+    ++m_completed;
+    emit progressChanged(m_completed, m_total);
+
+    if (--m_pendingPerCase[caseIndex] == 0) {
+        finishCase(caseIndex);
+    }
+    if (m_completed == m_total) {
+        m_state.reset();
+        finishRun(false);
+    }
+}
+
+void BuildBenchRunner::finishCase(int caseIndex) {
+    BuildBenchCase& bc = m_cases[caseIndex];
+    QList<double> wall, cpu, rss;
+    for (const BuildBenchSample& s : bc.samples) {
+        wall << s.wallMs;
+        if (s.cpuMs >= 0) cpu << s.cpuMs;
+        if (s.peakRssKb >= 0) rss << s.peakRssKb / 1024.0;
+    }
+    bc.wallMs    = summarize(wall);
+    bc.cpuMs     = summarize(cpu);
+    bc.peakRssMb = summarize(rss);
+    emit caseFinished(bc);
+}
+
+void BuildBenchRunner::finishRun(bool cancelled) {
+    computeSpeedups(m_cases);
+    m_running = false;
+    m_workDir.reset();
+    emit progressMessage(cancelled ? QStringLiteral("Build Bench cancelled.")
+                                   : QStringLiteral("Build Bench finished."));
+    emit finished(m_cases, cancelled);
+}
+
+// static
+BuildBenchStats BuildBenchRunner::summarize(const QList<double>& values) {
+    BuildBenchStats stats;
+    stats.count = values.size();
+    if (values.isEmpty()) return stats;
+
+    stats.min = stats.max = values.first();
+    double sum = 0;
+    for (double v : values) {
+        sum += v;
+        stats.min = std::min(stats.min, v);
+        stats.max = std::max(stats.max, v);
+    }
+    stats.mean = sum / values.size();
+
+    if (values.size() > 1) {
+        double squares = 0;
+        for (double v : values) {
+            squares += (v - stats.mean) * (v - stats.mean);
+        }
+        stats.stddev = std::sqrt(squares / (values.size() - 1));
+    }
+    return stats;
+}
+
+// static
+void BuildBenchRunner::computeSpeedups(QList<BuildBenchCase>& cases) {
+    QHash<QString, double> baselineMs;   // configuration → first snippet's mean wall time
+    for (BuildBenchCase& bc : cases) {
+        const QString config = bc.configurationLabel();
+        if (!baselineMs.contains(config)) {
+            baselineMs.insert(config, bc.success ? bc.wallMs.mean : 0.0);
+        }
+        const double base = baselineMs.value(config);
+        bc.speedup = (bc.success && base > 0 && bc.wallMs.mean > 0) ? base / bc.wallMs.mean : 0.0;
+    }
+}
@@ -0,0 +1,410 @@
+#include "tools/CompileProfileRunner.h"
+#include "compiler/CompilerRegistry.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QRegularExpression>
+#include <QUuid>
+#include <QVector>
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Sum entries by name and rank them, most expensive first
+class EntryAccumulator {
+public:
+    void add(const QString& name, qint64 us, int count = 1) {
+        auto it = m_index.find(name);
+        if (it == m_index.end()) {
+            it = m_index.insert(name, m_entries.size());
+            CompileProfileEntry entry;
+            entry.name = name;
+            m_entries.append(entry);
+        }
+        m_entries[it.value()].totalUs += us;
+        m_entries[it.value()].count   += count;
+    }
+
+    QList<CompileProfileEntry> ranked() const {
+        QList<CompileProfileEntry> out = m_entries;
+        std::stable_sort(out.begin(), out.end(),
+                         [](const CompileProfileEntry& a, const CompileProfileEntry& b) {
+            if (a.totalUs != b.totalUs) return a.totalUs > b.totalUs;
+            return a.count > b.count;
+        });
+        return out;
+    }
+
+private:
+    QHash<QString, int> m_index;
+    QList<CompileProfileEntry> m_entries;
+};
+
+// Assign nesting depths to spans that are already sorted by (start, -duration)
+void assignDepths(QList<CompileProfileEvent>& events) {
+    QVector<qint64> openEnds;
+    for (CompileProfileEvent& e : events) {
+        while (!openEnds.isEmpty() && openEnds.last() <= e.start) {
+            openEnds.removeLast();
+        }
+        e.depth = openEnds.size();
+        openEnds.append(e.start + e.duration);
+    }
+}
+
+} // namespace
+
+CompileProfileRunner::CompileProfileRunner(QObject* parent)
+    : IToolRunner(parent)
+{
+    m_compilerId = CompilerRegistry::instance().defaultCompilerId();
+}
+
+CompileProfileRunner::~CompileProfileRunner() {
+    cancel();
+}
+
+bool CompileProfileRunner::isAvailable() const {
+    auto compiler = CompilerRegistry::instance().getCompiler(m_compilerId);
+    return compiler && compiler->isAvailable();
+}
+
+void CompileProfileRunner::setCompilerId(const QString& id) {
+    m_compilerId = id;
+}
+
+QString CompileProfileRunner::compilerId() const {
+    return m_compilerId;
+}
+
+void CompileProfileRunner::run(const QString& sourceFile, const QStringList& flags) {
+    auto compiler = CompilerRegistry::instance().getCompiler(m_compilerId);
+    if (!compiler || !compiler->isAvailable()) {
+        emit finished(false, QString(),
+            QStringLiteral("Compiler '%1' is not available. "
+                           "Please select a valid compiler.").arg(m_compilerId));
+        return;
+    }
+
+    cancel(); // Kill any running process
+
+    // Same prefix convention CompilerRegistry uses when saving its config
+    m_clang = compiler->id().startsWith(QStringLiteral("clang"));
+    m_sourceFile = sourceFile;
+
+    const QString uuid = QUuid::createUuid().toString().remove('{').remove('}').remove('-');
+    const QString base = QDir::tempPath() + QStringLiteral("/cppatlas_profile_") + uuid;
+    m_tmpObjectFile = base + QStringLiteral(".o");
+    m_tmpTraceFile  = m_clang ? base + QStringLiteral(".json") : QString();
+
+    QStringList args;
+    args << QStringLiteral("-c");
+    if (m_clang) {
+        args << QStringLiteral("-ftime-trace")
+             << QStringLiteral("-ftime-trace-granularity=%1").arg(m_granularityUs);
+    } else {
+        args << QStringLiteral("-ftime-report") << QStringLiteral("-H");
+    }
+    args << flags;
+    args << sourceFile;
+    args << QStringLiteral("-o") << m_tmpObjectFile;
+
+    m_process = new QProcess(this);
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+
+    connect(m_process, &QProcess::started,
+            this, &CompileProfileRunner::onProcessStarted);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &CompileProfileRunner::onProcessFinished);
+    connect(m_process, &QProcess::errorOccurred,
+            this, &CompileProfileRunner::onProcessError);
+
+    emit progressMessage(
+        QStringLiteral("Profiling compilation of %1...").arg(QFileInfo(sourceFile).fileName()));
+
+    m_timer.start();
+    m_process->start(compiler->executablePath(), args);
+}
+
+void CompileProfileRunner::cancel() {
+    if (m_process && m_process->state() != QProcess::NotRunning) {
+        m_process->kill();
+        m_process->waitForFinished(1000);
+    }
+    if (m_process) {
+        m_process->deleteLater();
+        m_process = nullptr;
+    }
+    removeTempFiles();
+}
+
+void CompileProfileRunner::removeTempFiles() {
+    if (!m_tmpObjectFile.isEmpty()) {
+        QFile::remove(m_tmpObjectFile);
+        m_tmpObjectFile.clear();
+    }
+    if (!m_tmpTraceFile.isEmpty()) {
+        QFile::remove(m_tmpTraceFile);
+        m_tmpTraceFile.clear();
+    }
+}
+
+void CompileProfileRunner::onProcessStarted() {
+    emit started();
+}
+
+void CompileProfileRunner::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
+    if (!m_process) return;
+
+    const qint64 wallUs = m_timer.nsecsElapsed() / 1000;
+    const QString errText = QString::fromUtf8(m_process->readAllStandardError());
+    bool success = (status == QProcess::NormalExit && exitCode == 0);
+    QString errorOutput = errText;
+
+    if (success) {
+        CompileProfile profile;
+        if (m_clang) {
+            QFile traceFile(m_tmpTraceFile);
+            if (traceFile.open(QIODevice::ReadOnly)) {
+                profile = parseTimeTrace(traceFile.readAll());
+            } else {
+                profile.errorMessage =
+                    QStringLiteral("No time trace was written — -ftime-trace needs Clang 9 or newer.");
+            }
+        } else {
+            profile = parseGccReport(errText);
+        }
+
+        if (profile.success) {
+            profile.compilerId = m_compilerId;
+            profile.sourceFile = m_sourceFile;
+            profile.wallTimeUs = wallUs;
+            emit profileReady(profile);
+        } else {
+            success = false;
+            errorOutput = profile.errorMessage + '\n' + errText;
+        }
+    }
+
+    removeTempFiles();
+    emit finished(success, QString(), errorOutput);
+
+    m_process->deleteLater();
+    m_process = nullptr;
+}
+
+void CompileProfileRunner::onProcessError(QProcess::ProcessError error) {
+    static const QMap<QProcess::ProcessError, QString> errors = {
+        { QProcess::FailedToStart, QStringLiteral("Failed to start compiler — check path/permissions.") },
+        { QProcess::Crashed,       QStringLiteral("Compiler process crashed.") },
+        { QProcess::Timedout,      QStringLiteral("Compiler process timed out.") },
+        { QProcess::WriteError,    QStringLiteral("Write error to compiler process.") },
+        { QProcess::ReadError,     QStringLiteral("Read error from compiler process.") },
+    };
+
+    emit finished(false, QString(), errors.value(error, QStringLiteral("Unknown error.")));
+
+    removeTempFiles();
+    if (m_process) {
+        m_process->deleteLater();
+        m_process = nullptr;
+    }
+}
+
+// ── Parsers ──────────────────────────────────────────────────────────────────
+
+// static
+CompileProfile CompileProfileRunner::parseTimeTrace(const QByteArray& json) {
+    CompileProfile profile;
+    profile.unit = CompileProfile::Unit::Microseconds;
+    profile.rawOutput = QString::fromUtf8(json);
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        profile.errorMessage = QStringLiteral("Invalid time trace: ") + parseError.errorString();
+        return profile;
+    }
+    const QJsonArray traceEvents = doc.isArray() ? doc.array()
+                                                 : doc.object()["traceEvents"].toArray();
+
+    // Spans from the compiler's main thread; "Total X" summaries live on their own tids
+    int mainTid = -1;
+    QList<CompileProfileEvent> spans;
+    QList<int> spanTids;
+    EntryAccumulator phases;
+
+    for (const QJsonValue& value : traceEvents) {
+        const QJsonObject obj = value.toObject();
+        if (obj["ph"].toString() != QLatin1String("X")) continue;
+
+        const QString name = obj["name"].toString();
+        const qint64 dur = static_cast<qint64>(obj["dur"].toDouble());
+        if (name.startsWith(QLatin1String("Total "))) {
+            const int count = obj["args"].toObject()["count"].toInt(1);
+            phases.add(name.mid(6), dur, count);
+            continue;
+        }
+
+        CompileProfileEvent event;
+        event.name     = name;
+        event.detail   = obj["args"].toObject()["detail"].toString();
+        event.start    = static_cast<qint64>(obj["ts"].toDouble());
+        event.duration = dur;
+        spans.append(event);
+        spanTids.append(obj["tid"].toInt());
+
+        if (name == QLatin1String("ExecuteCompiler")) {
+            mainTid = obj["tid"].toInt();
+        }
+    }
+
+    if (spans.isEmpty()) {
+        profile.errorMessage = QStringLiteral("The time trace contains no events.");
+        return profile;
+    }
+    if (mainTid < 0) {
+        mainTid = spanTids.first();
+    }
+
+    qint64 origin = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < spans.size(); ++i) {
+        if (spanTids[i] == mainTid) {
+            origin = std::min(origin, spans[i].start);
+        }
+    }
+
+    EntryAccumulator headers;
+    EntryAccumulator templates;
+    EntryAccumulator functions;
+    for (int i = 0; i < spans.size(); ++i) {
+        if (spanTids[i] != mainTid) continue;
+        CompileProfileEvent event = spans[i];
+        event.start -= origin;
+        profile.events.append(event);
+
+        const QString& name = event.name;
+        if (event.detail.isEmpty()) continue;
+        if (name == QLatin1String("Source")) {
+            headers.add(event.detail, event.duration);
+        } else if (name == QLatin1String("InstantiateClass")
+                   || name == QLatin1String("InstantiateFunction")) {
+            templates.add(event.detail, event.duration);
+        } else if (name == QLatin1String("ParseFunctionDefinition")
+                   || name == QLatin1String("OptFunction")
+                   || name == QLatin1String("CodeGen Function")) {
+            functions.add(event.detail, event.duration);
+        }
+    }
+
+    std::sort(profile.events.begin(), profile.events.end(),
+              [](const CompileProfileEvent& a, const CompileProfileEvent& b) {
+        if (a.start != b.start) return a.start < b.start;
+        return a.duration > b.duration;
+    });
+    assignDepths(profile.events);
+
+    profile.headers   = headers.ranked();
+    profile.templates = templates.ranked();
+    profile.functions = functions.ranked();
+    profile.phases    = phases.ranked();
+    profile.success   = true;
+    return profile;
+}
+
+// static
+CompileProfile CompileProfileRunner::parseGccReport(const QString& stderrText) {
+    // -H:             ". /usr/include/c++/13/vector"   (one dot per include level)
+    // -ftime-report:  " phase parsing   :   0.35 ( 70%)   0.05 ( 50%)   0.41 ( 68%)  35M ( 72%)"
+    static const QRegularExpression includeRe(QStringLiteral(R"(^(\.+) (.+)$)"));
+    static const QRegularExpression timevarRe(QStringLiteral(
+        R"(^\s*(.+?)\s*:\s*([\d.]+)\s*\(\s*\d+%\)\s+([\d.]+)\s*\(\s*\d+%\)\s+([\d.]+)\s*\(\s*\d+%\))"));
+    static const QRegularExpression totalRe(QStringLiteral(
+        R"(^\s*TOTAL\s*:\s*([\d.]+)\s+([\d.]+)\s+([\d.]+))"));
+
+    CompileProfile profile;
+    profile.unit = CompileProfile::Unit::Headers;
+    profile.rawOutput = stderrText;
+
+    QVector<int> open;   // Indices into profile.events of the enclosing includes
+    EntryAccumulator phases;
+    qint64 templateUs = -1;
+    bool sawReport = false;
+
+    for (const QString& rawLine : stderrText.split('\n')) {
+        QString line = rawLine;
+        if (line.endsWith('\r')) line.chop(1);
+
+        QRegularExpressionMatch match = includeRe.match(line);
+        if (match.hasMatch()) {
+            CompileProfileEvent event;
+            event.name     = QStringLiteral("Source");
+            event.detail   = match.captured(2).trimmed();
+            event.depth    = match.captured(1).size() - 1;
+            event.start    = profile.events.size();
+            event.duration = 1;
+            while (!open.isEmpty() && profile.events[open.last()].depth >= event.depth) {
+                open.removeLast();
+            }
+            for (int index : open) {
+                ++profile.events[index].duration;   // Every ancestor pulls this header in
+            }
+            open.append(profile.events.size());
+            profile.events.append(event);
+            continue;
+        }
+
+        if ((match = totalRe.match(line)).hasMatch()) {
+            profile.wallTimeUs = qRound64(match.captured(3).toDouble() * 1e6);
+            sawReport = true;
+            continue;
+        }
+        if ((match = timevarRe.match(line)).hasMatch()) {
+            const QString name = match.captured(1);
+            const qint64 wallUs = qRound64(match.captured(4).toDouble() * 1e6);
+            phases.add(name, wallUs);
+            if (name == QLatin1String("template instantiation")) {
+                templateUs = wallUs;
+            }
+            sawReport = true;
+        }
+    }
+
+    if (!sawReport && profile.events.isEmpty()) {
+        profile.errorMessage =
+            QStringLiteral("No -ftime-report or -H output found in compiler stderr.");
+        return profile;
+    }
+
+    // Headers rank by how much of the include graph they drag in
+    EntryAccumulator headers;
+    for (const CompileProfileEvent& event : profile.events) {
+        headers.add(event.detail, 0, static_cast<int>(event.duration));
+    }
+    QList<CompileProfileEntry> rankedHeaders = headers.ranked();
+    std::stable_sort(rankedHeaders.begin(), rankedHeaders.end(),
+                     [](const CompileProfileEntry& a, const CompileProfileEntry& b) {
+        return a.count > b.count;
+    });
+    profile.headers = rankedHeaders;
+
+    // GCC only reports instantiation time as one aggregate
+    if (templateUs >= 0) {
+        CompileProfileEntry entry;
+        entry.name    = QStringLiteral("(all template instantiations)");
+        entry.totalUs = templateUs;
+        entry.count   = 1;
+        profile.templates.append(entry);
+    }
+    profile.phases  = phases.ranked();
+    profile.success = true;
+    return profile;
+}
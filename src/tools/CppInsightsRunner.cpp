@@ -1,9 +1,12 @@
 #include "tools/CppInsightsRunner.h"
 #include "tools/ToolsConfig.h"
+#include "core/ArtifactCache.h"
 
+#include <QDateTime>
 #include <QFileInfo>
 #include <QMap>
 #include <QStringList>
+#include <QTimer>
 
 CppInsightsRunner::CppInsightsRunner(QObject* parent)
     : IToolRunner(parent)
@@ -47,6 +50,27 @@ void CppInsightsRunner::run(const QString& sourceFile, const QStringList& flags)
 
     cancel(); // Kill any running process
 
+    // The binary's mtime stands in for a version: rebuilding insights invalidates entries
+    const QFileInfo exeInfo(executablePath());
+    m_cacheKey = ArtifactCache::keyForSource(
+        ArtifactCache::Kind::Insights, sourceFile, exeInfo.absoluteFilePath(),
+        exeInfo.lastModified().toString(Qt::ISODate), flags);
+
+    QByteArray cachedOutput;
+    QByteArray cachedLog;
+    if (ArtifactCache::instance()->lookupData(m_cacheKey, &cachedOutput, &cachedLog)) {
+        const quint64 serial = m_runSerial;
+        const QString output = QString::fromUtf8(cachedOutput);
+        const QString errText = QString::fromUtf8(cachedLog);
+        emit progressMessage(QStringLiteral("Using cached C++ Insights output for %1").arg(sourceFile));
+        QTimer::singleShot(0, this, [this, serial, output, errText]() {
+            if (serial != m_runSerial) return;   // cancelled or superseded
+            emit started();
+            emit finished(true, output, errText);
+        });
+        return;
+    }
+
     m_process = new QProcess(this);
     m_process->setProcessChannelMode(QProcess::SeparateChannels);
 
@@ -69,6 +93,7 @@ void CppInsightsRunner::run(const QString& sourceFile, const QStringList& flags)
 }
 
 void CppInsightsRunner::cancel() {
+    ++m_runSerial;
     if (m_process && m_process->state() != QProcess::NotRunning) {
         m_process->kill();
         m_process->waitForFinished(1000);
@@ -90,6 +115,9 @@ void CppInsightsRunner::onProcessFinished(int exitCode, QProcess::ExitStatus sta
     QString errText = QString::fromUtf8(m_process->readAllStandardError());
 
     bool success = (status == QProcess::NormalExit && exitCode == 0);
+    if (success) {
+        ArtifactCache::instance()->storeData(m_cacheKey, output.toUtf8(), errText.toUtf8());
+    }
     emit finished(success, output, errText);
 
     m_process->deleteLater();
@@ -0,0 +1,408 @@
+#include "tools/MatrixRunner.h"
+#include "tools/BenchmarkRunner.h"
+#include "tools/ProcessMeter.h"
+#include "tools/ToolsConfig.h"
+#include "compiler/CompilerRegistry.h"
+#include "core/ThreadPoolTask.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QVector>
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+QString firstErrorLine(const ProcessUsage& usage, const QString& what) {
+    if (!usage.started) {
+        return QStringLiteral("Failed to start %1: ").arg(what) + usage.errorString;
+    }
+    if (usage.timedOut) return QStringLiteral("%1 timed out.").arg(what);
+    if (usage.crashed)  return QStringLiteral("%1 crashed.").arg(what);
+
+    const QStringList lines = QString::fromUtf8(usage.standardError).split('\n');
+    for (const QString& line : lines) {
+        if (line.contains(QLatin1String("error"))) return line.trimmed();
+    }
+    return lines.isEmpty() || lines.first().trimmed().isEmpty()
+        ? QStringLiteral("%1 exited with code %2.").arg(what).arg(usage.exitCode)
+        : lines.first().trimmed();
+}
+
+} // namespace
+
+struct MatrixRunner::SharedState {
+    struct Command {
+        QString program;
+        QStringList flags;    // -std/-O/-march/extra, shared by the -S and link steps
+    };
+
+    QVector<Command> commands;    // Per cell; read-only once workers start
+    QString sourcePath;
+    QString workDir;
+    QStringList benchmarkLinkArgs;   // Empty = don't build benchmark binaries
+
+    QMutex mutex;
+    QList<int> queue;             // Guarded by mutex
+    std::atomic_bool cancel { false };
+};
+
+MatrixRunner::MatrixRunner(QObject* parent)
+    : QObject(parent)
+{
+}
+
+MatrixRunner::~MatrixRunner() {
+    if (m_state) {
+        m_state->cancel = true;
+    }
+    m_pool.waitForDone();
+}
+
+bool MatrixRunner::start(const MatrixConfig& config) {
+    if (m_running || config.sourceCode.trimmed().isEmpty() || config.compilerIds.isEmpty()
+        || config.standards.isEmpty() || config.optimizationLevels.isEmpty()
+        || config.marchTargets.isEmpty()) {
+        return false;
+    }
+
+    m_workDir.reset(new QTemporaryDir(QDir::tempPath() + QStringLiteral("/cppatlas_matrix_XXXXXX")));
+    if (!m_workDir->isValid()) {
+        emit progressMessage(QStringLiteral("Matrix: cannot create a temporary directory."));
+        return false;
+    }
+
+    auto state = QSharedPointer<SharedState>::create();
+    state->workDir    = m_workDir->path();
+    state->sourcePath = m_workDir->filePath(QStringLiteral("matrix.cpp"));
+    QFile file(state->sourcePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        emit progressMessage(QStringLiteral("Matrix: cannot write %1.").arg(state->sourcePath));
+        return false;
+    }
+    file.write(config.sourceCode.toUtf8());
+    file.close();
+
+    // Benchmark binaries need the same library setup as BenchmarkRunner
+    const bool benchmarks = config.runBenchmarks && usesGoogleBenchmark(config.sourceCode);
+    if (benchmarks) {
+        const ToolsConfig& tools = ToolsConfig::instance();
+        if (!tools.isBenchmarkAvailable()) {
+            emit progressMessage(QStringLiteral("Matrix: Google Benchmark not configured — "
+                                                "measuring compiles only."));
+        } else {
+            state->benchmarkLinkArgs << (QStringLiteral("-I") + tools.benchmarkIncludeDir());
+            const QString lib = tools.benchmarkLibrary();
+            if (!lib.isEmpty() && QFileInfo::exists(lib)) {
+                state->benchmarkLinkArgs << lib;
+            } else {
+                state->benchmarkLinkArgs << QStringLiteral("-lbenchmark")
+                                         << QStringLiteral("-lbenchmark_main");
+            }
+#ifndef Q_OS_WIN
+            state->benchmarkLinkArgs << QStringLiteral("-lpthread");
+#endif
+        }
+    }
+
+    m_cells.clear();
+    for (const QString& compilerId : config.compilerIds) {
+        auto compiler = CompilerRegistry::instance().getCompiler(compilerId);
+        if (!compiler || !compiler->isAvailable()) {
+            emit progressMessage(QStringLiteral("Matrix: skipping unavailable compiler '%1'.")
+                                     .arg(compilerId));
+            continue;
+        }
+        for (const QString& standard : config.standards) {
+            for (const QString& opt : config.optimizationLevels) {
+                for (const QString& march : config.marchTargets) {
+                    MatrixCell cell;
+                    cell.compilerId   = compilerId;
+                    cell.standard     = standard;
+                    cell.optimization = opt;
+                    cell.march        = march;
+                    cell.benchmarkRequested = !state->benchmarkLinkArgs.isEmpty();
+                    m_cells.append(cell);
+
+                    SharedState::Command command;
+                    command.program = compiler->executablePath();
+                    command.flags << QStringLiteral("-std=") + standard
+                                  << QStringLiteral("-") + opt;
+                    if (!march.isEmpty()) command.flags << QStringLiteral("-march=") + march;
+                    if (!config.includeDir.isEmpty()) {
+                        command.flags << QStringLiteral("-iquote") << config.includeDir;
+                    }
+                    command.flags << config.extraFlags;
+                    state->commands.append(command);
+                }
+            }
+        }
+    }
+    if (m_cells.isEmpty()) {
+        emit progressMessage(QStringLiteral("Matrix: no available compiler selected."));
+        return false;
+    }
+
+    for (int i = 0; i < m_cells.size(); ++i) {
+        state->queue.append(i);
+    }
+    m_binaries = QStringList();
+    for (int i = 0; i < m_cells.size(); ++i) {
+        m_binaries.append(QString());
+    }
+    m_compilesPending = m_cells.size();
+    m_completed = 0;
+    m_total     = m_cells.size() * (state->benchmarkLinkArgs.isEmpty() ? 1 : 2);
+
+    const int workers = std::min(std::max(1, QThread::idealThreadCount()), int(m_cells.size()));
+    m_pool.setMaxThreadCount(workers);
+    m_state   = state;
+    m_activeWorkers = workers;
+    m_running = true;
+
+    emit progressMessage(QStringLiteral("Matrix: compiling %1 configurations on %2 worker(s)...")
+                             .arg(m_cells.size()).arg(workers));
+    emit progressChanged(0, m_total);
+
+    for (int w = 0; w < workers; ++w) {
+        ThreadPoolTask::start(&m_pool, [this, state]() {
+            for (;;) {
+                int index = -1;
+                {
+                    QMutexLocker locker(&state->mutex);
+                    if (state->cancel || state->queue.isEmpty()) break;
+                    index = state->queue.takeFirst();
+                }
+
+                const SharedState::Command& command = state->commands[index];
+                const QString base = QDir(state->workDir).filePath(QStringLiteral("cell_%1").arg(index));
+
+                QStringList arguments = command.flags;
+                arguments << QStringLiteral("-S") << state->sourcePath
+                          << QStringLiteral("-o") << base + QStringLiteral(".s");
+                const ProcessUsage usage = ProcessMeter::run(command.program, arguments,
+                                                             -1, 120000, &state->cancel);
+
+                MatrixAsmStats stats;
+                QString binary;
+                QString linkError;
+                if (usage.succeeded()) {
+                    QFile asmFile(base + QStringLiteral(".s"));
+                    if (asmFile.open(QIODevice::ReadOnly)) {
+                        stats = analyzeAssembly(asmFile.readAll());
+                    }
+                    asmFile.remove();
+
+                    if (!state->benchmarkLinkArgs.isEmpty() && !state->cancel) {
+#ifdef Q_OS_WIN
+                        binary = base + QStringLiteral(".exe");
+#else
+                        binary = base;
+#endif
+                        QStringList linkArguments = command.flags;
+                        linkArguments << state->sourcePath << QStringLiteral("-o") << binary
+                                      << state->benchmarkLinkArgs;
+                        const ProcessUsage link = ProcessMeter::run(command.program, linkArguments,
+                                                                    -1, 120000, &state->cancel);
+                        if (!link.succeeded()) {
+                            linkError = firstErrorLine(link, QStringLiteral("Linker"));
+                            binary.clear();
+                        }
+                    }
+                }
+
+                QMetaObject::invokeMethod(this, [this, state, index, usage, stats, binary, linkError]() {
+                    if (state != m_state || state->cancel) return;   // Cancelled or superseded
+                    onCompileDone(index, usage, stats, binary, linkError);
+                }, Qt::QueuedConnection);
+            }
+            postWorkerDone(state);
+        });
+    }
+    return true;
+}
+
+void MatrixRunner::cancel() {
+    if (!m_running || m_state->cancel) return;
+    // Workers kill their compiles and drain; the last one to return ends the run
+    m_state->cancel = true;
+    emit progressMessage(QStringLiteral("Matrix: cancelling..."));
+}
+
+void MatrixRunner::postWorkerDone(const QSharedPointer<SharedState>& state) {
+    // Queued after the worker's last result, so it arrives after it
+    QMetaObject::invokeMethod(this, [this, state]() {
+        if (state != m_state) return;
+        if (--m_activeWorkers == 0 && state->cancel) {
+            m_state.reset();
+            finishRun(true);
+        }
+    }, Qt::QueuedConnection);
+}
+
+void MatrixRunner::onCompileDone(int index, const ProcessUsage& usage, const MatrixAsmStats& stats,
+                                 const QString& binaryPath, const QString& linkError) {
+    MatrixCell& cell = m_cells[index];
+    cell.compileMs = usage.wallMs;
+    cell.success   = usage.succeeded();
+    if (!cell.success) {
+        cell.errorMessage = firstErrorLine(usage, QStringLiteral("Compiler"));
+    } else {
+        cell.asmStats = stats;
+    }
+    cell.benchmarkError = linkError;
+    m_binaries[index]   = binaryPath;
+
+    // A cell with nothing left to benchmark counts as both of its steps
+    m_completed += (cell.benchmarkRequested && binaryPath.isEmpty()) ? 2 : 1;
+    emit progressChanged(m_completed, m_total);
+    emit cellUpdated(index, cell);
+
+    if (--m_compilesPending == 0) {
+        startBenchmarks();
+    }
+}
+
+void MatrixRunner::startBenchmarks() {
+    QList<QPair<int, QString>> runs;
+    for (int i = 0; i < m_binaries.size(); ++i) {
+        if (!m_binaries[i].isEmpty()) runs.append({ i, m_binaries[i] });
+    }
+    if (runs.isEmpty()) {
+        m_state.reset();
+        finishRun(false);
+        return;
+    }
+
+    emit progressMessage(QStringLiteral("Matrix: running %1 benchmark binaries one at a time...")
+                             .arg(runs.size()));
+
+    // A single runnable walks the list, so at most one benchmark runs at any moment
+    const QSharedPointer<SharedState> state = m_state;
+    ++m_activeWorkers;
+    ThreadPoolTask::start(&m_pool, [this, state, runs]() {
+        for (const auto& run : runs) {
+            if (state->cancel) break;
+            const QString jsonPath = run.second + QStringLiteral(".json");
+            const ProcessUsage usage = ProcessMeter::run(
+                run.second,
+                { QStringLiteral("--benchmark_out=") + jsonPath,
+                  QStringLiteral("--benchmark_out_format=json") },
+                -1, 600000, &state->cancel);
+
+            QByteArray json;
+            QFile jsonFile(jsonPath);
+            if (jsonFile.open(QIODevice::ReadOnly)) {
+                json = jsonFile.readAll();
+            }
+            jsonFile.remove();
+
+            const int index = run.first;
+            QMetaObject::invokeMethod(this, [this, state, index, usage, json]() {
+                if (state != m_state || state->cancel) return;
+                onBenchmarkDone(index, usage, json);
+            }, Qt::QueuedConnection);
+        }
+        postWorkerDone(state);
+    });
+}
+
+void MatrixRunner::onBenchmarkDone(int index, const ProcessUsage& usage, const QByteArray& json) {
+    MatrixCell& cell = m_cells[index];
+    cell.benchmarkRan = usage.succeeded();
+    if (!cell.benchmarkRan) {
+        cell.benchmarkError = firstErrorLine(usage, QStringLiteral("Benchmark"));
+    } else {
+        cell.benchmark = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(json));
+        cell.benchmark.success           = cell.benchmark.errorMessage.isEmpty();
+        cell.benchmark.rawJson           = QString::fromUtf8(json);
+        cell.benchmark.compilerId        = cell.compilerId;
+        cell.benchmark.standard          = cell.standard;
+        cell.benchmark.optimizationLevel = cell.optimization;
+        cell.benchmark.label             = cell.compilerId + QLatin1Char(' ') + cell.flagsLabel();
+        cell.benchmarkError              = cell.benchmark.errorMessage;
+    }
+    QFile::remove(m_binaries[index]);
+    m_binaries[index].clear();
+
+    ++m_completed;
+    emit progressChanged(m_completed, m_total);
+    emit cellUpdated(index, cell);
+
+    if (m_completed == m_total) {
+        m_state.reset();
+        finishRun(false);
+    }
+}
+
+void MatrixRunner::finishRun(bool cancelled) {
+    m_running = false;
+    m_workDir.reset();
+    emit progressMessage(cancelled ? QStringLiteral("Matrix cancelled.")
+                                   : QStringLiteral("Matrix finished."));
+    emit finished(m_cells, cancelled);
+}
+
+// static
+MatrixAsmStats MatrixRunner::analyzeAssembly(const QByteArray& assembly) {
+    MatrixAsmStats stats;
+    stats.bytes = assembly.size();
+
+    int typedFunctions = 0;
+    int globals = 0;
+    static const QRegularExpression typeFunction(
+        QStringLiteral("^\\.type\\s+\\S+,\\s*[@%]function"));
+    static const QRegularExpression whitespace(QStringLiteral("\\s"));
+
+    const QList<QByteArray> lines = assembly.split('\n');
+    for (const QByteArray& raw : lines) {
+        QString line = QString::fromUtf8(raw).trimmed();
+
+        // Strip leading labels ("foo:", "foo: insn") — quoted labels may contain ':'
+        while (!line.isEmpty()) {
+            int colon = -1;
+            if (line.startsWith('"')) {
+                const int close = line.indexOf('"', 1);
+                if (close > 0 && line.mid(close + 1, 1) == QLatin1String(":")) colon = close + 1;
+            } else {
+                const int space = line.indexOf(whitespace);
+                const int c = line.indexOf(':');
+                if (c > 0 && (space < 0 || c < space)) colon = c;
+            }
+            if (colon < 0) break;
+            line = line.mid(colon + 1).trimmed();
+        }
+
+        if (line.isEmpty()) continue;
+        if (line.startsWith('#') || line.startsWith(';') || line.startsWith('@')
+            || line.startsWith(QLatin1String("//"))) {
+            continue;
+        }
+        if (line.startsWith('.')) {
+            if (typeFunction.match(line).hasMatch()) ++typedFunctions;
+            else if (line.startsWith(QLatin1String(".globl")) || line.startsWith(QLatin1String(".global"))) ++globals;
+            continue;
+        }
+        ++stats.instructions;
+    }
+
+    // Mach-O and COFF output have no .type directives
+    stats.functions = typedFunctions > 0 ? typedFunctions : globals;
+    return stats;
+}
+
+// static
+bool MatrixRunner::usesGoogleBenchmark(const QString& code) {
+    static const QRegularExpression include(
+        QStringLiteral("^\\s*#\\s*include\\s*[<\"]benchmark/benchmark\\.h[>\"]"),
+        QRegularExpression::MultilineOption);
+    return include.match(code).hasMatch();
+}
@@ -0,0 +1,293 @@
+#include "tools/McaRunner.h"
+
+#include <QStandardPaths>
+
+namespace {
+
+// Column start offsets of a "[1]    [2] ...  Instructions:" table header
+struct TableLayout {
+    QVector<int> columns;
+    int textColumn = -1;
+};
+
+TableLayout tableLayout(const QString& header) {
+    TableLayout layout;
+    const int textColumn = header.indexOf(QLatin1String("Instructions:"));
+    int pos = 0;
+    while ((pos = header.indexOf(QLatin1Char('['), pos)) >= 0
+           && (textColumn < 0 || pos < textColumn)) {
+        layout.columns.append(pos);
+        ++pos;
+    }
+    layout.textColumn = textColumn;
+    return layout;
+}
+
+// Cells are left-aligned under their "[k]" header and may be blank
+QString tableCell(const QString& row, const TableLayout& layout, int column) {
+    const int begin = layout.columns[column];
+    const int end = column + 1 < layout.columns.size() ? layout.columns[column + 1]
+                  : layout.textColumn >= 0             ? layout.textColumn
+                                                       : row.size();
+    return row.mid(begin, end - begin).trimmed();
+}
+
+QVector<double> pressureValues(const QString& text) {
+    QVector<double> values;
+    for (const QString& token : text.simplified().split(QLatin1Char(' '), Qt::SkipEmptyParts)) {
+        values.append(token == QLatin1String("-") ? 0.0 : token.toDouble());
+    }
+    return values;
+}
+
+} // namespace
+
+McaRunner::McaRunner(QObject* parent)
+    : IToolRunner(parent)
+{
+}
+
+McaRunner::~McaRunner() {
+    killProcess();
+}
+
+QString McaRunner::findExecutable() {
+    QString path = QStandardPaths::findExecutable(QStringLiteral("llvm-mca"));
+    // Distribution packages often only ship the versioned name
+    for (int version = 20; path.isEmpty() && version >= 10; --version) {
+        path = QStandardPaths::findExecutable(QStringLiteral("llvm-mca-%1").arg(version));
+    }
+    return path;
+}
+
+bool McaRunner::isAvailable() const {
+    return !findExecutable().isEmpty();
+}
+
+bool McaRunner::isRunning() const {
+    return m_process != nullptr;
+}
+
+void McaRunner::run(const QString& sourceFile, const QStringList& flags) {
+    start(QStringList(flags) << sourceFile, QByteArray());
+}
+
+void McaRunner::analyze(const QString& assembly, const QString& cpu, bool intelSyntax) {
+    QStringList args;
+    if (!cpu.isEmpty()) {
+        args << QStringLiteral("-mcpu=") + cpu;
+    }
+    args << QStringLiteral("-");
+
+    QByteArray input;
+    if (intelSyntax) {
+        input = ".intel_syntax noprefix\n";
+    }
+    input += assembly.toUtf8();
+    start(args, input);
+}
+
+void McaRunner::start(const QStringList& args, const QByteArray& input) {
+    const QString program = findExecutable();
+    if (program.isEmpty()) {
+        emit finished(false, QString(),
+                      QStringLiteral("llvm-mca was not found on PATH. Install LLVM to use Analyze."));
+        return;
+    }
+
+    cancel();
+
+    m_process = new QProcess(this);
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    connect(m_process, &QProcess::started, this, &McaRunner::started);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &McaRunner::onProcessFinished);
+    connect(m_process, &QProcess::errorOccurred,
+            this, &McaRunner::onProcessError);
+
+    emit progressMessage(QStringLiteral("Running llvm-mca…"));
+    m_process->start(program, args);
+    if (!input.isEmpty()) {
+        m_process->write(input);
+    }
+    m_process->closeWriteChannel();
+}
+
+void McaRunner::cancel() {
+    killProcess();
+}
+
+void McaRunner::killProcess() {
+    if (!m_process) {
+        return;
+    }
+    disconnect(m_process, nullptr, this, nullptr);
+    if (m_process->state() != QProcess::NotRunning) {
+        m_process->kill();
+    }
+    m_process->deleteLater();
+    m_process = nullptr;
+}
+
+void McaRunner::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
+    if (!m_process) return;
+
+    const QString output  = QString::fromUtf8(m_process->readAllStandardOutput());
+    const QString errText = QString::fromUtf8(m_process->readAllStandardError());
+    const bool success = (status == QProcess::NormalExit && exitCode == 0);
+
+    m_process->deleteLater();
+    m_process = nullptr;
+
+    emit finished(success, output, errText);
+}
+
+void McaRunner::onProcessError(QProcess::ProcessError error) {
+    // Crashes also end in finished(); only a failed start does not
+    if (error != QProcess::FailedToStart) return;
+    killProcess();
+    emit finished(false, QString(), QStringLiteral("Failed to start llvm-mca."));
+}
+
+// ── Report parsing ────────────────────────────────────────────────────────────
+
+McaReport McaRunner::parseReport(const QString& output) {
+    enum class Section {
+        Summary,
+        InstructionInfo,
+        Resources,
+        PressurePerIteration,
+        PressureByInstruction,
+        Other
+    };
+
+    McaReport report;
+    Section section = Section::Summary;
+    QStringList infoColumns;   // "[k]: name" legend of the Instruction Info table
+    TableLayout layout;
+    bool haveHeader = false;
+    int pressureRow = 0;
+
+    for (QString row : output.split(QLatin1Char('\n'))) {
+        if (row.endsWith(QLatin1Char('\r'))) row.chop(1);
+        const QString line = row.trimmed();
+
+        if (line.isEmpty()) {
+            // Blank lines separate a legend from its table, and end the table
+            if (haveHeader || (section == Section::Resources && !report.resources.isEmpty())) {
+                section = Section::Other;
+                haveHeader = false;
+            }
+            continue;
+        }
+
+        if (!line.startsWith(QLatin1Char('[')) && line.endsWith(QLatin1Char(':'))) {
+            haveHeader = false;
+            if (line == QLatin1String("Instruction Info:")) {
+                section = Section::InstructionInfo;
+                infoColumns.clear();
+            } else if (line == QLatin1String("Resources:")) {
+                section = Section::Resources;
+            } else if (line == QLatin1String("Resource pressure per iteration:")) {
+                section = Section::PressurePerIteration;
+            } else if (line == QLatin1String("Resource pressure by instruction:")) {
+                section = Section::PressureByInstruction;
+                pressureRow = 0;
+            } else {
+                section = Section::Other;   // Timeline, stall cycles, ...
+            }
+            continue;
+        }
+
+        switch (section) {
+        case Section::Summary: {
+            const int colon = line.indexOf(QLatin1Char(':'));
+            if (colon < 0) break;
+            const QString key   = line.left(colon).trimmed();
+            const QString value = line.mid(colon + 1).trimmed();
+            if (key == QLatin1String("Iterations")) {
+                report.iterations = value.toInt();
+                report.valid = true;
+            } else if (key == QLatin1String("Instructions")) {
+                report.instructionCount = value.toInt();
+            } else if (key == QLatin1String("Total Cycles")) {
+                report.totalCycles = value.toLongLong();
+            } else if (key == QLatin1String("Total uOps")) {
+                report.totalUops = value.toLongLong();
+            } else if (key == QLatin1String("Dispatch Width")) {
+                report.dispatchWidth = value.toInt();
+            } else if (key == QLatin1String("uOps Per Cycle")) {
+                report.uopsPerCycle = value.toDouble();
+            } else if (key == QLatin1String("IPC")) {
+                report.ipc = value.toDouble();
+            } else if (key == QLatin1String("Block RThroughput")) {
+                report.blockRThroughput = value.toDouble();
+            }
+            break;
+        }
+
+        case Section::InstructionInfo: {
+            if (!haveHeader) {
+                const int legend = line.indexOf(QLatin1String("]:"));
+                if (legend > 0) {
+                    infoColumns << line.mid(legend + 2).trimmed();
+                } else if (line.contains(QLatin1String("Instructions:"))) {
+                    layout = tableLayout(row);
+                    haveHeader = true;
+                }
+                break;
+            }
+            McaInstruction instruction;
+            instruction.text = row.mid(layout.textColumn).trimmed();
+            for (int c = 0; c < layout.columns.size() && c < infoColumns.size(); ++c) {
+                const QString value = tableCell(row, layout, c);
+                const QString& name = infoColumns[c];
+                if (name == QLatin1String("#uOps"))            instruction.uops = value.toInt();
+                else if (name == QLatin1String("Latency"))     instruction.latency = value.toInt();
+                else if (name == QLatin1String("RThroughput")) instruction.rthroughput = value.toDouble();
+                else if (name == QLatin1String("MayLoad"))     instruction.mayLoad = !value.isEmpty();
+                else if (name == QLatin1String("MayStore"))    instruction.mayStore = !value.isEmpty();
+                else if (name.startsWith(QLatin1String("HasSideEffects")))
+                    instruction.sideEffects = !value.isEmpty();
+            }
+            report.instructions.append(instruction);
+            break;
+        }
+
+        case Section::Resources: {
+            // "[0]   - SKLDivider"; units of a group share the name: "[14.1] - Zn3LSU"
+            const int close = line.indexOf(QLatin1Char(']'));
+            const int dash  = line.indexOf(QLatin1String("- "), close);
+            if (!line.startsWith(QLatin1Char('[')) || close < 0 || dash < 0) break;
+            QString name = line.mid(dash + 2).trimmed();
+            const int unit = line.left(close).indexOf(QLatin1Char('.'));
+            if (unit > 0) {
+                name += line.mid(unit, close - unit);
+            }
+            report.resources << name;
+            break;
+        }
+
+        case Section::PressurePerIteration:
+            if (!haveHeader) {
+                haveHeader = line.startsWith(QLatin1Char('['));
+            } else {
+                report.resourcePressure = pressureValues(line);
+            }
+            break;
+
+        case Section::PressureByInstruction:
+            if (!haveHeader) {
+                layout = tableLayout(row);
+                haveHeader = layout.textColumn >= 0;
+            } else if (pressureRow < report.instructions.size()) {
+                report.instructions[pressureRow++].pressure = pressureValues(row.left(layout.textColumn));
+            }
+            break;
+
+        case Section::Other:
+            break;
+        }
+    }
+    return report;
+}
@@ -0,0 +1,355 @@
+#include "tools/OptRemarksRunner.h"
+#include "compiler/CompilerRegistry.h"
+#include "compiler/StdinSource.h"
+#include "core/GroupedProcess.h"
+#include "tools/AsmParser.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QPair>
+#include <QRegularExpression>
+#include <QUuid>
+#include <QVector>
+
+namespace {
+
+// YAML scalar as LLVM writes it: 'single' ('' escapes a quote), "double" or plain
+QString unquote(const QString& raw) {
+    const QString value = raw.trimmed();
+    if (value.size() >= 2 && value.startsWith(QLatin1Char('\''))
+        && value.endsWith(QLatin1Char('\''))) {
+        return value.mid(1, value.size() - 2).replace(QStringLiteral("''"), QStringLiteral("'"));
+    }
+    if (value.size() >= 2 && value.startsWith(QLatin1Char('"'))
+        && value.endsWith(QLatin1Char('"'))) {
+        QString out;
+        const QString inner = value.mid(1, value.size() - 2);
+        for (int i = 0; i < inner.size(); ++i) {
+            if (inner[i] == QLatin1Char('\\') && i + 1 < inner.size()) {
+                const QChar next = inner[++i];
+                out += next == QLatin1Char('n') ? QChar(QLatin1Char('\n'))
+                     : next == QLatin1Char('t') ? QChar(QLatin1Char('\t'))
+                                                : next;
+            } else {
+                out += inner[i];
+            }
+        }
+        return out;
+    }
+    return value;
+}
+
+// "{ File: '<stdin>', Line: 3, Column: 5 }"
+bool parseDebugLoc(const QString& text, OptRemark& remark) {
+    static const QRegularExpression locRe(QStringLiteral(
+        R"(File:\s*('(?:[^']|'')*'|"(?:[^"\\]|\\.)*"|[^,}]+)\s*,\s*Line:\s*(\d+)\s*,\s*Column:\s*(\d+))"));
+    const QRegularExpressionMatch match = locRe.match(text);
+    if (!match.hasMatch()) return false;
+    remark.file   = unquote(match.captured(1));
+    remark.line   = match.captured(2).toInt();
+    remark.column = match.captured(3).toInt();
+    return true;
+}
+
+// GCC does not name the pass; group remarks by what the text talks about
+QString gccPass(const QString& message) {
+    if (message.contains(QLatin1String("vectoriz"), Qt::CaseInsensitive)
+        || message.contains(QLatin1String("SLP"))) {
+        return QStringLiteral("vectorize");
+    }
+    if (message.contains(QLatin1String("inlin"), Qt::CaseInsensitive)) {
+        return QStringLiteral("inline");
+    }
+    if (message.contains(QLatin1String("unroll"), Qt::CaseInsensitive)) {
+        return QStringLiteral("unroll");
+    }
+    if (message.contains(QLatin1String("loop"), Qt::CaseInsensitive)) {
+        return QStringLiteral("loop");
+    }
+    return QString();
+}
+
+} // namespace
+
+OptRemarksRunner::OptRemarksRunner(QObject* parent)
+    : IToolRunner(parent)
+{
+    m_compilerId = CompilerRegistry::instance().defaultCompilerId();
+}
+
+OptRemarksRunner::~OptRemarksRunner() {
+    cancel();
+}
+
+bool OptRemarksRunner::isAvailable() const {
+    auto compiler = CompilerRegistry::instance().getCompiler(m_compilerId);
+    return compiler && compiler->isAvailable();
+}
+
+void OptRemarksRunner::setCompilerId(const QString& id) {
+    m_compilerId = id;
+}
+
+QString OptRemarksRunner::compilerId() const {
+    return m_compilerId;
+}
+
+bool OptRemarksRunner::isRunning() const {
+    return m_process != nullptr;
+}
+
+void OptRemarksRunner::run(const QString& sourceFile, const QStringList& flags) {
+    start(QFileInfo(sourceFile).fileName(), flags, sourceFile, QByteArray(),
+          QFileInfo(sourceFile).absolutePath());
+}
+
+void OptRemarksRunner::runSource(const QString& sourceCode, const QStringList& flags,
+                                 const QString& sourceDirectory) {
+    start(QStringLiteral("buffer"), flags, QString(), sourceCode.toUtf8(), sourceDirectory);
+}
+
+void OptRemarksRunner::start(const QString& displayName, const QStringList& flags,
+                             const QString& sourceFile, const QByteArray& input,
+                             const QString& workingDirectory) {
+    auto compiler = CompilerRegistry::instance().getCompiler(m_compilerId);
+    if (!compiler || !compiler->isAvailable()) {
+        emit finished(false, QString(),
+            QStringLiteral("Compiler '%1' is not available. "
+                           "Please select a valid compiler.").arg(m_compilerId));
+        return;
+    }
+
+    cancel(); // Kill any running process
+
+    // Same prefix convention CompilerRegistry uses when saving its config
+    m_clang = compiler->id().startsWith(QStringLiteral("clang"));
+
+    const QString uuid = QUuid::createUuid().toString().remove('{').remove('}').remove('-');
+    const QString base = QDir::tempPath() + QStringLiteral("/cppatlas_remarks_") + uuid;
+    m_tmpObjectFile = base + QStringLiteral(".o");
+    m_tmpRecordFile = m_clang ? base + QStringLiteral(".opt.yaml") : QString();
+
+    QStringList args;
+    args << QStringLiteral("-c");
+    if (m_clang) {
+        args << QStringLiteral("-fsave-optimization-record")
+             << QStringLiteral("-foptimization-record-file=") + m_tmpRecordFile;
+    } else {
+        args << QStringLiteral("-fopt-info-all");
+    }
+    args << flags;
+    if (sourceFile.isEmpty()) {
+        args << StdinSource::arguments(workingDirectory);
+    } else {
+        args << sourceFile;
+    }
+    args << QStringLiteral("-o") << m_tmpObjectFile;
+
+    m_process = new GroupedProcess(this);
+    m_process->setProcessChannelMode(QProcess::SeparateChannels);
+    if (!workingDirectory.isEmpty()) {
+        m_process->setWorkingDirectory(workingDirectory);
+    }
+
+    connect(m_process, &QProcess::started, this, &OptRemarksRunner::started);
+    connect(m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &OptRemarksRunner::onProcessFinished);
+    connect(m_process, &QProcess::errorOccurred,
+            this, &OptRemarksRunner::onProcessError);
+
+    emit progressMessage(
+        QStringLiteral("Collecting optimization remarks for %1...").arg(displayName));
+
+    m_process->start(compiler->executablePath(), args);
+    if (!input.isEmpty()) {
+        m_process->write(input);
+    }
+    m_process->closeWriteChannel();
+}
+
+void OptRemarksRunner::cancel() {
+    killProcess();
+    if (!m_tmpObjectFile.isEmpty()) {
+        QFile::remove(m_tmpObjectFile);
+        m_tmpObjectFile.clear();
+    }
+    if (!m_tmpRecordFile.isEmpty()) {
+        QFile::remove(m_tmpRecordFile);
+        m_tmpRecordFile.clear();
+    }
+}
+
+void OptRemarksRunner::killProcess() {
+    if (!m_process) {
+        return;
+    }
+    m_process->killAndRelease();
+    m_process = nullptr;
+}
+
+void OptRemarksRunner::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
+    if (!m_process) return;
+
+    const QString errText = QString::fromUtf8(m_process->readAllStandardError());
+    const bool success = (status == QProcess::NormalExit && exitCode == 0);
+
+    m_process->deleteLater();
+    m_process = nullptr;
+
+    if (success) {
+        QList<OptRemark> remarks;
+        if (m_clang) {
+            QFile record(m_tmpRecordFile);
+            if (record.open(QIODevice::ReadOnly)) {
+                remarks = parseOptRecord(record.readAll());
+            }
+        } else {
+            remarks = parseGccOptInfo(errText);
+        }
+        emit remarksReady(remarks);
+    }
+
+    cancel();   // Removes the temp files
+    // GCC's remarks are its stderr; only a failed compile reports it as an error
+    emit finished(success, QString(), success ? QString() : errText);
+}
+
+void OptRemarksRunner::onProcessError(QProcess::ProcessError error) {
+    // Crashes also end in finished(); only a failed start does not
+    if (error != QProcess::FailedToStart) return;
+    cancel();
+    emit finished(false, QString(),
+                  QStringLiteral("Failed to start compiler — check path/permissions."));
+}
+
+// ── Parsers ──────────────────────────────────────────────────────────────────
+
+// static
+QList<OptRemark> OptRemarksRunner::parseGccOptInfo(const QString& stderrText) {
+    // "<stdin>:3:23: optimized: loop vectorized using 16 byte vectors"
+    // "<stdin>:7:45: missed: not vectorized: control flow in loop."
+    static const QRegularExpression lineRe(QStringLiteral(
+        R"(^(.+?):(\d+):(\d+): (optimized|missed|note): (.*)$)"));
+    // "Inlining int sq(int)/0 into int sum(const int*, int)/2." — drop symbol-table order
+    static const QRegularExpression orderRe(QStringLiteral(R"(\)/\d+)"));
+
+    QList<OptRemark> remarks;
+    for (const QString& rawLine : stderrText.split('\n')) {
+        QString line = rawLine;
+        if (line.endsWith('\r')) line.chop(1);
+
+        const QRegularExpressionMatch match = lineRe.match(line);
+        if (!match.hasMatch()) continue;
+
+        OptRemark remark;
+        const QString kind = match.captured(4);
+        remark.kind = kind == QLatin1String("optimized") ? OptRemark::Kind::Passed
+                    : kind == QLatin1String("missed")    ? OptRemark::Kind::Missed
+                                                         : OptRemark::Kind::Analysis;
+        remark.file    = match.captured(1);
+        remark.line    = match.captured(2).toInt();
+        remark.column  = match.captured(3).toInt();
+        remark.message = match.captured(5).trimmed().replace(orderRe, QStringLiteral(")"));
+        remark.pass    = gccPass(remark.message);
+        remarks.append(remark);
+    }
+    return remarks;
+}
+
+// static
+QList<OptRemark> OptRemarksRunner::parseOptRecord(const QByteArray& yaml) {
+    // --- !Passed
+    // Pass:            inline
+    // Name:            Inlined
+    // DebugLoc:        { File: '<stdin>', Line: 7, Column: 14 }
+    // Function:        _Z3sumPKii
+    // Args:
+    //   - Callee:          _ZL2sqi
+    //     DebugLoc:        { File: '<stdin>', Line: 1, Column: 0 }
+    //   - String:          ' inlined into '
+    //   - Caller:          _Z3sumPKii
+    // ...
+    static const QRegularExpression headerRe(QStringLiteral(R"(^--- !(\w+))"));
+    static const QRegularExpression keyRe(QStringLiteral(R"(^(\w+):\s*(.*)$)"));
+    static const QRegularExpression argRe(QStringLiteral(R"(^\s*-\s+(\w+):\s*(.*)$)"));
+
+    struct Pending {
+        OptRemark remark;
+        QVector<QPair<QString, QString>> args;   // Key, unquoted value
+    };
+    QVector<Pending> pending;
+    bool inRemark = false;
+    bool inArgs = false;
+
+    for (const QString& rawLine : QString::fromUtf8(yaml).split('\n')) {
+        QString line = rawLine;
+        if (line.endsWith('\r')) line.chop(1);
+
+        QRegularExpressionMatch match = headerRe.match(line);
+        if (match.hasMatch()) {
+            const QString kind = match.captured(1);
+            Pending next;
+            next.remark.kind = kind == QLatin1String("Passed") ? OptRemark::Kind::Passed
+                             : kind == QLatin1String("Missed") ? OptRemark::Kind::Missed
+                                                               : OptRemark::Kind::Analysis;
+            pending.append(next);
+            inRemark = true;
+            inArgs = false;
+            continue;
+        }
+        if (line.startsWith(QLatin1String("..."))) {
+            inRemark = inArgs = false;
+            continue;
+        }
+        if (!inRemark) continue;
+
+        if (inArgs && (match = argRe.match(line)).hasMatch()) {
+            // A nested DebugLoc line has no dash and is skipped below
+            pending.last().args.append({ match.captured(1), unquote(match.captured(2)) });
+            continue;
+        }
+        if ((match = keyRe.match(line)).hasMatch()) {
+            const QString key = match.captured(1);
+            const QString value = match.captured(2);
+            OptRemark& remark = pending.last().remark;
+            inArgs = (key == QLatin1String("Args"));
+            if (key == QLatin1String("Pass"))          remark.pass = unquote(value);
+            else if (key == QLatin1String("Name"))     remark.name = unquote(value);
+            else if (key == QLatin1String("Function")) remark.function = unquote(value);
+            else if (key == QLatin1String("DebugLoc")) parseDebugLoc(value, remark);
+        }
+    }
+
+    // Demangle every symbol in one batch
+    QStringList symbols;
+    for (const Pending& p : pending) {
+        if (AsmParser::isMangled(p.remark.function.toUtf8())) symbols << p.remark.function;
+        for (const auto& arg : p.args) {
+            if ((arg.first == QLatin1String("Callee") || arg.first == QLatin1String("Caller"))
+                && AsmParser::isMangled(arg.second.toUtf8())) {
+                symbols << arg.second;
+            }
+        }
+    }
+    symbols.removeDuplicates();
+    const QStringList demangled = AsmParser::demangle(symbols);
+    QHash<QString, QString> names;
+    for (int i = 0; i < symbols.size() && i < demangled.size(); ++i) {
+        names.insert(symbols[i], demangled[i]);
+    }
+
+    QList<OptRemark> remarks;
+    remarks.reserve(pending.size());
+    for (Pending& p : pending) {
+        p.remark.function = names.value(p.remark.function, p.remark.function);
+        QString message;
+        for (const auto& arg : p.args) {
+            message += names.value(arg.second, arg.second);
+        }
+        p.remark.message = message.trimmed();
+        remarks.append(p.remark);
+    }
+    return remarks;
+}
@@ -0,0 +1,287 @@
+#include "tools/ProcessMeter.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+
+#include <vector>
+
+#if defined(Q_OS_UNIX)
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(Q_OS_LINUX)
+#include <sched.h>
+#endif
+#else
+#include <QProcess>
+#endif
+
+#if defined(Q_OS_UNIX)
+
+namespace {
+
+void closeFd(int& fd) {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+double toMs(const timeval& tv) {
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+// Stderr poll interval: bounds how late a reap is noticed while some
+// other process still holds the pipe open
+constexpr int POLL_MS = 20;
+
+#if !defined(Q_OS_LINUX)
+// pipe() then FD_CLOEXEC is not atomic; run() holds this from the pipes
+// to the fork so no other worker's child inherits them in between
+QMutex& forkMutex() {
+    static QMutex mutex;
+    return mutex;
+}
+#endif
+
+// Both ends close-on-exec: concurrent run() calls must not leak their
+// pipes into each other's children, or EOF waits for an unrelated exit
+bool openPipe(int fds[2]) {
+#if defined(Q_OS_LINUX)
+    return ::pipe2(fds, O_CLOEXEC) == 0;
+#else
+    if (::pipe(fds) != 0) return false;
+    ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return true;
+#endif
+}
+
+} // namespace
+
+ProcessUsage ProcessMeter::run(const QString& program, const QStringList& arguments,
+                               int cpu, int timeoutMs, const std::atomic_bool* cancel) {
+    ProcessUsage usage;
+
+    // Everything the child needs is prepared before fork(): no allocation after it
+    std::vector<QByteArray> argStorage;
+    argStorage.reserve(arguments.size() + 1);
+    argStorage.push_back(QFile::encodeName(program));
+    for (const QString& arg : arguments) {
+        argStorage.push_back(arg.toLocal8Bit());
+    }
+    std::vector<char*> argv;
+    for (QByteArray& arg : argStorage) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+#if !defined(Q_OS_LINUX)
+    QMutexLocker forkLock(&forkMutex());
+#endif
+    int errPipe[2] = { -1, -1 };    // Child stderr
+    int execPipe[2] = { -1, -1 };   // errno from a failed exec; closed by a successful one
+    if (!openPipe(errPipe) || !openPipe(execPipe)) {
+        usage.errorString = QString::fromLocal8Bit(std::strerror(errno));
+        closeFd(errPipe[0]); closeFd(errPipe[1]);
+        closeFd(execPipe[0]); closeFd(execPipe[1]);
+        return usage;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        usage.errorString = QString::fromLocal8Bit(std::strerror(errno));
+        closeFd(errPipe[0]); closeFd(errPipe[1]);
+        closeFd(execPipe[0]); closeFd(execPipe[1]);
+        return usage;
+    }
+
+    if (pid == 0) {
+        // ── Child: async-signal-safe calls only ──
+        // Own process group, so a kill also reaches cc1plus/as, which hold stderr open
+        ::setpgid(0, 0);
+#if defined(Q_OS_LINUX)
+        if (cpu >= 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            ::sched_setaffinity(0, sizeof(set), &set);
+        }
+#endif
+        const int devNull = ::open("/dev/null", O_RDWR | O_CLOEXEC);
+        if (devNull >= 0) {
+            ::dup2(devNull, STDIN_FILENO);
+            ::dup2(devNull, STDOUT_FILENO);
+            if (devNull > STDERR_FILENO) ::close(devNull);
+        }
+        ::dup2(errPipe[1], STDERR_FILENO);
+        if (errPipe[1] > STDERR_FILENO) ::close(errPipe[1]);
+        ::execvp(argv[0], argv.data());
+
+        const int err = errno;
+        ssize_t ignored = ::write(execPipe[1], &err, sizeof(err));
+        (void)ignored;
+        ::_exit(127);
+    }
+
+    // ── Parent ──
+#if !defined(Q_OS_LINUX)
+    forkLock.unlock();
+#endif
+    ::setpgid(pid, pid);    // Also here: the group must exist before any kill below
+    closeFd(errPipe[1]);
+    closeFd(execPipe[1]);
+
+    int execErrno = 0;
+    ssize_t n;
+    do {
+        n = ::read(execPipe[0], &execErrno, sizeof(execErrno));
+    } while (n < 0 && errno == EINTR);
+    closeFd(execPipe[0]);
+
+    if (n == static_cast<ssize_t>(sizeof(execErrno))) {
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        closeFd(errPipe[0]);
+        usage.errorString = QString::fromLocal8Bit(std::strerror(execErrno));
+        return usage;
+    }
+    usage.started = true;
+
+    // Drain stderr until EOF or until the child is reaped, whichever comes
+    // first, polling so timeout and cancellation stay responsive
+    bool killed = false;
+    bool reaped = false;
+    int status = 0;
+    rusage ru {};
+    char buffer[4096];
+    while (errPipe[0] >= 0 && !reaped) {
+        if (!killed) {
+            if (cancel && cancel->load()) {
+                usage.cancelled = true;
+            } else if (timer.elapsed() > timeoutMs) {
+                usage.timedOut = true;
+            }
+            if (usage.cancelled || usage.timedOut) {
+                ::kill(-pid, SIGKILL);
+                killed = true;
+            }
+        }
+
+        pollfd pfd { errPipe[0], POLLIN, 0 };
+        const int ready = ::poll(&pfd, 1, POLL_MS);
+        if (ready < 0 && errno != EINTR) break;
+        if (ready > 0) {
+            const ssize_t got = ::read(errPipe[0], buffer, sizeof(buffer));
+            if (got > 0) {
+                usage.standardError.append(buffer, static_cast<int>(got));
+            } else if (got == 0 || errno != EINTR) {
+                closeFd(errPipe[0]);
+            }
+        } else if (::wait4(pid, &status, WNOHANG, &ru) == pid) {
+            // Exited while something else keeps stderr open: time it now
+            usage.wallMs = timer.nsecsElapsed() / 1e6;
+            reaped = true;
+        }
+    }
+
+    if (!reaped) {
+        while (::wait4(pid, &status, 0, &ru) < 0 && errno == EINTR) {}
+        usage.wallMs = timer.nsecsElapsed() / 1e6;
+    } else {
+        // Whatever the child wrote before it exited is already buffered
+        pollfd pfd { errPipe[0], POLLIN, 0 };
+        while (::poll(&pfd, 1, 0) > 0) {
+            const ssize_t got = ::read(errPipe[0], buffer, sizeof(buffer));
+            if (got <= 0) break;
+            usage.standardError.append(buffer, static_cast<int>(got));
+        }
+    }
+    closeFd(errPipe[0]);
+
+    usage.userMs   = toMs(ru.ru_utime);
+    usage.systemMs = toMs(ru.ru_stime);
+#if defined(Q_OS_MACOS)
+    usage.peakRssKb = ru.ru_maxrss / 1024;   // Bytes on macOS
+#else
+    usage.peakRssKb = ru.ru_maxrss;          // KiB on Linux and the BSDs
+#endif
+
+    if (WIFEXITED(status)) {
+        usage.exitCode = WEXITSTATUS(status);
+    } else {
+        usage.crashed = !killed;
+    }
+    return usage;
+}
+
+bool ProcessMeter::hasResourceUsage() {
+    return true;
+}
+
+bool ProcessMeter::hasAffinity() {
+#if defined(Q_OS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+#else // !Q_OS_UNIX
+
+ProcessUsage ProcessMeter::run(const QString& program, const QStringList& arguments,
+                               int cpu, int timeoutMs, const std::atomic_bool* cancel) {
+    Q_UNUSED(cpu);
+    ProcessUsage usage;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QProcess process;
+    process.setStandardOutputFile(QProcess::nullDevice());
+    process.start(program, arguments);
+    if (!process.waitForStarted()) {
+        usage.errorString = process.errorString();
+        return usage;
+    }
+    usage.started = true;
+
+    while (!process.waitForFinished(100)) {
+        if (cancel && cancel->load()) {
+            usage.cancelled = true;
+        } else if (timer.elapsed() > timeoutMs) {
+            usage.timedOut = true;
+        }
+        if (usage.cancelled || usage.timedOut) {
+            process.kill();
+            process.waitForFinished(1000);
+            break;
+        }
+    }
+    usage.wallMs = timer.nsecsElapsed() / 1e6;
+    usage.standardError = process.readAllStandardError();
+    usage.crashed = process.exitStatus() == QProcess::CrashExit
+                    && !usage.cancelled && !usage.timedOut;
+    usage.exitCode = process.exitCode();
+    return usage;
+}
+
+bool ProcessMeter::hasResourceUsage() {
+    return false;
+}
+
+bool ProcessMeter::hasAffinity() {
+    return false;
+}
+
+#endif
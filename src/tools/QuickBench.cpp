@@ -0,0 +1,216 @@
+#include "tools/QuickBench.h"
+
+#include <QFile>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSet>
+
+namespace {
+
+const char* const SECTION_BEGIN = "// {{#SNIPPET}}\n";
+const char* const SECTION_END   = "// {{/SNIPPET}}\n";
+const char* const HARNESS_LINE  = "{{HARNESS_LINE}}";
+const char* const HARNESS_FILE  = "quick_bench.cpp";
+
+// Every line of @p text prefixed with @p indent; line count unchanged for #line
+QString indented(const QString& text, const QString& indent) {
+    QStringList lines = text.split(QLatin1Char('\n'));
+    for (QString& line : lines)
+        if (!line.trimmed().isEmpty()) line.prepend(indent);
+    return lines.join(QLatin1Char('\n'));
+}
+
+QList<double> inNanoseconds(const QList<double>& times, const QString& unit) {
+    QList<double> ns;
+    for (double t : times) ns << BenchmarkStats::toNanoseconds(t, unit);
+    return ns;
+}
+
+} // namespace
+
+// ─────────────────────────────────────────────────────────────────────────────
+// QuickBenchRatio
+// ─────────────────────────────────────────────────────────────────────────────
+
+QString QuickBenchRatio::text() const {
+    if (isReference()) return QStringLiteral("%1 is the reference").arg(name);
+
+    const bool   faster = speedup >= 1.0;
+    const double factor = faster ? speedup : 1.0 / speedup;
+    QString text = QStringLiteral("%1 is %2× %3 than %4")
+                       .arg(name, QString::number(factor, 'f', factor < 10.0 ? 2 : 1),
+                            faster ? QStringLiteral("faster") : QStringLiteral("slower"),
+                            reference);
+    if (!tested)
+        return text + QStringLiteral(" (untested: needs ≥ 2 repetitions)");
+    text += QStringLiteral(" ±%1%").arg(uncertainty() * 100.0, 0, 'f', 0);
+    if (!isSignificant())
+        text += QStringLiteral(" (not significant, p = %1)").arg(QString::number(pValue, 'g', 2));
+    return text;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Generation
+// ─────────────────────────────────────────────────────────────────────────────
+
+// static
+QString QuickBench::benchmarkName(const QString& snippetName) {
+    QString name = QStringLiteral("BM_");
+    for (const QChar c : snippetName.trimmed()) {
+        const bool plain = (c >= QLatin1Char('a') && c <= QLatin1Char('z'))
+                        || (c >= QLatin1Char('A') && c <= QLatin1Char('Z'))
+                        || (c >= QLatin1Char('0') && c <= QLatin1Char('9'))
+                        || c == QLatin1Char('_');
+        name += plain ? c : QLatin1Char('_');
+    }
+    return name;
+}
+
+// static
+QString QuickBench::validate(const QList<QuickBenchSnippet>& snippets) {
+    if (snippets.size() < MIN_SNIPPETS)
+        return QStringLiteral("Quick Bench needs at least %1 snippets.").arg(MIN_SNIPPETS);
+    if (snippets.size() > MAX_SNIPPETS)
+        return QStringLiteral("Quick Bench takes at most %1 snippets.").arg(MAX_SNIPPETS);
+
+    QSet<QString> names;
+    for (const QuickBenchSnippet& s : snippets) {
+        if (s.name.trimmed().isEmpty())
+            return QStringLiteral("Every snippet needs a name.");
+        if (s.code.trimmed().isEmpty())
+            return QStringLiteral("Snippet %1 is empty.").arg(s.name);
+        const QString name = benchmarkName(s.name);
+        if (names.contains(name))
+            return QStringLiteral("Two snippets are both named %1.").arg(name);
+        names.insert(name);
+    }
+    return QString();
+}
+
+// static
+QString QuickBench::generate(const QString& setup, const QList<QuickBenchSnippet>& snippets,
+                             QString* error) {
+    auto fail = [error](const QString& message) {
+        if (error) *error = message;
+        return QString();
+    };
+
+    const QString invalid = validate(snippets);
+    if (!invalid.isEmpty()) return fail(invalid);
+
+    QFile tmpl(QStringLiteral(":/templates/quick_bench_harness.cpp"));
+    if (!tmpl.open(QIODevice::ReadOnly | QIODevice::Text))
+        return fail(QStringLiteral("Quick Bench harness template is missing."));
+    QString source = QString::fromUtf8(tmpl.readAll());
+
+    // #include lines cannot live in a function; blank them so lines still match
+    QStringList includes;
+    QStringList setupLines = setup.split(QLatin1Char('\n'));
+    for (QString& line : setupLines) {
+        if (!line.trimmed().startsWith(QLatin1Char('#'))) continue;
+        if (!includes.contains(line.trimmed())) includes << line.trimmed();
+        line.clear();
+    }
+    const QString setupBody = indented(setupLines.join(QLatin1Char('\n')), QStringLiteral("    "));
+    source.replace(QLatin1String("{{INCLUDES}}"), includes.join(QLatin1Char('\n')));
+
+    const int begin = source.indexOf(QLatin1String(SECTION_BEGIN));
+    const int end   = source.indexOf(QLatin1String(SECTION_END));
+    if (begin < 0 || end < begin)
+        return fail(QStringLiteral("Quick Bench harness template has no snippet section."));
+    const int bodyStart = begin + int(qstrlen(SECTION_BEGIN));
+    const QString section = source.mid(bodyStart, end - bodyStart);
+
+    QString benchmarks;
+    for (const QuickBenchSnippet& s : snippets) {
+        QString label = s.name.trimmed();
+        label.remove(QLatin1Char('"')).remove(QLatin1Char('\\'));
+        QString b = section;
+        b.replace(QLatin1String("{{NAME}}"),  benchmarkName(s.name));
+        b.replace(QLatin1String("{{LABEL}}"), label);
+        b.replace(QLatin1String("{{SETUP}}"), setupBody);
+        // Last: snippet text may itself contain braces
+        b.replace(QLatin1String("{{CODE}}"),  indented(s.code, QStringLiteral("        ")));
+        benchmarks += b;
+    }
+
+    source.replace(begin, end + int(qstrlen(SECTION_END)) - begin, benchmarks);
+
+    // Once every line is in place: pane text is indented, so only the
+    // template's own markers stand alone on a line
+    QStringList lines = source.split(QLatin1Char('\n'));
+    for (int i = 0; i < lines.size(); ++i) {
+        if (lines[i] != QLatin1String(HARNESS_LINE)) continue;
+        lines[i] = QStringLiteral("#line %1 \"%2\"").arg(i + 2).arg(QLatin1String(HARNESS_FILE));
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+// static
+QStringList QuickBench::warnings(const QList<QuickBenchSnippet>& snippets) {
+    static const QRegularExpression returns(QStringLiteral("\\breturn\\b"));
+    QStringList warnings;
+    for (const QuickBenchSnippet& s : snippets) {
+        if (s.code.trimmed().isEmpty() || returns.match(s.code).hasMatch()) continue;
+        warnings << QStringLiteral("%1 returns nothing: only its writes to memory are kept, "
+                                   "so work that only feeds local variables may be optimised "
+                                   "away. Return the value it computes.").arg(s.name);
+    }
+    return warnings;
+}
+
+// static
+BenchmarkRunOptions QuickBench::runOptions(BenchmarkRunOptions options) {
+    options.randomInterleaving = true;
+    if (!options.adaptive)
+        options.repetitions = qMax(options.repetitions, MIN_REPETITIONS);
+    // Thread sweeps would rename the benchmarks away from their snippets
+    options.threadSweepMax = 0;
+    return options;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// Ratios
+// ─────────────────────────────────────────────────────────────────────────────
+
+// static
+QList<QuickBenchRatio> QuickBench::ratios(const BenchmarkResult& result,
+                                          const QList<QuickBenchSnippet>& snippets) {
+    QHash<QString, BenchmarkSummary> byName;
+    for (const BenchmarkSummary& s : BenchmarkStats::summarize(result.benchmarks))
+        byName.insert(s.runName, s);
+
+    QList<QuickBenchRatio> ratios;
+    if (snippets.isEmpty() || !byName.contains(benchmarkName(snippets.first().name)))
+        return ratios;
+
+    const BenchmarkSummary& ref = byName[benchmarkName(snippets.first().name)];
+    const double refNs = BenchmarkStats::toNanoseconds(ref.median, ref.timeUnit);
+    const QList<double> refTimes = inNanoseconds(ref.realTimes, ref.timeUnit);
+
+    for (const QuickBenchSnippet& snippet : snippets) {
+        const auto it = byName.constFind(benchmarkName(snippet.name));
+        if (it == byName.constEnd()) continue;
+        const double ns = BenchmarkStats::toNanoseconds(it->median, it->timeUnit);
+        if (ns <= 0.0 || refNs <= 0.0) continue;
+
+        QuickBenchRatio r;
+        r.name      = snippet.name;
+        r.reference = snippets.first().name;
+        r.speedup   = refNs / ns;
+        r.ciLow = r.ciHigh = r.speedup;
+        if (!r.isReference()) {
+            const QList<double> times = inNanoseconds(it->realTimes, it->timeUnit);
+            const MannWhitneyResult test = BenchmarkStats::mannWhitneyU(refTimes, times);
+            r.tested = test.valid;
+            r.pValue = test.pValue;
+            if (r.tested) {
+                const QPair<double, double> ci = BenchmarkStats::bootstrapMedianRatioCi(refTimes, times);
+                r.ciLow  = ci.first;
+                r.ciHigh = ci.second;
+            }
+        }
+        ratios << r;
+    }
+    return ratios;
+}
@@ -0,0 +1,161 @@
+#include "tools/SourceHeat.h"
+
+#include <QDir>
+#include <QFile>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QUuid>
+
+#include <algorithm>
+
+namespace {
+
+constexpr int PROCESS_TIMEOUT_MS = 30000;
+
+} // namespace
+
+bool SourceHeat::has(Metric metric) const {
+    switch (metric) {
+    case Metric::Instructions:
+        return std::any_of(instructions.cbegin(), instructions.cend(), [](int n) { return n > 0; });
+    case Metric::Bytes:
+        return std::any_of(bytes.cbegin(), bytes.cend(), [](qint64 n) { return n > 0; });
+    }
+    return false;
+}
+
+double SourceHeat::value(int line, Metric metric) const {
+    if (line <= 0) return 0.0;
+    switch (metric) {
+    case Metric::Instructions: return line < instructions.size() ? instructions[line] : 0.0;
+    case Metric::Bytes:        return line < bytes.size() ? double(bytes[line]) : 0.0;
+    }
+    return 0.0;
+}
+
+double SourceHeat::maxValue(Metric metric) const {
+    double max = 0.0;
+    for (int line = 1; line <= lineCount(); ++line) max = qMax(max, value(line, metric));
+    return max;
+}
+
+QString SourceHeat::describe(int line) const {
+    const int count = int(value(line, Metric::Instructions));
+    QStringList parts;
+    parts << (count == 1 ? QStringLiteral("1 instruction")
+                         : QStringLiteral("%1 instructions").arg(count));
+    if (has(Metric::Bytes)) {
+        parts << QStringLiteral("%1 bytes").arg(qint64(value(line, Metric::Bytes)));
+    }
+    return parts.join(QStringLiteral(" · "));
+}
+
+QString SourceHeat::metricName(Metric metric) {
+    switch (metric) {
+    case Metric::Instructions: return QStringLiteral("Instructions");
+    case Metric::Bytes:        return QStringLiteral("Code bytes");
+    }
+    return QString();
+}
+
+// static
+SourceHeat SourceHeat::fromDocument(const AsmDocument& document) {
+    SourceHeat heat;
+    if (document.srcOffsets.size() < 2) return heat;
+
+    // The CSR index already groups asm lines by source line; labels and
+    // data lines in a group are not code
+    heat.instructions.fill(0, document.srcOffsets.size() - 1);
+    for (int line = 1; line < heat.instructions.size(); ++line) {
+        const int count = document.asmCount(line);
+        for (int i = 0; i < count; ++i) {
+            if (document.lines[document.asmLineAt(line, i)].kind == AsmLine::Kind::Instruction) {
+                ++heat.instructions[line];
+            }
+        }
+    }
+    return heat;
+}
+
+void SourceHeat::applyLineBytes(const AsmDocument& document, const QVector<int>& lineBytes) {
+    bytes.clear();
+    if (lineBytes.isEmpty() || isEmpty()) return;
+
+    bytes.fill(0, instructions.size());
+    for (int line = 1; line < bytes.size(); ++line) {
+        const int count = document.asmCount(line);
+        for (int i = 0; i < count; ++i) {
+            const int asmLine = document.asmLineAt(line, i);
+            if (asmLine < lineBytes.size()
+                && document.lines[asmLine].kind == AsmLine::Kind::Instruction) {
+                bytes[line] += lineBytes[asmLine];
+            }
+        }
+    }
+}
+
+// ── Code size ─────────────────────────────────────────────────────────────────
+
+// static
+QVector<int> SourceHeat::measureLineBytes(const QString& listing, bool intelSyntax) {
+    const QString as = QStandardPaths::findExecutable(QStringLiteral("as"));
+    if (as.isEmpty() || listing.isEmpty()) return {};
+
+    const QString uuid = QUuid::createUuid().toString().remove('{').remove('}').remove('-');
+    const QString objPath = QDir::tempPath() + QStringLiteral("/cppatlas_heat_")
+        + uuid + QStringLiteral(".o");
+
+    // The filtered listing drops the syntax directive along with the others
+    QByteArray input;
+    int firstLine = 1;
+    if (intelSyntax) {
+        input = ".intel_syntax noprefix\n";
+        firstLine = 2;
+    }
+    input += listing.toUtf8();
+    input += '\n';
+
+    QProcess process;
+    process.start(as, { QStringLiteral("-aln"), QStringLiteral("--listing-cont-lines=8"),
+                        QStringLiteral("-o"), objPath });
+    process.write(input);
+    process.closeWriteChannel();
+    const bool ok = process.waitForFinished(PROCESS_TIMEOUT_MS)
+        && process.exitStatus() == QProcess::NormalExit;
+    if (!ok) process.kill();
+    QFile::remove(objPath);
+    // Lines that do not assemble fail the run but are still listed
+    if (!ok) return {};
+
+    const int lineCount = int(listing.count(QLatin1Char('\n'))) + 1;
+    const QVector<int> sizes = parseListing(process.readAllStandardOutput(), lineCount, firstLine);
+    const bool any = std::any_of(sizes.cbegin(), sizes.cend(), [](int n) { return n > 0; });
+    return any ? sizes : QVector<int>();
+}
+
+// static
+QVector<int> SourceHeat::parseListing(const QByteArray& listing, int lineCount, int firstLine) {
+    //    3 0000 B8010000 	 mov eax, 1      ← line, address, first bytes, source
+    //    3      00                          ← continuation: six spaces, more bytes
+    //    4              	.L2:
+    static const QRegularExpression firstRe(
+        QStringLiteral(R"(^\s*(\d+) [0-9A-Fa-f?]+ ([0-9A-Fa-f]*))"));
+    static const QRegularExpression contRe(QStringLiteral(R"(^\s*(\d+) {6}([0-9A-Fa-f]+))"));
+
+    QVector<int> sizes(qMax(0, lineCount), 0);
+    for (const QByteArray& raw : listing.split('\n')) {
+        // The source text after the tab could look like anything
+        const int tab = raw.indexOf('\t');
+        const QString head = QString::fromLatin1(tab >= 0 ? raw.left(tab) : raw);
+
+        QRegularExpressionMatch match = contRe.match(head);
+        if (!match.hasMatch()) match = firstRe.match(head);
+        if (!match.hasMatch()) continue;
+
+        const int line = match.captured(1).toInt() - firstLine;
+        if (line < 0 || line >= sizes.size()) continue;
+        sizes[line] += int(match.capturedLength(2) / 2);
+    }
+    return sizes;
+}
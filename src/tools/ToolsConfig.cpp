@@ -1,4 +1,5 @@
 #include "tools/ToolsConfig.h"
+#include "compiler/ToolchainDiscovery.h"
 
 #include <QCoreApplication>
 #include <QDir>
@@ -6,7 +7,6 @@
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QProcess>
 
 // CMake-injected compile-time hints (empty strings if not found at configure time)
 #ifndef CPPINSIGHTS_DEFAULT_PATH
@@ -68,11 +68,12 @@ bool ToolsConfig::isCppInsightsAvailable() const {
     if (QFileInfo::exists(m_cppInsightsPath)) {
         return true;
     }
-    // Probe via PATH (for bare name like "insights")
-    QProcess probe;
-    probe.start(m_cppInsightsPath, QStringList() << "--help");
-    probe.waitForFinished(3000);
-    return probe.exitStatus() == QProcess::NormalExit && probe.exitCode() == 0;
+    // Probe via PATH (for bare name like "insights"); cached by ToolchainDiscovery
+    return ToolchainDiscovery::instance().probe(m_cppInsightsPath, insightsProbeArguments()).available;
+}
+
+QStringList ToolsConfig::insightsProbeArguments() {
+    return {QStringLiteral("--help")};
 }
 
 // ---------------------------------------------------------------------------
@@ -264,19 +265,10 @@ QString ToolsConfig::autoDetectCppInsights() const {
     }
 #endif
 
-    // 2. Check system PATH
-    QProcess probe;
-#ifdef Q_OS_WIN
-    probe.start("where", QStringList() << "insights.exe");
-#else
-    probe.start("which", QStringList() << "insights");
-#endif
-    probe.waitForFinished(3000);
-    if (probe.exitCode() == 0) {
-        QString found = QString::fromLocal8Bit(probe.readAllStandardOutput()).trimmed();
-        if (!found.isEmpty()) {
-            return found.split('\n').first().trimmed();
-        }
+    // 2. Check system PATH (a filesystem lookup — no `which` process)
+    const QString found = ToolchainDiscovery::resolveExecutable(QStringLiteral("insights"));
+    if (!found.isEmpty()) {
+        return found;
     }
 
     // 3. Common install locations
@@ -2,6 +2,10 @@
 #include "ui/InsightsWidget.h"
 #include "ui/AssemblyWidget.h"
 #include "ui/BenchmarkWidget.h"
+#include "ui/BuildBenchWidget.h"
+#include "ui/CompileProfileWidget.h"
+#include "ui/MatrixWidget.h"
+#include "ui/AsmCompareWidget.h"
 
 #include <QFont>
 
@@ -12,10 +16,18 @@ AnalysisPanel::AnalysisPanel(QWidget* parent)
     m_insights  = new InsightsWidget(this);
     m_assembly  = new AssemblyWidget(this);
     m_benchmark = new BenchmarkWidget(this);
+    m_buildBench = new BuildBenchWidget(this);
+    m_compileProfile = new CompileProfileWidget(this);
+    m_matrix = new MatrixWidget(this);
+    m_asmCompare = new AsmCompareWidget(this);
 
     addTab(m_insights,  QStringLiteral("Insights"));
     addTab(m_assembly,  QStringLiteral("Assembly"));
     addTab(m_benchmark, QStringLiteral("Benchmark"));
+    addTab(m_buildBench, QStringLiteral("Build Bench"));
+    addTab(m_compileProfile, QStringLiteral("Compile Profile"));
+    addTab(m_matrix, QStringLiteral("Matrix"));
+    addTab(m_asmCompare, QStringLiteral("Asm Compare"));
 
     setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
     setMinimumWidth(100);
@@ -24,6 +36,8 @@ AnalysisPanel::AnalysisPanel(QWidget* parent)
     // Forward AssemblyWidget line-activation signal to MainWindow
     connect(m_assembly, &AssemblyWidget::sourceLineActivated,
             this,       &AnalysisPanel::sourceLineActivated);
+    connect(m_assembly, &AssemblyWidget::sourceHeatChanged,
+            this,       &AnalysisPanel::sourceHeatChanged);
 
     // ThemeManager connections are handled inside each sub-widget —
     // no additional wiring needed here.
@@ -33,18 +47,29 @@ void AnalysisPanel::setSourceCode(const QString& code,
                                   const QString& filePath) {
     m_insights->setSourceCode(code, filePath);
     m_assembly->setSourceCode(code, filePath);
+    m_compileProfile->setSourceCode(code, filePath);
+    m_matrix->setSourceCode(code, filePath);
+    m_asmCompare->setSourceCode(code, filePath);
     // BenchmarkWidget has its own independent editor — not forwarded.
 }
 
 void AnalysisPanel::setCompilerId(const QString& id) {
     m_assembly->setCompilerId(id);
     m_benchmark->setCompilerId(id);
+    m_buildBench->setCompilerId(id);
+    m_compileProfile->setCompilerId(id);
+    m_matrix->setCompilerId(id);
+    m_asmCompare->setCompilerId(id);
 }
 
 void AnalysisPanel::setStandard(const QString& standard) {
     m_insights->setStandard(standard);
     m_assembly->setStandard(standard);
     m_benchmark->setStandard(standard);
+    m_buildBench->setStandard(standard);
+    m_compileProfile->setStandard(standard);
+    m_matrix->setStandard(standard);
+    m_asmCompare->setStandard(standard);
 }
 
 void AnalysisPanel::applyToolEditorSettings(const AppSettings& s) {
@@ -67,6 +92,7 @@ void AnalysisPanel::applyToolEditorSettings(const AppSettings& s) {
         QFont f(family.isEmpty() ? QStringLiteral("Monospace") : family,
                 size > 0 ? size : 10);
         m_assembly->applyEditorSettings(f, lnums, wrap);
+        m_asmCompare->applyEditorSettings(f, lnums, wrap);   // Shares the assembly editor settings
     }
     // Benchmark
     {
@@ -77,5 +103,6 @@ void AnalysisPanel::applyToolEditorSettings(const AppSettings& s) {
         QFont f(family.isEmpty() ? QStringLiteral("Monospace") : family,
                 size > 0 ? size : 10);
         m_benchmark->applyEditorSettings(f, lnums, wrap);
+        m_buildBench->applyEditorSettings(f, lnums, wrap);   // Shares the benchmark editor settings
     }
 }
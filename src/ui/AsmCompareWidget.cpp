@@ -0,0 +1,628 @@
+#include "ui/AsmCompareWidget.h"
+#include "ui/ThemeManager.h"
+#include "tools/AsmParser.h"
+#include "tools/AssemblyRunner.h"
+#include "compiler/CompilerRegistry.h"
+#include "core/ThreadPoolTask.h"
+
+#include <Qsci/qsciscintilla.h>
+#include <Qsci/qscilexercpp.h>
+
+#include <QComboBox>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSignalBlocker>
+#include <QSplitter>
+#include <QTableWidget>
+#include <QToolButton>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace {
+
+enum SummaryColumn {
+    FunctionColumn,
+    LeftInstructionsColumn,
+    RightInstructionsColumn,
+    InstructionDeltaColumn,
+    LeftBytesColumn,
+    RightBytesColumn,
+    BytesDeltaColumn,
+    ChangedLinesColumn,
+    SummaryColumnCount
+};
+
+const char* const kDefaultMarch = "(default)";
+
+QString paneLetter(int index) {
+    return QString(QChar('A' + index));
+}
+
+QTableWidgetItem* countItem(qint64 value) {
+    auto* item = new QTableWidgetItem(value < 0 ? QStringLiteral("—") : QString::number(value));
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+// Signed delta; larger is neither good nor bad for instructions, so only
+// the direction is coloured
+QTableWidgetItem* deltaItem(qint64 delta, bool known, const Theme& theme) {
+    if (!known) return countItem(-1);
+    auto* item = new QTableWidgetItem(delta > 0 ? QStringLiteral("+%1").arg(delta)
+                                                : QString::number(delta));
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    if (delta > 0) item->setForeground(theme.warning);
+    else if (delta < 0) item->setForeground(theme.success);
+    return item;
+}
+
+} // namespace
+
+AsmCompareWidget::AsmCompareWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
+    m_diffPool.setMaxThreadCount(1);   // One diff at a time; newer ones supersede
+    setupUi();
+
+    // Two panes to start with: the classic "what does -O3 add over -O2"
+    createPane(QStringLiteral("O2"));
+    createPane(QStringLiteral("O3"));
+    relabelPanes();
+
+    connect(&CompilerRegistry::instance(), &CompilerRegistry::compilersChanged,
+            this, &AsmCompareWidget::rebuildCompilerCombos);
+    connect(ThemeManager::instance(), &ThemeManager::themeChanged,
+            this, &AsmCompareWidget::onThemeChanged);
+}
+
+AsmCompareWidget::~AsmCompareWidget() {
+    m_diffPool.clear();
+    m_diffPool.waitForDone();
+    for (Pane* pane : m_panes) {
+        delete pane->runner;   // Cancels its compiler before the pane goes
+    }
+    qDeleteAll(m_panes);
+}
+
+// ── UI setup ──────────────────────────────────────────────────────────────────
+
+void AsmCompareWidget::setupUi() {
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    mainLayout->setSpacing(0);
+
+    auto* toolbar = new QWidget(this);
+    setupToolbar(toolbar);
+    mainLayout->addWidget(toolbar);
+
+    auto* splitter = new QSplitter(Qt::Vertical, this);
+
+    m_paneSplitter = new QSplitter(Qt::Horizontal, splitter);
+    m_paneSplitter->setChildrenCollapsible(false);
+
+    // --- Summary strip ---
+    m_summaryTable = new QTableWidget(0, SummaryColumnCount, splitter);
+    m_summaryTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_summaryTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_summaryTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_summaryTable->verticalHeader()->setVisible(false);
+    m_summaryTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_summaryTable->horizontalHeader()->setSectionResizeMode(FunctionColumn, QHeaderView::Stretch);
+    m_summaryTable->setToolTip(QStringLiteral("Click a function to scroll both panes to it"));
+    connect(m_summaryTable, &QTableWidget::cellClicked,
+            this, &AsmCompareWidget::onSummaryCellClicked);
+
+    splitter->addWidget(m_paneSplitter);
+    splitter->addWidget(m_summaryTable);
+    splitter->setStretchFactor(0, 3);
+    splitter->setStretchFactor(1, 1);
+
+    mainLayout->addWidget(splitter, 1);
+}
+
+void AsmCompareWidget::setupToolbar(QWidget* toolbar) {
+    auto* tbLayout = new QHBoxLayout(toolbar);
+    tbLayout->setContentsMargins(6, 4, 6, 4);
+
+    m_addButton = new QPushButton(QStringLiteral("+ Pane"), toolbar);
+    m_addButton->setToolTip(QStringLiteral("Add another configuration (up to %1)").arg(MAX_PANES));
+    connect(m_addButton, &QPushButton::clicked, this, &AsmCompareWidget::addPane);
+    tbLayout->addWidget(m_addButton);
+
+    tbLayout->addSpacing(8);
+
+    // Which two panes are diffed: removed lines show in the left one,
+    // added lines in the right one
+    tbLayout->addWidget(new QLabel(QStringLiteral("Diff:"), toolbar));
+    m_leftCombo = new QComboBox(toolbar);
+    tbLayout->addWidget(m_leftCombo);
+    tbLayout->addWidget(new QLabel(QStringLiteral("vs"), toolbar));
+    m_rightCombo = new QComboBox(toolbar);
+    tbLayout->addWidget(m_rightCombo);
+    connect(m_leftCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &AsmCompareWidget::scheduleDiff);
+    connect(m_rightCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &AsmCompareWidget::scheduleDiff);
+
+    tbLayout->addStretch();
+
+    m_runButton = new QPushButton(QStringLiteral("▶  Generate All"), toolbar);
+    m_runButton->setToolTip(QStringLiteral("Generate assembly for every pane, in parallel"));
+    connect(m_runButton, &QPushButton::clicked, this, &AsmCompareWidget::generateAll);
+    tbLayout->addWidget(m_runButton);
+
+    m_stopButton = new QPushButton(QStringLiteral("■ Stop"), toolbar);
+    m_stopButton->setEnabled(false);
+    connect(m_stopButton, &QPushButton::clicked, this, &AsmCompareWidget::stopAll);
+    tbLayout->addWidget(m_stopButton);
+
+    m_statusLabel = new QLabel(QStringLiteral("Ready"), toolbar);
+    m_statusLabel->setMinimumWidth(220);
+    tbLayout->addWidget(m_statusLabel);
+}
+
+AsmCompareWidget::Pane* AsmCompareWidget::createPane(const QString& optLevel) {
+    auto* pane = new Pane;
+
+    pane->container = new QWidget(m_paneSplitter);
+    auto* layout = new QVBoxLayout(pane->container);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(0);
+
+    // --- Per-pane configuration row ---
+    auto* header = new QWidget(pane->container);
+    auto* hLayout = new QHBoxLayout(header);
+    hLayout->setContentsMargins(6, 2, 6, 2);
+
+    pane->titleLabel = new QLabel(header);
+    QFont titleFont = pane->titleLabel->font();
+    titleFont.setBold(true);
+    pane->titleLabel->setFont(titleFont);
+    hLayout->addWidget(pane->titleLabel);
+
+    pane->compilerCombo = new QComboBox(header);
+    connect(pane->compilerCombo, QOverload<int>::of(&QComboBox::activated),
+            this, [pane]() { pane->userPickedCompiler = true; });
+    hLayout->addWidget(pane->compilerCombo);
+
+    pane->optCombo = new QComboBox(header);
+    pane->optCombo->addItems({ "O0", "O1", "O2", "O3", "Os" });
+    pane->optCombo->setCurrentText(optLevel);
+    hLayout->addWidget(pane->optCombo);
+
+    pane->marchCombo = new QComboBox(header);
+    pane->marchCombo->setEditable(true);
+    pane->marchCombo->addItems({ kDefaultMarch, "x86-64", "x86-64-v2", "x86-64-v3",
+                                 "x86-64-v4", "native" });
+    pane->marchCombo->setToolTip(QStringLiteral("-march target"));
+    hLayout->addWidget(pane->marchCombo);
+
+    pane->flagsEdit = new QLineEdit(header);
+    pane->flagsEdit->setPlaceholderText(QStringLiteral("extra flags"));
+    hLayout->addWidget(pane->flagsEdit, 1);
+
+    pane->removeButton = new QToolButton(header);
+    pane->removeButton->setText(QStringLiteral("✕"));
+    pane->removeButton->setToolTip(QStringLiteral("Remove this pane"));
+    connect(pane->removeButton, &QToolButton::clicked, this, [this, pane]() { removePane(pane); });
+    hLayout->addWidget(pane->removeButton);
+
+    layout->addWidget(header);
+
+    // --- Listing ---
+    pane->editor = new QsciScintilla(pane->container);
+    pane->lexer  = new QsciLexerCPP(pane->editor);   // Basic highlighting, as in AssemblyWidget
+    pane->editor->setLexer(pane->lexer);
+    pane->editor->setReadOnly(true);
+    pane->editor->setTabWidth(4);
+    pane->editor->setMarginType(0, QsciScintilla::NumberMargin);
+    pane->editor->SendScintilla(QsciScintilla::SCI_SETUNDOCOLLECTION, 0UL);
+    pane->addedMarker   = pane->editor->markerDefine(QsciScintilla::Background);
+    pane->removedMarker = pane->editor->markerDefine(QsciScintilla::Background);
+    layout->addWidget(pane->editor, 1);
+
+    // --- Backend: one runner per pane, so all panes compile concurrently ---
+    pane->runner = new AssemblyRunner(this);
+    connect(pane->runner, &AssemblyRunner::finished, this,
+            [this, pane](bool success, const QString& output, const QString& error) {
+                onPaneFinished(pane, success, output, error);
+            });
+
+    m_panes.append(pane);
+    m_paneSplitter->addWidget(pane->container);
+
+    rebuildCompilerCombos();
+    applyThemeToPane(pane);
+    applyEditorSettings(m_editorFont, m_showLineNumbers, m_wordWrap);
+    return pane;
+}
+
+void AsmCompareWidget::relabelPanes() {
+    QStringList letters;
+    for (int i = 0; i < m_panes.size(); ++i) {
+        letters << paneLetter(i);
+        m_panes[i]->titleLabel->setText(letters.last());
+        m_panes[i]->removeButton->setEnabled(m_panes.size() > 2);
+    }
+    m_addButton->setEnabled(m_panes.size() < MAX_PANES);
+
+    // Keep the chosen pair where possible; default to A vs B
+    const int left  = m_leftCombo->currentIndex();
+    const int right = m_rightCombo->currentIndex();
+    {
+        const QSignalBlocker leftBlocker(m_leftCombo);
+        const QSignalBlocker rightBlocker(m_rightCombo);
+        m_leftCombo->clear();
+        m_rightCombo->clear();
+        m_leftCombo->addItems(letters);
+        m_rightCombo->addItems(letters);
+        m_leftCombo->setCurrentIndex(left >= 0 && left < letters.size() ? left : 0);
+        m_rightCombo->setCurrentIndex(right >= 0 && right < letters.size()
+                                          ? right : qMin(1, letters.size() - 1));
+    }
+    scheduleDiff();
+}
+
+void AsmCompareWidget::rebuildCompilerCombos() {
+    QStringList ids;
+    for (const auto& compiler : CompilerRegistry::instance().getAvailableCompilers()) {
+        ids << compiler->id();
+    }
+    const QString fallback = !m_compilerId.isEmpty() && ids.contains(m_compilerId)
+        ? m_compilerId : CompilerRegistry::instance().defaultCompilerId();
+
+    for (Pane* pane : m_panes) {
+        const QString current = pane->compilerCombo->currentText();
+        const QSignalBlocker blocker(pane->compilerCombo);
+        pane->compilerCombo->clear();
+        pane->compilerCombo->addItems(ids);
+        if (pane->userPickedCompiler && ids.contains(current)) {
+            pane->compilerCombo->setCurrentText(current);
+        } else if (ids.contains(fallback)) {
+            pane->compilerCombo->setCurrentText(fallback);
+        }
+    }
+}
+
+// ── Public interface ──────────────────────────────────────────────────────────
+
+void AsmCompareWidget::setSourceCode(const QString& code, const QString& filePath) {
+    m_currentSourceCode = code;
+    m_currentFilePath   = filePath;
+}
+
+void AsmCompareWidget::setCompilerId(const QString& id) {
+    m_compilerId = id;
+    rebuildCompilerCombos();
+}
+
+void AsmCompareWidget::setStandard(const QString& standard) {
+    m_standard = standard;
+}
+
+void AsmCompareWidget::addPane() {
+    if (m_panes.size() >= MAX_PANES) return;
+    createPane(m_panes.isEmpty() ? QStringLiteral("O2") : m_panes.last()->optCombo->currentText());
+    relabelPanes();
+}
+
+void AsmCompareWidget::removePane(Pane* pane) {
+    if (m_panes.size() <= 2 || !m_panes.contains(pane)) return;
+    ++m_diffSerial;
+    m_panes.removeOne(pane);
+    delete pane->runner;
+    pane->container->deleteLater();
+    delete pane;
+    relabelPanes();
+    updateStatus();
+}
+
+// ── Run ──────────────────────────────────────────────────────────────────────
+
+void AsmCompareWidget::generateAll() {
+    if (m_currentSourceCode.isEmpty()) {
+        m_statusLabel->setText(QStringLiteral("No source code loaded."));
+        return;
+    }
+
+    clearDiff();
+    for (Pane* pane : m_panes) {
+        runPane(pane);
+    }
+    updateStatus();
+}
+
+void AsmCompareWidget::runPane(Pane* pane) {
+    QStringList flags;
+    flags << QStringLiteral("-std=") + m_standard;
+    flags << QStringLiteral("-") + pane->optCombo->currentText();
+    const QString march = pane->marchCombo->currentText().trimmed();
+    if (!march.isEmpty() && march != QLatin1String(kDefaultMarch)) {
+        flags << QStringLiteral("-march=") + march;
+    }
+    flags << pane->flagsEdit->text().split(QLatin1Char(' '), Qt::SkipEmptyParts);
+
+    const QString sourceDir = m_currentFilePath.isEmpty()
+        ? QString() : QFileInfo(m_currentFilePath).absolutePath();
+
+    pane->running = true;
+    pane->runner->setCompilerId(pane->compilerCombo->currentText());
+    pane->runner->runSource(m_currentSourceCode, flags, sourceDir);   // May finish synchronously
+}
+
+void AsmCompareWidget::stopAll() {
+    for (Pane* pane : m_panes) {
+        pane->runner->cancel();
+        pane->running = false;
+    }
+    ++m_diffSerial;
+    updateStatus();
+    m_statusLabel->setText(QStringLiteral("Stopped."));
+}
+
+void AsmCompareWidget::onPaneFinished(Pane* pane, bool success, const QString& output,
+                                      const QString& error) {
+    pane->running = false;
+    ++pane->generation;
+
+    if (success) {
+        auto compiler = CompilerRegistry::instance().getCompiler(pane->runner->compilerId());
+        pane->rawAsm       = output.toUtf8();
+        pane->document     = AsmParser::parse(pane->rawAsm);
+        pane->compilerPath = compiler ? compiler->executablePath() : QString();
+        pane->editor->setText(pane->document.text());
+    } else {
+        pane->rawAsm.clear();
+        pane->document = AsmDocument();
+        pane->editor->setText(QStringLiteral("; Assembly error:\n;\n")
+                              + error.split('\n').join(QStringLiteral("\n; ")));
+    }
+
+    updateStatus();
+    scheduleDiff();
+}
+
+void AsmCompareWidget::updateStatus() {
+    const int running = int(std::count_if(m_panes.cbegin(), m_panes.cend(),
+                                           [](const Pane* pane) { return pane->running; }));
+    m_runButton->setEnabled(running == 0);
+    m_stopButton->setEnabled(running > 0);
+    if (running > 0) {
+        m_statusLabel->setText(QStringLiteral("Generating — %1 of %2 panes running…")
+                                   .arg(running).arg(m_panes.size()));
+    }
+}
+
+// ── Diff ─────────────────────────────────────────────────────────────────────
+
+AsmCompareWidget::Pane* AsmCompareWidget::diffPane(const QComboBox* combo) const {
+    const int index = combo->currentIndex();
+    return (index >= 0 && index < m_panes.size()) ? m_panes[index] : nullptr;
+}
+
+void AsmCompareWidget::scheduleDiff() {
+    clearDiff();
+    const quint64 serial = ++m_diffSerial;
+
+    Pane* left  = diffPane(m_leftCombo);
+    Pane* right = diffPane(m_rightCombo);
+    if (!left || !right || left == right || left->running || right->running
+        || left->document.lines.isEmpty() || right->document.lines.isEmpty()) {
+        return;
+    }
+
+    // Everything the worker needs is copied (implicitly shared, so cheap)
+    const AsmDocument leftDoc  = left->document;
+    const AsmDocument rightDoc = right->document;
+    const quint64 leftGen  = left->generation;
+    const quint64 rightGen = right->generation;
+    const bool measureLeft  = left->sizesGeneration != leftGen;
+    const bool measureRight = right->sizesGeneration != rightGen;
+    const QByteArray leftAsm  = measureLeft  ? left->rawAsm  : QByteArray();
+    const QByteArray rightAsm = measureRight ? right->rawAsm : QByteArray();
+    const QString leftCompiler  = left->compilerPath;
+    const QString rightCompiler = right->compilerPath;
+    const QHash<QString, qint64> knownLeft  = left->sizes;
+    const QHash<QString, qint64> knownRight = right->sizes;
+
+    m_statusLabel->setText(QStringLiteral("Diffing %1 vs %2…")
+                               .arg(m_leftCombo->currentText(), m_rightCombo->currentText()));
+
+    m_diffPool.clear();   // Queued diffs are already stale
+    ThreadPoolTask::start(&m_diffPool, [=]() {
+        AsmDiffResult result = AsmDiff::compare(leftDoc, rightDoc);
+        const QHash<QString, qint64> leftSizes = measureLeft
+            ? AsmDiff::measureFunctionSizes(leftCompiler, leftAsm) : knownLeft;
+        const QHash<QString, qint64> rightSizes = measureRight
+            ? AsmDiff::measureFunctionSizes(rightCompiler, rightAsm) : knownRight;
+        AsmDiff::applySizes(result, leftSizes, rightSizes);
+
+        QMetaObject::invokeMethod(this, [=]() {
+            if (serial != m_diffSerial) return;   // Superseded, or a pane went away
+            if (left->generation != leftGen || right->generation != rightGen) return;
+            left->sizes  = leftSizes;
+            left->sizesGeneration  = leftGen;
+            right->sizes = rightSizes;
+            right->sizesGeneration = rightGen;
+            applyDiff(left, right, result);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void AsmCompareWidget::clearDiff() {
+    for (Pane* pane : m_panes) {
+        pane->editor->markerDeleteAll(pane->addedMarker);
+        pane->editor->markerDeleteAll(pane->removedMarker);
+    }
+    m_summaryTable->setRowCount(0);
+}
+
+void AsmCompareWidget::applyDiff(Pane* left, Pane* right, const AsmDiffResult& result) {
+    for (int line : result.removedLines) {
+        left->editor->markerAdd(line, left->removedMarker);
+    }
+    for (int line : result.addedLines) {
+        right->editor->markerAdd(line, right->addedMarker);
+    }
+
+    const QString a = m_leftCombo->currentText();
+    const QString b = m_rightCombo->currentText();
+    m_summaryTable->setHorizontalHeaderLabels({
+        QStringLiteral("Function"),
+        QStringLiteral("Instr %1").arg(a), QStringLiteral("Instr %1").arg(b), QStringLiteral("Δ instr"),
+        QStringLiteral("Bytes %1").arg(a), QStringLiteral("Bytes %1").arg(b), QStringLiteral("Δ bytes"),
+        QStringLiteral("−/+ lines") });
+
+    // Changed functions first, biggest instruction swing on top
+    QVector<AsmFunctionDelta> rows = result.functions;
+    std::stable_sort(rows.begin(), rows.end(),
+                     [](const AsmFunctionDelta& x, const AsmFunctionDelta& y) {
+                         if (x.changed() != y.changed()) return x.changed();
+                         return qAbs(x.instructionDelta()) > qAbs(y.instructionDelta());
+                     });
+
+    AsmFunctionDelta total;
+    total.name = QStringLiteral("Total");
+    total.leftInstructions = total.rightInstructions = 0;
+    bool leftBytesKnown = true;
+    bool rightBytesKnown = true;
+    total.leftBytes = total.rightBytes = 0;
+    int changedFunctions = 0;
+    for (const AsmFunctionDelta& delta : rows) {
+        total.leftInstructions  += qMax(delta.leftInstructions, 0);
+        total.rightInstructions += qMax(delta.rightInstructions, 0);
+        total.removed += delta.removed;
+        total.added   += delta.added;
+        if (delta.leftInstructions >= 0) {
+            if (delta.leftBytes < 0) leftBytesKnown = false; else total.leftBytes += delta.leftBytes;
+        }
+        if (delta.rightInstructions >= 0) {
+            if (delta.rightBytes < 0) rightBytesKnown = false; else total.rightBytes += delta.rightBytes;
+        }
+        if (delta.changed()) ++changedFunctions;
+    }
+    if (!leftBytesKnown)  total.leftBytes  = -1;
+    if (!rightBytesKnown) total.rightBytes = -1;
+    rows.prepend(total);
+
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    m_summaryTable->setRowCount(rows.size());
+    for (int row = 0; row < rows.size(); ++row) {
+        const AsmFunctionDelta& delta = rows[row];
+        auto* nameItem = new QTableWidgetItem(delta.name);
+        if (row > 0) {
+            nameItem->setData(Qt::UserRole, delta.symbol);
+            nameItem->setToolTip(delta.symbol);
+        } else {
+            QFont bold = nameItem->font();
+            bold.setBold(true);
+            nameItem->setFont(bold);
+        }
+        if (delta.leftInstructions < 0)  nameItem->setText(delta.name + QStringLiteral("  (only %1)").arg(b));
+        if (delta.rightInstructions < 0) nameItem->setText(delta.name + QStringLiteral("  (only %1)").arg(a));
+        m_summaryTable->setItem(row, FunctionColumn, nameItem);
+
+        m_summaryTable->setItem(row, LeftInstructionsColumn,  countItem(delta.leftInstructions));
+        m_summaryTable->setItem(row, RightInstructionsColumn, countItem(delta.rightInstructions));
+        m_summaryTable->setItem(row, InstructionDeltaColumn,
+                                deltaItem(delta.instructionDelta(), true, theme));
+        m_summaryTable->setItem(row, LeftBytesColumn,  countItem(delta.leftBytes));
+        m_summaryTable->setItem(row, RightBytesColumn, countItem(delta.rightBytes));
+        const bool bytesKnown = (delta.leftInstructions < 0 || delta.leftBytes >= 0)
+                             && (delta.rightInstructions < 0 || delta.rightBytes >= 0);
+        m_summaryTable->setItem(row, BytesDeltaColumn,
+                                deltaItem(qMax(delta.rightBytes, qint64(0)) - qMax(delta.leftBytes, qint64(0)),
+                                          bytesKnown, theme));
+        auto* linesItem = new QTableWidgetItem(QStringLiteral("−%1 / +%2").arg(delta.removed).arg(delta.added));
+        linesItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        m_summaryTable->setItem(row, ChangedLinesColumn, linesItem);
+    }
+
+    m_statusLabel->setText(QStringLiteral("%1 vs %2 — %3 of %4 functions differ (−%5 / +%6 instructions).")
+                               .arg(a, b)
+                               .arg(changedFunctions)
+                               .arg(result.functions.size())
+                               .arg(total.removed)
+                               .arg(total.added));
+}
+
+void AsmCompareWidget::onSummaryCellClicked(int row, int column) {
+    Q_UNUSED(column);
+    const QTableWidgetItem* item = m_summaryTable->item(row, FunctionColumn);
+    const QString symbol = item ? item->data(Qt::UserRole).toString() : QString();
+    if (symbol.isEmpty()) return;
+
+    for (Pane* pane : { diffPane(m_leftCombo), diffPane(m_rightCombo) }) {
+        if (!pane) continue;
+        for (const AsmFunction& function : pane->document.functions) {
+            if (function.symbol == symbol) {
+                pane->editor->setFirstVisibleLine(function.firstLine);
+                break;
+            }
+        }
+    }
+}
+
+// ── Theme / settings ─────────────────────────────────────────────────────────
+
+void AsmCompareWidget::applyThemeToPane(Pane* pane) {
+    Theme theme = ThemeManager::instance()->currentTheme();
+
+    pane->lexer->setDefaultPaper(theme.editorBackground);
+    pane->lexer->setDefaultColor(theme.editorForeground);
+    for (int s = 0; s <= 128; ++s) {
+        pane->lexer->setPaper(theme.editorBackground, s);
+        pane->lexer->setColor(theme.editorForeground, s);
+    }
+    pane->lexer->setColor(theme.syntaxKeyword, QsciLexerCPP::Keyword);
+    pane->lexer->setColor(theme.syntaxComment, QsciLexerCPP::CommentLine);
+    pane->lexer->setColor(theme.syntaxNumber,  QsciLexerCPP::Number);
+    pane->lexer->setColor(theme.syntaxString,  QsciLexerCPP::DoubleQuotedString);
+
+    pane->editor->setPaper(theme.editorBackground);
+    pane->editor->setColor(theme.editorForeground);
+    pane->editor->setCaretLineVisible(true);
+    pane->editor->setCaretLineBackgroundColor(theme.editorCurrentLine);
+    pane->editor->setMarginsBackgroundColor(theme.sidebarBackground);
+    pane->editor->setMarginsForegroundColor(theme.textSecondary);
+    pane->editor->setFoldMarginColors(theme.sidebarBackground, theme.sidebarBackground);
+
+    // Same translucency as AssemblyWidget's source highlight
+    QColor added = theme.success;
+    added.setAlpha(80);
+    QColor removed = theme.error;
+    removed.setAlpha(80);
+    pane->editor->setMarkerBackgroundColor(added, pane->addedMarker);
+    pane->editor->setMarkerBackgroundColor(removed, pane->removedMarker);
+
+    pane->editor->recolor();
+}
+
+void AsmCompareWidget::onThemeChanged(const QString& themeName) {
+    Q_UNUSED(themeName);
+    for (Pane* pane : m_panes) {
+        applyThemeToPane(pane);
+    }
+}
+
+void AsmCompareWidget::applyEditorSettings(const QFont& font, bool showLineNumbers, bool wordWrap) {
+    m_editorFont      = font;
+    m_showLineNumbers = showLineNumbers;
+    m_wordWrap        = wordWrap;
+    for (Pane* pane : m_panes) {
+        pane->editor->setFont(font);
+        pane->editor->setMarginsFont(font);
+        pane->lexer->setDefaultFont(font);
+        for (int style = 0; style < 128; ++style)
+            pane->lexer->setFont(font, style);
+        pane->editor->setMarginLineNumbers(0, showLineNumbers);
+        pane->editor->setMarginWidth(0, showLineNumbers ? QStringLiteral("00000") : QStringLiteral("0"));
+        pane->editor->setWrapMode(wordWrap ? QsciScintilla::WrapWord : QsciScintilla::WrapNone);
+    }
+}
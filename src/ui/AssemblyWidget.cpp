@@ -1,35 +1,63 @@
 #include "ui/AssemblyWidget.h"
 #include "ui/ThemeManager.h"
+#include "editor/HeatMargin.h"
+#include "tools/AsmParser.h"
+#include "tools/McaRunner.h"
+#include "core/ThreadPoolTask.h"
 
 #include <Qsci/qsciscintilla.h>
 #include <Qsci/qscilexercpp.h>
 
+#include <QAction>
+#include <QCheckBox>
 #include <QComboBox>
-#include <QDir>
-#include <QFile>
+#include <QFileInfo>
 #include <QHBoxLayout>
 #include <QLabel>
+#include <QMenu>
+#include <QPair>
 #include <QPushButton>
 #include <QSplitter>
-#include <QTextStream>
-#include <QUuid>
+#include <QTimer>
+#include <QToolButton>
+#include <QToolTip>
 #include <QVBoxLayout>
 
+#include <algorithm>
+
+namespace {
+// Text margin of the asm pane holding per-instruction llvm-mca numbers
+constexpr int MCA_MARGIN = 1;
+// Heat margin of the source mirror, after numbers, markers and folding
+constexpr int HEAT_MARGIN = 3;
+// Heat combo entry for "no heat"
+constexpr int HEAT_OFF = -1;
+} // namespace
+
 AssemblyWidget::AssemblyWidget(QWidget* parent)
     : QWidget(parent)
     , m_runner(new AssemblyRunner(this))
+    , m_mcaRunner(new McaRunner(this))
 {
     setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
     setupUi();
 
+    m_liveTimer = new QTimer(this);
+    m_liveTimer->setSingleShot(true);
+    m_liveTimer->setInterval(LIVE_DEBOUNCE_MS);
+    connect(m_liveTimer, &QTimer::timeout, this, &AssemblyWidget::runAssembly);
+
+    m_heatPool.setMaxThreadCount(1);   // One measurement at a time; newer ones supersede
+
     connect(m_runner, &AssemblyRunner::started,
             this, &AssemblyWidget::onRunnerStarted);
     connect(m_runner, &AssemblyRunner::finished,
             this, &AssemblyWidget::onRunnerFinished);
     connect(m_runner, &AssemblyRunner::progressMessage,
             this, &AssemblyWidget::onProgressMessage);
-    connect(m_runner, &AssemblyRunner::lineMapReady,
-            this, &AssemblyWidget::onLineMapReady);
+
+    connect(m_mcaRunner, &McaRunner::finished,
+            this, &AssemblyWidget::onMcaFinished);
 
     connect(ThemeManager::instance(), &ThemeManager::themeChanged,
             this, &AssemblyWidget::onThemeChanged);
@@ -37,6 +65,11 @@ AssemblyWidget::AssemblyWidget(QWidget* parent)
     onThemeChanged(ThemeManager::instance()->currentThemeName());
 }
 
+AssemblyWidget::~AssemblyWidget() {
+    m_heatPool.clear();
+    m_heatPool.waitForDone();
+}
+
 // ── UI setup ──────────────────────────────────────────────────────────────────
 
 void AssemblyWidget::setupUi() {
@@ -54,6 +87,8 @@ void AssemblyWidget::setupUi() {
     m_optimizationCombo = new QComboBox(toolbar);
     m_optimizationCombo->addItems({ "O0", "O1", "O2", "O3", "Os" });
     m_optimizationCombo->setCurrentText(QStringLiteral("O0"));
+    connect(m_optimizationCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &AssemblyWidget::scheduleLiveRun);
     tbLayout->addWidget(m_optimizationCombo);
 
     tbLayout->addSpacing(8);
@@ -62,10 +97,82 @@ void AssemblyWidget::setupUi() {
     tbLayout->addWidget(new QLabel(QStringLiteral("Syntax:"), toolbar));
     m_syntaxCombo = new QComboBox(toolbar);
     m_syntaxCombo->addItems({ "AT&T", "Intel" });
+    connect(m_syntaxCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &AssemblyWidget::scheduleLiveRun);
     tbLayout->addWidget(m_syntaxCombo);
 
+    tbLayout->addSpacing(8);
+
+    // Output filters — applied to the cached raw listing, no recompile
+    auto* filterButton = new QToolButton(toolbar);
+    filterButton->setText(QStringLiteral("Filters"));
+    filterButton->setPopupMode(QToolButton::InstantPopup);
+    m_filterMenu = new QMenu(filterButton);
+    const QList<QPair<QString, QString>> filters = {
+        { QStringLiteral("directives"), QStringLiteral("Hide directives") },
+        { QStringLiteral("comments"),   QStringLiteral("Hide comments") },
+        { QStringLiteral("labels"),     QStringLiteral("Hide unused labels") },
+        { QStringLiteral("library"),    QStringLiteral("Hide library functions") },
+        { QStringLiteral("demangle"),   QStringLiteral("Demangle identifiers") },
+    };
+    for (const auto& filter : filters) {
+        QAction* action = m_filterMenu->addAction(filter.second);
+        action->setData(filter.first);
+        action->setCheckable(true);
+        action->setChecked(true);
+    }
+    connect(m_filterMenu, &QMenu::triggered, this, &AssemblyWidget::applyFilters);
+    filterButton->setMenu(m_filterMenu);
+    tbLayout->addWidget(filterButton);
+
+    tbLayout->addSpacing(8);
+
+    // Static throughput analysis of the selection / function at the cursor
+    tbLayout->addWidget(new QLabel(QStringLiteral("CPU:"), toolbar));
+    m_cpuCombo = new QComboBox(toolbar);
+    m_cpuCombo->setEditable(true);   // Any -mcpu value llvm-mca knows
+    m_cpuCombo->addItems({ "native", "x86-64-v3", "skylake", "skylake-avx512",
+                           "icelake-server", "alderlake", "znver2", "znver3" });
+    m_cpuCombo->setToolTip(QStringLiteral("CPU scheduling model used by llvm-mca"));
+    tbLayout->addWidget(m_cpuCombo);
+
+    m_analyzeButton = new QPushButton(QStringLiteral("Analyze"), toolbar);
+    if (m_mcaRunner->isAvailable()) {
+        m_analyzeButton->setToolTip(
+            QStringLiteral("Estimate throughput of the selected lines, or of the function "
+                           "at the cursor, with llvm-mca"));
+    } else {
+        m_analyzeButton->setEnabled(false);
+        m_analyzeButton->setToolTip(
+            QStringLiteral("llvm-mca was not found on PATH — install LLVM to enable"));
+    }
+    connect(m_analyzeButton, &QPushButton::clicked, this, &AssemblyWidget::analyzeSelection);
+    tbLayout->addWidget(m_analyzeButton);
+
+    tbLayout->addSpacing(8);
+
+    // Per-source-line cost shading of the mirror and the editor
+    tbLayout->addWidget(new QLabel(QStringLiteral("Heat:"), toolbar));
+    m_heatCombo = new QComboBox(toolbar);
+    m_heatCombo->addItem(QStringLiteral("Off"), HEAT_OFF);
+    for (SourceHeat::Metric metric : { SourceHeat::Metric::Instructions,
+                                       SourceHeat::Metric::Bytes }) {
+        m_heatCombo->addItem(SourceHeat::metricName(metric), int(metric));
+    }
+    m_heatCombo->setCurrentIndex(1);
+    m_heatCombo->setToolTip(QStringLiteral("Shade source lines by the code generated for them"));
+    connect(m_heatCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &AssemblyWidget::updateHeat);
+    tbLayout->addWidget(m_heatCombo);
+
     tbLayout->addStretch();
 
+    // Live mode — regenerate as the buffer changes
+    m_liveCheck = new QCheckBox(QStringLiteral("Live"), toolbar);
+    m_liveCheck->setToolTip(QStringLiteral("Regenerate assembly as you type"));
+    connect(m_liveCheck, &QCheckBox::toggled, this, &AssemblyWidget::setLiveMode);
+    tbLayout->addWidget(m_liveCheck);
+
     // Run button
     m_runButton = new QPushButton(QStringLiteral("▶  Generate Assembly"), toolbar);
     m_runButton->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_F9));
@@ -95,6 +202,16 @@ void AssemblyWidget::setupUi() {
     m_sourceEditor->setReadOnly(true);
     m_sourceEditor->setToolTip(QStringLiteral("Source code (read-only mirror)"));
     setupLexer(m_sourceEditor, m_sourceLexer);
+    m_sourceHeat = new HeatMargin(m_sourceEditor, HEAT_MARGIN);
+    m_sourceEditor->SendScintilla(QsciScintilla::SCI_SETMOUSEDWELLTIME, 500);
+    connect(m_sourceEditor, &QsciScintilla::SCN_DWELLSTART, this, [this](int, int x, int y) {
+        const QString tip = m_sourceHeat->toolTipAt(x, y);
+        if (!tip.isEmpty()) {
+            QToolTip::showText(m_sourceEditor->viewport()->mapToGlobal(QPoint(x, y)), tip,
+                               m_sourceEditor->viewport());
+        }
+    });
+    connect(m_sourceEditor, &QsciScintilla::SCN_DWELLEND, this, []() { QToolTip::hideText(); });
     splitter->addWidget(m_sourceEditor);
 
     m_asmLexer  = new QsciLexerCPP(this); // re-use CPP lexer for basic highlighting
@@ -102,6 +219,13 @@ void AssemblyWidget::setupUi() {
     m_asmEditor->setReadOnly(true);
     m_asmEditor->setToolTip(QStringLiteral("Assembly output"));
     setupLexer(m_asmEditor, m_asmLexer);
+    // Both panes are rewritten programmatically on every change
+    m_sourceEditor->SendScintilla(QsciScintilla::SCI_SETUNDOCOLLECTION, 0UL);
+    m_asmEditor->SendScintilla(QsciScintilla::SCI_SETUNDOCOLLECTION, 0UL);
+    // Hidden until an analysis fills it
+    m_asmEditor->setMarginType(MCA_MARGIN, QsciScintilla::TextMargin);
+    m_asmEditor->setMarginWidth(MCA_MARGIN, 0);
+    m_asmEditor->setAnnotationDisplay(QsciScintilla::AnnotationBoxed);
     splitter->addWidget(m_asmEditor);
 
     splitter->setStretchFactor(0, 1);
@@ -136,20 +260,66 @@ void AssemblyWidget::setupLexer(QsciScintilla* editor, QsciLexerCPP* lexer) {
 void AssemblyWidget::setCompilerId(const QString& id) {
     m_compilerId = id;
     if (m_runner) m_runner->setCompilerId(id);
+    scheduleLiveRun();
 }
 
 void AssemblyWidget::setStandard(const QString& standard) {
     m_standard = standard;
+    scheduleLiveRun();
 }
 
 void AssemblyWidget::setSourceCode(const QString& code, const QString& filePath) {
+    const bool sameFile = (filePath == m_currentFilePath);
+    if (sameFile && code == m_currentSourceCode) return;
+
     m_currentSourceCode = code;
     m_currentFilePath   = filePath;
-    m_sourceEditor->setText(code);
+    replaceChangedLines(m_sourceEditor, code);
+
+    // Live mode keeps the last good listing of the same file until the next
+    // one lands; anything else would show assembly for a different buffer.
+    if (isLiveMode() && sameFile && !code.isEmpty()) {
+        scheduleLiveRun();
+        return;
+    }
+
+    m_runner->cancel();
+    clearMcaOverlay();
     m_asmEditor->clear();
-    m_asmLineToSrcLine.clear();
-    m_srcLineToFirstAsm.clear();
-    m_statusLabel->setText(QStringLiteral("Ready — press Generate Assembly"));
+    m_rawAsm.clear();
+    m_document = AsmDocument();
+    m_heat = SourceHeat();
+    updateHeat();
+    if (isLiveMode() && !code.isEmpty()) {
+        scheduleLiveRun();
+    } else {
+        m_runButton->setEnabled(true);
+        m_stopButton->setEnabled(false);
+        m_statusLabel->setText(QStringLiteral("Ready — press Generate Assembly"));
+    }
+}
+
+void AssemblyWidget::setLiveMode(bool live) {
+    if (m_liveCheck->isChecked() != live) {
+        m_liveCheck->setChecked(live);   // Re-enters via toggled()
+        return;
+    }
+    if (live) {
+        scheduleLiveRun();
+    } else {
+        m_liveTimer->stop();
+    }
+}
+
+bool AssemblyWidget::isLiveMode() const {
+    return m_liveCheck && m_liveCheck->isChecked();
+}
+
+void AssemblyWidget::scheduleLiveRun() {
+    if (!isLiveMode() || m_currentSourceCode.isEmpty()) return;
+    // The running compile is for older input; its result would be stale
+    if (m_runner->isRunning()) m_runner->cancel();
+    m_liveTimer->start();   // Restarts the debounce on every change
 }
 
 void AssemblyWidget::highlightSourceLine(int sourceLine) {
@@ -160,10 +330,14 @@ void AssemblyWidget::highlightSourceLine(int sourceLine) {
         m_sourceEditor->ensureLineVisible(sourceLine - 1);
     }
 
-    // Scroll asm pane to first asm line for this source line
-    if (m_srcLineToFirstAsm.contains(sourceLine)) {
-        int asmLine = m_srcLineToFirstAsm.value(sourceLine);
-        m_asmEditor->ensureLineVisible(asmLine - 1);
+    // Mark every asm line generated from it and scroll to the first
+    m_asmEditor->markerDeleteAll(m_asmHighlightMarker);
+    const int count = m_document.asmCount(sourceLine);
+    for (int i = 0; i < count; ++i) {
+        m_asmEditor->markerAdd(m_document.asmLineAt(sourceLine, i), m_asmHighlightMarker);
+    }
+    if (count > 0) {
+        m_asmEditor->ensureLineVisible(m_document.firstAsmLine(sourceLine));
     }
 }
 
@@ -180,24 +354,7 @@ void AssemblyWidget::runAssembly() {
         return;
     }
 
-    // Write current source to a temp file
-    QString uuid = QUuid::createUuid().toString().remove('{').remove('}').remove('-');
-    QString tmpPath = QDir::tempPath()
-                      + QStringLiteral("/cppatlas_asmrun_")
-                      + uuid
-                      + QStringLiteral(".cpp");
-
-    QFile tmpFile(tmpPath);
-    if (!tmpFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        m_statusLabel->setText(QStringLiteral("Failed to create temp file."));
-        return;
-    }
-    {
-        QTextStream out(&tmpFile);
-        out << m_currentSourceCode;
-    }
-    tmpFile.close();
-    m_tempAsmSourceFile = tmpPath;
+    m_liveTimer->stop();
 
     // Build flags
     QStringList flags;
@@ -208,12 +365,13 @@ void AssemblyWidget::runAssembly() {
     m_runner->setIntelSyntax(m_syntaxCombo->currentText() == QStringLiteral("Intel"));
     m_runner->setCompilerId(m_compilerId);
 
+    // The previous listing stays visible until this run replaces it
     m_runButton->setEnabled(false);
-    m_asmEditor->clear();
-    m_asmLineToSrcLine.clear();
-    m_srcLineToFirstAsm.clear();
+    m_runTimer.start();
 
-    m_runner->run(tmpPath, flags);
+    const QString sourceDir = m_currentFilePath.isEmpty()
+        ? QString() : QFileInfo(m_currentFilePath).absolutePath();
+    m_runner->runSource(m_currentSourceCode, flags, sourceDir);
 }
 
 // ── Slots — runner ────────────────────────────────────────────────────────────
@@ -230,17 +388,22 @@ void AssemblyWidget::onProgressMessage(const QString& msg) {
 
 void AssemblyWidget::onRunnerFinished(bool success, const QString& output,
                                       const QString& error) {
-    if (!m_tempAsmSourceFile.isEmpty()) {
-        QFile::remove(m_tempAsmSourceFile);
-        m_tempAsmSourceFile.clear();
-    }
     m_runButton->setEnabled(true);
     m_stopButton->setEnabled(false);
 
     if (success) {
-        m_asmEditor->setText(output);
-        m_statusLabel->setText(QStringLiteral("Done."));
+        m_rawAsm = output.toUtf8();
+        applyFilters();
+    } else if (isLiveMode() && !m_rawAsm.isEmpty()) {
+        // Half-typed code fails all the time; keep the last good listing
+        m_statusLabel->setText(QStringLiteral("Error (showing last good output): ")
+                               + error.section('\n', 0, 0));
     } else {
+        m_rawAsm.clear();
+        m_document = AsmDocument();
+        m_heat = SourceHeat();
+        updateHeat();
+        clearMcaOverlay();
         m_asmEditor->setText(
             QStringLiteral("; Assembly error:\n;\n")
             + error.split('\n').join(QStringLiteral("\n; ")));
@@ -248,27 +411,95 @@ void AssemblyWidget::onRunnerFinished(bool success, const QString& output,
     }
 }
 
-void AssemblyWidget::onLineMapReady(const QMap<int, int>& asmLineToSrcLine) {
-    m_asmLineToSrcLine = asmLineToSrcLine;
+AsmFilterOptions AssemblyWidget::filterOptions() const {
+    AsmFilterOptions options;
+    for (const QAction* action : m_filterMenu->actions()) {
+        const QString key = action->data().toString();
+        const bool on = action->isChecked();
+        if (key == QLatin1String("directives"))    options.directives       = on;
+        else if (key == QLatin1String("comments")) options.comments         = on;
+        else if (key == QLatin1String("labels"))   options.unusedLabels     = on;
+        else if (key == QLatin1String("library"))  options.libraryFunctions = on;
+        else if (key == QLatin1String("demangle")) options.demangle         = on;
+    }
+    return options;
+}
+
+AsmDocument AssemblyWidget::assemblableDocument() const {
+    // Assemblers need the mangled names; demangling only rewrites text, the
+    // line indices are the same.
+    const AsmFilterOptions options = filterOptions();
+    if (!options.demangle) return m_document;
+    AsmFilterOptions mangled = options;
+    mangled.demangle = false;
+    return AsmParser::parse(m_rawAsm, mangled);
+}
 
-    // Build reverse map: source line → first asm line
-    m_srcLineToFirstAsm.clear();
-    for (auto it = asmLineToSrcLine.cbegin(); it != asmLineToSrcLine.cend(); ++it) {
-        int asmLine = it.key();
-        int srcLine = it.value();
-        if (!m_srcLineToFirstAsm.contains(srcLine)) {
-            m_srcLineToFirstAsm.insert(srcLine, asmLine);
-        }
+void AssemblyWidget::applyFilters() {
+    if (m_rawAsm.isEmpty()) return;
+
+    m_document = AsmParser::parse(m_rawAsm, filterOptions());
+    clearHighlights();
+    clearMcaOverlay();
+    replaceChangedLines(m_asmEditor, m_document.text());
+
+    // Instruction counts come straight from the index; bytes follow
+    m_heat = SourceHeat::fromDocument(m_document);
+    updateHeat();
+    measureHeatBytes();
+    QString status = QStringLiteral("Done — %1 of %2 lines, %3 functions")
+                         .arg(m_document.lines.size())
+                         .arg(m_document.rawLineCount)
+                         .arg(m_document.functions.size());
+    if (m_runTimer.isValid()) {
+        // Only right after a run; re-filtering is not a new compile
+        status += QStringLiteral(" in %1 ms").arg(m_runTimer.elapsed());
+        m_runTimer.invalidate();
     }
+    m_statusLabel->setText(status + QLatin1Char('.'));
 }
 
-void AssemblyWidget::onAsmCursorPositionChanged(int line, int col) {
-    Q_UNUSED(col);
-    int asmLine = line + 1; // QsciScintilla lines are 0-based
+void AssemblyWidget::replaceChangedLines(QsciScintilla* editor, const QString& text) {
+    const QByteArray oldText = editor->text().toUtf8();
+    const QByteArray newText = text.toUtf8();
+    if (oldText == newText) return;
+
+    // Common prefix, backed up to a line start, and common suffix starting at
+    // a line start; only the lines in between are replaced.
+    const int maxCommon = int(qMin(oldText.size(), newText.size()));
+    int prefix = 0;
+    while (prefix < maxCommon && oldText[prefix] == newText[prefix]) ++prefix;
+    while (prefix > 0 && oldText[prefix - 1] != '\n') --prefix;
+
+    int suffix = 0;
+    while (suffix < maxCommon - prefix
+           && oldText[oldText.size() - 1 - suffix] == newText[newText.size() - 1 - suffix]) {
+        ++suffix;
+    }
+    while (suffix > 0 && oldText.size() - suffix > prefix
+           && oldText[oldText.size() - suffix - 1] != '\n') {
+        --suffix;
+    }
 
-    if (m_asmLineToSrcLine.contains(asmLine)) {
-        int srcLine = m_asmLineToSrcLine.value(asmLine);
+    const QByteArray middle = newText.mid(prefix, newText.size() - prefix - suffix);
+
+    // Edits move the caret; nobody should react to that as a user click
+    const QSignalBlocker blocker(editor);
+    const bool readOnly = editor->isReadOnly();
+    editor->setReadOnly(false);
+    editor->SendScintilla(QsciScintilla::SCI_SETTARGETSTART, static_cast<unsigned long>(prefix));
+    editor->SendScintilla(QsciScintilla::SCI_SETTARGETEND,
+                          static_cast<unsigned long>(oldText.size() - suffix));
+    editor->SendScintilla(QsciScintilla::SCI_REPLACETARGET,
+                          static_cast<unsigned long>(middle.size()), middle.constData());
+    editor->setReadOnly(readOnly);
+}
 
+void AssemblyWidget::onAsmCursorPositionChanged(int line, int col) {
+    Q_UNUSED(col);
+    // QsciScintilla lines and AsmDocument lines are both 0-based
+    const int srcLine = m_document.mainSourceLine(line);
+    if (srcLine > 0) {
         // Highlight in source mirror
         m_sourceEditor->markerDeleteAll(m_srcHighlightMarker);
         m_sourceEditor->markerAdd(srcLine - 1, m_srcHighlightMarker);
@@ -334,6 +565,7 @@ void AssemblyWidget::applyThemeToEditor(QsciScintilla* editor, const QString& th
 void AssemblyWidget::onThemeChanged(const QString& themeName) {
     applyThemeToEditor(m_sourceEditor, themeName);
     applyThemeToEditor(m_asmEditor,    themeName);
+    m_sourceHeat->applyTheme();
 }
 
 void AssemblyWidget::applyEditorSettings(const QFont& font, bool showLineNumbers, bool wordWrap)
@@ -363,8 +595,171 @@ void AssemblyWidget::clearHighlights() {
 }
 
 void AssemblyWidget::stopProcess() {
+    m_liveTimer->stop();
     m_runner->cancel();
     m_runButton->setEnabled(true);
     m_stopButton->setEnabled(false);
     m_statusLabel->setText(QStringLiteral("Stopped."));
 }
+
+// ── Heat ──────────────────────────────────────────────────────────────────────
+
+void AssemblyWidget::updateHeat() {
+    const int selected = m_heatCombo->currentData().toInt();
+    if (selected == HEAT_OFF || m_heat.isEmpty()) {
+        m_sourceHeat->clear();
+        emit sourceHeatChanged(SourceHeat(), SourceHeat::Metric::Instructions);
+        return;
+    }
+
+    // Bytes arrive after the listing; shade by instructions until then
+    SourceHeat::Metric metric = SourceHeat::Metric(selected);
+    if (!m_heat.has(metric)) metric = SourceHeat::Metric::Instructions;
+    m_sourceHeat->show(m_heat, metric);
+    emit sourceHeatChanged(m_heat, metric);
+}
+
+void AssemblyWidget::measureHeatBytes() {
+    const quint64 serial = ++m_heatSerial;
+    if (m_document.lines.isEmpty()) return;
+
+    // The worker gets its own copies (implicitly shared, so cheap)
+    const QByteArray rawAsm = m_rawAsm;
+    AsmFilterOptions options = filterOptions();
+    options.demangle = false;
+    const bool intel = m_syntaxCombo->currentText() == QStringLiteral("Intel");
+
+    m_heatPool.clear();   // Queued measurements are already stale
+    ThreadPoolTask::start(&m_heatPool, [=]() {
+        const AsmDocument document = AsmParser::parse(rawAsm, options);
+        const QVector<int> lineBytes = SourceHeat::measureLineBytes(document.text(), intel);
+        QMetaObject::invokeMethod(this, [=]() {
+            if (serial != m_heatSerial || lineBytes.isEmpty()) return;
+            m_heat.applyLineBytes(document, lineBytes);
+            updateHeat();
+        }, Qt::QueuedConnection);
+    });
+}
+
+// ── llvm-mca ──────────────────────────────────────────────────────────────────
+
+void AssemblyWidget::analyzeSelection() {
+    if (m_document.lines.isEmpty()) {
+        m_statusLabel->setText(QStringLiteral("Generate assembly first."));
+        return;
+    }
+
+    // The selected lines, else the function under the cursor
+    int first = -1, last = -1;
+    int lineFrom, indexFrom, lineTo, indexTo;
+    m_asmEditor->getSelection(&lineFrom, &indexFrom, &lineTo, &indexTo);
+    if (lineFrom >= 0 && (lineFrom != lineTo || indexFrom != indexTo)) {
+        first = lineFrom;
+        last  = (indexTo == 0 && lineTo > lineFrom) ? lineTo - 1 : lineTo;
+    } else {
+        int line, index;
+        m_asmEditor->getCursorPosition(&line, &index);
+        const int function = (line >= 0 && line < m_document.lines.size())
+            ? m_document.lines[line].function : -1;
+        if (function < 0) {
+            m_statusLabel->setText(QStringLiteral("Select instructions or place the cursor in a function."));
+            return;
+        }
+        first = m_document.functions[function].firstLine;
+        last  = m_document.functions[function].lastLine;
+    }
+    last = qMin(last, m_document.lines.size() - 1);
+
+    const AsmDocument source = assemblableDocument();
+
+    clearMcaOverlay();
+    QStringList block;
+    for (int i = first; i <= last && i < source.lines.size(); ++i) {
+        if (source.lines[i].kind != AsmLine::Kind::Instruction) continue;
+        block << source.lines[i].text.trimmed();
+        m_mcaLines.append(i);
+    }
+    if (block.isEmpty()) {
+        m_statusLabel->setText(QStringLiteral("No instructions in the selection."));
+        return;
+    }
+
+    m_mcaCpu = m_cpuCombo->currentText().trimmed();
+    m_analyzeButton->setEnabled(false);
+    m_statusLabel->setText(QStringLiteral("Analyzing %1 instructions for %2…")
+                               .arg(block.size())
+                               .arg(m_mcaCpu.isEmpty() ? QStringLiteral("host") : m_mcaCpu));
+    m_mcaRunner->analyze(block.join(QLatin1Char('\n')) + QLatin1Char('\n'), m_mcaCpu,
+                         m_syntaxCombo->currentText() == QStringLiteral("Intel"));
+}
+
+void AssemblyWidget::onMcaFinished(bool success, const QString& output, const QString& error) {
+    m_analyzeButton->setEnabled(true);
+
+    const McaReport report = success ? McaRunner::parseReport(output) : McaReport();
+    if (!report.valid) {
+        m_mcaLines.clear();
+        const QString reason = error.trimmed().isEmpty()
+            ? QStringLiteral("no report produced") : error.trimmed().section('\n', 0, 0);
+        m_statusLabel->setText(QStringLiteral("llvm-mca failed: ") + reason);
+        return;
+    }
+    showMcaReport(report);
+}
+
+void AssemblyWidget::showMcaReport(const McaReport& report) {
+    // One report row per instruction sent, in the same order
+    const int rows = qMin(report.instructions.size(), m_mcaLines.size());
+    for (int i = 0; i < rows; ++i) {
+        const McaInstruction& instruction = report.instructions[i];
+        m_asmEditor->setMarginText(m_mcaLines[i],
+                                   QStringLiteral("lat %1  rt %2")
+                                       .arg(instruction.latency, 2)
+                                       .arg(instruction.rthroughput, 0, 'f', 2),
+                                   QsciScintilla::STYLE_LINENUMBER);
+    }
+    m_asmEditor->setMarginWidth(MCA_MARGIN, QStringLiteral("lat 00  rt 0.00 "));
+
+    // Busiest resources first
+    QVector<int> order;
+    for (int r = 0; r < report.resourcePressure.size() && r < report.resources.size(); ++r) {
+        if (report.resourcePressure[r] > 0.0) order.append(r);
+    }
+    std::stable_sort(order.begin(), order.end(), [&report](int a, int b) {
+        return report.resourcePressure[a] > report.resourcePressure[b];
+    });
+    QStringList pressure;
+    for (int i = 0; i < order.size() && i < 4; ++i) {
+        pressure << QStringLiteral("%1 %2").arg(report.resources[order[i]])
+                                           .arg(report.resourcePressure[order[i]], 0, 'f', 2);
+    }
+
+    const QString cpu = m_mcaCpu.isEmpty() ? QStringLiteral("host") : m_mcaCpu;
+    QString summary = QStringLiteral("llvm-mca (%1): IPC %2 · %3 cycles/iteration (block RThroughput)"
+                                     " · %4 µops/cycle")
+                          .arg(cpu)
+                          .arg(report.ipc, 0, 'f', 2)
+                          .arg(report.blockRThroughput, 0, 'f', 2)
+                          .arg(report.uopsPerCycle, 0, 'f', 2);
+    if (!pressure.isEmpty()) {
+        summary += QStringLiteral("\nBusiest resources per iteration: ") + pressure.join(QStringLiteral(", "));
+    }
+    m_asmEditor->annotate(m_mcaLines.last(), summary, QsciScintilla::STYLE_LINENUMBER);
+
+    m_statusLabel->setText(QStringLiteral("Analyzed %1 instructions — IPC %2, %3 cycles/iteration.")
+                               .arg(rows)
+                               .arg(report.ipc, 0, 'f', 2)
+                               .arg(report.blockRThroughput, 0, 'f', 2));
+}
+
+void AssemblyWidget::clearMcaOverlay() {
+    if (m_mcaRunner->isRunning()) {
+        m_mcaRunner->cancel();
+        m_analyzeButton->setEnabled(true);
+    }
+    if (m_mcaLines.isEmpty()) return;
+    m_mcaLines.clear();
+    m_asmEditor->clearMarginText();
+    m_asmEditor->clearAnnotations();
+    m_asmEditor->setMarginWidth(MCA_MARGIN, 0);
+}
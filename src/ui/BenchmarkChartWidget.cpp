@@ -1,10 +1,14 @@
 #include "ui/BenchmarkChartWidget.h"
 #include "ui/ThemeManager.h"
+#include "tools/BenchmarkStats.h"
 
+#include <QHash>
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QPainter>
 
+#include <cmath>
+
 #ifdef CPPATLAS_CHARTS_AVAILABLE
 #include <QtCharts/QBarSeries>
 #include <QtCharts/QBarSet>
@@ -12,6 +16,7 @@
 #include <QtCharts/QChart>
 #include <QtCharts/QChartView>
 #include <QtCharts/QLineSeries>
+#include <QtCharts/QLogValueAxis>
 #include <QtCharts/QValueAxis>
 
 #if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
@@ -64,6 +69,9 @@ void BenchmarkChartWidget::setResult(const BenchmarkResult& result) {
     case ChartType::Line:
         buildLineChart(result);
         break;
+    case ChartType::Scaling:
+        buildScalingChart(result);
+        break;
     }
 #else
     Q_UNUSED(result);
@@ -78,6 +86,54 @@ void BenchmarkChartWidget::compareResults(const QList<BenchmarkResult>& results)
 #endif
 }
 
+void BenchmarkChartWidget::showGroupedBars(const QStringList& categories,
+                                           const QList<BarGroup>& groups,
+                                           const QString& title,
+                                           const QString& axisTitle) {
+#ifdef CPPATLAS_CHARTS_AVAILABLE
+    auto* series = new QBarSeries();
+    for (const BarGroup& group : groups) {
+        auto* barSet = new QBarSet(group.label);
+        if (group.color.isValid())
+            barSet->setColor(group.color);
+        for (double value : group.values)
+            *barSet << value;
+        series->append(barSet);
+    }
+
+    auto* chart = new QChart();
+    chart->setTitle(title);
+    chart->setAnimationOptions(QChart::SeriesAnimations);
+    chart->addSeries(series);
+
+    auto* axisX = new QBarCategoryAxis();
+    axisX->append(categories);
+    chart->addAxis(axisX, Qt::AlignBottom);
+    series->attachAxis(axisX);
+
+    auto* axisY = new QValueAxis();
+    axisY->setTitleText(axisTitle);
+    chart->addAxis(axisY, Qt::AlignLeft);
+    series->attachAxis(axisY);
+
+    installChart(chart);
+#else
+    Q_UNUSED(categories);
+    Q_UNUSED(groups);
+    Q_UNUSED(title);
+    Q_UNUSED(axisTitle);
+#endif
+}
+
+void BenchmarkChartWidget::showTrend(const QList<BenchmarkResult>& runs, int baselineIndex) {
+#ifdef CPPATLAS_CHARTS_AVAILABLE
+    buildTrendChart(runs, baselineIndex);
+#else
+    Q_UNUSED(runs);
+    Q_UNUSED(baselineIndex);
+#endif
+}
+
 void BenchmarkChartWidget::setChartType(ChartType type) {
     m_chartType = type;
 }
@@ -85,12 +141,32 @@ void BenchmarkChartWidget::setChartType(ChartType type) {
 #ifdef CPPATLAS_CHARTS_AVAILABLE
 
 namespace {
+// Past these, lines are downsampled and drawn without animation
+constexpr int MAX_LINE_POINTS      = 400;
+constexpr int MAX_ANIMATED_POINTS  = 200;
+constexpr int COMPLEXITY_FIT_STEPS = 64;
+// Beyond this the legend swamps the trend chart
+constexpr int MAX_TREND_SERIES     = 12;
+
 QString shortName(const QString& name, int maxLen = 30) {
     return name.length() > maxLen
                ? name.left(maxLen - 3) + QStringLiteral("...")
                : name;
 }
 
+// Missing counters plot as nothing rather than as a negative bar
+double plotValue(const BenchmarkSummary& s, BenchmarkMetric metric) {
+    return qMax(0.0, BenchmarkStats::metricValue(s, metric));
+}
+
+// "NlgN" -> "O(N log N)"
+QString bigOText(const QString& bigO) {
+    if (bigO == QLatin1String("(1)")) return QStringLiteral("O(1)");
+    QString f = bigO;
+    f.replace(QLatin1String("lgN"), QLatin1String(" log N"));
+    return QStringLiteral("O(%1)").arg(f.trimmed());
+}
+
 void styleAxis(QAbstractAxis* axis, const Theme& theme) {
     axis->setLabelsBrush(QBrush(theme.textPrimary));
     axis->setTitleBrush(QBrush(theme.textPrimary));
@@ -100,25 +176,27 @@ void styleAxis(QAbstractAxis* axis, const Theme& theme) {
 } // namespace
 
 void BenchmarkChartWidget::buildBarChart(const BenchmarkResult& result) {
-    auto* barSet = new QBarSet(QStringLiteral("Real Time"));
+    const QString unit = result.benchmarks.isEmpty() ? QStringLiteral("ns")
+                                                     : result.benchmarks.first().timeUnit;
+    const QString title = BenchmarkStats::metricTitle(m_metric, unit);
+    auto* barSet = new QBarSet(title);
     // Apply displayColor if set
     if (result.displayColor.isValid())
         barSet->setColor(result.displayColor);
 
+    // Repetitions collapse to their median; aggregate rows are not bars
+    const QList<BenchmarkSummary> summaries = BenchmarkStats::summarize(result.benchmarks);
     QStringList categories;
-    for (const BenchmarkEntry& e : result.benchmarks) {
-        *barSet << e.realTimeNs;
-        categories << shortName(e.name);
+    for (const BenchmarkSummary& s : summaries) {
+        *barSet << plotValue(s, m_metric);
+        categories << shortName(s.runName);
     }
 
     auto* series = new QBarSeries();
     series->append(barSet);
 
     auto* chart = new QChart();
-    chart->setTitle(QStringLiteral("Benchmark Results — Real Time (%1)")
-                        .arg(result.benchmarks.isEmpty()
-                                 ? QStringLiteral("ns")
-                                 : result.benchmarks.first().timeUnit));
+    chart->setTitle(QStringLiteral("Benchmark Results — %1").arg(title));
     chart->setAnimationOptions(QChart::SeriesAnimations);
     chart->addSeries(series);
 
@@ -128,43 +206,190 @@ void BenchmarkChartWidget::buildBarChart(const BenchmarkResult& result) {
     series->attachAxis(axisX);
 
     auto* axisY = new QValueAxis();
-    axisY->setTitleText(
-        result.benchmarks.isEmpty()
-            ? QStringLiteral("Time (ns)")
-            : QStringLiteral("Time (%1)").arg(result.benchmarks.first().timeUnit));
+    axisY->setTitleText(m_metric == BenchmarkMetric::RealTime
+                            ? QStringLiteral("Time (%1)").arg(unit)
+                            : title);
     chart->addAxis(axisY, Qt::AlignLeft);
     series->attachAxis(axisY);
 
     chart->legend()->setVisible(false);
-    m_chartView->setChart(chart);
-    applyChartTheme(ThemeManager::instance()->currentThemeName());
+    installChart(chart);
 }
 
 void BenchmarkChartWidget::buildLineChart(const BenchmarkResult& result) {
-    QMap<QString, QLineSeries*> seriesMap;
-
-    for (const BenchmarkEntry& e : result.benchmarks) {
-        const int slashIdx = e.name.lastIndexOf(QLatin1Char('/'));
-        const QString baseName = (slashIdx > 0) ? e.name.left(slashIdx) : e.name;
-        bool ok = false;
-        const double xVal = (slashIdx > 0) ? e.name.mid(slashIdx + 1).toDouble(&ok) : 0.0;
-
-        if (!seriesMap.contains(baseName)) {
-            auto* s = new QLineSeries();
-            s->setName(baseName);
-            seriesMap[baseName] = s;
+    const QList<ParameterSweep> sweeps = BenchmarkStats::sweeps(result.benchmarks);
+    // Real time in ns so families with different time units share the axis
+    const bool    time  = m_metric == BenchmarkMetric::RealTime;
+    const QString title = BenchmarkStats::metricTitle(m_metric);
+
+    auto* chart = new QChart();
+    if (sweeps.isEmpty()) {
+        chart->setTitle(QStringLiteral("Parameter Sweep — no benchmark ran at several argument "
+                                       "values (->Range, ->Args, ->ArgsProduct)"));
+        installChart(chart);
+        return;
+    }
+    chart->setTitle(QStringLiteral("Parameter Sweep — %1, log-log").arg(title));
+
+    auto* axisX = new QLogValueAxis();
+    axisX->setBase(2);
+    axisX->setLabelFormat(QStringLiteral("%g"));
+    auto* axisY = new QLogValueAxis();
+    axisY->setBase(10);
+    axisY->setLabelFormat(QStringLiteral("%g"));
+    axisY->setTitleText(title);
+    chart->addAxis(axisX, Qt::AlignBottom);
+    chart->addAxis(axisY, Qt::AlignLeft);
+
+    auto attach = [&](QLineSeries* series) {
+        chart->addSeries(series);
+        series->attachAxis(axisX);
+        series->attachAxis(axisY);
+    };
+
+    QStringList xTitles;
+    int plotted = 0;
+    for (const ParameterSweep& sweep : sweeps) {
+        if (!xTitles.contains(sweep.dimensions.first())) xTitles << sweep.dimensions.first();
+
+        // Along the first varying argument; one line per value of the others
+        QStringList                    order;
+        QHash<QString, QList<QPointF>> lines;
+        for (const SweepPoint& p : sweep.points) {
+            const double y = time ? BenchmarkStats::toNanoseconds(p.summary.median, p.summary.timeUnit)
+                                  : BenchmarkStats::metricValue(p.summary, m_metric);
+            if (p.coords.first() <= 0 || y <= 0.0) continue;   // No place on a log axis
+            QStringList rest;
+            for (int d = 1; d < p.coords.size(); ++d)
+                rest << QStringLiteral("%1=%2").arg(sweep.dimensions[d]).arg(p.coords[d]);
+            const QString label = rest.isEmpty() ? sweep.name
+                                                 : sweep.name + QLatin1Char(' ') + rest.join(QStringLiteral(", "));
+            if (!lines.contains(label)) order << label;
+            lines[label] << QPointF(double(p.coords.first()), y);
+        }
+
+        for (const QString& label : order) {
+            const QList<QPointF>& line = lines.value(label);
+            QList<QPointF> logLine;
+            for (const QPointF& p : line) logLine << QPointF(std::log(p.x()), std::log(p.y()));
+
+            auto* measured = new QLineSeries();
+            measured->setName(shortName(label, 40));
+            for (int i : BenchmarkStats::downsample(logLine, MAX_LINE_POINTS))
+                measured->append(line[i]);
+            measured->setPointsVisible(measured->count() <= 32);
+            plotted += measured->count();
+            attach(measured);
+
+            if (!time || !sweep.hasFit() || !sweep.fit.canEvaluate()) continue;
+            // Log-spaced over the measured range; lgN is 0 at N = 1
+            auto* fit = new QLineSeries();
+            QString name = QStringLiteral("%1 fit %2")
+                               .arg(shortName(sweep.name, 30), bigOText(sweep.fit.bigO));
+            if (sweep.fit.rms >= 0.0)
+                name += QStringLiteral(", RMS %1%").arg(sweep.fit.rms * 100.0, 0, 'f', 1);
+            fit->setName(name);
+            const double first = line.first().x();
+            const double last  = line.last().x();
+            for (int step = 0; step <= COMPLEXITY_FIT_STEPS; ++step) {
+                const double n = first * std::pow(last / first, double(step) / COMPLEXITY_FIT_STEPS);
+                const double predicted = sweep.fit.predictNs(n);
+                if (predicted > 0.0) fit->append(n, predicted);
+            }
+            QPen dashed = measured->pen();
+            dashed.setStyle(Qt::DashLine);
+            fit->setPen(dashed);
+            attach(fit);
         }
-        seriesMap[baseName]->append(ok ? xVal : 0.0, e.realTimeNs);
     }
+    axisX->setTitleText(xTitles.join(QStringLiteral(" / ")));
+    chart->setAnimationOptions(plotted > MAX_ANIMATED_POINTS ? QChart::NoAnimation
+                                                             : QChart::SeriesAnimations);
+
+    installChart(chart);
+}
+
+void BenchmarkChartWidget::buildScalingChart(const BenchmarkResult& result) {
+    const QList<ScalingSeries> scaling = BenchmarkStats::scaling(result.benchmarks);
 
     auto* chart = new QChart();
-    chart->setTitle(QStringLiteral("Parametric Benchmark — Real Time (ns)"));
     chart->setAnimationOptions(QChart::SeriesAnimations);
-    for (auto* s : seriesMap.values()) chart->addSeries(s);
-    chart->createDefaultAxes();
+    if (scaling.isEmpty()) {
+        chart->setTitle(QStringLiteral("Thread Scaling — no benchmark ran at more than one "
+                                       "thread count (->ThreadRange, or Threads in the toolbar)"));
+        installChart(chart);
+        return;
+    }
+    chart->setTitle(QStringLiteral("Thread Scaling — speedup and parallel efficiency"));
+
+    auto* axisX = new QValueAxis();
+    axisX->setTitleText(QStringLiteral("Threads"));
+    axisX->setLabelFormat(QStringLiteral("%d"));
+    auto* axisSpeedup = new QValueAxis();
+    axisSpeedup->setTitleText(QStringLiteral("Speedup (×)"));
+    auto* axisEfficiency = new QValueAxis();
+    axisEfficiency->setTitleText(QStringLiteral("Efficiency (%)"));
+    axisEfficiency->setRange(0, 110);
+    chart->addAxis(axisX, Qt::AlignBottom);
+    chart->addAxis(axisSpeedup, Qt::AlignLeft);
+    chart->addAxis(axisEfficiency, Qt::AlignRight);
+
+    auto attach = [&](QLineSeries* series, QValueAxis* axisY) {
+        chart->addSeries(series);
+        series->attachAxis(axisX);
+        series->attachAxis(axisY);
+    };
+
+    int    maxThreads = 1;
+    double maxSpeedup = 1.0;
+    for (const ScalingSeries& s : scaling) {
+        auto* measured = new QLineSeries();
+        measured->setName(shortName(s.name));
+        measured->setPointsVisible(true);
+        auto* efficiency = new QLineSeries();
+        efficiency->setName(QStringLiteral("%1 efficiency").arg(shortName(s.name, 20)));
+        for (const ScalingPoint& p : s.points) {
+            measured->append(p.threads, p.speedup);
+            efficiency->append(p.threads, p.efficiency * 100.0);
+            maxSpeedup = qMax(maxSpeedup, p.speedup);
+        }
+        const int first = s.points.first().threads;
+        const int last  = s.points.last().threads;
+        maxThreads = qMax(maxThreads, last);
+        attach(measured, axisSpeedup);
+
+        QPen dotted = efficiency->pen();
+        dotted.setStyle(Qt::DotLine);
+        efficiency->setPen(dotted);
+        attach(efficiency, axisEfficiency);
+
+        if (s.hasFit()) {
+            auto* amdahl = new QLineSeries();
+            amdahl->setName(QStringLiteral("%1 Amdahl (serial %2%)")
+                                .arg(shortName(s.name, 20))
+                                .arg(s.serialFraction * 100.0, 0, 'f', 1));
+            for (int n = first; n <= last; ++n) amdahl->append(n, s.amdahlSpeedup(n));
+            QPen dashed = measured->pen();
+            dashed.setStyle(Qt::DashLine);
+            amdahl->setPen(dashed);
+            attach(amdahl, axisSpeedup);
+        }
+    }
 
-    m_chartView->setChart(chart);
-    applyChartTheme(ThemeManager::instance()->currentThemeName());
+    // Ideal: speedup equal to the thread count
+    auto* ideal = new QLineSeries();
+    ideal->setName(QStringLiteral("Ideal"));
+    ideal->append(1, 1);
+    ideal->append(maxThreads, maxThreads);
+    QPen idealPen(ThemeManager::instance()->currentTheme().textSecondary);
+    idealPen.setStyle(Qt::DashDotLine);
+    ideal->setPen(idealPen);
+    attach(ideal, axisSpeedup);
+
+    axisX->setRange(1, maxThreads);
+    axisSpeedup->setRange(0, qMax(double(maxThreads), maxSpeedup) * 1.05);
+
+    installChart(chart);
 }
 
 void BenchmarkChartWidget::buildComparisonChart(const QList<BenchmarkResult>& results)
@@ -173,51 +398,124 @@ void BenchmarkChartWidget::buildComparisonChart(const QList<BenchmarkResult>& re
 
     // Build union of benchmark names (categories) across all results
     // to handle results that have different benchmark sets.
+    // Each run's repetitions collapse to their median.
+    QList<QList<BenchmarkSummary>> summaries;
     QStringList categories;
     for (const BenchmarkResult& r : results) {
-        for (const BenchmarkEntry& e : r.benchmarks) {
-            const QString cat = shortName(e.name, 20);
+        summaries << BenchmarkStats::summarize(r.benchmarks);
+        for (const BenchmarkSummary& s : summaries.last()) {
+            const QString cat = shortName(s.runName, 20);
             if (!categories.contains(cat))
                 categories << cat;
         }
     }
 
-    auto* series = new QBarSeries();
-    for (const BenchmarkResult& r : results) {
-        const QString lbl = r.label.isEmpty() ? r.optimizationLevel : r.label;
-        auto* barSet = new QBarSet(lbl);
-
-        // Apply user-chosen color if set
-        if (r.displayColor.isValid())
-            barSet->setColor(r.displayColor);
+    QList<BarGroup> groups;
+    for (int i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        BarGroup group;
+        group.label = r.label.isEmpty() ? r.optimizationLevel : r.label;
+        group.color = r.displayColor;   // User-chosen color, if set
 
         // Fill values in category order — 0 if this result has no entry for that category
         for (const QString& cat : categories) {
             double val = 0.0;
-            for (const BenchmarkEntry& e : r.benchmarks) {
-                if (shortName(e.name, 20) == cat) { val = e.realTimeNs; break; }
+            for (const BenchmarkSummary& s : summaries[i]) {
+                if (shortName(s.runName, 20) == cat) {
+                    val = m_metric == BenchmarkMetric::RealTime
+                        ? BenchmarkStats::toNanoseconds(s.median, s.timeUnit)
+                        : plotValue(s, m_metric);
+                    break;
+                }
             }
-            *barSet << val;
+            group.values << val;
         }
-        series->append(barSet);
+        groups << group;
     }
 
+    const QString title = BenchmarkStats::metricTitle(m_metric);
+    showGroupedBars(categories, groups,
+                    QStringLiteral("Benchmark Comparison — %1").arg(
+                        m_metric == BenchmarkMetric::RealTime ? QStringLiteral("Median ") + title
+                                                              : title),
+                    m_metric == BenchmarkMetric::RealTime ? QStringLiteral("Time (ns)") : title);
+}
+
+void BenchmarkChartWidget::buildTrendChart(const QList<BenchmarkResult>& runs, int baselineIndex)
+{
     auto* chart = new QChart();
-    chart->setTitle(QStringLiteral("Benchmark Comparison — Real Time (ns)"));
+    if (runs.isEmpty()) {
+        chart->setTitle(QStringLiteral("History — no stored runs of this source yet"));
+        installChart(chart);
+        return;
+    }
+    const bool    time  = m_metric == BenchmarkMetric::RealTime;
+    const QString title = BenchmarkStats::metricTitle(m_metric);
+    chart->setTitle(QStringLiteral("History — %1 per run").arg(
+        time ? QStringLiteral("median ") + title : title));
     chart->setAnimationOptions(QChart::SeriesAnimations);
-    chart->addSeries(series);
-
-    auto* axisX = new QBarCategoryAxis();
-    axisX->append(categories);
-    chart->addAxis(axisX, Qt::AlignBottom);
-    series->attachAxis(axisX);
 
+    auto* axisX = new QValueAxis();
+    axisX->setTitleText(QStringLiteral("Run"));
+    axisX->setLabelFormat(QStringLiteral("%d"));
+    axisX->setRange(1, qMax(2, int(runs.size())));
+    axisX->setTickCount(qMin(int(runs.size()), 10) + 1);
     auto* axisY = new QValueAxis();
-    axisY->setTitleText(QStringLiteral("Time (ns)"));
+    axisY->setTitleText(time ? QStringLiteral("Time (ns)") : title);
+    chart->addAxis(axisX, Qt::AlignBottom);
     chart->addAxis(axisY, Qt::AlignLeft);
-    series->attachAxis(axisY);
 
+    // Benchmarks in order of first appearance; one that vanished leaves a gap
+    QStringList                 order;
+    QHash<QString, QLineSeries*> lines;
+    double maxY = 0.0;
+    for (int i = 0; i < runs.size(); ++i) {
+        for (const BenchmarkSummary& s : BenchmarkStats::summarize(runs[i].benchmarks)) {
+            const double y = time ? BenchmarkStats::toNanoseconds(s.median, s.timeUnit)
+                                  : BenchmarkStats::metricValue(s, m_metric);
+            if (y < 0.0) continue;
+            QLineSeries* series = lines.value(s.runName);
+            if (!series) {
+                if (order.size() >= MAX_TREND_SERIES) continue;
+                series = new QLineSeries();
+                series->setName(shortName(s.runName));
+                series->setPointsVisible(true);
+                order << s.runName;
+                lines.insert(s.runName, series);
+            }
+            series->append(i + 1, y);
+            maxY = qMax(maxY, y);
+        }
+    }
+    for (const QString& name : order) {
+        chart->addSeries(lines.value(name));
+        lines.value(name)->attachAxis(axisX);
+        lines.value(name)->attachAxis(axisY);
+    }
+    axisY->setRange(0, maxY > 0.0 ? maxY * 1.1 : 1.0);
+
+    if (baselineIndex >= 0 && baselineIndex < runs.size()) {
+        auto* baseline = new QLineSeries();
+        baseline->setName(QStringLiteral("Baseline"));
+        baseline->append(baselineIndex + 1, 0);
+        baseline->append(baselineIndex + 1, axisY->max());
+        QPen pen(ThemeManager::instance()->currentTheme().textSecondary);
+        pen.setStyle(Qt::DashDotLine);
+        baseline->setPen(pen);
+        chart->addSeries(baseline);
+        baseline->attachAxis(axisX);
+        baseline->attachAxis(axisY);
+    }
+
+    installChart(chart);
+}
+
+void BenchmarkChartWidget::installChart(QChart* chart) {
+    if (!m_animated) chart->setAnimationOptions(QChart::NoAnimation);
+    // setChart() hands the previous chart back instead of deleting it
+    QChart* old = m_chartView->chart();
     m_chartView->setChart(chart);
+    delete old;
     applyChartTheme(ThemeManager::instance()->currentThemeName());
 }
 
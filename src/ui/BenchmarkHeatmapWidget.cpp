@@ -0,0 +1,272 @@
+#include "ui/BenchmarkHeatmapWidget.h"
+#include "ui/ThemeManager.h"
+
+#include <QComboBox>
+#include <QLinearGradient>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+QColor blend(const QColor& a, const QColor& b, double t) {
+    return QColor::fromRgbF(a.redF()   + (b.redF()   - a.redF())   * t,
+                            a.greenF() + (b.greenF() - a.greenF()) * t,
+                            a.blueF()  + (b.blueF()  - a.blueF())  * t);
+}
+
+// 0 = lowest value (success), 1 = highest (error)
+QColor shade(const Theme& theme, double t) {
+    return t < 0.5 ? blend(theme.success, theme.warning, t * 2.0)
+                   : blend(theme.warning, theme.error, (t - 0.5) * 2.0);
+}
+
+} // namespace
+
+BenchmarkHeatmapWidget::BenchmarkHeatmapWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setMouseTracking(true);
+
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(4, 4, 4, 4);
+    m_sweepCombo = new QComboBox(this);
+    m_sweepCombo->setToolTip(QStringLiteral("Two-argument sweep to show"));
+    m_sweepCombo->hide();
+    layout->addWidget(m_sweepCombo, 0, Qt::AlignLeft);
+    layout->addStretch();
+    connect(m_sweepCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &BenchmarkHeatmapWidget::selectSweep);
+
+    connect(ThemeManager::instance(), &ThemeManager::themeChanged,
+            this, [this]() { update(); });
+}
+
+void BenchmarkHeatmapWidget::setResult(const BenchmarkResult& result) {
+    const QString previous = m_current >= 0 ? m_sweeps[m_current].name : QString();
+
+    m_sweeps.clear();
+    for (const ParameterSweep& sweep : BenchmarkStats::sweeps(result.benchmarks)) {
+        if (sweep.dimensions.size() == 2) m_sweeps << sweep;
+    }
+
+    // Keep showing the same sweep while a run streams in
+    int selected = m_sweeps.isEmpty() ? -1 : 0;
+    QStringList names;
+    for (int i = 0; i < m_sweeps.size(); ++i) {
+        names << m_sweeps[i].name;
+        if (m_sweeps[i].name == previous) selected = i;
+    }
+    m_sweepCombo->blockSignals(true);
+    m_sweepCombo->clear();
+    m_sweepCombo->addItems(names);
+    m_sweepCombo->setCurrentIndex(selected);
+    m_sweepCombo->blockSignals(false);
+    m_sweepCombo->setVisible(m_sweeps.size() > 1);
+    selectSweep(selected);
+}
+
+void BenchmarkHeatmapWidget::setMetric(BenchmarkMetric metric) {
+    m_metric = metric;
+    update();
+}
+
+QSize BenchmarkHeatmapWidget::sizeHint() const {
+    return QSize(400, 300);
+}
+
+void BenchmarkHeatmapWidget::selectSweep(int index) {
+    m_current = index >= 0 && index < m_sweeps.size() ? index : -1;
+    m_columns.clear();
+    m_rows.clear();
+    m_cells.clear();
+    if (m_current >= 0) {
+        const ParameterSweep& sweep = m_sweeps[m_current];
+        for (const SweepPoint& p : sweep.points) {
+            if (!m_columns.contains(p.coords[0])) m_columns << p.coords[0];
+            if (!m_rows.contains(p.coords[1]))    m_rows    << p.coords[1];
+        }
+        std::sort(m_columns.begin(), m_columns.end());
+        std::sort(m_rows.begin(), m_rows.end());
+        m_cells = QVector<int>(m_columns.size() * m_rows.size(), -1);
+        for (int i = 0; i < sweep.points.size(); ++i) {
+            const SweepPoint& p = sweep.points[i];
+            m_cells[m_rows.indexOf(p.coords[1]) * m_columns.size()
+                    + m_columns.indexOf(p.coords[0])] = i;
+        }
+    }
+    update();
+}
+
+// ── Geometry ──────────────────────────────────────────────────────────────────
+
+QRectF BenchmarkHeatmapWidget::gridRect() const {
+    const QFontMetrics fm(font());
+    int rowLabels = 0;
+    for (qint64 row : m_rows)
+        rowLabels = std::max(rowLabels, fm.horizontalAdvance(QString::number(row)));
+
+    const int top    = (m_sweepCombo->isVisible() ? m_sweepCombo->geometry().bottom() : 0)
+                     + HEADER_HEIGHT + fm.height();
+    const int left   = rowLabels + 10;
+    const int right  = LEGEND_WIDTH + fm.horizontalAdvance(QStringLiteral("000.0 ms")) + 16;
+    const int bottom = 2 * fm.height() + 8;
+    return QRectF(left, top, std::max(0, width() - left - right),
+                  std::max(0, height() - top - bottom));
+}
+
+int BenchmarkHeatmapWidget::pointAt(const QPoint& pos) const {
+    const QRectF grid = gridRect();
+    if (m_current < 0 || !grid.contains(pos)) return -1;
+    const int column = int((pos.x() - grid.left()) / grid.width() * m_columns.size());
+    const int row    = int((grid.bottom() - pos.y()) / grid.height() * m_rows.size());
+    if (column < 0 || column >= m_columns.size() || row < 0 || row >= m_rows.size()) return -1;
+    return m_cells[row * m_columns.size() + column];
+}
+
+double BenchmarkHeatmapWidget::valueOf(const SweepPoint& p) const {
+    if (m_metric == BenchmarkMetric::RealTime)
+        return BenchmarkStats::toNanoseconds(p.summary.median, p.summary.timeUnit);
+    return BenchmarkStats::metricValue(p.summary, m_metric);
+}
+
+QString BenchmarkHeatmapWidget::formatValue(double value) const {
+    if (m_metric == BenchmarkMetric::RealTime) {
+        if (value >= 1e9) return QStringLiteral("%1 s").arg(value / 1e9, 0, 'f', 1);
+        if (value >= 1e6) return QStringLiteral("%1 ms").arg(value / 1e6, 0, 'f', 1);
+        if (value >= 1e3) return QStringLiteral("%1 us").arg(value / 1e3, 0, 'f', 1);
+        return QStringLiteral("%1 ns").arg(value, 0, 'f', 1);
+    }
+    const QString text = QString::number(value, 'g', 3);
+    return m_metric == BenchmarkMetric::BranchMissRate ? text + QLatin1Char('%') : text;
+}
+
+// ── Painting ──────────────────────────────────────────────────────────────────
+
+void BenchmarkHeatmapWidget::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    QPainter painter(this);
+    painter.fillRect(rect(), theme.panelBackground);
+
+    if (m_current < 0) {
+        painter.setPen(theme.textSecondary);
+        painter.drawText(rect().adjusted(8, 8, -8, -8), Qt::AlignCenter | Qt::TextWordWrap,
+                         QStringLiteral("No benchmark varies two arguments.\n"
+                                        "Register one with ->Ranges({{lo, hi}, {lo, hi}}) "
+                                        "or ->ArgsProduct({...}) to see a heatmap."));
+        return;
+    }
+
+    const ParameterSweep& sweep = m_sweeps[m_current];
+    const QFontMetrics fm(font());
+    const QRectF grid = gridRect();
+    const int headerTop = m_sweepCombo->isVisible() ? m_sweepCombo->geometry().bottom() : 0;
+
+    painter.setPen(theme.textPrimary);
+    painter.drawText(QRect(4, headerTop, width() - 8, HEADER_HEIGHT),
+                     Qt::AlignVCenter | Qt::AlignLeft,
+                     QStringLiteral("%1 — %2").arg(sweep.name, BenchmarkStats::metricTitle(m_metric)));
+
+    // Log-scaled shade between the lowest and highest measured value
+    double low = 0.0, high = 0.0;
+    for (const SweepPoint& p : sweep.points) {
+        const double v = valueOf(p);
+        if (v <= 0.0) continue;
+        low  = low  > 0.0 ? std::min(low, v) : v;
+        high = std::max(high, v);
+    }
+    const double span = low > 0.0 && high > low ? std::log(high / low) : 0.0;
+
+    const double cellWidth  = grid.width()  / m_columns.size();
+    const double cellHeight = grid.height() / m_rows.size();
+    const bool   outlines   = cellWidth >= 6.0 && cellHeight >= 6.0;
+    for (int row = 0; row < m_rows.size(); ++row) {
+        for (int column = 0; column < m_columns.size(); ++column) {
+            const int index = m_cells[row * m_columns.size() + column];
+            if (index < 0) continue;
+            const QRectF cell(grid.left() + column * cellWidth,
+                              grid.bottom() - (row + 1) * cellHeight, cellWidth, cellHeight);
+            const double value = valueOf(sweep.points[index]);
+            if (value <= 0.0) {
+                painter.fillRect(cell, theme.border);
+                continue;
+            }
+            const QColor color = shade(theme, span > 0.0 ? std::log(value / low) / span : 0.0);
+            painter.fillRect(cell, color);
+            if (outlines) {
+                painter.setPen(theme.panelBackground);
+                painter.drawRect(cell);
+            }
+            const QString text = formatValue(value);
+            if (cellWidth > fm.horizontalAdvance(text) + 6 && cellHeight > fm.height() + 2) {
+                painter.setPen(color.lightnessF() > 0.55 ? Qt::black : Qt::white);
+                painter.drawText(cell, Qt::AlignCenter, text);
+            }
+        }
+    }
+
+    // Axis labels, skipping those that would overlap their neighbour
+    painter.setPen(theme.textSecondary);
+    double lastRight = -1e9;
+    for (int column = 0; column < m_columns.size(); ++column) {
+        const QString label = QString::number(m_columns[column]);
+        const double  w     = fm.horizontalAdvance(label);
+        const double  x     = grid.left() + (column + 0.5) * cellWidth - w / 2.0;
+        if (x < lastRight + 4) continue;
+        painter.drawText(QPointF(x, grid.bottom() + fm.ascent() + 2), label);
+        lastRight = x + w;
+    }
+    double lastTop = 1e9;
+    for (int row = 0; row < m_rows.size(); ++row) {
+        const double y = grid.bottom() - (row + 0.5) * cellHeight + fm.ascent() / 2.0;
+        if (y > lastTop - fm.height()) continue;
+        const QString label = QString::number(m_rows[row]);
+        painter.drawText(QPointF(grid.left() - 6 - fm.horizontalAdvance(label), y), label);
+        lastTop = y;
+    }
+    painter.setPen(theme.textPrimary);
+    painter.drawText(QRectF(grid.left(), grid.bottom() + fm.height() + 4, grid.width(), fm.height()),
+                     Qt::AlignHCenter, sweep.dimensions[0]);
+    painter.drawText(QRectF(4, grid.top() - fm.height() - 2, width() - 8, fm.height()),
+                     Qt::AlignLeft, sweep.dimensions[1]);
+
+    // Legend: the same ramp, highest value on top
+    if (high <= 0.0) return;
+    const QRectF bar(grid.right() + 8, grid.top(), LEGEND_WIDTH, grid.height());
+    QLinearGradient ramp(bar.bottomLeft(), bar.topLeft());
+    ramp.setColorAt(0.0, theme.success);
+    ramp.setColorAt(0.5, theme.warning);
+    ramp.setColorAt(1.0, theme.error);
+    painter.fillRect(bar, ramp);
+    painter.setPen(theme.textSecondary);
+    painter.drawText(QPointF(bar.right() + 4, bar.top() + fm.ascent()), formatValue(high));
+    painter.drawText(QPointF(bar.right() + 4, bar.bottom()), formatValue(low));
+}
+
+// ── Interaction ───────────────────────────────────────────────────────────────
+
+void BenchmarkHeatmapWidget::mouseMoveEvent(QMouseEvent* event) {
+    const int index = pointAt(event->pos());
+    if (index < 0) {
+        QToolTip::hideText();
+        return;
+    }
+    const ParameterSweep& sweep = m_sweeps[m_current];
+    const SweepPoint&     p     = sweep.points[index];
+    const double          value = valueOf(p);
+    const QString tip = QStringLiteral("<b>%1</b><br>%2 = %3, %4 = %5<br>%6")
+                            .arg(p.summary.runName.toHtmlEscaped(),
+                                 sweep.dimensions[0].toHtmlEscaped(), QString::number(p.coords[0]),
+                                 sweep.dimensions[1].toHtmlEscaped(), QString::number(p.coords[1]),
+                                 value < 0.0 ? QStringLiteral("not measured") : formatValue(value));
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QToolTip::showText(event->globalPosition().toPoint(), tip, this);
+#else
+    QToolTip::showText(event->globalPos(), tip, this);
+#endif
+}
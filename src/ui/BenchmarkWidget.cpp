@@ -1,6 +1,10 @@
 #include "ui/BenchmarkWidget.h"
 #include "ui/BenchmarkChartWidget.h"
+#include "ui/BenchmarkHeatmapWidget.h"
+#include "ui/QuickBenchWidget.h"
 #include "ui/ThemeManager.h"
+#include "tools/BenchmarkHistory.h"
+#include "tools/BenchmarkStats.h"
 
 #include <Qsci/qsciscintilla.h>
 #include <Qsci/qscilexercpp.h>
@@ -9,6 +13,7 @@
 #include <QColorDialog>
 #include <QComboBox>
 #include <QDir>
+#include <QDoubleSpinBox>
 #include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
@@ -22,17 +27,24 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QPlainTextEdit>
+#include <QProgressBar>
 #include <QPushButton>
 #include <QScrollArea>
+#include <QSpinBox>
 #include <QSplitter>
+#include <QStackedWidget>
 #include <QTabWidget>
 #include <QTableWidget>
 #include <QTableWidgetItem>
 #include <QTemporaryFile>
 #include <QTextStream>
+#include <QThread>
+#include <QTimer>
 #include <QToolButton>
 #include <QVBoxLayout>
 
+#include <algorithm>
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Color palette for auto-assignment
 // ─────────────────────────────────────────────────────────────────────────────
@@ -54,20 +66,37 @@ const QList<QColor>& BenchmarkWidget::recordPalette()
 BenchmarkWidget::BenchmarkWidget(QWidget* parent)
     : QWidget(parent)
     , m_runner(new BenchmarkRunner(this))
+    , m_history(new BenchmarkHistory(BenchmarkHistory::defaultPath(), this))
 {
     setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
     setupUi();
     loadTemplate();
 
+    m_liveRefreshTimer = new QTimer(this);
+    m_liveRefreshTimer->setSingleShot(true);
+    m_liveRefreshTimer->setInterval(LIVE_REFRESH_MS);
+    connect(m_liveRefreshTimer, &QTimer::timeout, this, &BenchmarkWidget::refreshLiveResult);
+
     connect(m_runner, &BenchmarkRunner::benchmarkResultReady,
             this, &BenchmarkWidget::onBenchmarkResultReady);
     connect(m_runner, &BenchmarkRunner::compilationFinished,
             this, &BenchmarkWidget::onCompilationFinished);
     connect(m_runner, &BenchmarkRunner::progressMessage,
             this, &BenchmarkWidget::onProgressMessage);
+    connect(m_runner, &BenchmarkRunner::convergenceUpdated,
+            this, &BenchmarkWidget::onConvergenceUpdated);
+    connect(m_runner, &BenchmarkRunner::entryReady,
+            this, &BenchmarkWidget::onEntryReady);
+    connect(m_runner, &BenchmarkRunner::runProgress,
+            this, &BenchmarkWidget::onRunProgress);
+    connect(m_runner, &IToolRunner::finished,
+            this, &BenchmarkWidget::onRunnerFinished);
+    connect(m_history, &BenchmarkHistory::changed,
+            this, &BenchmarkWidget::refreshHistory);
     connect(ThemeManager::instance(), &ThemeManager::themeChanged,
             this, &BenchmarkWidget::onThemeChanged);
 
+    refreshHistory();
     onThemeChanged(ThemeManager::instance()->currentThemeName());
 }
 
@@ -101,7 +130,14 @@ void BenchmarkWidget::setupUi() {
 
     auto* splitter = new QSplitter(Qt::Vertical, this);
     setupCodeEditor();
-    splitter->addWidget(m_editorTabs);
+    m_editorStack = new QStackedWidget(splitter);
+    m_editorStack->addWidget(m_editorTabs);
+    m_quickBench = new QuickBenchWidget(m_editorStack);
+    m_editorStack->addWidget(m_quickBench);
+    connect(m_quickBench, &QuickBenchWidget::editorAdded, this, [this]() {
+        applyThemeToEditor(ThemeManager::instance()->currentThemeName());
+    });
+    splitter->addWidget(m_editorStack);
     setupResultsTabs();
     splitter->addWidget(m_resultsTabs);
     splitter->setStretchFactor(0, 2);
@@ -116,6 +152,162 @@ void BenchmarkWidget::setupToolbar(QWidget* parent, QHBoxLayout* tbLayout) {
     m_optimizationCombo->setCurrentText(QStringLiteral("O2"));
     tbLayout->addWidget(m_optimizationCombo);
 
+    tbLayout->addWidget(new QLabel(QStringLiteral("Reps:"), parent));
+    m_repetitionsSpin = new QSpinBox(parent);
+    m_repetitionsSpin->setRange(1, 100);
+    m_repetitionsSpin->setValue(1);
+    m_repetitionsSpin->setToolTip(
+        QStringLiteral("--benchmark_repetitions\n\n"
+                       "Runs every benchmark this many times; the table shows the median,\n"
+                       "coefficient of variation and a bootstrap 95% confidence interval,\n"
+                       "and Compare tests whether two runs really differ.\n"
+                       "A single repetition cannot tell a speedup from noise; %1 or more\n"
+                       "are recommended.").arg(BenchmarkStats::RECOMMENDED_REPETITIONS));
+    tbLayout->addWidget(m_repetitionsSpin);
+
+    tbLayout->addWidget(new QLabel(QStringLiteral("Min time:"), parent));
+    m_minTimeSpin = new QDoubleSpinBox(parent);
+    m_minTimeSpin->setRange(0.0, 60.0);
+    m_minTimeSpin->setDecimals(2);
+    m_minTimeSpin->setSingleStep(0.1);
+    m_minTimeSpin->setSuffix(QStringLiteral(" s"));
+    m_minTimeSpin->setSpecialValueText(QStringLiteral("default"));
+    m_minTimeSpin->setToolTip(
+        QStringLiteral("--benchmark_min_time\n\n"
+                       "Minimum time each repetition runs for; longer runs average\n"
+                       "out more noise.  \"default\" keeps the library's 0.5 s."));
+    tbLayout->addWidget(m_minTimeSpin);
+
+    m_interleaveCheck = new QCheckBox(QStringLiteral("Interleave"), parent);
+    m_interleaveCheck->setToolTip(
+        QStringLiteral("--benchmark_enable_random_interleaving\n\n"
+                       "Runs repetitions of different benchmarks in random order so\n"
+                       "slow drift (thermal throttling, background load) does not\n"
+                       "favour whichever benchmark runs first."));
+    tbLayout->addWidget(m_interleaveCheck);
+
+    m_adaptiveCheck = new QCheckBox(QStringLiteral("Adaptive"), parent);
+    m_adaptiveCheck->setToolTip(
+        QStringLiteral("Repeat each benchmark until its numbers are stable\n\n"
+                       "Reps becomes the first batch (at least %1); every benchmark whose\n"
+                       "coefficient of variation and 95% CI width are both above the\n"
+                       "target is then re-run alone with --benchmark_filter, until it\n"
+                       "meets the target or the time budget is spent.\n"
+                       "Progress is shown in the Convergence tab.")
+            .arg(BenchmarkRunner::ADAPTIVE_MIN_REPETITIONS));
+    tbLayout->addWidget(m_adaptiveCheck);
+
+    m_targetSpin = new QDoubleSpinBox(parent);
+    m_targetSpin->setRange(0.1, 20.0);
+    m_targetSpin->setDecimals(1);
+    m_targetSpin->setSingleStep(0.5);
+    m_targetSpin->setValue(2.0);
+    m_targetSpin->setSuffix(QStringLiteral(" %"));
+    m_targetSpin->setToolTip(QStringLiteral("Adaptive target: CV or relative CI width"));
+    m_targetSpin->setEnabled(false);
+    tbLayout->addWidget(m_targetSpin);
+
+    m_budgetSpin = new QSpinBox(parent);
+    m_budgetSpin->setRange(5, 3600);
+    m_budgetSpin->setValue(60);
+    m_budgetSpin->setSuffix(QStringLiteral(" s"));
+    m_budgetSpin->setToolTip(QStringLiteral("Adaptive time budget for running the benchmarks"));
+    m_budgetSpin->setEnabled(false);
+    tbLayout->addWidget(m_budgetSpin);
+
+    connect(m_adaptiveCheck, &QCheckBox::toggled, this, [this](bool on) {
+        m_targetSpin->setEnabled(on);
+        m_budgetSpin->setEnabled(on);
+    });
+
+    m_pinCpusEdit = new QLineEdit(parent);
+    m_pinCpusEdit->setPlaceholderText(QStringLiteral("pin CPUs, e.g. 2,3"));
+    m_pinCpusEdit->setMaximumWidth(120);
+    m_pinCpusEdit->setToolTip(
+        QStringLiteral("Pin the benchmark to these CPUs (\"2,3\" or \"0-3\")\n\n"
+                       "Keeps the scheduler from migrating it mid-measurement. Pick\n"
+                       "CPUs that are otherwise idle, ideally isolated (isolcpus=)."));
+    tbLayout->addWidget(m_pinCpusEdit);
+
+    m_priorityCheck = new QCheckBox(QStringLiteral("High prio"), parent);
+    m_priorityCheck->setToolTip(
+        QStringLiteral("Run the benchmark at nice %1, ahead of ordinary processes\n"
+                       "(needs CAP_SYS_NICE or an RLIMIT_NICE allowance).")
+            .arg(BenchmarkRunner::ISOLATED_NICE));
+    tbLayout->addWidget(m_priorityCheck);
+
+    m_perfCountersCheck = new QCheckBox(QStringLiteral("HW counters"), parent);
+    m_perfCountersCheck->setToolTip(
+        QStringLiteral("--benchmark_perf_counters\n\n"
+                       "Counts cycles, instructions, cache misses, branches and branch\n"
+                       "misses per iteration, so the table and charts can show IPC,\n"
+                       "cache misses and the branch mispredict rate.\n"
+                       "Needs a library built with libpfm and kernel.perf_event_paranoid ≤ 2;\n"
+                       "otherwise the run goes on without them."));
+    tbLayout->addWidget(m_perfCountersCheck);
+
+    m_allocationsCheck = new QCheckBox(QStringLiteral("Allocs"), parent);
+    m_allocationsCheck->setToolTip(
+        QStringLiteral("Count heap allocations\n\n"
+                       "Links a memory manager that counts operator new / delete;\n"
+                       "the library then runs each benchmark once more and reports\n"
+                       "allocations and bytes per iteration and the peak of live bytes.\n"
+                       "Shows which version allocates: reserve, moves, SSO, small buffers."));
+    tbLayout->addWidget(m_allocationsCheck);
+
+    tbLayout->addWidget(new QLabel(QStringLiteral("Threads:"), parent));
+    m_threadSweepSpin = new QSpinBox(parent);
+    m_threadSweepSpin->setRange(0, qMax(64, 2 * QThread::idealThreadCount()));
+    m_threadSweepSpin->setValue(0);
+    m_threadSweepSpin->setPrefix(QStringLiteral("1.."));
+    m_threadSweepSpin->setSpecialValueText(QStringLiteral("as written"));
+    m_threadSweepSpin->setToolTip(
+        QStringLiteral("Sweep thread counts\n\n"
+                       "Runs every benchmark with ->ThreadRange(1, N) (powers of two up to N)\n"
+                       "without editing the file; registrations that already set threads\n"
+                       "keep theirs.  The Scaling tab plots speedup, the ideal line, the\n"
+                       "Amdahl fit and parallel efficiency.  This machine has %1 hardware threads.")
+            .arg(QThread::idealThreadCount()));
+    tbLayout->addWidget(m_threadSweepSpin);
+
+    tbLayout->addWidget(new QLabel(QStringLiteral("Plot:"), parent));
+    m_metricCombo = new QComboBox(parent);
+    m_metricCombo->addItem(QStringLiteral("Real time"),
+                           int(BenchmarkMetric::RealTime));
+    m_metricCombo->addItem(QStringLiteral("IPC"),
+                           int(BenchmarkMetric::Ipc));
+    m_metricCombo->addItem(QStringLiteral("Cache misses / iter"),
+                           int(BenchmarkMetric::CacheMisses));
+    m_metricCombo->addItem(QStringLiteral("Branch miss %"),
+                           int(BenchmarkMetric::BranchMissRate));
+    m_metricCombo->addItem(QStringLiteral("Allocs / iter"),
+                           int(BenchmarkMetric::Allocations));
+    m_metricCombo->addItem(QStringLiteral("Bytes / iter"),
+                           int(BenchmarkMetric::BytesAllocated));
+    m_metricCombo->setToolTip(QStringLiteral("What Charts, Comparison, Parameters and History plot; the counter metrics\n"
+                                             "need a run with HW counters, the heap ones with Allocs."));
+    tbLayout->addWidget(m_metricCombo);
+    connect(m_metricCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this]() {
+                const auto metric = BenchmarkMetric(m_metricCombo->currentData().toInt());
+                m_chartWidget->setMetric(metric);
+                m_comparisonChartWidget->setMetric(metric);
+                m_sweepChartWidget->setMetric(metric);
+                m_heatmapWidget->setMetric(metric);
+                m_historyChartWidget->setMetric(metric);
+                refreshDisplayedResult();
+                refreshHistory();
+                const QList<BenchmarkResult> compared = comparedResults();
+                if (compared.size() >= 2) m_comparisonChartWidget->compareResults(compared);
+            });
+
+    if (!BenchmarkRunner::isolationSupported()) {
+        m_pinCpusEdit->setEnabled(false);
+        m_priorityCheck->setEnabled(false);
+        m_pinCpusEdit->setToolTip(QStringLiteral("CPU pinning is only available on Linux."));
+        m_priorityCheck->setToolTip(QStringLiteral("Raising priority is only available on Linux."));
+    }
+
     tbLayout->addStretch();
 
     m_openFileButton = new QPushButton(QStringLiteral("Open..."), parent);
@@ -137,6 +329,22 @@ void BenchmarkWidget::setupToolbar(QWidget* parent, QHBoxLayout* tbLayout) {
     connect(m_importButton, &QPushButton::clicked, this, &BenchmarkWidget::importResults);
     tbLayout->addWidget(m_importButton);
 
+    m_quickBenchButton = new QPushButton(QStringLiteral("Quick Bench"), parent);
+    m_quickBenchButton->setCheckable(true);
+    m_quickBenchButton->setToolTip(
+        QStringLiteral("Compare plain snippets without writing harness code\n\n"
+                       "CppAtlas generates the BENCHMARK functions, keeps each snippet's\n"
+                       "result with DoNotOptimize() and ClobberMemory(), compiles them once\n"
+                       "and runs at least %1 interleaved repetitions.")
+            .arg(QuickBench::MIN_REPETITIONS));
+    connect(m_quickBenchButton, &QPushButton::toggled, this, [this](bool quick) {
+        m_editorStack->setCurrentWidget(quick ? static_cast<QWidget*>(m_quickBench)
+                                              : static_cast<QWidget*>(m_editorTabs));
+        m_openFileButton->setEnabled(!quick);
+        m_saveFileButton->setEnabled(!quick && !currentBenchFilePath().isEmpty());
+    });
+    tbLayout->addWidget(m_quickBenchButton);
+
     m_runButton = new QPushButton(QStringLiteral("▶  Run"), parent);
     m_runButton->setShortcut(QKeySequence(Qt::CTRL | Qt::Key_F9));
     m_runButton->setToolTip(
@@ -173,6 +381,13 @@ void BenchmarkWidget::setupToolbar(QWidget* parent, QHBoxLayout* tbLayout) {
     connect(m_compareButton, &QPushButton::clicked, this, &BenchmarkWidget::onCompareClicked);
     tbLayout->addWidget(m_compareButton);
 
+    m_progressBar = new QProgressBar(parent);
+    m_progressBar->setMaximumWidth(140);
+    m_progressBar->setFormat(QStringLiteral("%v / %m"));
+    m_progressBar->setToolTip(QStringLiteral("Benchmarks finished"));
+    m_progressBar->hide();
+    tbLayout->addWidget(m_progressBar);
+
     m_statusLabel = new QLabel(QStringLiteral("Ready"), parent);
     m_statusLabel->setMinimumWidth(220);
     tbLayout->addWidget(m_statusLabel);
@@ -212,10 +427,13 @@ void BenchmarkWidget::setupResultsTabs() {
     m_resultsTabs->addTab(m_chartWidget, QStringLiteral("Charts"));
 
     // Tab 1: Table
-    m_tableWidget = new QTableWidget(0, 4, m_resultsTabs);
+    m_tableWidget = new QTableWidget(0, 13, m_resultsTabs);
     m_tableWidget->setHorizontalHeaderLabels({
         QStringLiteral("Name"), QStringLiteral("Real Time"),
-        QStringLiteral("CPU Time"), QStringLiteral("Iterations")
+        QStringLiteral("CPU Time"), QStringLiteral("Iterations"),
+        QStringLiteral("Reps"), QStringLiteral("CV"), QStringLiteral("95% CI"),
+        QStringLiteral("IPC"), QStringLiteral("Cache Miss/Iter"), QStringLiteral("Branch Miss"),
+        QStringLiteral("Allocs/Iter"), QStringLiteral("Bytes/Iter"), QStringLiteral("Peak Heap")
     });
     m_tableWidget->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
     m_tableWidget->horizontalHeader()->setStretchLastSection(false);
@@ -229,12 +447,88 @@ void BenchmarkWidget::setupResultsTabs() {
     m_rawJsonView->setFont(QFont(QStringLiteral("Monospace"), 9));
     m_resultsTabs->addTab(m_rawJsonView, QStringLiteral("Raw JSON"));
 
-    // Tab 3: Comparison
-    m_comparisonChartWidget = new BenchmarkChartWidget(m_resultsTabs);
-    m_resultsTabs->addTab(m_comparisonChartWidget, QStringLiteral("Comparison"));
+    // Tab 3: Comparison — chart above, significance verdicts below
+    auto* comparisonSplitter = new QSplitter(Qt::Vertical, m_resultsTabs);
+    m_comparisonChartWidget = new BenchmarkChartWidget(comparisonSplitter);
+    comparisonSplitter->addWidget(m_comparisonChartWidget);
+
+    m_verdictTable = new QTableWidget(0, 6, comparisonSplitter);
+    m_verdictTable->setHorizontalHeaderLabels({
+        QStringLiteral("Benchmark"), QStringLiteral("Baseline"),
+        QStringLiteral("Contender"), QStringLiteral("Change"),
+        QStringLiteral("p-value"), QStringLiteral("Verdict")
+    });
+    m_verdictTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_verdictTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_verdictTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_verdictTable->verticalHeader()->setVisible(false);
+    m_verdictTable->setToolTip(
+        QStringLiteral("Each compared run against the first one (the baseline).\n"
+                       "Two-sided Mann-Whitney U test on the repetitions' real times,\n"
+                       "as in google/benchmark's tools/compare.py; significant below p = %1.")
+            .arg(BenchmarkStats::ALPHA));
+    m_comparisonContextLabel = new QLabel(comparisonSplitter);
+    m_comparisonContextLabel->setWordWrap(true);
+    m_comparisonContextLabel->setTextFormat(Qt::RichText);
+    m_comparisonContextLabel->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    m_comparisonContextLabel->setContentsMargins(6, 4, 6, 4);
+    comparisonSplitter->addWidget(m_comparisonContextLabel);
+    comparisonSplitter->addWidget(m_verdictTable);
+    comparisonSplitter->setStretchFactor(0, 2);
+    comparisonSplitter->setStretchFactor(1, 0);
+    comparisonSplitter->setStretchFactor(2, 1);
+    m_resultsTabs->addTab(comparisonSplitter, QStringLiteral("Comparison"));
 
     // Tab 4: Results Manager
     setupResultsManagerTab();
+
+    // Tab 5: Convergence — live per-benchmark state of an adaptive run
+    m_convergenceTable = new QTableWidget(0, 5, m_resultsTabs);
+    m_convergenceTable->setHorizontalHeaderLabels({
+        QStringLiteral("Benchmark"), QStringLiteral("Reps"), QStringLiteral("CV"),
+        QStringLiteral("CI width"), QStringLiteral("State")
+    });
+    m_convergenceTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    m_convergenceTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_convergenceTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_convergenceTable->verticalHeader()->setVisible(false);
+    m_resultsTabs->addTab(m_convergenceTable, QStringLiteral("Convergence"));
+
+    // Tab 6: Scaling — speedup against threads for ->ThreadRange benchmarks
+    m_scalingChartWidget = new BenchmarkChartWidget(m_resultsTabs);
+    m_scalingChartWidget->setChartType(BenchmarkChartWidget::ChartType::Scaling);
+    m_resultsTabs->addTab(m_scalingChartWidget, QStringLiteral("Scaling"));
+
+    // Tab 7: Parameters — ->Range / ->ArgsProduct sweeps, log-log above, 2-D heatmap below
+    auto* sweepSplitter = new QSplitter(Qt::Vertical, m_resultsTabs);
+    m_sweepChartWidget = new BenchmarkChartWidget(sweepSplitter);
+    m_sweepChartWidget->setChartType(BenchmarkChartWidget::ChartType::Line);
+    sweepSplitter->addWidget(m_sweepChartWidget);
+    m_heatmapWidget = new BenchmarkHeatmapWidget(sweepSplitter);
+    sweepSplitter->addWidget(m_heatmapWidget);
+    sweepSplitter->setStretchFactor(0, 3);
+    sweepSplitter->setStretchFactor(1, 2);
+    m_resultsTabs->addTab(sweepSplitter, QStringLiteral("Parameters"));
+
+    // Tab 8: History — stored runs of one source, trend and baseline
+    setupHistoryTab();
+
+    // Tab 9: Quick Bench — speedup of each snippet against the first
+    auto* quickSplitter = new QSplitter(Qt::Vertical, m_resultsTabs);
+    m_quickChartWidget = new BenchmarkChartWidget(quickSplitter);
+    quickSplitter->addWidget(m_quickChartWidget);
+    m_quickRatioLabel = new QLabel(
+        QStringLiteral("Switch on Quick Bench in the toolbar, write the snippets and Run."),
+        quickSplitter);
+    m_quickRatioLabel->setWordWrap(true);
+    m_quickRatioLabel->setTextFormat(Qt::RichText);
+    m_quickRatioLabel->setAlignment(Qt::AlignLeft | Qt::AlignTop);
+    m_quickRatioLabel->setContentsMargins(6, 4, 6, 4);
+    m_quickRatioLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    quickSplitter->addWidget(m_quickRatioLabel);
+    quickSplitter->setStretchFactor(0, 3);
+    quickSplitter->setStretchFactor(1, 1);
+    m_resultsTabs->addTab(quickSplitter, QStringLiteral("Quick Bench"));
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -293,6 +587,178 @@ void BenchmarkWidget::setupResultsManagerTab()
     m_resultsTabs->addTab(page, QStringLiteral("Results"));
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// History tab
+// ─────────────────────────────────────────────────────────────────────────────
+
+void BenchmarkWidget::setupHistoryTab()
+{
+    auto* page   = new QWidget(m_resultsTabs);
+    auto* layout = new QVBoxLayout(page);
+    layout->setContentsMargins(6, 6, 6, 6);
+    layout->setSpacing(4);
+
+    // ── Source selector and actions ───────────────────────────────────────────
+    auto* hdrRow = new QHBoxLayout();
+    hdrRow->addWidget(new QLabel(QStringLiteral("Source:"), page));
+    m_historySourceCombo = new QComboBox(page);
+    m_historySourceCombo->setMinimumWidth(200);
+    m_historySourceCombo->setToolTip(QStringLiteral("Runs are grouped by benchmark file, or by tab for unsaved ones"));
+    hdrRow->addWidget(m_historySourceCombo, 1);
+
+    m_pinBaselineButton = new QPushButton(QStringLiteral("Pin Baseline"), page);
+    m_pinBaselineButton->setToolTip(QStringLiteral("Compare every later run of this source against the selected one\n"
+                                                   "and flag significant regressions"));
+    m_unpinBaselineButton = new QPushButton(QStringLiteral("Unpin"), page);
+    m_loadHistoryButton = new QPushButton(QStringLiteral("Load"), page);
+    m_loadHistoryButton->setToolTip(QStringLiteral("Add the selected run to Results, e.g. to compare it"));
+    m_deleteHistoryButton = new QPushButton(QStringLiteral("Delete"), page);
+    hdrRow->addWidget(m_pinBaselineButton);
+    hdrRow->addWidget(m_unpinBaselineButton);
+    hdrRow->addWidget(m_loadHistoryButton);
+    hdrRow->addWidget(m_deleteHistoryButton);
+    layout->addLayout(hdrRow);
+
+    // ── Runs above, trend below ───────────────────────────────────────────────
+    auto* splitter = new QSplitter(Qt::Vertical, page);
+    m_historyTable = new QTableWidget(0, 6, splitter);
+    m_historyTable->setHorizontalHeaderLabels({
+        QStringLiteral("Run"), QStringLiteral("Recorded"), QStringLiteral("Source"),
+        QStringLiteral("Build"), QStringLiteral("Benchmarks"), QStringLiteral("vs. Baseline")
+    });
+    m_historyTable->horizontalHeader()->setSectionResizeMode(5, QHeaderView::Stretch);
+    m_historyTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_historyTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_historyTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_historyTable->verticalHeader()->setVisible(false);
+    splitter->addWidget(m_historyTable);
+    m_historyChartWidget = new BenchmarkChartWidget(splitter);
+    splitter->addWidget(m_historyChartWidget);
+    splitter->setStretchFactor(0, 1);
+    splitter->setStretchFactor(1, 2);
+    layout->addWidget(splitter, 1);
+
+    connect(m_historySourceCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this]() { refreshHistory(); });
+    connect(m_historyTable, &QTableWidget::itemSelectionChanged, this, [this]() {
+        const bool selected = selectedHistoryRun() >= 0;
+        m_pinBaselineButton->setEnabled(selected);
+        m_loadHistoryButton->setEnabled(selected);
+        m_deleteHistoryButton->setEnabled(selected);
+    });
+    connect(m_pinBaselineButton, &QPushButton::clicked, this, [this]() {
+        const qint64 id = selectedHistoryRun();
+        if (id >= 0 && !m_history->pinBaseline(id))
+            m_statusLabel->setText(QStringLiteral("History: ") + m_history->lastError());
+    });
+    connect(m_unpinBaselineButton, &QPushButton::clicked, this, [this]() {
+        m_history->unpinBaseline(m_historySourceCombo->currentData().toString());
+    });
+    connect(m_loadHistoryButton, &QPushButton::clicked, this, [this]() {
+        const BenchmarkHistoryRun run = m_history->run(selectedHistoryRun());
+        if (!run.isValid()) return;
+        addRecord(run.result, run.shortLabel());
+        m_exportButton->setEnabled(true);
+        m_resultsTabs->setCurrentIndex(4); // switch to Results tab
+    });
+    connect(m_deleteHistoryButton, &QPushButton::clicked, this, [this]() {
+        const qint64 id = selectedHistoryRun();
+        if (id >= 0 && !m_history->removeRun(id))
+            m_statusLabel->setText(QStringLiteral("History: ") + m_history->lastError());
+    });
+
+    if (!m_history->isOpen())
+        page->setToolTip(QStringLiteral("Benchmark history unavailable: ") + m_history->lastError());
+
+    m_resultsTabs->addTab(page, QStringLiteral("History"));
+}
+
+void BenchmarkWidget::refreshHistory()
+{
+    if (!m_historySourceCombo) return;
+
+    // Keep the shown source unless it has no runs left
+    const QString current = m_historySourceCombo->currentData().toString();
+    {
+        const QSignalBlocker blocker(m_historySourceCombo);
+        m_historySourceCombo->clear();
+        for (const QString& s : m_history->sourceNames()) {
+            m_historySourceCombo->addItem(QFileInfo(s).fileName(), s);
+            m_historySourceCombo->setItemData(m_historySourceCombo->count() - 1, s, Qt::ToolTipRole);
+        }
+        const int keep = m_historySourceCombo->findData(current.isEmpty() ? m_runSourceName : current);
+        m_historySourceCombo->setCurrentIndex(keep >= 0 ? keep : 0);
+    }
+
+    const QString source = m_historySourceCombo->currentData().toString();
+    const QList<BenchmarkHistoryRun> runs = source.isEmpty() ? QList<BenchmarkHistoryRun>{}
+                                                             : m_history->runs(source);
+    int baselineIndex = -1;
+    for (int i = 0; i < runs.size(); ++i)
+        if (runs[i].baseline) baselineIndex = i;
+
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    m_historyTable->setRowCount(0);
+    QList<BenchmarkResult> results;
+    for (int i = 0; i < runs.size(); ++i) {
+        const BenchmarkHistoryRun& run = runs[i];
+        results << run.result;
+        m_historyTable->insertRow(i);
+
+        auto* idItem = new QTableWidgetItem(run.baseline ? QStringLiteral("★ #%1").arg(run.id)
+                                                         : QStringLiteral("#%1").arg(run.id));
+        idItem->setData(Qt::UserRole, run.id);
+        if (run.baseline) idItem->setToolTip(QStringLiteral("Pinned baseline"));
+        m_historyTable->setItem(i, 0, idItem);
+        m_historyTable->setItem(i, 1, new QTableWidgetItem(
+            run.recordedAt.toLocalTime().toString(QStringLiteral("yyyy-MM-dd HH:mm:ss"))));
+        auto* hashItem = new QTableWidgetItem(run.sourceHash.left(7));
+        hashItem->setToolTip(run.sourceHash);
+        m_historyTable->setItem(i, 2, hashItem);
+        const QString cid = run.result.compilerId.contains('-') ? run.result.compilerId.section('-', -1)
+                                                                : run.result.compilerId;
+        auto* buildItem = new QTableWidgetItem(QStringLiteral("%1 / %2 / -%3")
+            .arg(cid.toUpper(), run.result.standard, run.result.optimizationLevel));
+        buildItem->setToolTip(BenchmarkRunner::describeMachine(run.result.context));
+        m_historyTable->setItem(i, 3, buildItem);
+        m_historyTable->setItem(i, 4, new QTableWidgetItem(
+            QString::number(BenchmarkStats::summarize(run.result.benchmarks).size())));
+
+        auto* verdictItem = new QTableWidgetItem();
+        if (baselineIndex >= 0 && i != baselineIndex) {
+            const QStringList flags = BenchmarkHistory::regressionFlags(
+                BenchmarkStats::compare(runs[baselineIndex].result, run.result));
+            if (flags.isEmpty()) {
+                verdictItem->setText(QStringLiteral("No regression"));
+                verdictItem->setForeground(theme.success);
+            } else {
+                verdictItem->setText(flags.size() == 1 ? flags.first()
+                                                       : QStringLiteral("⚠ %1 regressions").arg(flags.size()));
+                verdictItem->setToolTip(flags.join(QLatin1Char('\n')));
+                verdictItem->setForeground(theme.error);
+            }
+        }
+        m_historyTable->setItem(i, 5, verdictItem);
+    }
+    m_historyTable->resizeColumnsToContents();
+    m_historyTable->horizontalHeader()->setSectionResizeMode(5, QHeaderView::Stretch);
+
+    m_historyChartWidget->showTrend(results, baselineIndex);
+
+    m_pinBaselineButton->setEnabled(false);
+    m_loadHistoryButton->setEnabled(false);
+    m_deleteHistoryButton->setEnabled(false);
+    m_unpinBaselineButton->setEnabled(baselineIndex >= 0);
+}
+
+qint64 BenchmarkWidget::selectedHistoryRun() const
+{
+    const QList<QTableWidgetItem*> selected = m_historyTable->selectedItems();
+    if (selected.isEmpty()) return -1;
+    const QTableWidgetItem* idItem = m_historyTable->item(selected.first()->row(), 0);
+    return idItem ? idItem->data(Qt::UserRole).toLongLong() : -1;
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Record management
 // ─────────────────────────────────────────────────────────────────────────────
@@ -424,7 +890,7 @@ void BenchmarkWidget::refreshResultsTable()
         rowLay->addWidget(makeMeta(cid, cid));
         rowLay->addWidget(makeMeta(std));
         rowLay->addWidget(makeMeta(opt.isEmpty() ? QString("-") : "-" + opt));
-        auto* cntLbl = makeMeta(QString::number(rec.result.benchmarks.size()));
+        auto* cntLbl = makeMeta(QString::number(BenchmarkStats::summarize(rec.result.benchmarks).size()));
         cntLbl->setToolTip(QStringLiteral("Number of benchmarks"));
         rowLay->addWidget(cntLbl);
 
@@ -578,8 +1044,13 @@ void BenchmarkWidget::onClearAllResults()
     m_records.clear();
     refreshResultsTable();
     m_chartWidget->setResult(BenchmarkResult{});
+    m_scalingChartWidget->setResult(BenchmarkResult{});
+    m_sweepChartWidget->setResult(BenchmarkResult{});
+    m_heatmapWidget->setResult(BenchmarkResult{});
     m_tableWidget->setRowCount(0);
     m_rawJsonView->clear();
+    m_verdictTable->setRowCount(0);
+    m_comparisonContextLabel->clear();
     m_compareButton->setEnabled(false);
     m_exportButton->setEnabled(false);
 }
@@ -608,31 +1079,30 @@ void BenchmarkWidget::onExportResultClicked(int row)
         QFile f(path);
         if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
             QTextStream out(&f);
-            out << "name,real_time,cpu_time,iterations,time_unit\n";
+            out << "name,run_type,repetition_index,real_time,cpu_time,iterations,time_unit\n";
             for (const BenchmarkEntry& e : res.benchmarks)
-                out << e.name << "," << e.realTimeNs << "," << e.cpuTimeNs
+                out << e.name << ","
+                    << (e.isAggregate() ? e.aggregateName : QStringLiteral("iteration"))
+                    << "," << e.repetitionIndex << "," << e.realTimeNs << "," << e.cpuTimeNs
                     << "," << e.iterations << "," << e.timeUnit << "\n";
             ok = true;
         }
     } else {
         QJsonArray arr;
-        for (const BenchmarkEntry& e : res.benchmarks) {
-            QJsonObject obj;
-            obj["name"]       = e.name;
-            obj["real_time"]  = e.realTimeNs;
-            obj["cpu_time"]   = e.cpuTimeNs;
-            obj["iterations"] = static_cast<qint64>(e.iterations);
-            obj["time_unit"]  = e.timeUnit;
-            arr.append(obj);
-        }
+        for (const BenchmarkEntry& e : res.benchmarks)
+            arr.append(BenchmarkRunner::entryToJson(e));
         QJsonObject meta;
-        meta["compilerId"]        = res.compilerId;
-        meta["standard"]          = res.standard;
-        meta["optimizationLevel"] = res.optimizationLevel;
-        meta["label"]             = m_records[row].userLabel;
+        meta["compilerId"]         = res.compilerId;
+        meta["standard"]           = res.standard;
+        meta["optimizationLevel"]  = res.optimizationLevel;
+        meta["label"]              = m_records[row].userLabel;
+        meta["repetitions"]        = res.options.repetitions;
+        meta["minTime"]            = res.options.minTimeSec;
+        meta["randomInterleaving"] = res.options.randomInterleaving;
         QJsonObject root;
         root["date"]       = res.date;
         root["metadata"]   = meta;
+        root["context"]    = BenchmarkRunner::contextToJson(res.context);
         root["benchmarks"] = arr;
 
         QFile f(path);
@@ -661,6 +1131,9 @@ void BenchmarkWidget::refreshDisplayedResult()
     }
     // Nothing selected — clear views
     m_chartWidget->setResult(BenchmarkResult{});
+    m_scalingChartWidget->setResult(BenchmarkResult{});
+    m_sweepChartWidget->setResult(BenchmarkResult{});
+    m_heatmapWidget->setResult(BenchmarkResult{});
     m_tableWidget->setRowCount(0);
     m_rawJsonView->clear();
 }
@@ -674,19 +1147,120 @@ BenchmarkResult BenchmarkWidget::decoratedResult(int idx) const
     return r;
 }
 
-void BenchmarkWidget::refreshComparison()
+QList<BenchmarkResult> BenchmarkWidget::comparedResults() const
 {
-    QList<BenchmarkResult> toCompare;
+    QList<BenchmarkResult> compared;
     for (int i = 0; i < m_records.size(); ++i) {
         if (m_records[i].inComparison)
-            toCompare << decoratedResult(i);
+            compared << decoratedResult(i);
     }
+    return compared;
+}
+
+void BenchmarkWidget::refreshComparison()
+{
+    const QList<BenchmarkResult> toCompare = comparedResults();
     if (toCompare.size() < 2) return;
 
     m_comparisonChartWidget->compareResults(toCompare);
+    updateVerdictTable(toCompare);
+    updateComparisonContext(toCompare);
     m_resultsTabs->setCurrentIndex(3); // switch to Comparison tab
 }
 
+void BenchmarkWidget::updateVerdictTable(const QList<BenchmarkResult>& compared)
+{
+    m_verdictTable->setRowCount(0);
+    if (compared.size() < 2) return;
+
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    const BenchmarkResult& baseline = compared.first();
+    const QString baseLabel = baseline.label.isEmpty() ? baseline.optimizationLevel
+                                                       : baseline.label;
+    auto formatNs = [](double ns) {
+        if (ns >= 1e9) return QStringLiteral("%1 s").arg(ns / 1e9, 0, 'f', 3);
+        if (ns >= 1e6) return QStringLiteral("%1 ms").arg(ns / 1e6, 0, 'f', 3);
+        if (ns >= 1e3) return QStringLiteral("%1 us").arg(ns / 1e3, 0, 'f', 3);
+        return QStringLiteral("%1 ns").arg(ns, 0, 'f', 2);
+    };
+
+    for (int i = 1; i < compared.size(); ++i) {
+        const BenchmarkResult& contender = compared[i];
+        const QString label = contender.label.isEmpty() ? contender.optimizationLevel
+                                                        : contender.label;
+        for (const BenchmarkComparison& c : BenchmarkStats::compare(baseline, contender)) {
+            const int row = m_verdictTable->rowCount();
+            m_verdictTable->insertRow(row);
+
+            const QString name = compared.size() > 2
+                ? QStringLiteral("%1  [%2 vs %3]").arg(c.runName, label, baseLabel)
+                : c.runName;
+            m_verdictTable->setItem(row, 0, new QTableWidgetItem(name));
+            m_verdictTable->setItem(row, 1, new QTableWidgetItem(
+                QStringLiteral("%1 (×%2)").arg(formatNs(c.baselineNs)).arg(c.baselineRepetitions)));
+            m_verdictTable->setItem(row, 2, new QTableWidgetItem(
+                QStringLiteral("%1 (×%2)").arg(formatNs(c.contenderNs)).arg(c.contenderRepetitions)));
+            m_verdictTable->setItem(row, 3, new QTableWidgetItem(
+                QStringLiteral("%1%2%").arg(c.change >= 0 ? QStringLiteral("+") : QString())
+                                       .arg(c.change * 100.0, 0, 'f', 1)));
+            const bool tested = c.verdict != BenchmarkComparison::Verdict::InsufficientData;
+            m_verdictTable->setItem(row, 4, new QTableWidgetItem(
+                tested ? QString::number(c.pValue, 'f', 4) : QStringLiteral("—")));
+
+            auto* verdict = new QTableWidgetItem(BenchmarkComparison::verdictText(c.verdict));
+            switch (c.verdict) {
+            case BenchmarkComparison::Verdict::Faster:
+                verdict->setForeground(theme.success);
+                break;
+            case BenchmarkComparison::Verdict::Slower:
+                verdict->setForeground(theme.error);
+                break;
+            case BenchmarkComparison::Verdict::InsufficientData:
+                verdict->setForeground(theme.warning);
+                verdict->setToolTip(QStringLiteral("Run both with Reps ≥ %1 to test significance.")
+                                        .arg(BenchmarkStats::RECOMMENDED_REPETITIONS));
+                break;
+            case BenchmarkComparison::Verdict::NoSignificantDifference:
+                verdict->setForeground(theme.textSecondary);
+                break;
+            }
+            m_verdictTable->setItem(row, 5, verdict);
+        }
+    }
+    m_verdictTable->resizeColumnsToContents();
+    m_verdictTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+}
+
+void BenchmarkWidget::updateComparisonContext(const QList<BenchmarkResult>& compared)
+{
+    m_comparisonContextLabel->clear();
+    if (compared.size() < 2) return;
+
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    const BenchmarkContext& baseline = compared.first().context;
+    QStringList lines;
+    bool otherMachine = false;
+    for (const BenchmarkResult& r : compared) {
+        const QString label = r.label.isEmpty() ? r.optimizationLevel : r.label;
+        QString line = QStringLiteral("<b>%1</b>: %2")
+                           .arg(label.toHtmlEscaped(),
+                                BenchmarkRunner::describeMachine(r.context).toHtmlEscaped());
+        for (const QString& w : BenchmarkRunner::noiseWarnings(r)) {
+            line += QStringLiteral("<br>&nbsp;&nbsp;<span style=\"color:%1\">⚠ %2</span>")
+                        .arg(theme.warning.name(), w.toHtmlEscaped());
+        }
+        lines << line;
+        if (!r.context.isEmpty() && !baseline.isEmpty() && !r.context.sameMachine(baseline))
+            otherMachine = true;
+    }
+    if (otherMachine) {
+        lines.prepend(QStringLiteral("<span style=\"color:%1\"><b>⚠ These runs come from "
+                                     "different machines: differences may be hardware, "
+                                     "not code.</b></span>").arg(theme.error.name()));
+    }
+    m_comparisonContextLabel->setText(lines.join(QStringLiteral("<br>")));
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Toolbar slots
 // ─────────────────────────────────────────────────────────────────────────────
@@ -701,16 +1275,38 @@ void BenchmarkWidget::onCompareClicked()
 // ─────────────────────────────────────────────────────────────────────────────
 
 void BenchmarkWidget::runBenchmark() {
+    const bool quick = m_quickBenchButton->isChecked();
     auto* editor = currentBenchEditor();
-    if (!editor) return;
+    if (!quick && !editor) return;
+
+    // Quick Bench runs the harness generated from its snippets, never a file
+    QString filePath;
+    if (quick) {
+        QString error;
+        m_quickRunSnippets = m_quickBench->snippets();
+        m_runSourceText = QuickBench::generate(m_quickBench->setup(), m_quickRunSnippets, &error);
+        if (m_runSourceText.isEmpty()) {
+            m_quickRunSnippets.clear();
+            m_statusLabel->setText(QStringLiteral("Quick Bench: ") + error);
+            return;
+        }
+        m_runSourceName = QStringLiteral("Quick Bench");
+    } else {
+        m_quickRunSnippets.clear();
+        filePath        = currentBenchFilePath();
+        m_runSourceText = editor->text();
+        m_runSourceName = filePath;
+        if (m_runSourceName.isEmpty()) {
+            m_runSourceName = m_editorTabs->tabText(m_editorTabs->currentIndex());
+            if (m_runSourceName.endsWith(QLatin1Char('*'))) m_runSourceName.chop(1);
+        }
+    }
 
     QString sourceToRun;
-    const QString filePath = currentBenchFilePath();
-
     if (!filePath.isEmpty()) {
         QFile f(filePath);
         if (f.open(QIODevice::WriteOnly | QIODevice::Text))
-            QTextStream(&f) << editor->text();
+            QTextStream(&f) << m_runSourceText;
         sourceToRun = filePath;
     } else {
         m_tempBenchSource.reset(new QTemporaryFile(
@@ -720,13 +1316,42 @@ void BenchmarkWidget::runBenchmark() {
             m_statusLabel->setText(QStringLiteral("Error: cannot write temp file."));
             return;
         }
-        QTextStream(m_tempBenchSource.get()) << editor->text();
+        QTextStream(m_tempBenchSource.get()) << m_runSourceText;
         m_tempBenchSource->flush();
         sourceToRun = m_tempBenchSource->fileName();
     }
 
     m_runner->setCompilerId(m_compilerId);
 
+    BenchmarkRunOptions options;
+    options.repetitions        = m_repetitionsSpin->value();
+    options.minTimeSec         = m_minTimeSpin->value();
+    options.randomInterleaving = m_interleaveCheck->isChecked();
+    options.adaptive           = m_adaptiveCheck->isChecked();
+    options.targetCv           = m_targetSpin->value() / 100.0;
+    options.targetCiWidth      = m_targetSpin->value() / 100.0;
+    options.timeBudgetSec      = m_budgetSpin->value();
+    bool cpusOk = true;
+    options.pinnedCpus         = BenchmarkRunner::parseCpuList(m_pinCpusEdit->text(), &cpusOk);
+    options.raisePriority      = m_priorityCheck->isChecked();
+    options.perfCounters       = m_perfCountersCheck->isChecked();
+    options.trackAllocations   = m_allocationsCheck->isChecked();
+    options.threadSweepMax     = m_threadSweepSpin->value();
+    if (quick) options = QuickBench::runOptions(options);
+    if (!cpusOk) {
+        m_tempBenchSource.reset();
+        m_statusLabel->setText(QStringLiteral("Invalid CPU list \"%1\" — use e.g. 2,3 or 0-3.")
+                                   .arg(m_pinCpusEdit->text()));
+        return;
+    }
+    m_runner->setRunOptions(options);
+
+    m_convergenceTable->setRowCount(0);
+    if (options.adaptive) m_resultsTabs->setCurrentWidget(m_convergenceTable);
+
+    m_liveResult = BenchmarkResult();
+    m_liveResult.displayColor = recordPalette().value(m_records.size() % recordPalette().size());
+
     QStringList flags;
     flags << (QStringLiteral("-std=") + m_standard);
     flags << (QStringLiteral("-") + m_optimizationCombo->currentText());
@@ -771,11 +1396,89 @@ void BenchmarkWidget::onProgressMessage(const QString& msg) {
     m_statusLabel->setText(msg);
 }
 
+void BenchmarkWidget::onEntryReady(const BenchmarkEntry& entry) {
+    // Charts and Table follow the run as it goes, a batch of rows per
+    // refresh; the stored record replaces this once the binary exits
+    const bool first = m_liveResult.benchmarks.isEmpty();
+    m_liveResult.benchmarks << entry;
+    if (!m_liveRefreshTimer->isActive()) m_liveRefreshTimer->start();
+    if (first && m_resultsTabs->currentWidget() != m_convergenceTable)
+        m_resultsTabs->setCurrentWidget(m_chartWidget);
+}
+
+void BenchmarkWidget::onRunProgress(int done, int total) {
+    // A first pass (re)starts: drop rows of an attempt the runner abandoned
+    if (done == 0) m_liveResult.benchmarks.clear();
+    if (total <= 0) {
+        m_progressBar->hide();
+        return;
+    }
+    m_progressBar->setRange(0, total);
+    m_progressBar->setValue(done);
+    m_progressBar->show();
+}
+
+void BenchmarkWidget::onRunnerFinished(bool success, const QString&, const QString&) {
+    m_progressBar->hide();
+    if (!success) {
+        // Rows that streamed before the failure stay on show
+        if (m_liveRefreshTimer->isActive()) refreshLiveResult();
+        stopLiveRefresh();
+        m_tempBenchSource.reset();
+        m_runButton->setEnabled(true);
+        m_stopButton->setEnabled(false);
+    }
+}
+
+void BenchmarkWidget::onConvergenceUpdated(const BenchmarkConvergence& c) {
+    int row = 0;
+    while (row < m_convergenceTable->rowCount()
+           && m_convergenceTable->item(row, 0)->text() != c.runName)
+        ++row;
+    if (row == m_convergenceTable->rowCount()) {
+        m_convergenceTable->insertRow(row);
+        m_convergenceTable->setItem(row, 0, new QTableWidgetItem(c.runName));
+    }
+
+    m_convergenceTable->setItem(row, 1, new QTableWidgetItem(QString::number(c.repetitions)));
+    m_convergenceTable->setItem(row, 2, new QTableWidgetItem(
+        QStringLiteral("%1%").arg(c.cv * 100.0, 0, 'f', 2)));
+    m_convergenceTable->setItem(row, 3, new QTableWidgetItem(
+        QStringLiteral("±%1%").arg(c.ciWidth * 50.0, 0, 'f', 2)));
+
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    QString state;
+    QColor  color;
+    switch (c.state) {
+    case BenchmarkConvergence::State::Sampling:
+        state = QStringLiteral("Sampling...");
+        color = theme.textSecondary;
+        break;
+    case BenchmarkConvergence::State::Converged:
+        state = QStringLiteral("Converged");
+        color = theme.success;
+        break;
+    case BenchmarkConvergence::State::OutOfBudget:
+        state = QStringLiteral("Time budget spent");
+        color = theme.warning;
+        break;
+    case BenchmarkConvergence::State::OutOfRepetitions:
+        state = QStringLiteral("Repetition limit");
+        color = theme.warning;
+        break;
+    }
+    auto* stateItem = new QTableWidgetItem(state);
+    stateItem->setForeground(color);
+    m_convergenceTable->setItem(row, 4, stateItem);
+}
+
 void BenchmarkWidget::onBenchmarkResultReady(const BenchmarkResult& result) {
     m_tempBenchSource.reset();
     m_runButton->setEnabled(true);
     m_stopButton->setEnabled(false);
     m_exportButton->setEnabled(true);
+    // addRecord() shows the stored result, animated again
+    stopLiveRefresh();
 
     // Store with full metadata
     BenchmarkResult stored = result;
@@ -783,36 +1486,103 @@ void BenchmarkWidget::onBenchmarkResultReady(const BenchmarkResult& result) {
     stored.standard          = m_standard;
     stored.optimizationLevel = m_optimizationCombo->currentText();
 
-    addRecord(stored);
+    // Keep it, and check it against the pinned baseline of the same source
+    const qint64 historyId = m_history->addRun(stored, m_runSourceName, m_runSourceText);
+    const int sourceIndex = m_historySourceCombo->findData(m_runSourceName);
+    if (sourceIndex >= 0) m_historySourceCombo->setCurrentIndex(sourceIndex);
+    const BenchmarkHistoryRun baseline = m_history->baseline(m_runSourceName);
+    QStringList regressions;
+    if (historyId >= 0 && baseline.isValid() && baseline.id != historyId)
+        regressions = BenchmarkHistory::regressionFlags(BenchmarkStats::compare(baseline.result, stored));
 
-    m_statusLabel->setText(
-        QStringLiteral("Done — %1 benchmark(s)  ·  %2 total stored")
-            .arg(result.benchmarks.size()).arg(m_records.size()));
+    addRecord(stored);
 
-    // Switch to Results tab so user sees the new entry
-    m_resultsTabs->setCurrentIndex(4);
+    QString status = QStringLiteral("Done — %1 benchmark(s)  ·  %2 total stored")
+                         .arg(BenchmarkStats::summarize(result.benchmarks).size())
+                         .arg(m_records.size());
+    const QStringList warnings = BenchmarkRunner::noiseWarnings(stored);
+    if (!warnings.isEmpty())
+        status += QStringLiteral("  ·  ⚠ %1 warning(s)").arg(warnings.size());
+    if (!stored.perfCountersNote.isEmpty())
+        status += QStringLiteral("  ·  no HW counters");
+    if (!regressions.isEmpty())
+        status += QStringLiteral("  ·  ⚠ %1 regression(s) vs baseline").arg(regressions.size());
+    else if (baseline.isValid() && historyId >= 0)
+        status += QStringLiteral("  ·  no regression vs baseline");
+    if (historyId < 0)
+        status += QStringLiteral("  ·  not saved to history");
+    QString tip = BenchmarkRunner::describeMachine(stored.context);
+    if (!warnings.isEmpty())
+        tip += QStringLiteral("\n\n") + warnings.join(QLatin1Char('\n'));
+    if (!stored.perfCountersNote.isEmpty())
+        tip += QStringLiteral("\n\nHardware counters: ") + stored.perfCountersNote;
+    if (!regressions.isEmpty())
+        tip += QStringLiteral("\n\nAgainst baseline %1:\n").arg(baseline.shortLabel())
+               + regressions.join(QLatin1Char('\n'));
+    if (historyId < 0)
+        tip += QStringLiteral("\n\nHistory: ") + m_history->lastError();
+    m_statusLabel->setText(status);
+    m_statusLabel->setToolTip(tip);
+
+    // Switch to Results tab so user sees the new entry, or to the ratios of a Quick Bench
+    if (!m_quickRunSnippets.isEmpty()) {
+        showQuickBenchResult(stored);
+        m_quickRunSnippets.clear();
+        m_resultsTabs->setCurrentIndex(9);
+    } else {
+        m_resultsTabs->setCurrentIndex(4);
+    }
 
     emit benchmarkCompleted(result);
 }
 
+void BenchmarkWidget::showQuickBenchResult(const BenchmarkResult& result) {
+    const QList<QuickBenchRatio> ratios = QuickBench::ratios(result, m_quickRunSnippets);
+    const QString reference = m_quickRunSnippets.first().name;
+
+    BenchmarkChartWidget::BarGroup group;
+    group.label = QStringLiteral("Speedup vs %1").arg(reference);
+    QStringList categories;
+    for (const QuickBenchRatio& r : ratios) {
+        categories << r.name;
+        group.values << r.speedup;
+    }
+    m_quickChartWidget->showGroupedBars(
+        categories, { group },
+        QStringLiteral("Quick Bench — speed relative to %1 (higher is faster)").arg(reference),
+        QStringLiteral("× %1").arg(reference));
+
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    QStringList lines;
+    for (const QuickBenchRatio& r : ratios) {
+        const QColor color = !r.isSignificant() ? theme.textSecondary
+                           : r.speedup >= 1.0   ? theme.success
+                                                : theme.error;
+        lines << QStringLiteral("<span style=\"color:%1\">%2</span>")
+                     .arg(color.name(), r.text().toHtmlEscaped());
+    }
+    for (const QuickBenchSnippet& s : m_quickRunSnippets) {
+        const bool ran = std::any_of(ratios.cbegin(), ratios.cend(),
+                                     [&](const QuickBenchRatio& r) { return r.name == s.name; });
+        if (!ran)
+            lines << QStringLiteral("%1 has no result.").arg(s.name.toHtmlEscaped());
+    }
+    for (const QString& warning : QuickBench::warnings(m_quickRunSnippets))
+        lines << QStringLiteral("<span style=\"color:%1\">⚠ %2</span>")
+                     .arg(theme.warning.name(), warning.toHtmlEscaped());
+    m_quickRatioLabel->setText(lines.join(QStringLiteral("<br>")));
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // View update (Charts / Table / Raw JSON)
 // ─────────────────────────────────────────────────────────────────────────────
 
 void BenchmarkWidget::updateResultsView(const BenchmarkResult& result) {
     m_chartWidget->setResult(result);
-
-    m_tableWidget->setRowCount(result.benchmarks.size());
-    for (int i = 0; i < result.benchmarks.size(); ++i) {
-        const BenchmarkEntry& e    = result.benchmarks[i];
-        const QString         unit = e.timeUnit.isEmpty() ? QStringLiteral("ns") : e.timeUnit;
-        m_tableWidget->setItem(i, 0, new QTableWidgetItem(e.name));
-        m_tableWidget->setItem(i, 1, new QTableWidgetItem(
-                                         QStringLiteral("%1 %2").arg(e.realTimeNs, 0, 'f', 2).arg(unit)));
-        m_tableWidget->setItem(i, 2, new QTableWidgetItem(
-                                         QStringLiteral("%1 %2").arg(e.cpuTimeNs, 0, 'f', 2).arg(unit)));
-        m_tableWidget->setItem(i, 3, new QTableWidgetItem(QString::number(e.iterations)));
-    }
+    m_scalingChartWidget->setResult(result);
+    m_sweepChartWidget->setResult(result);
+    m_heatmapWidget->setResult(result);
+    populateTable(result);
 
     QString raw = QStringLiteral("// %1 benchmark(s)  date: %2\n\n")
                       .arg(result.benchmarks.size()).arg(result.date);
@@ -820,15 +1590,8 @@ void BenchmarkWidget::updateResultsView(const BenchmarkResult& result) {
         raw += result.rawJson;
     } else {
         QJsonArray arr;
-        for (const BenchmarkEntry& e : result.benchmarks) {
-            QJsonObject obj;
-            obj["name"]       = e.name;
-            obj["real_time"]  = e.realTimeNs;
-            obj["cpu_time"]   = e.cpuTimeNs;
-            obj["iterations"] = static_cast<qint64>(e.iterations);
-            obj["time_unit"]  = e.timeUnit;
-            arr.append(obj);
-        }
+        for (const BenchmarkEntry& e : result.benchmarks)
+            arr.append(BenchmarkRunner::entryToJson(e));
         QJsonObject root;
         root["date"]       = result.date;
         root["benchmarks"] = arr;
@@ -837,6 +1600,85 @@ void BenchmarkWidget::updateResultsView(const BenchmarkResult& result) {
     m_rawJsonView->setPlainText(raw);
 }
 
+void BenchmarkWidget::refreshLiveResult() {
+    for (BenchmarkChartWidget* chart : { m_chartWidget, m_scalingChartWidget, m_sweepChartWidget })
+        chart->setAnimated(false);
+    m_chartWidget->setResult(m_liveResult);
+    m_scalingChartWidget->setResult(m_liveResult);
+    m_sweepChartWidget->setResult(m_liveResult);
+    m_heatmapWidget->setResult(m_liveResult);
+    populateTable(m_liveResult);
+}
+
+void BenchmarkWidget::stopLiveRefresh() {
+    m_liveRefreshTimer->stop();
+    for (BenchmarkChartWidget* chart : { m_chartWidget, m_scalingChartWidget, m_sweepChartWidget })
+        chart->setAnimated(true);
+}
+
+void BenchmarkWidget::populateTable(const BenchmarkResult& result) {
+    // One row per benchmark: the median over its repetitions, not every raw row
+    const QList<BenchmarkSummary> summaries = BenchmarkStats::summarize(result.benchmarks);
+    const Theme theme = ThemeManager::instance()->currentTheme();
+    m_tableWidget->setRowCount(summaries.size());
+
+    // Counter and heap columns only for runs that measured them
+    const bool counters = std::any_of(summaries.cbegin(), summaries.cend(),
+                                      [](const BenchmarkSummary& s) { return s.hasPerfCounters(); });
+    const bool heap = std::any_of(summaries.cbegin(), summaries.cend(),
+                                  [](const BenchmarkSummary& s) { return s.hasAllocations(); });
+    for (int column = 7; column < 10; ++column) m_tableWidget->setColumnHidden(column, !counters);
+    for (int column = 10; column < 13; ++column) m_tableWidget->setColumnHidden(column, !heap);
+    auto counterText = [](double value, int decimals, const QString& suffix = QString()) {
+        return value < 0.0 ? QStringLiteral("—")
+                           : QString::number(value, 'f', decimals) + suffix;
+    };
+    for (int i = 0; i < summaries.size(); ++i) {
+        const BenchmarkSummary& s    = summaries[i];
+        const QString&          unit = s.timeUnit;
+        m_tableWidget->setItem(i, 0, new QTableWidgetItem(s.runName));
+        m_tableWidget->setItem(i, 1, new QTableWidgetItem(
+                                         QStringLiteral("%1 %2").arg(s.median, 0, 'f', 2).arg(unit)));
+        m_tableWidget->setItem(i, 2, new QTableWidgetItem(
+                                         QStringLiteral("%1 %2").arg(s.cpuMedian, 0, 'f', 2).arg(unit)));
+        m_tableWidget->setItem(i, 3, new QTableWidgetItem(
+                                         s.iterations > 0 ? QString::number(s.iterations)
+                                                          : QStringLiteral("—")));
+        m_tableWidget->setItem(i, 4, new QTableWidgetItem(QString::number(s.repetitions)));
+
+        const bool spread = s.repetitions >= 2;
+        auto* cv = new QTableWidgetItem(
+            spread ? QStringLiteral("%1%").arg(s.cv * 100.0, 0, 'f', 2) : QStringLiteral("—"));
+        // Above a few percent the run-to-run noise swamps small speedups
+        if (spread && s.cv > 0.05) {
+            cv->setForeground(theme.warning);
+            cv->setToolTip(QStringLiteral("Noisy: repetitions vary by more than 5%."));
+        }
+        m_tableWidget->setItem(i, 5, cv);
+        m_tableWidget->setItem(i, 6, new QTableWidgetItem(
+            s.hasInterval()
+                ? QStringLiteral("%1 – %2 %3").arg(s.ciLow, 0, 'f', 2).arg(s.ciHigh, 0, 'f', 2).arg(unit)
+                : QStringLiteral("—")));
+        if (counters) {
+            m_tableWidget->setItem(i, 7, new QTableWidgetItem(
+                counterText(BenchmarkStats::metricValue(s, BenchmarkMetric::Ipc), 2)));
+            m_tableWidget->setItem(i, 8, new QTableWidgetItem(
+                counterText(BenchmarkStats::metricValue(s, BenchmarkMetric::CacheMisses), 2)));
+            m_tableWidget->setItem(i, 9, new QTableWidgetItem(
+                counterText(BenchmarkStats::metricValue(s, BenchmarkMetric::BranchMissRate), 2,
+                            QStringLiteral("%"))));
+        }
+        if (heap) {
+            m_tableWidget->setItem(i, 10, new QTableWidgetItem(
+                counterText(s.allocsPerIteration, 2)));
+            m_tableWidget->setItem(i, 11, new QTableWidgetItem(
+                counterText(s.bytesPerIteration, 0, QStringLiteral(" B"))));
+            m_tableWidget->setItem(i, 12, new QTableWidgetItem(
+                counterText(s.peakBytes, 0, QStringLiteral(" B"))));
+        }
+    }
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Import
 // ─────────────────────────────────────────────────────────────────────────────
@@ -879,6 +1721,7 @@ void BenchmarkWidget::importResults() {
 void BenchmarkWidget::stopProcess() {
     m_runner->cancel();
     m_tempBenchSource.reset();
+    m_progressBar->hide();
     m_runButton->setEnabled(true);
     m_stopButton->setEnabled(false);
     m_statusLabel->setText(QStringLiteral("Stopped."));
@@ -892,6 +1735,17 @@ QsciScintilla* BenchmarkWidget::currentBenchEditor() const {
     return qobject_cast<QsciScintilla*>(m_editorTabs->currentWidget());
 }
 
+QList<QsciScintilla*> BenchmarkWidget::benchEditors() const {
+    QList<QsciScintilla*> editors;
+    for (int i = 0; i < m_editorTabs->count(); ++i) {
+        if (auto* editor = qobject_cast<QsciScintilla*>(m_editorTabs->widget(i)))
+            editors << editor;
+    }
+    // Null while the first tab is created, before the Quick Bench panes exist
+    if (m_quickBench) editors << m_quickBench->editors();
+    return editors;
+}
+
 QString BenchmarkWidget::currentBenchFilePath() const {
     const int idx = m_editorTabs->currentIndex();
     if (idx < 0) return QString();
@@ -1004,9 +1858,7 @@ void BenchmarkWidget::saveBenchmarkFile() {
 void BenchmarkWidget::applyThemeToEditor(const QString& themeName) {
     Theme theme = ThemeManager::instance()->currentTheme();
     Q_UNUSED(themeName);
-    for (int i = 0; i < m_editorTabs->count(); ++i) {
-        auto* editor = qobject_cast<QsciScintilla*>(m_editorTabs->widget(i));
-        if (!editor) continue;
+    for (QsciScintilla* editor : benchEditors()) {
         auto* lexer = qobject_cast<QsciLexerCPP*>(editor->lexer());
         if (lexer) {
             lexer->setDefaultPaper(theme.editorBackground);
@@ -1054,9 +1906,7 @@ void BenchmarkWidget::onThemeChanged(const QString& themeName) {
 }
 
 void BenchmarkWidget::applyEditorSettings(const QFont& font, bool showLineNumbers, bool wordWrap) {
-    for (int i = 0; i < m_editorTabs->count(); ++i) {
-        auto* editor = qobject_cast<QsciScintilla*>(m_editorTabs->widget(i));
-        if (!editor) continue;
+    for (QsciScintilla* editor : benchEditors()) {
         editor->setFont(font);
         editor->setMarginsFont(font);
         auto* lexer = qobject_cast<QsciLexerCPP*>(editor->lexer());
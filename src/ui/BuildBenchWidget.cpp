@@ -0,0 +1,511 @@
+#include "ui/BuildBenchWidget.h"
+#include "ui/BenchmarkChartWidget.h"
+#include "ui/ThemeManager.h"
+#include "compiler/CompilerRegistry.h"
+#include "tools/ProcessMeter.h"
+
+#include <Qsci/qsciscintilla.h>
+#include <Qsci/qscilexercpp.h>
+
+#include <QAction>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMenu>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QSplitter>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QToolButton>
+#include <QVBoxLayout>
+
+namespace {
+
+const char* const kTemplateSnippet =
+    "// Fibonacci computed by recursive class template instantiation\n"
+    "template <unsigned N>\n"
+    "struct Fib {\n"
+    "    static constexpr unsigned long long value = Fib<N - 1>::value + Fib<N - 2>::value;\n"
+    "};\n"
+    "template <> struct Fib<1> { static constexpr unsigned long long value = 1; };\n"
+    "template <> struct Fib<0> { static constexpr unsigned long long value = 0; };\n"
+    "\n"
+    "static_assert(Fib<90>::value == 2880067194370816120ULL, \"Fib<90>\");\n";
+
+const char* const kConstexprSnippet =
+    "// The same value from a constexpr function (C++14)\n"
+    "constexpr unsigned long long fib(unsigned n) {\n"
+    "    unsigned long long a = 0, b = 1;\n"
+    "    for (unsigned i = 0; i < n; ++i) {\n"
+    "        const unsigned long long next = a + b;\n"
+    "        a = b;\n"
+    "        b = next;\n"
+    "    }\n"
+    "    return a;\n"
+    "}\n"
+    "\n"
+    "static_assert(fib(90) == 2880067194370816120ULL, \"fib(90)\");\n";
+
+enum TableColumn {
+    SnippetColumn,
+    ConfigColumn,
+    WallColumn,
+    CpuColumn,
+    RssColumn,
+    SpeedupColumn,
+    RunsColumn,
+    TableColumnCount
+};
+
+QString meanAndStddev(const BuildBenchStats& stats, int precision = 1) {
+    if (stats.count == 0) return QStringLiteral("—");
+    return QStringLiteral("%1 ± %2").arg(stats.mean, 0, 'f', precision)
+                                     .arg(stats.stddev, 0, 'f', precision);
+}
+
+} // namespace
+
+BuildBenchWidget::BuildBenchWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_runner(new BuildBenchRunner(this))
+{
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
+    setupUi();
+
+    connect(m_runner, &BuildBenchRunner::progressMessage,
+            m_statusLabel, &QLabel::setText);
+    connect(m_runner, &BuildBenchRunner::progressChanged,
+            this, &BuildBenchWidget::onProgressChanged);
+    connect(m_runner, &BuildBenchRunner::caseFinished,
+            this, &BuildBenchWidget::onCaseFinished);
+    connect(m_runner, &BuildBenchRunner::finished,
+            this, &BuildBenchWidget::onBenchFinished);
+
+    connect(&CompilerRegistry::instance(), &CompilerRegistry::compilersChanged,
+            this, &BuildBenchWidget::rebuildCompilerMenu);
+    connect(ThemeManager::instance(), &ThemeManager::themeChanged,
+            this, &BuildBenchWidget::onThemeChanged);
+
+    addSnippetTab(QStringLiteral("templates"), QString::fromUtf8(kTemplateSnippet));
+    addSnippetTab(QStringLiteral("constexpr"), QString::fromUtf8(kConstexprSnippet));
+    m_snippetTabs->setCurrentIndex(0);
+}
+
+// ── UI setup ──────────────────────────────────────────────────────────────────
+
+void BuildBenchWidget::setupUi() {
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    mainLayout->setSpacing(0);
+
+    auto* toolbar = new QWidget(this);
+    setupToolbar(toolbar);
+    mainLayout->addWidget(toolbar);
+
+    auto* splitter = new QSplitter(Qt::Vertical, this);
+
+    // --- Snippet editors ---
+    m_snippetTabs = new QTabWidget(splitter);
+    m_snippetTabs->setTabsClosable(true);
+    m_snippetTabs->setMovable(true);
+    auto* addTabBtn = new QPushButton(QStringLiteral("+"), m_snippetTabs);
+    addTabBtn->setFixedSize(24, 24);
+    addTabBtn->setToolTip(QStringLiteral("Add a code variant"));
+    m_snippetTabs->setCornerWidget(addTabBtn, Qt::TopRightCorner);
+    connect(addTabBtn, &QPushButton::clicked, this, [this]() {
+        addSnippetTab(QStringLiteral("variant-%1").arg(m_snippetCounter + 1), QString());
+    });
+    connect(m_snippetTabs, &QTabWidget::tabCloseRequested, this, [this](int index) {
+        if (m_snippetTabs->count() > 1) {
+            m_snippetTabs->widget(index)->deleteLater();
+            m_snippetTabs->removeTab(index);
+        }
+    });
+    splitter->addWidget(m_snippetTabs);
+
+    // --- Results ---
+    m_resultsTabs = new QTabWidget(splitter);
+
+    auto* chartPage = new QWidget(m_resultsTabs);
+    auto* chartLayout = new QVBoxLayout(chartPage);
+    chartLayout->setContentsMargins(4, 4, 4, 4);
+    auto* metricRow = new QHBoxLayout;
+    metricRow->addWidget(new QLabel(QStringLiteral("Metric:"), chartPage));
+    m_metricCombo = new QComboBox(chartPage);
+    m_metricCombo->addItem(QStringLiteral("Wall time (ms)"), int(Metric::WallTime));
+    m_metricCombo->addItem(QStringLiteral("CPU time (ms)"),  int(Metric::CpuTime));
+    m_metricCombo->addItem(QStringLiteral("Peak RSS (MB)"),  int(Metric::PeakRss));
+    m_metricCombo->addItem(QStringLiteral("Speedup (×)"),    int(Metric::Speedup));
+    connect(m_metricCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &BuildBenchWidget::refreshChart);
+    metricRow->addWidget(m_metricCombo);
+    metricRow->addStretch();
+    chartLayout->addLayout(metricRow);
+    m_chartWidget = new BenchmarkChartWidget(chartPage);
+    chartLayout->addWidget(m_chartWidget, 1);
+    m_resultsTabs->addTab(chartPage, QStringLiteral("Chart"));
+
+    m_tableWidget = new QTableWidget(0, TableColumnCount, m_resultsTabs);
+    m_tableWidget->setHorizontalHeaderLabels({ QStringLiteral("Snippet"),
+                                               QStringLiteral("Configuration"),
+                                               QStringLiteral("Wall (ms)"),
+                                               QStringLiteral("CPU (ms)"),
+                                               QStringLiteral("Peak RSS (MB)"),
+                                               QStringLiteral("Speedup"),
+                                               QStringLiteral("Runs") });
+    m_tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tableWidget->setAlternatingRowColors(true);
+    m_tableWidget->verticalHeader()->setVisible(false);
+    m_tableWidget->horizontalHeader()->setSectionResizeMode(ConfigColumn, QHeaderView::Stretch);
+    m_resultsTabs->addTab(m_tableWidget, QStringLiteral("Table"));
+
+    splitter->addWidget(m_resultsTabs);
+    splitter->setStretchFactor(0, 2);
+    splitter->setStretchFactor(1, 1);
+    mainLayout->addWidget(splitter, 1);
+}
+
+void BuildBenchWidget::setupToolbar(QWidget* toolbar) {
+    auto* tbLayout = new QHBoxLayout(toolbar);
+    tbLayout->setContentsMargins(6, 4, 6, 4);
+
+    tbLayout->addWidget(makeMenuButton(QStringLiteral("Compilers"), toolbar, &m_compilerMenu));
+    connect(m_compilerMenu, &QMenu::triggered, this, [this]() { m_userPickedCompilers = true; });
+    rebuildCompilerMenu();
+
+    tbLayout->addWidget(makeMenuButton(QStringLiteral("Standards"), toolbar, &m_standardMenu));
+    addCheckableItems(m_standardMenu, { "c++11", "c++14", "c++17", "c++20", "c++23" }, { m_standard });
+    connect(m_standardMenu, &QMenu::triggered, this, [this]() { m_userPickedStandards = true; });
+
+    tbLayout->addWidget(makeMenuButton(QStringLiteral("Opt"), toolbar, &m_optMenu));
+    addCheckableItems(m_optMenu, { "O0", "O1", "O2", "O3", "Os" }, { "O0", "O2" });
+
+    tbLayout->addSpacing(8);
+    tbLayout->addWidget(new QLabel(QStringLiteral("Reps:"), toolbar));
+    m_repsSpin = new QSpinBox(toolbar);
+    m_repsSpin->setRange(1, 100);
+    m_repsSpin->setValue(5);
+    m_repsSpin->setToolTip(QStringLiteral("Measured compiles per case (one extra warm-up run is discarded)"));
+    tbLayout->addWidget(m_repsSpin);
+
+    m_parallelCheck = new QCheckBox(QStringLiteral("Parallel"), toolbar);
+    m_parallelCheck->setToolTip(ProcessMeter::hasAffinity()
+        ? QStringLiteral("Run one compile per core, each pinned to its own CPU.\n"
+                         "Faster, but shared caches and turbo limits add noise.")
+        : QStringLiteral("Run one compile per core.\n"
+                         "Faster, but concurrent compiles add noise."));
+    tbLayout->addWidget(m_parallelCheck);
+
+    tbLayout->addStretch();
+
+    m_runButton = new QPushButton(QStringLiteral("▶  Run"), toolbar);
+    m_runButton->setToolTip(QStringLiteral(
+        "Compile every snippet under every selected configuration and\n"
+        "compare wall time, CPU time and peak memory of the compiler"));
+    connect(m_runButton, &QPushButton::clicked, this, &BuildBenchWidget::runBench);
+    tbLayout->addWidget(m_runButton);
+
+    m_stopButton = new QPushButton(QStringLiteral("■ Stop"), toolbar);
+    m_stopButton->setEnabled(false);
+    connect(m_stopButton, &QPushButton::clicked, this, &BuildBenchWidget::stopBench);
+    tbLayout->addWidget(m_stopButton);
+
+    m_progressBar = new QProgressBar(toolbar);
+    m_progressBar->setMaximumWidth(120);
+    m_progressBar->setTextVisible(false);
+    m_progressBar->setVisible(false);
+    tbLayout->addWidget(m_progressBar);
+
+    m_statusLabel = new QLabel(QStringLiteral("Ready"), toolbar);
+    m_statusLabel->setMinimumWidth(200);
+    tbLayout->addWidget(m_statusLabel);
+}
+
+// static
+QToolButton* BuildBenchWidget::makeMenuButton(const QString& text, QWidget* parent, QMenu** menu) {
+    auto* button = new QToolButton(parent);
+    button->setText(text);
+    button->setPopupMode(QToolButton::InstantPopup);
+    *menu = new QMenu(button);
+    button->setMenu(*menu);
+    return button;
+}
+
+// static
+void BuildBenchWidget::addCheckableItems(QMenu* menu, const QStringList& items,
+                                         const QStringList& checked) {
+    for (const QString& item : items) {
+        QAction* action = menu->addAction(item);
+        action->setCheckable(true);
+        action->setChecked(checked.contains(item));
+    }
+}
+
+// static
+QStringList BuildBenchWidget::checkedItems(const QMenu* menu) {
+    QStringList items;
+    for (const QAction* action : menu->actions()) {
+        if (action->isChecked()) items << action->text();
+    }
+    return items;
+}
+
+void BuildBenchWidget::rebuildCompilerMenu() {
+    QStringList checked = checkedItems(m_compilerMenu);
+    if (!m_userPickedCompilers && !m_compilerId.isEmpty()) {
+        checked = { m_compilerId };
+    }
+    m_compilerMenu->clear();
+
+    QStringList ids;
+    for (const auto& compiler : CompilerRegistry::instance().getAvailableCompilers()) {
+        ids << compiler->id();
+    }
+    if (checked.isEmpty() && !ids.isEmpty()) {
+        checked << (ids.contains(CompilerRegistry::instance().defaultCompilerId())
+                        ? CompilerRegistry::instance().defaultCompilerId()
+                        : ids.first());
+    }
+    addCheckableItems(m_compilerMenu, ids, checked);
+}
+
+void BuildBenchWidget::addSnippetTab(const QString& name, const QString& code) {
+    auto* editor = new QsciScintilla(m_snippetTabs);
+    auto* lexer  = new QsciLexerCPP(editor);
+    QFont font(QStringLiteral("Monospace"), 10);
+    lexer->setDefaultFont(font);
+    editor->setLexer(lexer);
+    editor->setTabWidth(4);
+    editor->setIndentationsUseTabs(false);
+    editor->setAutoIndent(true);
+    editor->setFolding(QsciScintilla::BoxedTreeFoldStyle);
+    editor->setMarginType(0, QsciScintilla::NumberMargin);
+    editor->setMarginWidth(0, QStringLiteral("00000"));
+    editor->setWrapMode(QsciScintilla::WrapWord);
+    editor->SendScintilla(QsciScintilla::SCI_SETHSCROLLBAR, 0);
+    editor->setText(code);
+
+    ++m_snippetCounter;
+    const int idx = m_snippetTabs->addTab(editor, name);
+    m_snippetTabs->setCurrentIndex(idx);
+    applyThemeToEditor(editor);
+}
+
+// ── Public interface ──────────────────────────────────────────────────────────
+
+void BuildBenchWidget::setCompilerId(const QString& id) {
+    m_compilerId = id;
+    if (!m_userPickedCompilers) rebuildCompilerMenu();
+}
+
+void BuildBenchWidget::setStandard(const QString& standard) {
+    m_standard = standard;
+    if (m_userPickedStandards) return;
+    for (QAction* action : m_standardMenu->actions()) {
+        action->setChecked(action->text() == standard);
+    }
+}
+
+// ── Run ──────────────────────────────────────────────────────────────────────
+
+void BuildBenchWidget::runBench() {
+    BuildBenchConfig config;
+    for (int i = 0; i < m_snippetTabs->count(); ++i) {
+        auto* editor = qobject_cast<QsciScintilla*>(m_snippetTabs->widget(i));
+        if (!editor) continue;
+        config.snippets.append({ m_snippetTabs->tabText(i), editor->text() });
+    }
+    config.compilerIds        = checkedItems(m_compilerMenu);
+    config.standards          = checkedItems(m_standardMenu);
+    config.optimizationLevels = checkedItems(m_optMenu);
+    config.repetitions        = m_repsSpin->value();
+    config.parallel           = m_parallelCheck->isChecked();
+
+    if (config.compilerIds.isEmpty() || config.standards.isEmpty()
+        || config.optimizationLevels.isEmpty()) {
+        m_statusLabel->setText(QStringLiteral("Select at least one compiler, standard and -O level."));
+        return;
+    }
+
+    m_cases.clear();
+    refreshTable();
+    if (!m_runner->start(config)) {
+        return;   // The runner reported why via progressMessage
+    }
+    m_runButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
+    m_progressBar->setVisible(true);
+}
+
+void BuildBenchWidget::stopBench() {
+    m_runner->cancel();
+}
+
+// ── Slots — runner ────────────────────────────────────────────────────────────
+
+void BuildBenchWidget::onProgressChanged(int completed, int total) {
+    m_progressBar->setRange(0, total);
+    m_progressBar->setValue(completed);
+}
+
+void BuildBenchWidget::onCaseFinished(const BuildBenchCase& result) {
+    m_cases.append(result);
+    refreshTable();
+}
+
+void BuildBenchWidget::onBenchFinished(const QList<BuildBenchCase>& cases, bool cancelled) {
+    m_runButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+    m_progressBar->setVisible(false);
+
+    // Final list carries the speedups; on cancel keep only cases that completed
+    if (!cancelled) {
+        m_cases = cases;
+    } else {
+        QList<BuildBenchCase> completed;
+        for (const BuildBenchCase& c : cases) {
+            if (c.wallMs.count > 0 || !c.success) completed << c;
+        }
+        BuildBenchRunner::computeSpeedups(completed);
+        m_cases = completed;
+    }
+    refreshTable();
+    refreshChart();
+}
+
+// ── Views ─────────────────────────────────────────────────────────────────────
+
+void BuildBenchWidget::refreshTable() {
+    m_tableWidget->setRowCount(m_cases.size());
+    for (int row = 0; row < m_cases.size(); ++row) {
+        const BuildBenchCase& c = m_cases[row];
+        auto set = [&](int column, const QString& text) {
+            auto* item = new QTableWidgetItem(text);
+            if (column >= WallColumn) item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            m_tableWidget->setItem(row, column, item);
+            return item;
+        };
+        set(SnippetColumn, c.snippet);
+        set(ConfigColumn, c.configurationLabel());
+        if (!c.success) {
+            QTableWidgetItem* item = set(WallColumn, QStringLiteral("failed"));
+            item->setForeground(ThemeManager::instance()->currentTheme().error);
+            item->setToolTip(c.errorMessage);
+            for (int col = CpuColumn; col < TableColumnCount; ++col) set(col, QString());
+            continue;
+        }
+        set(WallColumn, meanAndStddev(c.wallMs));
+        set(CpuColumn,  meanAndStddev(c.cpuMs));
+        set(RssColumn,  meanAndStddev(c.peakRssMb));
+        set(SpeedupColumn, c.speedup > 0 ? QStringLiteral("%1×").arg(c.speedup, 0, 'f', 2)
+                                         : QStringLiteral("…"));
+        set(RunsColumn, QString::number(c.samples.size()));
+    }
+    m_tableWidget->resizeColumnsToContents();
+    m_tableWidget->horizontalHeader()->setSectionResizeMode(ConfigColumn, QHeaderView::Stretch);
+}
+
+void BuildBenchWidget::refreshChart() {
+    if (m_cases.isEmpty()) return;
+
+    const auto metric = static_cast<Metric>(m_metricCombo->currentData().toInt());
+
+    // Categories = configurations, one bar group per snippet
+    QStringList categories;
+    QStringList snippets;
+    for (const BuildBenchCase& c : m_cases) {
+        if (!categories.contains(c.configurationLabel())) categories << c.configurationLabel();
+        if (!snippets.contains(c.snippet)) snippets << c.snippet;
+    }
+
+    QList<BenchmarkChartWidget::BarGroup> groups;
+    for (const QString& snippet : snippets) {
+        BenchmarkChartWidget::BarGroup group;
+        group.label = snippet;
+        for (const QString& config : categories) {
+            double value = 0;
+            for (const BuildBenchCase& c : m_cases) {
+                if (c.snippet != snippet || c.configurationLabel() != config || !c.success) continue;
+                switch (metric) {
+                case Metric::WallTime: value = c.wallMs.mean;    break;
+                case Metric::CpuTime:  value = c.cpuMs.mean;     break;
+                case Metric::PeakRss:  value = c.peakRssMb.mean; break;
+                case Metric::Speedup:  value = c.speedup;        break;
+                }
+            }
+            group.values << value;
+        }
+        groups << group;
+    }
+
+    m_chartWidget->showGroupedBars(categories, groups,
+                                   QStringLiteral("Build Bench — ") + m_metricCombo->currentText(),
+                                   m_metricCombo->currentText());
+}
+
+// ── Theme / settings ─────────────────────────────────────────────────────────
+
+void BuildBenchWidget::applyThemeToEditor(QsciScintilla* editor) {
+    Theme theme = ThemeManager::instance()->currentTheme();
+    auto* lexer = qobject_cast<QsciLexerCPP*>(editor->lexer());
+    if (lexer) {
+        lexer->setDefaultPaper(theme.editorBackground);
+        lexer->setDefaultColor(theme.editorForeground);
+        for (int s = 0; s <= 128; ++s) {
+            lexer->setPaper(theme.editorBackground, s);
+            lexer->setColor(theme.editorForeground, s);
+        }
+        lexer->setColor(theme.syntaxKeyword,      QsciLexerCPP::Keyword);
+        lexer->setColor(theme.syntaxType,         QsciLexerCPP::KeywordSet2);
+        lexer->setColor(theme.syntaxString,       QsciLexerCPP::DoubleQuotedString);
+        lexer->setColor(theme.syntaxString,       QsciLexerCPP::SingleQuotedString);
+        lexer->setColor(theme.syntaxComment,      QsciLexerCPP::Comment);
+        lexer->setColor(theme.syntaxComment,      QsciLexerCPP::CommentLine);
+        lexer->setColor(theme.syntaxComment,      QsciLexerCPP::CommentDoc);
+        lexer->setColor(theme.syntaxPreprocessor, QsciLexerCPP::PreProcessor);
+        lexer->setColor(theme.syntaxNumber,       QsciLexerCPP::Number);
+        lexer->setColor(theme.syntaxFunction,     QsciLexerCPP::Operator);
+    }
+    editor->setPaper(theme.editorBackground);
+    editor->setColor(theme.editorForeground);
+    editor->setCaretLineVisible(true);
+    editor->setCaretLineBackgroundColor(theme.editorCurrentLine);
+    editor->setCaretForegroundColor(theme.cursorColor);
+    editor->setSelectionBackgroundColor(theme.accent);
+    editor->setSelectionForegroundColor(theme.editorForeground);
+    editor->setMarginsBackgroundColor(theme.sidebarBackground);
+    editor->setMarginsForegroundColor(theme.textSecondary);
+    editor->setFoldMarginColors(theme.sidebarBackground, theme.sidebarBackground);
+    editor->recolor();
+}
+
+void BuildBenchWidget::onThemeChanged(const QString& themeName) {
+    Q_UNUSED(themeName);
+    for (int i = 0; i < m_snippetTabs->count(); ++i) {
+        if (auto* editor = qobject_cast<QsciScintilla*>(m_snippetTabs->widget(i)))
+            applyThemeToEditor(editor);
+    }
+    refreshTable();
+}
+
+void BuildBenchWidget::applyEditorSettings(const QFont& font, bool showLineNumbers, bool wordWrap) {
+    for (int i = 0; i < m_snippetTabs->count(); ++i) {
+        auto* editor = qobject_cast<QsciScintilla*>(m_snippetTabs->widget(i));
+        if (!editor) continue;
+        editor->setFont(font);
+        editor->setMarginsFont(font);
+        if (auto* lexer = qobject_cast<QsciLexerCPP*>(editor->lexer())) {
+            lexer->setDefaultFont(font);
+            for (int style = 0; style < 128; ++style)
+                lexer->setFont(font, style);
+        }
+        editor->setMarginLineNumbers(0, showLineNumbers);
+        editor->setMarginWidth(0, showLineNumbers ? QStringLiteral("00000") : QStringLiteral("0"));
+        editor->setWrapMode(wordWrap ? QsciScintilla::WrapWord : QsciScintilla::WrapNone);
+    }
+}
@@ -0,0 +1,403 @@
+#include "ui/CompileProfileWidget.h"
+#include "ui/FlameChartWidget.h"
+
+#include <QColor>
+#include <QComboBox>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHash>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QScrollArea>
+#include <QSignalBlocker>
+#include <QSplitter>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QTextStream>
+#include <QUuid>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace {
+
+enum TableColumn {
+    NameColumn,
+    TimeColumn,
+    CountColumn,
+    BaselineTimeColumn,
+    DeltaColumn,
+    TableColumnCount
+};
+
+QTableWidgetItem* numberItem(double value, const QString& text) {
+    auto* item = new QTableWidgetItem;
+    item->setData(Qt::DisplayRole, value);   // Numeric sort
+    item->setData(Qt::ToolTipRole, text);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+QScrollArea* wrapInScrollArea(QWidget* child, QWidget* parent) {
+    auto* scroll = new QScrollArea(parent);
+    scroll->setWidgetResizable(true);
+    scroll->setWidget(child);
+    return scroll;
+}
+
+} // namespace
+
+CompileProfileWidget::CompileProfileWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_runner(new CompileProfileRunner(this))
+{
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
+    setupUi();
+
+    connect(m_runner, &CompileProfileRunner::started,
+            this, &CompileProfileWidget::onRunnerStarted);
+    connect(m_runner, &CompileProfileRunner::finished,
+            this, &CompileProfileWidget::onRunnerFinished);
+    connect(m_runner, &CompileProfileRunner::progressMessage,
+            this, &CompileProfileWidget::onProgressMessage);
+    connect(m_runner, &CompileProfileRunner::profileReady,
+            this, &CompileProfileWidget::onProfileReady);
+}
+
+CompileProfileWidget::~CompileProfileWidget() {
+    if (!m_tempSourceFile.isEmpty()) {
+        QFile::remove(m_tempSourceFile);
+    }
+}
+
+// ── UI setup ──────────────────────────────────────────────────────────────────
+
+void CompileProfileWidget::setupUi() {
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    mainLayout->setSpacing(0);
+
+    // --- Toolbar ---
+    auto* toolbar = new QWidget(this);
+    auto* tbLayout = new QHBoxLayout(toolbar);
+    tbLayout->setContentsMargins(6, 4, 6, 4);
+
+    tbLayout->addWidget(new QLabel(QStringLiteral("Opt:"), toolbar));
+    m_optimizationCombo = new QComboBox(toolbar);
+    m_optimizationCombo->addItems({ "O0", "O1", "O2", "O3", "Os" });
+    m_optimizationCombo->setCurrentText(QStringLiteral("O0"));
+    tbLayout->addWidget(m_optimizationCombo);
+
+    tbLayout->addSpacing(8);
+
+    tbLayout->addWidget(new QLabel(QStringLiteral("Compare with:"), toolbar));
+    m_compareCombo = new QComboBox(toolbar);
+    m_compareCombo->setMinimumContentsLength(18);
+    m_compareCombo->setToolTip(QStringLiteral("Show an earlier run next to the latest one"));
+    connect(m_compareCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &CompileProfileWidget::onCompareChanged);
+    tbLayout->addWidget(m_compareCombo);
+
+    tbLayout->addStretch();
+
+    m_runButton = new QPushButton(QStringLiteral("▶  Profile Compile"), toolbar);
+    m_runButton->setToolTip(QStringLiteral(
+        "Compile the current file with -ftime-trace (Clang) or "
+        "-ftime-report -H (GCC) and show where compile time goes"));
+    connect(m_runButton, &QPushButton::clicked, this, &CompileProfileWidget::runProfile);
+    tbLayout->addWidget(m_runButton);
+
+    m_stopButton = new QPushButton(QStringLiteral("■ Stop"), toolbar);
+    m_stopButton->setEnabled(false);
+    connect(m_stopButton, &QPushButton::clicked, this, &CompileProfileWidget::stopProcess);
+    tbLayout->addWidget(m_stopButton);
+
+    m_statusLabel = new QLabel(QStringLiteral("Ready"), toolbar);
+    m_statusLabel->setMinimumWidth(260);
+    tbLayout->addWidget(m_statusLabel);
+
+    mainLayout->addWidget(toolbar);
+
+    // --- Result tabs ---
+    m_tabs = new QTabWidget(this);
+
+    auto* flameSplitter = new QSplitter(Qt::Vertical, m_tabs);
+    m_currentChart = new FlameChartWidget;
+    m_currentChart->setCaption(QStringLiteral("Latest run"));
+    flameSplitter->addWidget(wrapInScrollArea(m_currentChart, flameSplitter));
+    m_baselineChart = new FlameChartWidget;
+    m_baselineScroll = wrapInScrollArea(m_baselineChart, flameSplitter);
+    m_baselineScroll->setVisible(false);
+    flameSplitter->addWidget(m_baselineScroll);
+    m_tabs->addTab(flameSplitter, QStringLiteral("Flame Chart"));
+
+    auto makeTable = [this]() {
+        auto* table = new QTableWidget(0, TableColumnCount, m_tabs);
+        table->setHorizontalHeaderLabels({ QStringLiteral("Name"),
+                                           QStringLiteral("Time (ms)"),
+                                           QStringLiteral("Count"),
+                                           QStringLiteral("Baseline (ms)"),
+                                           QStringLiteral("Δ (ms)") });
+        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+        table->setSelectionBehavior(QAbstractItemView::SelectRows);
+        table->setAlternatingRowColors(true);
+        table->verticalHeader()->setVisible(false);
+        table->horizontalHeader()->setSectionResizeMode(NameColumn, QHeaderView::Stretch);
+        table->setColumnHidden(BaselineTimeColumn, true);
+        table->setColumnHidden(DeltaColumn, true);
+        return table;
+    };
+    m_headersTable   = makeTable();
+    m_templatesTable = makeTable();
+    m_functionsTable = makeTable();
+    m_phasesTable    = makeTable();
+    m_tabs->addTab(m_headersTable,   QStringLiteral("Headers"));
+    m_tabs->addTab(m_templatesTable, QStringLiteral("Templates"));
+    m_tabs->addTab(m_functionsTable, QStringLiteral("Functions"));
+    m_tabs->addTab(m_phasesTable,    QStringLiteral("Phases"));
+
+    m_rawView = new QPlainTextEdit(m_tabs);
+    m_rawView->setReadOnly(true);
+    m_rawView->setLineWrapMode(QPlainTextEdit::NoWrap);
+    m_rawView->setFont(QFont(QStringLiteral("Monospace"), 9));
+    m_tabs->addTab(m_rawView, QStringLiteral("Raw"));
+
+    mainLayout->addWidget(m_tabs, 1);
+
+    rebuildCompareCombo();
+}
+
+// ── Public interface ──────────────────────────────────────────────────────────
+
+void CompileProfileWidget::setCompilerId(const QString& id) {
+    m_compilerId = id;
+    m_runner->setCompilerId(id);
+}
+
+void CompileProfileWidget::setStandard(const QString& standard) {
+    m_standard = standard;
+}
+
+void CompileProfileWidget::setSourceCode(const QString& code, const QString& filePath) {
+    m_currentSourceCode = code;
+    m_currentFilePath   = filePath;
+    if (m_runButton->isEnabled()) {
+        m_statusLabel->setText(QStringLiteral("Ready — press Profile Compile"));
+    }
+}
+
+// ── Run ──────────────────────────────────────────────────────────────────────
+
+void CompileProfileWidget::runProfile() {
+    if (m_currentSourceCode.isEmpty()) {
+        m_statusLabel->setText(QStringLiteral("No source code loaded."));
+        return;
+    }
+    if (!m_runner->isAvailable()) {
+        m_statusLabel->setText(QStringLiteral("No compiler available — configure in toolbar."));
+        return;
+    }
+
+    // Profile the editor buffer, not the file on disk
+    QString uuid = QUuid::createUuid().toString().remove('{').remove('}').remove('-');
+    QString tmpPath = QDir::tempPath()
+                      + QStringLiteral("/cppatlas_profile_")
+                      + uuid
+                      + QStringLiteral(".cpp");
+
+    QFile tmpFile(tmpPath);
+    if (!tmpFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        m_statusLabel->setText(QStringLiteral("Failed to create temp file."));
+        return;
+    }
+    {
+        QTextStream out(&tmpFile);
+        out << m_currentSourceCode;
+    }
+    tmpFile.close();
+    m_tempSourceFile = tmpPath;
+
+    QStringList flags;
+    flags << QStringLiteral("-std=") + m_standard;
+    flags << QStringLiteral("-") + m_optimizationCombo->currentText();
+    // Quoted includes still resolve against the real file's directory
+    if (!m_currentFilePath.isEmpty()) {
+        flags << QStringLiteral("-iquote") << QFileInfo(m_currentFilePath).absolutePath();
+    }
+
+    m_runner->setCompilerId(m_compilerId);
+    m_runButton->setEnabled(false);
+    m_runner->run(tmpPath, flags);
+}
+
+void CompileProfileWidget::stopProcess() {
+    m_runner->cancel();
+    if (!m_tempSourceFile.isEmpty()) {
+        QFile::remove(m_tempSourceFile);
+        m_tempSourceFile.clear();
+    }
+    m_runButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+    m_statusLabel->setText(QStringLiteral("Stopped."));
+}
+
+// ── Slots — runner ────────────────────────────────────────────────────────────
+
+void CompileProfileWidget::onRunnerStarted() {
+    m_statusLabel->setText(QStringLiteral("Profiling compilation…"));
+    m_stopButton->setEnabled(true);
+    m_runButton->setEnabled(false);
+}
+
+void CompileProfileWidget::onProgressMessage(const QString& msg) {
+    m_statusLabel->setText(msg);
+}
+
+void CompileProfileWidget::onRunnerFinished(bool success, const QString& output,
+                                            const QString& error) {
+    Q_UNUSED(output);
+    if (!m_tempSourceFile.isEmpty()) {
+        QFile::remove(m_tempSourceFile);
+        m_tempSourceFile.clear();
+    }
+    m_runButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+
+    if (!success) {
+        m_rawView->setPlainText(error);
+        m_statusLabel->setText(QStringLiteral("Error: ") + error.section('\n', 0, 0));
+    }
+}
+
+void CompileProfileWidget::onProfileReady(const CompileProfile& profile) {
+    CompileProfile run = profile;
+    run.label = QStringLiteral("#%1  %2  -%3  %4")
+                    .arg(++m_runCounter)
+                    .arg(QDateTime::currentDateTime().toString(QStringLiteral("HH:mm:ss")),
+                         m_optimizationCombo->currentText(),
+                         profile.compilerId);
+
+    m_history.append(run);
+    while (m_history.size() > MAX_HISTORY) {
+        m_history.removeFirst();
+    }
+
+    rebuildCompareCombo();
+    refreshViews();
+
+    m_statusLabel->setText(QStringLiteral("Done in %1 ms — %2 spans")
+                               .arg(run.wallTimeUs / 1000)
+                               .arg(run.events.size()));
+}
+
+void CompileProfileWidget::onCompareChanged(int index) {
+    Q_UNUSED(index);
+    refreshViews();
+}
+
+// ── Views ─────────────────────────────────────────────────────────────────────
+
+void CompileProfileWidget::rebuildCompareCombo() {
+    const QString previous = m_compareCombo->currentData().toString();
+
+    QSignalBlocker blocker(m_compareCombo);
+    m_compareCombo->clear();
+    m_compareCombo->addItem(QStringLiteral("(none)"), QString());
+    // The newest run is always the one being inspected
+    for (int i = m_history.size() - 2; i >= 0; --i) {
+        m_compareCombo->addItem(m_history[i].label, m_history[i].label);
+    }
+    const int restored = m_compareCombo->findData(previous);
+    m_compareCombo->setCurrentIndex(restored >= 0 ? restored : 0);
+    m_compareCombo->setEnabled(m_history.size() > 1);
+}
+
+const CompileProfile* CompileProfileWidget::baselineProfile() const {
+    const QString label = m_compareCombo->currentData().toString();
+    if (label.isEmpty()) return nullptr;
+    for (const CompileProfile& p : m_history) {
+        if (p.label == label) return &p;
+    }
+    return nullptr;
+}
+
+void CompileProfileWidget::refreshViews() {
+    if (m_history.isEmpty()) return;
+
+    const CompileProfile& current = m_history.last();
+    const CompileProfile* baseline = baselineProfile();
+
+    m_currentChart->setCaption(QStringLiteral("Latest run %1 — %2 ms")
+                                   .arg(current.label)
+                                   .arg(current.wallTimeUs / 1000));
+    m_currentChart->setProfile(current);
+
+    m_baselineScroll->setVisible(baseline != nullptr);
+    if (baseline) {
+        m_baselineChart->setCaption(QStringLiteral("Baseline %1 — %2 ms")
+                                        .arg(baseline->label)
+                                        .arg(baseline->wallTimeUs / 1000));
+        m_baselineChart->setProfile(*baseline);
+    } else {
+        m_baselineChart->clear();
+    }
+
+    fillTable(m_headersTable,   current.headers,   baseline ? &baseline->headers   : nullptr);
+    fillTable(m_templatesTable, current.templates, baseline ? &baseline->templates : nullptr);
+    fillTable(m_functionsTable, current.functions, baseline ? &baseline->functions : nullptr);
+    fillTable(m_phasesTable,    current.phases,    baseline ? &baseline->phases    : nullptr);
+
+    // GCC headers carry include counts, not time; label the column accordingly
+    m_headersTable->horizontalHeaderItem(CountColumn)->setText(
+        current.unit == CompileProfile::Unit::Headers ? QStringLiteral("Headers pulled in")
+                                                      : QStringLiteral("Count"));
+
+    m_rawView->setPlainText(current.rawOutput);
+}
+
+void CompileProfileWidget::fillTable(QTableWidget* table,
+                                     const QList<CompileProfileEntry>& entries,
+                                     const QList<CompileProfileEntry>* baseline) {
+    QHash<QString, qint64> baselineUs;
+    if (baseline) {
+        for (const CompileProfileEntry& e : *baseline) {
+            baselineUs.insert(e.name, e.totalUs);
+        }
+    }
+
+    table->setSortingEnabled(false);
+    const int rows = std::min<int>(entries.size(), MAX_TABLE_ROWS);
+    table->setRowCount(rows);
+    for (int row = 0; row < rows; ++row) {
+        const CompileProfileEntry& e = entries[row];
+        auto* nameItem = new QTableWidgetItem(e.name);
+        nameItem->setToolTip(e.name);
+        table->setItem(row, NameColumn, nameItem);
+        table->setItem(row, TimeColumn,
+                       numberItem(e.totalUs / 1000.0, QStringLiteral("%1 µs").arg(e.totalUs)));
+        table->setItem(row, CountColumn,
+                       numberItem(e.count, QString::number(e.count)));
+
+        if (baseline) {
+            const bool known = baselineUs.contains(e.name);
+            const qint64 baseUs = baselineUs.value(e.name);
+            table->setItem(row, BaselineTimeColumn,
+                           known ? numberItem(baseUs / 1000.0, QStringLiteral("%1 µs").arg(baseUs))
+                                 : new QTableWidgetItem(QStringLiteral("—")));
+            auto* delta = numberItem((e.totalUs - baseUs) / 1000.0,
+                                     known ? QStringLiteral("%1 µs").arg(e.totalUs - baseUs)
+                                           : QStringLiteral("Not in baseline"));
+            if (e.totalUs > baseUs) delta->setForeground(QColor("#F44747"));
+            else if (e.totalUs < baseUs) delta->setForeground(QColor("#4EC9B0"));
+            table->setItem(row, DeltaColumn, delta);
+        }
+    }
+    table->setColumnHidden(BaselineTimeColumn, baseline == nullptr);
+    table->setColumnHidden(DeltaColumn, baseline == nullptr);
+    table->setSortingEnabled(true);
+}
@@ -0,0 +1,191 @@
+#include "ui/FlameChartWidget.h"
+#include "ui/ThemeManager.h"
+
+#include <QFileInfo>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <QWheelEvent>
+
+#include <algorithm>
+
+FlameChartWidget::FlameChartWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setMouseTracking(true);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+
+    connect(ThemeManager::instance(), &ThemeManager::themeChanged,
+            this, [this]() { update(); });
+}
+
+void FlameChartWidget::setProfile(const CompileProfile& profile) {
+    m_events = profile.events;
+    m_unit   = profile.unit;
+    m_total  = 0;
+    m_maxDepth = 0;
+    for (const CompileProfileEvent& e : m_events) {
+        m_total    = std::max(m_total, e.start + e.duration);
+        m_maxDepth = std::max(m_maxDepth, e.depth);
+    }
+    resetZoom();
+    updateGeometry();
+    setMinimumHeight(sizeHint().height());
+}
+
+void FlameChartWidget::setCaption(const QString& caption) {
+    m_caption = caption;
+    update();
+}
+
+void FlameChartWidget::clear() {
+    setProfile(CompileProfile());
+}
+
+void FlameChartWidget::resetZoom() {
+    m_viewStart = 0;
+    m_viewSpan  = std::max<qint64>(m_total, 1);
+    update();
+}
+
+QSize FlameChartWidget::sizeHint() const {
+    return QSize(400, HEADER_HEIGHT + (m_maxDepth + 1) * ROW_HEIGHT + 4);
+}
+
+// ── Geometry ──────────────────────────────────────────────────────────────────
+
+QRectF FlameChartWidget::eventRect(const CompileProfileEvent& e) const {
+    const double scale = width() / m_viewSpan;
+    const double x = (e.start - m_viewStart) * scale;
+    const double w = e.duration * scale;
+    return QRectF(x, HEADER_HEIGHT + e.depth * ROW_HEIGHT, w, ROW_HEIGHT - 1);
+}
+
+int FlameChartWidget::eventAt(const QPoint& pos) const {
+    // Deepest match wins so the innermost span under the cursor is reported
+    int found = -1;
+    for (int i = 0; i < m_events.size(); ++i) {
+        const QRectF r = eventRect(m_events[i]);
+        if (r.contains(pos) && (found < 0 || m_events[i].depth > m_events[found].depth)) {
+            found = i;
+        }
+    }
+    return found;
+}
+
+QString FlameChartWidget::formatCost(qint64 value) const {
+    if (m_unit == CompileProfile::Unit::Headers) {
+        return value == 1 ? QStringLiteral("1 header") : QStringLiteral("%1 headers").arg(value);
+    }
+    if (value >= 1000000) return QStringLiteral("%1 s").arg(value / 1e6, 0, 'f', 2);
+    if (value >= 1000)    return QStringLiteral("%1 ms").arg(value / 1e3, 0, 'f', 1);
+    return QStringLiteral("%1 µs").arg(value);
+}
+
+// static
+QColor FlameChartWidget::colorForEvent(const CompileProfileEvent& e) {
+    if (e.name == QLatin1String("Source"))
+        return QColor("#4E79A7");
+    if (e.name.startsWith(QLatin1String("Instantiate")))
+        return QColor("#F28E2B");
+    if (e.name.contains(QLatin1String("Function")))
+        return QColor("#59A14F");
+    if (e.name.startsWith(QLatin1String("Parse")))
+        return QColor("#76B7B2");
+    return QColor("#9C755F");
+}
+
+// ── Painting ──────────────────────────────────────────────────────────────────
+
+void FlameChartWidget::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    const Theme theme = ThemeManager::instance()->currentTheme();
+
+    QPainter painter(this);
+    painter.fillRect(rect(), theme.editorBackground);
+
+    // Caption and visible range
+    painter.setPen(theme.textSecondary);
+    QString header = m_caption;
+    if (m_total > 0) {
+        header += QStringLiteral("   [%1 – %2]")
+                      .arg(formatCost(static_cast<qint64>(m_viewStart)),
+                           formatCost(static_cast<qint64>(m_viewStart + m_viewSpan)));
+    } else {
+        header += QStringLiteral("   (no profile)");
+    }
+    painter.drawText(QRect(4, 0, width() - 8, HEADER_HEIGHT),
+                     Qt::AlignVCenter | Qt::AlignLeft, header.trimmed());
+
+    const QFontMetrics fm(font());
+    for (const CompileProfileEvent& e : m_events) {
+        QRectF r = eventRect(e);
+        if (r.right() < 0 || r.left() > width() || r.width() < 0.5) continue;
+        r.setLeft(std::max(0.0, r.left()));
+        r.setRight(std::min<double>(width(), r.right()));
+
+        painter.fillRect(r, colorForEvent(e));
+        if (r.width() > 24) {
+            const QString label = e.detail.isEmpty()
+                ? e.name
+                : (e.name == QLatin1String("Source") ? QFileInfo(e.detail).fileName() : e.detail);
+            painter.setPen(Qt::white);
+            painter.drawText(r.adjusted(3, 0, -3, 0), Qt::AlignVCenter | Qt::AlignLeft,
+                             fm.elidedText(label, Qt::ElideRight, static_cast<int>(r.width()) - 6));
+        }
+    }
+}
+
+// ── Interaction ───────────────────────────────────────────────────────────────
+
+void FlameChartWidget::mouseMoveEvent(QMouseEvent* event) {
+    const int index = eventAt(event->pos());
+    if (index < 0) {
+        QToolTip::hideText();
+        return;
+    }
+    const CompileProfileEvent& e = m_events[index];
+    QString tip = QStringLiteral("<b>%1</b>").arg(e.name.toHtmlEscaped());
+    if (!e.detail.isEmpty()) {
+        tip += QStringLiteral("<br>%1").arg(e.detail.toHtmlEscaped());
+    }
+    tip += QStringLiteral("<br>%1").arg(formatCost(e.duration));
+    if (m_total > 0) {
+        tip += QStringLiteral(" (%1%)").arg(100.0 * e.duration / m_total, 0, 'f', 1);
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QToolTip::showText(event->globalPosition().toPoint(), tip, this);
+#else
+    QToolTip::showText(event->globalPos(), tip, this);
+#endif
+}
+
+void FlameChartWidget::mouseDoubleClickEvent(QMouseEvent* event) {
+    const int index = eventAt(event->pos());
+    if (index < 0) {
+        resetZoom();
+        return;
+    }
+    const CompileProfileEvent& e = m_events[index];
+    m_viewStart = e.start;
+    m_viewSpan  = std::max<qint64>(e.duration, 1);
+    update();
+}
+
+void FlameChartWidget::wheelEvent(QWheelEvent* event) {
+    if (m_total <= 0) return;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    const double cursorX = event->position().x();
+#else
+    const double cursorX = event->pos().x();
+#endif
+    const double anchor = m_viewStart + cursorX / std::max(1, width()) * m_viewSpan;
+    const double factor = event->angleDelta().y() > 0 ? 0.8 : 1.25;
+
+    m_viewSpan  = std::clamp(m_viewSpan * factor, 1.0, static_cast<double>(m_total));
+    m_viewStart = anchor - cursorX / std::max(1, width()) * m_viewSpan;
+    m_viewStart = std::clamp(m_viewStart, 0.0, std::max(0.0, m_total - m_viewSpan));
+    update();
+    event->accept();
+}
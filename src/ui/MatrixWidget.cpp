@@ -0,0 +1,450 @@
+#include "ui/MatrixWidget.h"
+#include "ui/BenchmarkChartWidget.h"
+#include "ui/ThemeManager.h"
+#include "compiler/CompilerRegistry.h"
+
+#include <QAction>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMenu>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSignalBlocker>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QToolButton>
+#include <QVBoxLayout>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+enum TableColumn {
+    CompilerColumn,
+    StandardColumn,
+    OptColumn,
+    MarchColumn,
+    CompileColumn,
+    AsmColumn,
+    InstructionsColumn,
+    FunctionsColumn,
+    BenchmarkColumn,
+    TableColumnCount
+};
+
+const char* const kDefaultMarch = "(default)";
+
+// Numbers go in as DisplayRole doubles so the grid sorts numerically
+QTableWidgetItem* numberItem(double value, int precision) {
+    auto* item = new QTableWidgetItem;
+    const double scale = std::pow(10.0, precision);
+    item->setData(Qt::DisplayRole, std::round(value * scale) / scale);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+} // namespace
+
+MatrixWidget::MatrixWidget(QWidget* parent)
+    : QWidget(parent)
+    , m_runner(new MatrixRunner(this))
+{
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
+    setupUi();
+
+    connect(m_runner, &MatrixRunner::progressMessage,
+            m_statusLabel, &QLabel::setText);
+    connect(m_runner, &MatrixRunner::progressChanged,
+            this, &MatrixWidget::onProgressChanged);
+    connect(m_runner, &MatrixRunner::cellUpdated,
+            this, &MatrixWidget::onCellUpdated);
+    connect(m_runner, &MatrixRunner::finished,
+            this, &MatrixWidget::onMatrixFinished);
+
+    connect(&CompilerRegistry::instance(), &CompilerRegistry::compilersChanged,
+            this, &MatrixWidget::rebuildCompilerMenu);
+    connect(ThemeManager::instance(), &ThemeManager::themeChanged,
+            this, &MatrixWidget::onThemeChanged);
+}
+
+// ── UI setup ──────────────────────────────────────────────────────────────────
+
+void MatrixWidget::setupUi() {
+    auto* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(0, 0, 0, 0);
+    mainLayout->setSpacing(0);
+
+    auto* toolbar = new QWidget(this);
+    setupToolbar(toolbar);
+    mainLayout->addWidget(toolbar);
+
+    // --- Metric / benchmark selection, shared by grid and chart ---
+    auto* selectRow = new QWidget(this);
+    auto* selectLayout = new QHBoxLayout(selectRow);
+    selectLayout->setContentsMargins(6, 0, 6, 4);
+    selectLayout->addWidget(new QLabel(QStringLiteral("Metric:"), selectRow));
+    m_metricCombo = new QComboBox(selectRow);
+    m_metricCombo->addItem(QStringLiteral("Compile time (ms)"),  int(Metric::CompileTime));
+    m_metricCombo->addItem(QStringLiteral("Assembly size (KB)"), int(Metric::AsmSize));
+    m_metricCombo->addItem(QStringLiteral("Instructions"),       int(Metric::Instructions));
+    m_metricCombo->addItem(QStringLiteral("Benchmark time (ns)"), int(Metric::BenchmarkTime));
+    connect(m_metricCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MatrixWidget::refreshChart);
+    selectLayout->addWidget(m_metricCombo);
+    selectLayout->addSpacing(12);
+    selectLayout->addWidget(new QLabel(QStringLiteral("Benchmark:"), selectRow));
+    m_benchmarkCombo = new QComboBox(selectRow);
+    m_benchmarkCombo->setMinimumWidth(160);
+    m_benchmarkCombo->setToolTip(QStringLiteral("Which benchmark the Benchmark column and chart show"));
+    connect(m_benchmarkCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
+        refreshTable();
+        refreshChart();
+    });
+    selectLayout->addWidget(m_benchmarkCombo);
+    selectLayout->addStretch();
+    mainLayout->addWidget(selectRow);
+
+    // --- Results ---
+    m_resultsTabs = new QTabWidget(this);
+
+    m_tableWidget = new QTableWidget(0, TableColumnCount, m_resultsTabs);
+    m_tableWidget->setHorizontalHeaderLabels({ QStringLiteral("Compiler"),
+                                               QStringLiteral("Standard"),
+                                               QStringLiteral("Opt"),
+                                               QStringLiteral("-march"),
+                                               QStringLiteral("Compile (ms)"),
+                                               QStringLiteral("Asm (KB)"),
+                                               QStringLiteral("Instructions"),
+                                               QStringLiteral("Functions"),
+                                               QStringLiteral("Benchmark (ns)") });
+    m_tableWidget->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_tableWidget->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_tableWidget->setAlternatingRowColors(true);
+    m_tableWidget->setSortingEnabled(true);
+    m_tableWidget->verticalHeader()->setVisible(false);
+    m_resultsTabs->addTab(m_tableWidget, QStringLiteral("Grid"));
+
+    m_chartWidget = new BenchmarkChartWidget(m_resultsTabs);
+    m_resultsTabs->addTab(m_chartWidget, QStringLiteral("Chart"));
+
+    mainLayout->addWidget(m_resultsTabs, 1);
+}
+
+void MatrixWidget::setupToolbar(QWidget* toolbar) {
+    auto* tbLayout = new QHBoxLayout(toolbar);
+    tbLayout->setContentsMargins(6, 4, 6, 4);
+
+    tbLayout->addWidget(makeMenuButton(QStringLiteral("Compilers"), toolbar, &m_compilerMenu));
+    connect(m_compilerMenu, &QMenu::triggered, this, [this]() { m_userPickedCompilers = true; });
+    rebuildCompilerMenu();
+
+    tbLayout->addWidget(makeMenuButton(QStringLiteral("Standards"), toolbar, &m_standardMenu));
+    addCheckableItems(m_standardMenu, { "c++11", "c++14", "c++17", "c++20", "c++23" }, { m_standard });
+    connect(m_standardMenu, &QMenu::triggered, this, [this]() { m_userPickedStandards = true; });
+
+    tbLayout->addWidget(makeMenuButton(QStringLiteral("Opt"), toolbar, &m_optMenu));
+    addCheckableItems(m_optMenu, { "O0", "O1", "O2", "O3", "Os" }, { "O2", "O3" });
+
+    tbLayout->addWidget(makeMenuButton(QStringLiteral("-march"), toolbar, &m_marchMenu));
+    addCheckableItems(m_marchMenu,
+                      { kDefaultMarch, "x86-64", "x86-64-v2", "x86-64-v3", "x86-64-v4", "native" },
+                      { kDefaultMarch, "native" });
+
+    tbLayout->addSpacing(8);
+    m_benchmarkCheck = new QCheckBox(QStringLiteral("Benchmarks"), toolbar);
+    m_benchmarkCheck->setChecked(true);
+    m_benchmarkCheck->setToolTip(QStringLiteral(
+        "For Google Benchmark sources, also link and run every cell.\n"
+        "Benchmarks run one at a time after all compiles have finished."));
+    tbLayout->addWidget(m_benchmarkCheck);
+
+    tbLayout->addStretch();
+
+    m_runButton = new QPushButton(QStringLiteral("▶  Run Matrix"), toolbar);
+    m_runButton->setToolTip(QStringLiteral(
+        "Build the current file under every selected compiler, standard,\n"
+        "-O level and -march target, in parallel"));
+    connect(m_runButton, &QPushButton::clicked, this, &MatrixWidget::runMatrix);
+    tbLayout->addWidget(m_runButton);
+
+    m_stopButton = new QPushButton(QStringLiteral("■ Stop"), toolbar);
+    m_stopButton->setEnabled(false);
+    connect(m_stopButton, &QPushButton::clicked, this, &MatrixWidget::stopMatrix);
+    tbLayout->addWidget(m_stopButton);
+
+    m_progressBar = new QProgressBar(toolbar);
+    m_progressBar->setMaximumWidth(120);
+    m_progressBar->setTextVisible(false);
+    m_progressBar->setVisible(false);
+    tbLayout->addWidget(m_progressBar);
+
+    m_statusLabel = new QLabel(QStringLiteral("Ready"), toolbar);
+    m_statusLabel->setMinimumWidth(200);
+    tbLayout->addWidget(m_statusLabel);
+}
+
+// static
+QToolButton* MatrixWidget::makeMenuButton(const QString& text, QWidget* parent, QMenu** menu) {
+    auto* button = new QToolButton(parent);
+    button->setText(text);
+    button->setPopupMode(QToolButton::InstantPopup);
+    *menu = new QMenu(button);
+    button->setMenu(*menu);
+    return button;
+}
+
+// static
+void MatrixWidget::addCheckableItems(QMenu* menu, const QStringList& items,
+                                     const QStringList& checked) {
+    for (const QString& item : items) {
+        QAction* action = menu->addAction(item);
+        action->setCheckable(true);
+        action->setChecked(checked.contains(item));
+    }
+}
+
+// static
+QStringList MatrixWidget::checkedItems(const QMenu* menu) {
+    QStringList items;
+    for (const QAction* action : menu->actions()) {
+        if (action->isChecked()) items << action->text();
+    }
+    return items;
+}
+
+void MatrixWidget::rebuildCompilerMenu() {
+    QStringList checked = checkedItems(m_compilerMenu);
+    if (!m_userPickedCompilers && !m_compilerId.isEmpty()) {
+        checked = { m_compilerId };
+    }
+    m_compilerMenu->clear();
+
+    QStringList ids;
+    for (const auto& compiler : CompilerRegistry::instance().getAvailableCompilers()) {
+        ids << compiler->id();
+    }
+    if (checked.isEmpty() && !ids.isEmpty()) {
+        checked << (ids.contains(CompilerRegistry::instance().defaultCompilerId())
+                        ? CompilerRegistry::instance().defaultCompilerId()
+                        : ids.first());
+    }
+    addCheckableItems(m_compilerMenu, ids, checked);
+}
+
+// ── Public interface ──────────────────────────────────────────────────────────
+
+void MatrixWidget::setSourceCode(const QString& code, const QString& filePath) {
+    m_currentSourceCode = code;
+    m_currentFilePath   = filePath;
+}
+
+void MatrixWidget::setCompilerId(const QString& id) {
+    m_compilerId = id;
+    if (!m_userPickedCompilers) rebuildCompilerMenu();
+}
+
+void MatrixWidget::setStandard(const QString& standard) {
+    m_standard = standard;
+    if (m_userPickedStandards) return;
+    for (QAction* action : m_standardMenu->actions()) {
+        action->setChecked(action->text() == standard);
+    }
+}
+
+// ── Run ──────────────────────────────────────────────────────────────────────
+
+void MatrixWidget::runMatrix() {
+    if (m_currentSourceCode.trimmed().isEmpty()) {
+        m_statusLabel->setText(QStringLiteral("No source code loaded."));
+        return;
+    }
+
+    MatrixConfig config;
+    config.sourceCode         = m_currentSourceCode;
+    config.compilerIds        = checkedItems(m_compilerMenu);
+    config.standards          = checkedItems(m_standardMenu);
+    config.optimizationLevels = checkedItems(m_optMenu);
+    config.runBenchmarks      = m_benchmarkCheck->isChecked();
+    for (const QString& march : checkedItems(m_marchMenu)) {
+        config.marchTargets << (march == QLatin1String(kDefaultMarch) ? QString() : march);
+    }
+    // Quoted includes still resolve against the real file's directory
+    if (!m_currentFilePath.isEmpty()) {
+        config.includeDir = QFileInfo(m_currentFilePath).absolutePath();
+    }
+
+    if (config.compilerIds.isEmpty() || config.standards.isEmpty()
+        || config.optimizationLevels.isEmpty() || config.marchTargets.isEmpty()) {
+        m_statusLabel->setText(QStringLiteral("Select at least one compiler, standard, -O level and -march."));
+        return;
+    }
+
+    if (!m_runner->start(config)) {
+        return;   // The runner reported why via progressMessage
+    }
+    m_cells = m_runner->cells();
+    refreshBenchmarkNames();
+    refreshTable();
+    m_runButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
+    m_progressBar->setVisible(true);
+}
+
+void MatrixWidget::stopMatrix() {
+    m_runner->cancel();
+}
+
+// ── Slots — runner ────────────────────────────────────────────────────────────
+
+void MatrixWidget::onProgressChanged(int completed, int total) {
+    m_progressBar->setRange(0, total);
+    m_progressBar->setValue(completed);
+}
+
+void MatrixWidget::onCellUpdated(int index, const MatrixCell& cell) {
+    if (index < 0 || index >= m_cells.size()) return;
+    m_cells[index] = cell;
+    if (cell.benchmarkRan) refreshBenchmarkNames();
+    refreshTable();
+}
+
+void MatrixWidget::onMatrixFinished(const QList<MatrixCell>& cells, bool cancelled) {
+    Q_UNUSED(cancelled);
+    m_runButton->setEnabled(true);
+    m_stopButton->setEnabled(false);
+    m_progressBar->setVisible(false);
+
+    m_cells = cells;
+    refreshBenchmarkNames();
+    refreshTable();
+    refreshChart();
+}
+
+// ── Views ─────────────────────────────────────────────────────────────────────
+
+void MatrixWidget::refreshBenchmarkNames() {
+    QStringList names;
+    for (const MatrixCell& cell : m_cells) {
+        for (const BenchmarkEntry& e : cell.benchmark.benchmarks) {
+            if (!names.contains(e.name)) names << e.name;
+        }
+    }
+
+    const QString current = m_benchmarkCombo->currentText();
+    QSignalBlocker blocker(m_benchmarkCombo);
+    m_benchmarkCombo->clear();
+    m_benchmarkCombo->addItems(names);
+    const int idx = names.indexOf(current);
+    m_benchmarkCombo->setCurrentIndex(idx >= 0 ? idx : 0);
+    m_benchmarkCombo->setEnabled(!names.isEmpty());
+}
+
+double MatrixWidget::metricValue(const MatrixCell& cell, Metric metric) const {
+    if (!cell.success) return -1;
+    switch (metric) {
+    case Metric::CompileTime:   return cell.compileMs;
+    case Metric::AsmSize:       return cell.asmStats.bytes / 1024.0;
+    case Metric::Instructions:  return cell.asmStats.instructions;
+    case Metric::BenchmarkTime: return cell.benchmarkNs(m_benchmarkCombo->currentText());
+    }
+    return -1;
+}
+
+void MatrixWidget::refreshTable() {
+    const Theme theme = ThemeManager::instance()->currentTheme();
+
+    // Sorting while inserting would move rows under our feet
+    m_tableWidget->setSortingEnabled(false);
+    m_tableWidget->setRowCount(m_cells.size());
+    for (int row = 0; row < m_cells.size(); ++row) {
+        const MatrixCell& c = m_cells[row];
+        m_tableWidget->setItem(row, CompilerColumn, new QTableWidgetItem(c.compilerId));
+        m_tableWidget->setItem(row, StandardColumn, new QTableWidgetItem(c.standard));
+        m_tableWidget->setItem(row, OptColumn,      new QTableWidgetItem(c.optimization));
+        m_tableWidget->setItem(row, MarchColumn,    new QTableWidgetItem(c.marchLabel()));
+
+        if (!c.success) {
+            const bool pending = c.errorMessage.isEmpty();
+            auto* item = new QTableWidgetItem(pending ? QStringLiteral("…") : QStringLiteral("failed"));
+            if (!pending) {
+                item->setForeground(theme.error);
+                item->setToolTip(c.errorMessage);
+            }
+            m_tableWidget->setItem(row, CompileColumn, item);
+            for (int col = AsmColumn; col < TableColumnCount; ++col) {
+                m_tableWidget->setItem(row, col, new QTableWidgetItem);
+            }
+            continue;
+        }
+
+        m_tableWidget->setItem(row, CompileColumn,      numberItem(c.compileMs, 1));
+        m_tableWidget->setItem(row, AsmColumn,          numberItem(c.asmStats.bytes / 1024.0, 1));
+        m_tableWidget->setItem(row, InstructionsColumn, numberItem(c.asmStats.instructions, 0));
+        m_tableWidget->setItem(row, FunctionsColumn,    numberItem(c.asmStats.functions, 0));
+
+        const double ns = c.benchmarkNs(m_benchmarkCombo->currentText());
+        if (ns >= 0) {
+            m_tableWidget->setItem(row, BenchmarkColumn, numberItem(ns, 2));
+        } else {
+            QString text;
+            if (!c.benchmarkError.isEmpty())      text = QStringLiteral("failed");
+            else if (c.benchmarkRequested && !c.benchmarkRan) text = QStringLiteral("…");
+            auto* item = new QTableWidgetItem(text);
+            if (!c.benchmarkError.isEmpty()) {
+                item->setForeground(theme.error);
+                item->setToolTip(c.benchmarkError);
+            }
+            m_tableWidget->setItem(row, BenchmarkColumn, item);
+        }
+    }
+    m_tableWidget->setSortingEnabled(true);
+    m_tableWidget->resizeColumnsToContents();
+}
+
+void MatrixWidget::refreshChart() {
+    if (m_cells.isEmpty()) return;
+
+    const auto metric = static_cast<Metric>(m_metricCombo->currentData().toInt());
+
+    // Categories = flag sets, one bar group per compiler
+    QStringList categories;
+    QStringList compilers;
+    for (const MatrixCell& c : m_cells) {
+        if (!categories.contains(c.flagsLabel())) categories << c.flagsLabel();
+        if (!compilers.contains(c.compilerId)) compilers << c.compilerId;
+    }
+
+    QList<BenchmarkChartWidget::BarGroup> groups;
+    for (const QString& compiler : compilers) {
+        BenchmarkChartWidget::BarGroup group;
+        group.label = compiler;
+        for (const QString& flags : categories) {
+            double value = 0;
+            for (const MatrixCell& c : m_cells) {
+                if (c.compilerId == compiler && c.flagsLabel() == flags) {
+                    value = std::max(0.0, metricValue(c, metric));
+                }
+            }
+            group.values << value;
+        }
+        groups << group;
+    }
+
+    QString title = QStringLiteral("Matrix — ") + m_metricCombo->currentText();
+    if (metric == Metric::BenchmarkTime && !m_benchmarkCombo->currentText().isEmpty()) {
+        title += QStringLiteral(" — ") + m_benchmarkCombo->currentText();
+    }
+    m_chartWidget->showGroupedBars(categories, groups, title, m_metricCombo->currentText());
+}
+
+// ── Theme ─────────────────────────────────────────────────────────────────────
+
+void MatrixWidget::onThemeChanged(const QString& themeName) {
+    Q_UNUSED(themeName);
+    refreshTable();
+}
@@ -0,0 +1,162 @@
+#include "ui/QuickBenchWidget.h"
+
+#include <Qsci/qsciscintilla.h>
+#include <Qsci/qscilexercpp.h>
+
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSplitter>
+#include <QToolButton>
+#include <QVBoxLayout>
+
+QuickBenchWidget::QuickBenchWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    auto* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(4, 4, 4, 4);
+    layout->setSpacing(4);
+
+    // ── Header ────────────────────────────────────────────────────────────────
+    auto* hdrRow = new QHBoxLayout();
+    m_addButton = new QPushButton(QStringLiteral("+ Snippet"), this);
+    m_addButton->setToolTip(QStringLiteral("Add a snippet pane (up to %1)").arg(QuickBench::MAX_SNIPPETS));
+    connect(m_addButton, &QPushButton::clicked, this, [this]() {
+        addSnippet(nextName(), QString());
+    });
+    hdrRow->addWidget(m_addButton);
+    auto* hint = new QLabel(
+        QStringLiteral("Each snippet runs once per iteration; <b>return</b> the value it computes "
+                       "so it cannot be optimised away.  A snippet that returns nothing is only "
+                       "warned about: its work may still be removed.  Ratios are against the first "
+                       "snippet."),
+        this);
+    hint->setWordWrap(true);
+    hdrRow->addWidget(hint, 1);
+    layout->addLayout(hdrRow);
+
+    // ── Setup above, snippets side by side below ──────────────────────────────
+    auto* splitter = new QSplitter(Qt::Vertical, this);
+
+    auto* setupPane   = new QWidget(splitter);
+    auto* setupLayout = new QVBoxLayout(setupPane);
+    setupLayout->setContentsMargins(0, 0, 0, 0);
+    setupLayout->setSpacing(2);
+    setupLayout->addWidget(new QLabel(
+        QStringLiteral("Setup — untimed, runs before every snippet; #include lines go to file scope"),
+        setupPane));
+    m_setupEditor = createEditor(setupPane);
+    setupLayout->addWidget(m_setupEditor, 1);
+    splitter->addWidget(setupPane);
+
+    m_snippetSplitter = new QSplitter(Qt::Horizontal, splitter);
+    splitter->addWidget(m_snippetSplitter);
+    splitter->setStretchFactor(0, 1);
+    splitter->setStretchFactor(1, 2);
+    layout->addWidget(splitter, 1);
+
+    m_setupEditor->setText(QStringLiteral(
+        "#include <numeric>\n"
+        "#include <vector>\n\n"
+        "std::vector<int> v(1000, 1);\n"));
+    addSnippet(QStringLiteral("Accumulate"),
+               QStringLiteral("return std::accumulate(v.begin(), v.end(), 0);\n"));
+    addSnippet(QStringLiteral("Loop"),
+               QStringLiteral("int sum = 0;\n"
+                              "for (int x : v) sum += x;\n"
+                              "return sum;\n"));
+}
+
+QString QuickBenchWidget::setup() const {
+    return m_setupEditor->text();
+}
+
+QList<QuickBenchSnippet> QuickBenchWidget::snippets() const {
+    QList<QuickBenchSnippet> result;
+    for (const Pane& pane : m_panes)
+        result << QuickBenchSnippet{ pane.nameEdit->text().trimmed(), pane.editor->text() };
+    return result;
+}
+
+QList<QsciScintilla*> QuickBenchWidget::editors() const {
+    QList<QsciScintilla*> result{ m_setupEditor };
+    for (const Pane& pane : m_panes) result << pane.editor;
+    return result;
+}
+
+void QuickBenchWidget::addSnippet(const QString& name, const QString& code) {
+    if (m_panes.size() >= QuickBench::MAX_SNIPPETS) return;
+
+    Pane pane;
+    pane.frame = new QWidget(m_snippetSplitter);
+    auto* layout = new QVBoxLayout(pane.frame);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(2);
+
+    auto* nameRow = new QHBoxLayout();
+    pane.nameEdit = new QLineEdit(name, pane.frame);
+    pane.nameEdit->setPlaceholderText(QStringLiteral("Name"));
+    pane.nameEdit->setToolTip(QStringLiteral("Shown in the results; the benchmark is BM_<name>"));
+    nameRow->addWidget(pane.nameEdit, 1);
+    pane.removeButton = new QToolButton(pane.frame);
+    pane.removeButton->setText(QStringLiteral("✕"));
+    pane.removeButton->setToolTip(QStringLiteral("Remove this snippet"));
+    QWidget* frame = pane.frame;
+    connect(pane.removeButton, &QToolButton::clicked, this, [this, frame]() { removeSnippet(frame); });
+    nameRow->addWidget(pane.removeButton);
+    layout->addLayout(nameRow);
+
+    pane.editor = createEditor(pane.frame);
+    pane.editor->setText(code);
+    layout->addWidget(pane.editor, 1);
+
+    m_snippetSplitter->addWidget(pane.frame);
+    m_panes << pane;
+    updateButtons();
+    emit editorAdded(pane.editor);
+}
+
+QsciScintilla* QuickBenchWidget::createEditor(QWidget* parent) const {
+    auto* editor = new QsciScintilla(parent);
+    auto* lexer  = new QsciLexerCPP(editor);
+    lexer->setDefaultFont(QFont(QStringLiteral("Monospace"), 10));
+    editor->setLexer(lexer);
+    editor->setTabWidth(4);
+    editor->setIndentationsUseTabs(false);
+    editor->setAutoIndent(true);
+    editor->setMarginType(0, QsciScintilla::NumberMargin);
+    editor->setMarginWidth(0, QStringLiteral("000"));
+    editor->setWrapMode(QsciScintilla::WrapWord);
+    editor->SendScintilla(QsciScintilla::SCI_SETHSCROLLBAR, 0);
+    return editor;
+}
+
+void QuickBenchWidget::removeSnippet(QWidget* frame) {
+    if (m_panes.size() <= QuickBench::MIN_SNIPPETS) return;
+    for (int i = 0; i < m_panes.size(); ++i) {
+        if (m_panes[i].frame != frame) continue;
+        m_panes.removeAt(i);
+        frame->deleteLater();
+        break;
+    }
+    updateButtons();
+}
+
+void QuickBenchWidget::updateButtons() {
+    m_addButton->setEnabled(m_panes.size() < QuickBench::MAX_SNIPPETS);
+    for (const Pane& pane : m_panes)
+        pane.removeButton->setEnabled(m_panes.size() > QuickBench::MIN_SNIPPETS);
+}
+
+QString QuickBenchWidget::nextName() const {
+    // First letter no pane is named after yet
+    for (char c = 'A'; c <= 'Z'; ++c) {
+        const QString name(QLatin1Char(c));
+        bool taken = false;
+        for (const Pane& pane : m_panes)
+            taken = taken || pane.nameEdit->text().trimmed() == name;
+        if (!taken) return name;
+    }
+    return QStringLiteral("Snippet%1").arg(m_panes.size() + 1);
+}
@@ -0,0 +1,187 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "compiler/CompileJob.h"
+#include "compiler/CompileJobQueue.h"
+
+class CompileJobTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("The fake compiler is a shell script");
+#endif
+        QVERIFY(m_dir.isValid());
+        // Stands in for a compiler: "ok" and "fail" exit at once, anything
+        // else keeps a child running until it is killed
+        m_compiler = m_dir.filePath("fake-compiler");
+        QFile script(m_compiler);
+        QVERIFY(script.open(QIODevice::WriteOnly));
+        script.write("#!/bin/sh\n"
+                     "case \"$1\" in\n"
+                     "  ok) exit 0 ;;\n"
+                     "  fail) echo 'x.cpp:1:1: error: boom' >&2; exit 1 ;;\n"
+                     "esac\n"
+                     "sleep 30\n");
+        script.close();
+        QVERIFY(script.setPermissions(script.permissions() | QFileDevice::ExeOwner));
+        m_savedMaxJobs = CompileJobQueue::instance().maxConcurrentJobs();
+    }
+
+    void cleanupTestCase()
+    {
+        CompileJobQueue::instance().setMaxConcurrentJobs(m_savedMaxJobs);
+    }
+
+    void cleanup()
+    {
+        // Killed processes hold their slot until reaped; start every test empty
+        QTRY_COMPARE_WITH_TIMEOUT(CompileJobQueue::instance().runningCount(), 0, 5000);
+        QCOMPARE(CompileJobQueue::instance().pendingCount(), 0);
+    }
+
+    // ── Concurrency ──────────────────────────────────────────────────────────
+
+    void concurrencyBoundHolds()
+    {
+        CompileJobQueue& queue = CompileJobQueue::instance();
+        queue.setMaxConcurrentJobs(2);
+        int peak = 0;
+        QMetaObject::Connection watch = connect(&queue, &CompileJobQueue::activityChanged,
+                                                this, [&peak](int running, int) {
+            peak = qMax(peak, running);
+        });
+
+        QObject owner;
+        QList<CompileJob*> jobs;
+        int started = 0;
+        int finished = 0;
+        for (int i = 0; i < 4; ++i) {
+            CompileJob* job = makeJob("sleep", &owner);
+            connect(job, &CompileJob::started, this, [&started]() { ++started; });
+            connect(job, &CompileJob::finished, this, [&finished](const CompileResult&) { ++finished; });
+            jobs.append(job);
+            job->start();
+        }
+        QCOMPARE(started, 2);
+        QCOMPARE(queue.runningCount(), 2);
+        QCOMPARE(queue.pendingCount(), 2);
+        QCOMPARE(jobs[2]->state(), CompileJob::State::Queued);
+
+        // Each cancelled job lets exactly one waiting job in, never more
+        jobs[0]->cancel();
+        QTRY_COMPARE(started, 3);
+        jobs[1]->cancel();
+        QTRY_COMPARE(started, 4);
+        jobs[2]->cancel();
+        jobs[3]->cancel();
+        QTRY_COMPARE(finished, 4);
+        disconnect(watch);
+        QVERIFY(peak <= 2);
+    }
+
+    // ── Cancellation ─────────────────────────────────────────────────────────
+
+    void cancelFreesTheSlot()
+    {
+        CompileJobQueue::instance().setMaxConcurrentJobs(1);
+        QObject owner;
+        CompileJob* running = makeJob("sleep", &owner);
+        CompileJob* waiting = makeJob("sleep", &owner);
+        CompileResult cancelled;
+        connect(running, &CompileJob::finished, this, [&cancelled](const CompileResult& result) {
+            cancelled = result;
+        });
+        running->start();
+        waiting->start();
+        QCOMPARE(waiting->state(), CompileJob::State::Queued);
+
+        running->cancel();
+        QTRY_COMPARE(waiting->state(), CompileJob::State::Running);
+        QVERIFY(cancelled.cancelled);
+        QVERIFY(!cancelled.success);
+        QCOMPARE(CompileJobQueue::instance().runningCount(), 1);
+        QCOMPARE(CompileJobQueue::instance().pendingCount(), 0);
+
+        waiting->cancel();
+    }
+
+    void destroyingACancelledJobDoesNotBlock()
+    {
+        CompileJobQueue::instance().setMaxConcurrentJobs(1);
+        QObject owner;
+        CompileJob* closing = makeJob("sleep", &owner);
+        CompileJob* waiting = makeJob("sleep", &owner);
+        closing->start();
+        waiting->start();
+
+        // Cancel, then close the tab before the compiler has been reaped
+        closing->cancel();
+        QElapsedTimer timer;
+        timer.start();
+        delete closing;
+        QVERIFY2(timer.elapsed() < 50, qPrintable(QString::number(timer.elapsed())));
+
+        // The killed process keeps the slot until it is gone
+        QCOMPARE(waiting->state(), CompileJob::State::Queued);
+        QCOMPARE(CompileJobQueue::instance().runningCount(), 1);
+        QTRY_COMPARE(waiting->state(), CompileJob::State::Running);
+
+        waiting->cancel();
+    }
+
+    // ── Build && Run ─────────────────────────────────────────────────────────
+
+    void runIsChainedOnlyOnSuccess_data()
+    {
+        QTest::addColumn<QString>("mode");
+        QTest::addColumn<bool>("cancel");
+        QTest::addColumn<bool>("runs");
+
+        QTest::newRow("succeeded") << "ok" << false << true;
+        QTest::newRow("failed") << "fail" << false << false;
+        QTest::newRow("cancelled") << "sleep" << true << false;
+    }
+
+    void runIsChainedOnlyOnSuccess()
+    {
+        QFETCH(QString, mode);
+        QFETCH(bool, cancel);
+        QFETCH(bool, runs);
+
+        CompileJobQueue::instance().setMaxConcurrentJobs(2);
+        QObject owner;
+        CompileJob* job = makeJob(mode, &owner);
+        bool finished = false;
+        bool ran = false;
+        connect(job, &CompileJob::finished, this, [&finished](const CompileResult&) {
+            finished = true;
+        });
+        job->whenSucceeded(&owner, [&ran]() { ran = true; });
+
+        job->start();
+        if (cancel) job->cancel();
+        QTRY_VERIFY(finished);
+        QCOMPARE(job->result().success, runs);
+        QCOMPARE(ran, runs);
+    }
+
+private:
+    CompileJob* makeJob(const QString& mode, QObject* owner) const
+    {
+        CompileRequest request;
+        request.sourceFile = m_dir.filePath("x.cpp");
+        request.outputFile = m_dir.filePath("x");
+        return new CompileJob(m_compiler, { mode }, request,
+                              DiagnosticStreamParser::Format::Text, owner);
+    }
+
+    QTemporaryDir m_dir;
+    QString m_compiler;
+    int m_savedMaxJobs = 1;
+};
+
+QTEST_MAIN(CompileJobTest)
+#include "test_compile_job.moc"
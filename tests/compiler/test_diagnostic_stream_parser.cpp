@@ -0,0 +1,140 @@
+#include <QtTest/QtTest>
+#include "compiler/DiagnosticStreamParser.h"
+
+class DiagnosticStreamParserTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // ── Text ─────────────────────────────────────────────────────────────────
+
+    void notesAndContextAreGrouped()
+    {
+        const QList<DiagnosticMessage> diags = DiagnosticStreamParser::parseText(
+            "a.cpp: In instantiation of 'void f(T) [with T = int]':\n"
+            "a.cpp:10:6:   required from here\n"
+            "a.cpp:5:3: error: no match for 'operator+'\n"
+            "    5 |   t + t;\n"
+            "      |   ~~^~~\n"
+            "a.cpp:5:3: note: candidate: 'X operator+(X, X)'\n"
+            "a.cpp:12:1: warning: unused variable 'y' [-Wunused-variable]\n");
+
+        QCOMPARE(diags.size(), 2);
+        QCOMPARE(diags[0].severity, DiagnosticMessage::Error);
+        QCOMPARE(diags[0].line, 5);
+        QCOMPARE(diags[0].message, QString("no match for 'operator+'"));
+        QCOMPARE(diags[0].children.size(), 3);
+        QVERIFY(diags[0].children[0].message.startsWith("In instantiation of"));
+        QCOMPARE(diags[0].children[1].line, 10);
+        QCOMPARE(diags[0].children[1].message, QString("required from here"));
+        QCOMPARE(diags[0].children[2].severity, DiagnosticMessage::Note);
+        QCOMPARE(diags[1].severity, DiagnosticMessage::Warning);
+        QVERIFY(diags[1].children.isEmpty());
+    }
+
+    void windowsDriveLetterIsKept()
+    {
+        const QList<DiagnosticMessage> diags = DiagnosticStreamParser::parseText(
+            "C:\\src\\main.cpp:3:7: fatal error: foo.h: No such file or directory\n");
+        QCOMPARE(diags.size(), 1);
+        QCOMPARE(diags[0].file, QString("C:\\src\\main.cpp"));
+        QCOMPARE(diags[0].severity, DiagnosticMessage::Error);
+    }
+
+    void chunksSplitMidLine()
+    {
+        DiagnosticStreamParser parser;
+        QList<DiagnosticMessage> diags = parser.feed("main.cpp:1:5: err");
+        QVERIFY(diags.isEmpty());
+        diags += parser.feed("or: first\nmain.cpp:2:1: error: second\n");
+        QCOMPARE(diags.size(), 1);   // "second" may still collect notes
+        diags += parser.finish();
+        QCOMPARE(diags.size(), 2);
+        QCOMPARE(diags[0].message, QString("first"));
+        QCOMPARE(diags[1].message, QString("second"));
+    }
+
+    // ── GCC JSON ─────────────────────────────────────────────────────────────
+
+    void gccJsonElementsStream()
+    {
+        DiagnosticStreamParser parser(DiagnosticStreamParser::Format::GccJson);
+        const QByteArray first =
+            R"([{"kind": "error", "message": "expected ';' {here}", "option": "",)"
+            R"( "locations": [{"caret": {"file": "a.cpp", "line": 3, "column": 9}}],)"
+            R"( "children": [{"kind": "note", "message": "see \"x\"",)"
+            R"( "locations": [{"caret": {"file": "a.h", "line": 1, "column": 1}}]}]})";
+
+        QList<DiagnosticMessage> diags = parser.feed(first.left(40));
+        QVERIFY(diags.isEmpty());
+        diags = parser.feed(first.mid(40));
+        QCOMPARE(diags.size(), 1);   // Reported before the array is closed
+        QCOMPARE(diags[0].message, QString("expected ';' {here}"));
+        QCOMPARE(diags[0].line, 3);
+        QCOMPARE(diags[0].children.size(), 1);
+        QCOMPARE(diags[0].children[0].message, QString("see \"x\""));
+
+        diags = parser.feed(R"(, {"kind": "warning", "message": "w", "option": "-Wall", "locations": []}])" "\n"
+                            "collect2: error: ld returned 1 exit status\n");
+        diags += parser.finish();
+        QCOMPARE(diags.size(), 1);
+        QCOMPARE(diags[0].code, QString("-Wall"));
+        QVERIFY(parser.takePassthroughText().contains("collect2"));
+    }
+
+    void malformedJsonFallsBackToText()
+    {
+        DiagnosticStreamParser parser(DiagnosticStreamParser::Format::GccJson);
+        QList<DiagnosticMessage> diags = parser.feed("[{\"kind\": \"error\", \"message\": ");
+        diags += parser.finish();
+        QVERIFY(diags.isEmpty());
+        QVERIFY(parser.takePassthroughText().contains("\"kind\""));
+    }
+
+    // ── SARIF ────────────────────────────────────────────────────────────────
+
+    void sarifResults()
+    {
+        DiagnosticStreamParser parser(DiagnosticStreamParser::Format::Sarif);
+        QList<DiagnosticMessage> diags = parser.feed(
+            "{\n  \"version\": \"2.1.0\",\n  \"runs\": [{\"results\": [\n"
+            "    {\"level\": \"error\", \"ruleId\": \"1\", \"message\": {\"text\": \"bad\"},\n"
+            "     \"locations\": [{\"physicalLocation\": {\"artifactLocation\": {\"uri\": \"file:///p/a.cpp\"},\n"
+            "                     \"region\": {\"startLine\": 4, \"startColumn\": 2}}}]},\n"
+            "    {\"level\": \"note\", \"message\": {\"text\": \"declared here\"}, \"locations\": []}\n"
+            "  ]}]\n}\n");
+        diags += parser.finish();
+
+        QCOMPARE(diags.size(), 1);
+        QCOMPARE(diags[0].file, QString("/p/a.cpp"));
+        QCOMPARE(diags[0].line, 4);
+        QCOMPARE(diags[0].column, 2);
+        QCOMPARE(diags[0].children.size(), 1);
+        QCOMPARE(diags[0].children[0].message, QString("declared here"));
+    }
+
+    // ── Formatting ───────────────────────────────────────────────────────────
+
+    void formattedTextRoundTrips()
+    {
+        DiagnosticMessage error;
+        error.severity = DiagnosticMessage::Error;
+        error.file = "a.cpp";
+        error.line = 2;
+        error.column = 4;
+        error.message = "boom";
+        DiagnosticMessage note = error;
+        note.severity = DiagnosticMessage::Note;
+        note.message = "because";
+        error.children.append(note);
+
+        const QList<DiagnosticMessage> reparsed = DiagnosticStreamParser::parseText(
+            DiagnosticStreamParser::formatDiagnostic(error));
+        QCOMPARE(reparsed.size(), 1);
+        QCOMPARE(reparsed[0].message, QString("boom"));
+        QCOMPARE(reparsed[0].children.size(), 1);
+    }
+};
+
+QTEST_MAIN(DiagnosticStreamParserTest)
+#include "test_diagnostic_stream_parser.moc"
@@ -0,0 +1,185 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "compiler/CompilerRegistry.h"
+#include "compiler/ICompiler.h"
+#include "compiler/ProjectBuilder.h"
+#include "core/Project.h"
+
+class ProjectBuilderTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        CompilerRegistry::instance().autoScanCompilers();
+    }
+
+    // ── Incremental builds ───────────────────────────────────────────────────
+
+    void rebuildsOnlyWhatChanged()
+    {
+        const QSharedPointer<ICompiler> compiler = CompilerRegistry::instance().getCompiler(
+            CompilerRegistry::instance().defaultCompilerId());
+        if (!compiler || !compiler->isAvailable()) QSKIP("No compiler available");
+
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        writeFile(dir.filePath("util.h"), "int twice(int x);\n");
+        writeFile(dir.filePath("util.cpp"), "int twice(int x) { return 2 * x; }\n");
+        writeFile(dir.filePath("main.cpp"),
+                  "#include \"util.h\"\nint main() { return twice(0); }\n");
+        // Sources well in the past, so objects built now are clearly newer
+        for (const QString& name : { "util.h", "util.cpp", "main.cpp" }) {
+            QVERIFY(setModified(dir.filePath(name), QDateTime::currentDateTime().addSecs(-60)));
+        }
+
+        Project project;
+        project.setName("incremental");
+        project.setDirectory(dir.path());
+        project.addSourceFile("main.cpp");
+        project.addSourceFile("util.cpp");
+        const QString objects = ProjectBuilder::objectDirectoryFor(&project);
+        const QString mainObject = objects + "/main.cpp.o";
+        const QString utilObject = objects + "/util.cpp.o";
+
+        BuildRun first = runBuild(project, compiler);
+        QVERIFY2(first.success, qPrintable(first.output));
+        QCOMPARE(first.recompiled, 2);
+        QVERIFY(!first.linkSkipped);
+        QVERIFY(QFileInfo::exists(ProjectBuilder::executablePathFor(&project)));
+
+        // Nothing changed: no compile, no link
+        const QDateTime utilTime = QFileInfo(utilObject).lastModified();
+        BuildRun second = runBuild(project, compiler);
+        QVERIFY2(second.success, qPrintable(second.output));
+        QCOMPARE(second.recompiled, 0);
+        QVERIFY(second.linkSkipped);
+
+        // A touched header recompiles only the unit including it, then relinks
+        QTest::qWait(20);
+        QVERIFY(setModified(dir.filePath("util.h"), QDateTime::currentDateTime()));
+        BuildRun third = runBuild(project, compiler);
+        QVERIFY2(third.success, qPrintable(third.output));
+        QCOMPARE(third.recompiled, 1);
+        QVERIFY(!third.linkSkipped);
+        QCOMPARE(QFileInfo(utilObject).lastModified(), utilTime);
+        QVERIFY(QFileInfo(mainObject).lastModified() > utilTime);
+
+        // Other flags, other command: the .cmd stamps no longer match
+        const QByteArray stamp = readFile(mainObject + ".cmd");
+        BuildRun fourth = runBuild(project, compiler, { "-DCPPATLAS_REBUILD" });
+        QVERIFY2(fourth.success, qPrintable(fourth.output));
+        QCOMPARE(fourth.recompiled, 2);
+        QVERIFY(!fourth.linkSkipped);
+        QVERIFY(readFile(mainObject + ".cmd") != stamp);
+    }
+
+    // ── Dependency file parsing ──────────────────────────────────────────────
+
+    void singleLineRule()
+    {
+        const QStringList deps = ProjectBuilder::parseDependencyFile(
+            "build/obj/main.cpp.o: /p/main.cpp /p/util.h\n");
+        QCOMPARE(deps, QStringList({"/p/main.cpp", "/p/util.h"}));
+    }
+
+    void lineContinuations()
+    {
+        const QStringList deps = ProjectBuilder::parseDependencyFile(
+            "main.o: /p/main.cpp \\\n /p/a.h \\\n  /p/b.h\n");
+        QCOMPARE(deps, QStringList({"/p/main.cpp", "/p/a.h", "/p/b.h"}));
+    }
+
+    void crlfContinuations()
+    {
+        const QStringList deps = ProjectBuilder::parseDependencyFile(
+            "main.o: /p/main.cpp \\\r\n /p/a.h\r\n");
+        QCOMPARE(deps, QStringList({"/p/main.cpp", "/p/a.h"}));
+    }
+
+    void escapedSpacesInPaths()
+    {
+        const QStringList deps = ProjectBuilder::parseDependencyFile(
+            "main.o: /my\\ project/main.cpp /my\\ project/a.h\n");
+        QCOMPARE(deps, QStringList({"/my project/main.cpp", "/my project/a.h"}));
+    }
+
+    void targetWithWindowsDrive()
+    {
+        // The drive colon must not be mistaken for the rule separator
+        const QStringList deps = ProjectBuilder::parseDependencyFile(
+            "C:/p/build/main.o: C:/p/main.cpp\n");
+        QCOMPARE(deps, QStringList({"C:/p/main.cpp"}));
+    }
+
+    void phonyHeaderRulesAddNothing()
+    {
+        const QStringList deps = ProjectBuilder::parseDependencyFile(
+            "main.o: main.cpp a.h\n\na.h:\n");
+        QCOMPARE(deps, QStringList({"main.cpp", "a.h"}));
+    }
+
+    void emptyInput()
+    {
+        QVERIFY(ProjectBuilder::parseDependencyFile(QString()).isEmpty());
+    }
+
+private:
+    struct BuildRun {
+        bool success = false;
+        int recompiled = -1;        // From "Build finished: N of M files recompiled"
+        bool linkSkipped = false;
+        QString output;
+    };
+
+    // Builds @p project to the end; up-to-date builds finish inside build()
+    BuildRun runBuild(const Project& project, const QSharedPointer<ICompiler>& compiler,
+                      const QStringList& extraFlags = QStringList())
+    {
+        static const QRegularExpression summary("^Build finished: (\\d+) of");
+        BuildRun run;
+        bool done = false;
+        ProjectBuilder builder;
+        connect(&builder, &ProjectBuilder::progressMessage, this, [&run](const QString& message) {
+            const QRegularExpressionMatch match = summary.match(message);
+            if (match.hasMatch()) run.recompiled = match.captured(1).toInt();
+        });
+        connect(&builder, &ProjectBuilder::outputReceived, this, [&run](const QString& text, bool) {
+            run.output += text;
+            if (text.contains("is up to date")) run.linkSkipped = true;
+        });
+        connect(&builder, &ProjectBuilder::finished, this,
+                [&run, &done](const CompileResult& result) {
+                    run.success = result.success;
+                    run.output += result.rawError;
+                    done = true;
+                });
+        if (!builder.build(&project, compiler, "c++17", extraFlags)) return run;
+        QTest::qWaitFor([&done]() { return done; }, 60000);
+        return run;
+    }
+
+    static void writeFile(const QString& path, const QByteArray& contents)
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(contents);
+    }
+
+    static bool setModified(const QString& path, const QDateTime& time)
+    {
+        QFile file(path);
+        return file.open(QIODevice::ReadWrite)
+               && file.setFileTime(time, QFileDevice::FileModificationTime);
+    }
+
+    static QByteArray readFile(const QString& path)
+    {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+};
+
+QTEST_MAIN(ProjectBuilderTest)
+#include "test_project_builder.moc"
@@ -0,0 +1,128 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "compiler/ToolchainDiscovery.h"
+
+class ToolchainDiscoveryTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        // Keep the real probe cache out of the way
+        QStandardPaths::setTestModeEnabled(true);
+        ToolchainDiscovery::instance().clear();
+    }
+
+    // ── File names ───────────────────────────────────────────────────────────
+
+    void compilerFileNames_data()
+    {
+        QTest::addColumn<QString>("fileName");
+        QTest::addColumn<bool>("matches");
+        QTest::addColumn<QString>("family");
+        QTest::addColumn<QString>("suffix");
+
+        QTest::newRow("g++")          << "g++"            << true  << "gcc"   << "";
+        QTest::newRow("g++-13")       << "g++-13"         << true  << "gcc"   << "13";
+        QTest::newRow("clang++-18")   << "clang++-18"     << true  << "clang" << "18";
+        QTest::newRow("clang++-17.0") << "clang++-17.0"   << true  << "clang" << "17.0";
+        QTest::newRow("windows exe")  << "clang++.exe"    << true  << "clang" << "";
+        QTest::newRow("c compiler")   << "gcc-13"         << false << ""      << "";
+        QTest::newRow("wrapper")      << "g++-wrapper"    << false << ""      << "";
+        QTest::newRow("cross")        << "x86_64-linux-gnu-g++-13" << false << "" << "";
+    }
+
+    void compilerFileNames()
+    {
+        QFETCH(QString, fileName);
+        QFETCH(bool, matches);
+        QFETCH(QString, family);
+        QFETCH(QString, suffix);
+
+        QString parsedFamily;
+        QString parsedSuffix;
+        QCOMPARE(ToolchainDiscovery::parseCompilerFileName(fileName, &parsedFamily, &parsedSuffix),
+                 matches);
+        if (matches) {
+            QCOMPARE(parsedFamily, family);
+            QCOMPARE(parsedSuffix, suffix);
+        }
+    }
+
+    // ── Probe cache ──────────────────────────────────────────────────────────
+
+    void probeIsCached()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Uses a shell script as the probed tool");
+#else
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString tool = dir.filePath("fake-tool");
+        const QString counter = dir.filePath("count");
+        writeScript(tool, QString("#!/bin/sh\necho run >> '%1'\necho 'fake 1.2.3'\n").arg(counter));
+
+        ToolchainDiscovery& discovery = ToolchainDiscovery::instance();
+        QVERIFY(!discovery.isCached(tool));
+
+        const ToolProbe first = discovery.probe(tool);
+        QVERIFY(first.available);
+        QVERIFY(first.output.contains("1.2.3"));
+        QVERIFY(discovery.isCached(tool));
+
+        const ToolProbe second = discovery.probe(tool);
+        QCOMPARE(second.output, first.output);
+        QCOMPARE(runCount(counter), 1);   // second call served from the cache
+#endif
+    }
+
+    void probeAllRunsEveryTool()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Uses shell scripts as the probed tools");
+#else
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QStringList tools;
+        for (int i = 0; i < 4; ++i) {
+            const QString tool = dir.filePath(QString("tool-%1").arg(i));
+            writeScript(tool, QString("#!/bin/sh\necho tool %1\n").arg(i));
+            tools << tool;
+        }
+        const QString broken = dir.filePath("broken");
+        writeScript(broken, "#!/bin/sh\nexit 3\n");
+        tools << broken;
+
+        ToolchainDiscovery& discovery = ToolchainDiscovery::instance();
+        discovery.probeAll(tools);
+        for (int i = 0; i < 4; ++i) {
+            const ToolProbe probe = discovery.cachedProbe(tools.at(i));
+            QVERIFY(probe.available);
+            QCOMPARE(probe.output.trimmed(), QString("tool %1").arg(i));
+        }
+        QVERIFY(discovery.isCached(broken));
+        QVERIFY(!discovery.cachedProbe(broken).available);
+#endif
+    }
+
+private:
+    static void writeScript(const QString& path, const QString& contents)
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(contents.toUtf8());
+        file.close();
+        file.setPermissions(file.permissions() | QFileDevice::ExeOwner | QFileDevice::ExeUser);
+    }
+
+    static int runCount(const QString& counterPath)
+    {
+        QFile file(counterPath);
+        if (!file.open(QIODevice::ReadOnly)) return 0;
+        return file.readAll().count('\n');
+    }
+};
+
+QTEST_MAIN(ToolchainDiscoveryTest)
+#include "test_toolchain_discovery.moc"
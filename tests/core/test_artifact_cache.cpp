@@ -0,0 +1,173 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "core/ArtifactCache.h"
+
+class ArtifactCacheTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        // Keep the real user cache out of the way
+        QStandardPaths::setTestModeEnabled(true);
+        ArtifactCache::instance()->clear();
+    }
+
+    void cleanupTestCase()
+    {
+        ArtifactCache::instance()->setMaxSizeBytes(ArtifactCache::DEFAULT_MAX_SIZE_BYTES);
+        ArtifactCache::instance()->clear();
+    }
+
+    // ── Keys ─────────────────────────────────────────────────────────────────
+
+    void keyDependsOnEveryInput()
+    {
+        const QString base = ArtifactCache::computeKey(
+            ArtifactCache::Kind::Assembly, "int main(){}", "gcc-system", "13.2.0", {"-O2"});
+        QCOMPARE(base, ArtifactCache::computeKey(
+            ArtifactCache::Kind::Assembly, "int main(){}", "gcc-system", "13.2.0", {"-O2"}));
+        QVERIFY(base != ArtifactCache::computeKey(
+            ArtifactCache::Kind::Executable, "int main(){}", "gcc-system", "13.2.0", {"-O2"}));
+        QVERIFY(base != ArtifactCache::computeKey(
+            ArtifactCache::Kind::Assembly, "int main(){ }", "gcc-system", "13.2.0", {"-O2"}));
+        QVERIFY(base != ArtifactCache::computeKey(
+            ArtifactCache::Kind::Assembly, "int main(){}", "gcc-system", "14.1.0", {"-O2"}));
+        QVERIFY(base != ArtifactCache::computeKey(
+            ArtifactCache::Kind::Assembly, "int main(){}", "gcc-system", "13.2.0", {"-O3"}));
+    }
+
+    void keyFollowsLocalHeaders()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        writeFile(dir.filePath("main.cpp"), "#include \"util.h\"\nint main() { return f(); }\n");
+        writeFile(dir.filePath("util.h"), "inline int f() { return 1; }\n");
+
+        const QString before = ArtifactCache::keyForSource(
+            ArtifactCache::Kind::Executable, dir.filePath("main.cpp"), "gcc", "13", {});
+        QVERIFY(!before.isEmpty());
+
+        writeFile(dir.filePath("util.h"), "inline int f() { return 2; }\n");
+        const QString after = ArtifactCache::keyForSource(
+            ArtifactCache::Kind::Executable, dir.filePath("main.cpp"), "gcc", "13", {});
+        QVERIFY(before != after);
+    }
+
+    void missingSourceHasNoKey()
+    {
+        QVERIFY(ArtifactCache::keyForSource(ArtifactCache::Kind::Executable,
+                                            "/nonexistent/main.cpp", "gcc", "13", {}).isEmpty());
+    }
+
+    // ── Storage ──────────────────────────────────────────────────────────────
+
+    void storeAndLookupData()
+    {
+        ArtifactCache* cache = ArtifactCache::instance();
+        const QString key = ArtifactCache::computeKey(
+            ArtifactCache::Kind::Assembly, "roundtrip", "gcc", "13", {});
+
+        QByteArray data;
+        QVERIFY(!cache->lookupData(key, &data));
+        QVERIFY(cache->storeData(key, "main:\n  ret\n", "warning: x"));
+
+        QByteArray log;
+        QVERIFY(cache->lookupData(key, &data, &log));
+        QCOMPARE(data, QByteArray("main:\n  ret\n"));
+        QCOMPARE(log, QByteArray("warning: x"));
+        QVERIFY(cache->stats().hits >= 1);
+        QVERIFY(cache->stats().misses >= 1);
+    }
+
+    void storeReplacesFileArtifact()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Checks the executable bit");
+#endif
+        ArtifactCache* cache = ArtifactCache::instance();
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString program = dir.filePath("program");
+        writeFile(program, "first build");
+        QVERIFY(QFile::setPermissions(program, QFile::permissions(program) | QFileDevice::ExeOwner));
+        const QString key = ArtifactCache::computeKey(
+            ArtifactCache::Kind::Executable, "replace", "gcc", "13", {});
+
+        QVERIFY(cache->store(key, program));
+        writeFile(program, "second build, a little longer");
+        QVERIFY(cache->store(key, program, "warning: y"));
+
+        QByteArray log;
+        const QString cached = cache->lookup(key, &log);
+        QVERIFY(!cached.isEmpty());
+        QCOMPARE(readFile(cached), QByteArray("second build, a little longer"));
+        QCOMPARE(log, QByteArray("warning: y"));
+        QVERIFY(QFile::permissions(cached) & QFileDevice::ExeOwner);
+
+        // No temporary copy left behind next to the artifact
+        const QFileInfo info(cached);
+        QCOMPARE(info.dir().entryList({ info.fileName() + "*" }, QDir::Files, QDir::Name),
+                 QStringList({ info.fileName(), info.fileName() + ".log" }));
+    }
+
+    void evictsLeastRecentlyUsed()
+    {
+        ArtifactCache* cache = ArtifactCache::instance();
+        cache->clear();
+        cache->setMaxSizeBytes(250);
+
+        const QByteArray blob(100, 'x');
+        const QString a = ArtifactCache::computeKey(ArtifactCache::Kind::Object, "a", "t", "1", {});
+        const QString b = ArtifactCache::computeKey(ArtifactCache::Kind::Object, "b", "t", "1", {});
+        const QString c = ArtifactCache::computeKey(ArtifactCache::Kind::Object, "c", "t", "1", {});
+
+        QVERIFY(cache->storeData(a, blob));
+        QTest::qWait(5);
+        QVERIFY(cache->storeData(b, blob));
+        QTest::qWait(5);
+        QVERIFY(cache->lookupData(a, nullptr));   // a is now more recent than b
+        QTest::qWait(5);
+        QVERIFY(cache->storeData(c, blob));       // exceeds 250 bytes → evict b
+
+        QVERIFY(cache->lookupData(a, nullptr));
+        QVERIFY(!cache->lookupData(b, nullptr));
+        QVERIFY(cache->lookupData(c, nullptr));
+        QCOMPARE(cache->stats().evictions, qint64(1));
+    }
+
+    void lookupDefersIndexWrite()
+    {
+        ArtifactCache* cache = ArtifactCache::instance();
+        cache->clear();
+        const QString key = ArtifactCache::computeKey(ArtifactCache::Kind::Assembly, "lazy", "t", "1", {});
+        QVERIFY(cache->storeData(key, "ret\n"));
+
+        const QString indexPath = cache->cacheDirectory() + "/index.json";
+        const QByteArray before = readFile(indexPath);
+        QVERIFY(!before.isEmpty());
+
+        // A hit moves lastUsed in memory only
+        QTest::qWait(5);
+        QVERIFY(cache->lookupData(key, nullptr));
+        QCOMPARE(readFile(indexPath), before);
+    }
+
+private:
+    static QByteArray readFile(const QString& path)
+    {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    static void writeFile(const QString& path, const QByteArray& contents)
+    {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(contents);
+    }
+};
+
+QTEST_MAIN(ArtifactCacheTest)
+#include "test_artifact_cache.moc"
@@ -0,0 +1,218 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "compiler/CompilerRegistry.h"
+#include "compiler/GccCompiler.h"
+#include "editor/SyntaxChecker.h"
+
+#ifndef Q_OS_WIN
+#include <cerrno>
+#include <signal.h>
+#endif
+
+class SyntaxCheckerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        // Keep the real probe cache out of the way
+        QStandardPaths::setTestModeEnabled(true);
+        QVERIFY(m_dir.isValid());
+    }
+
+    void cleanup()
+    {
+        CompilerRegistry::instance().unregisterCompiler(STUB_ID);
+    }
+
+    // ── Command line ─────────────────────────────────────────────────────────
+
+    void argumentsReadTheBufferFromStdin()
+    {
+        QCOMPARE(SyntaxChecker::buildArguments("c++20", "/p/src"),
+                 QStringList({"-fsyntax-only", "-fdiagnostics-color=never", "-std=c++20",
+                              "-iquote", "/p/src", "-x", "c++", "-"}));
+        QCOMPARE(SyntaxChecker::buildArguments(QString(), QString()),
+                 QStringList({"-fsyntax-only", "-fdiagnostics-color=never", "-x", "c++", "-"}));
+    }
+
+    // ── Checks ───────────────────────────────────────────────────────────────
+
+    void reportsOnlyBufferDiagnostics()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Uses a shell script as the compiler");
+#else
+        useStub("diag",
+                "cat > /dev/null\n"
+                "echo '/usr/include/c++/13/vector:1:1: warning: in a header' >&2\n"
+                "echo \"<stdin>:3:5: error: expected ';' before '}' token\" >&2\n"
+                "exit 1\n");
+
+        SyntaxChecker checker;
+        checker.setCompilerId(STUB_ID);
+        checker.setDebounceMs(0);
+        QList<QList<DiagnosticMessage>> reports;
+        connect(&checker, &SyntaxChecker::diagnosticsReady, this,
+                [&reports](const QList<DiagnosticMessage>& diagnostics, qint64) {
+                    reports << diagnostics;
+                });
+
+        checker.scheduleCheck("int main() {\n    int x = 1\n    }\n");
+        QTRY_COMPARE_WITH_TIMEOUT(reports.size(), 1, 5000);
+        QCOMPARE(reports.first().size(), 1);
+        const DiagnosticMessage& diag = reports.first().first();
+        QCOMPARE(diag.severity, DiagnosticMessage::Error);
+        QCOMPARE(diag.file, QString("<stdin>"));
+        QCOMPARE(diag.line, 3);
+        QCOMPARE(diag.column, 5);
+        QVERIFY(diag.message.contains("expected ';'"));
+        QVERIFY(!checker.isRunning());
+#endif
+    }
+
+    void debounceChecksOnlyTheLatestBuffer()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Uses a shell script as the compiler");
+#else
+        const QString counter = m_dir.filePath("debounce-count");
+        const QString checked = m_dir.filePath("debounce-last.cpp");
+        useStub("debounce", QString("echo run >> '%1'\ncat > '%2'\n").arg(counter, checked));
+
+        SyntaxChecker checker;
+        checker.setCompilerId(STUB_ID);
+        checker.setDebounceMs(200);
+        int reports = 0;
+        connect(&checker, &SyntaxChecker::diagnosticsReady, this,
+                [&reports](const QList<DiagnosticMessage>&, qint64) { ++reports; });
+
+        checker.scheduleCheck("int a;\n");
+        checker.scheduleCheck("int ab;\n");
+        checker.scheduleCheck("int abc;\n");
+        QTRY_COMPARE_WITH_TIMEOUT(reports, 1, 5000);
+
+        // No late run for the superseded buffers
+        QTest::qWait(400);
+        QCOMPARE(reports, 1);
+        QCOMPARE(readFile(counter).count('\n'), 1);
+        QCOMPARE(readFile(checked), QByteArray("int abc;\n"));
+#endif
+    }
+
+    void editWhileCheckingDropsTheStaleResult()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Uses a shell script as the compiler");
+#else
+        const QString pidFile = m_dir.filePath("stale-pid");
+        const QString checked = m_dir.filePath("stale-last.cpp");
+        useStub("stale", QString("echo $$ > '%1'\ncat > '%2'\nsleep 0.3\n"
+                                 "echo '<stdin>:1:1: error: stale or not' >&2\nexit 1\n")
+                             .arg(pidFile, checked));
+
+        SyntaxChecker checker;
+        checker.setCompilerId(STUB_ID);
+        checker.setDebounceMs(0);
+        QList<QList<DiagnosticMessage>> reports;
+        connect(&checker, &SyntaxChecker::diagnosticsReady, this,
+                [&reports](const QList<DiagnosticMessage>& diagnostics, qint64) {
+                    reports << diagnostics;
+                });
+
+        checker.scheduleCheck("int a;\n");
+        QTRY_VERIFY_WITH_TIMEOUT(!readFile(pidFile).trimmed().isEmpty(), 5000);
+        const pid_t first = static_cast<pid_t>(readFile(pidFile).trimmed().toLongLong());
+
+        // Typing does not kill the running check, nor wait for it
+        checker.setDebounceMs(1000);
+        QElapsedTimer timer;
+        timer.start();
+        checker.scheduleCheck("int ab;\n");
+        QVERIFY(timer.elapsed() < 50);
+        QCOMPARE(::kill(first, 0), 0);
+
+        // It ends on its own, unreported; then the latest buffer is checked
+        QTest::qWait(700);
+        QVERIFY(reports.isEmpty());
+        QTRY_COMPARE_WITH_TIMEOUT(reports.size(), 1, 5000);
+        QCOMPARE(readFile(checked), QByteArray("int ab;\n"));
+#endif
+    }
+
+    void cancelKillsTheWholeProcessGroup()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Uses a shell script as the compiler");
+#else
+        // The background sleep stands in for cc1plus under the g++ driver
+        const QString pidFile = m_dir.filePath("cancel-pid");
+        useStub("cancel", QString("sleep 30 &\necho $! > '%1'\nwait\n").arg(pidFile));
+
+        SyntaxChecker checker;
+        checker.setCompilerId(STUB_ID);
+        checker.setDebounceMs(0);
+        int reports = 0;
+        connect(&checker, &SyntaxChecker::diagnosticsReady, this,
+                [&reports](const QList<DiagnosticMessage>&, qint64) { ++reports; });
+
+        checker.scheduleCheck("int main() {}\n");
+        QTRY_VERIFY_WITH_TIMEOUT(!readFile(pidFile).trimmed().isEmpty(), 5000);
+        QVERIFY(checker.isRunning());
+        const pid_t pid = static_cast<pid_t>(readFile(pidFile).trimmed().toLongLong());
+
+        QElapsedTimer timer;
+        timer.start();
+        checker.cancel();
+        QVERIFY(timer.elapsed() < 50);   // No waiting on the GUI thread
+        QVERIFY(!checker.isRunning());
+
+        QTRY_VERIFY_WITH_TIMEOUT(processGone(pid), 2000);
+        QTest::qWait(200);
+        QCOMPARE(reports, 0);
+#endif
+    }
+
+private:
+    static constexpr const char* STUB_ID = "syntax-checker-stub";
+
+    // Registers a g++ look-alike running @p body for everything but --version
+    void useStub(const QString& name, const QString& body)
+    {
+        const QString path = m_dir.filePath(name + "-g++");
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QString("#!/bin/sh\n"
+                           "if [ \"$1\" = \"--version\" ]; then echo 'g++ (GCC) 13.2.0'; exit 0; fi\n"
+                           + body).toUtf8());
+        file.close();
+        file.setPermissions(file.permissions() | QFileDevice::ExeOwner | QFileDevice::ExeUser);
+
+        CompilerRegistry::instance().registerCompiler(
+            QSharedPointer<ICompiler>(new GccCompiler(path, STUB_ID)));
+    }
+
+#ifndef Q_OS_WIN
+    // Exited; a zombie left for init to reap counts as gone
+    static bool processGone(pid_t pid)
+    {
+        QFile stat(QString("/proc/%1/stat").arg(pid));
+        if (stat.open(QIODevice::ReadOnly)) {
+            return stat.readAll().contains(") Z ");
+        }
+        return ::kill(pid, 0) == -1 && errno == ESRCH;
+    }
+#endif
+
+    static QByteArray readFile(const QString& path)
+    {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    QTemporaryDir m_dir;
+};
+
+QTEST_MAIN(SyntaxCheckerTest)
+#include "test_syntax_checker.moc"
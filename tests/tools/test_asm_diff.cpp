@@ -0,0 +1,143 @@
+#include <QtTest/QtTest>
+#include "tools/AsmDiff.h"
+#include "tools/AsmParser.h"
+
+namespace {
+
+AsmDocument parse(const QByteArray& listing)
+{
+    AsmFilterOptions options;
+    options.demangle = false;
+    return AsmParser::parse(listing, options);
+}
+
+// -O2-like: one loop
+const char* const kLeft =
+    "\t.globl\t_Z3sumPKii\n"
+    "\t.type\t_Z3sumPKii, @function\n"
+    "_Z3sumPKii:\n"
+    "\txorl\t%eax, %eax\n"
+    ".L3:\n"
+    "\taddl\t(%rdi), %eax\n"
+    "\taddq\t$4, %rdi\n"
+    "\tcmpq\t%rsi, %rdi\n"
+    "\tjne\t.L3\n"
+    "\tret\n"
+    "\t.size\t_Z3sumPKii, .-_Z3sumPKii\n"
+    "\t.globl\t_Z3onev\n"
+    "\t.type\t_Z3onev, @function\n"
+    "_Z3onev:\n"
+    "\tmovl\t$1, %eax\n"
+    "\tret\n"
+    "\t.size\t_Z3onev, .-_Z3onev\n";
+
+// -O3-like: same function with a vector prologue and renumbered label,
+// plus a function the left side does not have
+const char* const kRight =
+    "\t.globl\t_Z3sumPKii\n"
+    "\t.type\t_Z3sumPKii, @function\n"
+    "_Z3sumPKii:\n"
+    "\tpxor\t%xmm0, %xmm0\n"
+    "\txorl\t%eax, %eax\n"
+    ".L7:\n"
+    "\taddl\t(%rdi), %eax\n"
+    "\taddq\t$4, %rdi\n"
+    "\tcmpq\t%rsi, %rdi\n"
+    "\tjne\t.L7\n"
+    "\tret\n"
+    "\t.size\t_Z3sumPKii, .-_Z3sumPKii\n"
+    "\t.globl\t_Z3twov\n"
+    "\t.type\t_Z3twov, @function\n"
+    "_Z3twov:\n"
+    "\tmovl\t$2, %eax\n"
+    "\tret\n"
+    "\t.size\t_Z3twov, .-_Z3twov\n";
+
+} // namespace
+
+class AsmDiffTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void normalizeIgnoresWhitespaceAndLocalLabels()
+    {
+        QCOMPARE(AsmDiff::normalize("\tjne\t.L3"), QStringLiteral("jne .L"));
+        QCOMPARE(AsmDiff::normalize("b.ne  LBB0_2"), QStringLiteral("b.ne .L"));
+        QCOMPARE(AsmDiff::normalize("leaq .LC0(%rip), %rax"), QStringLiteral("leaq .L(%rip), %rax"));
+        QCOMPARE(AsmDiff::normalize("call _Z3fooi"), QStringLiteral("call _Z3fooi"));
+    }
+
+    void functionsAreAlignedBySymbol()
+    {
+        const AsmDocument left  = parse(kLeft);
+        const AsmDocument right = parse(kRight);
+        const AsmDiffResult result = AsmDiff::compare(left, right);
+
+        QCOMPARE(result.functions.size(), 3);
+        const AsmFunctionDelta& sum = result.functions[0];
+        QCOMPARE(sum.symbol, QStringLiteral("_Z3sumPKii"));
+        QCOMPARE(sum.leftInstructions, 6);
+        QCOMPARE(sum.rightInstructions, 7);
+        QCOMPARE(sum.removed, 0);          // .L3 → .L7 alone is not a change
+        QCOMPARE(sum.added, 1);
+        QCOMPARE(sum.instructionDelta(), 1);
+
+        const AsmFunctionDelta& one = result.functions[1];
+        QCOMPARE(one.rightInstructions, -1);
+        QCOMPARE(one.removed, 2);
+
+        const AsmFunctionDelta& two = result.functions[2];
+        QCOMPARE(two.symbol, QStringLiteral("_Z3twov"));
+        QCOMPARE(two.leftInstructions, -1);
+        QCOMPARE(two.added, 2);
+    }
+
+    void changedLinesPointIntoEachListing()
+    {
+        const AsmDocument left  = parse(kLeft);
+        const AsmDocument right = parse(kRight);
+        const AsmDiffResult result = AsmDiff::compare(left, right);
+
+        QCOMPARE(result.addedLines.size(), 3);
+        QCOMPARE(right.lines[result.addedLines.first()].text.trimmed(),
+                 QStringLiteral("pxor\t%xmm0, %xmm0"));
+        QCOMPARE(result.removedLines.size(), 2);
+        for (int line : result.removedLines) {
+            QCOMPARE(left.lines[line].function, 1);   // All inside one()
+        }
+    }
+
+    void identicalListingsHaveNoChanges()
+    {
+        const AsmDocument doc = parse(kLeft);
+        const AsmDiffResult result = AsmDiff::compare(doc, doc);
+        QVERIFY(result.addedLines.isEmpty());
+        QVERIFY(result.removedLines.isEmpty());
+        for (const AsmFunctionDelta& delta : result.functions) {
+            QVERIFY(!delta.changed());
+        }
+    }
+
+    void parsesNmSizesAndAppliesThem()
+    {
+        const QByteArray nm =
+            "0000000000000000 000000000000001a T _Z3sumPKii\n"
+            "0000000000000020 0000000000000006 T _Z3onev\n"
+            "0000000000000000 0000000000000004 D counter\n"
+            "                 U memcpy\n";
+        const QHash<QString, qint64> sizes = AsmDiff::parseNmSizes(nm);
+        QCOMPARE(sizes.size(), 2);                       // Data and undefined symbols skipped
+        QCOMPARE(sizes.value("_Z3sumPKii"), qint64(26));
+
+        AsmDiffResult result = AsmDiff::compare(parse(kLeft), parse(kRight));
+        AsmDiff::applySizes(result, sizes, { { "_Z3sumPKii", 30 } });
+        QCOMPARE(result.functions[0].leftBytes, qint64(26));
+        QCOMPARE(result.functions[0].rightBytes, qint64(30));
+        QCOMPARE(result.functions[1].leftBytes, qint64(6));
+        QCOMPARE(result.functions[2].rightBytes, qint64(-1));   // Unknown
+    }
+};
+
+QTEST_MAIN(AsmDiffTest)
+#include "test_asm_diff.moc"
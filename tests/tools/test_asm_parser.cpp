@@ -0,0 +1,172 @@
+#include <QtTest/QtTest>
+#include "tools/AsmParser.h"
+
+namespace {
+
+// Trimmed GCC -O1 -g output: one user function, one std:: inline function
+// from a header, a string literal and a debug section.
+const char* const kGccListing =
+    "\t.file\t\"demo.cpp\"\n"
+    "\t.text\n"
+    ".Ltext0:\n"
+    "\t.file 1 \"demo.cpp\"\n"
+    "\t.file 2 \"/usr/include/c++/12/bits/stl_vector.h\"\n"
+    "\t.section\t.rodata.str1.1,\"aMS\",@progbits,1\n"
+    ".LC0:\n"
+    "\t.string\t\"hi\"\n"
+    "\t.text\n"
+    "\t.globl\t_Z6squarei\n"
+    "\t.type\t_Z6squarei, @function\n"
+    "_Z6squarei:\n"
+    ".LFB0:\n"
+    "\t.loc 1 3 19\n"
+    "\t.cfi_startproc\n"
+    "\t# comment line\n"
+    "\timull\t%edi, %edi\n"
+    "\t.loc 1 4 1\n"
+    "\ttestl\t%edi, %edi\n"
+    "\tje\t.L2\n"
+    "\tleaq\t.LC0(%rip), %rax\n"
+    ".L2:\n"
+    "\tmovl\t%edi, %eax\n"
+    "\tret\n"
+    "\t.cfi_endproc\n"
+    ".LFE0:\n"
+    "\t.size\t_Z6squarei, .-_Z6squarei\n"
+    "\t.section\t.text._ZNSt6vectorIiSaIiEE4sizeEv,\"axG\",@progbits,_ZNSt6vectorIiSaIiEE4sizeEv,comdat\n"
+    "\t.weak\t_ZNSt6vectorIiSaIiEE4sizeEv\n"
+    "\t.type\t_ZNSt6vectorIiSaIiEE4sizeEv, @function\n"
+    "_ZNSt6vectorIiSaIiEE4sizeEv:\n"
+    "\t.loc 2 919 7\n"
+    "\t.cfi_startproc\n"
+    "\tmovq\t8(%rdi), %rax\n"
+    "\tret\n"
+    "\t.cfi_endproc\n"
+    "\t.size\t_ZNSt6vectorIiSaIiEE4sizeEv, .-_ZNSt6vectorIiSaIiEE4sizeEv\n"
+    "\t.section\t.debug_info,\"\",@progbits\n"
+    ".Ldebug_info0:\n"
+    "\t.long\t0x86\n"
+    "\t.quad\t.L2\n";
+
+QStringList texts(const AsmDocument& doc)
+{
+    QStringList result;
+    for (const AsmLine& line : doc.lines) result << line.text.trimmed();
+    return result;
+}
+
+} // namespace
+
+class AsmParserTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // ── Filtering ────────────────────────────────────────────────────────────
+
+    void defaultFiltersLeaveCodeAndUsedData()
+    {
+        const AsmDocument doc = AsmParser::parse(kGccListing);
+        const QStringList lines = texts(doc);
+        QCOMPARE(doc.rawLineCount, 41);
+        QCOMPARE(lines.size(), 10);
+        QCOMPARE(lines.first(), QStringLiteral(".LC0:"));                 // Used by leaq
+        QCOMPARE(lines.at(1), QStringLiteral(".string\t\"hi\""));        // Data after a used label
+        QVERIFY(lines.contains(QStringLiteral(".L2:")));                 // Jump target
+        QVERIFY(!lines.contains(QStringLiteral(".LFB0:")));              // Unused
+        QVERIFY(!lines.contains(QStringLiteral("# comment line")));
+        for (const QString& line : lines) {
+            QVERIFY2(!line.startsWith(QLatin1String(".cfi")), qPrintable(line));
+            QVERIFY2(!line.contains(QLatin1String("debug")), qPrintable(line));
+        }
+    }
+
+    void libraryFunctionsAreDetectedFromLocFiles()
+    {
+        AsmFilterOptions keepLibrary;
+        keepLibrary.libraryFunctions = false;
+        const AsmDocument doc = AsmParser::parse(kGccListing, keepLibrary);
+        QCOMPARE(doc.functions.size(), 2);
+        QVERIFY(!doc.functions[0].library);
+        QVERIFY(doc.functions[1].library);
+        QCOMPARE(doc.functions[1].instructions, 2);
+
+        QCOMPARE(AsmParser::parse(kGccListing).functions.size(), 1);
+    }
+
+    void disabledFiltersKeepEveryLine()
+    {
+        AsmFilterOptions none;
+        none.directives = none.comments = none.unusedLabels = none.libraryFunctions = false;
+        none.demangle = false;
+        const AsmDocument doc = AsmParser::parse(kGccListing, none);
+        QCOMPARE(doc.lines.size(), doc.rawLineCount);
+        QCOMPARE(doc.functions.first().name, QStringLiteral("_Z6squarei"));
+    }
+
+    void trailingLabelCommentsAreStripped()
+    {
+        const AsmDocument doc = AsmParser::parse(
+            "\t.globl\tmain\n"
+            "\t.type\tmain,@function\n"
+            "main:                                   # @main\n"
+            "# %bb.0:\n"
+            "\txorl\t%eax, %eax\n"
+            "\tretq\n");
+        QCOMPARE(texts(doc), QStringList({ "main:", "xorl\t%eax, %eax", "retq" }));
+    }
+
+    // ── Source mapping ───────────────────────────────────────────────────────
+
+    void sourceIndexIsFlatAndBidirectional()
+    {
+        const AsmDocument doc = AsmParser::parse(kGccListing);
+        QCOMPARE(doc.mainSourceLine(3), 3);        // imull
+        QCOMPARE(doc.mainSourceLine(2), 0);        // The function label
+        QCOMPARE(doc.asmCount(3), 1);
+        QCOMPARE(doc.firstAsmLine(3), 3);
+        QCOMPARE(doc.asmCount(4), 5);
+        QCOMPARE(doc.asmLineAt(4, 4), 9);          // ret
+        QCOMPARE(doc.asmCount(5), 0);
+        QCOMPARE(doc.firstAsmLine(99), -1);
+    }
+
+    void dwarf5FileZeroIsTheMainFile()
+    {
+        const AsmDocument doc = AsmParser::parse(
+            "\t.file\t0 \"/work\" \"demo.cpp\" md5 0x0123\n"
+            "\t.file\t1 \"/usr/include\" \"stdio.h\"\n"
+            "\t.type\tf,@function\n"
+            "f:\n"
+            "\t.loc\t0 7 3 prologue_end\n"
+            "\tretq\n");
+        QCOMPARE(doc.files.size(), 2);
+        QCOMPARE(doc.files[0].path, QStringLiteral("/work/demo.cpp"));
+        QVERIFY(doc.files[0].isMain);
+        QVERIFY(!doc.files[1].isMain);
+        QCOMPARE(doc.firstAsmLine(7), 1);
+    }
+
+    // ── Demangling ───────────────────────────────────────────────────────────
+
+    void demanglesSymbolsInPlace()
+    {
+        const AsmDocument doc = AsmParser::parse(kGccListing);
+        QCOMPARE(doc.functions.first().name, QStringLiteral("square(int)"));
+        QCOMPARE(doc.functions.first().symbol, QStringLiteral("_Z6squarei"));
+        QCOMPARE(doc.lines.at(2).text, QStringLiteral("square(int):"));
+    }
+
+    void demangleHandlesMachOAndPlainNames()
+    {
+        const QStringList out = AsmParser::demangle({ "__Z6squarei", "main", "_Z3fooi.constprop.0" });
+        QCOMPARE(out.at(0), QStringLiteral("square(int)"));
+        QCOMPARE(out.at(1), QStringLiteral("main"));
+        QVERIFY(out.at(2).startsWith(QLatin1String("foo(int)")));
+        QVERIFY(AsmParser::isMangled("_ZN3fooEv"));
+        QVERIFY(!AsmParser::isMangled("main"));
+    }
+};
+
+QTEST_MAIN(AsmParserTest)
+#include "test_asm_parser.moc"
@@ -0,0 +1,166 @@
+#include <QtTest/QtTest>
+#include "tools/AssemblyRunner.h"
+#include "compiler/CompilerRegistry.h"
+#include "compiler/GccCompiler.h"
+
+#include <QDateTime>
+#include <QTemporaryDir>
+
+#ifndef Q_OS_WIN
+#include <cerrno>
+#include <signal.h>
+#endif
+
+class AssemblyRunnerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        CompilerRegistry::instance().autoScanCompilers();
+    }
+
+    // ── Command line ─────────────────────────────────────────────────────────
+
+    void sourceArgumentsReadStdinAndWriteStdout()
+    {
+        const QStringList args = AssemblyRunner::buildSourceArguments(
+            true, { "-std=c++20", "-O2" }, "/work/src");
+        QCOMPARE(args, QStringList({ "-S", "-g", "-masm=intel", "-std=c++20", "-O2",
+                                     "-iquote", "/work/src", "-x", "c++", "-", "-o", "-" }));
+
+        const QStringList plain = AssemblyRunner::buildSourceArguments(false, {}, QString());
+        QCOMPARE(plain, QStringList({ "-S", "-g", "-x", "c++", "-", "-o", "-" }));
+    }
+
+    // ── Line map ─────────────────────────────────────────────────────────────
+
+    void lineMapUsesRawLineNumbers()
+    {
+        const QMap<int, int> map = AssemblyRunner::parseLocDirectives(
+            "\t.file\t\"m.cpp\"\n"            // 1
+            "\t.file 1 \"m.cpp\"\n"            // 2
+            "\t.file 2 \"/usr/include/x.h\"\n" // 3
+            "f:\n"                              // 4
+            "\t.loc 1 3 5\n"                    // 5
+            "\timull\t%edi, %edi\n"             // 6
+            "\n"                                // 7: blank lines still count
+            "\t.loc 2 10 1\n"                   // 8
+            "\tnop\n"                            // 9: header code
+            "\t.loc 1 4 1\n"                    // 10
+            "\tret\n");                          // 11
+        QCOMPARE(map.size(), 2);
+        QCOMPARE(map.value(6), 3);
+        QCOMPARE(map.value(11), 4);
+    }
+
+    // ── Live runs ────────────────────────────────────────────────────────────
+
+    void compilesBufferWithoutTempFile()
+    {
+        AssemblyRunner runner;
+        if (!runner.isAvailable()) QSKIP("No compiler available");
+
+        QSignalSpy finished(&runner, &AssemblyRunner::finished);
+        runner.runSource(QStringLiteral("int square_%1(int x) { return x * x; }\n")
+                             .arg(QDateTime::currentMSecsSinceEpoch()),
+                         { "-std=c++17", "-O2" });
+        QVERIFY(finished.wait(30000));
+        QCOMPARE(finished.size(), 1);
+        QVERIFY(finished.first().at(0).toBool());
+        QVERIFY(finished.first().at(1).toString().contains(QLatin1String("square_")));
+        QVERIFY(!runner.isRunning());
+    }
+
+    void newerRunSupersedesInFlightOne()
+    {
+        AssemblyRunner runner;
+        if (!runner.isAvailable()) QSKIP("No compiler available");
+
+        const qint64 stamp = QDateTime::currentMSecsSinceEpoch();
+        QSignalSpy finished(&runner, &AssemblyRunner::finished);
+        runner.runSource(QStringLiteral("int stale_%1() { return 1; }\n").arg(stamp), {});
+        runner.runSource(QStringLiteral("int fresh_%1() { return 2; }\n").arg(stamp), {});
+        QVERIFY(finished.wait(30000));
+        QTest::qWait(200);   // A stale result would arrive right behind it
+        QCOMPARE(finished.size(), 1);
+        const QString asmText = finished.first().at(1).toString();
+        QVERIFY(asmText.contains(QLatin1String("fresh_")));
+        QVERIFY(!asmText.contains(QLatin1String("stale_")));
+    }
+
+    void cancelIsImmediateAndSilent()
+    {
+        AssemblyRunner runner;
+        if (!runner.isAvailable()) QSKIP("No compiler available");
+
+        QSignalSpy finished(&runner, &AssemblyRunner::finished);
+        runner.runSource(QStringLiteral("int cancelled_%1;\n")
+                             .arg(QDateTime::currentMSecsSinceEpoch()), {});
+        runner.cancel();
+        QVERIFY(!runner.isRunning());
+        QTest::qWait(500);
+        QCOMPARE(finished.size(), 0);
+    }
+
+    void cancelKillsTheCompilersChildren()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Uses a shell script as the compiler");
+#else
+        // The background sleep stands in for cc1plus under the g++ driver
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString pidFile = dir.filePath("child-pid");
+        const QString compiler = dir.filePath("slow-g++");
+        QFile script(compiler);
+        QVERIFY(script.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        script.write(QString("#!/bin/sh\n"
+                             "if [ \"$1\" = \"--version\" ]; then echo 'g++ (GCC) 13.2.0'; exit 0; fi\n"
+                             "sleep 30 &\n"
+                             "echo $! > '%1'\n"
+                             "wait\n").arg(pidFile).toUtf8());
+        script.close();
+        script.setPermissions(script.permissions() | QFileDevice::ExeOwner | QFileDevice::ExeUser);
+        CompilerRegistry::instance().registerCompiler(
+            QSharedPointer<ICompiler>(new GccCompiler(compiler, "asm-runner-slow")));
+
+        AssemblyRunner runner;
+        runner.setCompilerId("asm-runner-slow");
+        runner.runSource(QStringLiteral("int killed;\n"), {});
+        QTRY_VERIFY_WITH_TIMEOUT(!readFile(pidFile).trimmed().isEmpty(), 5000);
+        const pid_t child = static_cast<pid_t>(readFile(pidFile).trimmed().toLongLong());
+
+        QElapsedTimer timer;
+        timer.start();
+        runner.cancel();
+        QVERIFY(timer.elapsed() < 50);
+        QTRY_VERIFY_WITH_TIMEOUT(processGone(child), 2000);
+
+        CompilerRegistry::instance().unregisterCompiler("asm-runner-slow");
+#endif
+    }
+
+private:
+    static QByteArray readFile(const QString& path)
+    {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+#ifndef Q_OS_WIN
+    // Exited; a zombie left for init to reap counts as gone
+    static bool processGone(pid_t pid)
+    {
+        QFile stat(QString("/proc/%1/stat").arg(pid));
+        if (stat.open(QIODevice::ReadOnly)) {
+            return stat.readAll().contains(") Z ");
+        }
+        return ::kill(pid, 0) == -1 && errno == ESRCH;
+    }
+#endif
+};
+
+QTEST_MAIN(AssemblyRunnerTest)
+#include "test_assembly_runner.moc"
@@ -0,0 +1,190 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "tools/BenchmarkHistory.h"
+
+namespace {
+
+BenchmarkResult makeResult(const QString& name, const QList<double>& times) {
+    BenchmarkResult result;
+    result.success = true;
+    for (int i = 0; i < times.size(); ++i) {
+        BenchmarkEntry e;
+        e.name = e.runName = name;
+        e.runType         = QStringLiteral("iteration");
+        e.repetitions     = times.size();
+        e.repetitionIndex = i;
+        e.realTimeNs = e.cpuTimeNs = times[i];
+        e.iterations = 100;
+        e.timeUnit   = QStringLiteral("us");
+        result.benchmarks << e;
+    }
+    return result;
+}
+
+} // namespace
+
+class BenchmarkHistoryTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void storesAndReloadsRuns();
+    void groupsBySource();
+    void pinsOneBaselinePerSource();
+    void removesRunsWithEntries();
+    void regressionFlags();
+
+private:
+    QScopedPointer<QTemporaryDir> m_dir;
+    QString dbPath() const { return m_dir->filePath(QStringLiteral("history.db")); }
+};
+
+void BenchmarkHistoryTest::init()
+{
+    m_dir.reset(new QTemporaryDir());
+    QVERIFY(m_dir->isValid());
+}
+
+void BenchmarkHistoryTest::storesAndReloadsRuns()
+{
+    BenchmarkResult result = makeResult(QStringLiteral("BM_Sort/64"), { 10.0, 11.0, 12.0 });
+    result.compilerId        = QStringLiteral("gcc-13");
+    result.standard          = QStringLiteral("c++20");
+    result.optimizationLevel = QStringLiteral("O2");
+    result.date              = QStringLiteral("2026-01-01T00:00:00+00:00");
+    result.options.repetitions = 3;
+    result.options.pinnedCpus  = { 2, 3 };
+    result.context.hostName    = QStringLiteral("lab-07");
+    result.context.numCpus     = 8;
+    result.perfCountersNote    = QStringLiteral("perf_event_paranoid is 3");
+
+    const QString source = QStringLiteral("BENCHMARK(BM_Sort)->Arg(64);\n");
+    qint64 id = -1;
+    {
+        BenchmarkHistory history(dbPath());
+        QVERIFY2(history.isOpen(), qPrintable(history.lastError()));
+        QSignalSpy changed(&history, &BenchmarkHistory::changed);
+        id = history.addRun(result, QStringLiteral("/tmp/sort.cpp"), source);
+        QVERIFY2(id >= 0, qPrintable(history.lastError()));
+        QCOMPARE(changed.count(), 1);
+    }
+
+    // A fresh connection reads back what the first one wrote
+    BenchmarkHistory history(dbPath());
+    const BenchmarkHistoryRun run = history.run(id);
+    QVERIFY(run.isValid());
+    QCOMPARE(run.sourceName, QStringLiteral("/tmp/sort.cpp"));
+    QCOMPARE(run.source, source);
+    QCOMPARE(run.sourceHash, BenchmarkHistory::sourceHash(source));
+    QCOMPARE(run.sourceHash.size(), 40);
+    QVERIFY(run.recordedAt.isValid());
+    QVERIFY(!run.baseline);
+    QVERIFY(run.shortLabel().startsWith(QStringLiteral("#%1 · ").arg(id)));
+
+    const BenchmarkResult& r = run.result;
+    QCOMPARE(r.compilerId, result.compilerId);
+    QCOMPARE(r.standard, result.standard);
+    QCOMPARE(r.optimizationLevel, result.optimizationLevel);
+    QCOMPARE(r.date, result.date);
+    QCOMPARE(r.perfCountersNote, result.perfCountersNote);
+    QVERIFY(r.options == result.options);
+    QCOMPARE(r.context.hostName, QStringLiteral("lab-07"));
+    QCOMPARE(r.context.numCpus, 8);
+    QCOMPARE(r.benchmarks.size(), 3);
+    QCOMPARE(r.benchmarks[1].repetitionIndex, 1);
+    QCOMPARE(r.benchmarks[2].realTimeNs, 12.0);
+    QCOMPARE(r.benchmarks[2].timeUnit, QStringLiteral("us"));
+
+    QVERIFY(!history.run(id + 100).isValid());
+}
+
+void BenchmarkHistoryTest::groupsBySource()
+{
+    BenchmarkHistory history(dbPath());
+    const BenchmarkResult result = makeResult(QStringLiteral("BM_A"), { 1.0 });
+    const qint64 a1 = history.addRun(result, QStringLiteral("a.cpp"), QStringLiteral("v1"));
+    history.addRun(result, QStringLiteral("b.cpp"), QStringLiteral("v1"));
+    const qint64 a2 = history.addRun(result, QStringLiteral("a.cpp"), QStringLiteral("v2"));
+
+    // Most recently run first
+    QCOMPARE(history.sourceNames(), (QStringList{ QStringLiteral("a.cpp"), QStringLiteral("b.cpp") }));
+
+    const QList<BenchmarkHistoryRun> runs = history.runs(QStringLiteral("a.cpp"));
+    QCOMPARE(runs.size(), 2);
+    QCOMPARE(runs[0].id, a1);
+    QCOMPARE(runs[1].id, a2);
+    QVERIFY(runs[0].sourceHash != runs[1].sourceHash);
+    QCOMPARE(history.runs().size(), 3);
+}
+
+void BenchmarkHistoryTest::pinsOneBaselinePerSource()
+{
+    BenchmarkHistory history(dbPath());
+    const BenchmarkResult result = makeResult(QStringLiteral("BM_A"), { 1.0 });
+    const qint64 a1 = history.addRun(result, QStringLiteral("a.cpp"), QStringLiteral("v1"));
+    const qint64 a2 = history.addRun(result, QStringLiteral("a.cpp"), QStringLiteral("v2"));
+    const qint64 b1 = history.addRun(result, QStringLiteral("b.cpp"), QStringLiteral("v1"));
+
+    QVERIFY(!history.baseline(QStringLiteral("a.cpp")).isValid());
+    QVERIFY(history.pinBaseline(a1));
+    QVERIFY(history.pinBaseline(b1));
+    QCOMPARE(history.baseline(QStringLiteral("a.cpp")).id, a1);
+
+    // Re-pinning moves the baseline within its source only
+    QVERIFY(history.pinBaseline(a2));
+    QCOMPARE(history.baseline(QStringLiteral("a.cpp")).id, a2);
+    QVERIFY(!history.run(a1).baseline);
+    QCOMPARE(history.baseline(QStringLiteral("b.cpp")).id, b1);
+
+    QVERIFY(!history.pinBaseline(a2 + 100));
+    QVERIFY(history.unpinBaseline(QStringLiteral("a.cpp")));
+    QVERIFY(!history.baseline(QStringLiteral("a.cpp")).isValid());
+    QCOMPARE(history.baseline(QStringLiteral("b.cpp")).id, b1);
+}
+
+void BenchmarkHistoryTest::removesRunsWithEntries()
+{
+    BenchmarkHistory history(dbPath());
+    const qint64 id = history.addRun(makeResult(QStringLiteral("BM_A"), { 1.0, 2.0 }),
+                                     QStringLiteral("a.cpp"), QStringLiteral("v1"));
+    QSignalSpy changed(&history, &BenchmarkHistory::changed);
+    QVERIFY(history.removeRun(id));
+    QCOMPARE(changed.count(), 1);
+    QVERIFY(!history.run(id).isValid());
+    QVERIFY(history.sourceNames().isEmpty());
+    QVERIFY(!history.removeRun(id));
+
+    // Ids are not reused, so a new run never inherits the old one's entries
+    const qint64 next = history.addRun(makeResult(QStringLiteral("BM_B"), { 3.0 }),
+                                       QStringLiteral("a.cpp"), QStringLiteral("v2"));
+    QVERIFY(next > id);
+    QCOMPARE(history.run(next).result.benchmarks.size(), 1);
+}
+
+void BenchmarkHistoryTest::regressionFlags()
+{
+    const BenchmarkResult base = makeResult(QStringLiteral("BM_A"),
+                                            { 100, 101, 99, 102, 100, 98, 101, 100, 99 });
+    const BenchmarkResult slow = makeResult(QStringLiteral("BM_A"),
+                                            { 120, 121, 119, 122, 120, 118, 121, 120, 119 });
+    const BenchmarkResult fast = makeResult(QStringLiteral("BM_A"),
+                                            { 80, 81, 79, 82, 80, 78, 81, 80, 79 });
+
+    QStringList flags = BenchmarkHistory::regressionFlags(BenchmarkStats::compare(base, slow));
+    QCOMPARE(flags.size(), 1);
+    QVERIFY2(flags.first().startsWith(QStringLiteral("BM_A regressed by 20.0% (significant, p = ")),
+             qPrintable(flags.first()));
+    QVERIFY(BenchmarkHistory::regressionFlags(BenchmarkStats::compare(base, fast)).isEmpty());
+
+    // Single runs cannot be tested: only clear slowdowns are listed, as untested
+    flags = BenchmarkHistory::regressionFlags(BenchmarkStats::compare(
+        makeResult(QStringLiteral("BM_A"), { 100 }), makeResult(QStringLiteral("BM_A"), { 110 })));
+    QCOMPARE(flags.size(), 1);
+    QVERIFY(flags.first().contains(QStringLiteral("untested")));
+    QVERIFY(BenchmarkHistory::regressionFlags(BenchmarkStats::compare(
+        makeResult(QStringLiteral("BM_A"), { 100 }), makeResult(QStringLiteral("BM_A"), { 102 }))).isEmpty());
+}
+
+QTEST_MAIN(BenchmarkHistoryTest)
+#include "test_benchmark_history.moc"
@@ -0,0 +1,97 @@
+#include <QtTest/QtTest>
+#include "tools/BenchmarkJsonStream.h"
+#include "tools/BenchmarkRunner.h"
+
+namespace {
+
+// As flushed by the JSON reporter; the second name has a brace and a quote
+const char* const kOutput = R"({
+  "context": {
+    "date": "2026-01-01T00:00:00+00:00",
+    "caches": [ { "type": "Data", "level": 1, "size": 32768 } ]
+  },
+  "benchmarks": [
+    {
+      "name": "BM_A/8",
+      "run_name": "BM_A/8",
+      "run_type": "iteration",
+      "iterations": 1000,
+      "real_time": 10.5,
+      "cpu_time": 10.0,
+      "time_unit": "ns"
+    },
+    {
+      "name": "BM_B<{\"x\"}>",
+      "run_name": "BM_B<{\"x\"}>",
+      "run_type": "iteration",
+      "iterations": 50,
+      "real_time": 2.5,
+      "cpu_time": 2.0,
+      "time_unit": "us"
+    }
+  ]
+}
+)";
+
+} // namespace
+
+class BenchmarkJsonStreamTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emitsRowsAsTheyComplete();
+    void byteByByteMatchesWhole();
+    void ignoresContextObjects();
+};
+
+void BenchmarkJsonStreamTest::emitsRowsAsTheyComplete()
+{
+    const QByteArray all(kOutput);
+    const int firstEnd  = all.indexOf("    },") + 5;
+    const int secondEnd = all.lastIndexOf("    }") + 5;
+
+    BenchmarkJsonStream stream;
+    QVERIFY(stream.feed(all.left(firstEnd - 1)).isEmpty());
+
+    QList<QJsonObject> rows = stream.feed(all.mid(firstEnd - 1, 1));
+    QCOMPARE(rows.size(), 1);
+    QCOMPARE(BenchmarkRunner::entryFromJson(rows.first()).name, QStringLiteral("BM_A/8"));
+
+    QVERIFY(stream.feed(all.mid(firstEnd, secondEnd - firstEnd - 1)).isEmpty());
+    rows = stream.feed(all.mid(secondEnd - 1));
+    QCOMPARE(rows.size(), 1);
+    const BenchmarkEntry second = BenchmarkRunner::entryFromJson(rows.first());
+    QCOMPARE(second.name, QStringLiteral("BM_B<{\"x\"}>"));
+    QCOMPARE(second.timeUnit, QStringLiteral("us"));
+
+    // The whole output is kept for the final parse
+    QCOMPARE(stream.data(), all);
+    QCOMPARE(BenchmarkRunner::parseJsonOutput(QString::fromUtf8(stream.data())).benchmarks.size(), 2);
+}
+
+void BenchmarkJsonStreamTest::byteByByteMatchesWhole()
+{
+    const QByteArray all(kOutput);
+    BenchmarkJsonStream stream;
+    QStringList names;
+    for (int i = 0; i < all.size(); ++i) {
+        for (const QJsonObject& row : stream.feed(all.mid(i, 1)))
+            names << row.value(QStringLiteral("name")).toString();
+    }
+    QCOMPARE(names, (QStringList{ QStringLiteral("BM_A/8"), QStringLiteral("BM_B<{\"x\"}>") }));
+
+    stream.reset();
+    QCOMPARE(stream.feed(all).size(), 2);
+    QVERIFY(stream.feed(QByteArray("{ \"name\": \"late\" }")).isEmpty());
+}
+
+void BenchmarkJsonStreamTest::ignoresContextObjects()
+{
+    BenchmarkJsonStream stream;
+    const QByteArray all(kOutput);
+    QVERIFY(stream.feed(all.left(all.indexOf("\"benchmarks\""))).isEmpty());
+}
+
+QTEST_MAIN(BenchmarkJsonStreamTest)
+#include "test_benchmark_json_stream.moc"
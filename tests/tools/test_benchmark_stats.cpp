@@ -0,0 +1,754 @@
+#include <QtTest/QtTest>
+#include "tools/BenchmarkRunner.h"
+#include "tools/BenchmarkStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// --benchmark_format=json --benchmark_repetitions=3 (context trimmed)
+const char* const kRepetitionsJson = R"({
+  "context": { "date": "2026-01-01T00:00:00+00:00" },
+  "benchmarks": [
+    { "name": "BM_Sum/8", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Sum/8", "run_type": "iteration", "repetitions": 3,
+      "repetition_index": 0, "threads": 1, "iterations": 1000,
+      "real_time": 10.0, "cpu_time": 9.0, "time_unit": "ns", "items_per_second": 5.0 },
+    { "name": "BM_Sum/8", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Sum/8", "run_type": "iteration", "repetitions": 3,
+      "repetition_index": 1, "threads": 1, "iterations": 1000,
+      "real_time": 14.0, "cpu_time": 13.0, "time_unit": "ns", "items_per_second": 5.0 },
+    { "name": "BM_Sum/8", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Sum/8", "run_type": "iteration", "repetitions": 3,
+      "repetition_index": 2, "threads": 1, "iterations": 1000,
+      "real_time": 12.0, "cpu_time": 11.0, "time_unit": "ns", "items_per_second": 5.0 },
+    { "name": "BM_Sum/8_mean", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Sum/8", "run_type": "aggregate", "repetitions": 3,
+      "threads": 1, "aggregate_name": "mean", "aggregate_unit": "time",
+      "iterations": 3, "real_time": 12.0, "cpu_time": 11.0, "time_unit": "ns" },
+    { "name": "BM_Sum/8_median", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Sum/8", "run_type": "aggregate", "repetitions": 3,
+      "threads": 1, "aggregate_name": "median", "aggregate_unit": "time",
+      "iterations": 3, "real_time": 12.0, "cpu_time": 11.0, "time_unit": "ns" },
+    { "name": "BM_Sum/8_stddev", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Sum/8", "run_type": "aggregate", "repetitions": 3,
+      "threads": 1, "aggregate_name": "stddev", "aggregate_unit": "time",
+      "iterations": 3, "real_time": 2.0, "cpu_time": 2.0, "time_unit": "ns" },
+    { "name": "BM_Sum/8_cv", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Sum/8", "run_type": "aggregate", "repetitions": 3,
+      "threads": 1, "aggregate_name": "cv", "aggregate_unit": "percentage",
+      "iterations": 3, "real_time": 0.1667, "cpu_time": 0.1818, "time_unit": "ns" }
+  ]
+})";
+
+const char* const kContextJson = R"({
+  "context": {
+    "date": "2026-01-01T00:00:00+00:00", "host_name": "bench-box",
+    "executable": "./bm", "num_cpus": 8, "mhz_per_cpu": 2800,
+    "cpu_scaling_enabled": true,
+    "caches": [
+      { "type": "Data", "level": 1, "size": 32768, "num_sharing": 2 },
+      { "type": "Unified", "level": 3, "size": 8388608, "num_sharing": 8 }
+    ],
+    "load_avg": [2.5, 1.0, 0.5],
+    "library_version": "v1.8.3", "library_build_type": "debug"
+  },
+  "benchmarks": []
+})";
+
+// --benchmark_perf_counters=CYCLES,INSTRUCTIONS,CACHE-MISSES,BRANCHES,BRANCH-MISSES
+const char* const kPerfCountersJson = R"({
+  "context": { "date": "2026-01-01T00:00:00+00:00" },
+  "benchmarks": [
+    { "name": "BM_Branchy", "run_name": "BM_Branchy", "run_type": "iteration",
+      "repetitions": 2, "repetition_index": 0, "threads": 1, "iterations": 1000,
+      "real_time": 10.0, "cpu_time": 10.0, "time_unit": "ns",
+      "CYCLES": 40.0, "INSTRUCTIONS": 80.0, "CACHE-MISSES": 0.5,
+      "BRANCHES": 20.0, "BRANCH-MISSES": 1.0 },
+    { "name": "BM_Branchy", "run_name": "BM_Branchy", "run_type": "iteration",
+      "repetitions": 2, "repetition_index": 1, "threads": 1, "iterations": 1000,
+      "real_time": 12.0, "cpu_time": 12.0, "time_unit": "ns",
+      "CYCLES": 60.0, "INSTRUCTIONS": 80.0, "CACHE-MISSES": 1.5,
+      "BRANCHES": 20.0, "BRANCH-MISSES": 3.0 }
+  ]
+})";
+
+// Allocation tracking: the memory-manager run adds these keys
+const char* const kAllocationsJson = R"({
+  "context": { "date": "2026-01-01T00:00:00+00:00" },
+  "benchmarks": [
+    { "name": "BM_Push", "run_name": "BM_Push", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 38297,
+      "real_time": 250.0, "cpu_time": 250.0, "time_unit": "ns",
+      "allocs_per_iter": 8.0625, "max_bytes_used": 1192,
+      "total_allocated_bytes": 16720, "net_heap_growth": 0 },
+    { "name": "BM_Tiny", "run_name": "BM_Tiny", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 4,
+      "real_time": 9.0, "cpu_time": 9.0, "time_unit": "ns",
+      "allocs_per_iter": 1.0, "max_bytes_used": 64,
+      "total_allocated_bytes": 256, "net_heap_growth": 0 }
+  ]
+})";
+
+// ->Range(8, 64)->Complexity(oN), ->ArgsProduct with ArgNames, one fixed argument
+const char* const kSweepJson = R"({
+  "context": { "date": "2026-01-01T00:00:00+00:00" },
+  "benchmarks": [
+    { "name": "BM_Fill/8/real_time", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Fill/8/real_time", "run_type": "iteration", "repetitions": 1,
+      "repetition_index": 0, "threads": 1, "iterations": 1000,
+      "real_time": 17.0, "cpu_time": 17.0, "time_unit": "ns" },
+    { "name": "BM_Fill/64/real_time", "family_index": 0, "per_family_instance_index": 1,
+      "run_name": "BM_Fill/64/real_time", "run_type": "iteration", "repetitions": 1,
+      "repetition_index": 0, "threads": 1, "iterations": 1000,
+      "real_time": 127.0, "cpu_time": 127.0, "time_unit": "ns" },
+    { "name": "BM_Fill/real_time_BigO", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Fill/real_time", "run_type": "aggregate", "repetitions": 1,
+      "threads": 1, "aggregate_name": "BigO", "aggregate_unit": "time",
+      "cpu_coefficient": 1.98, "real_coefficient": 2.0, "big_o": "N", "time_unit": "ns" },
+    { "name": "BM_Fill/real_time_RMS", "family_index": 0, "per_family_instance_index": 0,
+      "run_name": "BM_Fill/real_time", "run_type": "aggregate", "repetitions": 1,
+      "threads": 1, "aggregate_name": "RMS", "aggregate_unit": "percentage", "rms": 0.05 },
+    { "name": "BM_2D/rows:1/cols:2", "run_name": "BM_2D/rows:1/cols:2", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 100,
+      "real_time": 2.0, "cpu_time": 2.0, "time_unit": "ns" },
+    { "name": "BM_2D/rows:4/cols:2", "run_name": "BM_2D/rows:4/cols:2", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 100,
+      "real_time": 8.0, "cpu_time": 8.0, "time_unit": "ns" },
+    { "name": "BM_2D/rows:1/cols:8", "run_name": "BM_2D/rows:1/cols:8", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 100,
+      "real_time": 8.0, "cpu_time": 8.0, "time_unit": "ns" },
+    { "name": "BM_2D/rows:4/cols:8", "run_name": "BM_2D/rows:4/cols:8", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 100,
+      "real_time": 32.0, "cpu_time": 32.0, "time_unit": "ns" },
+    { "name": "BM_Fixed/3/16", "run_name": "BM_Fixed/3/16", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 100,
+      "real_time": 1.0, "cpu_time": 1.0, "time_unit": "us" },
+    { "name": "BM_Fixed/3/32", "run_name": "BM_Fixed/3/32", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 100,
+      "real_time": 2.0, "cpu_time": 2.0, "time_unit": "us" },
+    { "name": "BM_Single/5", "run_name": "BM_Single/5", "run_type": "iteration",
+      "repetitions": 1, "repetition_index": 0, "threads": 1, "iterations": 100,
+      "real_time": 1.0, "cpu_time": 1.0, "time_unit": "ns" }
+  ]
+})";
+
+BenchmarkResult makeResult(const QString& name, const QList<double>& times) {
+    BenchmarkResult result;
+    for (int i = 0; i < times.size(); ++i) {
+        BenchmarkEntry e;
+        e.name = e.runName = name;
+        e.runType         = QStringLiteral("iteration");
+        e.repetitions     = times.size();
+        e.repetitionIndex = i;
+        e.realTimeNs = e.cpuTimeNs = times[i];
+        e.iterations = 100;
+        e.timeUnit   = QStringLiteral("ns");
+        result.benchmarks << e;
+    }
+    return result;
+}
+
+} // namespace
+
+class BenchmarkStatsTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void parsesRepetitionsAndAggregates();
+    void summarizesRepetitions();
+    void summarizesAggregatesOnly();
+    void bootstrapIntervalContainsMedian();
+    void bootstrapRatioIntervalContainsRatio();
+    void mannWhitneyExact();
+    void mannWhitneyNormalWithTies();
+    void mannWhitneyNeedsTwoPerSide();
+    void compareVerdicts();
+    void runArguments();
+    void entryJsonRoundTrip();
+    void filterMatchesOneRun();
+    void appendRepetitionsContinuesIndices();
+    void convergenceTargets();
+    void parsesCpuLists();
+    void parsesContext();
+    void noiseWarnings();
+    void parsesPerfCounters();
+    void perfCountersNotes();
+    void parsesAllocations();
+    void parsesNameParts();
+    void threadScalingAndAmdahl();
+    void injectsThreadRange();
+    void parameterSweeps();
+    void complexityFit();
+    void downsamplesKeepingPeaks();
+};
+
+void BenchmarkStatsTest::parsesRepetitionsAndAggregates()
+{
+    const BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kRepetitionsJson));
+    QCOMPARE(r.benchmarks.size(), 7);
+
+    const BenchmarkEntry& second = r.benchmarks[1];
+    QCOMPARE(second.runName, QStringLiteral("BM_Sum/8"));
+    QVERIFY(!second.isAggregate());
+    QCOMPARE(second.repetitions, 3);
+    QCOMPARE(second.repetitionIndex, 1);
+    QCOMPARE(second.counters.value(QStringLiteral("items_per_second")).toDouble(), 5.0);
+    // Bookkeeping keys are not user counters
+    QVERIFY(!second.counters.contains(QStringLiteral("family_index")));
+
+    const BenchmarkEntry& cv = r.benchmarks[6];
+    QVERIFY(cv.isAggregate());
+    QCOMPARE(cv.aggregateName, QStringLiteral("cv"));
+    QCOMPARE(cv.runName, QStringLiteral("BM_Sum/8"));
+    QVERIFY(!cv.counters.contains(QStringLiteral("aggregate_unit")));
+}
+
+void BenchmarkStatsTest::summarizesRepetitions()
+{
+    const BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kRepetitionsJson));
+    const QList<BenchmarkSummary> summaries = BenchmarkStats::summarize(r.benchmarks);
+    QCOMPARE(summaries.size(), 1);
+
+    const BenchmarkSummary& s = summaries.first();
+    QCOMPARE(s.runName, QStringLiteral("BM_Sum/8"));
+    QCOMPARE(s.repetitions, 3);
+    QCOMPARE(s.iterations, qint64(1000));
+    QCOMPARE(s.realTimes, (QList<double>{ 10.0, 14.0, 12.0 }));
+    QCOMPARE(s.median, 12.0);
+    QCOMPARE(s.mean, 12.0);
+    QCOMPARE(s.stddev, 2.0);
+    QVERIFY(qAbs(s.cv - 2.0 / 12.0) < 1e-12);
+    QCOMPARE(s.cpuMedian, 11.0);
+    QVERIFY(s.hasInterval());
+}
+
+void BenchmarkStatsTest::summarizesAggregatesOnly()
+{
+    // --benchmark_report_aggregates_only drops the iteration rows
+    BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kRepetitionsJson));
+    r.benchmarks = r.benchmarks.mid(3);
+
+    const QList<BenchmarkSummary> summaries = BenchmarkStats::summarize(r.benchmarks);
+    QCOMPARE(summaries.size(), 1);
+    const BenchmarkSummary& s = summaries.first();
+    QCOMPARE(s.repetitions, 3);
+    QCOMPARE(s.median, 12.0);
+    QCOMPARE(s.stddev, 2.0);
+    QCOMPARE(s.cv, 0.1667);
+    QVERIFY(!s.hasInterval());
+    QCOMPARE(s.ciLow, s.median);
+}
+
+void BenchmarkStatsTest::bootstrapIntervalContainsMedian()
+{
+    const QList<double> values = { 10.0, 11.0, 12.0, 13.0, 100.0, 11.5, 12.5 };
+    const QPair<double, double> ci = BenchmarkStats::bootstrapMedianCi(values);
+    QVERIFY(ci.first <= 12.0);
+    QVERIFY(ci.second >= 12.0);
+    QVERIFY(ci.first >= 10.0);
+    QVERIFY(ci.second < 100.0);   // The outlier cannot be a resampled median
+    const QPair<double, double> again = BenchmarkStats::bootstrapMedianCi(values);
+    QCOMPARE(again.first, ci.first);
+    QCOMPARE(again.second, ci.second);
+
+    const QPair<double, double> single = BenchmarkStats::bootstrapMedianCi({ 5.0 });
+    QCOMPARE(single.first, 5.0);
+    QCOMPARE(single.second, 5.0);
+}
+
+void BenchmarkStatsTest::bootstrapRatioIntervalContainsRatio()
+{
+    const QList<double> reference = { 20.0, 21.0, 19.0, 20.5, 19.5 };
+    const QList<double> contender = { 10.0, 10.5, 9.5, 10.2, 9.8 };
+    const QPair<double, double> ci = BenchmarkStats::bootstrapMedianRatioCi(reference, contender);
+    QVERIFY(ci.first <= 2.0);
+    QVERIFY(ci.second >= 2.0);
+    QVERIFY(ci.first > 19.0 / 10.5);
+    QVERIFY(ci.second < 21.0 / 9.5);
+    const QPair<double, double> again = BenchmarkStats::bootstrapMedianRatioCi(reference, contender);
+    QCOMPARE(again.first, ci.first);
+    QCOMPARE(again.second, ci.second);
+
+    const QPair<double, double> single = BenchmarkStats::bootstrapMedianRatioCi({ 20.0 }, contender);
+    QCOMPARE(single.first, 2.0);
+    QCOMPARE(single.second, 2.0);
+}
+
+void BenchmarkStatsTest::mannWhitneyExact()
+{
+    // Completely separated 5 vs 5: p = 2 / C(10, 5)
+    MannWhitneyResult r = BenchmarkStats::mannWhitneyU({ 1, 2, 3, 4, 5 }, { 6, 7, 8, 9, 10 });
+    QVERIFY(r.valid);
+    QVERIFY(r.exact);
+    QCOMPARE(r.u, 0.0);
+    QVERIFY(qAbs(r.pValue - 2.0 / 252.0) < 1e-12);
+
+    r = BenchmarkStats::mannWhitneyU({ 1, 3, 5, 7, 9 }, { 2, 4, 6, 8, 10 });
+    QCOMPARE(r.u, 10.0);
+    QVERIFY(qAbs(r.pValue - 174.0 / 252.0) < 1e-12);
+
+    r = BenchmarkStats::mannWhitneyU({ 1.0, 1.2, 1.1, 0.9 }, { 1.05, 1.3, 1.4 });
+    QCOMPARE(r.u, 2.0);
+    QVERIFY(qAbs(r.pValue - 8.0 / 35.0) < 1e-12);
+}
+
+void BenchmarkStatsTest::mannWhitneyNormalWithTies()
+{
+    // Tie-corrected normal approximation with continuity correction
+    const MannWhitneyResult r =
+        BenchmarkStats::mannWhitneyU({ 1, 2, 2, 3, 4 }, { 2, 3, 5, 6, 7, 7 });
+    QVERIFY(r.valid);
+    QVERIFY(!r.exact);
+    QCOMPARE(r.u, 4.5);
+    QVERIFY(qAbs(r.pValue - 0.0641466) < 1e-6);
+
+    // Nothing to rank apart
+    QCOMPARE(BenchmarkStats::mannWhitneyU({ 3, 3, 3 }, { 3, 3 }).pValue, 1.0);
+}
+
+void BenchmarkStatsTest::mannWhitneyNeedsTwoPerSide()
+{
+    QVERIFY(!BenchmarkStats::mannWhitneyU({ 1 }, { 2, 3, 4 }).valid);
+}
+
+void BenchmarkStatsTest::compareVerdicts()
+{
+    const BenchmarkResult base = makeResult(QStringLiteral("BM_A"),
+                                            { 100, 101, 99, 102, 100, 98, 101, 100, 99 });
+    const BenchmarkResult fast = makeResult(QStringLiteral("BM_A"),
+                                            { 80, 81, 79, 82, 80, 78, 81, 80, 79 });
+    const BenchmarkResult slow = makeResult(QStringLiteral("BM_A"),
+                                            { 120, 121, 119, 122, 120, 118, 121, 120, 119 });
+    const BenchmarkResult same = makeResult(QStringLiteral("BM_A"),
+                                            { 100.5, 99.5, 101.5, 98.5, 100.2, 99.8, 102.5, 97.5, 100.1 });
+
+    QList<BenchmarkComparison> c = BenchmarkStats::compare(base, fast);
+    QCOMPARE(c.size(), 1);
+    QCOMPARE(c.first().runName, QStringLiteral("BM_A"));
+    QCOMPARE(c.first().verdict, BenchmarkComparison::Verdict::Faster);
+    QVERIFY(qAbs(c.first().change - (-0.2)) < 1e-12);
+    QVERIFY(c.first().pValue < BenchmarkStats::ALPHA);
+
+    QCOMPARE(BenchmarkStats::compare(base, slow).first().verdict,
+             BenchmarkComparison::Verdict::Slower);
+    QCOMPARE(BenchmarkStats::compare(base, same).first().verdict,
+             BenchmarkComparison::Verdict::NoSignificantDifference);
+
+    // One repetition each: the medians still differ, significance is unknown
+    c = BenchmarkStats::compare(makeResult(QStringLiteral("BM_A"), { 100 }),
+                                makeResult(QStringLiteral("BM_A"), { 50 }));
+    QCOMPARE(c.first().verdict, BenchmarkComparison::Verdict::InsufficientData);
+    QVERIFY(qAbs(c.first().change - (-0.5)) < 1e-12);
+
+    // Benchmarks only one side has are not compared
+    QVERIFY(BenchmarkStats::compare(base, makeResult(QStringLiteral("BM_B"), { 1, 2 })).isEmpty());
+}
+
+void BenchmarkStatsTest::runArguments()
+{
+    QVERIFY(BenchmarkRunner::runArguments(BenchmarkRunOptions()).isEmpty());
+
+    BenchmarkRunOptions options;
+    options.repetitions        = 10;
+    options.minTimeSec         = 0.25;
+    options.randomInterleaving = true;
+    QCOMPARE(BenchmarkRunner::runArguments(options),
+             (QStringList{ QStringLiteral("--benchmark_repetitions=10"),
+                           QStringLiteral("--benchmark_min_time=0.25"),
+                           QStringLiteral("--benchmark_enable_random_interleaving=true") }));
+}
+
+void BenchmarkStatsTest::entryJsonRoundTrip()
+{
+    const BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kRepetitionsJson));
+    for (const BenchmarkEntry& e : r.benchmarks) {
+        const BenchmarkEntry back = BenchmarkRunner::entryFromJson(BenchmarkRunner::entryToJson(e));
+        QCOMPARE(back.name, e.name);
+        QCOMPARE(back.runName, e.runName);
+        QCOMPARE(back.runType, e.runType);
+        QCOMPARE(back.aggregateName, e.aggregateName);
+        QCOMPARE(back.repetitionIndex, e.repetitionIndex);
+        QCOMPARE(back.realTimeNs, e.realTimeNs);
+        QCOMPARE(back.counters, e.counters);
+    }
+}
+
+void BenchmarkStatsTest::filterMatchesOneRun()
+{
+    QCOMPARE(BenchmarkRunner::filterForRun(QStringLiteral("BM_Sum/8")),
+             QStringLiteral("^BM_Sum/8$"));
+    QCOMPARE(BenchmarkRunner::filterForRun(QStringLiteral("BM_Vec<int>/1024/threads:2")),
+             QStringLiteral("^BM_Vec<int>/1024/threads:2$"));
+    QCOMPARE(BenchmarkRunner::filterForRun(QStringLiteral("BM_F(x)/min_time:0.5")),
+             QStringLiteral("^BM_F\\(x\\)/min_time:0\\.5$"));
+}
+
+void BenchmarkStatsTest::appendRepetitionsContinuesIndices()
+{
+    QList<BenchmarkEntry> entries =
+        BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kRepetitionsJson)).benchmarks;
+    entries = entries.mid(0, 3);
+
+    // A filtered re-run: two more repetitions plus its own aggregates
+    BenchmarkResult batch = makeResult(QStringLiteral("BM_Sum/8"), { 11.0, 13.0 });
+    BenchmarkEntry mean = batch.benchmarks.first();
+    mean.runType       = QStringLiteral("aggregate");
+    mean.aggregateName = QStringLiteral("mean");
+    batch.benchmarks << mean;
+
+    BenchmarkRunner::appendRepetitions(entries, batch.benchmarks);
+    QCOMPARE(entries.size(), 5);
+    for (int i = 0; i < entries.size(); ++i) {
+        QVERIFY(!entries[i].isAggregate());
+        QCOMPARE(entries[i].repetitionIndex, i);
+        QCOMPARE(entries[i].repetitions, 5);
+    }
+    QCOMPARE(BenchmarkStats::summarize(entries).first().median, 12.0);
+}
+
+void BenchmarkStatsTest::convergenceTargets()
+{
+    BenchmarkRunOptions options;
+    options.adaptive      = true;
+    options.targetCv      = 0.02;
+    options.targetCiWidth = 0.02;
+
+    const QList<BenchmarkSummary> stable = BenchmarkStats::summarize(
+        makeResult(QStringLiteral("BM_A"), { 100, 100.5, 99.5, 100.2, 99.8 }).benchmarks);
+    QVERIFY(BenchmarkStats::isConverged(stable.first(), options));
+
+    const QList<BenchmarkSummary> noisy = BenchmarkStats::summarize(
+        makeResult(QStringLiteral("BM_A"), { 100, 130, 80, 115, 90 }).benchmarks);
+    QVERIFY(!BenchmarkStats::isConverged(noisy.first(), options));
+
+    // One repetition says nothing about stability
+    const QList<BenchmarkSummary> single = BenchmarkStats::summarize(
+        makeResult(QStringLiteral("BM_A"), { 100 }).benchmarks);
+    QVERIFY(!BenchmarkStats::isConverged(single.first(), options));
+
+    // The first adaptive batch always has enough repetitions to judge
+    QCOMPARE(BenchmarkRunner::runArguments(options),
+             QStringList{ QStringLiteral("--benchmark_repetitions=%1")
+                              .arg(BenchmarkRunner::ADAPTIVE_MIN_REPETITIONS) });
+}
+
+void BenchmarkStatsTest::parsesCpuLists()
+{
+    bool ok = false;
+    QCOMPARE(BenchmarkRunner::parseCpuList(QStringLiteral("3, 2,2"), &ok), (QList<int>{ 2, 3 }));
+    QVERIFY(ok);
+    QCOMPARE(BenchmarkRunner::parseCpuList(QStringLiteral("0-3,6"), &ok),
+             (QList<int>{ 0, 1, 2, 3, 6 }));
+    QVERIFY(ok);
+    QVERIFY(BenchmarkRunner::parseCpuList(QString(), &ok).isEmpty());
+    QVERIFY(ok);
+
+    for (const QString& bad : { QStringLiteral("x"), QStringLiteral("3-1"),
+                                QStringLiteral("-1"), QStringLiteral("1-2-3"),
+                                QStringLiteral("4096") }) {
+        QVERIFY(BenchmarkRunner::parseCpuList(bad, &ok).isEmpty());
+        QVERIFY2(!ok, qPrintable(bad));
+    }
+
+    QCOMPARE(BenchmarkRunner::formatCpuList({ 0, 1, 2, 3, 6, 8, 9 }), QStringLiteral("0-3,6,8,9"));
+}
+
+void BenchmarkStatsTest::parsesContext()
+{
+    const BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kContextJson));
+    const BenchmarkContext& c = r.context;
+    QCOMPARE(c.hostName, QStringLiteral("bench-box"));
+    QCOMPARE(c.numCpus, 8);
+    QCOMPARE(c.mhzPerCpu, 2800.0);
+    QVERIFY(c.cpuScalingKnown);
+    QVERIFY(c.cpuScalingEnabled);
+    QCOMPARE(c.loadAvg, (QList<double>{ 2.5, 1.0, 0.5 }));
+    QCOMPARE(c.caches.size(), 2);
+    QCOMPARE(c.caches[1].size, qint64(8388608));
+    QCOMPARE(c.libraryBuildType, QStringLiteral("debug"));
+    QCOMPARE(BenchmarkRunner::describeMachine(c),
+             QStringLiteral("bench-box · 8 × 2800 MHz · L1d 32 KiB · L3 8 MiB · debug"));
+
+    BenchmarkContext copy = BenchmarkRunner::contextFromJson(BenchmarkRunner::contextToJson(c));
+    QVERIFY(copy.sameMachine(c));
+    QCOMPARE(copy.loadAvg, c.loadAvg);
+    QCOMPARE(copy.libraryVersion, c.libraryVersion);
+
+    copy.caches.removeLast();
+    QVERIFY(!copy.sameMachine(c));
+}
+
+void BenchmarkStatsTest::noiseWarnings()
+{
+    BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kContextJson));
+    r.optimizationLevel = QStringLiteral("O2");
+    // Scaling, load and debug library
+    QCOMPARE(BenchmarkRunner::noiseWarnings(r).size(), 3);
+
+    r.context.cpuScalingEnabled = false;
+    r.context.governor          = QStringLiteral("performance");
+    r.context.loadAvg           = { 0.2, 0.2, 0.2 };
+    r.context.libraryBuildType  = QStringLiteral("release");
+    QVERIFY(BenchmarkRunner::noiseWarnings(r).isEmpty());
+
+    r.context.governor = QStringLiteral("powersave");
+    QCOMPARE(BenchmarkRunner::noiseWarnings(r).size(), 1);
+    QVERIFY(BenchmarkRunner::noiseWarnings(r).first().contains(QStringLiteral("powersave")));
+
+    // Asked for, but the process ran unpinned
+    r.context.governor   = QStringLiteral("performance");
+    r.options.pinnedCpus = { 2 };
+    QCOMPARE(BenchmarkRunner::noiseWarnings(r).size(), 1);
+    r.context.pinnedCpus = QStringLiteral("2");
+    QVERIFY(BenchmarkRunner::noiseWarnings(r).isEmpty());
+}
+
+void BenchmarkStatsTest::parsesPerfCounters()
+{
+    const BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kPerfCountersJson));
+    const BenchmarkEntry& first = r.benchmarks.first();
+    QVERIFY(first.hasPerfCounters());
+    QCOMPARE(first.cycles, 40.0);
+    QCOMPARE(first.branchMisses, 1.0);
+    // Counters are fields, not user counters
+    QVERIFY(first.counters.isEmpty());
+    QCOMPARE(BenchmarkRunner::entryFromJson(BenchmarkRunner::entryToJson(first)).cacheMisses, 0.5);
+
+    const BenchmarkSummary s = BenchmarkStats::summarize(r.benchmarks).first();
+    QCOMPARE(s.cycles, 50.0);
+    QCOMPARE(s.instructions, 80.0);
+    QCOMPARE(BenchmarkStats::metricValue(s, BenchmarkMetric::Ipc), 1.6);
+    QCOMPARE(BenchmarkStats::metricValue(s, BenchmarkMetric::CacheMisses), 1.0);
+    QCOMPARE(BenchmarkStats::metricValue(s, BenchmarkMetric::BranchMissRate), 10.0);
+
+    // Without counters every derived metric is missing
+    const BenchmarkSummary plain = BenchmarkStats::summarize(
+        makeResult(QStringLiteral("BM_A"), { 1, 2 }).benchmarks).first();
+    QVERIFY(!plain.hasPerfCounters());
+    QVERIFY(BenchmarkStats::metricValue(plain, BenchmarkMetric::Ipc) < 0);
+    QVERIFY(BenchmarkStats::metricValue(plain, BenchmarkMetric::BranchMissRate) < 0);
+
+    BenchmarkRunOptions options;
+    options.perfCounters = true;
+    QVERIFY(BenchmarkRunner::runArguments(options).first()
+                .startsWith(QStringLiteral("--benchmark_perf_counters=CYCLES,INSTRUCTIONS")));
+}
+
+void BenchmarkStatsTest::perfCountersNotes()
+{
+    QVERIFY(BenchmarkRunner::perfCountersNote(
+                QStringLiteral("***WARNING*** Performance counters not supported.\n"), 2)
+                .contains(QStringLiteral("libpfm")));
+    QVERIFY(BenchmarkRunner::perfCountersNote(QString(), 3)
+                .contains(QStringLiteral("perf_event_paranoid is 3")));
+    QVERIFY(BenchmarkRunner::perfCountersNote(
+                QStringLiteral("Perf counters are not supported in multi-threaded cases.\n"), 1)
+                .contains(QStringLiteral("multi-threaded")));
+    QVERIFY(BenchmarkRunner::perfCountersNote(
+                QStringLiteral("./src/perf_counters.h:53: PerfCounterValues: "
+                               "Check `(nr_counters_) <= (kMaxCounters)' failed.\n"), 1)
+                .contains(QStringLiteral("1.8")));
+    QVERIFY(!BenchmarkRunner::perfCountersNote(QString(), 1).isEmpty());
+}
+
+void BenchmarkStatsTest::parsesAllocations()
+{
+    const BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kAllocationsJson));
+    const BenchmarkEntry& push = r.benchmarks.first();
+    QVERIFY(push.hasAllocations());
+    QCOMPARE(push.allocsPerIteration, 8.0625);
+    QCOMPARE(push.maxBytesUsed, qint64(1192));
+    QCOMPARE(push.netHeapGrowth, qint64(0));
+    QVERIFY(push.counters.isEmpty());
+    // The memory-manager run is at most MEMORY_RUN_ITERATIONS long...
+    QCOMPARE(push.bytesPerIteration(), 16720.0 / BenchmarkEntry::MEMORY_RUN_ITERATIONS);
+    // ...and never longer than the timed run
+    QCOMPARE(r.benchmarks[1].bytesPerIteration(), 64.0);
+
+    const BenchmarkEntry copy = BenchmarkRunner::entryFromJson(BenchmarkRunner::entryToJson(push));
+    QCOMPARE(copy.totalAllocatedBytes, qint64(16720));
+    QCOMPARE(copy.allocsPerIteration, 8.0625);
+
+    const BenchmarkSummary s = BenchmarkStats::summarize(r.benchmarks).first();
+    QVERIFY(s.hasAllocations());
+    QCOMPARE(BenchmarkStats::metricValue(s, BenchmarkMetric::Allocations), 8.0625);
+    QCOMPARE(BenchmarkStats::metricValue(s, BenchmarkMetric::BytesAllocated), 1045.0);
+    QCOMPARE(s.peakBytes, 1192.0);
+
+    QVERIFY(!makeResult(QStringLiteral("BM_A"), { 1 }).benchmarks.first().hasAllocations());
+}
+
+void BenchmarkStatsTest::parsesNameParts()
+{
+    QJsonObject obj;
+    obj[QStringLiteral("name")]         = QStringLiteral("BM_Work/size:1000/7/real_time/threads:4");
+    obj[QStringLiteral("family_index")] = 2;
+    obj[QStringLiteral("per_family_instance_index")] = 5;
+    const BenchmarkEntry e = BenchmarkRunner::entryFromJson(obj);
+    QCOMPARE(e.family, QStringLiteral("BM_Work"));
+    QCOMPARE(e.args, (QList<qint64>{ 1000, 7 }));
+    QCOMPARE(e.argNames, (QStringList{ QStringLiteral("size"), QString() }));
+    // No "threads" key: taken from the name
+    QCOMPARE(e.threads, 4);
+    QCOMPARE(e.familyIndex, 2);
+    QCOMPARE(e.instanceIndex, 5);
+    QCOMPARE(e.scalingName(), QStringLiteral("BM_Work/size:1000/7/real_time"));
+
+    const BenchmarkEntry copy = BenchmarkRunner::entryFromJson(BenchmarkRunner::entryToJson(e));
+    QCOMPARE(copy.threads, 4);
+    QCOMPARE(copy.instanceIndex, 5);
+    QVERIFY(copy.counters.isEmpty());
+
+    QJsonObject capture;
+    capture[QStringLiteral("name")] = QStringLiteral("BM_Parse/short_string");
+    QVERIFY(BenchmarkRunner::entryFromJson(capture).args.isEmpty());
+}
+
+void BenchmarkStatsTest::threadScalingAndAmdahl()
+{
+    // Amdahl with a 10% serial part: speedup(n) = 1 / (0.1 + 0.9 / n)
+    QList<BenchmarkEntry> entries;
+    for (int threads : { 1, 2, 4, 8 }) {
+        BenchmarkEntry e;
+        e.name = e.runName = QStringLiteral("BM_Lock/64/threads:%1").arg(threads);
+        e.threads    = threads;
+        e.realTimeNs = 100.0 * (0.1 + 0.9 / threads);
+        e.timeUnit   = QStringLiteral("ns");
+        e.iterations = 1000;
+        entries << e;
+    }
+    BenchmarkEntry other;
+    other.name = other.runName = QStringLiteral("BM_Single/64");
+    other.realTimeNs = 5.0;
+    other.timeUnit   = QStringLiteral("ns");
+    entries << other;
+
+    const QList<ScalingSeries> scaling = BenchmarkStats::scaling(entries);
+    QCOMPARE(scaling.size(), 1);
+    const ScalingSeries& s = scaling.first();
+    QCOMPARE(s.name, QStringLiteral("BM_Lock/64"));
+    QCOMPARE(s.points.size(), 4);
+    QCOMPARE(s.points[0].speedup, 1.0);
+    QVERIFY(qAbs(s.points[3].speedup - 1.0 / (0.1 + 0.9 / 8)) < 1e-9);
+    QVERIFY(qAbs(s.points[3].efficiency - s.points[3].speedup / 8) < 1e-12);
+    QVERIFY(s.hasFit());
+    QVERIFY(qAbs(s.serialFraction - 0.1) < 1e-9);
+    QVERIFY(qAbs(s.amdahlSpeedup(4) - s.points[2].speedup) < 1e-9);
+
+    // Without a 1-thread point there is nothing to fit against
+    QList<ScalingPoint> fromTwo = s.points.mid(1);
+    QCOMPARE(BenchmarkStats::fitAmdahl(fromTwo), -1.0);
+}
+
+void BenchmarkStatsTest::injectsThreadRange()
+{
+    const QString source = QStringLiteral(
+        "// BENCHMARK(BM_Commented);\n"
+        "BENCHMARK(BM_A)->Arg(8);\n"
+        "BENCHMARK(BM_B)->Threads(2);\n"
+        "BENCHMARK_CAPTURE(BM_C, tiny, std::string(\"x\"))\n"
+        "    ->Arg(1);\n"
+        "BENCHMARK_TEMPLATE(BM_D, std::vector<int>);\n"
+        "BENCHMARK_MAIN();\n");
+    const QString swept = BenchmarkRunner::injectThreadRange(source, 4);
+    QCOMPARE(swept, QStringLiteral(
+        "// BENCHMARK(BM_Commented);\n"
+        "BENCHMARK(BM_A)->ThreadRange(1, 4)->Arg(8);\n"
+        "BENCHMARK(BM_B)->Threads(2);\n"
+        "BENCHMARK_CAPTURE(BM_C, tiny, std::string(\"x\"))->ThreadRange(1, 4)\n"
+        "    ->Arg(1);\n"
+        "BENCHMARK_TEMPLATE(BM_D, std::vector<int>)->ThreadRange(1, 4);\n"
+        "BENCHMARK_MAIN();\n"));
+    QCOMPARE(swept.count(QLatin1Char('\n')), source.count(QLatin1Char('\n')));
+}
+
+void BenchmarkStatsTest::parameterSweeps()
+{
+    const BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kSweepJson));
+    // The fit rows are not benchmarks of their own
+    for (const BenchmarkSummary& s : BenchmarkStats::summarize(r.benchmarks))
+        QVERIFY(s.runName != QLatin1String("BM_Fill/real_time"));
+
+    const QList<ParameterSweep> sweeps = BenchmarkStats::sweeps(r.benchmarks);
+    QCOMPARE(sweeps.size(), 3);   // BM_Single has a single run
+
+    const ParameterSweep& fill = sweeps[0];
+    QCOMPARE(fill.name, QStringLiteral("BM_Fill/*/real_time"));
+    QCOMPARE(fill.family, QStringLiteral("BM_Fill"));
+    QCOMPARE(fill.dimensions, QStringList{ QStringLiteral("range(0)") });
+    QCOMPARE(fill.points.size(), 2);
+    QCOMPARE(fill.points[1].coords, QList<qint64>{ 64 });
+    QCOMPARE(fill.points[1].summary.median, 127.0);
+    QVERIFY(fill.hasFit());
+    QCOMPARE(fill.fit.bigO, QStringLiteral("N"));
+    QCOMPARE(fill.fit.rms, 0.05);
+    QCOMPARE(fill.fit.predictNs(64), 128.0);
+
+    const ParameterSweep& grid = sweeps[1];
+    QCOMPARE(grid.name, QStringLiteral("BM_2D/rows:*/cols:*"));
+    QCOMPARE(grid.dimensions, (QStringList{ QStringLiteral("rows"), QStringLiteral("cols") }));
+    QCOMPARE(grid.points.size(), 4);
+    // Ascending by (rows, cols), whatever order the library ran them in
+    QCOMPARE(grid.points[1].coords, (QList<qint64>{ 1, 8 }));
+    QCOMPARE(grid.points[2].coords, (QList<qint64>{ 4, 2 }));
+    QVERIFY(!grid.hasFit());
+
+    // An argument that never changes stays in the name
+    const ParameterSweep& fixed = sweeps[2];
+    QCOMPARE(fixed.name, QStringLiteral("BM_Fixed/3/*"));
+    QCOMPARE(fixed.dimensions, QStringList{ QStringLiteral("range(1)") });
+    QCOMPARE(fixed.points.first().coords, QList<qint64>{ 16 });
+
+    // Round trip keeps the fit rows
+    const BenchmarkEntry bigO = BenchmarkRunner::entryFromJson(
+        BenchmarkRunner::entryToJson(r.benchmarks[2]));
+    QVERIFY(bigO.isComplexityFit());
+    QCOMPARE(bigO.bigO, QStringLiteral("N"));
+    QCOMPARE(bigO.realCoefficient, 2.0);
+}
+
+void BenchmarkStatsTest::complexityFit()
+{
+    ComplexityFit fit;
+    fit.coefficientNs = 1.0;
+    fit.bigO = QStringLiteral("NlgN");
+    QCOMPARE(fit.predictNs(8), 24.0);
+    fit.bigO = QStringLiteral("N^2");
+    QCOMPARE(fit.predictNs(8), 64.0);
+    fit.bigO = QStringLiteral("lgN");
+    QVERIFY(fit.canEvaluate());
+    QCOMPARE(fit.predictNs(1), 0.0);
+    fit.bigO = QStringLiteral("(1)");
+    QCOMPARE(fit.predictNs(1000), 1.0);
+    // Lambda complexities print as f(N): nothing to draw
+    fit.bigO = QStringLiteral("f(N)");
+    QVERIFY(!fit.canEvaluate());
+
+    const BenchmarkResult r = BenchmarkRunner::parseJsonOutput(QString::fromUtf8(kSweepJson));
+    const QList<ComplexityFit> fits = BenchmarkStats::complexityFits(r.benchmarks);
+    QCOMPARE(fits.size(), 1);
+    QCOMPARE(fits.first().runName, QStringLiteral("BM_Fill/real_time"));
+    QCOMPARE(fits.first().coefficientNs, 2.0);
+}
+
+void BenchmarkStatsTest::downsamplesKeepingPeaks()
+{
+    QList<QPointF> points;
+    for (int i = 0; i < 1000; ++i) points << QPointF(i, i == 501 ? 100.0 : std::sin(i / 50.0));
+
+    const QList<int> kept = BenchmarkStats::downsample(points, 50);
+    QCOMPARE(kept.size(), 50);
+    QCOMPARE(kept.first(), 0);
+    QCOMPARE(kept.last(), 999);
+    QVERIFY(std::is_sorted(kept.cbegin(), kept.cend()));
+    QVERIFY(kept.contains(501));
+
+    QCOMPARE(BenchmarkStats::downsample(points.mid(0, 10), 50).size(), 10);
+    QCOMPARE(BenchmarkStats::downsample(points, 2).size(), 1000);
+}
+
+QTEST_MAIN(BenchmarkStatsTest)
+#include "test_benchmark_stats.moc"
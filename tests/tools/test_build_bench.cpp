@@ -0,0 +1,209 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "compiler/CompilerRegistry.h"
+#include "compiler/GccCompiler.h"
+#include "tools/BuildBenchRunner.h"
+#include "tools/ProcessMeter.h"
+
+#include <thread>
+#include <vector>
+
+class BuildBenchTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        // Keep the real probe cache out of the way
+        QStandardPaths::setTestModeEnabled(true);
+    }
+
+    // ── Statistics ───────────────────────────────────────────────────────────
+
+    void summarizeComputesSampleStddev()
+    {
+        const BuildBenchStats stats = BuildBenchRunner::summarize({ 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 });
+        QCOMPARE(stats.count, 8);
+        QCOMPARE(stats.mean, 5.0);
+        QCOMPARE(stats.min, 2.0);
+        QCOMPARE(stats.max, 9.0);
+        QVERIFY(qAbs(stats.stddev - 2.13809) < 1e-4);   // sqrt(32 / 7)
+    }
+
+    void summarizeHandlesTinyInputs()
+    {
+        QCOMPARE(BuildBenchRunner::summarize({}).count, 0);
+        const BuildBenchStats one = BuildBenchRunner::summarize({ 3.5 });
+        QCOMPARE(one.mean, 3.5);
+        QCOMPARE(one.stddev, 0.0);
+    }
+
+    void speedupIsRelativeToFirstSnippetPerConfiguration()
+    {
+        auto makeCase = [](const QString& snippet, const QString& opt, double wall) {
+            BuildBenchCase c;
+            c.snippet = snippet;
+            c.compilerId = "gcc-system";
+            c.standard = "c++20";
+            c.optimization = opt;
+            c.success = true;
+            c.wallMs.count = 1;
+            c.wallMs.mean = wall;
+            return c;
+        };
+        QList<BuildBenchCase> cases = {
+            makeCase("templates", "O0", 200), makeCase("constexpr", "O0", 100),
+            makeCase("templates", "O2", 300), makeCase("constexpr", "O2", 600),
+        };
+        BuildBenchRunner::computeSpeedups(cases);
+        QCOMPARE(cases[0].speedup, 1.0);
+        QCOMPARE(cases[1].speedup, 2.0);
+        QCOMPARE(cases[2].speedup, 1.0);
+        QCOMPARE(cases[3].speedup, 0.5);
+    }
+
+    // ── ProcessMeter ─────────────────────────────────────────────────────────
+
+    void meterReportsExitCodeAndStderr()
+    {
+#ifdef Q_OS_UNIX
+        const ProcessUsage usage =
+            ProcessMeter::run("sh", { "-c", "echo oops >&2; exit 3" });
+        QVERIFY(usage.started);
+        QCOMPARE(usage.exitCode, 3);
+        QVERIFY(!usage.succeeded());
+        QCOMPARE(usage.standardError.trimmed(), QByteArray("oops"));
+        QVERIFY(usage.wallMs > 0);
+        QVERIFY(usage.userMs >= 0);
+        QVERIFY(usage.peakRssKb > 0);
+#else
+        QSKIP("Needs a POSIX shell");
+#endif
+    }
+
+    void meterReportsMissingProgram()
+    {
+        const ProcessUsage usage = ProcessMeter::run("cppatlas-no-such-program", {});
+        QVERIFY(!usage.started);
+        QVERIFY(!usage.errorString.isEmpty());
+    }
+
+    void meterHonoursTimeout()
+    {
+#ifdef Q_OS_UNIX
+        const ProcessUsage usage = ProcessMeter::run("sleep", { "5" }, -1, 200);
+        QVERIFY(usage.timedOut);
+        QVERIFY(!usage.succeeded());
+        QVERIFY(usage.wallMs < 4000);
+#else
+        QSKIP("Needs sleep(1)");
+#endif
+    }
+
+    void meterKillsTheWholeProcessGroup()
+    {
+#ifdef Q_OS_UNIX
+        // The background sleep holds stderr open like cc1plus under the g++ driver
+        const ProcessUsage usage = ProcessMeter::run("sh", { "-c", "sleep 30 & wait" }, -1, 200);
+        QVERIFY(usage.timedOut);
+        QVERIFY(usage.wallMs < 4000);
+#else
+        QSKIP("Needs a POSIX shell");
+#endif
+    }
+
+    void concurrentMetersDoNotStretchEachOther()
+    {
+#ifdef Q_OS_UNIX
+        // Slow runs fork while short runs have their pipes open; a slow
+        // child inheriting one would hold its EOF back for 2 s
+        constexpr int WORKERS = 8;
+        constexpr int SHORT_RUNS = 20;
+        std::vector<ProcessUsage> shortUsage(WORKERS * SHORT_RUNS);
+        std::vector<ProcessUsage> slowUsage(WORKERS);
+        std::vector<std::thread> threads;
+        for (int w = 0; w < WORKERS; ++w) {
+            threads.emplace_back([&shortUsage, w]() {
+                for (int i = 0; i < SHORT_RUNS; ++i)
+                    shortUsage[w * SHORT_RUNS + i] = ProcessMeter::run("true", {});
+            });
+            threads.emplace_back([&slowUsage, w]() {
+                slowUsage[w] = ProcessMeter::run("sleep", { "2" });
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+
+        for (const ProcessUsage& usage : shortUsage) {
+            QVERIFY(usage.succeeded());
+            QVERIFY2(usage.wallMs < 1000, qPrintable(QString::number(usage.wallMs)));
+        }
+        for (const ProcessUsage& usage : slowUsage) {
+            QVERIFY(usage.succeeded());
+            QVERIFY(usage.wallMs >= 1900);
+        }
+#else
+        QSKIP("Needs a POSIX shell");
+#endif
+    }
+
+    // ── Runner ───────────────────────────────────────────────────────────────
+
+    void cancelReturnsPromptly()
+    {
+#ifdef Q_OS_UNIX
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString compiler = dir.filePath("slow-g++");
+        const QString marker = dir.filePath("started");
+        QFile script(compiler);
+        QVERIFY(script.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        script.write(QString("#!/bin/sh\n"
+                             "if [ \"$1\" = \"--version\" ]; then echo 'g++ (GCC) 13.2.0'; exit 0; fi\n"
+                             "touch '%1'\n"
+                             "sleep 30 &\n"
+                             "wait\n").arg(marker).toUtf8());
+        script.close();
+        script.setPermissions(script.permissions() | QFileDevice::ExeOwner | QFileDevice::ExeUser);
+        CompilerRegistry::instance().registerCompiler(
+            QSharedPointer<ICompiler>(new GccCompiler(compiler, "build-bench-slow")));
+
+        BuildBenchConfig config;
+        config.snippets = { { "a", "int a;" }, { "b", "int b;" } };
+        config.compilerIds = { "build-bench-slow" };
+        config.standards = { "c++17" };
+        config.optimizationLevels = { "O0" };
+        config.repetitions = 3;
+        config.parallel = true;
+
+        BuildBenchRunner runner;
+        int finishedCount = 0;
+        bool wasCancelled = false;
+        connect(&runner, &BuildBenchRunner::finished, this,
+                [&](const QList<BuildBenchCase>&, bool cancelled) {
+                    ++finishedCount;
+                    wasCancelled = cancelled;
+                });
+        QVERIFY(runner.start(config));
+        QTRY_VERIFY_WITH_TIMEOUT(QFile::exists(marker), 5000);
+
+        QElapsedTimer timer;
+        timer.start();
+        runner.cancel();
+        QVERIFY(timer.elapsed() < 100);   // Does not wait for the workers
+        QVERIFY(runner.isRunning());
+
+        QTRY_COMPARE_WITH_TIMEOUT(finishedCount, 1, 4000);
+        QVERIFY(wasCancelled);
+        QVERIFY(!runner.isRunning());
+        QVERIFY(timer.elapsed() < 4000);
+
+        CompilerRegistry::instance().unregisterCompiler("build-bench-slow");
+#else
+        QSKIP("Needs a POSIX shell");
+#endif
+    }
+};
+
+QTEST_MAIN(BuildBenchTest)
+#include "test_build_bench.moc"
@@ -0,0 +1,111 @@
+#include <QtTest/QtTest>
+#include "tools/CompileProfileRunner.h"
+
+class CompileProfileTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // ── Clang -ftime-trace ───────────────────────────────────────────────────
+
+    void timeTraceRanksAndNests()
+    {
+        const QByteArray trace = R"({"traceEvents":[
+            {"ph":"X","pid":1,"tid":7,"ts":1000,"dur":9000,"name":"ExecuteCompiler"},
+            {"ph":"X","pid":1,"tid":7,"ts":1000,"dur":6000,"name":"Frontend"},
+            {"ph":"X","pid":1,"tid":7,"ts":1100,"dur":4000,"name":"Source","args":{"detail":"/usr/include/c++/13/vector"}},
+            {"ph":"X","pid":1,"tid":7,"ts":1200,"dur":1000,"name":"Source","args":{"detail":"/usr/include/c++/13/bits/stl_vector.h"}},
+            {"ph":"X","pid":1,"tid":7,"ts":5200,"dur":700,"name":"InstantiateClass","args":{"detail":"std::vector<int>"}},
+            {"ph":"X","pid":1,"tid":7,"ts":6000,"dur":300,"name":"InstantiateClass","args":{"detail":"std::vector<int>"}},
+            {"ph":"X","pid":1,"tid":7,"ts":7100,"dur":2500,"name":"OptFunction","args":{"detail":"main"}},
+            {"ph":"X","pid":1,"tid":8,"ts":0,"dur":6000,"name":"Total Frontend","args":{"count":1}},
+            {"ph":"X","pid":1,"tid":9,"ts":0,"dur":1000,"name":"Total InstantiateClass","args":{"count":2}},
+            {"ph":"M","pid":1,"tid":7,"ts":0,"name":"thread_name","args":{"name":"clang"}}
+        ]})";
+
+        const CompileProfile profile = CompileProfileRunner::parseTimeTrace(trace);
+        QVERIFY(profile.success);
+        QCOMPARE(profile.unit, CompileProfile::Unit::Microseconds);
+
+        // "Total" summaries are phases, not flame chart spans
+        QCOMPARE(profile.events.size(), 7);
+        QCOMPARE(profile.events.first().name, QString("ExecuteCompiler"));
+        QCOMPARE(profile.events.first().start, qint64(0));
+        QCOMPARE(profile.events.first().depth, 0);
+        for (const CompileProfileEvent& e : profile.events) {
+            if (e.detail.endsWith("stl_vector.h")) QCOMPARE(e.depth, 3);
+            if (e.name == "OptFunction")           QCOMPARE(e.depth, 1);
+        }
+
+        QCOMPARE(profile.headers.size(), 2);
+        QCOMPARE(profile.headers[0].name, QString("/usr/include/c++/13/vector"));
+        QCOMPARE(profile.headers[0].totalUs, qint64(4000));
+
+        QCOMPARE(profile.templates.size(), 1);
+        QCOMPARE(profile.templates[0].totalUs, qint64(1000));
+        QCOMPARE(profile.templates[0].count, 2);
+
+        QCOMPARE(profile.functions.size(), 1);
+        QCOMPARE(profile.functions[0].name, QString("main"));
+
+        QCOMPARE(profile.phases.size(), 2);
+        QCOMPARE(profile.phases[0].name, QString("Frontend"));
+        QCOMPARE(profile.phases[1].count, 2);
+    }
+
+    void timeTraceRejectsGarbage()
+    {
+        QVERIFY(!CompileProfileRunner::parseTimeTrace("not json").success);
+        QVERIFY(!CompileProfileRunner::parseTimeTrace(R"({"traceEvents":[]})").success);
+    }
+
+    // ── GCC -ftime-report -H ─────────────────────────────────────────────────
+
+    void gccReportIncludesAndPhases()
+    {
+        const QString stderrText =
+            ". /usr/include/c++/13/vector\n"
+            ".. /usr/include/c++/13/bits/stl_algobase.h\n"
+            "... /usr/include/c++/13/bits/functexcept.h\n"
+            ".. /usr/include/c++/13/bits/stl_vector.h\n"
+            ". /usr/include/c++/13/cstdio\n"
+            "Multiple include guards may be useful for:\n"
+            "/usr/include/x86_64-linux-gnu/bits/types.h\n"
+            "\n"
+            "Time variable                                  usr           sys          wall           GGC\n"
+            " phase setup                        :   0.00 (  0%)   0.00 (  0%)   0.01 (  2%)  1850k (  3%)\n"
+            " phase parsing                      :   0.30 ( 75%)   0.05 ( 83%)   0.36 ( 72%)    45M ( 80%)\n"
+            " template instantiation             :   0.08 ( 20%)   0.01 ( 17%)   0.09 ( 18%)  8000k ( 14%)\n"
+            " TOTAL                              :   0.40          0.06          0.50           56M\n";
+
+        const CompileProfile profile = CompileProfileRunner::parseGccReport(stderrText);
+        QVERIFY(profile.success);
+        QCOMPARE(profile.unit, CompileProfile::Unit::Headers);
+
+        QCOMPARE(profile.events.size(), 5);
+        QCOMPARE(profile.events[0].depth, 0);
+        QCOMPARE(profile.events[0].duration, qint64(4));   // itself + three nested headers
+        QCOMPARE(profile.events[1].duration, qint64(2));
+        QCOMPARE(profile.events[2].depth, 2);
+        QCOMPARE(profile.events[4].start, qint64(4));
+
+        QCOMPARE(profile.headers.first().name, QString("/usr/include/c++/13/vector"));
+        QCOMPARE(profile.headers.first().count, 4);
+
+        QCOMPARE(profile.phases.size(), 3);
+        QCOMPARE(profile.phases.first().name, QString("phase parsing"));
+        QCOMPARE(profile.phases.first().totalUs, qint64(360000));
+
+        QCOMPARE(profile.templates.size(), 1);
+        QCOMPARE(profile.templates.first().totalUs, qint64(90000));
+        QCOMPARE(profile.wallTimeUs, qint64(500000));
+    }
+
+    void gccReportWithoutProfileFails()
+    {
+        QVERIFY(!CompileProfileRunner::parseGccReport("a.cpp:1:1: error: boom\n").success);
+    }
+};
+
+QTEST_MAIN(CompileProfileTest)
+#include "test_compile_profile.moc"
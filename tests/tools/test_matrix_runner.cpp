@@ -0,0 +1,138 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "compiler/CompilerRegistry.h"
+#include "compiler/GccCompiler.h"
+#include "tools/MatrixRunner.h"
+
+class MatrixRunnerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        // Keep the real probe cache out of the way
+        QStandardPaths::setTestModeEnabled(true);
+    }
+
+    // ── Assembly statistics ──────────────────────────────────────────────────
+
+    void countsGccX86Instructions()
+    {
+        const QByteArray asmText =
+            "\t.file\t\"m.cpp\"\n"
+            "\t.text\n"
+            "\t.p2align 4\n"
+            "\t.globl\t_Z1fi\n"
+            "\t.type\t_Z1fi, @function\n"
+            "_Z1fi:\n"
+            ".LFB0:\n"
+            "\t.cfi_startproc\n"
+            "\tleal\t1(%rdi,%rdi,2), %eax\n"
+            "\tret\n"
+            "\t.cfi_endproc\n"
+            "\t.globl\tmain\n"
+            "\t.type\tmain, @function\n"
+            "main:\n"
+            "# %bb.0:\n"
+            "\tmovl\t$7, %eax\n"
+            "\tret\n";
+        const MatrixAsmStats stats = MatrixRunner::analyzeAssembly(asmText);
+        QCOMPARE(stats.instructions, 4);
+        QCOMPARE(stats.functions, 2);
+        QCOMPARE(stats.bytes, qint64(asmText.size()));
+    }
+
+    void countsArmAndMachOInstructions()
+    {
+        const QByteArray asmText =
+            "\t.globl\t_main\n"
+            "_main:                                  ; @main\n"
+            "; %bb.0:\n"
+            "\tmov\tw0, #7\n"
+            "// a comment\n"
+            "Ltmp0: ret\n";
+        const MatrixAsmStats stats = MatrixRunner::analyzeAssembly(asmText);
+        QCOMPARE(stats.instructions, 2);
+        QCOMPARE(stats.functions, 1);   // No .type — falls back to .globl
+    }
+
+    // ── Benchmark detection ──────────────────────────────────────────────────
+
+    void detectsGoogleBenchmarkSources()
+    {
+        QVERIFY(MatrixRunner::usesGoogleBenchmark("#include <benchmark/benchmark.h>\n"));
+        QVERIFY(MatrixRunner::usesGoogleBenchmark("int x;\n  #  include \"benchmark/benchmark.h\"\n"));
+        QVERIFY(!MatrixRunner::usesGoogleBenchmark("// #include <benchmark/benchmark.h>\n"));
+        QVERIFY(!MatrixRunner::usesGoogleBenchmark("#include <vector>\n"));
+    }
+
+    void benchmarkTimeIsNormalisedToNanoseconds()
+    {
+        MatrixCell cell;
+        BenchmarkEntry entry;
+        entry.name = "BM_Sort";
+        entry.realTimeNs = 2.5;
+        entry.timeUnit = "us";
+        cell.benchmark.benchmarks << entry;
+        QCOMPARE(cell.benchmarkNs("BM_Sort"), 2500.0);
+        QCOMPARE(cell.benchmarkNs("BM_Other"), -1.0);
+    }
+    // ── Runner ───────────────────────────────────────────────────────────────
+
+    void cancelReturnsPromptly()
+    {
+#ifdef Q_OS_UNIX
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString compiler = dir.filePath("slow-g++");
+        const QString marker = dir.filePath("started");
+        QFile script(compiler);
+        QVERIFY(script.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        script.write(QString("#!/bin/sh\n"
+                             "if [ \"$1\" = \"--version\" ]; then echo 'g++ (GCC) 13.2.0'; exit 0; fi\n"
+                             "touch '%1'\n"
+                             "sleep 30 &\n"
+                             "wait\n").arg(marker).toUtf8());
+        script.close();
+        script.setPermissions(script.permissions() | QFileDevice::ExeOwner | QFileDevice::ExeUser);
+        CompilerRegistry::instance().registerCompiler(
+            QSharedPointer<ICompiler>(new GccCompiler(compiler, "matrix-slow")));
+
+        MatrixConfig config;
+        config.sourceCode = "int main() {}\n";
+        config.compilerIds = { "matrix-slow" };
+        config.standards = { "c++17", "c++20" };
+        config.optimizationLevels = { "O0", "O2" };
+        config.marchTargets = { "" };
+
+        MatrixRunner runner;
+        int finishedCount = 0;
+        bool wasCancelled = false;
+        connect(&runner, &MatrixRunner::finished, this,
+                [&](const QList<MatrixCell>&, bool cancelled) {
+                    ++finishedCount;
+                    wasCancelled = cancelled;
+                });
+        QVERIFY(runner.start(config));
+        QTRY_VERIFY_WITH_TIMEOUT(QFile::exists(marker), 5000);
+
+        QElapsedTimer timer;
+        timer.start();
+        runner.cancel();
+        QVERIFY(timer.elapsed() < 100);   // Does not wait for the workers
+        QVERIFY(runner.isRunning());
+
+        QTRY_COMPARE_WITH_TIMEOUT(finishedCount, 1, 4000);
+        QVERIFY(wasCancelled);
+        QVERIFY(!runner.isRunning());
+
+        CompilerRegistry::instance().unregisterCompiler("matrix-slow");
+#else
+        QSKIP("Needs a POSIX shell");
+#endif
+    }
+};
+
+QTEST_MAIN(MatrixRunnerTest)
+#include "test_matrix_runner.moc"
@@ -0,0 +1,159 @@
+#include <QtTest/QtTest>
+#include "tools/McaRunner.h"
+
+namespace {
+
+// llvm-mca -mcpu=skylake on a load, an add and a store
+const char* const kReport =
+    "Iterations:        100\n"
+    "Instructions:      300\n"
+    "Total Cycles:      109\n"
+    "Total uOps:        300\n"
+    "\n"
+    "Dispatch Width:    6\n"
+    "uOps Per Cycle:    2.75\n"
+    "IPC:               2.75\n"
+    "Block RThroughput: 1.0\n"
+    "\n"
+    "\n"
+    "Instruction Info:\n"
+    "[1]: #uOps\n"
+    "[2]: Latency\n"
+    "[3]: RThroughput\n"
+    "[4]: MayLoad\n"
+    "[5]: MayStore\n"
+    "[6]: HasSideEffects (U)\n"
+    "\n"
+    "[1]    [2]    [3]    [4]    [5]    [6]    Instructions:\n"
+    " 1      5     0.50    *                   movl\t(%rdi), %eax\n"
+    " 1      1     0.25                        addl\t%eax, %edx\n"
+    " 1      1     1.00           *            movl\t%edx, 4(%rdi)\n"
+    "\n"
+    "\n"
+    "Resources:\n"
+    "[0]   - SKLDivider\n"
+    "[1]   - SKLFPDivider\n"
+    "[2]   - SKLPort0\n"
+    "[3]   - SKLPort1\n"
+    "[4]   - SKLPort2\n"
+    "[5]   - SKLPort3\n"
+    "[6]   - SKLPort4\n"
+    "[7]   - SKLPort5\n"
+    "[8]   - SKLPort6\n"
+    "[9]   - SKLPort7\n"
+    "\n"
+    "\n"
+    "Resource pressure per iteration:\n"
+    "[0]    [1]    [2]    [3]    [4]    [5]    [6]    [7]    [8]    [9]    \n"
+    " -      -     0.25   0.25   0.68   0.68   1.00   0.25   0.25   0.64   \n"
+    "\n"
+    "Resource pressure by instruction:\n"
+    "[0]    [1]    [2]    [3]    [4]    [5]    [6]    [7]    [8]    [9]    Instructions:\n"
+    " -      -      -      -     0.41   0.59    -      -      -      -     movl\t(%rdi), %eax\n"
+    " -      -     0.25   0.25    -      -      -     0.25   0.25    -     addl\t%eax, %edx\n"
+    " -      -      -      -     0.27   0.09   1.00    -      -     0.64   movl\t%edx, 4(%rdi)\n";
+
+} // namespace
+
+class McaRunnerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // ── Report parsing ───────────────────────────────────────────────────────
+
+    void parsesSummary()
+    {
+        const McaReport report = McaRunner::parseReport(QString::fromLatin1(kReport));
+        QVERIFY(report.valid);
+        QCOMPARE(report.iterations, 100);
+        QCOMPARE(report.instructionCount, 300);
+        QCOMPARE(report.totalCycles, qint64(109));
+        QCOMPARE(report.dispatchWidth, 6);
+        QCOMPARE(report.ipc, 2.75);
+        QCOMPARE(report.blockRThroughput, 1.0);
+    }
+
+    void parsesInstructionTableByColumn()
+    {
+        const McaReport report = McaRunner::parseReport(QString::fromLatin1(kReport));
+        QCOMPARE(report.instructions.size(), 3);
+
+        const McaInstruction& load = report.instructions[0];
+        QCOMPARE(load.text, QStringLiteral("movl\t(%rdi), %eax"));
+        QCOMPARE(load.uops, 1);
+        QCOMPARE(load.latency, 5);
+        QCOMPARE(load.rthroughput, 0.5);
+        QVERIFY(load.mayLoad);
+        QVERIFY(!load.mayStore);
+
+        const McaInstruction& store = report.instructions[2];
+        QVERIFY(!store.mayLoad);
+        QVERIFY(store.mayStore);
+        QVERIFY(!store.sideEffects);
+    }
+
+    void parsesResourcePressure()
+    {
+        const McaReport report = McaRunner::parseReport(QString::fromLatin1(kReport));
+        QCOMPARE(report.resources.size(), 10);
+        QCOMPARE(report.resources[2], QStringLiteral("SKLPort0"));
+        QCOMPARE(report.resourcePressure.size(), 10);
+        QCOMPARE(report.resourcePressure[0], 0.0);
+        QCOMPARE(report.resourcePressure[6], 1.0);
+        QCOMPARE(report.busiestResource(), 6);
+
+        QCOMPARE(report.instructions[1].pressure.size(), 10);
+        QCOMPARE(report.instructions[1].pressure[2], 0.25);
+        QCOMPARE(report.instructions[2].pressure[9], 0.64);
+    }
+
+    void groupedResourceUnitsGetDistinctNames()
+    {
+        const McaReport report = McaRunner::parseReport(QStringLiteral(
+            "Iterations:        100\r\n"
+            "\r\n"
+            "Resources:\r\n"
+            "[13]  - Zn3FPSt\r\n"
+            "[14.0] - Zn3LSU\r\n"
+            "[14.1] - Zn3LSU\r\n"
+            "\r\n"));
+        QCOMPARE(report.resources,
+                 QStringList({ "Zn3FPSt", "Zn3LSU.0", "Zn3LSU.1" }));
+    }
+
+    void outputWithoutSummaryIsInvalid()
+    {
+        QVERIFY(!McaRunner::parseReport(QString()).valid);
+        QVERIFY(!McaRunner::parseReport(
+            QStringLiteral("<stdin>:1:1: error: invalid instruction mnemonic 'foo'\n")).valid);
+    }
+
+    // ── Live analysis ────────────────────────────────────────────────────────
+
+    void analyzesBlockFromStdin()
+    {
+        McaRunner runner;
+        if (!runner.isAvailable()) QSKIP("llvm-mca not found");
+#ifndef Q_PROCESSOR_X86
+        QSKIP("Sample block is x86");
+#endif
+
+        QSignalSpy finished(&runner, &McaRunner::finished);
+        runner.analyze(QStringLiteral("mov eax, dword ptr [rdi]\nadd edx, eax\n"),
+                       QStringLiteral("skylake"), true);
+        QVERIFY(finished.wait(30000));
+        QCOMPARE(finished.size(), 1);
+        QVERIFY(finished.first().at(0).toBool());
+        QVERIFY(!runner.isRunning());
+
+        const McaReport report = McaRunner::parseReport(finished.first().at(1).toString());
+        QVERIFY(report.valid);
+        QCOMPARE(report.instructions.size(), 2);
+        QVERIFY(report.instructions[0].mayLoad);
+        QVERIFY(report.ipc > 0.0);
+    }
+};
+
+QTEST_MAIN(McaRunnerTest)
+#include "test_mca_runner.moc"
@@ -0,0 +1,146 @@
+#include <QtTest/QtTest>
+#include "tools/OptRemarksRunner.h"
+#include "compiler/CompilerRegistry.h"
+
+namespace {
+
+// g++ -O3 -c -fopt-info-all -x c++ -  (trimmed)
+const char* const kGccOutput =
+    "<stdin>:7:42: note: Considering inline candidate int sq(int)/0.\n"
+    "<stdin>:7:42: optimized:  Inlining int sq(int)/0 into int sum(const int*, int, int*)/2.\n"
+    "Unit growth for small function inlining: 28->28 (0%)\n"
+    "\n"
+    "<stdin>:3:23: optimized: loop vectorized using 16 byte vectors\n"
+    "<stdin>:7:45: missed: couldn't vectorize loop\n"
+    "<stdin>:7:45: missed: not vectorized: control flow in loop.\r\n";
+
+const char* const kOptRecord =
+    "--- !Passed\n"
+    "Pass:            inline\n"
+    "Name:            Inlined\n"
+    "DebugLoc:        { File: '<stdin>', Line: 7, Column: 14 }\n"
+    "Function:        _Z3sumPKii\n"
+    "Args:\n"
+    "  - String:          ''''\n"
+    "  - Callee:          _ZL2sqi\n"
+    "    DebugLoc:        { File: '<stdin>', Line: 1, Column: 0 }\n"
+    "  - String:          ''' inlined into '''\n"
+    "  - Caller:          _Z3sumPKii\n"
+    "    DebugLoc:        { File: '<stdin>', Line: 5, Column: 0 }\n"
+    "...\n"
+    "--- !Missed\n"
+    "Pass:            loop-vectorize\n"
+    "Name:            MissedDetails\n"
+    "DebugLoc:        { File: '<stdin>', Line: 7, Column: 5 }\n"
+    "Function:        _Z3sumPKii\n"
+    "Args:\n"
+    "  - String:          loop not vectorized\n"
+    "...\n"
+    "--- !AnalysisAliasing\n"
+    "Pass:            loop-vectorize\n"
+    "Name:            CantReorderMemOps\n"
+    "Function:        main\n"
+    "Args:\n"
+    "  - String:          \"loop not vectorized: cannot prove it is safe\"\n"
+    "...\n";
+
+} // namespace
+
+class OptRemarksRunnerTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase()
+    {
+        CompilerRegistry::instance().autoScanCompilers();
+    }
+
+    // ── GCC -fopt-info ───────────────────────────────────────────────────────
+
+    void parsesGccKindsAndLocations()
+    {
+        const QList<OptRemark> remarks =
+            OptRemarksRunner::parseGccOptInfo(QString::fromLatin1(kGccOutput));
+        QCOMPARE(remarks.size(), 5);   // Lines without a location are skipped
+
+        QCOMPARE(remarks[0].kind, OptRemark::Kind::Analysis);
+        QCOMPARE(remarks[1].kind, OptRemark::Kind::Passed);
+        QCOMPARE(remarks[1].file, QStringLiteral("<stdin>"));
+        QCOMPARE(remarks[1].line, 7);
+        QCOMPARE(remarks[1].column, 42);
+        QCOMPARE(remarks[2].kind, OptRemark::Kind::Passed);
+        QCOMPARE(remarks[4].kind, OptRemark::Kind::Missed);
+        QCOMPARE(remarks[4].message, QStringLiteral("not vectorized: control flow in loop."));
+    }
+
+    void cleansGccMessagesAndInfersPass()
+    {
+        const QList<OptRemark> remarks =
+            OptRemarksRunner::parseGccOptInfo(QString::fromLatin1(kGccOutput));
+        QCOMPARE(remarks[1].message,
+                 QStringLiteral("Inlining int sq(int) into int sum(const int*, int, int*)."));
+        QCOMPARE(remarks[1].pass, QStringLiteral("inline"));
+        QCOMPARE(remarks[2].pass, QStringLiteral("vectorize"));
+    }
+
+    // ── Clang optimization record ────────────────────────────────────────────
+
+    void parsesOptRecord()
+    {
+        const QList<OptRemark> remarks = OptRemarksRunner::parseOptRecord(kOptRecord);
+        QCOMPARE(remarks.size(), 3);
+
+        const OptRemark& inlined = remarks[0];
+        QCOMPARE(inlined.kind, OptRemark::Kind::Passed);
+        QCOMPARE(inlined.pass, QStringLiteral("inline"));
+        QCOMPARE(inlined.name, QStringLiteral("Inlined"));
+        QCOMPARE(inlined.line, 7);
+        QCOMPARE(inlined.column, 14);
+        QCOMPARE(inlined.function, QStringLiteral("sum(int const*, int)"));
+        QCOMPARE(inlined.message, QStringLiteral("'sq(int)' inlined into 'sum(int const*, int)'"));
+
+        QCOMPARE(remarks[1].kind, OptRemark::Kind::Missed);
+        QCOMPARE(remarks[1].message, QStringLiteral("loop not vectorized"));
+
+        // Analysis subkinds, double-quoted scalars, no DebugLoc
+        QCOMPARE(remarks[2].kind, OptRemark::Kind::Analysis);
+        QCOMPARE(remarks[2].line, 0);
+        QCOMPARE(remarks[2].message,
+                 QStringLiteral("loop not vectorized: cannot prove it is safe"));
+    }
+
+    // ── Live run ─────────────────────────────────────────────────────────────
+
+    void reportsVectorizedLoopForBuffer()
+    {
+        OptRemarksRunner runner;
+        if (!runner.isAvailable()) QSKIP("No compiler available");
+
+        QList<OptRemark> remarks;
+        int readyCount = 0;
+        connect(&runner, &OptRemarksRunner::remarksReady, this,
+                [&](const QList<OptRemark>& list) { remarks = list; ++readyCount; });
+        QSignalSpy finished(&runner, &OptRemarksRunner::finished);
+        runner.runSource(QStringLiteral("void scale(float* a, const float* b, int n) {\n"
+                                        "    for (int i = 0; i < n; ++i) a[i] = b[i] * 2.0f;\n"
+                                        "}\n"),
+                         { "-std=c++17", "-O3" });
+        QVERIFY(finished.wait(30000));
+        QVERIFY(finished.first().at(0).toBool());
+        QVERIFY(!runner.isRunning());
+        QCOMPARE(readyCount, 1);
+
+        bool vectorized = false;
+        for (const OptRemark& remark : remarks) {
+            if (remark.kind == OptRemark::Kind::Passed && remark.line == 2
+                && remark.message.contains(QLatin1String("vectoriz"))) {
+                vectorized = true;
+            }
+        }
+        QVERIFY(vectorized);
+    }
+};
+
+QTEST_MAIN(OptRemarksRunnerTest)
+#include "test_opt_remarks_runner.moc"
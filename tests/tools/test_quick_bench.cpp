@@ -0,0 +1,187 @@
+#include <QtTest/QtTest>
+#include "tools/QuickBench.h"
+
+namespace {
+
+void appendRuns(BenchmarkResult& result, const QString& name, const QList<double>& times) {
+    for (int i = 0; i < times.size(); ++i) {
+        BenchmarkEntry e;
+        e.name = e.runName = name;
+        e.runType         = QStringLiteral("iteration");
+        e.repetitions     = times.size();
+        e.repetitionIndex = i;
+        e.realTimeNs = e.cpuTimeNs = times[i];
+        e.iterations = 1000;
+        e.timeUnit   = QStringLiteral("ns");
+        result.benchmarks << e;
+    }
+}
+
+QList<QuickBenchSnippet> twoSnippets() {
+    return { { QStringLiteral("A"), QStringLiteral("return std::accumulate(v.begin(), v.end(), 0);") },
+             { QStringLiteral("B"), QStringLiteral("int s = 0;\nfor (int x : v) s += x;\nreturn s;") } };
+}
+
+} // namespace
+
+class QuickBenchTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void benchmarkNames();
+    void validatesSnippets();
+    void generatesHarness();
+    void warnsAboutUnusedResults();
+    void forcesInterleavedRepetitions();
+    void ratiosAgainstFirstSnippet();
+};
+
+void QuickBenchTest::initTestCase()
+{
+    // The harness template lives in the library's resources
+    Q_INIT_RESOURCE(resources);
+}
+
+void QuickBenchTest::benchmarkNames()
+{
+    QCOMPARE(QuickBench::benchmarkName(QStringLiteral("A")), QStringLiteral("BM_A"));
+    QCOMPARE(QuickBench::benchmarkName(QStringLiteral(" std::sort ")), QStringLiteral("BM_std__sort"));
+    QCOMPARE(QuickBench::benchmarkName(QStringLiteral("for-loop 2")), QStringLiteral("BM_for_loop_2"));
+}
+
+void QuickBenchTest::validatesSnippets()
+{
+    QList<QuickBenchSnippet> snippets = twoSnippets();
+    QVERIFY(QuickBench::validate(snippets).isEmpty());
+    QVERIFY(!QuickBench::validate(snippets.mid(0, 1)).isEmpty());
+
+    snippets[1].name = QStringLiteral("A");
+    QVERIFY(QuickBench::validate(snippets).contains(QStringLiteral("BM_A")));
+    snippets[1].name = QStringLiteral("B");
+    snippets[1].code = QStringLiteral("  \n");
+    QVERIFY(!QuickBench::validate(snippets).isEmpty());
+
+    QString error;
+    QVERIFY(QuickBench::generate(QString(), snippets, &error).isEmpty());
+    QVERIFY(error.contains(QStringLiteral("B")));
+}
+
+void QuickBenchTest::generatesHarness()
+{
+    const QString setup = QStringLiteral("#include <numeric>\n#include <vector>\n\n"
+                                         "std::vector<int> v(1000, 1);\n");
+    QString error;
+    const QString source = QuickBench::generate(setup, twoSnippets(), &error);
+    QVERIFY2(!source.isEmpty(), qPrintable(error));
+
+    QVERIFY(!source.contains(QStringLiteral("{{")));
+    QCOMPARE(source.count(QStringLiteral("BENCHMARK_MAIN();")), 1);
+    QVERIFY(source.contains(QStringLiteral("static void BM_A(benchmark::State& state) {")));
+    QVERIFY(source.contains(QStringLiteral("BENCHMARK(BM_B);")));
+    QCOMPARE(source.count(QStringLiteral("cppatlas_quick_bench::keep(snippet);")), 2);
+    QVERIFY(source.contains(QStringLiteral("benchmark::DoNotOptimize(result);")));
+
+    // Includes move to file scope, ahead of the first benchmark; the rest of
+    // the setup runs in every benchmark, on the pane's own line numbers
+    const int firstBenchmark = source.indexOf(QStringLiteral("static void BM_A"));
+    QVERIFY(source.indexOf(QStringLiteral("#include <numeric>")) < firstBenchmark);
+    QCOMPARE(source.count(QStringLiteral("#include <vector>")), 1);
+    QCOMPARE(source.count(QStringLiteral("    std::vector<int> v(1000, 1);")), 2);
+    QCOMPARE(source.count(QStringLiteral("#line 1 \"setup\"\n\n\n\n    std::vector<int>")), 2);
+    QVERIFY(source.contains(QStringLiteral("#line 1 \"B\"\n        int s = 0;\n        for (int x : v) s += x;")));
+
+    // After each pane, harness code (and BENCHMARK_MAIN) is back on the
+    // generated file's own line numbers
+    const QStringList lines = source.split(QLatin1Char('\n'));
+    const QRegularExpression harnessLine(QStringLiteral("^#line (\\d+) \"quick_bench\\.cpp\"$"));
+    int resets = 0;
+    for (int i = 0; i < lines.size(); ++i) {
+        const QRegularExpressionMatch m = harnessLine.match(lines[i]);
+        if (!m.hasMatch()) continue;
+        QCOMPARE(m.captured(1).toInt(), i + 2);
+        ++resets;
+    }
+    QCOMPARE(resets, 4);
+    QVERIFY(source.contains(QStringLiteral("        return s;\n#line ")));
+    const int lastReset = source.lastIndexOf(QStringLiteral("\"quick_bench.cpp\""));
+    QVERIFY(lastReset > source.lastIndexOf(QStringLiteral("#line 1 \"B\"")));
+    QVERIFY(lastReset < source.indexOf(QStringLiteral("BENCHMARK_MAIN();")));
+}
+
+void QuickBenchTest::warnsAboutUnusedResults()
+{
+    QList<QuickBenchSnippet> snippets = twoSnippets();
+    QVERIFY(QuickBench::warnings(snippets).isEmpty());
+
+    snippets[1].code = QStringLiteral("int s = 0;\nfor (int x : v) s += x;");
+    const QStringList warnings = QuickBench::warnings(snippets);
+    QCOMPARE(warnings.size(), 1);
+    QVERIFY(warnings.first().startsWith(QStringLiteral("B returns nothing")));
+
+    // "return" inside a longer identifier does not count
+    snippets[1].code = QStringLiteral("returned = v.size();");
+    QCOMPARE(QuickBench::warnings(snippets).size(), 1);
+}
+
+void QuickBenchTest::forcesInterleavedRepetitions()
+{
+    BenchmarkRunOptions options;
+    options.repetitions    = 3;
+    options.threadSweepMax = 8;
+    const BenchmarkRunOptions quick = QuickBench::runOptions(options);
+    QVERIFY(quick.randomInterleaving);
+    QCOMPARE(quick.repetitions, QuickBench::MIN_REPETITIONS);
+    QCOMPARE(quick.threadSweepMax, 0);
+
+    options.repetitions = 20;
+    QCOMPARE(QuickBench::runOptions(options).repetitions, 20);
+}
+
+void QuickBenchTest::ratiosAgainstFirstSnippet()
+{
+    QList<QuickBenchSnippet> snippets = twoSnippets();
+    snippets << QuickBenchSnippet{ QStringLiteral("C"), QStringLiteral("return 0;") }
+             << QuickBenchSnippet{ QStringLiteral("D"), QStringLiteral("return 1;") };
+
+    BenchmarkResult result;
+    appendRuns(result, QStringLiteral("BM_A"), { 100, 101, 99, 102, 100, 98, 101, 100, 99 });
+    appendRuns(result, QStringLiteral("BM_B"), { 50, 50.5, 49.5, 51, 50, 49, 50.5, 50, 49.5 });
+    appendRuns(result, QStringLiteral("BM_C"), { 150, 151, 149, 152, 150, 148, 151, 150, 149 });
+
+    // D did not run
+    const QList<QuickBenchRatio> ratios = QuickBench::ratios(result, snippets);
+    QCOMPARE(ratios.size(), 3);
+    QVERIFY(ratios[0].isReference());
+    QCOMPARE(ratios[0].speedup, 1.0);
+    QCOMPARE(ratios[0].text(), QStringLiteral("A is the reference"));
+
+    const QuickBenchRatio& b = ratios[1];
+    QCOMPARE(b.reference, QStringLiteral("A"));
+    QVERIFY(qAbs(b.speedup - 2.0) < 1e-12);
+    QVERIFY(b.isSignificant());
+    QVERIFY(b.ciLow <= b.speedup && b.speedup <= b.ciHigh);
+    QVERIFY(b.uncertainty() < 0.05);
+    QVERIFY2(b.text().startsWith(QStringLiteral("B is 2.00× faster than A ±")), qPrintable(b.text()));
+
+    QVERIFY2(ratios[2].text().startsWith(QStringLiteral("C is 1.50× slower than A ±")),
+             qPrintable(ratios[2].text()));
+
+    // Without repetitions there is a ratio but no test
+    BenchmarkResult single;
+    appendRuns(single, QStringLiteral("BM_A"), { 100 });
+    appendRuns(single, QStringLiteral("BM_B"), { 25 });
+    const QuickBenchRatio once = QuickBench::ratios(single, twoSnippets()).last();
+    QVERIFY(!once.tested);
+    QVERIFY(once.text().contains(QStringLiteral("4.00× faster")));
+    QVERIFY(once.text().contains(QStringLiteral("untested")));
+
+    // No reference, no ratios
+    BenchmarkResult noReference;
+    appendRuns(noReference, QStringLiteral("BM_B"), { 25 });
+    QVERIFY(QuickBench::ratios(noReference, twoSnippets()).isEmpty());
+}
+
+QTEST_MAIN(QuickBenchTest)
+#include "test_quick_bench.moc"
@@ -0,0 +1,101 @@
+#include <QtTest/QtTest>
+#include "tools/AsmParser.h"
+#include "tools/SourceHeat.h"
+
+namespace {
+
+// GCC -O1 -g: line 2 generates two instructions, line 3 one
+const char* const kListing =
+    "\t.file\t\"heat.cpp\"\n"
+    "\t.text\n"
+    "\t.file 1 \"heat.cpp\"\n"
+    "\t.globl\t_Z3addii\n"
+    "\t.type\t_Z3addii, @function\n"
+    "_Z3addii:\n"
+    ".LFB0:\n"
+    "\t.loc 1 2 1\n"
+    "\t.cfi_startproc\n"
+    "\tleal\t(%rdi,%rsi), %eax\n"
+    "\taddl\t$1, %eax\n"
+    "\t.loc 1 3 1\n"
+    "\tret\n"
+    "\t.cfi_endproc\n"
+    ".LFE0:\n"
+    "\t.size\t_Z3addii, .-_Z3addii\n";
+
+// as -aln --listing-cont-lines=8, Intel prologue on line 1
+const char* const kAsListing =
+    "   1              \t.intel_syntax noprefix\n"
+    "   2              \tfoo:\n"
+    "   3 0000 B8010000 \t mov eax,1\n"
+    "   3      00\n"
+    "   4 0005 48B88877 \t movabs rax,0x1122334455667788\n"
+    "   4      66554433 \n"
+    "   4      2211\n"
+    "   5              \t bogus x\n"
+    "   6 ???? C3       \t ret\n";
+
+} // namespace
+
+class SourceHeatTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    // ── Model ────────────────────────────────────────────────────────────────
+
+    void countsInstructionsPerSourceLine()
+    {
+        const SourceHeat heat = SourceHeat::fromDocument(AsmParser::parse(kListing));
+        QCOMPARE(heat.lineCount(), 3);
+        QCOMPARE(heat.instructions.at(1), 0);
+        QCOMPARE(heat.instructions.at(2), 2);
+        QCOMPARE(heat.instructions.at(3), 1);
+        QVERIFY(heat.has(SourceHeat::Metric::Instructions));
+        QVERIFY(!heat.has(SourceHeat::Metric::Bytes));
+        QCOMPARE(heat.maxValue(SourceHeat::Metric::Instructions), 2.0);
+    }
+
+    void sumsInstructionBytesOnly()
+    {
+        const AsmDocument document = AsmParser::parse(kListing);
+        SourceHeat heat = SourceHeat::fromDocument(document);
+
+        // Labels "assembled" to 100 bytes must not count
+        QVector<int> lineBytes(document.lines.size(), 0);
+        for (int i = 0; i < document.lines.size(); ++i) {
+            lineBytes[i] = document.lines[i].kind == AsmLine::Kind::Instruction ? 4 : 100;
+        }
+        heat.applyLineBytes(document, lineBytes);
+        QVERIFY(heat.has(SourceHeat::Metric::Bytes));
+        QCOMPARE(heat.value(2, SourceHeat::Metric::Bytes), 8.0);
+        QCOMPARE(heat.value(3, SourceHeat::Metric::Bytes), 4.0);
+        QCOMPARE(heat.describe(2), QStringLiteral("2 instructions · 8 bytes"));
+    }
+
+    // ── as listing ───────────────────────────────────────────────────────────
+
+    void parsesAsListing()
+    {
+        const QVector<int> sizes = SourceHeat::parseListing(kAsListing, 5, 2);
+        QCOMPARE(sizes, QVector<int>({ 0, 5, 10, 0, 1 }));
+    }
+
+    void measuresAssembledLines()
+    {
+        if (QStandardPaths::findExecutable(QStringLiteral("as")).isEmpty()) {
+            QSKIP("No assembler available");
+        }
+        const QVector<int> att = SourceHeat::measureLineBytes(
+            QStringLiteral("_Z3addii:\n\tleal\t(%rdi,%rsi), %eax\n\tret"), false);
+        if (att.isEmpty()) QSKIP("as does not support GNU listings");
+        QCOMPARE(att, QVector<int>({ 0, 3, 1 }));
+
+        const QVector<int> intel = SourceHeat::measureLineBytes(
+            QStringLiteral("\tlea\teax, [rdi+rsi]\n\tret"), true);
+        QCOMPARE(intel, QVector<int>({ 3, 1 }));
+    }
+};
+
+QTEST_MAIN(SourceHeatTest)
+#include "test_source_heat.moc"